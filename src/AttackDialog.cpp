@@ -23,6 +23,8 @@
 #include "GOODF.h"
 #include <wx/statline.h>
 #include "WAVfileParser.h"
+#include "LoopFinder.h"
+#include <wx/choicdlg.h>
 
 IMPLEMENT_CLASS(AttackDialog, wxDialog)
 
@@ -43,6 +45,7 @@ BEGIN_EVENT_TABLE(AttackDialog, wxDialog)
 	EVT_LISTBOX(ID_ATK_DIALOG_LOOP_LIST, AttackDialog::OnLoopListSelection)
 	EVT_BUTTON(ID_ATK_DIALOG_ADD_LOOP_BTN, AttackDialog::OnAddLoopBtn)
 	EVT_BUTTON(ID_ATK_DIALOG_DELETE_LOOP_BTN, AttackDialog::OnRemoveLoopBtn)
+	EVT_BUTTON(ID_ATK_DIALOG_FIND_LOOPS_BTN, AttackDialog::OnFindLoopsBtn)
 	EVT_SPINCTRL(ID_ATK_DIALOG_LOOP_START_SPIN, AttackDialog::OnLoopStartSpin)
 	EVT_SPINCTRL(ID_ATK_DIALOG_LOOP_END_SPIN, AttackDialog::OnLoopEndSpin)
 	EVT_CHECKBOX(ID_RANK_COPY_REPLACE_ODF_LOOPS, AttackDialog::OnCopyReplaceLoopCheck)
@@ -158,6 +161,9 @@ void AttackDialog::CreateControls() {
 	wxStaticLine *upperDivider = new wxStaticLine(this);
 	mainSizer->Add(upperDivider, 0, wxEXPAND);
 
+	m_waveform = new WaveformPanel(this);
+	mainSizer->Add(m_waveform, 1, wxEXPAND|wxALL, 5);
+
 	wxBoxSizer *secondRow = new wxBoxSizer(wxHORIZONTAL);
 	wxStaticText *loadReleaseText = new wxStaticText (
 		this,
@@ -389,6 +395,13 @@ void AttackDialog::CreateControls() {
 		wxT("Delete selected loop")
 	);
 	loopBtnContainer->Add(m_deleteLoopBtn, 0, wxGROW|wxALL, 5);
+	m_findLoopsBtn = new wxButton(
+		this,
+		ID_ATK_DIALOG_FIND_LOOPS_BTN,
+		wxT("Find loops...")
+	);
+	m_findLoopsBtn->SetToolTip(wxT("Search the sustain of the sample for loop points and add the chosen ones"));
+	loopBtnContainer->Add(m_findLoopsBtn, 0, wxGROW|wxALL, 5);
 	loopBtnContainer->AddStretchSpacer();
 	sixthRow->Add(loopBtnContainer, 0, wxGROW);
 	wxStaticBoxSizer *loopPropertiesContainer = new wxStaticBoxSizer(wxVERTICAL, this, wxT("Selected loop properties"));
@@ -556,12 +569,14 @@ void AttackDialog::OnMaxKeyPressTimeSpin(wxSpinEvent& WXUNUSED(event)) {
 void AttackDialog::OnAttackStartSpin(wxSpinEvent& WXUNUSED(event)) {
 	m_currentAttack->attackStart = m_attackStartSpin->GetValue();
 	m_copyPropertiesBtn->Enable();
+	UpdateWaveform();
 	::wxGetApp().m_frame->m_organ->setModified(true);
 }
 
 void AttackDialog::OnCuePointSpin(wxSpinEvent& WXUNUSED(event)) {
 	m_currentAttack->cuePoint = m_cuePointSpin->GetValue();
 	m_copyPropertiesBtn->Enable();
+	UpdateWaveform();
 	::wxGetApp().m_frame->m_organ->setModified(true);
 }
 
@@ -581,6 +596,7 @@ void AttackDialog::OnReleaseCrossfadeSpin(wxSpinEvent& WXUNUSED(event)) {
 void AttackDialog::OnReleaseEndSpin(wxSpinEvent& WXUNUSED(event)) {
 	m_currentAttack->releaseEnd = m_releaseEndSpin->GetValue();
 	m_copyPropertiesBtn->Enable();
+	UpdateWaveform();
 	::wxGetApp().m_frame->m_organ->setModified(true);
 }
 
@@ -634,6 +650,48 @@ void AttackDialog::OnRemoveLoopBtn(wxCommandEvent& WXUNUSED(event)) {
 	}
 }
 
+void AttackDialog::OnFindLoopsBtn(wxCommandEvent& WXUNUSED(event)) {
+	std::vector<LoopFinder::LOOP_CANDIDATE> candidates;
+	wxString errorMessage;
+	bool found;
+	{
+		wxBusyCursor busy;
+		found = LoopFinder::findLoops(m_currentAttack->fullPath, 8, candidates, errorMessage);
+	}
+	if (!found) {
+		wxMessageDialog msg(this, errorMessage, wxT("No loops found"), wxOK|wxCENTRE|wxICON_INFORMATION);
+		msg.ShowModal();
+		return;
+	}
+
+	WAVfileParser sample(m_currentAttack->fullPath);
+	wxArrayString choices;
+	for (LoopFinder::LOOP_CANDIDATE &candidate : candidates)
+		choices.Add(LoopFinder::describeCandidate(candidate, sample.getSampleRate()));
+	wxMultiChoiceDialog dlg(this, wxT("Select the loops to add, the best ones are listed first"), wxT("Loop candidates"), choices);
+	wxArrayInt preselected;
+	preselected.Add(0);
+	dlg.SetSelections(preselected);
+	if (dlg.ShowModal() != wxID_OK || dlg.GetSelections().IsEmpty())
+		return;
+
+	wxArrayInt selections = dlg.GetSelections();
+	for (int index : selections) {
+		Loop l;
+		l.start = candidates[index].start;
+		l.end = candidates[index].end;
+		m_currentAttack->addNewLoop(l);
+	}
+	UpdateLoopChoices();
+	unsigned lastLoopIndex = m_loopsList->GetCount() - 1;
+	m_loopsList->SetSelection(lastLoopIndex);
+	m_selectedLoop = m_currentAttack->getLoopAt(lastLoopIndex);
+	LoopInListSelected();
+	if (GetCopyReplaceLoops())
+		m_copyPropertiesBtn->Enable();
+	::wxGetApp().m_frame->m_organ->setModified(true);
+}
+
 void AttackDialog::OnLoopStartSpin(wxSpinEvent& WXUNUSED(event)) {
 	int value = m_loopStartSpin->GetValue();
 	if (value > m_loopEndSpin->GetValue() - 1) {
@@ -642,6 +700,7 @@ void AttackDialog::OnLoopStartSpin(wxSpinEvent& WXUNUSED(event)) {
 	}
 	m_selectedLoop->start = value;
 	SetLoopStartAndEndRanges();
+	UpdateWaveform();
 	::wxGetApp().m_frame->m_organ->setModified(true);
 	if (GetCopyReplaceLoops())
 		m_copyPropertiesBtn->Enable();
@@ -655,6 +714,7 @@ void AttackDialog::OnLoopEndSpin(wxSpinEvent& WXUNUSED(event)) {
 	}
 	m_selectedLoop->end = value;
 	SetLoopStartAndEndRanges();
+	UpdateWaveform();
 	::wxGetApp().m_frame->m_organ->setModified(true);
 	if (GetCopyReplaceLoops())
 		m_copyPropertiesBtn->Enable();
@@ -707,6 +767,7 @@ void AttackDialog::TransferAttackValuesToWindow() {
 		m_cuePointSpin->Disable();
 		m_releaseEndSpin->Disable();
 		m_addNewLoopBtn->Disable();
+		m_findLoopsBtn->Disable();
 		m_deleteLoopBtn->Disable();
 		m_loopStartSpin->Disable();
 		m_loopEndSpin->Disable();
@@ -726,6 +787,7 @@ void AttackDialog::TransferAttackValuesToWindow() {
 		} else {
 			m_maxSampleFrames = 158760000;
 		}
+		m_findLoopsBtn->Enable();
 
 		if (m_currentAttack->loadRelease) {
 			m_loadReleaseYes->SetValue(true);
@@ -750,6 +812,7 @@ void AttackDialog::TransferAttackValuesToWindow() {
 
 		UpdateLoopChoices();
 	}
+	UpdateWaveform();
 }
 
 void AttackDialog::SetLoopStartAndEndRanges() {
@@ -778,6 +841,29 @@ void AttackDialog::UpdateLoopChoices() {
 		m_loopStartSpin->Disable();
 		m_loopEndSpin->Disable();
 	}
+	UpdateWaveform();
+}
+
+void AttackDialog::UpdateWaveform() {
+	if (m_currentAttack->fullPath.IsSameAs(wxT("DUMMY"))) {
+		m_waveform->SetSample(wxEmptyString);
+		return;
+	}
+	m_waveform->SetSample(m_currentAttack->fullPath);
+
+	// like GrandOrgue, the loops and cue of the sample apply when none are set
+	WAVfileParser sample(m_currentAttack->fullPath);
+	std::vector<std::pair<unsigned, unsigned>> loops;
+	for (Loop &l : m_currentAttack->m_loops)
+		loops.push_back(std::make_pair((unsigned) l.start, (unsigned) l.end));
+	if (loops.empty()) {
+		for (unsigned i = 0; i < sample.getNumberOfLoops(); i++)
+			loops.push_back(std::make_pair(sample.getLoopAtIndex(i).dwStart, sample.getLoopAtIndex(i).dwEnd));
+	}
+	int cuePoint = m_currentAttack->cuePoint;
+	if (cuePoint < 0 && sample.getNumberOfCues() > 0)
+		cuePoint = sample.getCuepointAtIndex(0).dwSampleOffset;
+	m_waveform->SetMarkers(m_currentAttack->attackStart, cuePoint, m_currentAttack->releaseEnd, loops);
 }
 
 void AttackDialog::LoopInListSelected() {
@@ -26,6 +26,7 @@
 #include <wx/checkbox.h>
 #include "GOODFDef.h"
 #include "Attack.h"
+#include "WaveformPanel.h"
 
 class AttackDialog : public wxDialog {
 	DECLARE_CLASS(AttackDialog)
@@ -91,11 +92,13 @@ private:
 	wxSpinCtrl *m_attackStartSpin; // 0 - 158760000
 	wxSpinCtrl *m_cuePointSpin; // -1 - 158760000
 	wxSpinCtrl *m_releaseEndSpin; // -1 - 158760000
+	WaveformPanel *m_waveform;
 	wxSpinCtrl *m_loopCrossfadeSpin; // 0-3000
 	wxSpinCtrl *m_releaseCrossfadeSpin; // 0-3000
 	wxListBox *m_loopsList;
 	wxButton *m_addNewLoopBtn;
 	wxButton *m_deleteLoopBtn;
+	wxButton *m_findLoopsBtn;
 	wxSpinCtrl *m_loopStartSpin;
 	wxSpinCtrl *m_loopEndSpin;
 	wxButton *m_copyPropertiesBtn;
@@ -117,6 +120,7 @@ private:
 	void OnLoopListSelection(wxCommandEvent& event);
 	void OnAddLoopBtn(wxCommandEvent& event);
 	void OnRemoveLoopBtn(wxCommandEvent& event);
+	void OnFindLoopsBtn(wxCommandEvent& event);
 	void OnLoopStartSpin(wxSpinEvent& event);
 	void OnLoopEndSpin(wxSpinEvent& event);
 	void OnCopyReplaceLoopCheck(wxCommandEvent& event);
@@ -126,6 +130,7 @@ private:
 	void TransferAttackValuesToWindow();
 	void SetLoopStartAndEndRanges();
 	void UpdateLoopChoices();
+	void UpdateWaveform();
 	void LoopInListSelected();
 };
 
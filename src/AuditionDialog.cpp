@@ -0,0 +1,168 @@
+/*
+ * AuditionDialog.cpp is part of GoOdf.
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * GoOdf is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GoOdf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GoOdf.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#include "AuditionDialog.h"
+#include <wx/statline.h>
+
+IMPLEMENT_CLASS(AuditionDialog, wxDialog)
+
+AuditionDialog::AuditionDialog(const wxArrayString &releaseNames) {
+	Init(releaseNames);
+}
+
+AuditionDialog::AuditionDialog(
+	const wxArrayString &releaseNames,
+	wxWindow* parent,
+	wxWindowID id,
+	const wxString& caption,
+	const wxPoint& pos,
+	const wxSize& size,
+	long style
+) {
+	Init(releaseNames);
+	Create(parent, id, caption, pos, size, style);
+}
+
+AuditionDialog::~AuditionDialog() {
+
+}
+
+void AuditionDialog::Init(const wxArrayString &releaseNames) {
+	m_releaseNames = releaseNames;
+	m_loopIterationsSpin = NULL;
+	m_keyPressTimeSpin = NULL;
+	m_releaseChoice = NULL;
+}
+
+bool AuditionDialog::Create(
+	wxWindow* parent,
+	wxWindowID id,
+	const wxString& caption,
+	const wxPoint& pos,
+	const wxSize& size,
+	long style
+) {
+	if (!wxDialog::Create(parent, id, caption, pos, size, style))
+		return false;
+
+	CreateControls();
+
+	GetSizer()->Fit(this);
+	GetSizer()->SetSizeHints(this);
+	Centre();
+
+	return true;
+}
+
+void AuditionDialog::CreateControls() {
+	wxBoxSizer *mainSizer = new wxBoxSizer(wxVERTICAL);
+	wxFlexGridSizer *settingsGrid = new wxFlexGridSizer(2, 0, 0);
+
+	wxStaticText *loopIterationsText = new wxStaticText (
+		this,
+		wxID_STATIC,
+		wxT("Loop iterations before the release: ")
+	);
+	settingsGrid->Add(loopIterationsText, 0, wxALIGN_CENTER_VERTICAL|wxALL, 5);
+	m_loopIterationsSpin = new wxSpinCtrl(
+		this,
+		wxID_ANY,
+		wxEmptyString,
+		wxDefaultPosition,
+		wxDefaultSize,
+		wxSP_ARROW_KEYS,
+		1,
+		1000,
+		3
+	);
+	settingsGrid->Add(m_loopIterationsSpin, 0, wxALIGN_CENTER_VERTICAL|wxALL, 5);
+
+	wxStaticText *keyPressTimeText = new wxStaticText (
+		this,
+		wxID_STATIC,
+		wxT("Or release the key after (ms, 0 to use the loop iterations): ")
+	);
+	settingsGrid->Add(keyPressTimeText, 0, wxALIGN_CENTER_VERTICAL|wxALL, 5);
+	m_keyPressTimeSpin = new wxSpinCtrl(
+		this,
+		wxID_ANY,
+		wxEmptyString,
+		wxDefaultPosition,
+		wxDefaultSize,
+		wxSP_ARROW_KEYS,
+		0,
+		600000,
+		0
+	);
+	settingsGrid->Add(m_keyPressTimeSpin, 0, wxALIGN_CENTER_VERTICAL|wxALL, 5);
+
+	if (!m_releaseNames.IsEmpty()) {
+		wxStaticText *releaseText = new wxStaticText (
+			this,
+			wxID_STATIC,
+			wxT("Release: ")
+		);
+		settingsGrid->Add(releaseText, 0, wxALIGN_CENTER_VERTICAL|wxALL, 5);
+		wxArrayString choices;
+		choices.Add(wxT("By MaxKeyPressTime, or the release part of the attack"));
+		choices.insert(choices.end(), m_releaseNames.begin(), m_releaseNames.end());
+		m_releaseChoice = new wxChoice(
+			this,
+			wxID_ANY,
+			wxDefaultPosition,
+			wxDefaultSize,
+			choices
+		);
+		m_releaseChoice->SetSelection(0);
+		settingsGrid->Add(m_releaseChoice, 0, wxEXPAND|wxALL, 5);
+	}
+	mainSizer->Add(settingsGrid, 0, wxGROW|wxALL, 5);
+
+	wxStaticLine *bottomDivider = new wxStaticLine(this);
+	mainSizer->Add(bottomDivider, 0, wxEXPAND);
+
+	wxBoxSizer *bottomRow = new wxBoxSizer(wxHORIZONTAL);
+	bottomRow->AddStretchSpacer();
+	wxButton *theCancelButton = new wxButton(
+		this,
+		wxID_CANCEL,
+		wxT("Cancel")
+	);
+	bottomRow->Add(theCancelButton, 0, wxALIGN_CENTER|wxALL, 10);
+	bottomRow->AddStretchSpacer();
+	wxButton *theOkButton = new wxButton(
+		this,
+		wxID_OK,
+		wxT("Render")
+	);
+	bottomRow->Add(theOkButton, 0, wxALIGN_CENTER|wxALL, 10);
+	bottomRow->AddStretchSpacer();
+	mainSizer->Add(bottomRow, 0, wxGROW);
+
+	SetSizer(mainSizer);
+}
+
+AuditionRenderer::RENDER_SETTINGS AuditionDialog::GetSettings() {
+	AuditionRenderer::RENDER_SETTINGS settings;
+	settings.loopIterations = m_loopIterationsSpin->GetValue();
+	settings.keyPressTime = m_keyPressTimeSpin->GetValue();
+	settings.releaseIndex = m_releaseChoice ? m_releaseChoice->GetSelection() - 1 : -1;
+	return settings;
+}
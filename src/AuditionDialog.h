@@ -0,0 +1,76 @@
+/*
+ * AuditionDialog.h is part of GoOdf.
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * GoOdf is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GoOdf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GoOdf.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#ifndef AUDITIONDIALOG_H
+#define AUDITIONDIALOG_H
+
+#include <wx/wx.h>
+#include <wx/spinctrl.h>
+#include "AuditionRenderer.h"
+
+// Asks for the settings of an audition rendering. The release can only be
+// chosen when release names are given, otherwise it's picked per pipe.
+class AuditionDialog : public wxDialog {
+	DECLARE_CLASS(AuditionDialog)
+
+public:
+	// Constructors
+	AuditionDialog(const wxArrayString &releaseNames);
+	AuditionDialog(
+		const wxArrayString &releaseNames,
+		wxWindow* parent,
+		wxWindowID id = wxID_ANY,
+		const wxString& caption = wxT("Render audition"),
+		const wxPoint& pos = wxDefaultPosition,
+		const wxSize& size = wxDefaultSize,
+		long style = wxCAPTION|wxRESIZE_BORDER|wxSYSTEM_MENU|wxCLOSE_BOX
+	);
+
+	~AuditionDialog();
+
+	// Initialize our variables
+	void Init(const wxArrayString &releaseNames);
+
+	// Creation
+	bool Create(
+		wxWindow* parent,
+		wxWindowID id = wxID_ANY,
+		const wxString& caption = wxT("Render audition"),
+		const wxPoint& pos = wxDefaultPosition,
+		const wxSize& size = wxDefaultSize,
+		long style = wxCAPTION|wxRESIZE_BORDER|wxSYSTEM_MENU|wxCLOSE_BOX
+	);
+
+	// Creates the controls and sizers
+	void CreateControls();
+
+	// Accessors
+	AuditionRenderer::RENDER_SETTINGS GetSettings();
+
+private:
+	wxArrayString m_releaseNames;
+
+	wxSpinCtrl *m_loopIterationsSpin;
+	wxSpinCtrl *m_keyPressTimeSpin;
+	wxChoice *m_releaseChoice;
+
+};
+
+#endif
@@ -0,0 +1,454 @@
+/*
+ * AuditionRenderer.cpp is part of GoOdf.
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * GoOdf is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GoOdf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GoOdf.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#include "AuditionRenderer.h"
+#include "Rank.h"
+#include "SampleReader.h"
+#include "WAVfileParser.h"
+#include "WavWriter.h"
+#include "WorkerPool.h"
+#include "Instrumentation.h"
+#include "GOODFFunctions.h"
+#include "OdfFileWriter.h"
+#include <wx/filename.h>
+#include <algorithm>
+#include <memory>
+
+// frames of audio processed at a time
+static const unsigned CHUNK_FRAMES = 16384;
+
+namespace {
+
+	struct LOOP_RANGE {
+		unsigned start;
+		// exclusive, the frame after the last one of the loop
+		unsigned end;
+	};
+
+	unsigned msToFrames(int ms, unsigned sampleRate) {
+		return ms > 0 ? (unsigned) ((unsigned long long) ms * sampleRate / 1000) : 0;
+	}
+
+	// The cue point of the ODF, otherwise the first one of the file
+	int resolveCuePoint(int cuePoint, WAVfileParser &sample) {
+		if (cuePoint >= 0)
+			return cuePoint;
+		if (sample.getNumberOfCues() > 0)
+			return sample.getCuepointAtIndex(0).dwSampleOffset;
+		return -1;
+	}
+
+	// Plays a range of a sample, jumping back at the loop ends. The last
+	// frames before a jump are crossfaded with the frames before the loop
+	// start so that the jump itself is seamless. The loops are taken in
+	// turn, a loop ending before the current position is skipped.
+	class SampleStream {
+	public:
+		SampleStream(SampleReader &reader, unsigned start, unsigned end, const std::vector<LOOP_RANGE> &loops, unsigned crossfade) :
+			m_reader(reader),
+			m_channels(reader.getNumberOfChannels()),
+			m_position(start),
+			m_end(end),
+			m_loops(loops),
+			m_crossfade(crossfade),
+			m_target(NO_LOOP),
+			m_failed(false) {
+			m_target = nextTargetFrom(0, m_position);
+		}
+
+		// Frames from the start through the given number of loop jumps
+		unsigned getFramesThroughLoops(unsigned iterations) const {
+			unsigned long long frames = 0;
+			unsigned position = m_position;
+			size_t target = m_target;
+			for (unsigned i = 0; i < iterations && target != NO_LOOP; i++) {
+				frames += m_loops[target].end - position;
+				position = m_loops[target].start;
+				target = nextTargetFrom(target + 1, position);
+			}
+			if (target == NO_LOOP)
+				frames += m_end > position ? m_end - position : 0;
+			return (unsigned) std::min(frames, 0xffffffffULL);
+		}
+
+		// Returns less than asked for only at the end (or on a read error)
+		unsigned read(float *out, unsigned frames) {
+			unsigned produced = 0;
+			while (produced < frames && !m_failed) {
+				float *dest = out + (size_t) produced * m_channels;
+				unsigned wanted = frames - produced;
+				if (m_target == NO_LOOP) {
+					if (m_position >= m_end)
+						break;
+					unsigned count = std::min(wanted, m_end - m_position);
+					if (!readPlain(dest, count))
+						break;
+					produced += count;
+					continue;
+				}
+				const LOOP_RANGE &loop = m_loops[m_target];
+				unsigned crossfade = std::min(m_crossfade, std::min(loop.start, loop.end - loop.start));
+				unsigned fadeStart = loop.end - crossfade;
+				if (m_position < fadeStart) {
+					unsigned count = std::min(wanted, fadeStart - m_position);
+					if (!readPlain(dest, count))
+						break;
+					produced += count;
+					continue;
+				}
+				unsigned fadePosition = m_position - fadeStart;
+				if (fadePosition >= crossfade) {
+					m_position = loop.start;
+					m_target = nextTargetFrom(m_target + 1, m_position);
+					continue;
+				}
+				unsigned count = std::min(wanted, crossfade - fadePosition);
+				if (!m_reader.readRange(m_position, m_position + count, m_fadeOut) ||
+					!m_reader.readRange(loop.start - crossfade + fadePosition, loop.start - crossfade + fadePosition + count, m_fadeIn)) {
+					m_failed = true;
+					break;
+				}
+				for (unsigned i = 0; i < count; i++) {
+					float gain = (fadePosition + i + 0.5f) / crossfade;
+					for (unsigned c = 0; c < m_channels; c++) {
+						size_t index = (size_t) i * m_channels + c;
+						dest[index] = m_fadeOut[index] * (1 - gain) + m_fadeIn[index] * gain;
+					}
+				}
+				m_position += count;
+				produced += count;
+			}
+			return produced;
+		}
+
+		bool hasFailed() const {
+			return m_failed;
+		}
+
+	private:
+		static const size_t NO_LOOP = (size_t) -1;
+
+		SampleReader &m_reader;
+		unsigned m_channels;
+		unsigned m_position;
+		unsigned m_end;
+		std::vector<LOOP_RANGE> m_loops;
+		unsigned m_crossfade;
+		size_t m_target;
+		bool m_failed;
+		std::vector<float> m_fadeOut;
+		std::vector<float> m_fadeIn;
+
+		// The first loop from first on (wrapping around) that ends after position
+		size_t nextTargetFrom(size_t first, unsigned position) const {
+			for (size_t i = 0; i < m_loops.size(); i++) {
+				size_t index = (first + i) % m_loops.size();
+				if (m_loops[index].end > position)
+					return index;
+			}
+			return NO_LOOP;
+		}
+
+		bool readPlain(float *dest, unsigned count) {
+			if (!m_reader.seek(m_position) || m_reader.read(dest, count) != count) {
+				m_failed = true;
+				return false;
+			}
+			m_position += count;
+			return true;
+		}
+	};
+
+	// Copies frames to a buffer with another number of channels, a mono
+	// source is copied to every channel
+	void mapChannels(const float *in, unsigned inChannels, float *out, unsigned outChannels, unsigned frames, bool add) {
+		for (unsigned i = 0; i < frames; i++) {
+			for (unsigned c = 0; c < outChannels; c++) {
+				float value = in[(size_t) i * inChannels + std::min(c, inChannels - 1)];
+				float &dest = out[(size_t) i * outChannels + c];
+				dest = add ? dest + value : value;
+			}
+		}
+	}
+
+}
+
+bool AuditionRenderer::renderAttack(const Attack &atk, const Release *release, const RENDER_SETTINGS &settings, const wxString &outputPath, wxString &errorMessage) {
+	if (!GOODF_functions::isSampleFilePath(atk.fullPath)) {
+		errorMessage = wxT("The attack has no sample file.\n");
+		return false;
+	}
+	SampleReader attackReader(atk.fullPath);
+	if (!attackReader.isOk()) {
+		errorMessage = attackReader.getErrorMessage();
+		return false;
+	}
+	WAVfileParser attackSample(atk.fullPath);
+	unsigned sampleRate = attackReader.getSampleRate();
+	unsigned totalFrames = attackReader.getNumberOfFrames();
+	unsigned start = std::min((unsigned) std::max(atk.attackStart, 0), totalFrames);
+
+	// an attack with a release part ends where the release starts
+	unsigned end = totalFrames;
+	int cuePoint = resolveCuePoint(atk.cuePoint, attackSample);
+	if (cuePoint > (int) start && (unsigned) cuePoint < totalFrames)
+		end = cuePoint;
+
+	std::vector<LOOP_RANGE> loops;
+	if (!atk.m_loops.empty()) {
+		for (const Loop &l : atk.m_loops)
+			loops.push_back(LOOP_RANGE{(unsigned) std::max(l.start, 0), (unsigned) std::max(l.end, 0) + 1});
+	} else {
+		for (unsigned i = 0; i < attackSample.getNumberOfLoops(); i++) {
+			LOOP fileLoop = attackSample.getLoopAtIndex(i);
+			loops.push_back(LOOP_RANGE{fileLoop.dwStart, fileLoop.dwEnd + 1});
+		}
+	}
+	loops.erase(std::remove_if(loops.begin(), loops.end(), [start, end](const LOOP_RANGE &l) {
+		return l.start < start || l.end <= l.start + 1 || l.end > end;
+	}), loops.end());
+
+	SampleStream attackStream(attackReader, start, end, loops, msToFrames(atk.loopCrossfadeLength, sampleRate));
+	unsigned releaseAt;
+	if (settings.keyPressTime > 0)
+		releaseAt = msToFrames(settings.keyPressTime, sampleRate);
+	else
+		releaseAt = attackStream.getFramesThroughLoops(loops.empty() ? 0 : settings.loopIterations);
+
+	std::unique_ptr<SampleReader> releaseReader;
+	std::unique_ptr<SampleStream> releaseStream;
+	unsigned releaseCrossfade;
+	if (release && GOODF_functions::isSampleFilePath(release->fullPath)) {
+		releaseReader.reset(new SampleReader(release->fullPath));
+		if (!releaseReader->isOk()) {
+			errorMessage = releaseReader->getErrorMessage();
+			return false;
+		}
+		if (releaseReader->getSampleRate() != sampleRate) {
+			errorMessage = wxT("The attack and the release have different sample rates.\n");
+			return false;
+		}
+		WAVfileParser releaseSample(release->fullPath);
+		unsigned releaseFrames = releaseReader->getNumberOfFrames();
+		int releaseStart = resolveCuePoint(release->cuePoint, releaseSample);
+		unsigned first = releaseStart > 0 ? std::min((unsigned) releaseStart, releaseFrames) : 0;
+		unsigned last = release->releaseEnd > (int) first ? std::min((unsigned) release->releaseEnd, releaseFrames) : releaseFrames;
+		releaseStream.reset(new SampleStream(*releaseReader, first, last, std::vector<LOOP_RANGE>(), 0));
+		releaseCrossfade = msToFrames(release->releaseCrossfadeLength, sampleRate);
+	} else {
+		// no release to go to, a short fade out avoids a click
+		releaseCrossfade = std::max(msToFrames(atk.releaseCrossfadeLength, sampleRate), msToFrames(20, sampleRate));
+	}
+
+	unsigned attackChannels = attackReader.getNumberOfChannels();
+	unsigned releaseChannels = releaseReader ? releaseReader->getNumberOfChannels() : attackChannels;
+	unsigned channels = std::max(attackChannels, releaseChannels);
+	// an interrupted rendering mustn't leave a truncated file behind
+	wxString tempPath = outputPath + wxT(".tmp");
+	WavWriter writer;
+	if (!writer.open(tempPath, channels, sampleRate)) {
+		errorMessage = writer.getErrorMessage();
+		if (wxFileExists(tempPath))
+			wxRemoveFile(tempPath);
+		return false;
+	}
+
+	std::vector<float> attackBuffer((size_t) CHUNK_FRAMES * attackChannels);
+	std::vector<float> releaseBuffer((size_t) CHUNK_FRAMES * releaseChannels);
+	std::vector<float> output((size_t) CHUNK_FRAMES * channels);
+	bool ok = true;
+
+	// the key is held, a finished unlooped attack is followed by silence
+	unsigned written = 0;
+	while (ok && written < releaseAt) {
+		unsigned count = std::min(CHUNK_FRAMES, releaseAt - written);
+		unsigned got = attackStream.read(attackBuffer.data(), count);
+		std::fill(attackBuffer.begin() + (size_t) got * attackChannels, attackBuffer.begin() + (size_t) count * attackChannels, 0.0f);
+		mapChannels(attackBuffer.data(), attackChannels, output.data(), channels, count, false);
+		ok = !attackStream.hasFailed() && writer.write(output.data(), count);
+		written += count;
+	}
+
+	// the attack fades out while the release fades in
+	unsigned faded = 0;
+	while (ok && faded < releaseCrossfade) {
+		unsigned count = std::min(CHUNK_FRAMES, releaseCrossfade - faded);
+		unsigned got = attackStream.read(attackBuffer.data(), count);
+		std::fill(attackBuffer.begin() + (size_t) got * attackChannels, attackBuffer.begin() + (size_t) count * attackChannels, 0.0f);
+		for (unsigned i = 0; i < count; i++) {
+			float gain = 1 - (faded + i + 0.5f) / releaseCrossfade;
+			for (unsigned c = 0; c < attackChannels; c++)
+				attackBuffer[(size_t) i * attackChannels + c] *= gain;
+		}
+		mapChannels(attackBuffer.data(), attackChannels, output.data(), channels, count, false);
+		if (releaseStream) {
+			got = releaseStream->read(releaseBuffer.data(), count);
+			std::fill(releaseBuffer.begin() + (size_t) got * releaseChannels, releaseBuffer.begin() + (size_t) count * releaseChannels, 0.0f);
+			for (unsigned i = 0; i < count; i++) {
+				float gain = (faded + i + 0.5f) / releaseCrossfade;
+				for (unsigned c = 0; c < releaseChannels; c++)
+					releaseBuffer[(size_t) i * releaseChannels + c] *= gain;
+			}
+			mapChannels(releaseBuffer.data(), releaseChannels, output.data(), channels, count, true);
+		}
+		ok = !attackStream.hasFailed() && writer.write(output.data(), count);
+		faded += count;
+	}
+
+	// the rest of the release
+	while (ok && releaseStream) {
+		unsigned got = releaseStream->read(releaseBuffer.data(), CHUNK_FRAMES);
+		if (got == 0)
+			break;
+		mapChannels(releaseBuffer.data(), releaseChannels, output.data(), channels, got, false);
+		ok = writer.write(output.data(), got);
+	}
+	if (ok && releaseStream && releaseStream->hasFailed())
+		ok = false;
+
+	if (!writer.close() || !ok) {
+		errorMessage = writer.getErrorMessage();
+		if (errorMessage.IsEmpty())
+			errorMessage = attackReader.getErrorMessage();
+		if (errorMessage.IsEmpty() && releaseReader)
+			errorMessage = releaseReader->getErrorMessage();
+		if (errorMessage.IsEmpty())
+			errorMessage = wxT("The samples couldn't be read.\n");
+		wxRemoveFile(tempPath);
+		return false;
+	}
+	if (!OdfFileWriter::replaceFile(tempPath, outputPath)) {
+		errorMessage = wxT("The rendered file couldn't replace ") + outputPath + wxT("\n");
+		wxRemoveFile(tempPath);
+		return false;
+	}
+	return true;
+}
+
+bool AuditionRenderer::chooseRelease(Pipe *pipe, const Attack &atk, const RENDER_SETTINGS &settings, Release &release) {
+	if (settings.releaseIndex >= 0) {
+		if ((size_t) settings.releaseIndex >= pipe->m_releases.size())
+			return false;
+		release = *std::next(pipe->m_releases.begin(), settings.releaseIndex);
+		return true;
+	}
+
+	// the release with the shortest MaxKeyPressTime that still covers the
+	// key press, without knowing the time any release qualifies
+	const Release *best = NULL;
+	for (const Release &rel : pipe->m_releases) {
+		if (rel.isTremulant == 1 && atk.isTremulant != 1)
+			continue;
+		if (settings.keyPressTime > 0 && rel.maxKeyPressTime != -1 && rel.maxKeyPressTime < (int) settings.keyPressTime)
+			continue;
+		if (!best || (best->maxKeyPressTime == -1 ? rel.maxKeyPressTime != -1 : (rel.maxKeyPressTime != -1 && rel.maxKeyPressTime < best->maxKeyPressTime)))
+			best = &rel;
+	}
+	if (best) {
+		release = *best;
+		return true;
+	}
+
+	// the release part of the attack sample itself
+	if (!atk.loadRelease || !GOODF_functions::isSampleFilePath(atk.fullPath))
+		return false;
+	WAVfileParser sample(atk.fullPath);
+	int cuePoint = resolveCuePoint(atk.cuePoint, sample);
+	if (cuePoint <= 0)
+		return false;
+	release.fileName = atk.fileName;
+	release.fullPath = atk.fullPath;
+	release.isTremulant = atk.isTremulant;
+	release.maxKeyPressTime = -1;
+	release.cuePoint = cuePoint;
+	release.releaseEnd = atk.releaseEnd;
+	release.releaseCrossfadeLength = atk.releaseCrossfadeLength;
+	return true;
+}
+
+bool AuditionRenderer::renderRank(
+	Rank *rank,
+	unsigned rankNumber,
+	const RENDER_SETTINGS &settings,
+	const wxString &directory,
+	std::vector<PIPE_RENDER> &results,
+	const std::function<bool(size_t, size_t)> &progress
+) {
+	ScopedTimer timer("analysis.renderRankAuditions");
+	results.clear();
+	rank->loadPipes();
+
+	// a directory that can't be made shows up as a failure of every pipe
+	wxString rankDirectory = directory + wxFILE_SEP_PATH + getRankDirectoryName(rank, rankNumber);
+	{
+		wxLogNull noLog;
+		if (!wxFileName::DirExists(rankDirectory))
+			wxFileName::Mkdir(rankDirectory, wxS_DIR_DEFAULT, wxPATH_MKDIR_FULL);
+	}
+
+	// the workers get copies, the pipes may not be touched from them
+	struct JOB {
+		Attack attack;
+		Release release;
+		bool hasRelease;
+	};
+	std::vector<JOB> jobs;
+	unsigned pipeIndex = 0;
+	for (Pipe &pipe : rank->m_pipes) {
+		if (!pipe.m_attacks.empty() && GOODF_functions::isSampleFilePath(pipe.m_attacks.front().fullPath)) {
+			JOB job;
+			job.attack = pipe.m_attacks.front();
+			job.hasRelease = chooseRelease(&pipe, job.attack, settings, job.release);
+			jobs.push_back(job);
+
+			PIPE_RENDER result;
+			result.pipeIndex = pipeIndex;
+			result.outputPath = rankDirectory + wxFILE_SEP_PATH + wxString::Format(wxT("Pipe%03u.wav"), pipeIndex + 1);
+			result.isRendered = false;
+			results.push_back(result);
+		}
+		pipeIndex++;
+	}
+
+	size_t total = jobs.size();
+	return WorkerPool::run(
+		total,
+		[&](size_t index) {
+			const JOB &job = jobs[index];
+			results[index].isRendered = renderAttack(job.attack, job.hasRelease ? &job.release : NULL, settings, results[index].outputPath, results[index].errorMessage);
+		},
+		[&](size_t done) { return !progress || progress(done, total); }
+	);
+}
+
+wxString AuditionRenderer::getRankDirectoryName(Rank *rank, unsigned rankNumber) {
+	// the number keeps ranks with the same name apart
+	wxString name = wxString::Format(wxT("Rank%03u"), rankNumber);
+	wxString rankName = rank->getName();
+	rankName.Trim(true).Trim(false);
+	if (rankName.IsEmpty())
+		return name;
+	wxString forbidden = wxFileName::GetForbiddenChars() + wxT("/\\");
+	for (wxString::iterator it = rankName.begin(); it != rankName.end(); ++it) {
+		if (forbidden.Find(*it) != wxNOT_FOUND || (*it).GetValue() < 32)
+			*it = wxT('_');
+	}
+	return name + wxT(" ") + rankName;
+}
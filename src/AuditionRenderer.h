@@ -0,0 +1,79 @@
+/*
+ * AuditionRenderer.h is part of GoOdf.
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * GoOdf is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GoOdf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GoOdf.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#ifndef AUDITIONRENDERER_H
+#define AUDITIONRENDERER_H
+
+#include <wx/wx.h>
+#include <vector>
+#include <functional>
+#include "Attack.h"
+#include "Release.h"
+
+class Pipe;
+class Rank;
+
+// Renders what a held key would sound like to a WAVE file, without
+// GrandOrgue: the attack is played from AttackStart through a number of
+// loop iterations, crossfading into each loop start over the
+// LoopCrossfadeLength, and is then crossfaded into a release over its
+// ReleaseCrossfadeLength. With several loops they are taken in turn, so
+// the result is always the same for the same settings.
+class AuditionRenderer {
+public:
+	struct RENDER_SETTINGS {
+		unsigned loopIterations;
+		// from the key press to the release in ms, 0 releases the key
+		// right after the loop iterations
+		unsigned keyPressTime;
+		// index in the pipe releases, -1 picks one by MaxKeyPressTime like
+		// GrandOrgue does and falls back to the release part of the attack
+		int releaseIndex;
+	};
+
+	struct PIPE_RENDER {
+		unsigned pipeIndex;
+		wxString outputPath;
+		bool isRendered;
+		wxString errorMessage;
+	};
+
+	// Without a release the attack is just faded out at the release time.
+	// The file is written next to the output path and only replaces it
+	// once it's complete.
+	static bool renderAttack(const Attack &atk, const Release *release, const RENDER_SETTINGS &settings, const wxString &outputPath, wxString &errorMessage);
+	// Chooses the release for renderAttack, returns false if there is none
+	static bool chooseRelease(Pipe *pipe, const Attack &atk, const RENDER_SETTINGS &settings, Release &release);
+	// Renders the first attack of every pipe to a file per pipe on the
+	// worker pool. The files go to a subdirectory of the directory named
+	// after the rank so that renderings of other ranks are kept.
+	static bool renderRank(
+		Rank *rank,
+		unsigned rankNumber,
+		const RENDER_SETTINGS &settings,
+		const wxString &directory,
+		std::vector<PIPE_RENDER> &results,
+		const std::function<bool(size_t, size_t)> &progress = nullptr
+	);
+	// The name of the subdirectory that renderRank writes to
+	static wxString getRankDirectoryName(Rank *rank, unsigned rankNumber);
+};
+
+#endif
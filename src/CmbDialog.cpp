@@ -319,12 +319,13 @@ void CmbDialog::OnBrowseForCmbBtn(wxCommandEvent& WXUNUSED(event)) {
 			delete m_cmbParser;
 			m_cmbParser = NULL;
 		}
-		if (m_importedCmbOrgan.cmbRanks.size() > 0 || m_importedCmbOrgan.cmbStops.size() > 0) {
+		if (m_importedCmbOrgan.cmbRanks.size() > 0 || m_importedCmbOrgan.cmbStops.size() > 0 || m_importedCmbOrgan.cmbWindchests.size() > 0) {
 			// Any previously added information that could be left over must now be removed
 			m_importedCmbOrgan.churchName = wxEmptyString;
 			m_importedCmbOrgan.odfPath = wxEmptyString;
 			m_importedCmbOrgan.cmbRanks.clear();
 			m_importedCmbOrgan.cmbStops.clear();
+			m_importedCmbOrgan.cmbWindchests.clear();
 		}
 		m_cmbParser = new CmbParser(fileDialog.GetPath(), GetCmbOrgan());
 		if (m_cmbParser->IsParsedOk()) {
@@ -19,10 +19,81 @@
  */
 
 #include "CmbParser.h"
+#include "Instrumentation.h"
 #include <wx/stdpaths.h>
 #include <wx/filename.h>
 #include <wx/wfstream.h>
 #include <wx/zstream.h>
+#include <vector>
+#include <charconv>
+#include <cstring>
+#include <cctype>
+
+namespace {
+
+	bool isBlank(char c) {
+		return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+	}
+
+	std::string trimmed(const std::string &content, size_t begin, size_t end) {
+		while (begin < end && isBlank(content[begin]))
+			begin++;
+		while (end > begin && isBlank(content[end - 1]))
+			end--;
+		return content.substr(begin, end - begin);
+	}
+
+	bool startsWithNoCase(const std::string &str, const char *prefix) {
+		size_t length = strlen(prefix);
+		if (str.size() < length)
+			return false;
+		for (size_t i = 0; i < length; i++) {
+			if (tolower((unsigned char) str[i]) != tolower((unsigned char) prefix[i]))
+				return false;
+		}
+		return true;
+	}
+
+	bool equalsNoCase(const std::string &str, const char *other) {
+		return str.size() == strlen(other) && startsWithNoCase(str, other);
+	}
+
+	// number made of all the digits from start up to the end of the string
+	bool parseDigits(const std::string &str, size_t start, size_t end, int *number) {
+		if (start >= end || end - start > 6)
+			return false;
+		int value = 0;
+		for (size_t i = start; i < end; i++) {
+			if (str[i] < '0' || str[i] > '9')
+				return false;
+			value = value * 10 + (str[i] - '0');
+		}
+		*number = value;
+		return true;
+	}
+
+	template<typename T>
+	void parseNumber(const std::string &value, T *number) {
+		// the value is kept if it can't be parsed, just like wxConfig does
+		const char *begin = value.data();
+		const char *end = begin + value.size();
+		if (begin < end && *begin == '+')
+			begin++;
+		T parsed;
+		std::from_chars_result res = std::from_chars(begin, end, parsed);
+		if (res.ec == std::errc() && res.ptr == end)
+			*number = parsed;
+	}
+
+	// std::from_chars is only used for integers, the MinGW and macOS
+	// standard libraries of the release builds have no floating point one
+	void parseNumber(const std::string &value, float *number) {
+		double parsed;
+		if (wxString::FromAscii(value.c_str()).ToCDouble(&parsed))
+			*number = (float) parsed;
+	}
+
+}
 
 CmbParser::CmbParser(wxString filePath, CMB_ORGAN *cmbOrgan) {
 	m_isOk = false;
@@ -47,183 +118,227 @@ wxString CmbParser::GetErrorText() {
 
 bool CmbParser::readCmbFile(wxString fileName, CMB_ORGAN *cmbOrgan) {
 	// convert file parameter to a stream for further parsing
+	ScopedTimer timer("load.readCmbFile");
 	wxFFileInputStream cmbFile(fileName);
 
-	if (cmbFile.IsOk()) {
-		wxZlibInputStream cmbIn(cmbFile, wxZLIB_GZIP);
-		if (cmbIn.IsOk()) {
-			wxFileConfig iniFile(cmbIn);
-			if (iniFile.HasGroup(wxT("Organ"))) {
-				// An [Organ] section is found
-
-				parseSection(&iniFile, wxT("Organ"), cmbOrgan);
-
-				bool lookForWindchest = true;
-				int windchestNbr = 1;
-				while (lookForWindchest) {
-					wxString windchestName = wxString::Format(wxT("WindchestGroup%0.3d"), windchestNbr);
-					if (parseSection(&iniFile, windchestName, cmbOrgan)) {
-						windchestNbr++;
-					} else {
-						lookForWindchest = false;
-					}
-				}
-
-				bool lookForRank = true;
-				int rankNbr = 1;
-				while (lookForRank) {
-					wxString rankName = wxString::Format(wxT("Rank%0.3d"), rankNbr);
-					if (parseSection(&iniFile, rankName, cmbOrgan)) {
-						rankNbr++;
-					} else {
-						lookForRank = false;
-					}
-				}
-
-				bool lookForStop = true;
-				int stopNbr = 1;
-				while (lookForStop) {
-					wxString stopName = wxString::Format(wxT("Stop%0.3d"), stopNbr);
-					if (parseSection(&iniFile, stopName, cmbOrgan)) {
-						stopNbr++;
-					} else {
-						lookForStop = false;
-					}
-				}
-
-				return true;
-			} else {
-				m_errorText = wxT("Couldn't find an [Organ] section in the file!");
-				return false;
-			}
-		} else {
-			m_errorText = wxT("Decompression of the stream failed!");
-			return false;
-		}
-	} else {
+	if (!cmbFile.IsOk()) {
 		m_errorText = wxT("Failed to create stream from filename!\n");
 		return false;
 	}
-}
+	Instrumentation::count(Instrumentation::BYTES_READ, (long long) cmbFile.GetLength());
 
-bool CmbParser::parseString(wxFileConfig *ini, wxString key, wxString *value, wxString defaultValue) {
-	return ini->Read(key, value, defaultValue);
-}
+	wxZlibInputStream cmbIn(cmbFile, wxZLIB_GZIP);
+	std::string content;
+	if (!cmbIn.IsOk() || !readDecompressed(cmbIn, content)) {
+		m_errorText = wxT("Decompression of the stream failed!");
+		return false;
+	}
 
-bool CmbParser::parseInt(wxFileConfig *ini, wxString key, int *value, int defaultValue) {
-	long parsedValue = defaultValue;
-	bool returnValue = ini->Read(key, &parsedValue, defaultValue);
-	*value = static_cast<long>(parsedValue);
-	return returnValue;
-}
+	bool hasOrganSection = false;
+	PARSED_SECTION organ;
+	setDefaults(organ.attributes);
+	std::map<int, PARSED_SECTION> windchests;
+	std::map<int, PARSED_SECTION> ranks;
+	std::map<int, PARSED_SECTION> stops;
+	PARSED_SECTION *section = NULL;
+	SECTION_TYPE sectionType = OTHER_SECTION;
+
+	size_t pos = 0;
+	if (content.compare(0, 3, "\xEF\xBB\xBF") == 0)
+		pos = 3;
+	while (pos < content.size()) {
+		size_t lineEnd = content.find('\n', pos);
+		if (lineEnd == std::string::npos)
+			lineEnd = content.size();
+		size_t lineBegin = pos;
+		pos = lineEnd + 1;
+
+		while (lineBegin < lineEnd && isBlank(content[lineBegin]))
+			lineBegin++;
+		if (lineBegin == lineEnd || content[lineBegin] == ';' || content[lineBegin] == '#')
+			continue;
+
+		if (content[lineBegin] == '[') {
+			size_t close = content.find(']', lineBegin);
+			section = NULL;
+			sectionType = OTHER_SECTION;
+			if (close == std::string::npos || close > lineEnd)
+				continue;
+
+			int number = 0;
+			sectionType = parseSectionName(trimmed(content, lineBegin + 1, close), &number);
+			switch (sectionType) {
+				case ORGAN_SECTION:
+					hasOrganSection = true;
+					section = &organ;
+					break;
+				case WINDCHEST_SECTION:
+					section = &getSection(windchests, number);
+					break;
+				case RANK_SECTION:
+					section = &getSection(ranks, number);
+					break;
+				case STOP_SECTION:
+					section = &getSection(stops, number);
+					break;
+				default:
+					break;
+			}
+			continue;
+		}
 
-bool CmbParser::parseFloat(wxFileConfig *ini, wxString key, float *value, float defaultValue) {
-	return ini->Read(key, value, defaultValue);
-}
+		if (!section)
+			continue;
 
-bool CmbParser::parseSection(wxFileConfig *ini, wxString section, CMB_ORGAN *cmbOrgan) {
-	if (ini->HasGroup(section))
-		ini->SetPath(wxT("/") + section);
-	else
-		return false;
+		size_t equals = content.find('=', lineBegin);
+		if (equals == std::string::npos || equals > lineEnd)
+			continue;
+		std::string key = trimmed(content, lineBegin, equals);
+		std::string value = trimmed(content, equals + 1, lineEnd);
 
-	float amplitude;
-	parseFloat(ini, wxT("Amplitude"), &amplitude, 100.0f);
+		if (sectionType == RANK_SECTION || sectionType == STOP_SECTION) {
+			if (startsWithNoCase(key, "Pipe")) {
+				addPipeEntry(*section, key, value);
+				continue;
+			}
+		} else if (sectionType == ORGAN_SECTION) {
+			if (equalsNoCase(key, "ChurchName")) {
+				cmbOrgan->churchName = decodeString(value);
+				continue;
+			} else if (equalsNoCase(key, "ODFPath")) {
+				cmbOrgan->odfPath = decodeString(value);
+				continue;
+			}
+		}
+		parseAttribute(section->attributes, key, value);
+	}
 
-	float gain;
-	parseFloat(ini, wxT("UserGain"), &gain, 0.0f);
+	if (!hasOrganSection) {
+		m_errorText = wxT("Couldn't find an [Organ] section in the file!");
+		return false;
+	}
 
-	float pitchTuning;
-	parseFloat(ini, wxT("ManualTuning"), &pitchTuning, 0.0f);
+	cmbOrgan->attributes = organ.attributes;
+	for (int nbr = 1; windchests.count(nbr); nbr++)
+		cmbOrgan->cmbWindchests.push_back(windchests[nbr].attributes);
+	addSections(ranks, cmbOrgan->cmbRanks);
+	addSections(stops, cmbOrgan->cmbStops);
 
-	float pitchCorrection;
-	parseFloat(ini, wxT("AutoTuningCorrection"), &pitchCorrection, 0.0f);
+	return true;
+}
 
-	int trackerDelay;
-	parseInt(ini, wxT("Delay"), &trackerDelay, 0);
+bool CmbParser::readDecompressed(wxInputStream &in, std::string &content) {
+	std::vector<char> buffer(65536);
+	while (true) {
+		in.Read(buffer.data(), buffer.size());
+		size_t bytesRead = in.LastRead();
+		content.append(buffer.data(), bytesRead);
+		if (in.GetLastError() == wxSTREAM_EOF)
+			return true;
+		if (in.GetLastError() != wxSTREAM_NO_ERROR)
+			return false;
+		if (bytesRead == 0)
+			return true;
+	}
+}
 
-	if (!section.IsSameAs(wxT("Organ")) && !section.StartsWith(wxT("WindchestGroup"))) {
-		CMB_ELEMENT_WITH_PIPES elementWithPipes;
-		elementWithPipes.attributes.amplitude = amplitude;
-		elementWithPipes.attributes.gain = gain;
-		elementWithPipes.attributes.pitchTuning = pitchTuning;
-		elementWithPipes.attributes.pitchCorrection = pitchCorrection;
-		elementWithPipes.attributes.trackerDelay = trackerDelay;
-
-		int pipeId = 1;
-		while (pipeId < 193) {
-			if (hasPipeKey(ini, pipeId))
-				elementWithPipes.pipes.push_back(parsePipe(ini, pipeId));
-
-			pipeId++;
+CmbParser::SECTION_TYPE CmbParser::parseSectionName(const std::string &name, int *number) {
+	if (equalsNoCase(name, "Organ"))
+		return ORGAN_SECTION;
+
+	static const struct {
+		const char *prefix;
+		SECTION_TYPE type;
+	} numberedSections[] = {
+		{ "WindchestGroup", WINDCHEST_SECTION },
+		{ "Rank", RANK_SECTION },
+		{ "Stop", STOP_SECTION }
+	};
+	for (const auto &numbered : numberedSections) {
+		if (startsWithNoCase(name, numbered.prefix)) {
+			if (parseDigits(name, strlen(numbered.prefix), name.size(), number) && *number > 0)
+				return numbered.type;
+			return OTHER_SECTION;
 		}
+	}
+	return OTHER_SECTION;
+}
+
+CmbParser::PARSED_SECTION& CmbParser::getSection(std::map<int, PARSED_SECTION> &sections, int number) {
+	auto it = sections.find(number);
+	if (it == sections.end()) {
+		it = sections.emplace(number, PARSED_SECTION()).first;
+		setDefaults(it->second.attributes);
+	}
+	return it->second;
+}
 
-		if (section.StartsWith(wxT("Rank"))) {
-			cmbOrgan->cmbRanks.push_back(elementWithPipes);
-		} else if (section.StartsWith(wxT("Stop"))) {
-			cmbOrgan->cmbStops.push_back(elementWithPipes);
+void CmbParser::addSections(std::map<int, PARSED_SECTION> &sections, std::vector<CMB_ELEMENT_WITH_PIPES> &elements) {
+	// numbering starts from 001 and the first missing number ends it
+	for (int nbr = 1; sections.count(nbr); nbr++) {
+		PARSED_SECTION &section = sections[nbr];
+		CMB_ELEMENT_WITH_PIPES elementWithPipes;
+		elementWithPipes.attributes = section.attributes;
+		// only pipes with an amplitude are voiced, the map keeps them in order
+		for (auto &parsedPipe : section.pipes) {
+			if (parsedPipe.second.hasAmplitude)
+				elementWithPipes.pipes.push_back(parsedPipe.second.pipe);
 		}
-	} else if (section.StartsWith(wxT("WindchestGroup"))) {
-		CMB_ELEMENT windchest;
-		windchest.amplitude = amplitude;
-		windchest.gain = gain;
-		windchest.pitchTuning = pitchTuning;
-		windchest.pitchCorrection = pitchCorrection;
-		windchest.trackerDelay = trackerDelay;
-		cmbOrgan->cmbWindchests.push_back(windchest);
-	} else {
-		wxString churchName;
-		parseString(ini, wxT("ChurchName"), &churchName, wxEmptyString);
-		cmbOrgan->churchName = churchName;
-
-		wxString odfPath;
-		parseString(ini, wxT("ODFPath"), &odfPath, wxEmptyString);
-		cmbOrgan->odfPath = odfPath;
-
-		cmbOrgan->attributes.amplitude = amplitude;
-		cmbOrgan->attributes.gain = gain;
-		cmbOrgan->attributes.pitchTuning = pitchTuning;
-		cmbOrgan->attributes.pitchCorrection = pitchCorrection;
-		cmbOrgan->attributes.trackerDelay = trackerDelay;
-	}
-
-	ini->SetPath("/");
-	return true;
+		elements.push_back(elementWithPipes);
+	}
 }
 
-bool CmbParser::hasPipeKey(wxFileConfig *ini, int pipeIndex) {
-	wxString pipeStr = wxString::Format(wxT("Pipe%0.3d"), pipeIndex);
-	if (ini->HasEntry(pipeStr + wxT("Amplitude")))
-		return true;
+bool CmbParser::parseAttribute(CMB_ELEMENT &element, const std::string &key, const std::string &value) {
+	if (equalsNoCase(key, "Amplitude"))
+		parseNumber(value, &element.amplitude);
+	else if (equalsNoCase(key, "UserGain"))
+		parseNumber(value, &element.gain);
+	else if (equalsNoCase(key, "ManualTuning"))
+		parseNumber(value, &element.pitchTuning);
+	else if (equalsNoCase(key, "AutoTuningCorrection"))
+		parseNumber(value, &element.pitchCorrection);
+	else if (equalsNoCase(key, "Delay"))
+		parseNumber(value, &element.trackerDelay);
 	else
 		return false;
+	return true;
 }
 
-CMB_PIPE CmbParser::parsePipe(wxFileConfig *ini, int pipeIndex) {
-	wxString pipeStr = wxString::Format(wxT("Pipe%0.3d"), pipeIndex);
-
-	float amplitude;
-	parseFloat(ini, pipeStr + wxT("Amplitude"), &amplitude, 100.0f);
-
-	float gain;
-	parseFloat(ini, pipeStr + wxT("UserGain"), &gain, 0.0f);
-
-	float pitchTuning;
-	parseFloat(ini, pipeStr + wxT("ManualTuning"), &pitchTuning, 0.0f);
-
-	float pitchCorrection;
-	parseFloat(ini, pipeStr + wxT("AutoTuningCorrection"), &pitchCorrection, 0.0f);
+void CmbParser::addPipeEntry(PARSED_SECTION &section, const std::string &key, const std::string &value) {
+	// keys are like Pipe001Amplitude
+	size_t digitsEnd = 4;
+	while (digitsEnd < key.size() && key[digitsEnd] >= '0' && key[digitsEnd] <= '9')
+		digitsEnd++;
+
+	int pipeNbr;
+	if (!parseDigits(key, 4, digitsEnd, &pipeNbr) || pipeNbr < 1 || pipeNbr > 192)
+		return;
+
+	auto it = section.pipes.find(pipeNbr);
+	if (it == section.pipes.end()) {
+		PARSED_PIPE parsedPipe;
+		parsedPipe.pipe.pipeNbr = pipeNbr;
+		setDefaults(parsedPipe.pipe.attributes);
+		parsedPipe.hasAmplitude = false;
+		it = section.pipes.emplace(pipeNbr, parsedPipe).first;
+	}
 
-	int trackerDelay;
-	parseInt(ini, pipeStr + wxT("Delay"), &trackerDelay, 0);
+	std::string attribute = key.substr(digitsEnd);
+	if (parseAttribute(it->second.pipe.attributes, attribute, value) && equalsNoCase(attribute, "Amplitude"))
+		it->second.hasAmplitude = true;
+}
 
-	CMB_PIPE thePipe;
-	thePipe.pipeNbr = pipeIndex;
-	thePipe.attributes.amplitude = amplitude;
-	thePipe.attributes.gain = gain;
-	thePipe.attributes.pitchTuning = pitchTuning;
-	thePipe.attributes.pitchCorrection = pitchCorrection;
-	thePipe.attributes.trackerDelay = trackerDelay;
+wxString CmbParser::decodeString(const std::string &value) {
+	wxString decoded = wxString::FromUTF8(value.c_str(), value.size());
+	if (decoded.IsEmpty() && !value.empty())
+		decoded = wxString(value.c_str(), wxConvISO8859_1, value.size());
+	return decoded;
+}
 
-	return thePipe;
+void CmbParser::setDefaults(CMB_ELEMENT &element) {
+	element.amplitude = 100.0f;
+	element.gain = 0.0f;
+	element.pitchTuning = 0.0f;
+	element.pitchCorrection = 0.0f;
+	element.trackerDelay = 0;
 }
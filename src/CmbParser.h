@@ -22,9 +22,14 @@
 #define CMBPARSER_H
 
 #include <wx/wx.h>
-#include <wx/fileconf.h>
+#include <wx/stream.h>
+#include <map>
+#include <string>
 #include "CmbOrgan.h"
 
+// Reads the voicing data of a .cmb file. The decompressed file is gone
+// through once and every entry is handed to the windchest, rank, stop or
+// pipe that its section and key name point at.
 class CmbParser {
 public:
 	CmbParser(wxString filePath, CMB_ORGAN *cmbOrgan);
@@ -34,16 +39,37 @@ public:
 	wxString GetErrorText();
 
 private:
+	enum SECTION_TYPE {
+		OTHER_SECTION,
+		ORGAN_SECTION,
+		WINDCHEST_SECTION,
+		RANK_SECTION,
+		STOP_SECTION
+	};
+
+	struct PARSED_PIPE {
+		CMB_PIPE pipe;
+		bool hasAmplitude;
+	};
+
+	// entries of a section gathered before the sections are put in order
+	struct PARSED_SECTION {
+		CMB_ELEMENT attributes;
+		std::map<int, PARSED_PIPE> pipes;
+	};
+
 	bool m_isOk;
 	wxString m_errorText;
 
 	bool readCmbFile(wxString fileName, CMB_ORGAN *cmbOrgan);
-	bool parseString(wxFileConfig *ini, wxString key, wxString *value, wxString defaultValue = wxEmptyString);
-	bool parseInt(wxFileConfig *ini, wxString key, int *value, int defaultValue = -1);
-	bool parseFloat(wxFileConfig *ini, wxString key, float *value, float defaultValue = 0.0f);
-	bool parseSection(wxFileConfig *ini, wxString section, CMB_ORGAN *cmbOrgan);
-	bool hasPipeKey(wxFileConfig *ini, int pipeIndex);
-	CMB_PIPE parsePipe(wxFileConfig *ini, int pipeIndex);
+	bool readDecompressed(wxInputStream &in, std::string &content);
+	SECTION_TYPE parseSectionName(const std::string &name, int *number);
+	PARSED_SECTION& getSection(std::map<int, PARSED_SECTION> &sections, int number);
+	void addSections(std::map<int, PARSED_SECTION> &sections, std::vector<CMB_ELEMENT_WITH_PIPES> &elements);
+	bool parseAttribute(CMB_ELEMENT &element, const std::string &key, const std::string &value);
+	void addPipeEntry(PARSED_SECTION &section, const std::string &key, const std::string &value);
+	wxString decodeString(const std::string &value);
+	void setDefaults(CMB_ELEMENT &element);
 };
 
 #endif
@@ -19,7 +19,7 @@
  */
 
 #include "Coupler.h"
-#include "GOODF.h"
+#include "Organ.h"
 #include "GOODFFunctions.h"
 
 Coupler::Coupler() : Drawstop() {
@@ -48,7 +48,7 @@ void Coupler::write(wxTextFile *outFile) {
 		outFile->AddLine(wxT("UnisonOff=Y"));
 	} else {
 		outFile->AddLine(wxT("UnisonOff=N"));
-		wxString manId = GOODF_functions::number_format(::wxGetApp().m_frame->m_organ->getIndexOfOrganManual(m_destinationManual));
+		wxString manId = GOODF_functions::number_format(OrganContext::current()->getOrgan()->getIndexOfOrganManual(m_destinationManual));
 		outFile->AddLine(wxT("DestinationManual=") + manId);
 		outFile->AddLine(wxT("DestinationKeyshift=") + wxString::Format(wxT("%i"), m_destinationKeyshift));
 		if (m_couplerType.IsSameAs(wxT("Normal"))) {
@@ -19,7 +19,7 @@
  */
 
 #include "Divisional.h"
-#include "GOODF.h"
+#include "Organ.h"
 #include "GOODFFunctions.h"
 
 Divisional::Divisional() : Button() {
@@ -145,8 +145,7 @@ void Divisional::read(wxFileConfig *cfg, bool usingOldPanelFormat, Manual *ownin
 						m_tremulants.push_back(std::make_pair(m_owningManual->getTremulantAt(labs(value) - 1), false));
 					}
 				} else {
-					wxLogError("%s value %s is out of range for divisional '%s' since manual '%s' only lists %u tremulants!", tremNbr, tremId, name, m_owningManual->getName(), m_owningManual->getNumberOfTremulants());
-					::wxGetApp().m_frame->GetLogWindow()->Show(true);
+					OrganContext::current()->logError(wxString::Format("%s value %s is out of range for divisional '%s' since manual '%s' only lists %u tremulants!", tremNbr, tremId, name, m_owningManual->getName(), m_owningManual->getNumberOfTremulants()));
 				}
 			}
 		}
@@ -167,8 +166,7 @@ void Divisional::read(wxFileConfig *cfg, bool usingOldPanelFormat, Manual *ownin
 						m_switches.push_back(std::make_pair(m_owningManual->getGoSwitchAt(labs(value) - 1), false));
 					}
 				} else {
-					wxLogError("%s value %s is out of range for divisional '%s' since manual '%s' only lists %u switches!", swNbr, swId, name, m_owningManual->getName(), m_owningManual->getNumberOfGoSwitches());
-					::wxGetApp().m_frame->GetLogWindow()->Show(true);
+					OrganContext::current()->logError(wxString::Format("%s value %s is out of range for divisional '%s' since manual '%s' only lists %u switches!", swNbr, swId, name, m_owningManual->getName(), m_owningManual->getNumberOfGoSwitches()));
 				}
 			}
 		}
@@ -19,7 +19,7 @@
  */
 
 #include "DivisionalCoupler.h"
-#include "GOODF.h"
+#include "Organ.h"
 #include "GOODFFunctions.h"
 
 DivisionalCoupler::DivisionalCoupler() : Drawstop() {
@@ -41,7 +41,7 @@ void DivisionalCoupler::write(wxTextFile *outFile) {
 	outFile->AddLine(wxT("NumberOfManuals=") + wxString::Format(wxT("%u"), getNumberOfManuals()));
 	unsigned counter = 1;
 	for (Manual* m : m_affectedManuals) {
-		wxString manId = GOODF_functions::number_format(::wxGetApp().m_frame->m_organ->getIndexOfOrganManual(m));
+		wxString manId = GOODF_functions::number_format(OrganContext::current()->getOrgan()->getIndexOfOrganManual(m));
 		outFile->AddLine(wxT("Manual") + GOODF_functions::number_format(counter) + wxT("=") + manId);
 		counter++;
 	}
@@ -20,7 +20,7 @@
 
 #include "Drawstop.h"
 #include "GOODFFunctions.h"
-#include "GOODF.h"
+#include "Organ.h"
 #include "GoSwitch.h"
 
 Drawstop::Drawstop() : Button() {
@@ -41,7 +41,7 @@ void Drawstop::write(wxTextFile *outFile) {
 		if (function.IsSameAs(wxT("Not"))) {
 			// Only the first switch is relevant
 			outFile->AddLine(wxT("Function=") + function);
-			unsigned refIndex = ::wxGetApp().m_frame->m_organ->getIndexOfOrganSwitch(m_switches.front());
+			unsigned refIndex = OrganContext::current()->getOrgan()->getIndexOfOrganSwitch(m_switches.front());
 			wxString formattedSwitch = GOODF_functions::number_format(refIndex);
 			outFile->AddLine(wxT("Switch001=") + formattedSwitch);
 		} else {
@@ -52,7 +52,7 @@ void Drawstop::write(wxTextFile *outFile) {
 			unsigned k = 0;
 			for (auto& sw : m_switches) {
 				k++;
-				unsigned refIndex = ::wxGetApp().m_frame->m_organ->getIndexOfOrganSwitch(sw);
+				unsigned refIndex = OrganContext::current()->getOrgan()->getIndexOfOrganSwitch(sw);
 				wxString formattedNumber = GOODF_functions::number_format(k);
 				wxString formattedSwitch = GOODF_functions::number_format(refIndex);
 				outFile->AddLine(wxT("Switch") + formattedNumber + wxT("=") + formattedSwitch);
@@ -61,8 +61,7 @@ void Drawstop::write(wxTextFile *outFile) {
 	} else {
 		// Issue a warning if function is set to something else than Input and referenced switches is empty
 		if (!function.IsSameAs(wxT("Input")) && m_switches.empty()) {
-			wxLogWarning("%s has function %s and should reference some switch(es) but doesn't! The function value will thus not be written to file!", getName(), getFunction());
-			::wxGetApp().m_frame->GetLogWindow()->Show(true);
+			OrganContext::current()->logWarning(wxString::Format("%s has function %s and should reference some switch(es) but doesn't! The function value will thus not be written to file!", getName(), getFunction()));
 		}
 		if (defaultToEngaged)
 			outFile->AddLine(wxT("DefaultToEngaged=Y"));
@@ -97,8 +96,7 @@ void Drawstop::read(wxFileConfig *cfg, bool usingOldPanelFormat, Organ *readOrga
 				if (!hasSwitchReference(readOrgan->getOrganSwitchAt(swRefNbr - 1)))
 					addSwitchReference(readOrgan->getOrganSwitchAt(swRefNbr - 1));
 				else {
-					wxLogWarning("Switch%0.3d (%s) is already added to %s! This additional switch entry will be ignored!", swRefNbr, readOrgan->getOrganSwitchAt(swRefNbr - 1)->getName(), getName());
-					::wxGetApp().m_frame->GetLogWindow()->Show(true);
+					readOrgan->getContext()->logWarning(wxString::Format("Switch%0.3d (%s) is already added to %s! This additional switch entry will be ignored!", swRefNbr, readOrgan->getOrganSwitchAt(swRefNbr - 1)->getName(), getName()));
 				}
 			}
 		}
@@ -0,0 +1,714 @@
+/*
+ * DuplicateSampleFinder.cpp is part of GoOdf.
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * GoOdf is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GoOdf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GoOdf.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#include "DuplicateSampleFinder.h"
+#include "Organ.h"
+#include "WorkerPool.h"
+#include "Instrumentation.h"
+#include "GOODFFunctions.h"
+#include <wx/ffile.h>
+#include <cstring>
+#include <cstdint>
+#include <algorithm>
+
+namespace {
+
+	// A fast 64 bit content hash that is fed in pieces, four lanes wide
+	class ContentHasher {
+	public:
+		ContentHasher() {
+			m_lanes[0] = PRIME1 + PRIME2;
+			m_lanes[1] = PRIME2;
+			m_lanes[2] = 0;
+			m_lanes[3] = 0 - PRIME1;
+			m_buffered = 0;
+			m_totalLength = 0;
+		}
+
+		void update(const unsigned char *data, size_t length) {
+			m_totalLength += length;
+			if (m_buffered) {
+				size_t toCopy = std::min(length, sizeof(m_buffer) - m_buffered);
+				memcpy(m_buffer + m_buffered, data, toCopy);
+				m_buffered += toCopy;
+				data += toCopy;
+				length -= toCopy;
+				if (m_buffered < sizeof(m_buffer))
+					return;
+				processStripe(m_buffer);
+				m_buffered = 0;
+			}
+			while (length >= sizeof(m_buffer)) {
+				processStripe(data);
+				data += sizeof(m_buffer);
+				length -= sizeof(m_buffer);
+			}
+			memcpy(m_buffer, data, length);
+			m_buffered = length;
+		}
+
+		uint64_t finish() {
+			uint64_t hash = rotate(m_lanes[0], 1) + rotate(m_lanes[1], 7) + rotate(m_lanes[2], 12) + rotate(m_lanes[3], 18);
+			for (int i = 0; i < 4; i++) {
+				hash ^= round(0, m_lanes[i]);
+				hash = hash * PRIME1 + PRIME4;
+			}
+			hash += m_totalLength;
+			for (size_t i = 0; i < m_buffered; i++) {
+				hash ^= m_buffer[i] * PRIME5;
+				hash = rotate(hash, 11) * PRIME1;
+			}
+			hash ^= hash >> 33;
+			hash *= PRIME2;
+			hash ^= hash >> 29;
+			hash *= PRIME3;
+			hash ^= hash >> 32;
+			return hash;
+		}
+
+	private:
+		static const uint64_t PRIME1 = 11400714785074694791ULL;
+		static const uint64_t PRIME2 = 14029467366897019727ULL;
+		static const uint64_t PRIME3 = 1609587929392839161ULL;
+		static const uint64_t PRIME4 = 9650029242287828579ULL;
+		static const uint64_t PRIME5 = 2870177450012600261ULL;
+
+		uint64_t m_lanes[4];
+		unsigned char m_buffer[32];
+		size_t m_buffered;
+		uint64_t m_totalLength;
+
+		static uint64_t rotate(uint64_t value, int bits) {
+			return (value << bits) | (value >> (64 - bits));
+		}
+
+		static uint64_t round(uint64_t lane, uint64_t input) {
+			lane += input * PRIME2;
+			return rotate(lane, 31) * PRIME1;
+		}
+
+		void processStripe(const unsigned char *stripe) {
+			for (int i = 0; i < 4; i++) {
+				uint64_t word;
+				memcpy(&word, stripe + i * 8, 8);
+				m_lanes[i] = round(m_lanes[i], word);
+			}
+		}
+	};
+
+	unsigned readLittleEndian32(const unsigned char *bytes) {
+		return (unsigned) bytes[0] | ((unsigned) bytes[1] << 8) | ((unsigned) bytes[2] << 16) | ((unsigned) bytes[3] << 24);
+	}
+
+	// Reads the given ranges of a file as if they were one stream
+	class RangeReader {
+	public:
+		RangeReader(const std::vector<std::pair<unsigned long long, unsigned long long>> &ranges) : m_ranges(ranges) {
+			m_rangeIndex = 0;
+			m_remaining = 0;
+		}
+
+		bool open(const wxString &path) {
+			wxLogNull noLog;
+			return m_file.Open(path, wxT("rb"));
+		}
+
+		// Fills the whole buffer unless the ranges end or reading fails
+		size_t read(unsigned char *buffer, size_t length) {
+			size_t filled = 0;
+			while (filled < length) {
+				if (m_remaining == 0) {
+					if (m_rangeIndex >= m_ranges.size() || !m_file.Seek(m_ranges[m_rangeIndex].first))
+						break;
+					m_remaining = m_ranges[m_rangeIndex].second;
+					m_rangeIndex++;
+					continue;
+				}
+				size_t toRead = (size_t) std::min<unsigned long long>(m_remaining, length - filled);
+				size_t bytesRead = m_file.Read(buffer + filled, toRead);
+				filled += bytesRead;
+				m_remaining -= bytesRead;
+				if (bytesRead != toRead)
+					break;
+			}
+			return filled;
+		}
+
+	private:
+		wxFFile m_file;
+		const std::vector<std::pair<unsigned long long, unsigned long long>> &m_ranges;
+		size_t m_rangeIndex;
+		unsigned long long m_remaining;
+	};
+
+	template<typename T>
+	T* getListItem(std::list<T> &list, unsigned index) {
+		if (index >= list.size())
+			return NULL;
+		return &(*std::next(list.begin(), index));
+	}
+
+}
+
+DuplicateSampleFinder::DuplicateSampleFinder(Organ *organ) {
+	m_organ = organ;
+}
+
+DuplicateSampleFinder::~DuplicateSampleFinder() {
+
+}
+
+bool DuplicateSampleFinder::find(const std::function<bool(size_t, size_t)> &progress) {
+	ScopedTimer timer("analysis.findDuplicateSamples");
+	m_ranks.clear();
+	m_files.clear();
+	m_fileIndexes.clear();
+	m_groups.clear();
+	m_suggestions.clear();
+
+	collectRanks();
+	collectSampleFiles();
+
+	// the size of the audio data is read from the headers first
+	size_t total = m_files.size();
+	bool completed = WorkerPool::run(
+		m_files.size(),
+		[this](size_t index) { scanFile(m_files[index]); },
+		[&](size_t done) { return !progress || progress(done, total); }
+	);
+	if (!completed)
+		return false;
+
+	// then only files that have a potential twin need to be hashed
+	std::map<std::pair<bool, unsigned long long>, std::vector<unsigned>> buckets;
+	for (unsigned i = 0; i < m_files.size(); i++) {
+		if (m_files[i].isReadable)
+			buckets[std::make_pair(m_files[i].isWavPack, m_files[i].contentSize)].push_back(i);
+	}
+	std::vector<unsigned> toHash;
+	for (auto &bucket : buckets) {
+		if (bucket.second.size() > 1)
+			toHash.insert(toHash.end(), bucket.second.begin(), bucket.second.end());
+	}
+
+	size_t scanned = m_files.size();
+	total = scanned + toHash.size();
+	completed = WorkerPool::run(
+		toHash.size(),
+		[&](size_t index) { hashFile(m_files[toHash[index]]); },
+		[&](size_t done) { return !progress || progress(scanned + done, total); }
+	);
+	if (!completed)
+		return false;
+
+	// equal hashes are only candidates, the files are compared byte by
+	// byte with the first file of their candidate group
+	std::vector<std::vector<unsigned>> candidates = collectCandidateGroups();
+	std::vector<std::pair<unsigned, unsigned>> comparisons;
+	for (auto &candidate : candidates) {
+		for (unsigned i = 1; i < candidate.size(); i++)
+			comparisons.push_back(std::make_pair(candidate[0], candidate[i]));
+	}
+	std::vector<char> isSame(comparisons.size(), 0);
+	size_t hashed = total;
+	total = hashed + comparisons.size();
+	completed = WorkerPool::run(
+		comparisons.size(),
+		[&](size_t index) { isSame[index] = hasSameContent(m_files[comparisons[index].first], m_files[comparisons[index].second]); },
+		[&](size_t done) { return !progress || progress(hashed + done, total); }
+	);
+	if (!completed)
+		return false;
+
+	buildGroups(candidates, isSame);
+	buildBorrowingSuggestions();
+	return true;
+}
+
+unsigned DuplicateSampleFinder::getNumberOfSampleFiles() const {
+	return m_files.size();
+}
+
+const std::vector<DuplicateSampleFinder::DUPLICATE_GROUP>& DuplicateSampleFinder::getGroups() const {
+	return m_groups;
+}
+
+unsigned long long DuplicateSampleFinder::getDuplicatedBytes() const {
+	unsigned long long bytes = 0;
+	for (const DUPLICATE_GROUP &group : m_groups)
+		bytes += group.dataSize * (group.files.size() - 1);
+	return bytes;
+}
+
+const std::vector<DuplicateSampleFinder::BORROWING_SUGGESTION>& DuplicateSampleFinder::getBorrowingSuggestions() const {
+	return m_suggestions;
+}
+
+unsigned DuplicateSampleFinder::shareFilesWithinRanks(const std::vector<unsigned> &groupIndexes) {
+	unsigned changedSamples = 0;
+	for (unsigned groupIndex : groupIndexes) {
+		if (groupIndex >= m_groups.size())
+			continue;
+		DUPLICATE_GROUP &group = m_groups[groupIndex];
+
+		// the uses of the group in each rank, with the file index of each
+		std::map<Rank*, std::vector<std::pair<SAMPLE_USE, unsigned>>> usesInRank;
+		for (unsigned i = 0; i < group.files.size(); i++) {
+			for (const SAMPLE_USE &use : group.uses[i])
+				usesInRank[use.rank].push_back(std::make_pair(use, i));
+		}
+
+		for (auto &rankUses : usesInRank) {
+			Rank *rank = rankUses.first;
+			std::vector<std::pair<SAMPLE_USE, unsigned>> &uses = rankUses.second;
+			std::sort(uses.begin(), uses.end(), [](const std::pair<SAMPLE_USE, unsigned> &a, const std::pair<SAMPLE_USE, unsigned> &b) {
+				if (a.first.pipeIndex != b.first.pipeIndex)
+					return a.first.pipeIndex < b.first.pipeIndex;
+				if (a.first.isRelease != b.first.isRelease)
+					return !a.first.isRelease;
+				return a.first.sampleIndex < b.first.sampleIndex;
+			});
+
+			unsigned sharedFile = uses.front().second;
+			wxString sharedFileName;
+			Pipe *firstPipe = rank->getPipeAt(uses.front().first.pipeIndex);
+			if (uses.front().first.isRelease)
+				sharedFileName = getListItem(firstPipe->m_releases, uses.front().first.sampleIndex)->fileName;
+			else
+				sharedFileName = getListItem(firstPipe->m_attacks, uses.front().first.sampleIndex)->fileName;
+
+			bool rankChanged = false;
+			for (auto &use : uses) {
+				if (use.second == sharedFile)
+					continue;
+				Pipe *pipe = rank->getPipeAt(use.first.pipeIndex);
+				if (use.first.isRelease) {
+					Release *rel = getListItem(pipe->m_releases, use.first.sampleIndex);
+					rel->fileName = sharedFileName;
+					rel->fullPath = group.files[sharedFile];
+				} else {
+					Attack *atk = getListItem(pipe->m_attacks, use.first.sampleIndex);
+					atk->fileName = sharedFileName;
+					atk->fullPath = group.files[sharedFile];
+				}
+				changedSamples++;
+				rankChanged = true;
+			}
+			if (rankChanged)
+				m_organ->setSectionModified(rank);
+		}
+	}
+	return changedSamples;
+}
+
+unsigned DuplicateSampleFinder::applyBorrowing(const std::vector<unsigned> &suggestionIndexes) {
+	unsigned changedPipes = 0;
+	for (unsigned index : suggestionIndexes) {
+		if (index >= m_suggestions.size())
+			continue;
+		BORROWING_SUGGESTION &suggestion = m_suggestions[index];
+		suggestion.rank->clearPipeAt(suggestion.pipeIndex);
+		Pipe *pipe = suggestion.rank->getPipeAt(suggestion.pipeIndex);
+		pipe->m_attacks.front().fileName = suggestion.refString;
+		pipe->m_attacks.front().fullPath = suggestion.refString;
+		m_organ->setSectionModified(suggestion.rank);
+		changedPipes++;
+	}
+	return changedPipes;
+}
+
+wxString DuplicateSampleFinder::describeUse(const SAMPLE_USE &use) {
+	return wxString::Format(
+		wxT("%s, Pipe%s %s %u"),
+		use.rankName,
+		GOODF_functions::number_format(use.pipeIndex + 1),
+		use.isRelease ? wxT("release") : wxT("attack"),
+		use.sampleIndex + 1
+	);
+}
+
+void DuplicateSampleFinder::collectRanks() {
+	for (unsigned i = 0; i < m_organ->getNumberOfRanks(); i++) {
+		RANK_ENTRY entry;
+		entry.rank = m_organ->getOrganRankAt(i);
+		entry.name = entry.rank->getName();
+		entry.manualNumber = -1;
+		entry.stopNumber = -1;
+		entry.accessiblePipes = 0;
+		m_ranks.push_back(entry);
+	}
+	for (unsigned i = 0; i < m_organ->getNumberOfStops(); i++) {
+		Stop *stop = m_organ->getOrganStopAt(i);
+		if (!stop->isUsingInternalRank())
+			continue;
+		RANK_ENTRY entry;
+		entry.rank = stop->getInternalRank();
+		entry.name = stop->getName() + wxT(" (internal rank)");
+		entry.manualNumber = -1;
+		entry.stopNumber = -1;
+		entry.accessiblePipes = 0;
+		m_ranks.push_back(entry);
+	}
+
+	// A rank can be borrowed from if it's the first rank of a stop and its
+	// first pipe is the first pipe of the stop
+	for (unsigned i = 0; i < m_organ->getNumberOfManuals(); i++) {
+		Manual *manual = m_organ->getOrganManualAt(i);
+		int manualNumber = m_organ->doesHavePedals() ? i : i + 1;
+		for (unsigned j = 0; j < manual->getNumberOfStops(); j++) {
+			Stop *stop = manual->getStopAt(j);
+			Rank *firstRank = NULL;
+			if (stop->isUsingInternalRank()) {
+				if (stop->getFirstPipeLogicalPipeNbr() == 1)
+					firstRank = stop->getInternalRank();
+			} else if (stop->getNumberOfRanks() > 0) {
+				RankReference *ref = stop->getRankReferenceAt(0);
+				if (ref->m_firstPipeNumber == 1)
+					firstRank = ref->m_rankReference;
+			}
+			if (!firstRank)
+				continue;
+			for (RANK_ENTRY &entry : m_ranks) {
+				if (entry.rank == firstRank && entry.manualNumber < 0) {
+					entry.manualNumber = manualNumber;
+					entry.stopNumber = j + 1;
+					entry.accessiblePipes = stop->getNumberOfAccessiblePipes();
+				}
+			}
+		}
+	}
+}
+
+void DuplicateSampleFinder::collectSampleFiles() {
+	auto addUse = [this](const wxString &path, const SAMPLE_USE &use) {
+		if (!GOODF_functions::isSampleFilePath(path))
+			return;
+		auto it = m_fileIndexes.find(path);
+		if (it == m_fileIndexes.end()) {
+			SAMPLE_FILE file;
+			file.path = path;
+			file.isReadable = false;
+			file.isWavPack = false;
+			file.contentSize = 0;
+			file.hash = 0;
+			file.groupIndex = -1;
+			it = m_fileIndexes.emplace(path, m_files.size()).first;
+			m_files.push_back(file);
+		}
+		m_files[it->second].uses.push_back(use);
+	};
+
+	for (RANK_ENTRY &entry : m_ranks) {
+		entry.rank->loadPipes();
+		unsigned pipeIndex = 0;
+		for (Pipe &pipe : entry.rank->m_pipes) {
+			SAMPLE_USE use;
+			use.rank = entry.rank;
+			use.rankName = entry.name;
+			use.pipeIndex = pipeIndex;
+			use.isRelease = false;
+			use.sampleIndex = 0;
+			for (Attack &atk : pipe.m_attacks) {
+				addUse(atk.fullPath, use);
+				use.sampleIndex++;
+			}
+			use.isRelease = true;
+			use.sampleIndex = 0;
+			for (Release &rel : pipe.m_releases) {
+				addUse(rel.fullPath, use);
+				use.sampleIndex++;
+			}
+			pipeIndex++;
+		}
+	}
+}
+
+void DuplicateSampleFinder::scanFile(SAMPLE_FILE &file) {
+	wxFFile in;
+	{
+		wxLogNull noLog;
+		if (!in.Open(file.path, wxT("rb")))
+			return;
+	}
+	wxFileOffset length = in.Length();
+	unsigned char header[12];
+	if (length < 12 || in.Read(header, 12) != 12)
+		return;
+
+	if (memcmp(header, "wvpk", 4) == 0) {
+		// WavPack files are compared as a whole
+		file.isWavPack = true;
+		file.contentSize = length;
+		file.hashedRanges.push_back(std::make_pair(0ULL, (unsigned long long) length));
+		file.isReadable = true;
+		return;
+	}
+	if (memcmp(header, "RIFF", 4) != 0 || memcmp(header + 8, "WAVE", 4) != 0)
+		return;
+
+	bool hasData = false;
+	unsigned long long pos = 12;
+	while (pos + 8 <= (unsigned long long) length) {
+		unsigned char chunk[8];
+		if (!in.Seek(pos) || in.Read(chunk, 8) != 8)
+			break;
+		unsigned long long chunkSize = readLittleEndian32(chunk + 4);
+		unsigned long long rangeSize = std::min(chunkSize + 8, (unsigned long long) length - pos);
+		if (memcmp(chunk, "fmt ", 4) == 0 || memcmp(chunk, "smpl", 4) == 0 || memcmp(chunk, "cue ", 4) == 0) {
+			file.hashedRanges.push_back(std::make_pair(pos, rangeSize));
+		} else if (memcmp(chunk, "data", 4) == 0) {
+			file.hashedRanges.push_back(std::make_pair(pos, rangeSize));
+			file.contentSize = rangeSize - 8;
+			hasData = true;
+		}
+		pos += 8 + chunkSize + (chunkSize & 1);
+	}
+	file.isReadable = hasData;
+}
+
+void DuplicateSampleFinder::hashFile(SAMPLE_FILE &file) {
+	wxFFile in;
+	{
+		wxLogNull noLog;
+		if (!in.Open(file.path, wxT("rb"))) {
+			file.isReadable = false;
+			return;
+		}
+	}
+
+	ContentHasher hasher;
+	std::vector<unsigned char> buffer(1 << 20);
+	for (auto &range : file.hashedRanges) {
+		if (!in.Seek(range.first)) {
+			file.isReadable = false;
+			return;
+		}
+		unsigned long long remaining = range.second;
+		while (remaining > 0) {
+			size_t toRead = (size_t) std::min<unsigned long long>(remaining, buffer.size());
+			size_t bytesRead = in.Read(buffer.data(), toRead);
+			if (bytesRead != toRead) {
+				file.isReadable = false;
+				return;
+			}
+			hasher.update(buffer.data(), bytesRead);
+			remaining -= bytesRead;
+		}
+		Instrumentation::count(Instrumentation::BYTES_READ, range.second);
+	}
+	file.hash = hasher.finish();
+}
+
+bool DuplicateSampleFinder::hasSameContent(const SAMPLE_FILE &first, const SAMPLE_FILE &second) {
+	RangeReader firstReader(first.hashedRanges);
+	RangeReader secondReader(second.hashedRanges);
+	if (!firstReader.open(first.path) || !secondReader.open(second.path))
+		return false;
+
+	std::vector<unsigned char> firstBuffer(1 << 20);
+	std::vector<unsigned char> secondBuffer(1 << 20);
+	unsigned long long compared = 0;
+	while (compared < first.contentSize) {
+		size_t toRead = (size_t) std::min<unsigned long long>(first.contentSize - compared, firstBuffer.size());
+		if (firstReader.read(firstBuffer.data(), toRead) != toRead || secondReader.read(secondBuffer.data(), toRead) != toRead)
+			return false;
+		if (memcmp(firstBuffer.data(), secondBuffer.data(), toRead) != 0)
+			return false;
+		compared += toRead;
+	}
+	Instrumentation::count(Instrumentation::BYTES_READ, compared * 2);
+	return true;
+}
+
+std::vector<std::vector<unsigned>> DuplicateSampleFinder::collectCandidateGroups() {
+	std::map<std::pair<std::pair<bool, unsigned long long>, unsigned long long>, std::vector<unsigned>> identical;
+	std::vector<std::pair<std::pair<bool, unsigned long long>, unsigned long long>> order;
+	for (unsigned i = 0; i < m_files.size(); i++) {
+		SAMPLE_FILE &file = m_files[i];
+		if (!file.isReadable || file.hash == 0)
+			continue;
+		auto key = std::make_pair(std::make_pair(file.isWavPack, file.contentSize), file.hash);
+		std::vector<unsigned> &sameHash = identical[key];
+		if (sameHash.empty())
+			order.push_back(key);
+		sameHash.push_back(i);
+	}
+
+	// the candidates come in the order their first file is used in the organ
+	std::vector<std::vector<unsigned>> candidates;
+	for (auto &key : order) {
+		if (identical[key].size() > 1)
+			candidates.push_back(identical[key]);
+	}
+	return candidates;
+}
+
+void DuplicateSampleFinder::buildGroups(const std::vector<std::vector<unsigned>> &candidates, const std::vector<char> &isSame) {
+	size_t comparison = 0;
+	for (auto &candidate : candidates) {
+		std::vector<unsigned> sameContent(1, candidate[0]);
+		std::vector<unsigned> others;
+		for (unsigned i = 1; i < candidate.size(); i++) {
+			if (isSame[comparison++])
+				sameContent.push_back(candidate[i]);
+			else
+				others.push_back(candidate[i]);
+		}
+		addGroup(sameContent);
+
+		// only a hash collision gets here, so the rest is compared directly
+		while (others.size() > 1) {
+			std::vector<unsigned> sameAsFirst(1, others[0]);
+			std::vector<unsigned> remaining;
+			for (unsigned i = 1; i < others.size(); i++) {
+				if (hasSameContent(m_files[others[0]], m_files[others[i]]))
+					sameAsFirst.push_back(others[i]);
+				else
+					remaining.push_back(others[i]);
+			}
+			addGroup(sameAsFirst);
+			others.swap(remaining);
+		}
+	}
+}
+
+void DuplicateSampleFinder::addGroup(const std::vector<unsigned> &fileIndexes) {
+	if (fileIndexes.size() < 2)
+		return;
+	DUPLICATE_GROUP group;
+	group.dataSize = m_files[fileIndexes.front()].contentSize;
+	for (unsigned fileIndex : fileIndexes) {
+		m_files[fileIndex].groupIndex = m_groups.size();
+		group.files.push_back(m_files[fileIndex].path);
+		group.uses.push_back(m_files[fileIndex].uses);
+	}
+	m_groups.push_back(group);
+}
+
+void DuplicateSampleFinder::buildBorrowingSuggestions() {
+	// the first pipe with each sound that can be borrowed from
+	std::map<wxString, std::pair<unsigned, unsigned>> sources;
+	std::vector<std::vector<wxString>> signatures(m_ranks.size());
+	for (unsigned r = 0; r < m_ranks.size(); r++) {
+		RANK_ENTRY &entry = m_ranks[r];
+		for (unsigned p = 0; p < entry.rank->m_pipes.size(); p++) {
+			wxString signature = getPipeSignature(entry.rank, p);
+			signatures[r].push_back(signature);
+			if (signature.IsEmpty() || entry.manualNumber < 0 || (int) p >= entry.accessiblePipes)
+				continue;
+			if (sources.find(signature) == sources.end())
+				sources[signature] = std::make_pair(r, p);
+		}
+	}
+
+	for (unsigned r = 0; r < m_ranks.size(); r++) {
+		for (unsigned p = 0; p < signatures[r].size(); p++) {
+			if (signatures[r][p].IsEmpty())
+				continue;
+			auto source = sources.find(signatures[r][p]);
+			if (source == sources.end() || (source->second.first == r && source->second.second == p))
+				continue;
+			RANK_ENTRY &sourceEntry = m_ranks[source->second.first];
+			unsigned sourcePipe = source->second.second;
+			BORROWING_SUGGESTION suggestion;
+			suggestion.rank = m_ranks[r].rank;
+			suggestion.rankName = m_ranks[r].name;
+			suggestion.pipeIndex = p;
+			suggestion.sourceDescription = sourceEntry.name + wxT(", Pipe") + GOODF_functions::number_format(sourcePipe + 1);
+			suggestion.refString = wxT("REF:") + GOODF_functions::number_format(sourceEntry.manualNumber) + wxT(":") + GOODF_functions::number_format(sourceEntry.stopNumber) + wxT(":") + GOODF_functions::number_format(sourcePipe + 1);
+			m_suggestions.push_back(suggestion);
+		}
+	}
+}
+
+wxString DuplicateSampleFinder::getPipeSignature(Rank *rank, unsigned pipeIndex) {
+	// Everything that decides how the samples of a pipe sound, with each
+	// file replaced by an id for its content. Empty if the pipe can't be
+	// replaced by a reference.
+	Pipe *pipe = rank->getPipeAt(pipeIndex);
+	auto contentId = [this](const wxString &path) -> long {
+		auto it = m_fileIndexes.find(path);
+		if (it == m_fileIndexes.end() || !m_files[it->second].isReadable)
+			return 0;
+		const SAMPLE_FILE &file = m_files[it->second];
+		if (file.groupIndex > -1)
+			return -(file.groupIndex + 1);
+		return it->second + 1;
+	};
+
+	// the referencing pipe sounds like the source including its voicing, so
+	// the effective pipe and rank values have to match as well
+	int midiKeyNumber = pipe->midiKeyNumber;
+	if (midiKeyNumber < 0)
+		midiKeyNumber = rank->getFirstMidiNoteNumber() + (int) pipeIndex;
+	wxString signature = wxString::Format(
+		wxT("V%.9g,%.9g,%.9g,%.9g,%d,%d,%d,%.9g,%u,%d,%d,%d,%.9g,%.9g"),
+		rank->getAmplitudeLevel() * pipe->amplitudeLevel,
+		rank->getGain() + pipe->gain,
+		rank->getPitchTuning() + pipe->pitchTuning,
+		rank->getPitchCorrection() + pipe->pitchCorrection,
+		rank->getTrackerDelay() + pipe->trackerDelay,
+		pipe->harmonicNumber,
+		midiKeyNumber,
+		pipe->midiPitchFraction,
+		m_organ->getIndexOfOrganWindchest(pipe->windchest),
+		pipe->isPercussive ? 1 : 0,
+		pipe->hasIndependentRelease ? 1 : 0,
+		pipe->acceptsRetuning ? 1 : 0,
+		pipe->minVelocityVolume,
+		pipe->maxVelocityVolume
+	);
+	for (Attack &atk : pipe->m_attacks) {
+		long id = contentId(atk.fullPath);
+		if (!id)
+			return wxEmptyString;
+		signature += wxString::Format(
+			wxT("A%ld,%d,%d,%d,%d,%d,%d,%d,%d,%d,%d"),
+			id,
+			atk.loadRelease ? 1 : 0,
+			atk.attackVelocity,
+			atk.maxTimeSinceLastRelease,
+			atk.isTremulant,
+			atk.maxKeyPressTime,
+			atk.attackStart,
+			atk.cuePoint,
+			atk.releaseEnd,
+			atk.loopCrossfadeLength,
+			atk.releaseCrossfadeLength
+		);
+		for (Loop &loop : atk.m_loops)
+			signature += wxString::Format(wxT("L%d,%d"), loop.start, loop.end);
+	}
+	for (Release &rel : pipe->m_releases) {
+		long id = contentId(rel.fullPath);
+		if (!id)
+			return wxEmptyString;
+		signature += wxString::Format(
+			wxT("R%ld,%d,%d,%d,%d,%d"),
+			id,
+			rel.isTremulant,
+			rel.maxKeyPressTime,
+			rel.cuePoint,
+			rel.releaseEnd,
+			rel.releaseCrossfadeLength
+		);
+	}
+	return signature;
+}
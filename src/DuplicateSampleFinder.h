@@ -0,0 +1,123 @@
+/*
+ * DuplicateSampleFinder.h is part of GoOdf.
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * GoOdf is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GoOdf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GoOdf.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#ifndef DUPLICATESAMPLEFINDER_H
+#define DUPLICATESAMPLEFINDER_H
+
+#include <wx/wx.h>
+#include <vector>
+#include <map>
+#include <functional>
+
+class Organ;
+class Rank;
+
+// Finds sample files with identical content among all attacks and releases
+// of an organ. Files are first put in buckets by the size of their audio
+// data, and only files sharing a bucket are hashed, on all processors. For
+// wave files the format, data, smpl and cue chunks are hashed so that the
+// metadata GrandOrgue doesn't use is ignored, WavPack files are hashed whole.
+class DuplicateSampleFinder {
+public:
+	struct SAMPLE_USE {
+		Rank *rank;
+		wxString rankName;
+		unsigned pipeIndex;
+		bool isRelease;
+		unsigned sampleIndex;
+	};
+
+	struct DUPLICATE_GROUP {
+		unsigned long long dataSize;
+		std::vector<wxString> files;
+		std::vector<std::vector<SAMPLE_USE>> uses; // for each of the files
+	};
+
+	// A pipe whose samples all are the same as those of a pipe that can be
+	// borrowed with a REF:manual:stop:pipe reference
+	struct BORROWING_SUGGESTION {
+		Rank *rank;
+		wxString rankName;
+		unsigned pipeIndex;
+		wxString sourceDescription;
+		wxString refString;
+	};
+
+	DuplicateSampleFinder(Organ *organ);
+	~DuplicateSampleFinder();
+
+	// The progress gets the number of finished files and the total number
+	// of files to check and can return false to cancel the search
+	bool find(const std::function<bool(size_t, size_t)> &progress = nullptr);
+
+	unsigned getNumberOfSampleFiles() const;
+	const std::vector<DUPLICATE_GROUP>& getGroups() const;
+	unsigned long long getDuplicatedBytes() const;
+	const std::vector<BORROWING_SUGGESTION>& getBorrowingSuggestions() const;
+
+	// Makes all uses of the files of a group in each rank use the file that
+	// the rank uses first. Returns the number of changed samples.
+	unsigned shareFilesWithinRanks(const std::vector<unsigned> &groupIndexes);
+	// Turns the suggested pipes into references. Returns the number of pipes.
+	unsigned applyBorrowing(const std::vector<unsigned> &suggestionIndexes);
+
+	static wxString describeUse(const SAMPLE_USE &use);
+
+private:
+	struct SAMPLE_FILE {
+		wxString path;
+		std::vector<SAMPLE_USE> uses;
+		bool isReadable;
+		bool isWavPack;
+		unsigned long long contentSize;
+		unsigned long long hash;
+		std::vector<std::pair<unsigned long long, unsigned long long>> hashedRanges;
+		int groupIndex;
+	};
+
+	struct RANK_ENTRY {
+		Rank *rank;
+		wxString name;
+		// where the rank can be borrowed from, if anywhere
+		int manualNumber;
+		int stopNumber;
+		int accessiblePipes;
+	};
+
+	Organ *m_organ;
+	std::vector<RANK_ENTRY> m_ranks;
+	std::vector<SAMPLE_FILE> m_files;
+	std::map<wxString, unsigned> m_fileIndexes;
+	std::vector<DUPLICATE_GROUP> m_groups;
+	std::vector<BORROWING_SUGGESTION> m_suggestions;
+
+	void collectRanks();
+	void collectSampleFiles();
+	void scanFile(SAMPLE_FILE &file);
+	void hashFile(SAMPLE_FILE &file);
+	bool hasSameContent(const SAMPLE_FILE &first, const SAMPLE_FILE &second);
+	std::vector<std::vector<unsigned>> collectCandidateGroups();
+	void buildGroups(const std::vector<std::vector<unsigned>> &candidates, const std::vector<char> &isSame);
+	void addGroup(const std::vector<unsigned> &fileIndexes);
+	void buildBorrowingSuggestions();
+	wxString getPipeSignature(Rank *rank, unsigned pipeIndex);
+};
+
+#endif
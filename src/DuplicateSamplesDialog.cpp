@@ -0,0 +1,240 @@
+/*
+ * DuplicateSamplesDialog.cpp is part of GoOdf.
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * GoOdf is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GoOdf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GoOdf. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#include "DuplicateSamplesDialog.h"
+#include "GOODFDef.h"
+#include <wx/statline.h>
+#include <algorithm>
+
+IMPLEMENT_CLASS(DuplicateSamplesDialog, wxDialog)
+
+BEGIN_EVENT_TABLE(DuplicateSamplesDialog, wxDialog)
+	EVT_LIST_ITEM_SELECTED(ID_DUPLICATE_GROUPS_LIST, DuplicateSamplesDialog::OnGroupSelection)
+	EVT_LIST_ITEM_DESELECTED(ID_DUPLICATE_GROUPS_LIST, DuplicateSamplesDialog::OnGroupSelection)
+	EVT_LIST_ITEM_SELECTED(ID_BORROWING_SUGGESTIONS_LIST, DuplicateSamplesDialog::OnSuggestionSelection)
+	EVT_LIST_ITEM_DESELECTED(ID_BORROWING_SUGGESTIONS_LIST, DuplicateSamplesDialog::OnSuggestionSelection)
+	EVT_BUTTON(ID_SHARE_DUPLICATES_IN_RANKS_BTN, DuplicateSamplesDialog::OnShareInRanksBtn)
+	EVT_BUTTON(ID_APPLY_BORROWING_BTN, DuplicateSamplesDialog::OnApplyBorrowingBtn)
+END_EVENT_TABLE()
+
+DuplicateSamplesDialog::DuplicateSamplesDialog(DuplicateSampleFinder *finder) {
+	Init(finder);
+}
+
+DuplicateSamplesDialog::DuplicateSamplesDialog(
+	DuplicateSampleFinder *finder,
+	wxWindow* parent,
+	wxWindowID id,
+	const wxString& caption,
+	const wxPoint& pos,
+	const wxSize& size,
+	long style
+) {
+	Init(finder);
+	Create(parent, id, caption, pos, size, style);
+}
+
+DuplicateSamplesDialog::~DuplicateSamplesDialog() {
+
+}
+
+void DuplicateSamplesDialog::Init(DuplicateSampleFinder *finder) {
+	m_finder = finder;
+	m_numberOfChanges = 0;
+}
+
+bool DuplicateSamplesDialog::Create(
+	wxWindow* parent,
+	wxWindowID id,
+	const wxString& caption,
+	const wxPoint& pos,
+	const wxSize& size,
+	long style
+) {
+	if (!wxDialog::Create(parent, id, caption, pos, size, style))
+		return false;
+
+	CreateControls();
+	FillLists();
+	UpdateButtons();
+
+	GetSizer()->Fit(this);
+	GetSizer()->SetSizeHints(this);
+	Centre();
+
+	return true;
+}
+
+void DuplicateSamplesDialog::CreateControls() {
+	wxBoxSizer *mainSizer = new wxBoxSizer(wxVERTICAL);
+
+	wxStaticText *summaryText = new wxStaticText (
+		this,
+		wxID_STATIC,
+		wxString::Format(
+			wxT("Found %u groups of identical samples among %u sample files, using %.1f MB more than needed."),
+			(unsigned) m_finder->getGroups().size(),
+			m_finder->getNumberOfSampleFiles(),
+			m_finder->getDuplicatedBytes() / 1048576.0
+		)
+	);
+	mainSizer->Add(summaryText, 0, wxALL, 5);
+
+	wxStaticText *groupsText = new wxStaticText (
+		this,
+		wxID_STATIC,
+		wxT("Identical sample files:")
+	);
+	mainSizer->Add(groupsText, 0, wxLEFT|wxRIGHT|wxTOP, 5);
+	m_groupsList = new wxListCtrl(
+		this,
+		ID_DUPLICATE_GROUPS_LIST,
+		wxDefaultPosition,
+		wxSize(760, 200),
+		wxLC_REPORT
+	);
+	m_groupsList->AppendColumn(wxT("Group"), wxLIST_FORMAT_RIGHT, 50);
+	m_groupsList->AppendColumn(wxT("Data size"), wxLIST_FORMAT_RIGHT, 90);
+	m_groupsList->AppendColumn(wxT("File"), wxLIST_FORMAT_LEFT, 360);
+	m_groupsList->AppendColumn(wxT("Used by"), wxLIST_FORMAT_LEFT, 260);
+	mainSizer->Add(m_groupsList, 1, wxEXPAND|wxALL, 5);
+	m_shareInRanksBtn = new wxButton(
+		this,
+		ID_SHARE_DUPLICATES_IN_RANKS_BTN,
+		wxT("Use one file per rank for selected groups")
+	);
+	mainSizer->Add(m_shareInRanksBtn, 0, wxALIGN_RIGHT|wxLEFT|wxRIGHT|wxBOTTOM, 5);
+
+	wxStaticText *suggestionsText = new wxStaticText (
+		this,
+		wxID_STATIC,
+		wxT("Pipes that can borrow an identical pipe instead:")
+	);
+	mainSizer->Add(suggestionsText, 0, wxLEFT|wxRIGHT|wxTOP, 5);
+	m_suggestionsList = new wxListCtrl(
+		this,
+		ID_BORROWING_SUGGESTIONS_LIST,
+		wxDefaultPosition,
+		wxSize(760, 200),
+		wxLC_REPORT
+	);
+	m_suggestionsList->AppendColumn(wxT("Rank"), wxLIST_FORMAT_LEFT, 220);
+	m_suggestionsList->AppendColumn(wxT("Pipe"), wxLIST_FORMAT_RIGHT, 60);
+	m_suggestionsList->AppendColumn(wxT("Identical to"), wxLIST_FORMAT_LEFT, 280);
+	m_suggestionsList->AppendColumn(wxT("Reference"), wxLIST_FORMAT_LEFT, 160);
+	mainSizer->Add(m_suggestionsList, 1, wxEXPAND|wxALL, 5);
+	m_applyBorrowingBtn = new wxButton(
+		this,
+		ID_APPLY_BORROWING_BTN,
+		wxT("Borrow selected pipes")
+	);
+	mainSizer->Add(m_applyBorrowingBtn, 0, wxALIGN_RIGHT|wxLEFT|wxRIGHT|wxBOTTOM, 5);
+
+	wxStaticLine *bottomDivider = new wxStaticLine(this);
+	mainSizer->Add(bottomDivider, 0, wxEXPAND);
+
+	wxBoxSizer *bottomRow = new wxBoxSizer(wxHORIZONTAL);
+	bottomRow->AddStretchSpacer();
+	wxButton *theCloseButton = new wxButton(
+		this,
+		wxID_CANCEL,
+		wxT("Close")
+	);
+	bottomRow->Add(theCloseButton, 0, wxALIGN_CENTER|wxALL, 10);
+	bottomRow->AddStretchSpacer();
+	mainSizer->Add(bottomRow, 0, wxGROW);
+
+	SetSizer(mainSizer);
+}
+
+unsigned DuplicateSamplesDialog::GetNumberOfChanges() {
+	return m_numberOfChanges;
+}
+
+void DuplicateSamplesDialog::OnGroupSelection(wxListEvent& WXUNUSED(event)) {
+	UpdateButtons();
+}
+
+void DuplicateSamplesDialog::OnSuggestionSelection(wxListEvent& WXUNUSED(event)) {
+	UpdateButtons();
+}
+
+void DuplicateSamplesDialog::OnShareInRanksBtn(wxCommandEvent& WXUNUSED(event)) {
+	// several rows can belong to the same group
+	std::vector<unsigned> groups;
+	for (unsigned row : GetSelectedItems(m_groupsList)) {
+		unsigned group = m_groupsList->GetItemData(row);
+		if (std::find(groups.begin(), groups.end(), group) == groups.end())
+			groups.push_back(group);
+	}
+	m_numberOfChanges += m_finder->shareFilesWithinRanks(groups);
+	// the found groups no longer describe the organ
+	EndModal(wxID_OK);
+}
+
+void DuplicateSamplesDialog::OnApplyBorrowingBtn(wxCommandEvent& WXUNUSED(event)) {
+	m_numberOfChanges += m_finder->applyBorrowing(GetSelectedItems(m_suggestionsList));
+	EndModal(wxID_OK);
+}
+
+void DuplicateSamplesDialog::FillLists() {
+	const std::vector<DuplicateSampleFinder::DUPLICATE_GROUP> &groups = m_finder->getGroups();
+	long row = 0;
+	for (unsigned i = 0; i < groups.size(); i++) {
+		for (unsigned j = 0; j < groups[i].files.size(); j++) {
+			wxString usedBy;
+			const std::vector<DuplicateSampleFinder::SAMPLE_USE> &uses = groups[i].uses[j];
+			if (!uses.empty())
+				usedBy = DuplicateSampleFinder::describeUse(uses.front());
+			if (uses.size() > 1)
+				usedBy += wxString::Format(wxT(" and %u more"), (unsigned) uses.size() - 1);
+
+			m_groupsList->InsertItem(row, j == 0 ? wxString::Format(wxT("%u"), i + 1) : wxString());
+			m_groupsList->SetItem(row, 1, j == 0 ? wxString::Format(wxT("%.1f kB"), groups[i].dataSize / 1024.0) : wxString());
+			m_groupsList->SetItem(row, 2, groups[i].files[j]);
+			m_groupsList->SetItem(row, 3, usedBy);
+			m_groupsList->SetItemData(row, i);
+			row++;
+		}
+	}
+
+	const std::vector<DuplicateSampleFinder::BORROWING_SUGGESTION> &suggestions = m_finder->getBorrowingSuggestions();
+	for (unsigned i = 0; i < suggestions.size(); i++) {
+		m_suggestionsList->InsertItem(i, suggestions[i].rankName);
+		m_suggestionsList->SetItem(i, 1, wxString::Format(wxT("%u"), suggestions[i].pipeIndex + 1));
+		m_suggestionsList->SetItem(i, 2, suggestions[i].sourceDescription);
+		m_suggestionsList->SetItem(i, 3, suggestions[i].refString);
+	}
+}
+
+std::vector<unsigned> DuplicateSamplesDialog::GetSelectedItems(wxListCtrl *list) {
+	std::vector<unsigned> selected;
+	long item = list->GetNextItem(-1, wxLIST_NEXT_ALL, wxLIST_STATE_SELECTED);
+	while (item != -1) {
+		selected.push_back(item);
+		item = list->GetNextItem(item, wxLIST_NEXT_ALL, wxLIST_STATE_SELECTED);
+	}
+	return selected;
+}
+
+void DuplicateSamplesDialog::UpdateButtons() {
+	m_shareInRanksBtn->Enable(m_groupsList->GetSelectedItemCount() > 0);
+	m_applyBorrowingBtn->Enable(m_suggestionsList->GetSelectedItemCount() > 0);
+}
@@ -0,0 +1,86 @@
+/*
+ * DuplicateSamplesDialog.h is part of GoOdf.
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * GoOdf is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GoOdf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GoOdf. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#ifndef DUPLICATESAMPLESDIALOG_H
+#define DUPLICATESAMPLESDIALOG_H
+
+#include <wx/wx.h>
+#include <wx/listctrl.h>
+#include "DuplicateSampleFinder.h"
+
+class DuplicateSamplesDialog : public wxDialog {
+	DECLARE_CLASS(DuplicateSamplesDialog)
+	DECLARE_EVENT_TABLE()
+
+public:
+	// Constructors
+	DuplicateSamplesDialog(DuplicateSampleFinder *finder);
+	DuplicateSamplesDialog(
+		DuplicateSampleFinder *finder,
+		wxWindow* parent,
+		wxWindowID id = wxID_ANY,
+		const wxString& caption = wxT("Duplicate samples"),
+		const wxPoint& pos = wxDefaultPosition,
+		const wxSize& size = wxDefaultSize,
+		long style = wxCAPTION|wxRESIZE_BORDER|wxSYSTEM_MENU|wxCLOSE_BOX
+	);
+
+	~DuplicateSamplesDialog();
+
+	// Initialize our variables
+	void Init(DuplicateSampleFinder *finder);
+
+	// Creation
+	bool Create(
+		wxWindow* parent,
+		wxWindowID id = wxID_ANY,
+		const wxString& caption = wxT("Duplicate samples"),
+		const wxPoint& pos = wxDefaultPosition,
+		const wxSize& size = wxDefaultSize,
+		long style = wxCAPTION|wxRESIZE_BORDER|wxSYSTEM_MENU|wxCLOSE_BOX
+	);
+
+	// Creates the controls and sizers
+	void CreateControls();
+
+	// Accessors
+	unsigned GetNumberOfChanges();
+
+private:
+	DuplicateSampleFinder *m_finder;
+	unsigned m_numberOfChanges;
+
+	wxListCtrl *m_groupsList;
+	wxListCtrl *m_suggestionsList;
+	wxButton *m_shareInRanksBtn;
+	wxButton *m_applyBorrowingBtn;
+
+	// Event methods
+	void OnGroupSelection(wxListEvent& event);
+	void OnSuggestionSelection(wxListEvent& event);
+	void OnShareInRanksBtn(wxCommandEvent& event);
+	void OnApplyBorrowingBtn(wxCommandEvent& event);
+
+	void FillLists();
+	std::vector<unsigned> GetSelectedItems(wxListCtrl *list);
+	void UpdateButtons();
+};
+
+#endif
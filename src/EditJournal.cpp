@@ -0,0 +1,426 @@
+/*
+ * EditJournal.cpp is part of GoOdf.
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * GoOdf is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GoOdf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GoOdf.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#include "EditJournal.h"
+#include <wx/filename.h>
+#include <wx/stdpaths.h>
+#include <wx/dir.h>
+#include <wx/process.h>
+#include <wx/utils.h>
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include "Organ.h"
+#include "Instrumentation.h"
+
+namespace {
+
+	const char journalMagic[8] = { 'G', 'O', 'O', 'D', 'F', 'J', 'N', 'L' };
+	const uint32_t journalVersion = 1;
+
+	enum RecordType {
+		RECORD_BASE = 1,
+		RECORD_RECOVERY_PATH = 2,
+		RECORD_SECTION = 3,
+		RECORD_REMOVED_SECTION = 4
+	};
+
+	uint32_t checksum(const char *data, size_t length) {
+		uint32_t hash = 2166136261u;
+		for (size_t i = 0; i < length; i++) {
+			hash ^= (unsigned char) data[i];
+			hash *= 16777619u;
+		}
+		return hash;
+	}
+
+	// the journal is only ever read back on the machine that wrote it
+	void appendUint32(std::string &out, uint32_t value) {
+		out.append(reinterpret_cast<const char*>(&value), sizeof(value));
+	}
+
+	void appendString(std::string &out, const wxString &str) {
+		const wxScopedCharBuffer utf8 = str.utf8_str();
+		appendUint32(out, utf8.length());
+		out.append(utf8.data(), utf8.length());
+	}
+
+	// A record carries its length and a checksum so that one cut short by a
+	// crash is recognized and the replay stops there.
+	void appendRecord(std::string &out, RecordType type, const std::string &payload) {
+		std::string record(1, (char) type);
+		record.append(payload);
+		appendUint32(out, record.size());
+		out.append(record);
+		appendUint32(out, checksum(record.data(), record.size()));
+	}
+
+	class RecordReader {
+	public:
+		RecordReader(const char *data, size_t length) : m_pos(data), m_end(data + length) {}
+
+		bool readUint32(uint32_t &value) {
+			if ((size_t) (m_end - m_pos) < sizeof(value))
+				return false;
+			memcpy(&value, m_pos, sizeof(value));
+			m_pos += sizeof(value);
+			return true;
+		}
+
+		bool readString(wxString &str) {
+			uint32_t length;
+			if (!readUint32(length) || (size_t) (m_end - m_pos) < length)
+				return false;
+			str = wxString::FromUTF8(m_pos, length);
+			m_pos += length;
+			return true;
+		}
+
+		bool readRecord(int &type, RecordReader &payload) {
+			uint32_t length;
+			uint32_t storedChecksum;
+			if (!readUint32(length) || length == 0 || (size_t) (m_end - m_pos) < length + sizeof(storedChecksum))
+				return false;
+			const char *record = m_pos;
+			m_pos += length;
+			readUint32(storedChecksum);
+			if (checksum(record, length) != storedChecksum)
+				return false;
+			type = (unsigned char) record[0];
+			payload = RecordReader(record + 1, length - 1);
+			return true;
+		}
+
+		bool skip(size_t length) {
+			if ((size_t) (m_end - m_pos) < length)
+				return false;
+			m_pos += length;
+			return true;
+		}
+
+		const char* position() const {
+			return m_pos;
+		}
+
+	private:
+		const char *m_pos;
+		const char *m_end;
+	};
+
+	struct SectionEdit {
+		bool isRemoved;
+		wxArrayString lines;
+	};
+
+	// What a journal holds once replayed: the latest state of every section
+	// that was changed, in the order they were first changed.
+	struct JournalContents {
+		wxString basePath;
+		wxString recoveryPath;
+		std::vector<wxString> editOrder;
+		std::map<wxString, SectionEdit> edits;
+	};
+
+	bool isSectionHeader(const wxString &line) {
+		return line.StartsWith(wxT("[")) && line.EndsWith(wxT("]"));
+	}
+
+	unsigned long long hashLines(wxTextFile *lines, size_t first, size_t end) {
+		unsigned long long hash = 14695981039346656037ull;
+		for (size_t i = first; i < end; i++) {
+			const wxString &line = lines->GetLine(i);
+			for (wxString::const_iterator it = line.begin(); it != line.end(); ++it) {
+				hash ^= (unsigned long long) (*it).GetValue();
+				hash *= 1099511628211ull;
+			}
+			hash ^= '\n';
+			hash *= 1099511628211ull;
+		}
+		return hash;
+	}
+
+	bool readJournal(const wxString &journalPath, JournalContents &contents) {
+		wxFile in;
+		if (!in.Open(journalPath))
+			return false;
+		wxFileOffset length = in.Length();
+		if (length < (wxFileOffset) (sizeof(journalMagic) + sizeof(journalVersion)))
+			return false;
+		std::string data(length, '\0');
+		if (in.Read(&data[0], length) != length)
+			return false;
+
+		RecordReader reader(data.data(), data.size());
+		uint32_t version;
+		if (memcmp(reader.position(), journalMagic, sizeof(journalMagic)) != 0)
+			return false;
+		reader.skip(sizeof(journalMagic));
+		if (!reader.readUint32(version) || version != journalVersion)
+			return false;
+
+		int type;
+		RecordReader payload(NULL, 0);
+		while (reader.readRecord(type, payload)) {
+			if (type == RECORD_BASE) {
+				payload.readString(contents.basePath);
+			} else if (type == RECORD_RECOVERY_PATH) {
+				payload.readString(contents.recoveryPath);
+			} else if (type == RECORD_SECTION || type == RECORD_REMOVED_SECTION) {
+				wxString name;
+				if (!payload.readString(name))
+					break;
+				SectionEdit edit;
+				edit.isRemoved = type == RECORD_REMOVED_SECTION;
+				if (!edit.isRemoved) {
+					uint32_t nbrLines = 0;
+					payload.readUint32(nbrLines);
+					wxString line;
+					for (uint32_t i = 0; i < nbrLines && payload.readString(line); i++)
+						edit.lines.Add(line);
+				}
+				if (contents.edits.find(name) == contents.edits.end())
+					contents.editOrder.push_back(name);
+				contents.edits[name] = edit;
+			}
+		}
+		return true;
+	}
+
+}
+
+EditJournal::EditJournal() {
+	m_journalPath = getJournalDirectory() + wxFILE_SEP_PATH + wxString::Format(wxT("EditJournal-%lu.bin"), wxGetProcessId());
+	m_recordedModificationCount = 0;
+	m_isRecordedModificationCountKnown = false;
+}
+
+EditJournal::~EditJournal() {
+	if (m_file.IsOpened())
+		m_file.Close();
+}
+
+void EditJournal::reset(const wxString &basePath, wxTextFile *baseLines, const std::map<wxString, unsigned long long> *cachedSections) {
+	// hashes of cached sections are kept as the same caches make up the new base
+	m_sectionHashes.clear();
+	m_recoveryPath = wxEmptyString;
+	m_isRecordedModificationCountKnown = false;
+	if (m_file.IsOpened())
+		m_file.Close();
+	if (!wxFileName::DirExists(getJournalDirectory()))
+		wxFileName::Mkdir(getJournalDirectory(), wxS_DIR_DEFAULT, wxPATH_MKDIR_FULL);
+	// re-creating the file truncates what was recorded against the old base
+	if (!m_file.Create(m_journalPath, true))
+		return;
+
+	std::string header(journalMagic, sizeof(journalMagic));
+	appendUint32(header, journalVersion);
+	std::string payload;
+	appendString(payload, basePath);
+	appendRecord(header, RECORD_BASE, payload);
+	appendRecords(header);
+
+	if (baseLines)
+		recordSections(baseLines, cachedSections ? *cachedSections : std::map<wxString, unsigned long long>(), NULL);
+}
+
+void EditJournal::checkpoint(Organ *organ, const wxString &recoveryPath) {
+	if (!m_file.IsOpened())
+		return;
+	// nothing has been edited since the last checkpoint
+	if (m_isRecordedModificationCountKnown && m_recordedModificationCount == organ->getModificationCount() && recoveryPath == m_recoveryPath)
+		return;
+	ScopedTimer checkpointTimer("journal.checkpoint");
+	wxTextFile lines;
+	std::map<wxString, unsigned long long> cachedSections;
+	// the warnings of the organ are only shown when it's saved
+	organ->getContext()->setDiscardingDiagnostics(true);
+	organ->writeOrgan(&lines, &cachedSections);
+	organ->getContext()->setDiscardingDiagnostics(false);
+	m_recordedModificationCount = organ->getModificationCount();
+	m_isRecordedModificationCountKnown = true;
+
+	std::string records;
+	if (recoveryPath != m_recoveryPath) {
+		std::string payload;
+		appendString(payload, recoveryPath);
+		appendRecord(records, RECORD_RECOVERY_PATH, payload);
+		m_recoveryPath = recoveryPath;
+	}
+
+	recordSections(&lines, cachedSections, &records);
+	if (!records.empty())
+		appendRecords(records);
+}
+
+void EditJournal::discard() {
+	if (m_file.IsOpened())
+		m_file.Close();
+	if (wxFileExists(m_journalPath))
+		wxRemoveFile(m_journalPath);
+	m_sectionHashes.clear();
+}
+
+wxArrayString EditJournal::findAbandonedJournals() {
+	wxArrayString abandoned;
+	wxString directory = getJournalDirectory();
+	if (!wxDir::Exists(directory))
+		return abandoned;
+	wxArrayString journals;
+	wxDir::GetAllFiles(directory, &journals, wxT("EditJournal-*.bin"), wxDIR_FILES);
+	for (unsigned i = 0; i < journals.GetCount(); i++) {
+		unsigned long pid = 0;
+		wxString name = wxFileName(journals[i]).GetName();
+		if (!name.AfterFirst(wxT('-')).ToULong(&pid))
+			continue;
+		if (pid != wxGetProcessId() && !wxProcess::Exists((int) pid))
+			abandoned.Add(journals[i]);
+	}
+	return abandoned;
+}
+
+bool EditJournal::hasRecoverableEdits(const wxString &journalPath) {
+	JournalContents contents;
+	return readJournal(journalPath, contents) && !contents.edits.empty();
+}
+
+bool EditJournal::recover(const wxString &journalPath, wxString &recoveredPath) {
+	JournalContents contents;
+	if (!readJournal(journalPath, contents) || contents.edits.empty())
+		return false;
+
+	// the sections of the file the journal was started from
+	std::vector<wxString> order;
+	std::map<wxString, wxArrayString> sections;
+	wxTextFile base;
+	if (!contents.basePath.IsEmpty() && wxFileExists(contents.basePath) && base.Open(contents.basePath)) {
+		wxString current = wxEmptyString;
+		order.push_back(current);
+		for (size_t i = 0; i < base.GetLineCount(); i++) {
+			const wxString &line = base.GetLine(i);
+			if (isSectionHeader(line)) {
+				current = line;
+				if (sections.find(current) == sections.end())
+					order.push_back(current);
+				sections[current].Clear();
+			} else {
+				sections[current].Add(line);
+			}
+		}
+	}
+
+	// with the recorded sections replacing, removing or adding to them
+	wxArrayString lines;
+	for (unsigned i = 0; i < order.size(); i++) {
+		std::map<wxString, SectionEdit>::iterator edit = contents.edits.find(order[i]);
+		if (edit != contents.edits.end() && edit->second.isRemoved)
+			continue;
+		if (!order[i].IsEmpty())
+			lines.Add(order[i]);
+		const wxArrayString &sectionLines = edit != contents.edits.end() ? edit->second.lines : sections[order[i]];
+		for (unsigned j = 0; j < sectionLines.GetCount(); j++)
+			lines.Add(sectionLines[j]);
+	}
+	for (unsigned i = 0; i < contents.editOrder.size(); i++) {
+		const wxString &name = contents.editOrder[i];
+		const SectionEdit &edit = contents.edits[name];
+		if (sections.find(name) != sections.end() || edit.isRemoved)
+			continue;
+		lines.Add(name);
+		for (unsigned j = 0; j < edit.lines.GetCount(); j++)
+			lines.Add(edit.lines[j]);
+	}
+
+	recoveredPath = contents.recoveryPath;
+	if (recoveredPath.IsEmpty())
+		recoveredPath = wxStandardPaths::Get().GetDocumentsDir() + wxFILE_SEP_PATH + wxT("Recovered.organ");
+	wxFile outFile;
+	if (!outFile.Create(recoveredPath, true))
+		return false;
+	std::string content("\xef\xbb\xbf");
+	for (unsigned i = 0; i < lines.GetCount(); i++) {
+		const wxScopedCharBuffer utf8 = lines[i].utf8_str();
+		content.append(utf8.data(), utf8.length());
+		content.append("\r\n");
+	}
+	bool isOk = outFile.Write(content.data(), content.size()) == content.size();
+	return outFile.Close() && isOk;
+}
+
+void EditJournal::recordSections(wxTextFile *lines, const std::map<wxString, unsigned long long> &cachedSections, std::string *records) {
+	// Only the sections that differ from what was recorded before are added
+	// to the records. A section from a cache that was hashed before has the
+	// same content, so only sections stored or written anew are hashed.
+	std::map<wxString, unsigned long long> sectionHashes;
+	std::map<unsigned long long, unsigned long long> hashesByStamp;
+	size_t nbrLines = lines->GetLineCount();
+	size_t start = 0;
+	while (start < nbrLines) {
+		size_t end = start + 1;
+		while (end < nbrLines && !isSectionHeader(lines->GetLine(end)))
+			end++;
+		const wxString &name = lines->GetLine(start);
+		unsigned long long hash;
+		std::map<wxString, unsigned long long>::const_iterator cached = cachedSections.find(name);
+		std::map<unsigned long long, unsigned long long>::iterator known = m_hashesByStamp.end();
+		if (cached != cachedSections.end())
+			known = m_hashesByStamp.find(cached->second);
+		if (known != m_hashesByStamp.end())
+			hash = known->second;
+		else
+			hash = hashLines(lines, start + 1, end);
+		if (cached != cachedSections.end())
+			hashesByStamp[cached->second] = hash;
+		sectionHashes[name] = hash;
+		std::map<wxString, unsigned long long>::iterator recorded = m_sectionHashes.find(name);
+		if (records && (recorded == m_sectionHashes.end() || recorded->second != hash)) {
+			std::string payload;
+			appendString(payload, name);
+			appendUint32(payload, end - start - 1);
+			for (size_t i = start + 1; i < end; i++)
+				appendString(payload, lines->GetLine(i));
+			appendRecord(*records, RECORD_SECTION, payload);
+		}
+		start = end;
+	}
+	if (records) {
+		for (std::map<wxString, unsigned long long>::iterator it = m_sectionHashes.begin(); it != m_sectionHashes.end(); ++it) {
+			if (sectionHashes.find(it->first) == sectionHashes.end()) {
+				std::string payload;
+				appendString(payload, it->first);
+				appendRecord(*records, RECORD_REMOVED_SECTION, payload);
+			}
+		}
+	}
+	m_sectionHashes.swap(sectionHashes);
+	m_hashesByStamp.swap(hashesByStamp);
+}
+
+void EditJournal::appendRecords(const std::string &records) {
+	// one write per checkpoint, which is enough to survive the application
+	// crashing as the data is then already handed over to the system
+	if (m_file.Write(records.data(), records.size()) != records.size()) {
+		m_file.Close();
+		wxLogWarning(wxT("The edit journal couldn't be written, unsaved changes can't be recovered after a crash."));
+	}
+}
+
+wxString EditJournal::getJournalDirectory() {
+	return wxStandardPaths::Get().GetUserDataDir();
+}
@@ -0,0 +1,72 @@
+/*
+ * EditJournal.h is part of GoOdf.
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * GoOdf is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GoOdf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GoOdf.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#ifndef EDITJOURNAL_H
+#define EDITJOURNAL_H
+
+#include <wx/wx.h>
+#include <wx/textfile.h>
+#include <wx/file.h>
+#include <map>
+#include <string>
+
+class Organ;
+
+// An append-only record of the edits made since the organ was opened or
+// last saved, used to recover the work after a crash. At each checkpoint
+// the organ is serialized in memory and only the sections that differ from
+// what was recorded before are appended, so the cost is one write of the
+// changed sections rather than a full rewrite of the .organ file. A section
+// the organ takes from a cache is only hashed again when the cache has been
+// stored anew since. The journal starts over from the written file after
+// every successful save.
+class EditJournal {
+public:
+	EditJournal();
+	~EditJournal();
+
+	void reset(const wxString &basePath, wxTextFile *baseLines = NULL, const std::map<wxString, unsigned long long> *cachedSections = NULL);
+	void checkpoint(Organ *organ, const wxString &recoveryPath);
+	void discard();
+
+	// Journals left behind by instances that are no longer running
+	static wxArrayString findAbandonedJournals();
+	static bool hasRecoverableEdits(const wxString &journalPath);
+	static bool recover(const wxString &journalPath, wxString &recoveredPath);
+
+private:
+	wxString m_journalPath;
+	wxFile m_file;
+	std::map<wxString, unsigned long long> m_sectionHashes;
+	std::map<unsigned long long, unsigned long long> m_hashesByStamp;
+	wxString m_recoveryPath;
+	unsigned m_recordedModificationCount;
+	bool m_isRecordedModificationCountKnown;
+
+	void recordSections(wxTextFile *lines, const std::map<wxString, unsigned long long> &cachedSections, std::string *records);
+	void appendRecords(const std::string &records);
+
+	static wxString getJournalDirectory();
+
+	EditJournal(const EditJournal&) = delete;
+	EditJournal& operator=(const EditJournal&) = delete;
+};
+
+#endif
@@ -0,0 +1,288 @@
+/*
+ * EnvelopeAnalyzer.cpp is part of GoOdf.
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * GoOdf is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GoOdf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GoOdf.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#include "EnvelopeAnalyzer.h"
+#include "Rank.h"
+#include "SampleReader.h"
+#include "SignalKernels.h"
+#include "WAVfileParser.h"
+#include "WorkerPool.h"
+#include "Instrumentation.h"
+#include "GOODFFunctions.h"
+#include <algorithm>
+#include <cmath>
+
+// the envelope has one value per 10 ms
+static const unsigned BLOCKS_PER_SECOND = 100;
+// a release must fall this far below the sustain to be detected
+static const float RELEASE_DECAY_DB = -20.0f;
+// the noise floor is this percentile of the release envelope
+static const float NOISE_FLOOR_PERCENTILE = 0.1f;
+// and the release ends at least this much above it
+static const float NOISE_FLOOR_MARGIN_DB = 6.0f;
+
+namespace {
+
+	float dbToLevel(float db) {
+		return std::pow(10.0f, db / 20.0f);
+	}
+
+	float percentile(std::vector<float> values, float share) {
+		if (values.empty())
+			return 0;
+		size_t index = std::min(values.size() - 1, (size_t) (share * values.size()));
+		std::nth_element(values.begin(), values.begin() + index, values.end());
+		return values[index];
+	}
+
+}
+
+bool EnvelopeAnalyzer::SAMPLE_PROPOSAL::hasChanges() const {
+	return proposedAttackStart != -1 || proposedCuePoint != -1 || proposedReleaseEnd != -1;
+}
+
+bool EnvelopeAnalyzer::computeEnvelope(SampleReader &reader, unsigned blockFrames, ENVELOPE &envelope) {
+	envelope.blockFrames = blockFrames;
+	envelope.rms.clear();
+	envelope.peak.clear();
+	envelope.maxPeak = 0;
+	if (!reader.seek(0))
+		return false;
+	unsigned channels = reader.getNumberOfChannels();
+	std::vector<float> buffer((size_t) blockFrames * channels);
+	unsigned framesRead;
+	while ((framesRead = reader.read(buffer.data(), blockFrames)) > 0) {
+		size_t values = (size_t) framesRead * channels;
+		float peak = SignalKernels::peakAbsolute(buffer.data(), values);
+		envelope.rms.push_back(std::sqrt(SignalKernels::sumOfSquares(buffer.data(), values) / values));
+		envelope.peak.push_back(peak);
+		envelope.maxPeak = std::max(envelope.maxPeak, peak);
+	}
+	return !envelope.rms.empty();
+}
+
+bool EnvelopeAnalyzer::analyzeSample(const ENVELOPE_SETTINGS &settings, SAMPLE_PROPOSAL &proposal) {
+	proposal.proposedAttackStart = -1;
+	proposal.proposedCuePoint = -1;
+	proposal.proposedReleaseEnd = -1;
+	SampleReader reader(proposal.fullPath);
+	if (!reader.isOk()) {
+		proposal.errorMessage = reader.getErrorMessage();
+		return false;
+	}
+	unsigned frames = reader.getNumberOfFrames();
+	unsigned blockFrames = std::max(1u, reader.getSampleRate() / BLOCKS_PER_SECOND);
+	ENVELOPE envelope;
+	if (!computeEnvelope(reader, blockFrames, envelope) || envelope.maxPeak <= 0) {
+		proposal.errorMessage = wxT("The sample is silent.\n");
+		return false;
+	}
+	unsigned numberOfBlocks = envelope.rms.size();
+
+	// loops and cue in the sample are used when the .organ file has none
+	WAVfileParser sample(proposal.fullPath);
+	std::vector<std::pair<unsigned, unsigned>> loops = proposal.loops;
+	if (loops.empty()) {
+		for (unsigned i = 0; i < sample.getNumberOfLoops(); i++) {
+			LOOP loop = sample.getLoopAtIndex(i);
+			loops.push_back(std::make_pair(loop.dwStart, loop.dwEnd));
+		}
+	}
+	unsigned firstLoopStart = frames;
+	unsigned lastLoopEnd = 0;
+	for (std::pair<unsigned, unsigned> &loop : loops) {
+		firstLoopStart = std::min(firstLoopStart, loop.first);
+		lastLoopEnd = std::max(lastLoopEnd, loop.second);
+	}
+	int cuePoint = proposal.cuePoint;
+	if (cuePoint < 0 && sample.getNumberOfCues() > 0)
+		cuePoint = sample.getCuepointAtIndex(0).dwSampleOffset;
+
+	if (!proposal.isRelease && settings.detectAttackStart && !(settings.onlyUnset && proposal.attackStart != 0)) {
+		// the first frame that reaches the threshold, from the zero crossing before it
+		float level = envelope.maxPeak * dbToLevel(settings.attackStartThreshold);
+		unsigned block = 0;
+		while (block < numberOfBlocks && envelope.peak[block] < level)
+			block++;
+		std::vector<float> frameValues;
+		unsigned first = block * blockFrames;
+		if (block < numberOfBlocks && reader.readRange(first, std::min(frames, first + blockFrames), frameValues)) {
+			unsigned channels = reader.getNumberOfChannels();
+			size_t index = 0;
+			while (index < frameValues.size() && std::fabs(frameValues[index]) < level)
+				index++;
+			unsigned start = findZeroCrossingBefore(reader, first + index / channels, blockFrames);
+			if (start != (unsigned) proposal.attackStart && start < firstLoopStart && (cuePoint <= 0 || start < (unsigned) cuePoint))
+				proposal.proposedAttackStart = start;
+		}
+	}
+
+	if (!proposal.isRelease && proposal.hasRelease && settings.detectCuePoint && !(settings.onlyUnset && proposal.cuePoint != -1) && numberOfBlocks > 10) {
+		// The release starts where the envelope falls below the sustain for good
+		unsigned firstSustainBlock = numberOfBlocks / 10;
+		unsigned lastSustainBlock = numberOfBlocks / 2;
+		if (!loops.empty()) {
+			firstSustainBlock = std::min(numberOfBlocks - 1, firstLoopStart / blockFrames);
+			lastSustainBlock = std::min(numberOfBlocks - 1, lastLoopEnd / blockFrames);
+		}
+		lastSustainBlock = std::max(lastSustainBlock, firstSustainBlock);
+		std::vector<float> sustain(envelope.rms.begin() + firstSustainBlock, envelope.rms.begin() + lastSustainBlock + 1);
+		float sustainLevel = percentile(sustain, 0.5f);
+		unsigned tailBlocks = std::min(5u, numberOfBlocks);
+		float tailLevel = 0;
+		for (unsigned b = numberOfBlocks - tailBlocks; b < numberOfBlocks; b++)
+			tailLevel += envelope.rms[b] / tailBlocks;
+		if (sustainLevel > 0 && tailLevel < sustainLevel * dbToLevel(RELEASE_DECAY_DB)) {
+			float level = sustainLevel * dbToLevel(settings.cuePointThreshold);
+			unsigned block = numberOfBlocks - 1;
+			while (block > firstSustainBlock && envelope.rms[block] < level)
+				block--;
+			unsigned cue = findZeroCrossingBefore(reader, std::min(frames - 1, (block + 1) * blockFrames), blockFrames);
+			if (!loops.empty() && cue <= lastLoopEnd)
+				cue = lastLoopEnd + 1;
+			if (cue < frames - 1 && (int) cue != proposal.cuePoint) {
+				proposal.proposedCuePoint = cue;
+				cuePoint = cue;
+			}
+		}
+	}
+
+	if ((proposal.isRelease || proposal.hasRelease) && settings.detectReleaseEnd && !(settings.onlyUnset && proposal.releaseEnd != -1)) {
+		// The release ends where it has faded to the threshold or into the noise floor
+		unsigned releaseStart = proposal.isRelease || cuePoint < 0 ? 0 : cuePoint;
+		unsigned firstBlock = std::min(numberOfBlocks, releaseStart / blockFrames);
+		std::vector<float> release(envelope.rms.begin() + firstBlock, envelope.rms.end());
+		if (release.size() >= 4) {
+			float noiseFloor = percentile(release, NOISE_FLOOR_PERCENTILE);
+			float level = std::max(envelope.maxPeak * dbToLevel(settings.releaseEndThreshold), noiseFloor * dbToLevel(NOISE_FLOOR_MARGIN_DB));
+			unsigned block = numberOfBlocks - 1;
+			while (block > firstBlock && envelope.rms[block] < level)
+				block--;
+			unsigned end = std::min(frames - 1, (block + 1) * blockFrames);
+			// only worth it when it shortens the sample
+			if (end + blockFrames < frames - 1 && end > releaseStart && (int) end != proposal.releaseEnd)
+				proposal.proposedReleaseEnd = end;
+		}
+	}
+	return true;
+}
+
+bool EnvelopeAnalyzer::analyzeRank(
+	Rank *rank,
+	const ENVELOPE_SETTINGS &settings,
+	std::vector<SAMPLE_PROPOSAL> &proposals,
+	const std::function<bool(size_t, size_t)> &progress
+) {
+	ScopedTimer timer("analysis.envelopes");
+	proposals.clear();
+	rank->loadPipes();
+
+	// the samples are copied so that the workers never touch the organ
+	unsigned pipeIndex = 0;
+	for (Pipe &pipe : rank->m_pipes) {
+		unsigned attackIndex = 0;
+		for (Attack &atk : pipe.m_attacks) {
+			if (GOODF_functions::isSampleFilePath(atk.fullPath)) {
+				SAMPLE_PROPOSAL proposal;
+				proposal.pipeIndex = pipeIndex;
+				proposal.isRelease = false;
+				proposal.sampleIndex = attackIndex;
+				proposal.fileName = atk.fileName;
+				proposal.fullPath = atk.fullPath;
+				proposal.attackStart = atk.attackStart;
+				proposal.cuePoint = atk.cuePoint;
+				proposal.releaseEnd = atk.releaseEnd;
+				proposal.hasRelease = atk.loadRelease;
+				for (Loop &loop : atk.m_loops)
+					proposal.loops.push_back(std::make_pair((unsigned) loop.start, (unsigned) loop.end));
+				proposals.push_back(proposal);
+			}
+			attackIndex++;
+		}
+		unsigned releaseIndex = 0;
+		for (Release &rel : pipe.m_releases) {
+			if (GOODF_functions::isSampleFilePath(rel.fullPath)) {
+				SAMPLE_PROPOSAL proposal;
+				proposal.pipeIndex = pipeIndex;
+				proposal.isRelease = true;
+				proposal.sampleIndex = releaseIndex;
+				proposal.fileName = rel.fileName;
+				proposal.fullPath = rel.fullPath;
+				proposal.attackStart = 0;
+				proposal.cuePoint = rel.cuePoint;
+				proposal.releaseEnd = rel.releaseEnd;
+				proposal.hasRelease = true;
+				proposals.push_back(proposal);
+			}
+			releaseIndex++;
+		}
+		pipeIndex++;
+	}
+
+	size_t total = proposals.size();
+	return WorkerPool::run(
+		proposals.size(),
+		[&](size_t index) { analyzeSample(settings, proposals[index]); },
+		[&](size_t done) { return !progress || progress(done, total); }
+	);
+}
+
+unsigned EnvelopeAnalyzer::applyProposals(Rank *rank, const std::vector<SAMPLE_PROPOSAL> &proposals) {
+	unsigned changed = 0;
+	for (const SAMPLE_PROPOSAL &proposal : proposals) {
+		if (!proposal.hasChanges() || proposal.pipeIndex >= rank->m_pipes.size())
+			continue;
+		Pipe *pipe = rank->getPipeAt(proposal.pipeIndex);
+		if (proposal.isRelease) {
+			if (proposal.sampleIndex >= pipe->m_releases.size())
+				continue;
+			Release &rel = *std::next(pipe->m_releases.begin(), proposal.sampleIndex);
+			if (proposal.proposedReleaseEnd != -1)
+				rel.releaseEnd = proposal.proposedReleaseEnd;
+		} else {
+			if (proposal.sampleIndex >= pipe->m_attacks.size())
+				continue;
+			Attack &atk = *std::next(pipe->m_attacks.begin(), proposal.sampleIndex);
+			if (proposal.proposedAttackStart != -1)
+				atk.attackStart = proposal.proposedAttackStart;
+			if (proposal.proposedCuePoint != -1)
+				atk.cuePoint = proposal.proposedCuePoint;
+			if (proposal.proposedReleaseEnd != -1)
+				atk.releaseEnd = proposal.proposedReleaseEnd;
+		}
+		changed++;
+	}
+	return changed;
+}
+
+unsigned EnvelopeAnalyzer::findZeroCrossingBefore(SampleReader &reader, unsigned frame, unsigned maxDistance) {
+	unsigned first = frame > maxDistance ? frame - maxDistance : 0;
+	std::vector<float> interleaved;
+	if (frame <= first || !reader.readRange(first, frame + 1, interleaved))
+		return frame;
+	unsigned length = frame + 1 - first;
+	std::vector<float> mono(length);
+	SignalKernels::mixToMono(interleaved.data(), reader.getNumberOfChannels(), mono.data(), length);
+	for (unsigned i = length - 1; i > 0; i--) {
+		if ((mono[i - 1] <= 0 && mono[i] > 0) || (mono[i - 1] >= 0 && mono[i] < 0))
+			return first + i;
+	}
+	return frame;
+}
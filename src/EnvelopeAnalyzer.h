@@ -0,0 +1,96 @@
+/*
+ * EnvelopeAnalyzer.h is part of GoOdf.
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * GoOdf is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GoOdf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GoOdf.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#ifndef ENVELOPEANALYZER_H
+#define ENVELOPEANALYZER_H
+
+#include <wx/wx.h>
+#include <vector>
+#include <functional>
+
+class Rank;
+class SampleReader;
+
+// Follows the RMS and peak envelope of samples in short blocks to propose
+// where an attack should start playing (AttackStart), where the release
+// of an attack begins (CuePoint) and where a release has faded into the
+// noise floor (ReleaseEnd). All thresholds are in dB.
+class EnvelopeAnalyzer {
+public:
+	struct ENVELOPE_SETTINGS {
+		bool detectAttackStart;
+		// relative to the peak of the sample
+		float attackStartThreshold;
+		bool detectCuePoint;
+		// relative to the level of the sustain
+		float cuePointThreshold;
+		bool detectReleaseEnd;
+		// relative to the peak of the sample, never below the noise floor
+		float releaseEndThreshold;
+		// values that are already set are kept
+		bool onlyUnset;
+	};
+
+	struct ENVELOPE {
+		unsigned blockFrames;
+		std::vector<float> rms;
+		std::vector<float> peak;
+		float maxPeak;
+	};
+
+	// A proposed value of -1 means that nothing is proposed for it
+	struct SAMPLE_PROPOSAL {
+		unsigned pipeIndex;
+		bool isRelease;
+		// index among the attacks or the releases of the pipe
+		unsigned sampleIndex;
+		wxString fileName;
+		wxString fullPath;
+		// the current values and the loops, copied from the sample
+		int attackStart;
+		int cuePoint;
+		int releaseEnd;
+		bool hasRelease;
+		std::vector<std::pair<unsigned, unsigned>> loops;
+		int proposedAttackStart;
+		int proposedCuePoint;
+		int proposedReleaseEnd;
+		wxString errorMessage;
+
+		bool hasChanges() const;
+	};
+
+	static bool computeEnvelope(SampleReader &reader, unsigned blockFrames, ENVELOPE &envelope);
+	static bool analyzeSample(const ENVELOPE_SETTINGS &settings, SAMPLE_PROPOSAL &proposal);
+	// Analyzes all attacks and releases of the rank on the worker pool
+	static bool analyzeRank(
+		Rank *rank,
+		const ENVELOPE_SETTINGS &settings,
+		std::vector<SAMPLE_PROPOSAL> &proposals,
+		const std::function<bool(size_t, size_t)> &progress = nullptr
+	);
+	// Returns the number of samples that were changed
+	static unsigned applyProposals(Rank *rank, const std::vector<SAMPLE_PROPOSAL> &proposals);
+
+private:
+	static unsigned findZeroCrossingBefore(SampleReader &reader, unsigned frame, unsigned maxDistance);
+};
+
+#endif
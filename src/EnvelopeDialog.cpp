@@ -0,0 +1,219 @@
+/*
+ * EnvelopeDialog.cpp is part of GoOdf.
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * GoOdf is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GoOdf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GoOdf. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#include "EnvelopeDialog.h"
+#include "GOODFDef.h"
+#include "GOODFFunctions.h"
+#include "Rank.h"
+#include <wx/statline.h>
+#include <algorithm>
+
+IMPLEMENT_CLASS(EnvelopeDialog, wxDialog)
+
+BEGIN_EVENT_TABLE(EnvelopeDialog, wxDialog)
+	EVT_BUTTON(ID_ENVELOPE_ANALYZE_BTN, EnvelopeDialog::OnAnalyzeBtn)
+	EVT_BUTTON(ID_ENVELOPE_APPLY_BTN, EnvelopeDialog::OnApplyBtn)
+END_EVENT_TABLE()
+
+EnvelopeDialog::EnvelopeDialog(Rank *rank) {
+	Init(rank);
+}
+
+EnvelopeDialog::EnvelopeDialog(
+	Rank *rank,
+	wxWindow* parent,
+	wxWindowID id,
+	const wxString& caption,
+	const wxPoint& pos,
+	const wxSize& size,
+	long style
+) {
+	Init(rank);
+	Create(parent, id, caption, pos, size, style);
+}
+
+EnvelopeDialog::~EnvelopeDialog() {
+
+}
+
+void EnvelopeDialog::Init(Rank *rank) {
+	m_rank = rank;
+	m_numberOfChanges = 0;
+}
+
+bool EnvelopeDialog::Create(
+	wxWindow* parent,
+	wxWindowID id,
+	const wxString& caption,
+	const wxPoint& pos,
+	const wxSize& size,
+	long style
+) {
+	if (!wxDialog::Create(parent, id, caption, pos, size, style))
+		return false;
+
+	CreateControls();
+
+	GetSizer()->Fit(this);
+	GetSizer()->SetSizeHints(this);
+	Centre();
+
+	return true;
+}
+
+void EnvelopeDialog::CreateControls() {
+	wxBoxSizer *mainSizer = new wxBoxSizer(wxVERTICAL);
+
+	wxStaticText *infoText = new wxStaticText (
+		this,
+		wxID_STATIC,
+		wxT("The envelope of every attack and release of ") + m_rank->getName() + wxT(" is analyzed with the thresholds below.")
+	);
+	mainSizer->Add(infoText, 0, wxALL, 5);
+
+	m_attackStartCheck = new wxCheckBox(this, wxID_ANY, wxT("Set AttackStart where the attack reaches"));
+	m_attackStartCheck->SetValue(true);
+	m_attackStartSpin = new wxSpinCtrlDouble(this, wxID_ANY, wxEmptyString, wxDefaultPosition, wxDefaultSize, wxSP_ARROW_KEYS, -120, 0, -40, 0.5);
+	AddThresholdRow(mainSizer, m_attackStartCheck, m_attackStartSpin, wxT("dB below the peak"));
+	m_cuePointCheck = new wxCheckBox(this, wxID_ANY, wxT("Set CuePoint where the sustain has fallen by"));
+	m_cuePointCheck->SetValue(true);
+	m_cuePointSpin = new wxSpinCtrlDouble(this, wxID_ANY, wxEmptyString, wxDefaultPosition, wxDefaultSize, wxSP_ARROW_KEYS, -60, 0, -6, 0.5);
+	AddThresholdRow(mainSizer, m_cuePointCheck, m_cuePointSpin, wxT("dB (attacks with release only)"));
+	m_releaseEndCheck = new wxCheckBox(this, wxID_ANY, wxT("Set ReleaseEnd where the release has faded to"));
+	m_releaseEndCheck->SetValue(true);
+	m_releaseEndSpin = new wxSpinCtrlDouble(this, wxID_ANY, wxEmptyString, wxDefaultPosition, wxDefaultSize, wxSP_ARROW_KEYS, -120, 0, -60, 0.5);
+	AddThresholdRow(mainSizer, m_releaseEndCheck, m_releaseEndSpin, wxT("dB below the peak, or the noise floor"));
+	m_onlyUnsetCheck = new wxCheckBox(this, wxID_ANY, wxT("Keep values that are already set"));
+	m_onlyUnsetCheck->SetValue(true);
+	mainSizer->Add(m_onlyUnsetCheck, 0, wxALL, 5);
+	wxButton *analyzeBtn = new wxButton(
+		this,
+		ID_ENVELOPE_ANALYZE_BTN,
+		wxT("Analyze")
+	);
+	mainSizer->Add(analyzeBtn, 0, wxALIGN_RIGHT|wxLEFT|wxRIGHT|wxBOTTOM, 5);
+
+	m_proposalList = new wxListCtrl(
+		this,
+		ID_ENVELOPE_PROPOSAL_LIST,
+		wxDefaultPosition,
+		wxSize(820, 300),
+		wxLC_REPORT|wxLC_SINGLE_SEL
+	);
+	m_proposalList->AppendColumn(wxT("Pipe"), wxLIST_FORMAT_RIGHT, 60);
+	m_proposalList->AppendColumn(wxT("Sample"), wxLIST_FORMAT_LEFT, 260);
+	m_proposalList->AppendColumn(wxT("AttackStart"), wxLIST_FORMAT_LEFT, 160);
+	m_proposalList->AppendColumn(wxT("CuePoint"), wxLIST_FORMAT_LEFT, 160);
+	m_proposalList->AppendColumn(wxT("ReleaseEnd"), wxLIST_FORMAT_LEFT, 160);
+	mainSizer->Add(m_proposalList, 1, wxEXPAND|wxALL, 5);
+	m_applyBtn = new wxButton(
+		this,
+		ID_ENVELOPE_APPLY_BTN,
+		wxT("Apply all proposed values")
+	);
+	m_applyBtn->Disable();
+	mainSizer->Add(m_applyBtn, 0, wxALIGN_RIGHT|wxLEFT|wxRIGHT|wxBOTTOM, 5);
+
+	wxStaticLine *bottomDivider = new wxStaticLine(this);
+	mainSizer->Add(bottomDivider, 0, wxEXPAND);
+
+	wxBoxSizer *bottomRow = new wxBoxSizer(wxHORIZONTAL);
+	bottomRow->AddStretchSpacer();
+	wxButton *theCloseButton = new wxButton(
+		this,
+		wxID_CANCEL,
+		wxT("Close")
+	);
+	bottomRow->Add(theCloseButton, 0, wxALIGN_CENTER|wxALL, 10);
+	bottomRow->AddStretchSpacer();
+	mainSizer->Add(bottomRow, 0, wxGROW);
+
+	SetSizer(mainSizer);
+}
+
+unsigned EnvelopeDialog::GetNumberOfChanges() {
+	return m_numberOfChanges;
+}
+
+void EnvelopeDialog::OnAnalyzeBtn(wxCommandEvent& WXUNUSED(event)) {
+	EnvelopeAnalyzer::ENVELOPE_SETTINGS settings;
+	settings.detectAttackStart = m_attackStartCheck->GetValue();
+	settings.attackStartThreshold = (float) m_attackStartSpin->GetValue();
+	settings.detectCuePoint = m_cuePointCheck->GetValue();
+	settings.cuePointThreshold = (float) m_cuePointSpin->GetValue();
+	settings.detectReleaseEnd = m_releaseEndCheck->GetValue();
+	settings.releaseEndThreshold = (float) m_releaseEndSpin->GetValue();
+	settings.onlyUnset = m_onlyUnsetCheck->GetValue();
+
+	bool completed = GOODF_functions::runWithProgress(this, wxT("Analyzing envelopes"), wxT("Analyzing the samples of ") + m_rank->getName(), false, [&](const std::function<bool(size_t, size_t)> &progress) {
+		return EnvelopeAnalyzer::analyzeRank(m_rank, settings, m_proposals, progress);
+	});
+	if (!completed)
+		m_proposals.clear();
+	FillList();
+}
+
+void EnvelopeDialog::OnApplyBtn(wxCommandEvent& WXUNUSED(event)) {
+	m_numberOfChanges += EnvelopeAnalyzer::applyProposals(m_rank, m_proposals);
+	EndModal(wxID_OK);
+}
+
+void EnvelopeDialog::AddThresholdRow(wxSizer *sizer, wxCheckBox *check, wxSpinCtrlDouble *spin, const wxString &unit) {
+	wxBoxSizer *row = new wxBoxSizer(wxHORIZONTAL);
+	row->Add(check, 0, wxALIGN_CENTER_VERTICAL|wxALL, 5);
+	spin->SetDigits(1);
+	row->Add(spin, 0, wxALIGN_CENTER_VERTICAL|wxALL, 5);
+	wxStaticText *unitText = new wxStaticText (
+		this,
+		wxID_STATIC,
+		unit
+	);
+	row->Add(unitText, 0, wxALIGN_CENTER_VERTICAL|wxALL, 5);
+	sizer->Add(row, 0, wxGROW);
+}
+
+void EnvelopeDialog::FillList() {
+	m_proposalList->DeleteAllItems();
+	unsigned row = 0;
+	for (const EnvelopeAnalyzer::SAMPLE_PROPOSAL &proposal : m_proposals) {
+		if (!proposal.hasChanges() && proposal.errorMessage.IsEmpty())
+			continue;
+		m_proposalList->InsertItem(row, GOODF_functions::number_format(proposal.pipeIndex + 1));
+		m_proposalList->SetItem(row, 1, (proposal.isRelease ? wxT("Release: ") : wxT("Attack: ")) + proposal.fileName);
+		if (proposal.errorMessage.IsEmpty()) {
+			m_proposalList->SetItem(row, 2, DescribeChange(proposal.attackStart, proposal.proposedAttackStart));
+			m_proposalList->SetItem(row, 3, DescribeChange(proposal.cuePoint, proposal.proposedCuePoint));
+			m_proposalList->SetItem(row, 4, DescribeChange(proposal.releaseEnd, proposal.proposedReleaseEnd));
+		} else {
+			m_proposalList->SetItem(row, 2, proposal.errorMessage.Strip(wxString::both));
+		}
+		row++;
+	}
+	bool hasChanges = std::any_of(m_proposals.begin(), m_proposals.end(), [](const EnvelopeAnalyzer::SAMPLE_PROPOSAL &proposal) {
+		return proposal.hasChanges();
+	});
+	m_applyBtn->Enable(hasChanges);
+}
+
+wxString EnvelopeDialog::DescribeChange(int current, int proposed) {
+	if (proposed == -1)
+		return wxEmptyString;
+	return wxString::Format(wxT("%d -> %d"), current, proposed);
+}
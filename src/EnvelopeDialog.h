@@ -0,0 +1,93 @@
+/*
+ * EnvelopeDialog.h is part of GoOdf.
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * GoOdf is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GoOdf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GoOdf. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#ifndef ENVELOPEDIALOG_H
+#define ENVELOPEDIALOG_H
+
+#include <wx/wx.h>
+#include <wx/listctrl.h>
+#include <wx/spinctrl.h>
+#include "EnvelopeAnalyzer.h"
+
+class Rank;
+
+class EnvelopeDialog : public wxDialog {
+	DECLARE_CLASS(EnvelopeDialog)
+	DECLARE_EVENT_TABLE()
+
+public:
+	// Constructors
+	EnvelopeDialog(Rank *rank);
+	EnvelopeDialog(
+		Rank *rank,
+		wxWindow* parent,
+		wxWindowID id = wxID_ANY,
+		const wxString& caption = wxT("Detect sample points from the envelope"),
+		const wxPoint& pos = wxDefaultPosition,
+		const wxSize& size = wxDefaultSize,
+		long style = wxCAPTION|wxRESIZE_BORDER|wxSYSTEM_MENU|wxCLOSE_BOX
+	);
+
+	~EnvelopeDialog();
+
+	// Initialize our variables
+	void Init(Rank *rank);
+
+	// Creation
+	bool Create(
+		wxWindow* parent,
+		wxWindowID id = wxID_ANY,
+		const wxString& caption = wxT("Detect sample points from the envelope"),
+		const wxPoint& pos = wxDefaultPosition,
+		const wxSize& size = wxDefaultSize,
+		long style = wxCAPTION|wxRESIZE_BORDER|wxSYSTEM_MENU|wxCLOSE_BOX
+	);
+
+	// Creates the controls and sizers
+	void CreateControls();
+
+	// Accessors
+	unsigned GetNumberOfChanges();
+
+private:
+	Rank *m_rank;
+	std::vector<EnvelopeAnalyzer::SAMPLE_PROPOSAL> m_proposals;
+	unsigned m_numberOfChanges;
+
+	wxCheckBox *m_attackStartCheck;
+	wxSpinCtrlDouble *m_attackStartSpin;
+	wxCheckBox *m_cuePointCheck;
+	wxSpinCtrlDouble *m_cuePointSpin;
+	wxCheckBox *m_releaseEndCheck;
+	wxSpinCtrlDouble *m_releaseEndSpin;
+	wxCheckBox *m_onlyUnsetCheck;
+	wxListCtrl *m_proposalList;
+	wxButton *m_applyBtn;
+
+	// Event methods
+	void OnAnalyzeBtn(wxCommandEvent& event);
+	void OnApplyBtn(wxCommandEvent& event);
+
+	void AddThresholdRow(wxSizer *sizer, wxCheckBox *check, wxSpinCtrlDouble *spin, const wxString &unit);
+	void FillList();
+	static wxString DescribeChange(int current, int proposed);
+};
+
+#endif
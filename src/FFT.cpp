@@ -0,0 +1,90 @@
+/*
+ * FFT.cpp is part of GoOdf.
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * GoOdf is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GoOdf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GoOdf.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#include "FFT.h"
+#include <cmath>
+#include <utility>
+
+static const double PI = 3.14159265358979323846;
+
+FFT::FFT(unsigned size) {
+	m_size = getSizeFor(size);
+	m_twiddles.resize(m_size / 2);
+	for (unsigned i = 0; i < m_size / 2; i++) {
+		double angle = -2.0 * PI * i / m_size;
+		m_twiddles[i] = std::complex<float>((float) std::cos(angle), (float) std::sin(angle));
+	}
+	m_bitReversed.resize(m_size);
+	unsigned bits = 0;
+	while ((1u << bits) < m_size)
+		bits++;
+	for (unsigned i = 0; i < m_size; i++) {
+		unsigned reversed = 0;
+		for (unsigned b = 0; b < bits; b++) {
+			if (i & (1u << b))
+				reversed |= 1u << (bits - 1 - b);
+		}
+		m_bitReversed[i] = reversed;
+	}
+}
+
+FFT::~FFT() {
+
+}
+
+unsigned FFT::getSize() const {
+	return m_size;
+}
+
+void FFT::transform(std::vector<std::complex<float>> &data, bool inverse) const {
+	data.resize(m_size);
+	for (unsigned i = 0; i < m_size; i++) {
+		if (i < m_bitReversed[i])
+			std::swap(data[i], data[m_bitReversed[i]]);
+	}
+
+	for (unsigned length = 2; length <= m_size; length <<= 1) {
+		unsigned half = length / 2;
+		unsigned twiddleStep = m_size / length;
+		for (unsigned start = 0; start < m_size; start += length) {
+			for (unsigned k = 0; k < half; k++) {
+				std::complex<float> twiddle = m_twiddles[k * twiddleStep];
+				if (inverse)
+					twiddle = std::conj(twiddle);
+				std::complex<float> odd = data[start + k + half] * twiddle;
+				data[start + k + half] = data[start + k] - odd;
+				data[start + k] += odd;
+			}
+		}
+	}
+
+	if (inverse) {
+		float scale = 1.0f / m_size;
+		for (std::complex<float> &value : data)
+			value *= scale;
+	}
+}
+
+unsigned FFT::getSizeFor(unsigned minimumSize) {
+	unsigned size = 1;
+	while (size < minimumSize)
+		size <<= 1;
+	return size;
+}
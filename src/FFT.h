@@ -0,0 +1,47 @@
+/*
+ * FFT.h is part of GoOdf.
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * GoOdf is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GoOdf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GoOdf.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#ifndef FFT_H
+#define FFT_H
+
+#include <complex>
+#include <vector>
+
+// In place radix-2 complex FFT of a fixed power of two size. The twiddle
+// factors and bit reversal are computed once, so the same object can
+// transform many buffers (but only on one thread at a time).
+class FFT {
+public:
+	FFT(unsigned size);
+	~FFT();
+
+	unsigned getSize() const;
+	// The inverse transform is scaled by 1 / size
+	void transform(std::vector<std::complex<float>> &data, bool inverse = false) const;
+
+	static unsigned getSizeFor(unsigned minimumSize);
+
+private:
+	unsigned m_size;
+	std::vector<std::complex<float>> m_twiddles;
+	std::vector<unsigned> m_bitReversed;
+};
+
+#endif
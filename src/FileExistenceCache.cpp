@@ -0,0 +1,174 @@
+/*
+ * FileExistenceCache.cpp is part of GoOdf.
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * GoOdf is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GoOdf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GoOdf.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#include "FileExistenceCache.h"
+#include "OrganContext.h"
+#include "Instrumentation.h"
+#include <wx/dir.h>
+#include <vector>
+
+// Lists a share of the directories on a worker thread
+class DirectoryListingThread : public wxThread {
+public:
+	DirectoryListingThread(const wxArrayString &directories) : wxThread(wxTHREAD_JOINABLE) {
+		for (unsigned i = 0; i < directories.GetCount(); i++)
+			m_directories.Add(directories[i].Clone());
+		m_entries.resize(m_directories.GetCount());
+		m_isListed.resize(m_directories.GetCount(), false);
+	}
+
+	wxArrayString m_directories;
+	std::vector<std::set<wxString>> m_entries;
+	std::vector<bool> m_isListed;
+
+protected:
+	virtual ExitCode Entry() {
+		for (unsigned i = 0; i < m_directories.GetCount(); i++) {
+			bool listed = false;
+			FileExistenceCache::listDirectory(m_directories[i], m_entries[i], listed);
+			m_isListed[i] = listed;
+		}
+		return (ExitCode) 0;
+	}
+};
+
+FileExistenceCache::FileExistenceCache() {
+
+}
+
+FileExistenceCache::~FileExistenceCache() {
+
+}
+
+void FileExistenceCache::addDirectoryOf(const wxString &fullPath) {
+	wxString dirPath = wxFileName(fullPath, wxPATH_DOS).GetPath();
+	if (m_directories.find(normalizedName(dirPath)) == m_directories.end())
+		m_directoriesToList.insert(dirPath);
+}
+
+void FileExistenceCache::prefetch() {
+	if (m_directoriesToList.empty())
+		return;
+
+	// the work is mostly waiting on the file system so a few more threads than cores is fine
+	unsigned nbrThreads = wxThread::GetCPUCount() > 0 ? (unsigned) wxThread::GetCPUCount() * 2 : 4;
+	if (nbrThreads > 16)
+		nbrThreads = 16;
+	if (nbrThreads > m_directoriesToList.size())
+		nbrThreads = m_directoriesToList.size();
+
+	std::vector<wxArrayString> batches(nbrThreads);
+	unsigned dirIdx = 0;
+	for (const wxString &dir : m_directoriesToList) {
+		batches[dirIdx % nbrThreads].Add(dir);
+		dirIdx++;
+	}
+	m_directoriesToList.clear();
+
+	std::vector<DirectoryListingThread*> workers;
+	for (unsigned i = 0; i < nbrThreads; i++) {
+		DirectoryListingThread *worker = new DirectoryListingThread(batches[i]);
+		if (worker->Run() == wxTHREAD_NO_ERROR) {
+			workers.push_back(worker);
+		} else {
+			// list this batch here instead
+			delete worker;
+			for (unsigned j = 0; j < batches[i].GetCount(); j++)
+				getListing(batches[i][j]);
+		}
+	}
+
+	for (DirectoryListingThread *worker : workers) {
+		worker->Wait();
+		for (unsigned i = 0; i < worker->m_directories.GetCount(); i++) {
+			DirectoryListing &listing = m_directories[normalizedName(worker->m_directories[i])];
+			listing.entries.swap(worker->m_entries[i]);
+			listing.isListed = worker->m_isListed[i];
+		}
+		delete worker;
+	}
+}
+
+bool FileExistenceCache::fileExists(const wxFileName &file) {
+	DirectoryListing &listing = getListing(file.GetPath());
+	if (!listing.isListed) {
+		// the directory couldn't be read as a whole so ask for the file itself
+		Instrumentation::count(Instrumentation::FILES_STATTED);
+		return file.FileExists();
+	}
+	if (listing.entries.find(normalizedName(file.GetFullName())) != listing.entries.end())
+		return true;
+	// a name can be listed in another Unicode normalization than the ODF
+	// uses, so a miss is only believed once the file itself is asked for
+	Instrumentation::count(Instrumentation::FILES_STATTED);
+	return file.FileExists();
+}
+
+void FileExistenceCache::addMissingFile(const wxString &relativePath) {
+	if (m_reportedMissingFiles.insert(relativePath).second)
+		m_missingFiles.Add(relativePath);
+}
+
+void FileExistenceCache::reportMissingFiles(OrganContext *context) {
+	bool keepFiles = context->isKeepingMissingFiles();
+	for (unsigned i = 0; i < m_missingFiles.GetCount(); i++) {
+		context->logWarning(wxString::Format("%s does not exist.%s", m_missingFiles[i], (keepFiles) ? "" : " Removed from .organ file"));
+	}
+	m_missingFiles.Empty();
+}
+
+void FileExistenceCache::listDirectory(const wxString &dirPath, std::set<wxString> &entries, bool &isListed) {
+	ScopedTimer timer("load.listDirectory");
+	Instrumentation::count(Instrumentation::DIRECTORIES_LISTED);
+	isListed = false;
+	if (!wxDir::Exists(dirPath)) {
+		// nothing can exist in a missing directory
+		isListed = true;
+		return;
+	}
+	wxDir dir;
+	if (!dir.Open(dirPath))
+		return;
+	// a directory with the name of a sample isn't the sample
+	wxString entryName;
+	bool hasEntry = dir.GetFirst(&entryName, wxEmptyString, wxDIR_FILES | wxDIR_HIDDEN);
+	while (hasEntry) {
+		entries.insert(normalizedName(entryName));
+		hasEntry = dir.GetNext(&entryName);
+	}
+	isListed = true;
+}
+
+wxString FileExistenceCache::normalizedName(const wxString &name) {
+	if (wxFileName::IsCaseSensitive())
+		return name;
+	return name.Lower();
+}
+
+FileExistenceCache::DirectoryListing& FileExistenceCache::getListing(const wxString &dirPath) {
+	wxString key = normalizedName(dirPath);
+	std::map<wxString, DirectoryListing>::iterator it = m_directories.find(key);
+	if (it != m_directories.end())
+		return it->second;
+
+	DirectoryListing &listing = m_directories[key];
+	listDirectory(dirPath, listing.entries, listing.isListed);
+	return listing;
+}
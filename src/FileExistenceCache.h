@@ -0,0 +1,65 @@
+/*
+ * FileExistenceCache.h is part of GoOdf.
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * GoOdf is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GoOdf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GoOdf.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#ifndef FILEEXISTENCECACHE_H
+#define FILEEXISTENCECACHE_H
+
+#include <wx/wx.h>
+#include <wx/filename.h>
+#include <map>
+#include <set>
+
+class OrganContext;
+
+// Answers file existence queries from one listing per directory instead of
+// one stat call per file, only a file that isn't listed is checked by
+// itself. The directories can be listed up front by a few worker threads,
+// and the missing files are collected so that each one is reported only
+// once when parsing is done.
+class FileExistenceCache {
+public:
+	FileExistenceCache();
+	~FileExistenceCache();
+
+	void addDirectoryOf(const wxString &fullPath);
+	void prefetch();
+	bool fileExists(const wxFileName &file);
+	void addMissingFile(const wxString &relativePath);
+	void reportMissingFiles(OrganContext *context);
+
+	static void listDirectory(const wxString &dirPath, std::set<wxString> &entries, bool &isListed);
+
+private:
+	struct DirectoryListing {
+		std::set<wxString> entries;
+		bool isListed;
+	};
+
+	std::map<wxString, DirectoryListing> m_directories;
+	std::set<wxString> m_directoriesToList;
+	wxArrayString m_missingFiles;
+	std::set<wxString> m_reportedMissingFiles;
+
+	static wxString normalizedName(const wxString &name);
+	DirectoryListing& getListing(const wxString &dirPath);
+
+};
+
+#endif
@@ -21,6 +21,7 @@
 #include "GOODF.h"
 #include "GOODFDef.h"
 #include "GoImages.h"
+#include "Instrumentation.h"
 #include <wx/image.h>
 #include <wx/filename.h>
 #include <wx/stdpaths.h>
@@ -30,6 +31,19 @@
 IMPLEMENT_APP(GOODF)
 
 bool GOODF::OnInit() {
+	// profiling is enabled by GOODF_PROFILE or a --profile[=file.json] argument
+	Instrumentation::enableFromEnvironment();
+	wxString organFileArgument = wxEmptyString;
+	for (int i = 1; i < wxApp::argc; i++) {
+		wxString argument = wxApp::argv[i];
+		if (argument.IsSameAs(wxT("--profile")))
+			Instrumentation::enable();
+		else if (argument.StartsWith(wxT("--profile=")))
+			Instrumentation::enable(argument.Mid(10));
+		else if (organFileArgument.IsEmpty())
+			organFileArgument = argument;
+	}
+
 	// Create fullAppName with version from cmake
 	m_fullAppName = wxT("GoOdf ");
 	m_fullAppName.Append(wxT(GOODF_VERSION));
@@ -561,9 +575,10 @@ bool GOODF::OnInit() {
 	// Show the frame
 	m_frame->Show(true);
 
+	// unsaved changes from a session that crashed are offered first, then
 	// if a <file.organ> command line argument exists, try opening it as an organ file
-	if (wxApp::argc > 1) {
-		wxFileName f_name(wxApp::argv[1]);
+	if (!m_frame->RecoverFromEditJournals() && !organFileArgument.IsEmpty()) {
+		wxFileName f_name(organFileArgument);
 		if (f_name.Exists() && f_name.GetExt().IsSameAs("organ", false)) { // ignore case
 			// might like to use GetAbsolutePath() here, but it's only available in wx 3.1.6 or above
 			if (f_name.MakeAbsolute()) {
@@ -577,6 +592,7 @@ bool GOODF::OnInit() {
 }
 
 int GOODF::OnExit() {
+	Instrumentation::writeJsonReport();
 	return wxApp::OnExit();
 }
 
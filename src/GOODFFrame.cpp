@@ -26,13 +26,30 @@
 #include <wx/stdpaths.h>
 #include <wx/msgdlg.h>
 #include <wx/button.h>
+#include <wx/stopwatch.h>
+#include <wx/dirdlg.h>
 #include "Enclosure.h"
 #include "Windchestgroup.h"
 #include "OrganFileParser.h"
+#include "OrganLoader.h"
+#include "OdfFileWriter.h"
+#include "EditJournal.h"
+#include "Instrumentation.h"
+#include "GOODFFunctions.h"
 #include "CopyElementAttributesDialog.h"
 #include "CmbDialog.h"
 #include "DefaultPathsDialog.h"
 #include "StopRankImportDialog.h"
+#include "OdfSectionIndex.h"
+#include "SampleNameMatcher.h"
+#include "DuplicateSamplesDialog.h"
+#include "MemoryFootprintDialog.h"
+#include "LoopQualityDialog.h"
+#include "LoudnessDialog.h"
+#include "SampleChunkWriter.h"
+#include "SampleTrimExporter.h"
+#include "SampleValidator.h"
+#include "SampleValidationDialog.h"
 #include <vector>
 #include <algorithm>
 
@@ -44,10 +61,20 @@ BEGIN_EVENT_TABLE(GOODFFrame, wxFrame)
 	EVT_MENU(ID_WRITE_ODF, GOODFFrame::OnWriteODF)
 	EVT_MENU(ID_NEW_ORGAN, GOODFFrame::OnNewOrgan)
 	EVT_MENU(ID_READ_ORGAN, GOODFFrame::OnReadOrganFile)
+	EVT_MENU(ID_CANCEL_ORGAN_LOADING, GOODFFrame::OnCancelOrganLoading)
 	EVT_MENU(ID_IMPORT_VOICING_DATA, GOODFFrame::OnImportCMB)
 	EVT_MENU(ID_IMPORT_STOP_RANK, GOODFFrame::OnImportStopRank)
 	EVT_MENU(ID_GLOBAL_SHOW_TOOLTIPS_OPTION, GOODFFrame::OnEnableTooltipsMenu)
 	EVT_MENU(ID_GLOBAL_KEEPFILES_OPTION, GOODFFrame::OnEnableKeepfilesMenu)
+	EVT_MENU(ID_GLOBAL_LOAD_PIPES_ON_DEMAND_OPTION, GOODFFrame::OnEnableLoadPipesOnDemandMenu)
+	EVT_MENU(ID_GLOBAL_SAMPLE_NAMING_OPTION, GOODFFrame::OnSampleNamingMenu)
+	EVT_MENU(ID_FIND_DUPLICATE_SAMPLES, GOODFFrame::OnFindDuplicateSamples)
+	EVT_MENU(ID_ESTIMATE_MEMORY_FOOTPRINT, GOODFFrame::OnEstimateMemoryFootprint)
+	EVT_MENU(ID_LOOP_QUALITY_REPORT, GOODFFrame::OnLoopQualityReport)
+	EVT_MENU(ID_LOUDNESS_REPORT, GOODFFrame::OnLoudnessReport)
+	EVT_MENU(ID_WRITE_SAMPLE_CHUNKS, GOODFFrame::OnWriteSampleChunks)
+	EVT_MENU(ID_EXPORT_TRIMMED_SAMPLES, GOODFFrame::OnExportTrimmedSamples)
+	EVT_MENU(ID_VALIDATE_SAMPLES, GOODFFrame::OnValidateSamples)
 	EVT_MENU(ID_GLOBAL_PARSE_LEGACY_XFADES_OPTION, GOODFFrame::OnImportLegacyXfadesMenu)
 	EVT_MENU(ID_CLEAR_HISTORY, GOODFFrame::OnClearHistory)
 	EVT_MENU(ID_DEFAULT_PATHS_MENU, GOODFFrame::OnDefaultPathMenuChoice)
@@ -68,6 +95,10 @@ BEGIN_EVENT_TABLE(GOODFFrame, wxFrame)
 	EVT_BUTTON(ID_ADD_REVERSIBLE_PISTON_BTN, GOODFFrame::OnAddNewReversiblePiston)
 	EVT_BUTTON(ID_ADD_PANEL_BTN, GOODFFrame::OnAddNewPanel)
 	EVT_SIZE(GOODFFrame::OnSizeChange)
+	EVT_THREAD(ID_ORGAN_LOADER_THREAD, GOODFFrame::OnOrganLoaderThread)
+	EVT_TIMER(ID_ORGAN_LOADER_TIMER, GOODFFrame::OnOrganLoaderTimer)
+	EVT_THREAD(ID_ODF_WRITER_THREAD, GOODFFrame::OnOdfWriterThread)
+	EVT_TIMER(ID_EDIT_JOURNAL_TIMER, GOODFFrame::OnEditJournalTimer)
 	EVT_CLOSE(GOODFFrame::OnClose)
 END_EVENT_TABLE()
 
@@ -77,9 +108,20 @@ GOODFFrame::GOODFFrame(const wxString& title) : wxFrame(NULL, wxID_ANY, title) {
 	m_organHasBeenSaved = false;
 	m_enableTooltips = false;
 	m_keepMissingFiles = false;
+	m_loadPipesOnDemand = false;
+	m_sampleNamingScheme = SampleNameMatcher::MIDI_NUMBER_SCHEME;
+	m_noteNameConvention = SampleNameMatcher::ENGLISH_NOTE_NAMES;
 	m_config = new wxFileConfig(wxT("GoOdf"));
 	m_defaultOrganDirectory = wxEmptyString;
 	m_defaultCmbDirectory = wxEmptyString;
+	m_organLoader = NULL;
+	m_organLoaderDlg = NULL;
+	m_organLoaderTimer.SetOwner(this, ID_ORGAN_LOADER_TIMER);
+	m_odfWriter = NULL;
+	m_editJournal = new EditJournal();
+	m_editJournal->reset(wxEmptyString);
+	m_editJournalTimer.SetOwner(this, ID_EDIT_JOURNAL_TIMER);
+	m_sampleValidator = new SampleValidator();
 	m_logWindow = new wxLogWindow(this, wxT("Log messages"), false, false);
 	wxLog::SetActiveTarget(m_logWindow);
 
@@ -91,6 +133,8 @@ GOODFFrame::GOODFFrame(const wxString& title) : wxFrame(NULL, wxID_ANY, title) {
 	m_fileMenu->Append(ID_READ_ORGAN, wxT("Open file\tCtrl+O"), wxT("Open existing .organ file"));
 	m_recentMenu = new wxMenu();
 	m_fileMenu->AppendSubMenu(m_recentMenu, wxT("Recent Files"));
+	m_fileMenu->Append(ID_CANCEL_ORGAN_LOADING, wxT("Cancel Loading"), wxT("Stop loading the .organ file that is being opened"));
+	m_fileMenu->Enable(ID_CANCEL_ORGAN_LOADING, false);
 	m_fileMenu->AppendSeparator();
 	m_fileMenu->Append(ID_WRITE_ODF, wxT("Write ODF\tCtrl+S"), wxT("Write/Save the .organ file"));
 	m_fileMenu->Append(wxID_EXIT, wxT("&Exit\tCtrl+Q"), wxT("Quit this program"));
@@ -101,12 +145,21 @@ GOODFFrame::GOODFFrame(const wxString& title) : wxFrame(NULL, wxID_ANY, title) {
 	// Add tools menu items
 	m_toolsMenu->Append(ID_IMPORT_VOICING_DATA, wxT("Import .cmb\tCtrl+I"), wxT("Import voicing data from a .cmb (settings) file"));
 	m_toolsMenu->Append(ID_IMPORT_STOP_RANK, wxT("Import Stops/Ranks\tCtrl+R"), wxT("Import stops/ranks from another (working) .organ file"));
+	m_toolsMenu->Append(ID_FIND_DUPLICATE_SAMPLES, wxT("Find duplicate samples..."), wxT("Find sample files with identical audio and share or borrow them instead"));
+	m_toolsMenu->Append(ID_ESTIMATE_MEMORY_FOOTPRINT, wxT("Estimate memory footprint..."), wxT("Estimate how much memory GrandOrgue needs for the samples of each rank and stop"));
+	m_toolsMenu->Append(ID_LOOP_QUALITY_REPORT, wxT("Loop quality report..."), wxT("Check the loops of the attacks in all ranks for clicks"));
+	m_toolsMenu->Append(ID_LOUDNESS_REPORT, wxT("Pipe loudness..."), wxT("Measure the loudness of all pipes and suggest gains that even out each rank"));
+	m_toolsMenu->Append(ID_VALIDATE_SAMPLES, wxT("Validate samples..."), wxT("Check the attacks, releases and loops of all ranks against their sample files"));
+	m_toolsMenu->Append(ID_WRITE_SAMPLE_CHUNKS, wxT("Write loops/cues to samples..."), wxT("Store the loops and cue points set in the .organ file in the smpl and cue chunks of the WAVE files"));
+	m_toolsMenu->Append(ID_EXPORT_TRIMMED_SAMPLES, wxT("Export trimmed samples..."), wxT("Write copies of all samples without the audio before AttackStart and after ReleaseEnd and use them in the .organ file"));
 	m_toolsMenu->AppendCheckItem(ID_GLOBAL_SHOW_TOOLTIPS_OPTION, wxT("Enable Tooltips"), wxT("Enable tooltips for certain controls"));
 	m_toolsMenu->Check(ID_GLOBAL_SHOW_TOOLTIPS_OPTION, false);
 	m_toolsMenu->Append(ID_GLOBAL_PARSE_LEGACY_XFADES_OPTION, wxT("Import Legacy X-fades"), wxT("Make extra attacks/releases inherit LoopCrossfadeLength & ReleaseCrossfadeLength values like pre GO v3.14.0"));
 	m_toolsMenu->Append(ID_CLEAR_HISTORY, wxT("Clear File History"), wxT("Remove all the entries in the recent file history"));
 	m_toolsMenu->Append(ID_DEFAULT_PATHS_MENU, wxT("Default paths\tCtrl+P"), wxT("Set the default paths used by the application here"));
 	m_toolsMenu->AppendCheckItem(ID_GLOBAL_KEEPFILES_OPTION, wxT("Keep missing files"), wxT("Keep missing files in ODF file"));
+	m_toolsMenu->AppendCheckItem(ID_GLOBAL_LOAD_PIPES_ON_DEMAND_OPTION, wxT("Load pipes on demand"), wxT("Only read the pipes of a rank when it's first selected or edited"));
+	m_toolsMenu->Append(ID_GLOBAL_SAMPLE_NAMING_OPTION, wxT("Sample naming scheme..."), wxT("Choose how the MIDI note of a sample is found from its file name when reading pipes"));
 
 	m_toolsMenu->Enable(ID_GLOBAL_PARSE_LEGACY_XFADES_OPTION, false);
 
@@ -521,6 +574,21 @@ GOODFFrame::GOODFFrame(const wxString& title) : wxFrame(NULL, wxID_ANY, title) {
 		else
 			m_toolsMenu->Check(ID_GLOBAL_KEEPFILES_OPTION, false);
 	}
+	if (m_config->Read(wxT("General/LoadPipesOnDemand"), &b)) {
+		m_loadPipesOnDemand = b;
+		if (m_loadPipesOnDemand)
+			m_toolsMenu->Check(ID_GLOBAL_LOAD_PIPES_ON_DEMAND_OPTION, true);
+		else
+			m_toolsMenu->Check(ID_GLOBAL_LOAD_PIPES_ON_DEMAND_OPTION, false);
+	}
+	int scheme;
+	if (m_config->Read(wxT("General/SampleNamingScheme"), &scheme) && scheme >= 0 && scheme <= SampleNameMatcher::CUSTOM_PATTERN_SCHEME)
+		m_sampleNamingScheme = scheme;
+	m_config->Read(wxT("General/SampleNamePattern"), &m_sampleNamePattern);
+	int convention;
+	if (m_config->Read(wxT("General/NoteNameConvention"), &convention) && convention >= 0 && convention <= SampleNameMatcher::GERMAN_NOTE_NAMES)
+		m_noteNameConvention = convention;
+	SetupOrganContext(m_organ);
 
 	int readInt;
 	if (m_config->Read(wxT("General/FrameXPosition"), &readInt))
@@ -593,6 +661,8 @@ GOODFFrame::GOODFFrame(const wxString& title) : wxFrame(NULL, wxID_ANY, title) {
 GOODFFrame::~GOODFFrame() {
 	if (m_organ)
 		delete m_organ;
+	delete m_editJournal;
+	delete m_sampleValidator;
 	wxLog::SetActiveTarget(nullptr);
 	delete m_logWindow;
 }
@@ -622,9 +692,10 @@ void GOODFFrame::OnClose(wxCloseEvent& event) {
 		// Ask if user wants to save/write the organ file
 		wxMessageDialog dlg(this, wxT("ODF file is modified. Do you want to save/write it?"), wxT("ODF file is modified"), wxYES_NO|wxCENTRE|wxICON_EXCLAMATION);
 		if (dlg.ShowModal() == wxID_YES) {
-			// Try triggering save/write by posting an event
+			// Trigger save/write and wait for the file to be written
 			wxCommandEvent evt(wxEVT_MENU, ID_WRITE_ODF);
-			wxPostEvent(this, evt);
+			GetEventHandler()->ProcessEvent(evt);
+			WaitForWritingOdf();
 
 			if (m_organ->isModified()) {
 				// This means that the save failed, ask if the user wants to abort the quitting to fix the issue
@@ -637,9 +708,23 @@ void GOODFFrame::OnClose(wxCloseEvent& event) {
 		}
 	}
 
+	// Stop any loading that is still going on, a file being written is finished
+	CancelOrganLoading();
+	WaitForWritingOdf();
+	// nothing is left to recover after a normal close
+	m_editJournalTimer.Stop();
+	m_editJournal->discard();
+	for (OrganLoader *loader : m_cancelledOrganLoaders)
+		delete loader;
+	m_cancelledOrganLoaders.clear();
+
 	// Write config file (settings)
 	m_config->Write(wxT("General/EnableTooltips"), m_enableTooltips);
 	m_config->Write(wxT("General/KeepMissingFiles"), m_keepMissingFiles);
+	m_config->Write(wxT("General/LoadPipesOnDemand"), m_loadPipesOnDemand);
+	m_config->Write(wxT("General/SampleNamingScheme"), m_sampleNamingScheme);
+	m_config->Write(wxT("General/SampleNamePattern"), m_sampleNamePattern);
+	m_config->Write(wxT("General/NoteNameConvention"), m_noteNameConvention);
 	UpdateFrameSizeAndPos();
 	m_config->Write(wxT("General/FrameXPosition"), m_xPosition);
 	m_config->Write(wxT("General/FrameYPosition"), m_yPosition);
@@ -665,47 +750,8 @@ void GOODFFrame::OnClose(wxCloseEvent& event) {
 	Destroy();
 }
 
-// iterate through wxTextFile checking that wxCSConv would work
-bool GOODFFrame::IsEncodingOk(wxTextFile *odfFile, wxCSConv conv) {
-	bool isOk = true;
-	size_t unused = 0;
-	wxString str;
-
-	if (!conv.IsOk()) {
-		return false;
-	}
-	for (str = odfFile->GetFirstLine(); !odfFile->Eof(); str = odfFile->GetNextLine()) {
-		size_t result = conv.FromWChar(NULL, unused, str);
-		if (result == wxCONV_FAILED) {
-			isOk = false;
-			break;
-		}
-	}
-	return isOk;
-}
-
-// output wxTextFile as UTF8 and include the BOM marker
-bool GOODFFrame::WriteUTF8(wxTextFile *odfFile) {
-	bool isOk;
-	wxString str;
-
-	wxCSConv conv = wxCSConv("UTF-8");
-	if (!conv.IsOk()) {
-		return false;
-	}
-
-	wxFile *outFile = new wxFile(odfFile->GetName(), wxFile::write);
-	outFile->Write("\xef\xbb\xbf", 3);
-	for (str = odfFile->GetFirstLine(), isOk = true; !odfFile->Eof() && isOk; str = odfFile->GetNextLine()) {
-		isOk = outFile->Write(str, conv);
-		outFile->Write(wxTextFile::GetEOL(wxTextFileType_Dos));
-	}
-	outFile->Flush();
-	delete outFile;
-	return isOk;
-}
-
 void GOODFFrame::OnWriteODF(wxCommandEvent& WXUNUSED(event)) {
+	CompleteOrganLoading();
 	FixAnyIllegalEntries();
 	if (m_organPanel->getOdfPath().IsEmpty() || m_organPanel->getOdfName().IsEmpty()) {
 		wxMessageDialog incomplete(this, wxT("Both path (location) and name for ODF must be set!"), wxT("Cannot write ODF"), wxOK|wxCENTRE);
@@ -716,60 +762,144 @@ void GOODFFrame::OnWriteODF(wxCommandEvent& WXUNUSED(event)) {
 	if (m_recentlyUsed->GetCount() &&  !fullFileName.IsSameAs(m_recentlyUsed->GetHistoryFile(0))) {
 		m_organHasBeenSaved = false;
 	}
-	wxTextFile *odfFile = new wxTextFile(fullFileName);
-	if (odfFile->Exists() && !m_organHasBeenSaved) {
+	if (m_odfWriter) {
+		// the earlier save must be done before a new snapshot is written
+		wxBusyCursor busy;
+		WaitForWritingOdf();
+	}
+	if (wxFileExists(fullFileName) && !m_organHasBeenSaved) {
 		wxMessageDialog dlg(this, wxT("ODF file already exists. Do you want to overwrite it?"), wxT("Existing ODF file"), wxYES_NO|wxCENTRE|wxICON_EXCLAMATION);
-		if (dlg.ShowModal() == wxID_YES) {
-			odfFile->Open(fullFileName);
-			odfFile->Clear();
-		} else {
-			delete odfFile;
+		if (dlg.ShowModal() != wxID_YES) {
 			return;
 		}
-	} else {
-		odfFile->Create(fullFileName);
 	}
 
-	bool isWrittenCorrectly = false;
-	bool isEncodingWorking = false;
-	wxString tail = wxT("!");
-	m_organ->writeOrgan(odfFile);
-	if (IsEncodingOk(odfFile, wxCSConv("ISO-8859-1"))) {
-		isEncodingWorking = true;
-		isWrittenCorrectly = odfFile->Write(wxTextFileType_Dos, wxCSConv("ISO-8859-1"));
-	} else if (IsEncodingOk(odfFile, wxCSConv("UTF-8"))) {
-		isEncodingWorking = true;
-		isWrittenCorrectly = WriteUTF8(odfFile);
-		tail = wxT(" as UTF-8") + tail;
+	// Serializing only copies lines as the unchanged sections are cached, the
+	// encoding and writing of the snapshot is then done on a worker thread.
+	m_odfWriter = new OdfFileWriter(fullFileName, this, ID_ODF_WRITER_THREAD);
+	{
+		ScopedTimer serializeTimer("save.serialize");
+		m_organ->writeOrgan(m_odfWriter->getLines(), m_odfWriter->getCachedSections());
 	}
+	Instrumentation::count(Instrumentation::LINES_WRITTEN, m_odfWriter->getLines()->GetLineCount());
+	m_odfWriter->setModificationCount(m_organ->getModificationCount());
+	if (!GetStatusBar())
+		CreateStatusBar();
+	SetStatusText(wxT("Writing ") + m_organPanel->getOdfName() + wxT(".organ..."));
+	m_odfWriter->start();
+}
 
-	if (isWrittenCorrectly) {
+void GOODFFrame::OnOdfWriterThread(wxThreadEvent& event) {
+	// a save that has already been waited for is reported by now
+	if (event.GetPayload<OdfFileWriter*>() != m_odfWriter)
+		return;
+	FinishWritingOdf();
+}
+
+void GOODFFrame::FinishWritingOdf() {
+	m_odfWriter->wait();
+	OdfFileWriter::Result result = m_odfWriter->getResult();
+	wxString fullFileName = m_odfWriter->getFilePath();
+	// changes made while the file was written still need saving
+	bool isUnchanged = m_odfWriter->getModificationCount() == m_organ->getModificationCount();
+	if (result == OdfFileWriter::WRITTEN || result == OdfFileWriter::WRITTEN_AS_UTF8) {
+		// the journal starts over from what is now on disk
+		m_editJournal->reset(fullFileName, m_odfWriter->getLines(), m_odfWriter->getCachedSections());
+		if (!isUnchanged)
+			ScheduleEditJournalCheckpoint();
+	}
+	delete m_odfWriter;
+	m_odfWriter = NULL;
+	if (!m_organLoader && GetStatusBar()) {
+		wxStatusBar *statusBar = GetStatusBar();
+		SetStatusBar(NULL);
+		statusBar->Destroy();
+		SendSizeEvent();
+	}
+
+	if (result == OdfFileWriter::WRITTEN || result == OdfFileWriter::WRITTEN_AS_UTF8) {
 		if (!m_organHasBeenSaved) {
-			wxMessageDialog msg(this, wxT("ODF file ") + m_organPanel->getOdfName() + wxT(".organ has been written") + tail, wxT("ODF file written"), wxOK|wxCENTRE);
+			wxString tail = result == OdfFileWriter::WRITTEN_AS_UTF8 ? wxT(" as UTF-8!") : wxT("!");
+			wxMessageDialog msg(this, wxT("ODF file ") + wxFileName(fullFileName).GetFullName() + wxT(" has been written") + tail, wxT("ODF file written"), wxOK|wxCENTRE);
 			msg.ShowModal();
 		}
 		m_organHasBeenSaved = true;
-		m_organ->setModified(false);
+		if (isUnchanged)
+			m_organ->setModified(false);
 		UpdateFrameTitle();
 		m_recentlyUsed->AddFileToHistory(fullFileName);
+	} else if (result == OdfFileWriter::ENCODING_FAILED) {
+		wxString errorMessage = wxT("Failure to encode ODF file as ISO-8859-1 or UTF-8! Please remove any character(s) that cannot be correctly encoded.");
+		wxMessageDialog msg(this, errorMessage, wxT("Encoding error!"), wxOK|wxCENTRE|wxICON_ERROR);
+		msg.ShowModal();
 	} else {
-		if (isEncodingWorking) {
-			wxString errorMessage = wxT("Failure while writing ODF file, it may be corrupted on disk!");
-			wxMessageDialog msg(this, errorMessage, wxT("Writing error!"), wxOK|wxCENTRE|wxICON_ERROR);
-			msg.ShowModal();
-		} else {
-			wxString errorMessage = wxT("Failure to encode ODF file as ISO-8859-1 or UTF-8! Please remove any character(s) that cannot be correctly encoded.");
-			wxMessageDialog msg(this, errorMessage, wxT("Encoding error!"), wxOK|wxCENTRE|wxICON_ERROR);
-			msg.ShowModal();
-		}
+		wxString errorMessage = wxT("Failure while writing ODF file! The existing file on disk has been left untouched.");
+		wxMessageDialog msg(this, errorMessage, wxT("Writing error!"), wxOK|wxCENTRE|wxICON_ERROR);
+		msg.ShowModal();
 	}
-	odfFile->Close();
-	delete odfFile;
 
+	Instrumentation::report();
 	if (m_logWindow->GetFrame()->IsShown())
 		m_logWindow->GetFrame()->Raise();
 }
 
+void GOODFFrame::WaitForWritingOdf() {
+	if (m_odfWriter)
+		FinishWritingOdf();
+}
+
+void GOODFFrame::OnEditJournalTimer(wxTimerEvent& WXUNUSED(event)) {
+	if (m_organLoader) {
+		// the organ can only be recorded once it's completely loaded
+		m_editJournalTimer.StartOnce(2000);
+		return;
+	}
+	if (m_organ->isModified())
+		m_editJournal->checkpoint(m_organ, GetRecoveryPath());
+}
+
+void GOODFFrame::ScheduleEditJournalCheckpoint() {
+	// A checkpoint is made once the edits have paused for a moment, but
+	// editing without a pause can't put it off for more than ten seconds.
+	if (!m_editJournalTimer.IsRunning())
+		m_editJournalPendingTime.Start();
+	long untilDeadline = 10000 - m_editJournalPendingTime.Time();
+	if (untilDeadline < 1)
+		untilDeadline = 1;
+	m_editJournalTimer.StartOnce(untilDeadline < 2000 ? untilDeadline : 2000);
+}
+
+wxString GOODFFrame::GetRecoveryPath() {
+	// recovered files are placed with the organ so that relative paths still work
+	if (m_organPanel->getOdfPath().IsEmpty() || m_organPanel->getOdfName().IsEmpty())
+		return wxEmptyString;
+	return m_organPanel->getOdfPath() + wxFILE_SEP_PATH + m_organPanel->getOdfName() + wxT(".recovered.organ");
+}
+
+bool GOODFFrame::RecoverFromEditJournals() {
+	wxArrayString journals = EditJournal::findAbandonedJournals();
+	bool isRecovered = false;
+	for (unsigned i = 0; i < journals.GetCount() && !isRecovered; i++) {
+		if (EditJournal::hasRecoverableEdits(journals[i])) {
+			wxMessageDialog dlg(this, wxT("GoOdf wasn't closed properly and there are unsaved changes that can be recovered. Do you want to recover them?"), wxT("Recover unsaved changes"), wxYES_NO|wxCENTRE|wxICON_QUESTION);
+			if (dlg.ShowModal() == wxID_YES) {
+				wxString recoveredPath;
+				if (EditJournal::recover(journals[i], recoveredPath)) {
+					wxMessageDialog msg(this, wxT("The recovered organ has been written to ") + recoveredPath + wxT(" and will now be opened."), wxT("Unsaved changes recovered"), wxOK|wxCENTRE);
+					msg.ShowModal();
+					DoOpenOrgan(recoveredPath);
+					isRecovered = true;
+				} else {
+					wxMessageDialog msg(this, wxT("The unsaved changes couldn't be recovered!"), wxT("Recovery failed"), wxOK|wxCENTRE|wxICON_ERROR);
+					msg.ShowModal();
+				}
+			}
+		}
+		wxRemoveFile(journals[i]);
+	}
+	return isRecovered;
+}
+
 void GOODFFrame::OnReadOrganFile(wxCommandEvent& WXUNUSED(event)) {
 	if (m_organ->isModified()) {
 		wxMessageDialog dlg(this, wxT("All current organ data will be lost! Do you want to proceed?"), wxT("Are you sure?"), wxYES_NO|wxCENTRE|wxICON_EXCLAMATION);
@@ -801,102 +931,281 @@ void GOODFFrame::OnReadOrganFile(wxCommandEvent& WXUNUSED(event)) {
 }
 
 void GOODFFrame::DoOpenOrgan(wxString filePath) {
+	CancelOrganLoading();
 	m_organTreeCtrl->SetFocusedItem(tree_organ);
+	ShowEmptyOrgan();
+	RecreateLogWindow();
+
+	// The structure is parsed on a worker thread into an organ that isn't shown
+	// yet, meanwhile the progress dialog keeps the event loop running.
+	Organ *loadedOrgan = new Organ();
+	SetupOrganContext(loadedOrgan, false);
+	m_organLoader = new OrganLoader(filePath, loadedOrgan, this, ID_ORGAN_LOADER_THREAD);
+	m_organLoaderDlg = new wxProgressDialog(
+		wxT("Parsing ") + filePath,
+		wxT("Reading .organ file"),
+		100,
+		this,
+		wxPD_APP_MODAL|wxPD_AUTO_HIDE|wxPD_CAN_ABORT|wxPD_ELAPSED_TIME
+	);
+	m_organLoader->start();
+	m_organLoaderTimer.Start(100);
+}
+
+void GOODFFrame::CompleteOrganLoading() {
+	// until the structure is shown there is nothing the user can change
+	if (!m_organLoader || m_organLoaderDlg)
+		return;
+	wxBusyCursor busy;
+	while (m_organLoader->loadNextPart());
+	FinishOrganLoading();
+}
+
+void GOODFFrame::OnOrganLoaderThread(wxThreadEvent& event) {
+	OrganLoader *loader = event.GetPayload<OrganLoader*>();
+	if (loader != m_organLoader) {
+		// a cancelled open has stopped parsing and can now be thrown away
+		std::vector<OrganLoader*>::iterator it = std::find(m_cancelledOrganLoaders.begin(), m_cancelledOrganLoaders.end(), loader);
+		if (it != m_cancelledOrganLoaders.end()) {
+			delete *it;
+			m_cancelledOrganLoaders.erase(it);
+		}
+		return;
+	}
+	if (m_organLoaderDlg) {
+		delete m_organLoaderDlg;
+		m_organLoaderDlg = NULL;
+	}
+	if (m_organLoader->hasParsedStructure()) {
+		ShowLoadedOrganStructure();
+	} else {
+		// the empty organ stays, but any problems found are still shown
+		m_organLoaderTimer.Stop();
+		m_organLoader->getOrgan()->getContext()->flushDiagnostics();
+		delete m_organLoader;
+		m_organLoader = NULL;
+		Instrumentation::report();
+	}
+}
+
+void GOODFFrame::OnOrganLoaderTimer(wxTimerEvent& WXUNUSED(event)) {
+	if (!m_organLoader) {
+		m_organLoaderTimer.Stop();
+		return;
+	}
+	wxString message;
+	if (m_organLoaderDlg) {
+		// still parsing on the worker thread, the dialog is closed at 100
+		int progress = m_organLoader->getParsingProgress(message);
+		if (!m_organLoaderDlg->Update(progress < 99 ? progress : 99, message))
+			CancelOrganLoading();
+		return;
+	}
+
+	// load the rest in short slices so that the organ can be used meanwhile
+	wxStopWatch slice;
+	bool hasMoreParts = true;
+	while (hasMoreParts && slice.Time() < 40)
+		hasMoreParts = m_organLoader->loadNextPart();
+	SynchronizePanelsInTree();
+	if (hasMoreParts) {
+		int progress = m_organLoader->getLoadingProgress(message);
+		SetStatusText(wxString::Format(wxT("%s... %i%%"), message, progress));
+	} else {
+		FinishOrganLoading();
+	}
+}
+
+void GOODFFrame::OnCancelOrganLoading(wxCommandEvent& WXUNUSED(event)) {
+	if (!m_organLoader)
+		return;
+	// a partially loaded organ can't be kept
+	CancelOrganLoading();
+	ShowEmptyOrgan();
+}
+
+void GOODFFrame::ShowEmptyOrgan() {
+	WaitForWritingOdf();
+	m_editJournal->reset(wxEmptyString);
 	if (m_organ) {
 		delete m_organ;
 		m_organ = NULL;
 	}
 	m_organ = new Organ();
+	SetupOrganContext(m_organ);
 	removeAllItemsFromTree();
 	m_organHasBeenSaved = false;
-	RecreateLogWindow();
+	SetupOrganMainPanel();
+	m_organPanel->setCurrentOrgan(m_organ);
+	m_organPanel->setOdfPath(wxEmptyString);
+	m_organPanel->setOdfName(wxEmptyString);
+	SetTitle(::wxGetApp().m_fullAppName);
+	m_organ->organElementHasChanged(true);
+	m_organTreeCtrl->SelectItem(tree_organ);
+	SetImportXfadeMenuItemState();
+}
 
-	OrganFileParser parser(filePath, m_organ);
-	if (parser.isOrganReady()) {
-		m_recentlyUsed->AddFileToHistory(filePath);
-		wxFileName f_name = wxFileName(filePath);
-		m_organPanel->setCurrentOrgan(m_organ);
-		m_organPanel->setOdfPath(f_name.GetPath());
-		m_organPanel->setOdfName(f_name.GetName());
-		for (unsigned i = 0; i < m_organ->getNumberOfEnclosures(); i++) {
-			m_organTreeCtrl->AppendItem(tree_enclosures, m_organ->getOrganEnclosureAt(i)->getName());
-		}
-		for (unsigned i = 0; i < m_organ->getNumberOfTremulants(); i++) {
-			m_organTreeCtrl->AppendItem(tree_tremulants, m_organ->getOrganTremulantAt(i)->getName());
-		}
-		for (unsigned i = 0; i < m_organ->getNumberOfWindchestgroups(); i++) {
-			m_organTreeCtrl->AppendItem(tree_windchestgrps, m_organ->getOrganWindchestgroupAt(i)->getName());
-		}
-		for (unsigned i = 0; i < m_organ->getNumberOfSwitches() ; i++) {
-			m_organTreeCtrl->AppendItem(tree_switches, m_organ->getOrganSwitchAt(i)->getName());
-		}
-		for (unsigned i = 0; i < m_organ->getNumberOfRanks() ; i++) {
-			m_organTreeCtrl->AppendItem(tree_ranks, m_organ->getOrganRankAt(i)->getName());
-		}
-		for (unsigned i = 0; i < m_organ->getNumberOfManuals() ; i++) {
-			wxTreeItemId thisManual = m_organTreeCtrl->AppendItem(tree_manuals, m_organ->getOrganManualAt(i)->getName());
+void GOODFFrame::ShowLoadedOrganStructure() {
+	ScopedTimer treeTimer("load.buildTree");
+	wxString filePath = m_organLoader->getFilePath();
+	if (m_organ)
+		delete m_organ;
+	m_organ = m_organLoader->getOrgan();
+	m_organLoader->releaseOrgan();
+	SetupOrganContext(m_organ);
+	m_organ->getContext()->flushDiagnostics();
+	removeAllItemsFromTree();
+
+	m_recentlyUsed->AddFileToHistory(filePath);
+	wxFileName f_name = wxFileName(filePath);
+	m_organPanel->setCurrentOrgan(m_organ);
+	m_organPanel->setOdfPath(f_name.GetPath());
+	m_organPanel->setOdfName(f_name.GetName());
+	for (unsigned i = 0; i < m_organ->getNumberOfEnclosures(); i++) {
+		m_organTreeCtrl->AppendItem(tree_enclosures, m_organ->getOrganEnclosureAt(i)->getName());
+	}
+	for (unsigned i = 0; i < m_organ->getNumberOfTremulants(); i++) {
+		m_organTreeCtrl->AppendItem(tree_tremulants, m_organ->getOrganTremulantAt(i)->getName());
+	}
+	for (unsigned i = 0; i < m_organ->getNumberOfWindchestgroups(); i++) {
+		m_organTreeCtrl->AppendItem(tree_windchestgrps, m_organ->getOrganWindchestgroupAt(i)->getName());
+	}
+	for (unsigned i = 0; i < m_organ->getNumberOfSwitches() ; i++) {
+		m_organTreeCtrl->AppendItem(tree_switches, m_organ->getOrganSwitchAt(i)->getName());
+	}
+	for (unsigned i = 0; i < m_organ->getNumberOfRanks() ; i++) {
+		m_organTreeCtrl->AppendItem(tree_ranks, m_organ->getOrganRankAt(i)->getName());
+	}
+	for (unsigned i = 0; i < m_organ->getNumberOfManuals() ; i++) {
+		wxTreeItemId thisManual = m_organTreeCtrl->AppendItem(tree_manuals, m_organ->getOrganManualAt(i)->getName());
 
-			// create the subitems for Stops, Couplers and Divisionals
-			wxTreeItemId thisManualStops = m_organTreeCtrl->AppendItem(thisManual, wxT("Stops"));
-			wxTreeItemId thisManualCouplers = m_organTreeCtrl->AppendItem(thisManual, wxT("Couplers"));
-			wxTreeItemId thisManualDivisionals = m_organTreeCtrl->AppendItem(thisManual, wxT("Divisionals"));
+		// create the subitems for Stops, Couplers and Divisionals
+		wxTreeItemId thisManualStops = m_organTreeCtrl->AppendItem(thisManual, wxT("Stops"));
+		wxTreeItemId thisManualCouplers = m_organTreeCtrl->AppendItem(thisManual, wxT("Couplers"));
+		wxTreeItemId thisManualDivisionals = m_organTreeCtrl->AppendItem(thisManual, wxT("Divisionals"));
 
-			// then they can be populated
-			for (unsigned j = 0; j < m_organ->getOrganManualAt(i)->getNumberOfStops(); j++) {
-				m_organTreeCtrl->AppendItem(thisManualStops, m_organ->getOrganManualAt(i)->getStopAt(j)->getName());
-			}
-			for (unsigned j = 0; j < m_organ->getOrganManualAt(i)->getNumberOfCouplers(); j++) {
-				m_organTreeCtrl->AppendItem(thisManualCouplers, m_organ->getOrganManualAt(i)->getCouplerAt(j)->getName());
-			}
-			for (unsigned j = 0; j < m_organ->getOrganManualAt(i)->getNumberOfDivisionals(); j++) {
-				m_organTreeCtrl->AppendItem(thisManualDivisionals, m_organ->getOrganManualAt(i)->getDivisionalAt(j)->getName());
-			}
-		}
-		for (unsigned i = 0; i < m_organ->getNumberOfOrganDivisionalCouplers() ; i++) {
-			m_organTreeCtrl->AppendItem(tree_divisionalCouplers, m_organ->getOrganDivisionalCouplerAt(i)->getName());
+		// then they can be populated
+		for (unsigned j = 0; j < m_organ->getOrganManualAt(i)->getNumberOfStops(); j++) {
+			m_organTreeCtrl->AppendItem(thisManualStops, m_organ->getOrganManualAt(i)->getStopAt(j)->getName());
 		}
-		for (unsigned i = 0; i < m_organ->getNumberOfGenerals() ; i++) {
-			m_organTreeCtrl->AppendItem(tree_generals, m_organ->getOrganGeneralAt(i)->getName());
+		for (unsigned j = 0; j < m_organ->getOrganManualAt(i)->getNumberOfCouplers(); j++) {
+			m_organTreeCtrl->AppendItem(thisManualCouplers, m_organ->getOrganManualAt(i)->getCouplerAt(j)->getName());
 		}
-		for (unsigned i = 0; i < m_organ->getNumberOfReversiblePistons() ; i++) {
-			m_organTreeCtrl->AppendItem(tree_reversiblePistons, m_organ->getReversiblePistonAt(i)->getName());
+		for (unsigned j = 0; j < m_organ->getOrganManualAt(i)->getNumberOfDivisionals(); j++) {
+			m_organTreeCtrl->AppendItem(thisManualDivisionals, m_organ->getOrganManualAt(i)->getDivisionalAt(j)->getName());
 		}
-		for (unsigned i = 0; i < m_organ->getNumberOfPanels(); i++) {
-			wxTreeItemId thisPanel = m_organTreeCtrl->AppendItem(tree_panels, m_organ->getOrganPanelAt(i)->getName());
+	}
+	for (unsigned i = 0; i < m_organ->getNumberOfOrganDivisionalCouplers() ; i++) {
+		m_organTreeCtrl->AppendItem(tree_divisionalCouplers, m_organ->getOrganDivisionalCouplerAt(i)->getName());
+	}
+	for (unsigned i = 0; i < m_organ->getNumberOfGenerals() ; i++) {
+		m_organTreeCtrl->AppendItem(tree_generals, m_organ->getOrganGeneralAt(i)->getName());
+	}
+	for (unsigned i = 0; i < m_organ->getNumberOfReversiblePistons() ; i++) {
+		m_organTreeCtrl->AppendItem(tree_reversiblePistons, m_organ->getReversiblePistonAt(i)->getName());
+	}
+	SynchronizePanelsInTree();
+	UpdateFrameTitle();
+	m_organ->organElementHasChanged(true);
+	m_organTreeCtrl->SelectItem(tree_organ);
+	SetImportXfadeMenuItemState();
+
+	// the panels and pipes are loaded while the organ can already be used
+	if (!GetStatusBar())
+		CreateStatusBar();
+	SetStatusText(wxT("Loading panels and pipes..."));
+	m_fileMenu->Enable(ID_CANCEL_ORGAN_LOADING, true);
+	this->Raise();
+	if (m_logWindow->GetFrame()->IsShown())
+		m_logWindow->GetFrame()->Raise();
+}
+
+void GOODFFrame::SynchronizePanelsInTree() {
+	wxTreeItemIdValue cookie;
+	wxTreeItemId panelItem = m_organTreeCtrl->GetFirstChild(tree_panels, cookie);
+	for (unsigned i = 0; i < m_organ->getNumberOfPanels(); i++) {
+		GoPanel *panel = m_organ->getOrganPanelAt(i);
+		if (!panelItem.IsOk()) {
+			panelItem = m_organTreeCtrl->AppendItem(tree_panels, panel->getName());
 
 			// create the subitems for Displaymetrics, Images and GUIElements
-			m_organTreeCtrl->AppendItem(thisPanel, wxT("Displaymetrics"));
-			wxTreeItemId panelImages = m_organTreeCtrl->AppendItem(thisPanel, wxT("Images"));
-			m_organTreeCtrl->AppendItem(thisPanel, wxT("GUI Elements"));
+			m_organTreeCtrl->AppendItem(panelItem, wxT("Displaymetrics"));
+			m_organTreeCtrl->AppendItem(panelItem, wxT("Images"));
+			m_organTreeCtrl->AppendItem(panelItem, wxT("GUI Elements"));
+		} else if (m_organTreeCtrl->GetItemText(panelItem) != panel->getName()) {
+			m_organTreeCtrl->SetItemText(panelItem, panel->getName());
+		}
 
-			for (unsigned j = 0; j < m_organ->getOrganPanelAt(i)->getNumberOfImages(); j++) {
-				m_organTreeCtrl->AppendItem(panelImages, m_organ->getOrganPanelAt(i)->getImageAt(j)->getImageNameOnly());
+		wxTreeItemIdValue panelCookie;
+		m_organTreeCtrl->GetFirstChild(panelItem, panelCookie);
+		wxTreeItemId panelImages = m_organTreeCtrl->GetNextChild(panelItem, panelCookie);
+		if (m_organTreeCtrl->GetChildrenCount(panelImages, false) != panel->getNumberOfImages()) {
+			m_organTreeCtrl->DeleteChildren(panelImages);
+			for (unsigned j = 0; j < panel->getNumberOfImages(); j++) {
+				m_organTreeCtrl->AppendItem(panelImages, panel->getImageAt(j)->getImageNameOnly());
 			}
-			RebuildPanelGuiElementsInTree(i);
 		}
-		UpdateFrameTitle();
-	} else {
-		if (m_organ) {
-			delete m_organ;
-			m_organ = NULL;
-		}
-		m_organ = new Organ();
-		removeAllItemsFromTree();
-		m_organHasBeenSaved = false;
-		SetupOrganMainPanel();
-		m_organPanel->setCurrentOrgan(m_organ);
-		m_organPanel->setOdfPath(wxEmptyString);
-		m_organPanel->setOdfName(wxEmptyString);
-		SetTitle(::wxGetApp().m_fullAppName);
+		wxTreeItemId guiElements = m_organTreeCtrl->GetLastChild(panelItem);
+		if (m_organTreeCtrl->GetChildrenCount(guiElements, false) != (size_t) panel->getNumberOfGuiElements())
+			RebuildPanelGuiElementsInTree(i);
+
+		panelItem = m_organTreeCtrl->GetNextChild(tree_panels, cookie);
 	}
+}
+
+void GOODFFrame::FinishOrganLoading() {
+	m_organLoaderTimer.Stop();
+	m_organLoader->finish();
+	delete m_organLoader;
+	m_organLoader = NULL;
+	SynchronizePanelsInTree();
+	HideOrganLoadingStatus();
 	m_organ->organElementHasChanged(true);
-	m_organTreeCtrl->SelectItem(tree_organ);
-	SetImportXfadeMenuItemState();
-	this->Raise();
+	// edits made while loading can't be told apart, so then all is recorded
+	wxString odfFilePath = m_organPanel->getOdfPath() + wxFILE_SEP_PATH + m_organPanel->getOdfName() + wxT(".organ");
+	if (m_organ->isModified()) {
+		m_editJournal->reset(odfFilePath);
+		ScheduleEditJournalCheckpoint();
+	} else {
+		wxTextFile baseLines;
+		std::map<wxString, unsigned long long> cachedSections;
+		m_organ->getContext()->setDiscardingDiagnostics(true);
+		m_organ->writeOrgan(&baseLines, &cachedSections);
+		m_organ->getContext()->setDiscardingDiagnostics(false);
+		m_editJournal->reset(odfFilePath, &baseLines, &cachedSections);
+	}
+	Instrumentation::report();
 	if (m_logWindow->GetFrame()->IsShown())
 		m_logWindow->GetFrame()->Raise();
 }
 
+void GOODFFrame::CancelOrganLoading() {
+	if (!m_organLoader)
+		return;
+	m_organLoaderTimer.Stop();
+	if (m_organLoaderDlg) {
+		// the worker stops at the next section and is thrown away when it reports back
+		delete m_organLoaderDlg;
+		m_organLoaderDlg = NULL;
+		m_organLoader->cancel();
+		m_cancelledOrganLoaders.push_back(m_organLoader);
+	} else {
+		delete m_organLoader;
+	}
+	m_organLoader = NULL;
+	HideOrganLoadingStatus();
+}
+
+void GOODFFrame::HideOrganLoadingStatus() {
+	m_fileMenu->Enable(ID_CANCEL_ORGAN_LOADING, false);
+	wxStatusBar *statusBar = GetStatusBar();
+	if (statusBar) {
+		SetStatusBar(NULL);
+		statusBar->Destroy();
+		SendSizeEvent();
+	}
+}
+
 void GOODFFrame::OrganTreeChildItemLabelChanged(wxString label) {
 	wxTreeItemId selected;
 	selected = m_organTreeCtrl->GetSelection();
@@ -2946,11 +3255,15 @@ void GOODFFrame::OnNewOrgan(wxCommandEvent& WXUNUSED(event)) {
 	if (m_organ->isModified()) {
 		wxMessageDialog dlg(this, wxT("Are you really sure you want to create a completely new organ?"), wxT("Are you sure?"), wxYES_NO|wxCENTRE|wxICON_EXCLAMATION);
 		if (dlg.ShowModal() == wxID_YES) {
+			CancelOrganLoading();
+			WaitForWritingOdf();
+			m_editJournal->reset(wxEmptyString);
 			if (m_organ) {
 				delete m_organ;
 				m_organ = NULL;
 			}
 			m_organ = new Organ();
+			SetupOrganContext(m_organ);
 			m_organHasBeenSaved = false;
 
 			removeAllItemsFromTree();
@@ -2964,11 +3277,15 @@ void GOODFFrame::OnNewOrgan(wxCommandEvent& WXUNUSED(event)) {
 			RecreateLogWindow();
 		}
 	} else {
+		CancelOrganLoading();
+		WaitForWritingOdf();
+		m_editJournal->reset(wxEmptyString);
 		if (m_organ) {
 			delete m_organ;
 			m_organ = NULL;
 		}
 		m_organ = new Organ();
+		SetupOrganContext(m_organ);
 		m_organHasBeenSaved = false;
 
 		removeAllItemsFromTree();
@@ -3046,6 +3363,8 @@ void GOODFFrame::OnAddNewReversiblePiston(wxCommandEvent& WXUNUSED(event)) {
 }
 
 void GOODFFrame::OnAddNewPanel(wxCommandEvent& WXUNUSED(event)) {
+	// the panels still being loaded must keep their numbers
+	CompleteOrganLoading();
 	if (m_organ->getNumberOfPanels() < 1000) {
 		GoPanel p;
 		m_organ->addPanel(p);
@@ -3161,10 +3480,9 @@ void GOODFFrame::OnImportCMB(wxCommandEvent& WXUNUSED(event)) {
 
 		unsigned stopIdx = 0;
 		for (CMB_ELEMENT_WITH_PIPES &s : imported->cmbStops) {
-			if (m_organ->getNumberOfStops() > stopIdx) {
+			// stops without an internal rank are skipped but still counted
+			if (m_organ->getNumberOfStops() > stopIdx && m_organ->getOrganStopAt(stopIdx)->isUsingInternalRank()) {
 				Stop *stop = m_organ->getOrganStopAt(stopIdx);
-				if (!stop->isUsingInternalRank())
-					continue;
 
 				if (importCmb.GetImportAmplitude())
 					stop->getInternalRank()->setAmplitudeLevel(s.attributes.amplitude);
@@ -3202,11 +3520,17 @@ void GOODFFrame::OnImportCMB(wxCommandEvent& WXUNUSED(event)) {
 					stop->getInternalRank()->setTrackerDelay(s.attributes.trackerDelay);
 				}
 
-				// next deal with the pipes in the internal rank of the stop
+				// next deal with the pipes in the internal rank of the stop, which are walked
+				// through once as the imported pipes come sorted by number
+				stop->getInternalRank()->loadPipes();
+				auto pipeIt = stop->getInternalRank()->m_pipes.begin();
+				unsigned currentPipeIdx = 0;
 				for (CMB_PIPE &p : s.pipes) {
 					unsigned pipeIdx = p.pipeNbr - 1;
 					if (pipeIdx < stop->getInternalRank()->m_pipes.size()) {
-						Pipe *pipe = stop->getInternalRank()->getPipeAt(pipeIdx);
+						std::advance(pipeIt, pipeIdx - currentPipeIdx);
+						currentPipeIdx = pipeIdx;
+						Pipe *pipe = &(*pipeIt);
 
 						if (importCmb.GetImportAmplitude())
 							pipe->amplitudeLevel = p.attributes.amplitude;
@@ -3237,6 +3561,7 @@ void GOODFFrame::OnImportCMB(wxCommandEvent& WXUNUSED(event)) {
 		for (CMB_ELEMENT_WITH_PIPES &r : imported->cmbRanks) {
 			if (m_organ->getNumberOfRanks() > rankIdx) {
 				Rank *rank = m_organ->getOrganRankAt(rankIdx);
+				rank->loadPipes();
 
 				if (importCmb.GetImportAmplitude())
 					rank->setAmplitudeLevel(r.attributes.amplitude);
@@ -3274,11 +3599,16 @@ void GOODFFrame::OnImportCMB(wxCommandEvent& WXUNUSED(event)) {
 					rank->setTrackerDelay(r.attributes.trackerDelay);
 				}
 
-				// next deal with the pipes in the rank
+				// next deal with the pipes in the rank, which are walked
+				// through once as the imported pipes come sorted by number
+				auto pipeIt = rank->m_pipes.begin();
+				unsigned currentPipeIdx = 0;
 				for (CMB_PIPE &p : r.pipes) {
 					unsigned pipeIdx = p.pipeNbr - 1;
 					if (pipeIdx < rank->m_pipes.size()) {
-						Pipe *pipe = rank->getPipeAt(pipeIdx);
+						std::advance(pipeIt, pipeIdx - currentPipeIdx);
+						currentPipeIdx = pipeIdx;
+						Pipe *pipe = &(*pipeIt);
 
 						if (importCmb.GetImportAmplitude())
 							pipe->amplitudeLevel = p.attributes.amplitude;
@@ -3308,14 +3638,7 @@ void GOODFFrame::OnImportCMB(wxCommandEvent& WXUNUSED(event)) {
 		// Update display in panels
 		m_organ->setModified(true);
 		m_organPanel->setCurrentOrgan(m_organ);
-		if (m_rankPanel->IsShown()) {
-			Rank *currentRank = m_rankPanel->getCurrentRank();
-			m_rankPanel->setRank(currentRank);
-		}
-		if (m_stopPanel->IsShown()) {
-			Stop *currentStop = m_stopPanel->getCurrentStop();
-			m_stopPanel->setStop(currentStop);
-		}
+		RefreshRankAndStopPanels();
 	}
 }
 
@@ -3353,6 +3676,277 @@ void GOODFFrame::OnEnableKeepfilesMenu(wxCommandEvent& WXUNUSED(event)) {
 	} else {
 		m_keepMissingFiles = false;
 	}
+	SetupOrganContext(m_organ);
+}
+
+void GOODFFrame::OnEnableLoadPipesOnDemandMenu(wxCommandEvent& WXUNUSED(event)) {
+	if (m_toolsMenu->IsChecked(ID_GLOBAL_LOAD_PIPES_ON_DEMAND_OPTION)) {
+		m_loadPipesOnDemand = true;
+	} else {
+		m_loadPipesOnDemand = false;
+	}
+	SetupOrganContext(m_organ);
+}
+
+void GOODFFrame::OnSampleNamingMenu(wxCommandEvent& WXUNUSED(event)) {
+	wxArrayString schemes;
+	schemes.Add(wxT("MIDI number in the name (036-c.wav)"));
+	schemes.Add(wxT("Note name in the name (C2.wav, c#3.wav, fis4.wav)"));
+	schemes.Add(wxT("Custom pattern"));
+	wxSingleChoiceDialog schemeDialog(
+		this,
+		wxT("Choose how the MIDI note of a sample is found from its file name\nwhen pipes are read from folders."),
+		wxT("Sample naming scheme"),
+		schemes
+	);
+	schemeDialog.SetSelection(m_sampleNamingScheme);
+	if (schemeDialog.ShowModal() != wxID_OK)
+		return;
+
+	int scheme = schemeDialog.GetSelection();
+	wxString pattern = m_sampleNamePattern;
+	if (scheme == SampleNameMatcher::CUSTOM_PATTERN_SCHEME) {
+		wxTextEntryDialog patternDialog(
+			this,
+			wxT("Pattern for the file name without suffix, where %m is the MIDI number\nor %n the note name, * any text and ? any single character.\nFor example: Pipe_%m_* or *-%n"),
+			wxT("Custom sample name pattern"),
+			m_sampleNamePattern
+		);
+		if (patternDialog.ShowModal() != wxID_OK)
+			return;
+		pattern = patternDialog.GetValue();
+		if (!SampleNameMatcher::isValidPattern(pattern)) {
+			wxMessageDialog msg(this, wxT("The pattern must contain either %m or %n exactly once."), wxT("Invalid pattern"), wxOK|wxCENTRE|wxICON_ERROR);
+			msg.ShowModal();
+			return;
+		}
+	}
+	int convention = m_noteNameConvention;
+	if (scheme == SampleNameMatcher::NOTE_NAME_SCHEME || (scheme == SampleNameMatcher::CUSTOM_PATTERN_SCHEME && pattern.Find(wxT("%n")) != wxNOT_FOUND)) {
+		wxArrayString conventions;
+		conventions.Add(wxT("English (B3.wav is B, Bb3.wav is B flat)"));
+		conventions.Add(wxT("German (h3.wav is B, b3.wav is B flat)"));
+		wxSingleChoiceDialog conventionDialog(
+			this,
+			wxT("Choose how the letters b and h in note names are understood."),
+			wxT("Note names"),
+			conventions
+		);
+		conventionDialog.SetSelection(m_noteNameConvention);
+		if (conventionDialog.ShowModal() != wxID_OK)
+			return;
+		convention = conventionDialog.GetSelection();
+	}
+	m_sampleNamingScheme = scheme;
+	if (scheme == SampleNameMatcher::CUSTOM_PATTERN_SCHEME)
+		m_sampleNamePattern = pattern;
+	m_noteNameConvention = convention;
+	SetupOrganContext(m_organ);
+}
+
+void GOODFFrame::OnFindDuplicateSamples(wxCommandEvent& WXUNUSED(event)) {
+	DuplicateSampleFinder finder(m_organ);
+	bool completed = GOODF_functions::runWithProgress(this, wxT("Finding duplicate samples"), wxT("Comparing sample files"), true, [&](const std::function<bool(size_t, size_t)> &progress) {
+		return finder.find(progress);
+	});
+	if (!completed)
+		return;
+
+	if (finder.getGroups().empty()) {
+		wxMessageDialog msg(this, wxString::Format(wxT("No identical samples were found among the %u sample files."), finder.getNumberOfSampleFiles()), wxT("No duplicate samples"), wxOK|wxCENTRE|wxICON_INFORMATION);
+		msg.ShowModal();
+		return;
+	}
+
+	DuplicateSamplesDialog duplicatesDlg(&finder, this);
+	if (duplicatesDlg.ShowModal() == wxID_OK && duplicatesDlg.GetNumberOfChanges() > 0) {
+		// Update display in panels
+		m_organ->setModified(true);
+		RefreshRankAndStopPanels();
+	}
+}
+
+void GOODFFrame::OnEstimateMemoryFootprint(wxCommandEvent& WXUNUSED(event)) {
+	MemoryFootprintEstimator estimator(m_organ);
+	bool completed = GOODF_functions::runWithProgress(this, wxT("Estimating memory footprint"), wxT("Reading sample files"), true, [&](const std::function<bool(size_t, size_t)> &progress) {
+		return estimator.estimate(progress);
+	});
+	if (!completed)
+		return;
+
+	MemoryFootprintDialog footprintDlg(&estimator, this);
+	footprintDlg.ShowModal();
+}
+
+void GOODFFrame::OnLoopQualityReport(wxCommandEvent& WXUNUSED(event)) {
+	std::vector<std::pair<Rank*, wxString>> ranks = GetAllRanks();
+	std::vector<LoopAnalyzer::ATTACK_RESULT> results;
+	bool completed = GOODF_functions::runWithProgress(this, wxT("Checking loops"), wxT("Analyzing the loops of all attacks"), true, [&](const std::function<bool(size_t, size_t)> &progress) {
+		return LoopAnalyzer::analyzeRanks(ranks, results, progress);
+	});
+	if (!completed)
+		return;
+
+	LoopQualityDialog reportDlg(results, this);
+	reportDlg.ShowModal();
+}
+
+void GOODFFrame::OnLoudnessReport(wxCommandEvent& WXUNUSED(event)) {
+	std::vector<std::pair<Rank*, wxString>> ranks = GetAllRanks();
+	std::vector<LoudnessAnalyzer::PIPE_LOUDNESS> results;
+	bool completed = GOODF_functions::runWithProgress(this, wxT("Measuring loudness"), wxT("Measuring the loudness of all pipes"), true, [&](const std::function<bool(size_t, size_t)> &progress) {
+		return LoudnessAnalyzer::measureRanks(ranks, results, progress);
+	});
+	if (!completed)
+		return;
+
+	LoudnessDialog loudnessDlg(&results, this);
+	if (loudnessDlg.ShowModal() == wxID_OK && loudnessDlg.GetNumberOfChanges() > 0) {
+		// Update display in panels
+		m_organ->setModified(true);
+		RefreshRankAndStopPanels();
+	}
+}
+
+void GOODFFrame::OnWriteSampleChunks(wxCommandEvent& WXUNUSED(event)) {
+	std::vector<SampleChunkWriter::SAMPLE_PATCH> patches;
+	unsigned conflicts = SampleChunkWriter::collectPatches(GetAllRanks(), patches);
+	if (patches.empty()) {
+		wxMessageDialog msg(this, wxT("No attack or release has loops or a cue point set in the .organ file."), wxT("Write loops/cues to samples"), wxOK|wxCENTRE|wxICON_INFORMATION);
+		msg.ShowModal();
+		return;
+	}
+	wxString question = wxString::Format(wxT("The loops and cue points set in the .organ file will be written into %u sample file(s), replacing the ones stored in them. The audio is left as it is. Continue?"), (unsigned) patches.size());
+	if (conflicts)
+		question += wxString::Format(wxT("\n\n%u attack(s)/release(s) use a sample file already written with other values and will be skipped."), conflicts);
+	wxMessageDialog confirm(this, question, wxT("Write loops/cues to samples"), wxYES_NO|wxCENTRE|wxICON_QUESTION);
+	if (confirm.ShowModal() != wxID_YES)
+		return;
+
+	bool completed = GOODF_functions::runWithProgress(this, wxT("Writing samples"), wxT("Writing loops and cue points to the sample files"), true, [&](const std::function<bool(size_t, size_t)> &progress) {
+		return SampleChunkWriter::patchFiles(patches, progress);
+	});
+
+	unsigned written = 0;
+	wxString failures;
+	for (SampleChunkWriter::SAMPLE_PATCH &patch : patches) {
+		if (patch.isWritten)
+			written++;
+		else if (!patch.errorMessage.IsEmpty())
+			failures += wxT("\n") + patch.errorMessage.Trim();
+	}
+	wxString message = wxString::Format(wxT("%u sample file(s) were written."), written);
+	if (!completed)
+		message += wxT("\nThe writing was cancelled.");
+	if (!failures.IsEmpty())
+		message += wxT("\n") + failures;
+	wxMessageDialog msg(this, message, wxT("Write loops/cues to samples"), wxOK|wxCENTRE|wxICON_INFORMATION);
+	msg.ShowModal();
+}
+
+void GOODFFrame::OnValidateSamples(wxCommandEvent& WXUNUSED(event)) {
+	std::vector<std::pair<Rank*, wxString>> ranks = GetAllRanks();
+	// the validator is kept so that checking again only reads what changed
+	bool completed = GOODF_functions::runWithProgress(this, wxT("Validating samples"), wxT("Checking the samples of all ranks"), true, [&](const std::function<bool(size_t, size_t)> &progress) {
+		return m_sampleValidator->validate(ranks, progress);
+	});
+	if (!completed)
+		return;
+
+	SampleValidationDialog validationDlg(m_sampleValidator, ranks, this);
+	validationDlg.ShowModal();
+}
+
+void GOODFFrame::OnExportTrimmedSamples(wxCommandEvent& WXUNUSED(event)) {
+	ExportTrimmedSamples(GetAllRanks());
+}
+
+void GOODFFrame::ExportTrimmedSamples(const std::vector<std::pair<Rank*, wxString>> &ranks) {
+	wxDirDialog dirDialog(
+		this,
+		wxT("Pick a directory to write the trimmed samples to"),
+		m_organ->getOdfRoot(),
+		wxDD_DIR_MUST_EXIST
+	);
+	if (dirDialog.ShowModal() != wxID_OK)
+		return;
+	if (wxFileName::DirName(dirDialog.GetPath()).SameAs(wxFileName::DirName(m_organ->getOdfRoot()))) {
+		wxMessageDialog msg(this, wxT("The trimmed samples would replace the original ones. Pick another directory, like a sub directory of the .organ file directory."), wxT("Export trimmed samples"), wxOK|wxCENTRE|wxICON_ERROR);
+		msg.ShowModal();
+		return;
+	}
+
+	SampleTrimExporter exporter(m_organ);
+	exporter.collectSamples(ranks, dirDialog.GetPath());
+	if (exporter.getFiles().empty()) {
+		wxMessageDialog msg(this, wxT("There are no sample files to export."), wxT("Export trimmed samples"), wxOK|wxCENTRE|wxICON_INFORMATION);
+		msg.ShowModal();
+		return;
+	}
+	wxString question = wxString::Format(wxT("%u sample file(s) will be written to %s without the audio that is never played, and the .organ file will use them instead of the original ones. Continue?"), (unsigned) exporter.getFiles().size(), dirDialog.GetPath());
+	wxMessageDialog confirm(this, question, wxT("Export trimmed samples"), wxYES_NO|wxCENTRE|wxICON_QUESTION);
+	if (confirm.ShowModal() != wxID_YES)
+		return;
+
+	bool completed = GOODF_functions::runWithProgress(this, wxT("Exporting samples"), wxT("Writing the trimmed samples"), true, [&](const std::function<bool(size_t, size_t)> &progress) {
+		return exporter.exportFiles(progress);
+	});
+	unsigned changedSamples = exporter.applyToOdf();
+
+	unsigned written = 0;
+	unsigned long long sourceBytes = 0;
+	unsigned long long outputBytes = 0;
+	wxString failures;
+	for (const SampleTrimExporter::EXPORT_FILE &file : exporter.getFiles()) {
+		if (file.isWritten) {
+			written++;
+			sourceBytes += file.sourceSize;
+			outputBytes += file.outputSize;
+		} else if (!file.errorMessage.IsEmpty()) {
+			wxString error = file.errorMessage;
+			failures += wxT("\n") + error.Trim();
+		}
+	}
+	wxString message = wxString::Format(
+		wxT("%u sample file(s) were written, %.1f MB instead of %.1f MB. %u attack(s)/release(s) now use them."),
+		written,
+		outputBytes / 1048576.0,
+		sourceBytes / 1048576.0,
+		changedSamples
+	);
+	if (!completed)
+		message += wxT("\nThe export was cancelled.");
+	if (!failures.IsEmpty())
+		message += wxT("\n") + failures;
+	wxMessageDialog msg(this, message, wxT("Export trimmed samples"), wxOK|wxCENTRE|wxICON_INFORMATION);
+	msg.ShowModal();
+
+	if (changedSamples > 0)
+		RefreshRankAndStopPanels();
+}
+
+void GOODFFrame::RefreshRankAndStopPanels() {
+	// shows the changes made to the current rank or stop by a tool
+	if (m_rankPanel->IsShown()) {
+		Rank *currentRank = m_rankPanel->getCurrentRank();
+		m_rankPanel->setRank(currentRank);
+	}
+	if (m_stopPanel->IsShown()) {
+		Stop *currentStop = m_stopPanel->getCurrentStop();
+		m_stopPanel->setStop(currentStop);
+	}
+}
+
+std::vector<std::pair<Rank*, wxString>> GOODFFrame::GetAllRanks() {
+	std::vector<std::pair<Rank*, wxString>> ranks;
+	for (unsigned i = 0; i < m_organ->getNumberOfRanks(); i++)
+		ranks.push_back(std::make_pair(m_organ->getOrganRankAt(i), m_organ->getOrganRankAt(i)->getName()));
+	for (unsigned i = 0; i < m_organ->getNumberOfStops(); i++) {
+		Stop *stop = m_organ->getOrganStopAt(i);
+		if (stop->isUsingInternalRank())
+			ranks.push_back(std::make_pair(stop->getInternalRank(), stop->getName() + wxT(" (internal rank)")));
+	}
+	return ranks;
 }
 
 void GOODFFrame::OnRecentFileMenuChoice(wxCommandEvent& event) {
@@ -3410,12 +4004,14 @@ void GOODFFrame::OnImportStopRank(wxCommandEvent& WXUNUSED(event)) {
 	organFilePath = fileDialog.GetPath();
 
 	Organ *sourceOrgan = new Organ();
+	SetupOrganContext(sourceOrgan, false);
 
-	OrganFileParser parser(organFilePath, sourceOrgan);
-	if (parser.isOrganReady()) {
-		StopRankImportDialog importDialog(sourceOrgan, m_organ, this);
+	// only the sections of the stops and ranks that are used get parsed
+	OdfSectionIndex sourceIndex;
+	if (sourceIndex.build(organFilePath) && sourceIndex.hasSection(wxT("Organ"))) {
+		StopRankImportDialog importDialog(sourceOrgan, &sourceIndex, m_organ, this);
 		importDialog.ShowModal();
-
+		Instrumentation::report();
 	} else {
 		wxMessageDialog msg(this, wxT("The selected .organ file could not be parsed for importing any stops/ranks!"), wxT("Failure to parse .organ file"), wxOK|wxCENTRE|wxICON_ERROR);
 		msg.ShowModal();
@@ -3487,9 +4083,12 @@ void GOODFFrame::RebuildPanelGuiElementsInTree(int panelIndex) {
 	}
 }
 
-void GOODFFrame::PanelGUIPropertyIsChanged() {
+void GOODFFrame::PanelGUIPropertyIsChanged(GoPanel *changedPanel) {
 	m_panelPanel->updateRepresentationLayout();
-	m_organ->setModified(true);
+	if (changedPanel)
+		m_organ->setSectionModified(changedPanel);
+	else
+		m_organ->setModified(true);
 }
 
 void GOODFFrame::GUIElementPositionIsChanged() {
@@ -3501,6 +4100,12 @@ void GOODFFrame::GUIElementPositionIsChanged() {
 	m_organ->setModified(true);
 }
 
+void GOODFFrame::OrganModifiedStateChanged() {
+	UpdateFrameTitle();
+	if (m_organ && m_organ->isModified())
+		ScheduleEditJournalCheckpoint();
+}
+
 void GOODFFrame::UpdateFrameTitle() {
 	if (m_organ->isModified()) {
 		SetTitle(::wxGetApp().m_fullAppName + wxT(" - ") + m_organPanel->getOdfName() + wxT(" (modified)"));
@@ -3561,6 +4166,21 @@ void GOODFFrame::RecreateLogWindow() {
 	wxLog::SetActiveTarget(m_logWindow);
 }
 
+void GOODFFrame::SetupOrganContext(Organ *organ, bool attachToUi) {
+	OrganContext *context = organ->getContext();
+	context->setKeepMissingFiles(m_keepMissingFiles);
+	context->setLoadPipesOnDemand(m_loadPipesOnDemand);
+	context->setSampleNamingScheme(m_sampleNamingScheme);
+	context->setSampleNamePattern(m_sampleNamePattern);
+	context->setNoteNameConvention(m_noteNameConvention);
+	OrganContext::UI_CALLBACKS callbacks;
+	callbacks.panelGuiElementsChanged = [this](unsigned panelIndex) { RebuildPanelGuiElementsInTree(panelIndex); };
+	callbacks.modifiedStateChanged = [this]() { OrganModifiedStateChanged(); };
+	callbacks.structureWillChange = [this]() { CompleteOrganLoading(); };
+	callbacks.showLogWindow = [this]() { GetLogWindow()->Show(true); };
+	context->setAttachedToUi(attachToUi, callbacks);
+}
+
 void GOODFFrame::SetImportXfadeMenuItemState() {
 	if (!m_organ->getNumberOfRanks() && !m_organ->getNumberOfStops())
 		m_toolsMenu->Enable(ID_GLOBAL_PARSE_LEGACY_XFADES_OPTION, false);
@@ -29,6 +29,10 @@
 #include <wx/spinctrl.h>
 #include <wx/filehistory.h>
 #include <wx/fileconf.h>
+#include <wx/progdlg.h>
+#include <wx/timer.h>
+#include <wx/stopwatch.h>
+#include <vector>
 #include "EnclosurePanel.h"
 #include "TremulantPanel.h"
 #include "WindchestgroupPanel.h"
@@ -49,6 +53,11 @@
 #include "GUILabelPanel.h"
 #include "GUIManualPanel.h"
 
+class OrganLoader;
+class OdfFileWriter;
+class EditJournal;
+class SampleValidator;
+
 class GOODFFrame : public wxFrame {
 public:
 	GOODFFrame(const wxString& title);
@@ -61,6 +70,8 @@ public:
 	void OnWriteODF(wxCommandEvent& event);
 	void OnReadOrganFile(wxCommandEvent& event);
 	void DoOpenOrgan(wxString filePath);
+	void CompleteOrganLoading();
+	bool RecoverFromEditJournals();
 
 	void OrganTreeChildItemLabelChanged(wxString label);
 	void RemoveCurrentItemFromOrgan();
@@ -74,17 +85,23 @@ public:
 	void AddImageItemToTree();
 	void AddGuiElementToTree(wxString title);
 	void RebuildPanelGuiElementsInTree(int panelIndex);
-	void PanelGUIPropertyIsChanged();
+	void PanelGUIPropertyIsChanged(GoPanel *changedPanel = NULL);
 	void GUIElementPositionIsChanged();
 	void UpdateFrameTitle();
+	void OrganModifiedStateChanged();
 	void SynchronizePipeReadingOptions(RankPanel* rankPanel, wxString atkFolder, bool oneAttack, bool loadRelease, wxString releaseFolder, bool extractTime, wxString tremFolder, bool loadAsTremOff);
 	wxString GetDefaultOrganDirectory();
 	wxString GetDefaultCmbDirectory();
 	wxLogWindow* GetLogWindow();
+	void ExportTrimmedSamples(const std::vector<std::pair<Rank*, wxString>> &ranks);
 
 	Organ *m_organ;
 
 	bool m_keepMissingFiles;
+	bool m_loadPipesOnDemand;
+	int m_sampleNamingScheme;
+	wxString m_sampleNamePattern;
+	int m_noteNameConvention;
 
 private:
 	DECLARE_EVENT_TABLE()
@@ -162,6 +179,15 @@ private:
 	bool m_frameMaximized;
 	wxString m_defaultOrganDirectory;
 	wxString m_defaultCmbDirectory;
+	OrganLoader *m_organLoader;
+	std::vector<OrganLoader*> m_cancelledOrganLoaders;
+	wxProgressDialog *m_organLoaderDlg;
+	wxTimer m_organLoaderTimer;
+	OdfFileWriter *m_odfWriter;
+	EditJournal *m_editJournal;
+	SampleValidator *m_sampleValidator;
+	wxTimer m_editJournalTimer;
+	wxStopWatch m_editJournalPendingTime;
 
 	void OnOrganTreeSelectionChanged(wxTreeEvent& event);
 	void OnOrganTreeRightClicked(wxTreeEvent& event);
@@ -182,21 +208,46 @@ private:
 	void OnImportCMB(wxCommandEvent& event);
 	void OnEnableTooltipsMenu(wxCommandEvent& event);
 	void OnEnableKeepfilesMenu(wxCommandEvent& event);
+	void OnEnableLoadPipesOnDemandMenu(wxCommandEvent& event);
+	void OnSampleNamingMenu(wxCommandEvent& event);
+	void OnFindDuplicateSamples(wxCommandEvent& event);
+	void OnEstimateMemoryFootprint(wxCommandEvent& event);
+	void OnLoopQualityReport(wxCommandEvent& event);
+	void OnLoudnessReport(wxCommandEvent& event);
+	void OnWriteSampleChunks(wxCommandEvent& event);
+	void OnExportTrimmedSamples(wxCommandEvent& event);
+	void OnValidateSamples(wxCommandEvent& event);
 	void OnRecentFileMenuChoice(wxCommandEvent& event);
 	void OnClearHistory(wxCommandEvent& event);
 	void OnSizeChange(wxSizeEvent& event);
 	void OnDefaultPathMenuChoice(wxCommandEvent& event);
 	void OnImportStopRank(wxCommandEvent& event);
 	void OnImportLegacyXfadesMenu(wxCommandEvent& event);
+	void OnCancelOrganLoading(wxCommandEvent& event);
+	void OnOrganLoaderThread(wxThreadEvent& event);
+	void OnOrganLoaderTimer(wxTimerEvent& event);
+	void OnOdfWriterThread(wxThreadEvent& event);
+	void OnEditJournalTimer(wxTimerEvent& event);
 
 	void SetupOrganMainPanel();
 	void removeAllItemsFromTree();
 	void UpdateFrameSizeAndPos();
 	void RecreateLogWindow();
 	void SetImportXfadeMenuItemState();
+	void SetupOrganContext(Organ *organ, bool attachToUi = true);
+	void ShowEmptyOrgan();
+	void ShowLoadedOrganStructure();
+	void SynchronizePanelsInTree();
+	void FinishOrganLoading();
+	void CancelOrganLoading();
+	void HideOrganLoadingStatus();
 	void FixAnyIllegalEntries();
-	bool IsEncodingOk(wxTextFile *odfFile, wxCSConv conv);
-	bool WriteUTF8(wxTextFile *odfFile);
+	void FinishWritingOdf();
+	void WaitForWritingOdf();
+	void ScheduleEditJournalCheckpoint();
+	wxString GetRecoveryPath();
+	std::vector<std::pair<Rank*, wxString>> GetAllRanks();
+	void RefreshRankAndStopPanels();
 
 };
 
@@ -24,16 +24,79 @@
 #include <wx/wx.h>
 #include <wx/textfile.h>
 #include <wx/filename.h>
+#include <wx/fileconf.h>
+#include <wx/progdlg.h>
 #include <vector>
-#include "GOODF.h"
+#include <charconv>
+#include <functional>
+#include <algorithm>
+#include <memory>
+#include "Organ.h"
+#include "Instrumentation.h"
 
 class Organ;
 
 namespace GOODF_functions {
 
 	inline wxString number_format(int number) {
-		 wxString str = wxString::Format(wxT("%0.3d"), number);
-		 return str;
+		// same output as "%0.3d" (at least three digits) without printf
+		char buf[16];
+		char *pos = buf;
+		unsigned magnitude = number < 0 ? 0u - (unsigned) number : (unsigned) number;
+		if (number < 0)
+			*pos++ = '-';
+		if (magnitude < 100)
+			*pos++ = '0';
+		if (magnitude < 10)
+			*pos++ = '0';
+		pos = std::to_chars(pos, buf + sizeof(buf), magnitude).ptr;
+		return wxString(buf, pos - buf);
+	}
+
+	inline void appendNumber(wxString &str, int value) {
+		char buf[16];
+		char *end = std::to_chars(buf, buf + sizeof(buf), value).ptr;
+		str.append(buf, end - buf);
+	}
+
+	inline void appendNumber(wxString &str, unsigned value) {
+		char buf[16];
+		char *end = std::to_chars(buf, buf + sizeof(buf), value).ptr;
+		str.append(buf, end - buf);
+	}
+
+	inline void appendNumber(wxString &str, float value) {
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L && !defined(__APPLE__)
+		// fixed notation with six decimals is exactly what "%f" produces in the C locale
+		char buf[64];
+		std::to_chars_result res = std::to_chars(buf, buf + sizeof(buf), (double) value, std::chars_format::fixed, 6);
+		if (res.ec == std::errc()) {
+			str.append(buf, res.ptr - buf);
+			return;
+		}
+#endif
+		// older libstdc++ has no floating point to_chars and libc++ only has
+		// it above the macOS versions built for
+		str.append(wxString::Format(wxT("%f"), value));
+	}
+
+	// Adds prefix + key + value as a line, re-using the same line buffer for
+	// every call so that only the copy stored in the file is allocated.
+	template<typename T>
+	inline void addKeyLine(wxTextFile *outFile, const wxString &prefix, const wxChar *key, T value) {
+		static thread_local wxString line;
+		line.assign(prefix);
+		line.append(key);
+		appendNumber(line, value);
+		outFile->AddLine(line);
+	}
+
+	template<typename T>
+	inline void addKeyLine(wxTextFile *outFile, const wxChar *key, T value) {
+		static thread_local wxString line;
+		line.assign(key);
+		appendNumber(line, value);
+		outFile->AddLine(line);
 	}
 
 	inline void writeReferences(wxTextFile *outFile, wxString elementName, std::vector<int> list) {
@@ -66,11 +129,11 @@ namespace GOODF_functions {
 		return pathToCheck;
 	}
 
-	inline wxString removeBaseOdfPath(wxString path) {
+	inline wxString removeBaseOdfPath(wxString path, OrganContext &context) {
 		wxString stringToReturn = path;
 		wxFileName fName = wxFileName(path);
 		if (fName.FileExists()) {
-			fName.MakeRelativeTo(::wxGetApp().m_frame->m_organ->getOdfRoot());
+			fName.MakeRelativeTo(context.getOrgan()->getOdfRoot());
 			stringToReturn = fName.GetFullPath();
 			if (stringToReturn.StartsWith(wxFILE_SEP_PATH))
 				stringToReturn.erase(0, 1);
@@ -81,18 +144,25 @@ namespace GOODF_functions {
 	}
 
 	inline wxString checkIfFileExist(wxString relativePath, Organ *currentOrgan) {
-		bool keepFiles = ::wxGetApp().m_frame->m_keepMissingFiles;
+		bool keepFiles = currentOrgan->getContext()->isKeepingMissingFiles();
 		if (relativePath != wxEmptyString) {
 			if (relativePath.StartsWith(wxT("./")) || relativePath.StartsWith(wxT(".\\")))
 				relativePath.erase(0, 2);
 			wxString fullFilePath = currentOrgan->getOdfRoot() + wxFILE_SEP_PATH + relativePath;
 			wxFileName theFile = wxFileName(fullFilePath, wxPATH_DOS);
-			if (theFile.FileExists()) {
+			// while parsing the answer comes from cached directory listings
+			FileExistenceCache *fileCache = currentOrgan->getFileExistenceCache();
+			if (!fileCache)
+				Instrumentation::count(Instrumentation::FILES_STATTED);
+			if (fileCache ? fileCache->fileExists(theFile) : theFile.FileExists()) {
 				return theFile.GetFullPath();
 			}
 			if (!(relativePath.IsSameAs("DUMMY") || relativePath.StartsWith("REF:"))) {  // warn about removed files
-				wxLogWarning("%s does not exist.%s", relativePath, (keepFiles) ? "" : " Removed from .organ file");
-				::wxGetApp().m_frame->GetLogWindow()->Show(true);
+				if (fileCache) {
+					fileCache->addMissingFile(relativePath);
+				} else {
+					currentOrgan->getContext()->logWarning(wxString::Format("%s does not exist.%s", relativePath, (keepFiles) ? "" : " Removed from .organ file"));
+				}
 			}
 			if (keepFiles) {
 				return relativePath;
@@ -101,6 +171,11 @@ namespace GOODF_functions {
 		return wxEmptyString;
 	}
 
+	// A sample file rather than a reference to another pipe or a dummy
+	inline bool isSampleFilePath(const wxString &fullPath) {
+		return !fullPath.IsEmpty() && !fullPath.StartsWith(wxT("REF:")) && !fullPath.IsSameAs(wxT("DUMMY"), false);
+	}
+
 	inline bool parseBoolean(wxString value, bool defaultValue = true) {
 		if (value.IsSameAs(wxT("Y"), false))
 			return true;
@@ -109,6 +184,43 @@ namespace GOODF_functions {
 		return defaultValue;
 	}
 
+	// Copies a group, and with a prefix also every group whose name starts
+	// with it, into a config held only in memory. What is read from the copy
+	// later can't disturb, or be disturbed by, whoever keeps using cfg.
+	inline std::shared_ptr<wxFileConfig> copyConfigGroups(wxFileConfig *cfg, const wxString &groupName, bool asPrefix = false) {
+		std::shared_ptr<wxFileConfig> copy = std::make_shared<wxFileConfig>(wxEmptyString, wxEmptyString, wxEmptyString, wxEmptyString, wxCONFIG_USE_NO_ESCAPE_CHARACTERS);
+		copy->SetExpandEnvVars(false);
+		wxString oldPath = cfg->GetPath();
+		wxArrayString groups;
+		if (asPrefix) {
+			cfg->SetPath(wxT("/"));
+			wxString group;
+			long groupIndex;
+			bool hasGroup = cfg->GetFirstGroup(group, groupIndex);
+			while (hasGroup) {
+				if (group.StartsWith(groupName))
+					groups.Add(group);
+				hasGroup = cfg->GetNextGroup(group, groupIndex);
+			}
+		} else if (cfg->HasGroup(wxT("/") + groupName)) {
+			groups.Add(groupName);
+		}
+		for (const wxString &group : groups) {
+			cfg->SetPath(wxT("/") + group);
+			copy->SetPath(wxT("/") + group);
+			wxString entry;
+			long entryIndex;
+			bool hasEntry = cfg->GetFirstEntry(entry, entryIndex);
+			while (hasEntry) {
+				copy->Write(entry, cfg->Read(entry, wxEmptyString));
+				hasEntry = cfg->GetNextEntry(entry, entryIndex);
+			}
+		}
+		cfg->SetPath(oldPath);
+		copy->SetPath(wxT("/"));
+		return copy;
+	}
+
 	inline int getGreatestCommonDivisor(int a, int b) {
 		if (a == 0)
 			return b;
@@ -138,6 +250,30 @@ namespace GOODF_functions {
 			}
 		}
 	}
+
+	// Runs a task that reports (done, total) and can be cancelled under a
+	// modal progress dialog. Returns what the task returns.
+	inline bool runWithProgress(
+		wxWindow *parent,
+		const wxString &title,
+		const wxString &message,
+		bool showElapsedTime,
+		const std::function<bool(const std::function<bool(size_t, size_t)>&)> &task
+	) {
+		wxProgressDialog progressDlg(
+			title,
+			message,
+			100,
+			parent,
+			wxPD_APP_MODAL|wxPD_AUTO_HIDE|wxPD_CAN_ABORT|(showElapsedTime ? wxPD_ELAPSED_TIME : 0)
+		);
+		bool completed = task([&progressDlg](size_t done, size_t total) {
+			int percent = total ? (int) (done * 100 / total) : 100;
+			return progressDlg.Update(std::min(percent, 99));
+		});
+		progressDlg.Update(100);
+		return completed;
+	}
 }
 
 #endif
@@ -20,6 +20,7 @@
 
 #include "GUIButton.h"
 #include "GOODFFunctions.h"
+#include "Instrumentation.h"
 #include "GOODF.h"
 #include <algorithm>
 
@@ -96,19 +97,19 @@ void GUIButton::write(wxTextFile *outFile) {
 	if (m_dispDrawstopCol != 1 && (getPosX() == -1) && !m_displayAsPiston)
 		outFile->AddLine(wxT("DispDrawstopCol=") + wxString::Format(wxT("%i"), m_dispDrawstopCol));
 	if (m_imageOn != wxEmptyString) {
-		wxString relativePath = GOODF_functions::removeBaseOdfPath(m_imageOn);
+		wxString relativePath = GOODF_functions::removeBaseOdfPath(m_imageOn, *OrganContext::current());
 		outFile->AddLine(wxT("ImageOn=") + GOODF_functions::fixSeparator(relativePath));
 	}
 	if (m_imageOff != wxEmptyString) {
-		wxString relativePath = GOODF_functions::removeBaseOdfPath(m_imageOff);
+		wxString relativePath = GOODF_functions::removeBaseOdfPath(m_imageOff, *OrganContext::current());
 		outFile->AddLine(wxT("ImageOff=") + GOODF_functions::fixSeparator(relativePath));
 	}
 	if (m_maskOn != wxEmptyString) {
-		wxString relativePath = GOODF_functions::removeBaseOdfPath(m_maskOn);
+		wxString relativePath = GOODF_functions::removeBaseOdfPath(m_maskOn, *OrganContext::current());
 		outFile->AddLine(wxT("MaskOn=") + GOODF_functions::fixSeparator(relativePath));
 	}
 	if (m_maskOff != wxEmptyString) {
-		wxString relativePath = GOODF_functions::removeBaseOdfPath(m_maskOff);
+		wxString relativePath = GOODF_functions::removeBaseOdfPath(m_maskOff, *OrganContext::current());
 		outFile->AddLine(wxT("MaskOff=") + GOODF_functions::fixSeparator(relativePath));
 	}
 	if (m_width != m_bitmapWidth)
@@ -204,6 +205,7 @@ void GUIButton::read(wxFileConfig *cfg, bool isPiston, Organ *readOrgan) {
 	m_imageOn = GOODF_functions::checkIfFileExist(image_on, readOrgan);
 	if (m_imageOn != wxEmptyString) {
 		wxImage img = wxImage(m_imageOn);
+		Instrumentation::count(Instrumentation::BITMAPS_DECODED);
 		if (img.IsOk()) {
 			int width = img.GetWidth();
 			int height = img.GetHeight();
@@ -316,7 +318,7 @@ GUIButton* GUIButton::clone() {
 	return new GUIButton(*this);
 }
 
-void GUIButton::updateDisplayName() {
+void GUIButton::updateDisplayName(OrganContext&) {
 
 }
 
@@ -329,6 +331,7 @@ wxBitmap GUIButton::getBitmap() {
 		}
 	} else {
 		wxImage img(m_imageOff);
+		Instrumentation::count(Instrumentation::BITMAPS_DECODED);
 		if (img.IsOk()) {
 			wxBitmap bmp(m_imageOff, img.GetType());
 			return bmp;
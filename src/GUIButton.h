@@ -38,7 +38,7 @@ public:
 	virtual void read(wxFileConfig *cfg, bool isPiston, Organ *readOrgan);
 
 	virtual GUIButton* clone();
-	virtual void updateDisplayName();
+	virtual void updateDisplayName(OrganContext &context);
 	virtual wxBitmap getBitmap();
 	virtual wxString getElementName();
 	int getDispButtonCol() const;
@@ -758,27 +758,27 @@ void GUIButtonPanel::setButton(GUIButton *button) {
 	m_drawstopRowSpin->SetValue(m_button->getDispDrawstopRow());
 	m_drawstopColSpin->SetValue(m_button->getDispDrawstopCol());
 	if (m_button->getImageOn() != wxEmptyString) {
-		wxString relativeImageOn = GOODF_functions::removeBaseOdfPath(m_button->getImageOn());
+		wxString relativeImageOn = GOODF_functions::removeBaseOdfPath(m_button->getImageOn(), *::wxGetApp().m_frame->m_organ->getContext());
 		m_imageOnPathField->SetValue(relativeImageOn);
 	} else {
 		m_imageOnPathField->SetValue(wxEmptyString);
 		m_addMaskOnBtn->Disable();
 	}
 	if (m_button->getImageOff() != wxEmptyString) {
-		wxString relativeImageOff = GOODF_functions::removeBaseOdfPath(m_button->getImageOff());
+		wxString relativeImageOff = GOODF_functions::removeBaseOdfPath(m_button->getImageOff(), *::wxGetApp().m_frame->m_organ->getContext());
 		m_imageOffPathField->SetValue(relativeImageOff);
 	} else {
 		m_imageOffPathField->SetValue(wxEmptyString);
 		m_addMaskOffBtn->Disable();
 	}
 	if (m_button->getMaskOn() != wxEmptyString) {
-		wxString relativeMaskOn = GOODF_functions::removeBaseOdfPath(m_button->getMaskOn());
+		wxString relativeMaskOn = GOODF_functions::removeBaseOdfPath(m_button->getMaskOn(), *::wxGetApp().m_frame->m_organ->getContext());
 		m_maskOnPathField->SetValue(relativeMaskOn);
 	} else {
 		m_maskOnPathField->SetValue(wxEmptyString);
 	}
 	if (m_button->getMaskOff() != wxEmptyString) {
-		wxString relativeMaskOff = GOODF_functions::removeBaseOdfPath(m_button->getMaskOff());
+		wxString relativeMaskOff = GOODF_functions::removeBaseOdfPath(m_button->getMaskOff(), *::wxGetApp().m_frame->m_organ->getContext());
 		m_maskOffPathField->SetValue(relativeMaskOff);
 	} else {
 		m_maskOffPathField->SetValue(wxEmptyString);
@@ -882,7 +882,7 @@ void GUIButtonPanel::OnLabelTextChange(wxCommandEvent& WXUNUSED(event)) {
 	wxString content = m_labelTextField->GetValue();
 	GOODF_functions::CheckForStartingWhitespace(&content, m_labelTextField);
 	m_button->setDispLabelText(m_labelTextField->GetValue());
-	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
+	::wxGetApp().m_frame->PanelGUIPropertyIsChanged(m_button->getOwningPanel());
 }
 
 void GUIButtonPanel::OnLabelFontChange(wxCommandEvent& WXUNUSED(event)) {
@@ -918,7 +918,7 @@ void GUIButtonPanel::OnLabelFontChange(wxCommandEvent& WXUNUSED(event)) {
 		}
 	}
 
-	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
+	::wxGetApp().m_frame->PanelGUIPropertyIsChanged(m_button->getOwningPanel());
 }
 
 void GUIButtonPanel::OnLabelColourChoice(wxCommandEvent& event) {
@@ -929,7 +929,7 @@ void GUIButtonPanel::OnLabelColourChoice(wxCommandEvent& event) {
 			m_button->getDispLabelColour()->setSelectedColorIndex(m_labelColourChoice->GetSelection());
 			m_labelColourPick->SetColour(m_button->getDispLabelColour()->getColor());
 			m_labelColourPick->Disable();
-			::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
+			::wxGetApp().m_frame->PanelGUIPropertyIsChanged(m_button->getOwningPanel());
 		}
 	}
 }
@@ -937,7 +937,7 @@ void GUIButtonPanel::OnLabelColourChoice(wxCommandEvent& event) {
 void GUIButtonPanel::OnLabelColourPick(wxColourPickerEvent& event) {
 	if (event.GetId() == ID_GUIBUTTONPANEL_COLOR_PICKER) {
 		m_button->getDispLabelColour()->setColorValue(m_labelColourPick->GetColour());
-		::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
+		::wxGetApp().m_frame->PanelGUIPropertyIsChanged(m_button->getOwningPanel());
 	}
 }
 
@@ -968,7 +968,7 @@ void GUIButtonPanel::OnDisplayAsPistonRadio(wxCommandEvent& event) {
 		UpdateSpinRanges();
 		UpdateDefaultSpinValues();
 	}
-	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
+	::wxGetApp().m_frame->PanelGUIPropertyIsChanged(m_button->getOwningPanel());
 }
 
 void GUIButtonPanel::OnDisplayKeyLabelLeftRadio(wxCommandEvent& event) {
@@ -979,23 +979,23 @@ void GUIButtonPanel::OnDisplayKeyLabelLeftRadio(wxCommandEvent& event) {
 		m_displayKeyLabelLeftNo->SetValue(true);
 		m_button->setDispKeyLabelOnLeft(false);
 	}
-	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
+	::wxGetApp().m_frame->PanelGUIPropertyIsChanged(m_button->getOwningPanel());
 }
 
 void GUIButtonPanel::OnImageNumberChoice(wxCommandEvent& WXUNUSED(event)) {
 	m_button->setDispImageNum(m_dispImageNbrBox->GetSelection() + 1);
-	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
+	::wxGetApp().m_frame->PanelGUIPropertyIsChanged(m_button->getOwningPanel());
 }
 
 void GUIButtonPanel::OnButtonRowSpin(wxSpinEvent& WXUNUSED(event)) {
 	int rowValue = m_buttonRowSpin->GetValue();
 	m_button->setDispButtonRow(rowValue);
-	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
+	::wxGetApp().m_frame->PanelGUIPropertyIsChanged(m_button->getOwningPanel());
 }
 
 void GUIButtonPanel::OnButtonColSpin(wxSpinEvent& WXUNUSED(event)) {
 	m_button->setDispButtonCol(m_buttonColSpin->GetValue());
-	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
+	::wxGetApp().m_frame->PanelGUIPropertyIsChanged(m_button->getOwningPanel());
 }
 
 void GUIButtonPanel::OnDrawstopRowSpin(wxSpinEvent& WXUNUSED(event)) {
@@ -1007,12 +1007,12 @@ void GUIButtonPanel::OnDrawstopRowSpin(wxSpinEvent& WXUNUSED(event)) {
 	} else {
 		m_drawstopColSpin->SetRange(1, m_button->getOwningPanel()->getDisplayMetrics()->m_dispExtraDrawstopCols);
 	}
-	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
+	::wxGetApp().m_frame->PanelGUIPropertyIsChanged(m_button->getOwningPanel());
 }
 
 void GUIButtonPanel::OnDrawstopColSpin(wxSpinEvent& WXUNUSED(event)) {
 	m_button->setDispDrawstopCol(m_drawstopColSpin->GetValue());
-	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
+	::wxGetApp().m_frame->PanelGUIPropertyIsChanged(m_button->getOwningPanel());
 }
 
 void GUIButtonPanel::OnAddImageOnBtn(wxCommandEvent& WXUNUSED(event)) {
@@ -1036,7 +1036,7 @@ void GUIButtonPanel::OnAddImageOnBtn(wxCommandEvent& WXUNUSED(event)) {
 				m_button->setTextBreakWidth(m_button->getTextRectWidth() - (m_button->getTextRectWidth() < 50 ? 4 : 14));
 				UpdateSpinRanges();
 				UpdateDefaultSpinValues();
-				wxString relativePath = GOODF_functions::removeBaseOdfPath(m_button->getImageOn());
+				wxString relativePath = GOODF_functions::removeBaseOdfPath(m_button->getImageOn(), *::wxGetApp().m_frame->m_organ->getContext());
 				m_imageOnPathField->SetValue(relativePath);
 				m_addMaskOnBtn->Enable();
 			} else {
@@ -1072,7 +1072,7 @@ void GUIButtonPanel::OnAddImageOnBtn(wxCommandEvent& WXUNUSED(event)) {
 			}
 		}
 	}
-	::wxGetApp().m_frame->m_organ->setModified(true);
+	::wxGetApp().m_frame->m_organ->setSectionModified(m_button->getOwningPanel());
 }
 
 void GUIButtonPanel::OnAddImageOffBtn(wxCommandEvent& WXUNUSED(event)) {
@@ -1084,10 +1084,10 @@ void GUIButtonPanel::OnAddImageOffBtn(wxCommandEvent& WXUNUSED(event)) {
 			int height = img.GetHeight();
 			if (width == m_button->getBitmapWidth() && height == m_button->getBitmapHeight()) {
 				m_button->setImageOff(path);
-				wxString relativePath = GOODF_functions::removeBaseOdfPath(m_button->getImageOff());
+				wxString relativePath = GOODF_functions::removeBaseOdfPath(m_button->getImageOff(), *::wxGetApp().m_frame->m_organ->getContext());
 				m_imageOffPathField->SetValue(relativePath);
 				m_addMaskOffBtn->Enable();
-				::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
+				::wxGetApp().m_frame->PanelGUIPropertyIsChanged(m_button->getOwningPanel());
 			} else {
 				wxMessageDialog msg(this, wxT("Image off bitmap size must match on bitmap!"), wxT("Wrong bitmap size"), wxOK|wxCENTRE|wxICON_ERROR);
 				msg.ShowModal();
@@ -1104,7 +1104,7 @@ void GUIButtonPanel::OnAddImageOffBtn(wxCommandEvent& WXUNUSED(event)) {
 				m_imageOffPathField->SetValue(wxEmptyString);
 				m_maskOffPathField->SetValue(wxEmptyString);
 				m_addMaskOffBtn->Disable();
-				::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
+				::wxGetApp().m_frame->PanelGUIPropertyIsChanged(m_button->getOwningPanel());
 			}
 		}
 	}
@@ -1119,7 +1119,7 @@ void GUIButtonPanel::OnAddMaskOnBtn(wxCommandEvent& WXUNUSED(event)) {
 			int height = img.GetHeight();
 			if (width == m_button->getBitmapWidth() && height == m_button->getBitmapHeight()) {
 				m_button->setMaskOn(path);
-				wxString relativePath = GOODF_functions::removeBaseOdfPath(m_button->getMaskOn());
+				wxString relativePath = GOODF_functions::removeBaseOdfPath(m_button->getMaskOn(), *::wxGetApp().m_frame->m_organ->getContext());
 				m_maskOnPathField->SetValue(relativePath);
 			}
 		}
@@ -1134,7 +1134,7 @@ void GUIButtonPanel::OnAddMaskOnBtn(wxCommandEvent& WXUNUSED(event)) {
 			}
 		}
 	}
-	::wxGetApp().m_frame->m_organ->setModified(true);
+	::wxGetApp().m_frame->m_organ->setSectionModified(m_button->getOwningPanel());
 }
 
 void GUIButtonPanel::OnAddMaskOffBtn(wxCommandEvent& WXUNUSED(event)) {
@@ -1146,7 +1146,7 @@ void GUIButtonPanel::OnAddMaskOffBtn(wxCommandEvent& WXUNUSED(event)) {
 			int height = img.GetHeight();
 			if (width == m_button->getBitmapWidth() && height == m_button->getBitmapHeight()) {
 				m_button->setMaskOff(path);
-				wxString relativePath = GOODF_functions::removeBaseOdfPath(m_button->getMaskOff());
+				wxString relativePath = GOODF_functions::removeBaseOdfPath(m_button->getMaskOff(), *::wxGetApp().m_frame->m_organ->getContext());
 				m_maskOffPathField->SetValue(relativePath);
 			}
 		}
@@ -1161,91 +1161,91 @@ void GUIButtonPanel::OnAddMaskOffBtn(wxCommandEvent& WXUNUSED(event)) {
 			}
 		}
 	}
-	::wxGetApp().m_frame->m_organ->setModified(true);
+	::wxGetApp().m_frame->m_organ->setSectionModified(m_button->getOwningPanel());
 }
 
 void GUIButtonPanel::OnWidthSpin(wxSpinEvent& WXUNUSED(event)) {
 	m_button->setWidth(m_widthSpin->GetValue());
 	UpdateSpinRanges();
 	UpdateDefaultSpinValues();
-	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
+	::wxGetApp().m_frame->PanelGUIPropertyIsChanged(m_button->getOwningPanel());
 }
 
 void GUIButtonPanel::OnHeightSpin(wxSpinEvent& WXUNUSED(event)) {
 	m_button->setHeight(m_heightSpin->GetValue());
 	UpdateSpinRanges();
 	UpdateDefaultSpinValues();
-	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
+	::wxGetApp().m_frame->PanelGUIPropertyIsChanged(m_button->getOwningPanel());
 }
 
 void GUIButtonPanel::OnTileOffsetXSpin(wxSpinEvent& WXUNUSED(event)) {
 	m_button->setTileOffsetX(m_tileOffsetXSpin->GetValue());
-	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
+	::wxGetApp().m_frame->PanelGUIPropertyIsChanged(m_button->getOwningPanel());
 }
 
 void GUIButtonPanel::OnTileOffsetYSpin(wxSpinEvent& WXUNUSED(event)) {
 	m_button->setTileOffsetY(m_tileOffsetYSpin->GetValue());
-	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
+	::wxGetApp().m_frame->PanelGUIPropertyIsChanged(m_button->getOwningPanel());
 }
 
 void GUIButtonPanel::OnMouseRectLeftSpin(wxSpinEvent& WXUNUSED(event)) {
 	m_button->setMouseRectLeft(m_mouseRectLeftSpin->GetValue());
 	UpdateSpinRanges();
 	UpdateDefaultSpinValues();
-	::wxGetApp().m_frame->m_organ->setModified(true);
+	::wxGetApp().m_frame->m_organ->setSectionModified(m_button->getOwningPanel());
 }
 
 void GUIButtonPanel::OnMouseRectTopSpin(wxSpinEvent& WXUNUSED(event)) {
 	m_button->setMouseRectTop(m_mouseRectTopSpin->GetValue());
 	UpdateSpinRanges();
 	UpdateDefaultSpinValues();
-	::wxGetApp().m_frame->m_organ->setModified(true);
+	::wxGetApp().m_frame->m_organ->setSectionModified(m_button->getOwningPanel());
 }
 
 void GUIButtonPanel::OnMouseRectWidthSpin(wxSpinEvent& WXUNUSED(event)) {
 	m_button->setMouseRectWidth(m_mouseRectWidthSpin->GetValue());
-	::wxGetApp().m_frame->m_organ->setModified(true);
+	::wxGetApp().m_frame->m_organ->setSectionModified(m_button->getOwningPanel());
 }
 
 void GUIButtonPanel::OnMouseRectHeightSpin(wxSpinEvent& WXUNUSED(event)) {
 	m_button->setMouseRectHeight(m_mouseRectHeightSpin->GetValue());
-	::wxGetApp().m_frame->m_organ->setModified(true);
+	::wxGetApp().m_frame->m_organ->setSectionModified(m_button->getOwningPanel());
 }
 
 void GUIButtonPanel::OnMouseRadiusSpin(wxSpinEvent& WXUNUSED(event)) {
 	m_button->setMouseRadius(m_mouseRadiusSpin->GetValue());
-	::wxGetApp().m_frame->m_organ->setModified(true);
+	::wxGetApp().m_frame->m_organ->setSectionModified(m_button->getOwningPanel());
 }
 
 void GUIButtonPanel::OnTextRectLeftSpin(wxSpinEvent& WXUNUSED(event)) {
 	m_button->setTextRectLeft(m_textRectLeftSpin->GetValue());
 	UpdateSpinRanges();
 	UpdateDefaultSpinValues();
-	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
+	::wxGetApp().m_frame->PanelGUIPropertyIsChanged(m_button->getOwningPanel());
 }
 
 void GUIButtonPanel::OnTextRectTopSpin(wxSpinEvent& WXUNUSED(event)) {
 	m_button->setTextRectTop(m_textRectTopSpin->GetValue());
 	UpdateSpinRanges();
 	UpdateDefaultSpinValues();
-	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
+	::wxGetApp().m_frame->PanelGUIPropertyIsChanged(m_button->getOwningPanel());
 }
 
 void GUIButtonPanel::OnTextRectWidthSpin(wxSpinEvent& WXUNUSED(event)) {
 	m_button->setTextRectWidth(m_textRectWidthSpin->GetValue());
 	UpdateSpinRanges();
 	UpdateDefaultSpinValues();
-	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
+	::wxGetApp().m_frame->PanelGUIPropertyIsChanged(m_button->getOwningPanel());
 }
 
 void GUIButtonPanel::OnTextRectHeightSpin(wxSpinEvent& WXUNUSED(event)) {
 	m_button->setTextRectHeight(m_textRectHeightSpin->GetValue());
-	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
+	::wxGetApp().m_frame->PanelGUIPropertyIsChanged(m_button->getOwningPanel());
 }
 
 void GUIButtonPanel::OnTextBreakWidthSpin(wxSpinEvent& WXUNUSED(event)) {
 	m_button->setTextBreakWidth(m_textBreakWidthSpin->GetValue());
-	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
+	::wxGetApp().m_frame->PanelGUIPropertyIsChanged(m_button->getOwningPanel());
 }
 
 void GUIButtonPanel::OnPositionXSpin(wxSpinEvent& WXUNUSED(event)) {
@@ -1279,7 +1279,7 @@ void GUIButtonPanel::OnPositionXSpin(wxSpinEvent& WXUNUSED(event)) {
 			m_drawstopColSpin->Enable();
 		}
 	}
-	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
+	::wxGetApp().m_frame->PanelGUIPropertyIsChanged(m_button->getOwningPanel());
 }
 
 void GUIButtonPanel::OnPositionYSpin(wxSpinEvent& WXUNUSED(event)) {
@@ -1313,7 +1313,7 @@ void GUIButtonPanel::OnPositionYSpin(wxSpinEvent& WXUNUSED(event)) {
 			m_drawstopColSpin->Enable();
 		}
 	}
-	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
+	::wxGetApp().m_frame->PanelGUIPropertyIsChanged(m_button->getOwningPanel());
 }
 
 void GUIButtonPanel::OnRemoveButtonBtn(wxCommandEvent& WXUNUSED(event)) {
@@ -32,7 +32,7 @@ GUICoupler::~GUICoupler() {
 
 void GUICoupler::write(wxTextFile *outFile) {
 	GUIElement::write(outFile);
-	unsigned manualNbr = ::wxGetApp().m_frame->m_organ->getIndexOfOrganManual(m_coupler->getOwningManual());
+	unsigned manualNbr = OrganContext::current()->getOrgan()->getIndexOfOrganManual(m_coupler->getOwningManual());
 	wxString manId = wxT("Manual=") + GOODF_functions::number_format(manualNbr);
 	outFile->AddLine(manId);
 	int couplerNbr = m_coupler->getOwningManual()->getIndexOfCoupler(m_coupler) + 1;
@@ -53,7 +53,7 @@ bool GUICoupler::isReferencing(Coupler *cplr) {
 	return m_coupler == cplr ? true : false;
 }
 
-void GUICoupler::updateDisplayName() {
+void GUICoupler::updateDisplayName(OrganContext&) {
 	setDisplayName(m_coupler->getName() + wxT(" (Coupler in ") + m_coupler->getOwningManual()->getName() + wxT(")"));
 }
 
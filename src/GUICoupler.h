@@ -34,7 +34,7 @@ public:
 	void write(wxTextFile *outFile);
 	virtual GUICoupler* clone();
 	bool isReferencing(Coupler *cplr);
-	void updateDisplayName();
+	void updateDisplayName(OrganContext &context);
 	wxString getElementName();
 
 private:
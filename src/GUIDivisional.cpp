@@ -34,7 +34,7 @@ GUIDivisional::~GUIDivisional() {
 void GUIDivisional::write(wxTextFile *outFile) {
 	GUIElement::write(outFile);
 	if (m_divisional) {
-		unsigned manualNbr = ::wxGetApp().m_frame->m_organ->getIndexOfOrganManual(m_divisional->getOwningManual());
+		unsigned manualNbr = OrganContext::current()->getOrgan()->getIndexOfOrganManual(m_divisional->getOwningManual());
 		wxString manId = wxT("Manual=") + GOODF_functions::number_format(manualNbr);
 		outFile->AddLine(manId);
 		int divisionalNbr = m_divisional->getOwningManual()->getIndexOfDivisional(m_divisional) + 1;
@@ -56,7 +56,7 @@ bool GUIDivisional::isReferencing(Divisional *divisional) {
 	return m_divisional == divisional ? true : false;
 }
 
-void GUIDivisional::updateDisplayName() {
+void GUIDivisional::updateDisplayName(OrganContext&) {
 	if (m_divisional)
 		setDisplayName(m_divisional->getName() + wxT(" (Divisional in ") + m_divisional->getOwningManual()->getName() + wxT(")"));
 }
@@ -34,7 +34,7 @@ public:
 	void write(wxTextFile *outFile);
 	virtual GUIDivisional* clone();
 	bool isReferencing(Divisional *divisional);
-	void updateDisplayName();
+	void updateDisplayName(OrganContext &context);
 	wxString getElementName();
 
 private:
@@ -32,7 +32,7 @@ GUIDivisionalCoupler::~GUIDivisionalCoupler() {
 
 void GUIDivisionalCoupler::write(wxTextFile *outFile) {
 	GUIElement::write(outFile);
-	int divCplrNbr = ::wxGetApp().m_frame->m_organ->getIndexOfOrganDivisionalCoupler(m_divCoupler);
+	int divCplrNbr = OrganContext::current()->getOrgan()->getIndexOfOrganDivisionalCoupler(m_divCoupler);
 	wxString divId = wxT("DivisionalCoupler=") + GOODF_functions::number_format(divCplrNbr);
 	outFile->AddLine(divId);
 	if (m_positionX != -1)
@@ -50,7 +50,7 @@ bool GUIDivisionalCoupler::isReferencing(DivisionalCoupler *divCplr) {
 	return m_divCoupler == divCplr ? true : false;
 }
 
-void GUIDivisionalCoupler::updateDisplayName() {
+void GUIDivisionalCoupler::updateDisplayName(OrganContext&) {
 	setDisplayName(m_divCoupler->getName() + wxT(" (Divisional coupler)"));
 }
 
@@ -34,7 +34,7 @@ public:
 	void write(wxTextFile *outFile);
 	virtual GUIDivisionalCoupler* clone();
 	bool isReferencing(DivisionalCoupler *divisional);
-	void updateDisplayName();
+	void updateDisplayName(OrganContext &context);
 	wxString getElementName();
 
 private:
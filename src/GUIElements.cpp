@@ -44,7 +44,7 @@ GUIElement* GUIElement::clone() {
 	return nullptr;
 }
 
-void GUIElement::updateDisplayName() {
+void GUIElement::updateDisplayName(OrganContext&) {
 
 }
 
@@ -30,6 +30,7 @@
 #include "Manual.h"
 
 class GoPanel;
+class OrganContext;
 
 class GUIElement {
 public:
@@ -40,7 +41,7 @@ public:
 	virtual void read(wxFileConfig *cfg);
 
 	virtual GUIElement* clone();
-	virtual void updateDisplayName();
+	virtual void updateDisplayName(OrganContext &context);
 	virtual void setDefaultFont(wxFont&);
 	virtual wxBitmap getBitmap();
 	virtual wxString getElementName();
@@ -20,6 +20,7 @@
 
 #include "GUIEnclosure.h"
 #include "GOODFFunctions.h"
+#include "Instrumentation.h"
 #include "GOODF.h"
 
 GUIEnclosure::GUIEnclosure(Enclosure *enclosure) : GUIElement(), m_enclosure(enclosure) {
@@ -59,7 +60,7 @@ GUIEnclosure::~GUIEnclosure() {
 void GUIEnclosure::write(wxTextFile *outFile) {
 	GUIElement::write(outFile);
 	if (m_enclosure != NULL) {
-		wxString encId = wxT("Enclosure=") + GOODF_functions::number_format(::wxGetApp().m_frame->m_organ->getIndexOfOrganEnclosure(m_enclosure));
+		wxString encId = wxT("Enclosure=") + GOODF_functions::number_format(OrganContext::current()->getOrgan()->getIndexOfOrganEnclosure(m_enclosure));
 		outFile->AddLine(encId);
 	}
 	if (m_positionX != -1)
@@ -92,10 +93,10 @@ void GUIEnclosure::write(wxTextFile *outFile) {
 		unsigned counter = 1;
 		for (GoImage& bitmap : m_bitmaps) {
 			wxString bitmapId = wxT("Bitmap") + GOODF_functions::number_format(counter) + wxT("=");
-			outFile->AddLine(bitmapId + GOODF_functions::fixSeparator(bitmap.getRelativeImagePath()));
+			outFile->AddLine(bitmapId + GOODF_functions::fixSeparator(bitmap.getRelativeImagePath(*OrganContext::current())));
 			if (bitmap.getMask() != wxEmptyString) {
 				wxString maskId = wxT("Mask") + GOODF_functions::number_format(counter) + wxT("=");
-				outFile->AddLine(maskId + GOODF_functions::fixSeparator(bitmap.getRelativeMaskPath()));
+				outFile->AddLine(maskId + GOODF_functions::fixSeparator(bitmap.getRelativeMaskPath(*OrganContext::current())));
 			}
 			counter++;
 		}
@@ -180,10 +181,12 @@ void GUIEnclosure::read(wxFileConfig *cfg, Organ *readOrgan) {
 			wxString fullMaskPath = GOODF_functions::checkIfFileExist(relMaskPath, readOrgan);
 			if (fullBmpPath != wxEmptyString) {
 				wxImage img = wxImage(fullBmpPath);
+				Instrumentation::count(Instrumentation::BITMAPS_DECODED);
 				if (img.IsOk()) {
 					tmpBmp.setImage(fullBmpPath);
 					if (fullMaskPath != wxEmptyString) {
 						wxImage mask = wxImage(fullMaskPath);
+						Instrumentation::count(Instrumentation::BITMAPS_DECODED);
 						if (mask.IsOk()) {
 							tmpBmp.setMask(fullMaskPath);
 						}
@@ -304,7 +307,7 @@ bool GUIEnclosure::isReferencing(Enclosure *enclosure) {
 	return m_enclosure == enclosure ? true : false;
 }
 
-void GUIEnclosure::updateDisplayName() {
+void GUIEnclosure::updateDisplayName(OrganContext&) {
 	if (m_enclosure)
 		setDisplayName(m_enclosure->getName() + wxT(" (Enclosure)"));
 }
@@ -42,7 +42,7 @@ public:
 
 	virtual GUIEnclosure* clone();
 	bool isReferencing(Enclosure *enclosure);
-	void updateDisplayName();
+	void updateDisplayName(OrganContext &context);
 	virtual wxBitmap getBitmap();
 	virtual wxString getElementName();
 
@@ -625,8 +625,8 @@ void GUIEnclosurePanel::GUIEnclosurePanel::setEnclosure(GUIEnclosure *enclosure)
 		m_removeBitmapBtn->Enable();
 		m_enclosure->setEnclosureStyle(1);
 		m_enclosureStyleBox->SetSelection(0);
-		m_imagePathField->SetValue(m_enclosure->getBitmapAtIndex(0)->getRelativeImagePath());
-		m_maskPathField->SetValue(m_enclosure->getBitmapAtIndex(0)->getRelativeMaskPath());
+		m_imagePathField->SetValue(m_enclosure->getBitmapAtIndex(0)->getRelativeImagePath(*::wxGetApp().m_frame->m_organ->getContext()));
+		m_maskPathField->SetValue(m_enclosure->getBitmapAtIndex(0)->getRelativeMaskPath(*::wxGetApp().m_frame->m_organ->getContext()));
 	} else {
 		// no bitmaps existing so enclosure style is enabled and remove bitmap button disabled
 		if (!m_bitmapBox->IsEmpty()) {
@@ -721,13 +721,13 @@ void GUIEnclosurePanel::OnLabelTextChange(wxCommandEvent& WXUNUSED(event)) {
 	wxString content = m_labelTextField->GetValue();
 	GOODF_functions::CheckForStartingWhitespace(&content, m_labelTextField);
 	m_enclosure->setDispLabelText(m_labelTextField->GetValue());
-	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
+	::wxGetApp().m_frame->PanelGUIPropertyIsChanged(m_enclosure->getOwningPanel());
 }
 
 void GUIEnclosurePanel::OnLabelFontChange(wxFontPickerEvent& WXUNUSED(event)) {
 	m_enclosure->setDispLabelFont(m_labelFont->GetSelectedFont());
 	m_enclosure->setDispLabelFontSize(m_labelFont->GetSelectedFont().GetPointSize());
-	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
+	::wxGetApp().m_frame->PanelGUIPropertyIsChanged(m_enclosure->getOwningPanel());
 }
 
 void GUIEnclosurePanel::OnLabelColourChoice(wxCommandEvent& event) {
@@ -738,7 +738,7 @@ void GUIEnclosurePanel::OnLabelColourChoice(wxCommandEvent& event) {
 			m_enclosure->getDispLabelColour()->setSelectedColorIndex(m_labelColourChoice->GetSelection());
 			m_labelColourPick->SetColour(m_enclosure->getDispLabelColour()->getColor());
 			m_labelColourPick->Disable();
-			::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
+			::wxGetApp().m_frame->PanelGUIPropertyIsChanged(m_enclosure->getOwningPanel());
 		}
 	}
 }
@@ -746,7 +746,7 @@ void GUIEnclosurePanel::OnLabelColourChoice(wxCommandEvent& event) {
 void GUIEnclosurePanel::OnLabelColourPick(wxColourPickerEvent& event) {
 	if (event.GetId() == ID_GUIENCLOSUREPANEL_COLOR_PICKER) {
 		m_enclosure->getDispLabelColour()->setColorValue(m_labelColourPick->GetColour());
-		::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
+		::wxGetApp().m_frame->PanelGUIPropertyIsChanged(m_enclosure->getOwningPanel());
 	}
 }
 
@@ -754,30 +754,30 @@ void GUIEnclosurePanel::OnPositionXSpin(wxSpinEvent& WXUNUSED(event)) {
 	// a value of -1 indicate that default display metric positioning is used
 	int value = m_elementPosXSpin->GetValue();
 	m_enclosure->setPosX(value);
-	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
+	::wxGetApp().m_frame->PanelGUIPropertyIsChanged(m_enclosure->getOwningPanel());
 }
 
 void GUIEnclosurePanel::OnPositionYSpin(wxSpinEvent& WXUNUSED(event)) {
 	// a value of -1 indicate that default display metric positioning is used
 	int value = m_elementPosYSpin->GetValue();
 	m_enclosure->setPosY(value);
-	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
+	::wxGetApp().m_frame->PanelGUIPropertyIsChanged(m_enclosure->getOwningPanel());
 }
 
 void GUIEnclosurePanel::OnEnclosureStyleChoice(wxCommandEvent& WXUNUSED(event)) {
 	m_enclosure->setEnclosureStyle(m_enclosureStyleBox->GetSelection() + 1);
-	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
+	::wxGetApp().m_frame->PanelGUIPropertyIsChanged(m_enclosure->getOwningPanel());
 }
 
 void GUIEnclosurePanel::OnBitmapChoice(wxCommandEvent& WXUNUSED(event)) {
 	// when a bitmap is selected the image and mask fields should fill and the remove bitmap button be enabled
 	int selectedIndex = m_bitmapBox->GetSelection();
 	if (m_enclosure->getBitmapAtIndex(selectedIndex)->getImage() != wxEmptyString)
-		m_imagePathField->SetValue(m_enclosure->getBitmapAtIndex(selectedIndex)->getRelativeImagePath());
+		m_imagePathField->SetValue(m_enclosure->getBitmapAtIndex(selectedIndex)->getRelativeImagePath(*::wxGetApp().m_frame->m_organ->getContext()));
 	else
 		m_imagePathField->SetValue(wxEmptyString);
 	if (m_enclosure->getBitmapAtIndex(selectedIndex)->getMask() != wxEmptyString)
-		m_maskPathField->SetValue(m_enclosure->getBitmapAtIndex(selectedIndex)->getRelativeMaskPath());
+		m_maskPathField->SetValue(m_enclosure->getBitmapAtIndex(selectedIndex)->getRelativeMaskPath(*::wxGetApp().m_frame->m_organ->getContext()));
 	else
 		m_maskPathField->SetValue(wxEmptyString);
 	m_addImagePathBtn->Enable();
@@ -795,7 +795,7 @@ void GUIEnclosurePanel::OnAddBitmapBtn(wxCommandEvent& WXUNUSED(event)) {
 	// we need to notify the bitmapBox that selection has changed
 	wxCommandEvent evt(wxEVT_LISTBOX, ID_GUIENCLOSUREPANEL_BITMAP_BOX);
 	wxPostEvent(this, evt);
-	::wxGetApp().m_frame->m_organ->setModified(true);
+	::wxGetApp().m_frame->m_organ->setSectionModified(m_enclosure->getOwningPanel());
 }
 
 void GUIEnclosurePanel::OnAddImagePathBtn(wxCommandEvent& WXUNUSED(event)) {
@@ -820,11 +820,11 @@ void GUIEnclosurePanel::OnAddImagePathBtn(wxCommandEvent& WXUNUSED(event)) {
 				m_enclosure->setTextBreakWidth(m_enclosure->getTextRectWidth());
 				UpdateSpinRanges();
 				UpdateDefaultSpinValues();
-				m_imagePathField->SetValue(m_enclosure->getBitmapAtIndex(m_bitmapBox->GetSelection())->getRelativeImagePath());
-				::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
+				m_imagePathField->SetValue(m_enclosure->getBitmapAtIndex(m_bitmapBox->GetSelection())->getRelativeImagePath(*::wxGetApp().m_frame->m_organ->getContext()));
+				::wxGetApp().m_frame->PanelGUIPropertyIsChanged(m_enclosure->getOwningPanel());
 			} else {
 				if (width == m_enclosure->getBitmapWidth() && height == m_enclosure->getBitmapHeight()) {
-					m_imagePathField->SetValue(m_enclosure->getBitmapAtIndex(m_bitmapBox->GetSelection())->getRelativeImagePath());
+					m_imagePathField->SetValue(m_enclosure->getBitmapAtIndex(m_bitmapBox->GetSelection())->getRelativeImagePath(*::wxGetApp().m_frame->m_organ->getContext()));
 				} else {
 					wxMessageDialog msg(this, wxT("Current bitmap size doesn't match the first bitmap! Please review/set first bitmap size correctly."), wxT("All bitmaps must be of same size!"), wxOK|wxCENTRE|wxICON_EXCLAMATION);
 					msg.ShowModal();
@@ -853,7 +853,7 @@ void GUIEnclosurePanel::OnAddMaskPathBtn(wxCommandEvent& WXUNUSED(event)) {
 			if (width == m_enclosure->getBitmapWidth() && height == m_enclosure->getBitmapHeight()) {
 				m_enclosure->getBitmapAtIndex(m_bitmapBox->GetSelection())->setMask(path);
 				m_maskPathField->SetValue(m_enclosure->getBitmapAtIndex(m_bitmapBox->GetSelection())->getMaskNameOnly());
-				::wxGetApp().m_frame->m_organ->setModified(true);
+				::wxGetApp().m_frame->m_organ->setSectionModified(m_enclosure->getOwningPanel());
 			}
 		}
 	} else {
@@ -864,7 +864,7 @@ void GUIEnclosurePanel::OnAddMaskPathBtn(wxCommandEvent& WXUNUSED(event)) {
 				// then we empty the value in button and panel
 				m_enclosure->getBitmapAtIndex(m_bitmapBox->GetSelection())->setMask(wxEmptyString);
 				m_maskPathField->SetValue(wxEmptyString);
-				::wxGetApp().m_frame->m_organ->setModified(true);
+				::wxGetApp().m_frame->m_organ->setSectionModified(m_enclosure->getOwningPanel());
 			}
 		}
 	}
@@ -888,7 +888,7 @@ void GUIEnclosurePanel::OnRemoveBitmapBtn(wxCommandEvent& WXUNUSED(event)) {
 			// then we notify the box that selection has changed
 			wxCommandEvent evt(wxEVT_LISTBOX, ID_GUIENCLOSUREPANEL_BITMAP_BOX);
 			wxPostEvent(this, evt);
-			::wxGetApp().m_frame->m_organ->setModified(true);
+			::wxGetApp().m_frame->m_organ->setSectionModified(m_enclosure->getOwningPanel());
 		} else {
 			m_removeBitmapBtn->Disable();
 			m_addImagePathBtn->Disable();
@@ -896,7 +896,7 @@ void GUIEnclosurePanel::OnRemoveBitmapBtn(wxCommandEvent& WXUNUSED(event)) {
 			UpdateBuiltinBitmapValues();
 			UpdateSpinRanges();
 			UpdateDefaultSpinValues();
-			::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
+			::wxGetApp().m_frame->PanelGUIPropertyIsChanged(m_enclosure->getOwningPanel());
 		}
 	}
 }
@@ -950,7 +950,7 @@ void GUIEnclosurePanel::OnAddImageBitmapsBtn(wxCommandEvent& WXUNUSED(event)) {
 			// we need to notify the bitmapBox that selection has changed
 			wxCommandEvent evt(wxEVT_LISTBOX, ID_GUIENCLOSUREPANEL_BITMAP_BOX);
 			wxPostEvent(this, evt);
-			::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
+			::wxGetApp().m_frame->PanelGUIPropertyIsChanged(m_enclosure->getOwningPanel());
 		}
 	}
 }
@@ -958,87 +958,87 @@ void GUIEnclosurePanel::OnAddImageBitmapsBtn(wxCommandEvent& WXUNUSED(event)) {
 void GUIEnclosurePanel::OnWidthSpin(wxSpinEvent& WXUNUSED(event)) {
 	m_enclosure->setWidth(m_widthSpin->GetValue());
 	UpdateSpinRanges();
-	::wxGetApp().m_frame->m_organ->setModified(true);
+	::wxGetApp().m_frame->m_organ->setSectionModified(m_enclosure->getOwningPanel());
 }
 
 void GUIEnclosurePanel::OnHeightSpin(wxSpinEvent& WXUNUSED(event)) {
 	m_enclosure->setHeight(m_heightSpin->GetValue());
 	UpdateSpinRanges();
-	::wxGetApp().m_frame->m_organ->setModified(true);
+	::wxGetApp().m_frame->m_organ->setSectionModified(m_enclosure->getOwningPanel());
 }
 
 void GUIEnclosurePanel::OnTileOffsetXSpin(wxSpinEvent& WXUNUSED(event)) {
 	m_enclosure->setTileOffsetX(m_tileOffsetXSpin->GetValue());
-	::wxGetApp().m_frame->m_organ->setModified(true);
+	::wxGetApp().m_frame->m_organ->setSectionModified(m_enclosure->getOwningPanel());
 }
 
 void GUIEnclosurePanel::OnTileOffsetYSpin(wxSpinEvent& WXUNUSED(event)) {
 	m_enclosure->setTileOffsetY(m_tileOffsetYSpin->GetValue());
-	::wxGetApp().m_frame->m_organ->setModified(true);
+	::wxGetApp().m_frame->m_organ->setSectionModified(m_enclosure->getOwningPanel());
 }
 
 void GUIEnclosurePanel::OnMouseRectLeftSpin(wxSpinEvent& WXUNUSED(event)) {
 	m_enclosure->setMouseRectLeft(m_mouseRectLeftSpin->GetValue());
 	UpdateSpinRanges();
-	::wxGetApp().m_frame->m_organ->setModified(true);
+	::wxGetApp().m_frame->m_organ->setSectionModified(m_enclosure->getOwningPanel());
 }
 
 void GUIEnclosurePanel::OnMouseRectTopSpin(wxSpinEvent& WXUNUSED(event)) {
 	m_enclosure->setMouseRectTop(m_mouseRectTopSpin->GetValue());
 	UpdateSpinRanges();
-	::wxGetApp().m_frame->m_organ->setModified(true);
+	::wxGetApp().m_frame->m_organ->setSectionModified(m_enclosure->getOwningPanel());
 }
 
 void GUIEnclosurePanel::OnMouseRectWidthSpin(wxSpinEvent& WXUNUSED(event)) {
 	m_enclosure->setMouseRectWidth(m_mouseRectWidthSpin->GetValue());
 	UpdateSpinRanges();
-	::wxGetApp().m_frame->m_organ->setModified(true);
+	::wxGetApp().m_frame->m_organ->setSectionModified(m_enclosure->getOwningPanel());
 }
 
 void GUIEnclosurePanel::OnMouseRectHeightSpin(wxSpinEvent& WXUNUSED(event)) {
 	m_enclosure->setMouseRectHeight(m_mouseRectHeightSpin->GetValue());
 	UpdateSpinRanges();
-	::wxGetApp().m_frame->m_organ->setModified(true);
+	::wxGetApp().m_frame->m_organ->setSectionModified(m_enclosure->getOwningPanel());
 }
 
 void GUIEnclosurePanel::OnMouseAxisStartSpin(wxSpinEvent& WXUNUSED(event)) {
 	m_enclosure->setMouseAxisStart(m_mouseAxisStartSpin->GetValue());
 	UpdateSpinRanges();
-	::wxGetApp().m_frame->m_organ->setModified(true);
+	::wxGetApp().m_frame->m_organ->setSectionModified(m_enclosure->getOwningPanel());
 }
 
 void GUIEnclosurePanel::OnMouseAxisEndSpin(wxSpinEvent& WXUNUSED(event)) {
 	m_enclosure->setMouseAxisEnd(m_mouseAxisEndSpin->GetValue());
-	::wxGetApp().m_frame->m_organ->setModified(true);
+	::wxGetApp().m_frame->m_organ->setSectionModified(m_enclosure->getOwningPanel());
 }
 
 void GUIEnclosurePanel::OnTextRectLeftSpin(wxSpinEvent& WXUNUSED(event)) {
 	m_enclosure->setTextRectLeft(m_textRectLeftSpin->GetValue());
 	UpdateSpinRanges();
-	::wxGetApp().m_frame->m_organ->setModified(true);
+	::wxGetApp().m_frame->m_organ->setSectionModified(m_enclosure->getOwningPanel());
 }
 
 void GUIEnclosurePanel::OnTextRectTopSpin(wxSpinEvent& WXUNUSED(event)) {
 	m_enclosure->setTextRectTop(m_textRectTopSpin->GetValue());
 	UpdateSpinRanges();
-	::wxGetApp().m_frame->m_organ->setModified(true);
+	::wxGetApp().m_frame->m_organ->setSectionModified(m_enclosure->getOwningPanel());
 }
 
 void GUIEnclosurePanel::OnTextRectWidthSpin(wxSpinEvent& WXUNUSED(event)) {
 	m_enclosure->setTextRectWidth(m_textRectWidthSpin->GetValue());
 	UpdateSpinRanges();
-	::wxGetApp().m_frame->m_organ->setModified(true);
+	::wxGetApp().m_frame->m_organ->setSectionModified(m_enclosure->getOwningPanel());
 }
 
 void GUIEnclosurePanel::OnTextRectHeightSpin(wxSpinEvent& WXUNUSED(event)) {
 	m_enclosure->setTextRectHeight(m_textRectHeightSpin->GetValue());
 	UpdateSpinRanges();
-	::wxGetApp().m_frame->m_organ->setModified(true);
+	::wxGetApp().m_frame->m_organ->setSectionModified(m_enclosure->getOwningPanel());
 }
 
 void GUIEnclosurePanel::OnTextBreakWidthSpin(wxSpinEvent& WXUNUSED(event)) {
 	m_enclosure->setTextBreakWidth(m_textBreakWidthSpin->GetValue());
-	::wxGetApp().m_frame->m_organ->setModified(true);
+	::wxGetApp().m_frame->m_organ->setSectionModified(m_enclosure->getOwningPanel());
 }
 
 void GUIEnclosurePanel::OnRemoveEnclosureBtn(wxCommandEvent& WXUNUSED(event)) {
@@ -34,7 +34,7 @@ GUIGeneral::~GUIGeneral() {
 void GUIGeneral::write(wxTextFile *outFile) {
 	GUIElement::write(outFile);
 	if (m_general) {
-		int generalNbr = ::wxGetApp().m_frame->m_organ->getIndexOfOrganGeneral(m_general);
+		int generalNbr = OrganContext::current()->getOrgan()->getIndexOfOrganGeneral(m_general);
 		wxString generalId = wxT("General=") + GOODF_functions::number_format(generalNbr);
 		outFile->AddLine(generalId);
 	}
@@ -53,7 +53,7 @@ bool GUIGeneral::isReferencing(General *general) {
 	return m_general == general ? true : false;
 }
 
-void GUIGeneral::updateDisplayName() {
+void GUIGeneral::updateDisplayName(OrganContext&) {
 	if (m_general)
 		setDisplayName(m_general->getName() + wxT(" (General)"));
 }
@@ -34,7 +34,7 @@ public:
 	void write(wxTextFile *outFile);
 	virtual GUIGeneral* clone();
 	bool isReferencing(General *general);
-	void updateDisplayName();
+	void updateDisplayName(OrganContext &context);
 	wxString getElementName();
 
 private:
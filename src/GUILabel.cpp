@@ -20,6 +20,7 @@
 
 #include "GUILabel.h"
 #include "GOODFFunctions.h"
+#include "Instrumentation.h"
 #include "GOODF.h"
 
 GUILabel::GUILabel() {
@@ -102,9 +103,9 @@ void GUILabel::write(wxTextFile *outFile) {
 	if (m_dispImageNum != 1 && m_image.getImage() == wxEmptyString)
 		outFile->AddLine(wxT("DispImageNum=") + wxString::Format(wxT("%i"), m_dispImageNum));
 	if (m_image.getImage() != wxEmptyString)
-		outFile->AddLine(GOODF_functions::fixSeparator(wxT("Image=") + m_image.getRelativeImagePath()));
+		outFile->AddLine(GOODF_functions::fixSeparator(wxT("Image=") + m_image.getRelativeImagePath(*OrganContext::current())));
 	if (m_image.getMask() != wxEmptyString && m_image.getImage() != wxEmptyString)
-		outFile->AddLine(GOODF_functions::fixSeparator(wxT("Mask=") + m_image.getRelativeMaskPath()));
+		outFile->AddLine(GOODF_functions::fixSeparator(wxT("Mask=") + m_image.getRelativeMaskPath(*OrganContext::current())));
 	if (m_width != m_bitmapWidth)
 		outFile->AddLine(wxT("Width=") + wxString::Format(wxT("%i"), m_width));
 	if (m_height != m_bitmapHeight)
@@ -202,6 +203,7 @@ void GUILabel::read(wxFileConfig *cfg, Organ *readOrgan) {
 	wxString fullImgPath = GOODF_functions::checkIfFileExist(img, readOrgan);
 	if (fullImgPath != wxEmptyString) {
 		wxImage realImage = wxImage(fullImgPath);
+		Instrumentation::count(Instrumentation::BITMAPS_DECODED);
 		if (realImage.IsOk()) {
 			m_image.setImage(fullImgPath);
 			m_image.setOriginalWidth(realImage.GetWidth());
@@ -269,7 +271,7 @@ GUILabel* GUILabel::clone() {
 	return new GUILabel(*this);
 }
 
-void GUILabel::updateDisplayName() {
+void GUILabel::updateDisplayName(OrganContext&) {
 	if (m_type.IsSameAs(wxT("Label"))) {
 		if (m_name != wxEmptyString) {
 			wxString dispName;
@@ -40,7 +40,7 @@ public:
 	void read(wxFileConfig *cfg, Organ *readOrgan);
 	virtual GUILabel* clone();
 
-	void updateDisplayName();
+	void updateDisplayName(OrganContext &context);
 
 	bool isDispAtTopOfDrawstopCol() const;
 	void setDispAtTopOfDrawstopCol(bool dispAtTopOfDrawstopCol);
@@ -676,7 +676,7 @@ void GUILabelPanel::setLabel(GUILabel *label) {
 	}
 
 	if (m_label->getImage()->getMask() != wxEmptyString) {
-		m_maskPathField->SetValue(m_label->getImage()->getRelativeMaskPath());
+		m_maskPathField->SetValue(m_label->getImage()->getRelativeMaskPath(*::wxGetApp().m_frame->m_organ->getContext()));
 	} else {
 		m_maskPathField->SetValue(wxEmptyString);
 	}
@@ -768,9 +768,9 @@ void GUILabelPanel::OnLabelTextChange(wxCommandEvent& WXUNUSED(event)) {
 	wxString content = m_labelTextField->GetValue();
 	GOODF_functions::CheckForStartingWhitespace(&content, m_labelTextField);
 	m_label->setName(m_labelTextField->GetValue());
-	m_label->updateDisplayName();
+	m_label->updateDisplayName(*::wxGetApp().m_frame->m_organ->getContext());
 	::wxGetApp().m_frame->OrganTreeChildItemLabelChanged(m_label->getDisplayName());
-	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
+	::wxGetApp().m_frame->PanelGUIPropertyIsChanged(m_label->getOwningPanel());
 }
 
 void GUILabelPanel::OnLabelFontChange(wxCommandEvent& WXUNUSED(event)) {
@@ -806,7 +806,7 @@ void GUILabelPanel::OnLabelFontChange(wxCommandEvent& WXUNUSED(event)) {
 		}
 	}
 
-	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
+	::wxGetApp().m_frame->PanelGUIPropertyIsChanged(m_label->getOwningPanel());
 }
 
 void GUILabelPanel::OnLabelColourChoice(wxCommandEvent& event) {
@@ -817,7 +817,7 @@ void GUILabelPanel::OnLabelColourChoice(wxCommandEvent& event) {
 			m_label->getDispLabelColour()->setSelectedColorIndex(m_labelColourChoice->GetSelection());
 			m_labelColourPick->SetColour(m_label->getDispLabelColour()->getColor());
 			m_labelColourPick->Disable();
-			::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
+			::wxGetApp().m_frame->PanelGUIPropertyIsChanged(m_label->getOwningPanel());
 		}
 	}
 }
@@ -825,7 +825,7 @@ void GUILabelPanel::OnLabelColourChoice(wxCommandEvent& event) {
 void GUILabelPanel::OnLabelColourPick(wxColourPickerEvent& event) {
 	if (event.GetId() == ID_GUILABELPANEL_COLOR_PICKER) {
 		m_label->getDispLabelColour()->setColorValue(m_labelColourPick->GetColour());
-		::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
+		::wxGetApp().m_frame->PanelGUIPropertyIsChanged(m_label->getOwningPanel());
 	}
 }
 
@@ -847,7 +847,7 @@ void GUILabelPanel::OnFreeXposRadio(wxCommandEvent& event) {
 		m_spanDrawstopColToRightNo->Enable();
 		m_drawstopColSpin->Enable();
 	}
-	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
+	::wxGetApp().m_frame->PanelGUIPropertyIsChanged(m_label->getOwningPanel());
 }
 
 void GUILabelPanel::OnFreeYposRadio(wxCommandEvent& event) {
@@ -866,7 +866,7 @@ void GUILabelPanel::OnFreeYposRadio(wxCommandEvent& event) {
 		m_atTopOfDrawstopColYes->Enable();
 		m_atTopOfDrawstopColNo->Enable();
 	}
-	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
+	::wxGetApp().m_frame->PanelGUIPropertyIsChanged(m_label->getOwningPanel());
 }
 
 void GUILabelPanel::OnImageNumberChoice(wxCommandEvent& WXUNUSED(event)) {
@@ -875,12 +875,12 @@ void GUILabelPanel::OnImageNumberChoice(wxCommandEvent& WXUNUSED(event)) {
 	UpdateDefaultImageValues();
 	UpdateSpinRanges();
 	UpdateDefaultSpinValues();
-	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
+	::wxGetApp().m_frame->PanelGUIPropertyIsChanged(m_label->getOwningPanel());
 }
 
 void GUILabelPanel::OnDrawstopColSpin(wxSpinEvent& WXUNUSED(event)) {
 	m_label->setDispDrawstopCol(m_drawstopColSpin->GetValue());
-	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
+	::wxGetApp().m_frame->PanelGUIPropertyIsChanged(m_label->getOwningPanel());
 }
 
 void GUILabelPanel::OnAtTopOfDrawstopColRadio(wxCommandEvent& event) {
@@ -889,7 +889,7 @@ void GUILabelPanel::OnAtTopOfDrawstopColRadio(wxCommandEvent& event) {
 	} else {
 		m_label->setDispAtTopOfDrawstopCol(false);
 	}
-	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
+	::wxGetApp().m_frame->PanelGUIPropertyIsChanged(m_label->getOwningPanel());
 }
 
 void GUILabelPanel::OnSpanDrawstopColRightRadio(wxCommandEvent& event) {
@@ -898,7 +898,7 @@ void GUILabelPanel::OnSpanDrawstopColRightRadio(wxCommandEvent& event) {
 	} else {
 		m_label->setDispSpanDrawstopColToRight(false);
 	}
-	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
+	::wxGetApp().m_frame->PanelGUIPropertyIsChanged(m_label->getOwningPanel());
 }
 
 void GUILabelPanel::OnAddImageBtn(wxCommandEvent& WXUNUSED(event)) {
@@ -918,7 +918,7 @@ void GUILabelPanel::OnAddImageBtn(wxCommandEvent& WXUNUSED(event)) {
 			m_label->setTextBreakWidth(m_label->getTextRectWidth());
 			UpdateSpinRanges();
 			UpdateDefaultSpinValues();
-			m_imagePathField->SetValue(m_label->getImage()->getRelativeImagePath());
+			m_imagePathField->SetValue(m_label->getImage()->getRelativeImagePath(*::wxGetApp().m_frame->m_organ->getContext()));
 			m_addMaskBtn->Enable();
 			m_dispImageNbrBox->Disable();
 		}
@@ -943,7 +943,7 @@ void GUILabelPanel::OnAddImageBtn(wxCommandEvent& WXUNUSED(event)) {
 			}
 		}
 	}
-	::wxGetApp().m_frame->m_organ->setModified(true);
+	::wxGetApp().m_frame->m_organ->setSectionModified(m_label->getOwningPanel());
 }
 
 void GUILabelPanel::OnAddMaskBtn(wxCommandEvent& WXUNUSED(event)) {
@@ -969,7 +969,7 @@ void GUILabelPanel::OnAddMaskBtn(wxCommandEvent& WXUNUSED(event)) {
 			}
 		}
 	}
-	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
+	::wxGetApp().m_frame->PanelGUIPropertyIsChanged(m_label->getOwningPanel());
 }
 
 void GUILabelPanel::OnWidthSpin(wxSpinEvent& WXUNUSED(event)) {
@@ -977,7 +977,7 @@ void GUILabelPanel::OnWidthSpin(wxSpinEvent& WXUNUSED(event)) {
 	m_label->setWidth(value);
 	UpdateSpinRanges();
 	UpdateDefaultSpinValues();
-	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
+	::wxGetApp().m_frame->PanelGUIPropertyIsChanged(m_label->getOwningPanel());
 }
 
 void GUILabelPanel::OnHeightSpin(wxSpinEvent& WXUNUSED(event)) {
@@ -985,48 +985,48 @@ void GUILabelPanel::OnHeightSpin(wxSpinEvent& WXUNUSED(event)) {
 	m_label->setHeight(value);
 	UpdateSpinRanges();
 	UpdateDefaultSpinValues();
-	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
+	::wxGetApp().m_frame->PanelGUIPropertyIsChanged(m_label->getOwningPanel());
 }
 
 void GUILabelPanel::OnTileOffsetXSpin(wxSpinEvent& WXUNUSED(event)) {
 	m_label->setTileOffsetX(m_tileOffsetXSpin->GetValue());
-	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
+	::wxGetApp().m_frame->PanelGUIPropertyIsChanged(m_label->getOwningPanel());
 }
 
 void GUILabelPanel::OnTileOffsetYSpin(wxSpinEvent& WXUNUSED(event)) {
 	m_label->setTileOffsetY(m_tileOffsetYSpin->GetValue());
-	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
+	::wxGetApp().m_frame->PanelGUIPropertyIsChanged(m_label->getOwningPanel());
 }
 
 void GUILabelPanel::OnTextRectLeftSpin(wxSpinEvent& WXUNUSED(event)) {
 	m_label->setTextRectLeft(m_textRectLeftSpin->GetValue());
 	UpdateSpinRanges();
 	UpdateDefaultSpinValues();
-	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
+	::wxGetApp().m_frame->PanelGUIPropertyIsChanged(m_label->getOwningPanel());
 }
 
 void GUILabelPanel::OnTextRectTopSpin(wxSpinEvent& WXUNUSED(event)) {
 	m_label->setTextRectTop(m_textRectTopSpin->GetValue());
 	UpdateSpinRanges();
 	UpdateDefaultSpinValues();
-	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
+	::wxGetApp().m_frame->PanelGUIPropertyIsChanged(m_label->getOwningPanel());
 }
 
 void GUILabelPanel::OnTextRectWidthSpin(wxSpinEvent& WXUNUSED(event)) {
 	m_label->setTextRectWidth(m_textRectWidthSpin->GetValue());
 	UpdateSpinRanges();
 	UpdateDefaultSpinValues();
-	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
+	::wxGetApp().m_frame->PanelGUIPropertyIsChanged(m_label->getOwningPanel());
 }
 
 void GUILabelPanel::OnTextRectHeightSpin(wxSpinEvent& WXUNUSED(event)) {
 	m_label->setTextRectHeight(m_textRectHeightSpin->GetValue());
-	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
+	::wxGetApp().m_frame->PanelGUIPropertyIsChanged(m_label->getOwningPanel());
 }
 
 void GUILabelPanel::OnTextBreakWidthSpin(wxSpinEvent& WXUNUSED(event)) {
 	m_label->setTextBreakWidth(m_textBreakWidthSpin->GetValue());
-	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
+	::wxGetApp().m_frame->PanelGUIPropertyIsChanged(m_label->getOwningPanel());
 }
 
 void GUILabelPanel::OnPositionXSpin(wxSpinEvent& WXUNUSED(event)) {
@@ -1039,7 +1039,7 @@ void GUILabelPanel::OnPositionXSpin(wxSpinEvent& WXUNUSED(event)) {
 	} else {
 		m_dispXposSpin->Enable();
 	}
-	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
+	::wxGetApp().m_frame->PanelGUIPropertyIsChanged(m_label->getOwningPanel());
 }
 
 void GUILabelPanel::OnPositionYSpin(wxSpinEvent& WXUNUSED(event)) {
@@ -1052,17 +1052,17 @@ void GUILabelPanel::OnPositionYSpin(wxSpinEvent& WXUNUSED(event)) {
 	} else {
 		m_dispYposSpin->Enable();
 	}
-	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
+	::wxGetApp().m_frame->PanelGUIPropertyIsChanged(m_label->getOwningPanel());
 }
 
 void GUILabelPanel::OnDispXposSpin(wxSpinEvent& WXUNUSED(event)) {
 	m_label->setDispXpos(m_dispXposSpin->GetValue());
-	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
+	::wxGetApp().m_frame->PanelGUIPropertyIsChanged(m_label->getOwningPanel());
 }
 
 void GUILabelPanel::OnDispYposSpin(wxSpinEvent& WXUNUSED(event)) {
 	m_label->setDispYpos(m_dispYposSpin->GetValue());
-	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
+	::wxGetApp().m_frame->PanelGUIPropertyIsChanged(m_label->getOwningPanel());
 }
 
 void GUILabelPanel::OnRemoveLabelBtn(wxCommandEvent& WXUNUSED(event)) {
@@ -20,6 +20,7 @@
 
 #include "GUIManual.h"
 #include "GOODFFunctions.h"
+#include "Instrumentation.h"
 #include "GOODF.h"
 
 GUIManual::GUIManual(Manual *manual) : GUIElement(), m_manual(manual) {
@@ -43,7 +44,7 @@ GUIManual::~GUIManual() {
 
 void GUIManual::write(wxTextFile *outFile) {
 	GUIElement::write(outFile);
-	wxString manId = wxT("Manual=") + GOODF_functions::number_format(::wxGetApp().m_frame->m_organ->getIndexOfOrganManual(m_manual));
+	wxString manId = wxT("Manual=") + GOODF_functions::number_format(OrganContext::current()->getOrgan()->getIndexOfOrganManual(m_manual));
 	outFile->AddLine(manId);
 	if (m_positionX != -1)
 		outFile->AddLine(wxT("PositionX=") + wxString::Format(wxT("%i"), m_positionX));
@@ -53,13 +54,13 @@ void GUIManual::write(wxTextFile *outFile) {
 		for (KEYTYPE& key : m_keytypes) {
 			if (key.KeytypeIdentifier.StartsWith(wxT("Key"))) {
 				if (key.ImageOn.getImage() != wxEmptyString)
-					outFile->AddLine(key.KeytypeIdentifier + wxT("ImageOn=") + GOODF_functions::fixSeparator(key.ImageOn.getRelativeImagePath()));
+					outFile->AddLine(key.KeytypeIdentifier + wxT("ImageOn=") + GOODF_functions::fixSeparator(key.ImageOn.getRelativeImagePath(*OrganContext::current())));
 				if (key.ImageOff.getImage() != wxEmptyString)
-					outFile->AddLine(key.KeytypeIdentifier + wxT("ImageOff=") + GOODF_functions::fixSeparator(key.ImageOff.getRelativeImagePath()));
+					outFile->AddLine(key.KeytypeIdentifier + wxT("ImageOff=") + GOODF_functions::fixSeparator(key.ImageOff.getRelativeImagePath(*OrganContext::current())));
 				if (key.ImageOn.getMask() != wxEmptyString)
-					outFile->AddLine(key.KeytypeIdentifier + wxT("MaskOn=") + GOODF_functions::fixSeparator(key.ImageOn.getRelativeMaskPath()));
+					outFile->AddLine(key.KeytypeIdentifier + wxT("MaskOn=") + GOODF_functions::fixSeparator(key.ImageOn.getRelativeMaskPath(*OrganContext::current())));
 				if (key.ImageOff.getMask() != wxEmptyString)
-					outFile->AddLine(key.KeytypeIdentifier + wxT("MaskOff=") + GOODF_functions::fixSeparator(key.ImageOff.getRelativeMaskPath()));
+					outFile->AddLine(key.KeytypeIdentifier + wxT("MaskOff=") + GOODF_functions::fixSeparator(key.ImageOff.getRelativeMaskPath(*OrganContext::current())));
 				if (key.Width != key.BitmapWidth || keyNbrOverrideBaseKeyWidth(&key) || key.ForceWritingWidth)
 					outFile->AddLine(key.KeytypeIdentifier + wxT("Width=") + wxString::Format(wxT("%i"), key.Width));
 				if (key.Offset != 0 || key.ForceWritingOffset)
@@ -76,13 +77,13 @@ void GUIManual::write(wxTextFile *outFile) {
 					outFile->AddLine(key.KeytypeIdentifier + wxT("MouseRectHeight=") + wxString::Format(wxT("%i"), key.MouseRectHeight));
 			} else {
 				if (key.ImageOn.getImage() != wxEmptyString)
-					outFile->AddLine(wxT("ImageOn_") + key.KeytypeIdentifier + wxT("=") + GOODF_functions::fixSeparator(key.ImageOn.getRelativeImagePath()));
+					outFile->AddLine(wxT("ImageOn_") + key.KeytypeIdentifier + wxT("=") + GOODF_functions::fixSeparator(key.ImageOn.getRelativeImagePath(*OrganContext::current())));
 				if (key.ImageOff.getImage() != wxEmptyString)
-					outFile->AddLine(wxT("ImageOff_") + key.KeytypeIdentifier + wxT("=") + GOODF_functions::fixSeparator(key.ImageOff.getRelativeImagePath()));
+					outFile->AddLine(wxT("ImageOff_") + key.KeytypeIdentifier + wxT("=") + GOODF_functions::fixSeparator(key.ImageOff.getRelativeImagePath(*OrganContext::current())));
 				if (key.ImageOn.getMask() != wxEmptyString)
-					outFile->AddLine(wxT("MaskOn_") + key.KeytypeIdentifier + wxT("=") + GOODF_functions::fixSeparator(key.ImageOn.getRelativeMaskPath()));
+					outFile->AddLine(wxT("MaskOn_") + key.KeytypeIdentifier + wxT("=") + GOODF_functions::fixSeparator(key.ImageOn.getRelativeMaskPath(*OrganContext::current())));
 				if (key.ImageOff.getMask() != wxEmptyString)
-					outFile->AddLine(wxT("MaskOff_") + key.KeytypeIdentifier + wxT("=") + GOODF_functions::fixSeparator(key.ImageOff.getRelativeMaskPath()));
+					outFile->AddLine(wxT("MaskOff_") + key.KeytypeIdentifier + wxT("=") + GOODF_functions::fixSeparator(key.ImageOff.getRelativeMaskPath(*OrganContext::current())));
 				if (key.Width != key.BitmapWidth || key.ForceWritingWidth)
 					outFile->AddLine(wxT("Width_") + key.KeytypeIdentifier + wxT("=") + wxString::Format(wxT("%i"), key.Width));
 				if (key.Offset != 0 || key.ForceWritingOffset)
@@ -190,6 +191,7 @@ void GUIManual::read(wxFileConfig *cfg, Organ *readOrgan) {
 				wxString fullImgOnPath = GOODF_functions::checkIfFileExist(cfgImgOn, readOrgan);
 				if (fullImgOnPath != wxEmptyString) {
 					wxImage img = wxImage(fullImgOnPath);
+					Instrumentation::count(Instrumentation::BITMAPS_DECODED);
 					if (img.IsOk()) {
 						int width = img.GetWidth();
 						int height = img.GetHeight();
@@ -268,6 +270,7 @@ void GUIManual::read(wxFileConfig *cfg, Organ *readOrgan) {
 			wxString fullImgOnPath = GOODF_functions::checkIfFileExist(keyImgOn, readOrgan);
 			if (fullImgOnPath != wxEmptyString) {
 				wxImage img = wxImage(fullImgOnPath);
+				Instrumentation::count(Instrumentation::BITMAPS_DECODED);
 				if (img.IsOk()) {
 					int width = img.GetWidth();
 					int height = img.GetHeight();
@@ -379,8 +382,8 @@ bool GUIManual::isReferencing(Manual *man) {
 	return m_manual == man ? true : false;
 }
 
-void GUIManual::updateDisplayName() {
-	setDisplayName(m_manual->getName() + wxT(" (Manual[") + GOODF_functions::number_format(::wxGetApp().m_frame->m_organ->getIndexOfOrganManual(m_manual)) + wxT("])"));
+void GUIManual::updateDisplayName(OrganContext &context) {
+	setDisplayName(m_manual->getName() + wxT(" (Manual[") + GOODF_functions::number_format(context.getOrgan()->getIndexOfOrganManual(m_manual)) + wxT("])"));
 }
 
 Manual* GUIManual::getManual() {
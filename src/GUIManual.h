@@ -77,7 +77,7 @@ public:
 
 	virtual GUIManual* clone();
 	bool isReferencing(Manual *man);
-	void updateDisplayName();
+	void updateDisplayName(OrganContext &context);
 
 	Manual* getManual();
 	void addKeytype(wxString identifier, bool isReading = false);
@@ -788,7 +788,7 @@ void GUIManualPanel::OnKeyColorInvertedRadio(wxCommandEvent& event) {
 		m_manual->setDispKeyColourInverted(false);
 	}
 	SetupImageNbrBoxContent();
-	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
+	::wxGetApp().m_frame->PanelGUIPropertyIsChanged(m_manual->getOwningPanel());
 }
 
 void GUIManualPanel::OnKeyColorWoodRadio(wxCommandEvent& event) {
@@ -798,7 +798,7 @@ void GUIManualPanel::OnKeyColorWoodRadio(wxCommandEvent& event) {
 		m_manual->setDispKeyColurWooden(false);
 	}
 	SetupImageNbrBoxContent();
-	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
+	::wxGetApp().m_frame->PanelGUIPropertyIsChanged(m_manual->getOwningPanel());
 }
 
 void GUIManualPanel::OnForceWriteWidthRadio(wxCommandEvent& event) {
@@ -812,22 +812,22 @@ void GUIManualPanel::OnForceWriteWidthRadio(wxCommandEvent& event) {
 			currentKey->ForceWritingWidth = false;
 		}
 	}
-	::wxGetApp().m_frame->m_organ->setModified(true);
+	::wxGetApp().m_frame->m_organ->setSectionModified(m_manual->getOwningPanel());
 }
 
 void GUIManualPanel::OnImageNumberChoice(wxCommandEvent& WXUNUSED(event)) {
 	m_manual->setDispImageNum(m_dispImageNbrBox->GetSelection() + 1);
-	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
+	::wxGetApp().m_frame->PanelGUIPropertyIsChanged(m_manual->getOwningPanel());
 }
 
 void GUIManualPanel::OnPositionXSpin(wxSpinEvent& WXUNUSED(event)) {
 	m_manual->setPosX(m_elementPosXSpin->GetValue());
-	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
+	::wxGetApp().m_frame->PanelGUIPropertyIsChanged(m_manual->getOwningPanel());
 }
 
 void GUIManualPanel::OnPositionYSpin(wxSpinEvent& WXUNUSED(event)) {
 	m_manual->setPosY(m_elementPosYSpin->GetValue());
-	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
+	::wxGetApp().m_frame->PanelGUIPropertyIsChanged(m_manual->getOwningPanel());
 }
 
 void GUIManualPanel::OnAvailableKeyTypesChoice(wxCommandEvent& WXUNUSED(event)) {
@@ -882,7 +882,7 @@ void GUIManualPanel::OnAddKeyBtn(wxCommandEvent& WXUNUSED(event)) {
 		wxCommandEvent evt(wxEVT_LISTBOX, ID_GUIMANUALPANEL_ADDED_KEYS_BOX);
 		wxPostEvent(this, evt);
 	}
-	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
+	::wxGetApp().m_frame->PanelGUIPropertyIsChanged(m_manual->getOwningPanel());
 }
 
 void GUIManualPanel::OnRemoveKeyBtn(wxCommandEvent& WXUNUSED(event)) {
@@ -908,7 +908,7 @@ void GUIManualPanel::OnRemoveKeyBtn(wxCommandEvent& WXUNUSED(event)) {
 		m_removeKey->Disable();
 		UpdateExistingSelectedKeyData();
 	}
-	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
+	::wxGetApp().m_frame->PanelGUIPropertyIsChanged(m_manual->getOwningPanel());
 }
 
 void GUIManualPanel::OnCopyKeyBtn(wxCommandEvent& WXUNUSED(event)) {
@@ -935,7 +935,7 @@ void GUIManualPanel::OnCopyKeyBtn(wxCommandEvent& WXUNUSED(event)) {
 		}
 		m_manual->updateKeyInfo();
 	}
-	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
+	::wxGetApp().m_frame->PanelGUIPropertyIsChanged(m_manual->getOwningPanel());
 }
 
 void GUIManualPanel::OnAddedKeysChoice(wxCommandEvent& WXUNUSED(event)) {
@@ -991,7 +991,7 @@ void GUIManualPanel::OnAddImageOnBtn(wxCommandEvent& WXUNUSED(event)) {
 			}
 		}
 	}
-	::wxGetApp().m_frame->m_organ->setModified(true);
+	::wxGetApp().m_frame->m_organ->setSectionModified(m_manual->getOwningPanel());
 }
 
 void GUIManualPanel::OnAddImageOffBtn(wxCommandEvent& WXUNUSED(event)) {
@@ -1006,7 +1006,7 @@ void GUIManualPanel::OnAddImageOffBtn(wxCommandEvent& WXUNUSED(event)) {
 				key->ImageOff.setImage(path);
 				m_manual->updateKeyInfo();
 				UpdateExistingSelectedKeyData();
-				::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
+				::wxGetApp().m_frame->PanelGUIPropertyIsChanged(m_manual->getOwningPanel());
 			}
 		}
 	} else {
@@ -1021,7 +1021,7 @@ void GUIManualPanel::OnAddImageOffBtn(wxCommandEvent& WXUNUSED(event)) {
 					key->ImageOff.setMask(wxEmptyString);
 
 				UpdateExistingSelectedKeyData();
-				::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
+				::wxGetApp().m_frame->PanelGUIPropertyIsChanged(m_manual->getOwningPanel());
 			}
 		}
 	}
@@ -1052,7 +1052,7 @@ void GUIManualPanel::OnAddMaskOffBtn(wxCommandEvent& WXUNUSED(event)) {
 			}
 		}
 	}
-	::wxGetApp().m_frame->m_organ->setModified(true);
+	::wxGetApp().m_frame->m_organ->setSectionModified(m_manual->getOwningPanel());
 }
 
 void GUIManualPanel::OnAddMaskOnBtn(wxCommandEvent& WXUNUSED(event)) {
@@ -1080,52 +1080,52 @@ void GUIManualPanel::OnAddMaskOnBtn(wxCommandEvent& WXUNUSED(event)) {
 			}
 		}
 	}
-	::wxGetApp().m_frame->m_organ->setModified(true);
+	::wxGetApp().m_frame->m_organ->setSectionModified(m_manual->getOwningPanel());
 }
 
 void GUIManualPanel::OnWidthSpin(wxSpinEvent& WXUNUSED(event)) {
 	KEYTYPE *key = m_manual->getKeytypeAt(m_addedKeyTypes->GetSelection());
 	key->Width = m_widthSpin->GetValue();
 	m_manual->updateKeyInfo();
-	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
+	::wxGetApp().m_frame->PanelGUIPropertyIsChanged(m_manual->getOwningPanel());
 }
 
 void GUIManualPanel::OnOffsetSpin(wxSpinEvent& WXUNUSED(event)) {
 	KEYTYPE *key = m_manual->getKeytypeAt(m_addedKeyTypes->GetSelection());
 	key->Offset = m_offsetSpin->GetValue();
 	m_manual->updateKeyInfo();
-	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
+	::wxGetApp().m_frame->PanelGUIPropertyIsChanged(m_manual->getOwningPanel());
 }
 
 void GUIManualPanel::OnOffsetYSpin(wxSpinEvent& WXUNUSED(event)) {
 	KEYTYPE *key = m_manual->getKeytypeAt(m_addedKeyTypes->GetSelection());
 	key->YOffset = m_offsetYSpin->GetValue();
 	m_manual->updateKeyInfo();
-	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
+	::wxGetApp().m_frame->PanelGUIPropertyIsChanged(m_manual->getOwningPanel());
 }
 
 void GUIManualPanel::OnMouseRectLeftSpin(wxSpinEvent& WXUNUSED(event)) {
 	KEYTYPE *key = m_manual->getKeytypeAt(m_addedKeyTypes->GetSelection());
 	key->MouseRectLeft = m_mouseRectLeftSpin->GetValue();
-	::wxGetApp().m_frame->m_organ->setModified(true);
+	::wxGetApp().m_frame->m_organ->setSectionModified(m_manual->getOwningPanel());
 }
 
 void GUIManualPanel::OnMouseRectTopSpin(wxSpinEvent& WXUNUSED(event)) {
 	KEYTYPE *key = m_manual->getKeytypeAt(m_addedKeyTypes->GetSelection());
 	key->MouseRectTop = m_mouseRectTopSpin->GetValue();
-	::wxGetApp().m_frame->m_organ->setModified(true);
+	::wxGetApp().m_frame->m_organ->setSectionModified(m_manual->getOwningPanel());
 }
 
 void GUIManualPanel::OnMouseRectWidthSpin(wxSpinEvent& WXUNUSED(event)) {
 	KEYTYPE *key = m_manual->getKeytypeAt(m_addedKeyTypes->GetSelection());
 	key->MouseRectWidth = m_mouseRectWidthSpin->GetValue();
-	::wxGetApp().m_frame->m_organ->setModified(true);
+	::wxGetApp().m_frame->m_organ->setSectionModified(m_manual->getOwningPanel());
 }
 
 void GUIManualPanel::OnMouseRectHeightSpin(wxSpinEvent& WXUNUSED(event)) {
 	KEYTYPE *key = m_manual->getKeytypeAt(m_addedKeyTypes->GetSelection());
 	key->MouseRectHeight = m_mouseRectHeightSpin->GetValue();
-	::wxGetApp().m_frame->m_organ->setModified(true);
+	::wxGetApp().m_frame->m_organ->setSectionModified(m_manual->getOwningPanel());
 }
 
 void GUIManualPanel::OnDisplayKeysSpin(wxSpinEvent& WXUNUSED(event)) {
@@ -1134,7 +1134,7 @@ void GUIManualPanel::OnDisplayKeysSpin(wxSpinEvent& WXUNUSED(event)) {
 	SetupKeyChoiceAndMapping();
 	UpdateAddedKeyTypes();
 	UpdateExistingSelectedKeyData();
-	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
+	::wxGetApp().m_frame->PanelGUIPropertyIsChanged(m_manual->getOwningPanel());
 }
 
 void GUIManualPanel::OnFirstNoteSpin(wxSpinEvent& WXUNUSED(event)) {
@@ -1143,7 +1143,7 @@ void GUIManualPanel::OnFirstNoteSpin(wxSpinEvent& WXUNUSED(event)) {
 	SetupKeyChoiceAndMapping();
 	UpdateAddedKeyTypes();
 	UpdateExistingSelectedKeyData();
-	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
+	::wxGetApp().m_frame->PanelGUIPropertyIsChanged(m_manual->getOwningPanel());
 }
 
 void GUIManualPanel::OnDisplayKeyChoice(wxCommandEvent& WXUNUSED(event)) {
@@ -1159,7 +1159,7 @@ void GUIManualPanel::OnBackendMIDIkeySpin(wxSpinEvent& WXUNUSED(event)) {
 	int selectedIndex = m_displayKeyChoice->GetSelection();
 	if (selectedIndex != wxNOT_FOUND) {
 		m_manual->getDisplayKeyAt(selectedIndex)->first = m_backendMIDIkey->GetValue();
-		::wxGetApp().m_frame->m_organ->setModified(true);
+		::wxGetApp().m_frame->m_organ->setSectionModified(m_manual->getOwningPanel());
 	}
 }
 
@@ -1169,7 +1169,7 @@ void GUIManualPanel::OnFrontendMIDIkeySpin(wxSpinEvent& WXUNUSED(event)) {
 		m_manual->getDisplayKeyAt(selectedIndex)->second = m_frontendMIDIkey->GetValue();
 		m_manual->updateKeyInfo();
 	}
-	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
+	::wxGetApp().m_frame->PanelGUIPropertyIsChanged(m_manual->getOwningPanel());
 }
 
 void GUIManualPanel::OnRemoveManualBtn(wxCommandEvent& WXUNUSED(event)) {
@@ -1241,7 +1241,7 @@ void GUIManualPanel::UpdateExistingSelectedKeyData() {
 			m_forceWriteWidthYes->SetValue(true);
 		else
 			m_forceWriteWidthNo->SetValue(true);
-		m_imageOnPathField->SetValue(currentKey->ImageOn.getRelativeImagePath());
+		m_imageOnPathField->SetValue(currentKey->ImageOn.getRelativeImagePath(*::wxGetApp().m_frame->m_organ->getContext()));
 		if (m_imageOnPathField->GetValue() != wxEmptyString) {
 			m_addMaskOnBtn->Enable();
 			m_addImageOffBtn->Enable();
@@ -1250,13 +1250,13 @@ void GUIManualPanel::UpdateExistingSelectedKeyData() {
 			m_addImageOffBtn->Disable();
 			m_addMaskOffBtn->Disable();
 		}
-		m_maskOnPathField->SetValue(currentKey->ImageOn.getRelativeMaskPath());
-		m_imageOffPathField->SetValue(currentKey->ImageOff.getRelativeImagePath());
+		m_maskOnPathField->SetValue(currentKey->ImageOn.getRelativeMaskPath(*::wxGetApp().m_frame->m_organ->getContext()));
+		m_imageOffPathField->SetValue(currentKey->ImageOff.getRelativeImagePath(*::wxGetApp().m_frame->m_organ->getContext()));
 		if (m_imageOffPathField->GetValue() != wxEmptyString)
 			m_addMaskOffBtn->Enable();
 		else
 			m_addMaskOffBtn->Disable();
-		m_maskOffPathField->SetValue(currentKey->ImageOff.getRelativeMaskPath());
+		m_maskOffPathField->SetValue(currentKey->ImageOff.getRelativeMaskPath(*::wxGetApp().m_frame->m_organ->getContext()));
 
 		m_widthSpin->SetValue(currentKey->Width);
 		m_offsetSpin->SetValue(currentKey->Offset);
@@ -22,6 +22,7 @@
 #include "GUIButton.h"
 #include "GUILabel.h"
 #include "GOODF.h"
+#include "Instrumentation.h"
 
 // Event table
 BEGIN_EVENT_TABLE(GUIRepresentationDrawingPanel, wxPanel)
@@ -617,6 +618,7 @@ void GUIRepresentationDrawingPanel::DoPaintNow() {
 }
 
 void GUIRepresentationDrawingPanel::RenderPanel(wxDC& dc) {
+	ScopedTimer timer("render.panel");
 	m_overlay.Reset();
 	// First draw the basic background of left jamb
 	wxRect rect = wxRect(0, 0, GetCenterX(), m_currentPanel->getDisplayMetrics()->m_dispScreenSizeVert.getNumericalValue());
@@ -33,7 +33,7 @@ GUIReversiblePiston::~GUIReversiblePiston() {
 
 void GUIReversiblePiston::write(wxTextFile *outFile) {
 	GUIElement::write(outFile);
-	int reversiblePistonNbr = ::wxGetApp().m_frame->m_organ->getIndexOfReversiblePiston(m_reversiblePiston);
+	int reversiblePistonNbr = OrganContext::current()->getOrgan()->getIndexOfReversiblePiston(m_reversiblePiston);
 	wxString divId = wxT("ReversiblePiston=") + GOODF_functions::number_format(reversiblePistonNbr);
 	outFile->AddLine(divId);
 	if (m_positionX != -1)
@@ -51,7 +51,7 @@ bool GUIReversiblePiston::isReferencing(ReversiblePiston *reversiblePiston) {
 	return m_reversiblePiston == reversiblePiston ? true : false;
 }
 
-void GUIReversiblePiston::updateDisplayName() {
+void GUIReversiblePiston::updateDisplayName(OrganContext&) {
 	setDisplayName(m_reversiblePiston->getName() + wxT(" (Reversible piston)"));
 }
 
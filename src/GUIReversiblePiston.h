@@ -34,7 +34,7 @@ public:
 	void write(wxTextFile *outFile);
 	virtual GUIReversiblePiston* clone();
 	bool isReferencing(ReversiblePiston *reversiblePiston);
-	void updateDisplayName();
+	void updateDisplayName(OrganContext &context);
 	wxString getElementName();
 
 private:
@@ -32,7 +32,7 @@ GUIStop::~GUIStop() {
 
 void GUIStop::write(wxTextFile *outFile) {
 	GUIElement::write(outFile);
-	unsigned manualNbr = ::wxGetApp().m_frame->m_organ->getIndexOfOrganManual(m_stop->getOwningManual());
+	unsigned manualNbr = OrganContext::current()->getOrgan()->getIndexOfOrganManual(m_stop->getOwningManual());
 	wxString manId = wxT("Manual=") + GOODF_functions::number_format(manualNbr);
 	outFile->AddLine(manId);
 	int stopNbr = m_stop->getOwningManual()->getIndexOfStop(m_stop) + 1;
@@ -53,7 +53,7 @@ bool GUIStop::isReferencing(Stop *stop) {
 	return m_stop == stop ? true : false;
 }
 
-void GUIStop::updateDisplayName() {
+void GUIStop::updateDisplayName(OrganContext&) {
 	setDisplayName(m_stop->getName() + wxT(" (Stop in ") + m_stop->getOwningManual()->getName() + wxT(")"));
 }
 
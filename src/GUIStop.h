@@ -34,7 +34,7 @@ public:
 	void write(wxTextFile *outFile);
 	virtual GUIStop* clone();
 	bool isReferencing(Stop *stop);
-	void updateDisplayName();
+	void updateDisplayName(OrganContext &context);
 	wxString getElementName();
 
 private:
@@ -33,7 +33,7 @@ GUISwitch::~GUISwitch() {
 void GUISwitch::write(wxTextFile *outFile) {
 	GUIElement::write(outFile);
 	if (m_switch) {
-		int switchNbr = ::wxGetApp().m_frame->m_organ->getIndexOfOrganSwitch(m_switch);
+		int switchNbr = OrganContext::current()->getOrgan()->getIndexOfOrganSwitch(m_switch);
 		wxString swId = wxT("Switch=") + GOODF_functions::number_format(switchNbr);
 		outFile->AddLine(swId);
 	}
@@ -56,9 +56,9 @@ bool GUISwitch::isReferencing(GoSwitch *sw) {
 	return m_switch == sw ? true : false;
 }
 
-void GUISwitch::updateDisplayName() {
+void GUISwitch::updateDisplayName(OrganContext &context) {
 	if (m_switch)
-		setDisplayName(m_switch->getName() + wxT(" (Switch[") + GOODF_functions::number_format(::wxGetApp().m_frame->m_organ->getIndexOfOrganSwitch(m_switch)) + wxT("])"));
+		setDisplayName(m_switch->getName() + wxT(" (Switch[") + GOODF_functions::number_format(context.getOrgan()->getIndexOfOrganSwitch(m_switch)) + wxT("])"));
 }
 
 wxString GUISwitch::getElementName() {
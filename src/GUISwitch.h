@@ -38,7 +38,7 @@ public:
 
 	virtual GUISwitch* clone();
 	bool isReferencing(GoSwitch *sw);
-	void updateDisplayName();
+	void updateDisplayName(OrganContext &context);
 	wxString getElementName();
 
 private:
@@ -32,7 +32,7 @@ GUITremulant::~GUITremulant() {
 
 void GUITremulant::write(wxTextFile *outFile) {
 	GUIElement::write(outFile);
-	int tremulantNbr = ::wxGetApp().m_frame->m_organ->getIndexOfOrganTremulant(m_tremulant);
+	int tremulantNbr = OrganContext::current()->getOrgan()->getIndexOfOrganTremulant(m_tremulant);
 	wxString tremId = wxT("Tremulant=") + GOODF_functions::number_format(tremulantNbr);
 	outFile->AddLine(tremId);
 	if (m_positionX != -1)
@@ -54,8 +54,8 @@ bool GUITremulant::isReferencing(Tremulant *tremulant) {
 	return m_tremulant == tremulant ? true : false;
 }
 
-void GUITremulant::updateDisplayName() {
-	setDisplayName(m_tremulant->getName() + wxT(" (Tremulant[") + GOODF_functions::number_format(::wxGetApp().m_frame->m_organ->getIndexOfOrganTremulant(m_tremulant)) + wxT("])"));
+void GUITremulant::updateDisplayName(OrganContext &context) {
+	setDisplayName(m_tremulant->getName() + wxT(" (Tremulant[") + GOODF_functions::number_format(context.getOrgan()->getIndexOfOrganTremulant(m_tremulant)) + wxT("])"));
 }
 
 wxString GUITremulant::getElementName() {
@@ -38,7 +38,7 @@ public:
 
 	virtual GUITremulant* clone();
 	bool isReferencing(Tremulant *tremulant);
-	void updateDisplayName();
+	void updateDisplayName(OrganContext &context);
 	wxString getElementName();
 
 private:
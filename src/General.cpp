@@ -19,7 +19,7 @@
  */
 
 #include "General.h"
-#include "GOODF.h"
+#include "Organ.h"
 #include "GOODFFunctions.h"
 
 General::General() : Button() {
@@ -41,12 +41,12 @@ void General::write(wxTextFile *outFile) {
 	for (std::pair<Stop*, bool> stop : m_stops) {
 		// The returned index of organ manual is already adjusted so that the pedal always get index 0 and a manual
 		// will start at index 1 in the odf, this must be taken into account when looking for item
-		unsigned manId = ::wxGetApp().m_frame->m_organ->getIndexOfOrganManual(stop.first->getOwningManual());
+		unsigned manId = OrganContext::current()->getOrgan()->getIndexOfOrganManual(stop.first->getOwningManual());
 		unsigned actualManualIndex = manId;
-		if (!(::wxGetApp().m_frame->m_organ->doesHavePedals()))
+		if (!(OrganContext::current()->getOrgan()->doesHavePedals()))
 			actualManualIndex -= 1;
 
-		int stopIdx = ::wxGetApp().m_frame->m_organ->getOrganManualAt(actualManualIndex)->getIndexOfStop(stop.first) + 1;
+		int stopIdx = OrganContext::current()->getOrgan()->getOrganManualAt(actualManualIndex)->getIndexOfStop(stop.first) + 1;
 		wxString stopId = GOODF_functions::number_format(stopIdx);
 		if (stop.second)
 			outFile->AddLine(wxT("StopNumber") + GOODF_functions::number_format(counter) + wxT("=") + stopId);
@@ -62,12 +62,12 @@ void General::write(wxTextFile *outFile) {
 	outFile->AddLine(wxT("NumberOfCouplers=") + wxString::Format(wxT("%u"), nbCouplers));
 	counter = 1;
 	for (std::pair<Coupler*, bool> coupler : m_couplers) {
-		unsigned manId = ::wxGetApp().m_frame->m_organ->getIndexOfOrganManual(coupler.first->getOwningManual());
+		unsigned manId = OrganContext::current()->getOrgan()->getIndexOfOrganManual(coupler.first->getOwningManual());
 		unsigned actualManualIndex = manId;
-		if (!(::wxGetApp().m_frame->m_organ->doesHavePedals()))
+		if (!(OrganContext::current()->getOrgan()->doesHavePedals()))
 			actualManualIndex -= 1;
 
-		int couplerIdx = ::wxGetApp().m_frame->m_organ->getOrganManualAt(actualManualIndex)->getIndexOfCoupler(coupler.first) + 1;
+		int couplerIdx = OrganContext::current()->getOrgan()->getOrganManualAt(actualManualIndex)->getIndexOfCoupler(coupler.first) + 1;
 		wxString couplerId = GOODF_functions::number_format(couplerIdx);
 		if (coupler.second)
 			outFile->AddLine(wxT("CouplerNumber") + GOODF_functions::number_format(counter) + wxT("=") + couplerId);
@@ -83,7 +83,7 @@ void General::write(wxTextFile *outFile) {
 	outFile->AddLine(wxT("NumberOfTremulants=") + wxString::Format(wxT("%u"), nbTrems));
 	counter = 1;
 	for (std::pair<Tremulant*, bool> trem : m_tremulants) {
-		wxString tremId = GOODF_functions::number_format(::wxGetApp().m_frame->m_organ->getIndexOfOrganTremulant(trem.first));
+		wxString tremId = GOODF_functions::number_format(OrganContext::current()->getOrgan()->getIndexOfOrganTremulant(trem.first));
 		if (trem.second)
 			outFile->AddLine(wxT("TremulantNumber") + GOODF_functions::number_format(counter) + wxT("=") + tremId);
 		else
@@ -95,7 +95,7 @@ void General::write(wxTextFile *outFile) {
 	outFile->AddLine(wxT("NumberOfSwitches=") + wxString::Format(wxT("%u"), nbSwitches));
 	counter = 1;
 	for (std::pair<GoSwitch*, bool> sw : m_switches) {
-		wxString switchId = GOODF_functions::number_format(::wxGetApp().m_frame->m_organ->getIndexOfOrganSwitch(sw.first));
+		wxString switchId = GOODF_functions::number_format(OrganContext::current()->getOrgan()->getIndexOfOrganSwitch(sw.first));
 		if (sw.second)
 			outFile->AddLine(wxT("SwitchNumber") + GOODF_functions::number_format(counter) + wxT("=") + switchId);
 		else
@@ -107,7 +107,7 @@ void General::write(wxTextFile *outFile) {
 	outFile->AddLine(wxT("NumberOfDivisionalCouplers=") + wxString::Format(wxT("%u"), nbDivCplrs));
 	counter = 1;
 	for (std::pair<DivisionalCoupler*, bool> divCplr : m_divisionalCouplers) {
-		wxString divCplrId = GOODF_functions::number_format(::wxGetApp().m_frame->m_organ->getIndexOfOrganDivisionalCoupler(divCplr.first));
+		wxString divCplrId = GOODF_functions::number_format(OrganContext::current()->getOrgan()->getIndexOfOrganDivisionalCoupler(divCplr.first));
 		if (divCplr.second)
 			outFile->AddLine(wxT("DivisionalCouplerNumber") + GOODF_functions::number_format(counter) + wxT("=") + divCplrId);
 		else
@@ -20,6 +20,7 @@
 
 #include "GoImage.h"
 #include "GOODFFunctions.h"
+#include "Instrumentation.h"
 #include <wx/filename.h>
 
 GoImage::GoImage() {
@@ -43,11 +44,11 @@ GoImage::~GoImage() {
 
 void GoImage::write(wxTextFile *outFile) {
 	// we need to remove base odf path from image and mask paths
-	wxString relativeFileName = getRelativeImagePath();
+	wxString relativeFileName = getRelativeImagePath(*OrganContext::current());
 	wxString fullImageLine = GOODF_functions::fixSeparator(wxT("Image=") + relativeFileName);
 	outFile->AddLine(fullImageLine);
 	if (m_maskPath != wxEmptyString) {
-		wxString relativeMaskName = getRelativeMaskPath();
+		wxString relativeMaskName = getRelativeMaskPath(*OrganContext::current());
 		wxString fullMaskLine = GOODF_functions::fixSeparator(wxT("Mask=") + relativeMaskName);
 		outFile->AddLine(fullMaskLine);
 	}
@@ -72,6 +73,7 @@ bool GoImage::read(wxFileConfig *cfg, Organ *readOrgan) {
 	wxString imgPath = GOODF_functions::checkIfFileExist(relImgPath, readOrgan);
 	if (imgPath != wxEmptyString) {
 		wxImage img = wxImage(imgPath);
+		Instrumentation::count(Instrumentation::BITMAPS_DECODED);
 		if (img.IsOk()) {
 			imageIsValid = true;
 			setImage(imgPath);
@@ -97,6 +99,7 @@ bool GoImage::read(wxFileConfig *cfg, Organ *readOrgan) {
 		wxString maskPath = GOODF_functions::checkIfFileExist(relMaskPath, readOrgan);
 		if (maskPath != wxEmptyString) {
 			wxImage mask = wxImage(maskPath);
+			Instrumentation::count(Instrumentation::BITMAPS_DECODED);
 			if (mask.IsOk()) {
 				int width = mask.GetWidth();
 				int height = mask.GetHeight();
@@ -227,16 +230,16 @@ int GoImage::getOriginalHeight() {
 	return m_imageOrginalHeight;
 }
 
-wxString GoImage::getRelativeImagePath() {
+wxString GoImage::getRelativeImagePath(OrganContext &context) {
 	if (m_imagePath != wxEmptyString)
-		return GOODF_functions::removeBaseOdfPath(m_imagePath);
+		return GOODF_functions::removeBaseOdfPath(m_imagePath, context);
 	else
 		return wxEmptyString;
 }
 
-wxString GoImage::getRelativeMaskPath() {
+wxString GoImage::getRelativeMaskPath(OrganContext &context) {
 	if (m_maskPath != wxEmptyString)
-		return GOODF_functions::removeBaseOdfPath(m_maskPath);
+		return GOODF_functions::removeBaseOdfPath(m_maskPath, context);
 	else
 		return wxEmptyString;
 }
@@ -261,12 +264,14 @@ wxString GoImage::getMaskNameOnly() {
 
 wxBitmap GoImage::getBitmap() {
 	wxImage img(m_imagePath);
+	Instrumentation::count(Instrumentation::BITMAPS_DECODED);
 	if (img.IsOk()) {
 		wxBitmap bmp;
 		if (m_maskPath == wxEmptyString) {
 			bmp = wxBitmap(m_imagePath, img.GetType());
 		} else {
 			wxImage maskImg(m_maskPath);
+			Instrumentation::count(Instrumentation::BITMAPS_DECODED);
 			if (maskImg.IsOk()) {
 				img.SetMaskFromImage(maskImg, 0xFF, 0xFF, 0xFF);
 				bmp = wxBitmap(img);
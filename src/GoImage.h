@@ -26,6 +26,7 @@
 #include <wx/fileconf.h>
 
 class Organ;
+class OrganContext;
 
 class GoImage {
 public:
@@ -60,8 +61,8 @@ public:
 	void setOriginalHeight(int height);
 	int getOriginalWidth();
 	int getOriginalHeight();
-	wxString getRelativeImagePath();
-	wxString getRelativeMaskPath();
+	wxString getRelativeImagePath(OrganContext &context);
+	wxString getRelativeMaskPath(OrganContext &context);
 	wxString getImageNameOnly();
 	wxString getMaskNameOnly();
 	wxBitmap getBitmap();
@@ -410,14 +410,14 @@ void GoImagePanel::OnRemoveImageBtn(wxCommandEvent& WXUNUSED(event)) {
 
 void GoImagePanel::UpdateControlValues() {
 	if (m_image->getImage() != wxEmptyString) {
-		m_imagePathField->SetValue(m_image->getRelativeImagePath());
+		m_imagePathField->SetValue(m_image->getRelativeImagePath(*::wxGetApp().m_frame->m_organ->getContext()));
 		m_addMaskBtn->Enable();
 	} else {
 		m_imagePathField->SetValue(wxEmptyString);
 		m_addMaskBtn->Disable();
 	}
 	if (m_image->getMask() != wxEmptyString) {
-		m_maskPathField->SetValue(m_image->getRelativeMaskPath());
+		m_maskPathField->SetValue(m_image->getRelativeMaskPath(*::wxGetApp().m_frame->m_organ->getContext()));
 	} else {
 		m_maskPathField->SetValue(wxEmptyString);
 	}
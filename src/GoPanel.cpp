@@ -99,8 +99,7 @@ void GoPanel::write(wxTextFile *outFile, unsigned panelNbr) {
 	}
 
 	if (panelNbr == 0 && nbGUIElements < 1) {
-		wxLogWarning("Nothing is displayed as a GUI Element on the main panel! Is this really intentional?");
-		::wxGetApp().m_frame->GetLogWindow()->Show(true);
+		OrganContext::current()->logWarning(wxT("Nothing is displayed as a GUI Element on the main panel! Is this really intentional?"));
 	}
 }
 
@@ -603,9 +602,9 @@ void GoPanel::removeItemFromPanel(General *general) {
 	}
 }
 
-void GoPanel::updateGuiElementsDisplayNames() {
+void GoPanel::updateGuiElementsDisplayNames(OrganContext &context) {
 	for (GUIElement* e : m_guiElements) {
-		e->updateDisplayName();
+		e->updateDisplayName(context);
 	}
 }
 
@@ -34,8 +34,10 @@
 #include "General.h"
 #include "GUIManual.h"
 #include "GUIEnclosure.h"
+#include "SectionCache.h"
 
 class Organ;
+class OrganContext;
 
 class GoPanel {
 public:
@@ -83,7 +85,7 @@ public:
 	void removeItemFromPanel(ReversiblePiston *revPist);
 	bool hasItemAsGuiElement(General *general);
 	void removeItemFromPanel(General *general);
-	void updateGuiElementsDisplayNames();
+	void updateGuiElementsDisplayNames(OrganContext &context);
 	void moveGuiElement(int sourceIndex, int toBeforeIndex);
 	void updateButtonRowsAndCols();
 	void applyButtonFontName();
@@ -100,6 +102,8 @@ public:
 	unsigned getNumberOfEnclosures();
 	GUIEnclosure* getGuiEnclosureAt(unsigned index);
 
+	SectionCache m_sectionCache;
+
 private:
 	wxString m_name;
 	wxString m_group;
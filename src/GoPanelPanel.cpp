@@ -406,68 +406,68 @@ void GoPanelPanel::OnElementChoiceBtn(wxCommandEvent& WXUNUSED(event)) {
 				if (organElement.first == wxT("Manual")) {
 					GUIElement *choice = new GUIManual(::wxGetApp().m_frame->m_organ->getOrganManualAt(organElement.second));
 					choice->setOwningPanel(m_panel);
-					choice->updateDisplayName();
+					choice->updateDisplayName(*::wxGetApp().m_frame->m_organ->getContext());
 					m_panel->addGuiElement(choice);
 					::wxGetApp().m_frame->AddGuiElementToTree(choice->getDisplayName());
 				} else if (organElement.first == wxT("Stop")) {
 					GUIElement *choice = new GUIStop(::wxGetApp().m_frame->m_organ->getOrganStopAt(organElement.second));
 					choice->setOwningPanel(m_panel);
-					choice->updateDisplayName();
+					choice->updateDisplayName(*::wxGetApp().m_frame->m_organ->getContext());
 					choice->setDefaultFont(m_panel->getDisplayMetrics()->m_dispControlLabelFont);
 					m_panel->addGuiElement(choice);
 					::wxGetApp().m_frame->AddGuiElementToTree(choice->getDisplayName());
 				} else if (organElement.first == wxT("Coupler")) {
 					GUIElement *choice = new GUICoupler(::wxGetApp().m_frame->m_organ->getOrganCouplerAt(organElement.second));
 					choice->setOwningPanel(m_panel);
-					choice->updateDisplayName();
+					choice->updateDisplayName(*::wxGetApp().m_frame->m_organ->getContext());
 					choice->setDefaultFont(m_panel->getDisplayMetrics()->m_dispControlLabelFont);
 					m_panel->addGuiElement(choice);
 					::wxGetApp().m_frame->AddGuiElementToTree(choice->getDisplayName());
 				} else if (organElement.first == wxT("Divisional")) {
 					GUIElement *choice = new GUIDivisional(::wxGetApp().m_frame->m_organ->getOrganDivisionalAt(organElement.second));
 					choice->setOwningPanel(m_panel);
-					choice->updateDisplayName();
+					choice->updateDisplayName(*::wxGetApp().m_frame->m_organ->getContext());
 					choice->setDefaultFont(m_panel->getDisplayMetrics()->m_dispControlLabelFont);
 					m_panel->addGuiElement(choice);
 					::wxGetApp().m_frame->AddGuiElementToTree(choice->getDisplayName());
 				} else if (organElement.first == wxT("Enclosure")) {
 					GUIElement *choice = new GUIEnclosure(::wxGetApp().m_frame->m_organ->getOrganEnclosureAt(organElement.second));
 					choice->setOwningPanel(m_panel);
-					choice->updateDisplayName();
+					choice->updateDisplayName(*::wxGetApp().m_frame->m_organ->getContext());
 					m_panel->addGuiElement(choice);
 					::wxGetApp().m_frame->AddGuiElementToTree(choice->getDisplayName());
 				} else if (organElement.first == wxT("Tremulant")) {
 					GUIElement *choice = new GUITremulant(::wxGetApp().m_frame->m_organ->getOrganTremulantAt(organElement.second));
 					choice->setOwningPanel(m_panel);
-					choice->updateDisplayName();
+					choice->updateDisplayName(*::wxGetApp().m_frame->m_organ->getContext());
 					choice->setDefaultFont(m_panel->getDisplayMetrics()->m_dispControlLabelFont);
 					m_panel->addGuiElement(choice);
 					::wxGetApp().m_frame->AddGuiElementToTree(choice->getDisplayName());
 				} else if (organElement.first == wxT("Switch")) {
 					GUIElement *choice = new GUISwitch(::wxGetApp().m_frame->m_organ->getOrganSwitchAt(organElement.second));
 					choice->setOwningPanel(m_panel);
-					choice->updateDisplayName();
+					choice->updateDisplayName(*::wxGetApp().m_frame->m_organ->getContext());
 					choice->setDefaultFont(m_panel->getDisplayMetrics()->m_dispControlLabelFont);
 					m_panel->addGuiElement(choice);
 					::wxGetApp().m_frame->AddGuiElementToTree(choice->getDisplayName());
 				} else if (organElement.first == wxT("ReversiblePiston")) {
 					GUIElement *choice = new GUIReversiblePiston(::wxGetApp().m_frame->m_organ->getReversiblePistonAt(organElement.second));
 					choice->setOwningPanel(m_panel);
-					choice->updateDisplayName();
+					choice->updateDisplayName(*::wxGetApp().m_frame->m_organ->getContext());
 					choice->setDefaultFont(m_panel->getDisplayMetrics()->m_dispControlLabelFont);
 					m_panel->addGuiElement(choice);
 					::wxGetApp().m_frame->AddGuiElementToTree(choice->getDisplayName());
 				} else if (organElement.first == wxT("DivisionalCoupler")) {
 					GUIElement *choice = new GUIDivisionalCoupler(::wxGetApp().m_frame->m_organ->getOrganDivisionalCouplerAt(organElement.second));
 					choice->setOwningPanel(m_panel);
-					choice->updateDisplayName();
+					choice->updateDisplayName(*::wxGetApp().m_frame->m_organ->getContext());
 					choice->setDefaultFont(m_panel->getDisplayMetrics()->m_dispControlLabelFont);
 					m_panel->addGuiElement(choice);
 					::wxGetApp().m_frame->AddGuiElementToTree(choice->getDisplayName());
 				} else if (organElement.first == wxT("General")) {
 					GUIElement *choice = new GUIGeneral(::wxGetApp().m_frame->m_organ->getOrganGeneralAt(organElement.second));
 					choice->setOwningPanel(m_panel);
-					choice->updateDisplayName();
+					choice->updateDisplayName(*::wxGetApp().m_frame->m_organ->getContext());
 					choice->setDefaultFont(m_panel->getDisplayMetrics()->m_dispControlLabelFont);
 					m_panel->addGuiElement(choice);
 					::wxGetApp().m_frame->AddGuiElementToTree(choice->getDisplayName());
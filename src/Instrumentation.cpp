@@ -0,0 +1,323 @@
+/*
+ * Instrumentation.cpp is part of GoOdf.
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * GoOdf is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GoOdf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GoOdf.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#include "Instrumentation.h"
+#include "GOODF.h"
+#include <wx/file.h>
+#include <wx/thread.h>
+#include <cstdlib>
+#include <new>
+#include <algorithm>
+#ifdef __WXMSW__
+#include <malloc.h>
+#endif
+#include <map>
+#include <string>
+
+std::atomic<bool> Instrumentation::m_enabled(false);
+std::atomic<long long> Instrumentation::m_counters[Instrumentation::NUMBER_OF_COUNTERS];
+wxString Instrumentation::m_jsonReportPath;
+
+namespace {
+
+	struct PhaseTime {
+		long long calls = 0;
+		long long totalMicroseconds = 0;
+		long long maxMicroseconds = 0;
+	};
+
+	// allocated on first use and never freed so that timers running in
+	// static destructors or worker threads never see a destroyed map
+	std::map<std::string, PhaseTime>& getPhases() {
+		static std::map<std::string, PhaseTime> *phases = new std::map<std::string, PhaseTime>();
+		return *phases;
+	}
+
+	wxCriticalSection& getPhaseLock() {
+		static wxCriticalSection *lock = new wxCriticalSection();
+		return *lock;
+	}
+
+}
+
+void Instrumentation::enable(const wxString &jsonReportPath) {
+	m_jsonReportPath = jsonReportPath;
+	for (int i = 0; i < NUMBER_OF_COUNTERS; i++)
+		m_counters[i].store(0, std::memory_order_relaxed);
+	m_enabled.store(true, std::memory_order_relaxed);
+}
+
+void Instrumentation::enableFromEnvironment() {
+	// GOODF_PROFILE=1 reports to the log window, any other value is taken as a JSON file path
+	wxString value;
+	if (!wxGetEnv(wxT("GOODF_PROFILE"), &value) || value.IsEmpty() || value.IsSameAs(wxT("0")))
+		return;
+	if (value.IsSameAs(wxT("1")))
+		enable();
+	else
+		enable(value);
+}
+
+void Instrumentation::addPhaseTime(const char *phase, long long microseconds) {
+	wxCriticalSectionLocker locker(getPhaseLock());
+	PhaseTime &time = getPhases()[phase];
+	time.calls++;
+	time.totalMicroseconds += microseconds;
+	if (microseconds > time.maxMicroseconds)
+		time.maxMicroseconds = microseconds;
+}
+
+void Instrumentation::report() {
+	if (!isEnabled())
+		return;
+
+	if (!m_jsonReportPath.IsEmpty()) {
+		if (!writeJsonReport()) {
+			wxLogWarning("Profiling report couldn't be written to %s", m_jsonReportPath);
+			::wxGetApp().m_frame->GetLogWindow()->Show(true);
+		}
+		return;
+	}
+
+	wxLogMessage("Profiling report");
+	{
+		wxCriticalSectionLocker locker(getPhaseLock());
+		for (const std::pair<const std::string, PhaseTime> &phase : getPhases()) {
+			wxLogMessage(
+				"  %s: %lld calls, %.3f ms total, %.3f ms max",
+				wxString::FromAscii(phase.first.c_str()),
+				phase.second.calls,
+				phase.second.totalMicroseconds / 1000.0,
+				phase.second.maxMicroseconds / 1000.0
+			);
+		}
+	}
+	for (int i = 0; i < NUMBER_OF_COUNTERS; i++) {
+		wxLogMessage("  %s: %lld", getCounterName((Counter) i), m_counters[i].load(std::memory_order_relaxed));
+	}
+	::wxGetApp().m_frame->GetLogWindow()->Show(true);
+}
+
+bool Instrumentation::writeJsonReport() {
+	if (!isEnabled() || m_jsonReportPath.IsEmpty())
+		return true;
+	wxFile jsonFile(m_jsonReportPath, wxFile::write);
+	return jsonFile.IsOpened() && jsonFile.Write(createJsonReport(), wxConvUTF8);
+}
+
+const char* Instrumentation::getCounterName(Counter counter) {
+	switch (counter) {
+		case FILES_STATTED:
+			return "filesStatted";
+		case DIRECTORIES_LISTED:
+			return "directoriesListed";
+		case FILES_PARSED:
+			return "filesParsed";
+		case BYTES_READ:
+			return "bytesRead";
+		case BITMAPS_DECODED:
+			return "bitmapsDecoded";
+		case LINES_WRITTEN:
+			return "linesWritten";
+		case ALLOCATIONS:
+			return "allocations";
+		case ALLOCATED_BYTES:
+			return "allocatedBytes";
+		default:
+			return "unknown";
+	}
+}
+
+wxString Instrumentation::createJsonReport() {
+	wxString json = wxT("{\n\t\"phases\": {");
+	{
+		wxCriticalSectionLocker locker(getPhaseLock());
+		bool isFirst = true;
+		for (const std::pair<const std::string, PhaseTime> &phase : getPhases()) {
+			json += isFirst ? wxT("\n") : wxT(",\n");
+			json += wxString::Format(
+				wxT("\t\t\"%s\": { \"calls\": %lld, \"totalMs\": %.3f, \"maxMs\": %.3f }"),
+				wxString::FromAscii(phase.first.c_str()),
+				phase.second.calls,
+				phase.second.totalMicroseconds / 1000.0,
+				phase.second.maxMicroseconds / 1000.0
+			);
+			isFirst = false;
+		}
+	}
+	json += wxT("\n\t},\n\t\"counters\": {");
+	for (int i = 0; i < NUMBER_OF_COUNTERS; i++) {
+		json += (i == 0) ? wxT("\n") : wxT(",\n");
+		json += wxString::Format(wxT("\t\t\"%s\": %lld"), getCounterName((Counter) i), m_counters[i].load(std::memory_order_relaxed));
+	}
+	json += wxT("\n\t}\n}\n");
+	return json;
+}
+
+#ifdef GOODF_COUNT_ALLOCATIONS
+// Counting replacements of all the global allocation functions, only built
+// with the GOODF_COUNT_ALLOCATIONS CMake option since they add an atomic
+// check to every allocation of the program.
+namespace {
+
+	void* allocate(std::size_t size) {
+		Instrumentation::count(Instrumentation::ALLOCATIONS);
+		Instrumentation::count(Instrumentation::ALLOCATED_BYTES, (long long) size);
+		if (!size)
+			size = 1;
+		void *ptr;
+		while (!(ptr = std::malloc(size))) {
+			std::new_handler handler = std::get_new_handler();
+			if (!handler)
+				throw std::bad_alloc();
+			handler();
+		}
+		return ptr;
+	}
+
+	void* allocateAligned(std::size_t size, std::align_val_t alignment) {
+		Instrumentation::count(Instrumentation::ALLOCATIONS);
+		Instrumentation::count(Instrumentation::ALLOCATED_BYTES, (long long) size);
+		std::size_t align = std::max((std::size_t) alignment, sizeof(void*));
+		if (!size)
+			size = 1;
+		void *ptr;
+		while (true) {
+#ifdef __WXMSW__
+			ptr = _aligned_malloc(size, align);
+#else
+			if (posix_memalign(&ptr, align, size))
+				ptr = NULL;
+#endif
+			if (ptr)
+				return ptr;
+			std::new_handler handler = std::get_new_handler();
+			if (!handler)
+				throw std::bad_alloc();
+			handler();
+		}
+	}
+
+	void freeAligned(void *ptr) {
+#ifdef __WXMSW__
+		_aligned_free(ptr);
+#else
+		std::free(ptr);
+#endif
+	}
+
+}
+
+void* operator new(std::size_t size) {
+	return allocate(size);
+}
+
+void* operator new[](std::size_t size) {
+	return allocate(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+	try {
+		return allocate(size);
+	} catch (...) {
+		return NULL;
+	}
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+	try {
+		return allocate(size);
+	} catch (...) {
+		return NULL;
+	}
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+	return allocateAligned(size, alignment);
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+	return allocateAligned(size, alignment);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+	try {
+		return allocateAligned(size, alignment);
+	} catch (...) {
+		return NULL;
+	}
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+	try {
+		return allocateAligned(size, alignment);
+	} catch (...) {
+		return NULL;
+	}
+}
+
+void operator delete(void *ptr) noexcept {
+	std::free(ptr);
+}
+
+void operator delete[](void *ptr) noexcept {
+	std::free(ptr);
+}
+
+void operator delete(void *ptr, const std::nothrow_t&) noexcept {
+	std::free(ptr);
+}
+
+void operator delete[](void *ptr, const std::nothrow_t&) noexcept {
+	std::free(ptr);
+}
+
+void operator delete(void *ptr, std::size_t) noexcept {
+	std::free(ptr);
+}
+
+void operator delete[](void *ptr, std::size_t) noexcept {
+	std::free(ptr);
+}
+
+void operator delete(void *ptr, std::align_val_t) noexcept {
+	freeAligned(ptr);
+}
+
+void operator delete[](void *ptr, std::align_val_t) noexcept {
+	freeAligned(ptr);
+}
+
+void operator delete(void *ptr, std::align_val_t, const std::nothrow_t&) noexcept {
+	freeAligned(ptr);
+}
+
+void operator delete[](void *ptr, std::align_val_t, const std::nothrow_t&) noexcept {
+	freeAligned(ptr);
+}
+
+void operator delete(void *ptr, std::size_t, std::align_val_t) noexcept {
+	freeAligned(ptr);
+}
+
+void operator delete[](void *ptr, std::size_t, std::align_val_t) noexcept {
+	freeAligned(ptr);
+}
+#endif
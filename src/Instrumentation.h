@@ -0,0 +1,94 @@
+/*
+ * Instrumentation.h is part of GoOdf.
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * GoOdf is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GoOdf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GoOdf.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#ifndef INSTRUMENTATION_H
+#define INSTRUMENTATION_H
+
+#include <wx/wx.h>
+#include <atomic>
+#include <chrono>
+
+// Built-in profiling of where the time goes when loading, saving, scanning
+// for samples and rendering panels. Everything is a no-op until enabled with
+// the --profile[=file.json] command line switch or the GOODF_PROFILE
+// environment variable. The report goes to the log window, or to a JSON
+// file if one was given.
+class Instrumentation {
+public:
+	enum Counter {
+		FILES_STATTED,
+		DIRECTORIES_LISTED,
+		FILES_PARSED,
+		BYTES_READ,
+		BITMAPS_DECODED,
+		LINES_WRITTEN,
+		ALLOCATIONS,
+		ALLOCATED_BYTES,
+		NUMBER_OF_COUNTERS
+	};
+
+	static void enable(const wxString &jsonReportPath = wxEmptyString);
+	static void enableFromEnvironment();
+	static inline bool isEnabled() {
+		return m_enabled.load(std::memory_order_relaxed);
+	}
+	static inline void count(Counter counter, long long amount = 1) {
+		if (isEnabled())
+			m_counters[counter].fetch_add(amount, std::memory_order_relaxed);
+	}
+	static void addPhaseTime(const char *phase, long long microseconds);
+	static void report();
+	static bool writeJsonReport();
+
+private:
+	static std::atomic<bool> m_enabled;
+	static std::atomic<long long> m_counters[NUMBER_OF_COUNTERS];
+	static wxString m_jsonReportPath;
+
+	static const char* getCounterName(Counter counter);
+	static wxString createJsonReport();
+
+};
+
+// Adds the time from construction to destruction to the named phase.
+// The phase name must be a string literal or otherwise outlive the report.
+class ScopedTimer {
+public:
+	ScopedTimer(const char *phase) : m_phase(phase), m_active(Instrumentation::isEnabled()) {
+		if (m_active)
+			m_start = std::chrono::steady_clock::now();
+	}
+	~ScopedTimer() {
+		if (m_active) {
+			std::chrono::steady_clock::duration elapsed = std::chrono::steady_clock::now() - m_start;
+			Instrumentation::addPhaseTime(m_phase, std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count());
+		}
+	}
+
+private:
+	const char *m_phase;
+	bool m_active;
+	std::chrono::steady_clock::time_point m_start;
+
+	ScopedTimer(const ScopedTimer&) = delete;
+	ScopedTimer& operator=(const ScopedTimer&) = delete;
+};
+
+#endif
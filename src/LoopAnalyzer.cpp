@@ -0,0 +1,225 @@
+/*
+ * LoopAnalyzer.cpp is part of GoOdf.
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * GoOdf is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GoOdf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GoOdf.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#include "LoopAnalyzer.h"
+#include "Rank.h"
+#include "SampleReader.h"
+#include "SignalKernels.h"
+#include "WAVfileParser.h"
+#include "WorkerPool.h"
+#include "Instrumentation.h"
+#include "GOODFFunctions.h"
+#include <algorithm>
+#include <cmath>
+
+// frames compared on each side of a loop join
+static const unsigned JOIN_WINDOW = 512;
+
+// what counts as a click on its own; the score is the largest share of these
+static const float CLICK_AMPLITUDE_JUMP = 0.5f;
+static const float CLICK_SLOPE_JUMP = 1.0f;
+static const float CLICK_DECORRELATION = 0.1f;
+static const float AUDIBLE_SCORE = 0.2f;
+// loops outside of the sample sort before everything else
+static const float INVALID_LOOP_SCORE = 1000.0f;
+
+float LoopAnalyzer::ATTACK_RESULT::getWorstScore() const {
+	float worst = 0;
+	for (const LOOP_QUALITY &loop : loops)
+		worst = std::max(worst, loop.isValid ? loop.score : INVALID_LOOP_SCORE);
+	return worst;
+}
+
+wxString LoopAnalyzer::ATTACK_RESULT::getSummary() const {
+	if (!errorMessage.IsEmpty())
+		return wxT("loops not checked");
+	if (loops.empty())
+		return wxT("no loops");
+	unsigned invalid = 0;
+	unsigned worstLoop = 0;
+	for (unsigned i = 0; i < loops.size(); i++) {
+		if (!loops[i].isValid)
+			invalid++;
+		else if (!loops[worstLoop].isValid || loops[i].score > loops[worstLoop].score)
+			worstLoop = i;
+	}
+	if (invalid)
+		return wxString::Format(wxT("%u invalid loop(s)"), invalid);
+	return wxString::Format(
+		wxT("%u loop(s), worst %s (%.2f)"),
+		(unsigned) loops.size(),
+		describeGrade(loops[worstLoop].grade),
+		loops[worstLoop].score
+	);
+}
+
+bool LoopAnalyzer::analyzeAttack(const Attack &atk, std::vector<LOOP_QUALITY> &loops, wxString &errorMessage) {
+	std::vector<std::pair<unsigned, unsigned>> attackLoops;
+	for (const Loop &loop : atk.m_loops)
+		attackLoops.push_back(std::make_pair((unsigned) loop.start, (unsigned) loop.end));
+	return analyzeFile(atk.fullPath, attackLoops, loops, errorMessage);
+}
+
+LoopAnalyzer::LOOP_QUALITY LoopAnalyzer::analyzeLoop(SampleReader &reader, unsigned start, unsigned end) {
+	LOOP_QUALITY quality;
+	quality.start = start;
+	quality.end = end;
+	quality.isValid = false;
+	quality.amplitudeJump = 0;
+	quality.slopeJump = 0;
+	quality.correlation = 1;
+	quality.score = 0;
+	quality.grade = LOOP_GOOD;
+	if (start < 2 || end <= start || end >= reader.getNumberOfFrames())
+		return quality;
+
+	// The window leading into the end (last frame played before the jump)
+	// is compared to the one leading into the start (the frame before it)
+	unsigned window = std::min(JOIN_WINDOW, start);
+	window = std::min(window, end - start);
+	if (window < 2)
+		return quality;
+	std::vector<float> endFrames;
+	std::vector<float> startFrames;
+	if (!reader.readRange(end + 1 - window, end + 1, endFrames) || !reader.readRange(start - window, start, startFrames))
+		return quality;
+	quality.isValid = true;
+
+	unsigned channels = reader.getNumberOfChannels();
+	std::vector<float> endWindow(window);
+	std::vector<float> startWindow(window);
+	for (unsigned c = 0; c < channels; c++) {
+		SignalKernels::extractChannel(endFrames.data(), channels, c, endWindow.data(), window);
+		SignalKernels::extractChannel(startFrames.data(), channels, c, startWindow.data(), window);
+
+		float endEnergy = SignalKernels::sumOfSquares(endWindow.data(), window);
+		float startEnergy = SignalKernels::sumOfSquares(startWindow.data(), window);
+		float rms = std::sqrt((endEnergy + startEnergy) / (2 * window));
+		if (rms < 1e-6f)
+			continue; // silence joins silently
+
+		float correlation = SignalKernels::dotProduct(endWindow.data(), startWindow.data(), window) / std::sqrt(endEnergy * startEnergy + 1e-20f);
+		float amplitudeJump = std::fabs(endWindow[window - 1] - startWindow[window - 1]) / rms;
+		float endSlope = endWindow[window - 1] - endWindow[window - 2];
+		float startSlope = startWindow[window - 1] - startWindow[window - 2];
+		// the slope is compared to the typical slope of the windows
+		float slopeRms = std::sqrt(
+			(SignalKernels::squaredDistance(endWindow.data() + 1, endWindow.data(), window - 1) +
+			SignalKernels::squaredDistance(startWindow.data() + 1, startWindow.data(), window - 1)) / (2 * (window - 1))
+		);
+		float slopeJump = std::fabs(endSlope - startSlope) / std::max(slopeRms, 1e-6f);
+
+		quality.amplitudeJump = std::max(quality.amplitudeJump, amplitudeJump);
+		quality.slopeJump = std::max(quality.slopeJump, slopeJump);
+		quality.correlation = std::min(quality.correlation, correlation);
+	}
+
+	quality.score = std::max(
+		std::max(quality.amplitudeJump / CLICK_AMPLITUDE_JUMP, quality.slopeJump / CLICK_SLOPE_JUMP),
+		(1 - quality.correlation) / CLICK_DECORRELATION
+	);
+	if (quality.score >= 1)
+		quality.grade = LOOP_CLICK;
+	else if (quality.score >= AUDIBLE_SCORE)
+		quality.grade = LOOP_AUDIBLE;
+	else
+		quality.grade = LOOP_GOOD;
+	return quality;
+}
+
+bool LoopAnalyzer::analyzeRanks(
+	const std::vector<std::pair<Rank*, wxString>> &ranks,
+	std::vector<ATTACK_RESULT> &results,
+	const std::function<bool(size_t, size_t)> &progress
+) {
+	ScopedTimer timer("analysis.loopQuality");
+	results.clear();
+
+	// the attacks are copied so that the workers never touch the organ
+	std::vector<std::vector<std::pair<unsigned, unsigned>>> attackLoops;
+	std::vector<wxString> paths;
+	for (const std::pair<Rank*, wxString> &rank : ranks) {
+		rank.first->loadPipes();
+		unsigned pipeIndex = 0;
+		for (Pipe &pipe : rank.first->m_pipes) {
+			unsigned attackIndex = 0;
+			for (Attack &atk : pipe.m_attacks) {
+				if (GOODF_functions::isSampleFilePath(atk.fullPath)) {
+					ATTACK_RESULT result;
+					result.rank = rank.first;
+					result.rankName = rank.second;
+					result.pipeIndex = pipeIndex;
+					result.attackIndex = attackIndex;
+					result.fileName = atk.fileName;
+					results.push_back(result);
+					paths.push_back(atk.fullPath);
+					std::vector<std::pair<unsigned, unsigned>> loops;
+					for (Loop &loop : atk.m_loops)
+						loops.push_back(std::make_pair((unsigned) loop.start, (unsigned) loop.end));
+					attackLoops.push_back(loops);
+				}
+				attackIndex++;
+			}
+			pipeIndex++;
+		}
+	}
+
+	size_t total = results.size();
+	return WorkerPool::run(
+		results.size(),
+		[&](size_t index) { analyzeFile(paths[index], attackLoops[index], results[index].loops, results[index].errorMessage); },
+		[&](size_t done) { return !progress || progress(done, total); }
+	);
+}
+
+wxString LoopAnalyzer::describeGrade(LOOP_GRADE grade) {
+	switch (grade) {
+		case LOOP_GOOD:
+			return wxT("good");
+		case LOOP_AUDIBLE:
+			return wxT("may be audible");
+		case LOOP_CLICK:
+			return wxT("likely click");
+	}
+	return wxEmptyString;
+}
+
+bool LoopAnalyzer::analyzeFile(const wxString &path, const std::vector<std::pair<unsigned, unsigned>> &attackLoops, std::vector<LOOP_QUALITY> &loops, wxString &errorMessage) {
+	loops.clear();
+	std::vector<std::pair<unsigned, unsigned>> toCheck = attackLoops;
+	if (toCheck.empty()) {
+		WAVfileParser sample(path);
+		for (unsigned i = 0; i < sample.getNumberOfLoops(); i++) {
+			LOOP loop = sample.getLoopAtIndex(i);
+			toCheck.push_back(std::make_pair(loop.dwStart, loop.dwEnd));
+		}
+	}
+	if (toCheck.empty())
+		return true;
+
+	SampleReader reader(path);
+	if (!reader.isOk()) {
+		errorMessage = reader.getErrorMessage();
+		return false;
+	}
+	for (std::pair<unsigned, unsigned> &loop : toCheck)
+		loops.push_back(analyzeLoop(reader, loop.first, loop.second));
+	return true;
+}
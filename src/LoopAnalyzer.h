@@ -0,0 +1,87 @@
+/*
+ * LoopAnalyzer.h is part of GoOdf.
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * GoOdf is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GoOdf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GoOdf.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#ifndef LOOPANALYZER_H
+#define LOOPANALYZER_H
+
+#include <wx/wx.h>
+#include <vector>
+#include <functional>
+
+class Rank;
+class Attack;
+class SampleReader;
+
+// Scores how smoothly the audio continues where each loop of an attack
+// jumps from its end back to its start. Only a short window on each side
+// of the join is read, comparing the level, the slope and the shape
+// (normalized cross-correlation) of the audio leading into the end with
+// that leading into the start, which is what a seamless loop would play.
+class LoopAnalyzer {
+public:
+	enum LOOP_GRADE {
+		LOOP_GOOD = 0,
+		LOOP_AUDIBLE,
+		LOOP_CLICK
+	};
+
+	struct LOOP_QUALITY {
+		unsigned start;
+		unsigned end;
+		bool isValid;
+		// jumps relative to the level of the audio around the join
+		float amplitudeJump;
+		float slopeJump;
+		float correlation;
+		// 1 or more is likely to be heard as a click
+		float score;
+		LOOP_GRADE grade;
+	};
+
+	struct ATTACK_RESULT {
+		Rank *rank;
+		wxString rankName;
+		unsigned pipeIndex;
+		unsigned attackIndex;
+		wxString fileName;
+		std::vector<LOOP_QUALITY> loops;
+		wxString errorMessage;
+
+		float getWorstScore() const;
+		wxString getSummary() const;
+	};
+
+	// The loops of the attack, or those of the sample file if it has none
+	static bool analyzeAttack(const Attack &atk, std::vector<LOOP_QUALITY> &loops, wxString &errorMessage);
+	static LOOP_QUALITY analyzeLoop(SampleReader &reader, unsigned start, unsigned end);
+	// Analyzes every attack of the ranks on the worker pool. The progress
+	// gets the number of analyzed attacks and their total.
+	static bool analyzeRanks(
+		const std::vector<std::pair<Rank*, wxString>> &ranks,
+		std::vector<ATTACK_RESULT> &results,
+		const std::function<bool(size_t, size_t)> &progress = nullptr
+	);
+	static wxString describeGrade(LOOP_GRADE grade);
+
+private:
+	static bool analyzeFile(const wxString &path, const std::vector<std::pair<unsigned, unsigned>> &attackLoops, std::vector<LOOP_QUALITY> &loops, wxString &errorMessage);
+};
+
+#endif
@@ -0,0 +1,250 @@
+/*
+ * LoopFinder.cpp is part of GoOdf.
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * GoOdf is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GoOdf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GoOdf.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#include "LoopFinder.h"
+#include "LoopAnalyzer.h"
+#include "FFT.h"
+#include "Rank.h"
+#include "SampleReader.h"
+#include "SignalKernels.h"
+#include "WAVfileParser.h"
+#include "WorkerPool.h"
+#include "Instrumentation.h"
+#include "GOODFFunctions.h"
+#include <algorithm>
+#include <cmath>
+
+// frames of audio leading into a loop end that are matched
+static const unsigned TEMPLATE_LENGTH = 4096;
+// at most this much of the sustain is searched, to bound the memory use
+static const unsigned MAX_SEARCH_LENGTH = 1 << 20;
+static const unsigned NUMBER_OF_ENDS = 6;
+static const unsigned PEAKS_PER_END = 4;
+static const float MIN_CORRELATION = 0.8f;
+static const int FINE_TUNING_RANGE = 3;
+
+namespace {
+
+	// how well the frames before start continue into end, in a mono buffer
+	float joinError(const std::vector<float> &audio, unsigned start, unsigned end) {
+		float level = std::fabs(audio[start - 1] - audio[end]);
+		float slope = std::fabs((audio[start - 1] - audio[start - 2]) - (audio[end] - audio[end - 1]));
+		return level + slope;
+	}
+
+}
+
+bool LoopFinder::findLoops(const wxString &path, unsigned numberOfCandidates, std::vector<LOOP_CANDIDATE> &candidates, wxString &errorMessage) {
+	candidates.clear();
+	SampleReader reader(path);
+	if (!reader.isOk()) {
+		errorMessage = reader.getErrorMessage();
+		return false;
+	}
+	unsigned frames = reader.getNumberOfFrames();
+	unsigned sampleRate = reader.getSampleRate();
+
+	// The sustain starts after the attack transient and ends where the
+	// release does, if the sample has a release marker
+	WAVfileParser sample(path);
+	unsigned sustainEnd = frames;
+	if (sample.getNumberOfCues() > 0 && sample.getCuepointAtIndex(0).dwSampleOffset > 0)
+		sustainEnd = std::min(frames, (unsigned) sample.getCuepointAtIndex(0).dwSampleOffset);
+	sustainEnd = sustainEnd > sampleRate / 20 ? sustainEnd - sampleRate / 20 : sustainEnd;
+	unsigned sustainStart = std::min(sampleRate, sustainEnd / 4);
+	if (sustainEnd - sustainStart > MAX_SEARCH_LENGTH)
+		sustainStart = sustainEnd - MAX_SEARCH_LENGTH;
+	unsigned length = sustainEnd - sustainStart;
+	unsigned templateLength = std::min(TEMPLATE_LENGTH, length / 8);
+	if (templateLength < 64) {
+		errorMessage = wxT("The sample is too short to find loops in.\n");
+		return false;
+	}
+	unsigned minLoopLength = std::min(sampleRate / 2, length / 4);
+
+	std::vector<float> interleaved;
+	if (!reader.readRange(sustainStart, sustainEnd, interleaved)) {
+		errorMessage = wxT("Couldn't read the audio of the sample.\n");
+		return false;
+	}
+	std::vector<float> audio(length);
+	SignalKernels::mixToMono(interleaved.data(), reader.getNumberOfChannels(), audio.data(), length);
+	std::vector<float>().swap(interleaved);
+
+	// energy of every window for normalizing the correlation
+	std::vector<double> energyBefore(length + 1, 0.0);
+	for (unsigned i = 0; i < length; i++)
+		energyBefore[i + 1] = energyBefore[i] + (double) audio[i] * audio[i];
+
+	FFT fft(length + templateLength);
+	std::vector<std::complex<float>> audioSpectrum(audio.begin(), audio.end());
+	fft.transform(audioSpectrum);
+
+	std::vector<LOOP_CANDIDATE> found;
+	std::vector<std::complex<float>> correlation;
+	for (unsigned e = 0; e < NUMBER_OF_ENDS; e++) {
+		// ends spread over the last third of the sustain, moved to a rising zero crossing
+		unsigned end = length - 2 - (length / 3) * e / NUMBER_OF_ENDS;
+		while (end + 1 < length && !(audio[end] <= 0 && audio[end + 1] > 0))
+			end++;
+		if (end + 1 >= length || end + 1 < templateLength + minLoopLength + templateLength)
+			continue;
+
+		const float *templ = &audio[end + 1 - templateLength];
+		double templateEnergy = energyBefore[end + 1] - energyBefore[end + 1 - templateLength];
+		if (templateEnergy <= 0)
+			continue;
+		correlation.assign(fft.getSize(), std::complex<float>(0, 0));
+		for (unsigned i = 0; i < templateLength; i++)
+			correlation[i] = templ[i];
+		fft.transform(correlation);
+		for (unsigned i = 0; i < fft.getSize(); i++)
+			correlation[i] = audioSpectrum[i] * std::conj(correlation[i]);
+		fft.transform(correlation, true);
+
+		// window p precedes the loop start p + templateLength
+		unsigned lastWindow = end + 1 - minLoopLength - templateLength;
+		std::vector<std::pair<float, unsigned>> peaks;
+		float previous = 0;
+		float current = 0;
+		for (unsigned p = 0; p <= lastWindow; p++) {
+			double windowEnergy = energyBefore[p + templateLength] - energyBefore[p];
+			float next = windowEnergy > 0 ? (float) (correlation[p].real() / std::sqrt(templateEnergy * windowEnergy)) : 0;
+			if (p >= 2 && current >= previous && current > next && current >= MIN_CORRELATION)
+				peaks.push_back(std::make_pair(current, p - 1));
+			previous = current;
+			current = next;
+		}
+		std::sort(peaks.begin(), peaks.end(), [](const std::pair<float, unsigned> &a, const std::pair<float, unsigned> &b) {
+			return a.first > b.first;
+		});
+
+		unsigned kept = 0;
+		std::vector<unsigned> keptStarts;
+		for (std::pair<float, unsigned> &peak : peaks) {
+			if (kept == PEAKS_PER_END)
+				break;
+			unsigned start = peak.second + templateLength;
+			bool tooClose = false;
+			for (unsigned other : keptStarts) {
+				if ((start > other ? start - other : other - start) < templateLength / 2)
+					tooClose = true;
+			}
+			if (tooClose)
+				continue;
+
+			// the phase is matched on the sample level
+			unsigned bestStart = start;
+			float bestError = joinError(audio, start, end);
+			for (int offset = -FINE_TUNING_RANGE; offset <= FINE_TUNING_RANGE; offset++) {
+				int tried = (int) start + offset;
+				if (tried < 2 || (unsigned) tried + minLoopLength > end)
+					continue;
+				float error = joinError(audio, tried, end);
+				if (error < bestError) {
+					bestError = error;
+					bestStart = tried;
+				}
+			}
+
+			LOOP_CANDIDATE candidate;
+			candidate.start = sustainStart + bestStart;
+			candidate.end = sustainStart + end;
+			candidate.correlation = peak.first;
+			candidate.score = LoopAnalyzer::analyzeLoop(reader, candidate.start, candidate.end).score;
+			found.push_back(candidate);
+			keptStarts.push_back(start);
+			kept++;
+		}
+	}
+
+	std::sort(found.begin(), found.end(), [](const LOOP_CANDIDATE &a, const LOOP_CANDIDATE &b) {
+		if (a.score != b.score)
+			return a.score < b.score;
+		return a.correlation > b.correlation;
+	});
+	for (LOOP_CANDIDATE &candidate : found) {
+		if (candidates.size() == numberOfCandidates)
+			break;
+		candidates.push_back(candidate);
+	}
+	if (candidates.empty()) {
+		errorMessage = wxT("No good loop was found in the sustain.\n");
+		return false;
+	}
+	return true;
+}
+
+bool LoopFinder::findRankLoops(
+	Rank *rank,
+	unsigned numberOfCandidates,
+	bool onlyUnlooped,
+	std::vector<ATTACK_CANDIDATES> &results,
+	const std::function<bool(size_t, size_t)> &progress
+) {
+	ScopedTimer timer("analysis.findLoops");
+	results.clear();
+	rank->loadPipes();
+
+	std::vector<wxString> paths;
+	unsigned pipeIndex = 0;
+	for (Pipe &pipe : rank->m_pipes) {
+		unsigned attackIndex = 0;
+		for (Attack &atk : pipe.m_attacks) {
+			if (GOODF_functions::isSampleFilePath(atk.fullPath) &&
+				!(onlyUnlooped && !atk.m_loops.empty())
+			) {
+				ATTACK_CANDIDATES result;
+				result.pipeIndex = pipeIndex;
+				result.attackIndex = attackIndex;
+				results.push_back(result);
+				paths.push_back(atk.fullPath);
+			}
+			attackIndex++;
+		}
+		pipeIndex++;
+	}
+
+	size_t total = paths.size();
+	return WorkerPool::run(
+		paths.size(),
+		[&](size_t index) {
+			if (onlyUnlooped) {
+				WAVfileParser sample(paths[index]);
+				if (sample.getNumberOfLoops() > 0)
+					return;
+			}
+			findLoops(paths[index], numberOfCandidates, results[index].candidates, results[index].errorMessage);
+		},
+		[&](size_t done) { return !progress || progress(done, total); }
+	);
+}
+
+wxString LoopFinder::describeCandidate(const LOOP_CANDIDATE &candidate, unsigned sampleRate) {
+	return wxString::Format(
+		wxT("%u - %u (%.2f s), correlation %.3f, %s (%.2f)"),
+		candidate.start,
+		candidate.end,
+		sampleRate ? (candidate.end - candidate.start + 1) / (double) sampleRate : 0.0,
+		candidate.correlation,
+		LoopAnalyzer::describeGrade(candidate.score >= 1 ? LoopAnalyzer::LOOP_CLICK : (candidate.score >= 0.2f ? LoopAnalyzer::LOOP_AUDIBLE : LoopAnalyzer::LOOP_GOOD)),
+		candidate.score
+	);
+}
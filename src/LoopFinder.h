@@ -0,0 +1,66 @@
+/*
+ * LoopFinder.h is part of GoOdf.
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * GoOdf is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GoOdf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GoOdf.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#ifndef LOOPFINDER_H
+#define LOOPFINDER_H
+
+#include <wx/wx.h>
+#include <vector>
+#include <functional>
+
+class Rank;
+
+// Searches the sustain of an attack for loop points. For a few loop ends
+// at rising zero crossings near the end of the sustain, the audio leading
+// into the end is cross-correlated (with FFTs) against the whole sustain,
+// and the best matching starts are then fine tuned to match the level and
+// slope at the join and scored like the loop check does.
+class LoopFinder {
+public:
+	struct LOOP_CANDIDATE {
+		unsigned start;
+		unsigned end;
+		float correlation;
+		// as LoopAnalyzer scores it, lower is better
+		float score;
+	};
+
+	struct ATTACK_CANDIDATES {
+		unsigned pipeIndex;
+		unsigned attackIndex;
+		std::vector<LOOP_CANDIDATE> candidates;
+		wxString errorMessage;
+	};
+
+	// The best candidates first
+	static bool findLoops(const wxString &path, unsigned numberOfCandidates, std::vector<LOOP_CANDIDATE> &candidates, wxString &errorMessage);
+	// Searches all attacks of the rank on the worker pool, with onlyUnlooped
+	// only those that have loops neither in the ODF nor in the sample
+	static bool findRankLoops(
+		Rank *rank,
+		unsigned numberOfCandidates,
+		bool onlyUnlooped,
+		std::vector<ATTACK_CANDIDATES> &results,
+		const std::function<bool(size_t, size_t)> &progress = nullptr
+	);
+	static wxString describeCandidate(const LOOP_CANDIDATE &candidate, unsigned sampleRate);
+};
+
+#endif
@@ -0,0 +1,141 @@
+/*
+ * LoopQualityDialog.cpp is part of GoOdf.
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * GoOdf is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GoOdf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GoOdf. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#include "LoopQualityDialog.h"
+#include "GOODFDef.h"
+#include "GOODFFunctions.h"
+#include <wx/statline.h>
+#include <algorithm>
+
+IMPLEMENT_CLASS(LoopQualityDialog, wxDialog)
+
+LoopQualityDialog::LoopQualityDialog(const std::vector<LoopAnalyzer::ATTACK_RESULT> &results) {
+	Init(results);
+}
+
+LoopQualityDialog::LoopQualityDialog(
+	const std::vector<LoopAnalyzer::ATTACK_RESULT> &results,
+	wxWindow* parent,
+	wxWindowID id,
+	const wxString& caption,
+	const wxPoint& pos,
+	const wxSize& size,
+	long style
+) {
+	Init(results);
+	Create(parent, id, caption, pos, size, style);
+}
+
+LoopQualityDialog::~LoopQualityDialog() {
+
+}
+
+void LoopQualityDialog::Init(const std::vector<LoopAnalyzer::ATTACK_RESULT> &results) {
+	// attacks without loops have nothing to report, the rest come worst first
+	for (const LoopAnalyzer::ATTACK_RESULT &result : results) {
+		if (!result.loops.empty() || !result.errorMessage.IsEmpty())
+			m_results.push_back(&result);
+	}
+	std::stable_sort(m_results.begin(), m_results.end(), [](const LoopAnalyzer::ATTACK_RESULT *a, const LoopAnalyzer::ATTACK_RESULT *b) {
+		return a->getWorstScore() > b->getWorstScore();
+	});
+}
+
+bool LoopQualityDialog::Create(
+	wxWindow* parent,
+	wxWindowID id,
+	const wxString& caption,
+	const wxPoint& pos,
+	const wxSize& size,
+	long style
+) {
+	if (!wxDialog::Create(parent, id, caption, pos, size, style))
+		return false;
+
+	CreateControls();
+	FillList();
+
+	GetSizer()->Fit(this);
+	GetSizer()->SetSizeHints(this);
+	Centre();
+
+	return true;
+}
+
+void LoopQualityDialog::CreateControls() {
+	wxBoxSizer *mainSizer = new wxBoxSizer(wxVERTICAL);
+
+	unsigned clicks = 0;
+	for (const LoopAnalyzer::ATTACK_RESULT *result : m_results) {
+		if (result->getWorstScore() >= 1)
+			clicks++;
+	}
+	wxStaticText *summaryText = new wxStaticText (
+		this,
+		wxID_STATIC,
+		wxString::Format(wxT("%u of %u looped attacks have a loop that is likely to click or couldn't be checked."), clicks, (unsigned) m_results.size())
+	);
+	mainSizer->Add(summaryText, 0, wxALL, 5);
+
+	m_resultList = new wxListCtrl(
+		this,
+		ID_LOOP_QUALITY_LIST,
+		wxDefaultPosition,
+		wxSize(860, 400),
+		wxLC_REPORT|wxLC_SINGLE_SEL
+	);
+	m_resultList->AppendColumn(wxT("Rank"), wxLIST_FORMAT_LEFT, 200);
+	m_resultList->AppendColumn(wxT("Pipe"), wxLIST_FORMAT_RIGHT, 60);
+	m_resultList->AppendColumn(wxT("Attack"), wxLIST_FORMAT_LEFT, 260);
+	m_resultList->AppendColumn(wxT("Result"), wxLIST_FORMAT_LEFT, 240);
+	m_resultList->AppendColumn(wxT("Score"), wxLIST_FORMAT_RIGHT, 80);
+	mainSizer->Add(m_resultList, 1, wxEXPAND|wxALL, 5);
+
+	wxStaticLine *bottomDivider = new wxStaticLine(this);
+	mainSizer->Add(bottomDivider, 0, wxEXPAND);
+
+	wxBoxSizer *bottomRow = new wxBoxSizer(wxHORIZONTAL);
+	bottomRow->AddStretchSpacer();
+	wxButton *theCloseButton = new wxButton(
+		this,
+		wxID_CANCEL,
+		wxT("Close")
+	);
+	bottomRow->Add(theCloseButton, 0, wxALIGN_CENTER|wxALL, 10);
+	bottomRow->AddStretchSpacer();
+	mainSizer->Add(bottomRow, 0, wxGROW);
+
+	SetSizer(mainSizer);
+}
+
+void LoopQualityDialog::FillList() {
+	for (unsigned i = 0; i < m_results.size(); i++) {
+		const LoopAnalyzer::ATTACK_RESULT *result = m_results[i];
+		m_resultList->InsertItem(i, result->rankName);
+		m_resultList->SetItem(i, 1, GOODF_functions::number_format(result->pipeIndex + 1));
+		m_resultList->SetItem(i, 2, result->fileName);
+		if (result->errorMessage.IsEmpty()) {
+			m_resultList->SetItem(i, 3, result->getSummary());
+			m_resultList->SetItem(i, 4, wxString::Format(wxT("%.2f"), result->getWorstScore()));
+		} else {
+			m_resultList->SetItem(i, 3, result->errorMessage.Strip(wxString::both));
+		}
+	}
+}
@@ -0,0 +1,70 @@
+/*
+ * LoopQualityDialog.h is part of GoOdf.
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * GoOdf is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GoOdf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GoOdf. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#ifndef LOOPQUALITYDIALOG_H
+#define LOOPQUALITYDIALOG_H
+
+#include <wx/wx.h>
+#include <wx/listctrl.h>
+#include "LoopAnalyzer.h"
+
+class LoopQualityDialog : public wxDialog {
+	DECLARE_CLASS(LoopQualityDialog)
+
+public:
+	// Constructors
+	LoopQualityDialog(const std::vector<LoopAnalyzer::ATTACK_RESULT> &results);
+	LoopQualityDialog(
+		const std::vector<LoopAnalyzer::ATTACK_RESULT> &results,
+		wxWindow* parent,
+		wxWindowID id = wxID_ANY,
+		const wxString& caption = wxT("Loop quality report"),
+		const wxPoint& pos = wxDefaultPosition,
+		const wxSize& size = wxDefaultSize,
+		long style = wxCAPTION|wxRESIZE_BORDER|wxSYSTEM_MENU|wxCLOSE_BOX
+	);
+
+	~LoopQualityDialog();
+
+	// Initialize our variables
+	void Init(const std::vector<LoopAnalyzer::ATTACK_RESULT> &results);
+
+	// Creation
+	bool Create(
+		wxWindow* parent,
+		wxWindowID id = wxID_ANY,
+		const wxString& caption = wxT("Loop quality report"),
+		const wxPoint& pos = wxDefaultPosition,
+		const wxSize& size = wxDefaultSize,
+		long style = wxCAPTION|wxRESIZE_BORDER|wxSYSTEM_MENU|wxCLOSE_BOX
+	);
+
+	// Creates the controls and sizers
+	void CreateControls();
+
+private:
+	std::vector<const LoopAnalyzer::ATTACK_RESULT*> m_results;
+
+	wxListCtrl *m_resultList;
+
+	void FillList();
+};
+
+#endif
@@ -0,0 +1,325 @@
+/*
+ * LoudnessAnalyzer.cpp is part of GoOdf.
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * GoOdf is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GoOdf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GoOdf.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#include "LoudnessAnalyzer.h"
+#include "Rank.h"
+#include "SampleReader.h"
+#include "WAVfileParser.h"
+#include "WorkerPool.h"
+#include "Instrumentation.h"
+#include "GOODFFunctions.h"
+#include <algorithm>
+#include <cmath>
+
+// at most this much of the sustain is measured
+static const unsigned MAX_MEASURED_SECONDS = 5;
+// the filters settle on audio before the measured part
+static const unsigned FILTER_SETTLING_MS = 100;
+// BS.1770 gating, with 400 ms blocks made of four 100 ms steps
+static const unsigned STEPS_PER_BLOCK = 4;
+static const float ABSOLUTE_GATE = -70.0f;
+static const float RELATIVE_GATE = -10.0f;
+static const float MIN_GAIN = -120.0f;
+static const float MAX_GAIN = 40.0f;
+// anything quieter is silence, a finite value as release builds use
+// -ffast-math where infinities can't be tested for
+static const double SILENCE_POWER = 1e-20;
+static const float SILENCE_DB = -200.0f;
+
+namespace {
+
+	struct Biquad {
+		double b0, b1, b2, a1, a2;
+		double z1, z2;
+
+		float process(float in) {
+			double out = b0 * in + z1;
+			z1 = b1 * in - a1 * out + z2;
+			z2 = b2 * in - a2 * out;
+			return (float) out;
+		}
+	};
+
+	// The two stages of the K-weighting filter of BS.1770 for any sample rate
+	void createKWeighting(unsigned sampleRate, Biquad &shelf, Biquad &highPass) {
+		const double PI = 3.14159265358979323846;
+		double k = std::tan(PI * 1681.974450955533 / sampleRate);
+		double q = 0.7071752369554196;
+		double vh = std::pow(10.0, 3.999843853973347 / 20.0);
+		double vb = std::pow(vh, 0.4996667741545416);
+		double a0 = 1.0 + k / q + k * k;
+		shelf = { (vh + vb * k / q + k * k) / a0, 2.0 * (k * k - vh) / a0, (vh - vb * k / q + k * k) / a0, 2.0 * (k * k - 1.0) / a0, (1.0 - k / q + k * k) / a0, 0, 0 };
+
+		k = std::tan(PI * 38.13547087602444 / sampleRate);
+		q = 0.5003270373238773;
+		a0 = 1.0 + k / q + k * k;
+		highPass = { 1.0, -2.0, 1.0, 2.0 * (k * k - 1.0) / a0, (1.0 - k / q + k * k) / a0, 0, 0 };
+	}
+
+	float powerToDb(double power, float offset) {
+		return power > SILENCE_POWER ? offset + 10.0f * (float) std::log10(power) : SILENCE_DB;
+	}
+
+}
+
+bool LoudnessAnalyzer::measureRanks(
+	const std::vector<std::pair<Rank*, wxString>> &ranks,
+	std::vector<PIPE_LOUDNESS> &results,
+	const std::function<bool(size_t, size_t)> &progress
+) {
+	ScopedTimer timer("analysis.loudness");
+	results.clear();
+
+	// the attacks are copied so that the workers never touch the organ
+	struct SUSTAIN {
+		wxString path;
+		int attackStart;
+		int cuePoint;
+		std::vector<std::pair<unsigned, unsigned>> loops;
+	};
+	std::vector<SUSTAIN> sustains;
+	for (const std::pair<Rank*, wxString> &rank : ranks) {
+		rank.first->loadPipes();
+		unsigned pipeIndex = 0;
+		for (Pipe &pipe : rank.first->m_pipes) {
+			PIPE_LOUDNESS result;
+			result.rank = rank.first;
+			result.rankName = rank.second;
+			result.pipeIndex = pipeIndex++;
+			result.isMeasured = false;
+			// a muted pipe is still measured but gets no proposal
+			result.isSilent = pipe.amplitudeLevel <= 0;
+			result.rms = 0;
+			result.loudness = 0;
+			result.amplitudeLevel = pipe.amplitudeLevel;
+			result.gain = pipe.gain;
+			result.effectiveLoudness = 0;
+			result.hasProposal = false;
+			result.proposedGain = pipe.gain;
+			SUSTAIN sustain;
+			for (Attack &atk : pipe.m_attacks) {
+				if (GOODF_functions::isSampleFilePath(atk.fullPath)) {
+					result.fileName = atk.fileName;
+					sustain.path = atk.fullPath;
+					sustain.attackStart = atk.attackStart;
+					sustain.cuePoint = atk.cuePoint;
+					for (Loop &loop : atk.m_loops)
+						sustain.loops.push_back(std::make_pair((unsigned) loop.start, (unsigned) loop.end));
+					break;
+				}
+			}
+			results.push_back(result);
+			sustains.push_back(sustain);
+		}
+	}
+
+	size_t total = results.size();
+	return WorkerPool::run(
+		results.size(),
+		[&](size_t index) {
+			SUSTAIN &sustain = sustains[index];
+			PIPE_LOUDNESS &result = results[index];
+			if (sustain.path.IsEmpty())
+				return;
+
+			// The sustain is the looped part or, without loops, what
+			// follows the attack transient up to the release
+			WAVfileParser sample(sustain.path);
+			if (sustain.loops.empty()) {
+				for (unsigned i = 0; i < sample.getNumberOfLoops(); i++) {
+					LOOP loop = sample.getLoopAtIndex(i);
+					sustain.loops.push_back(std::make_pair(loop.dwStart, loop.dwEnd));
+				}
+			}
+			unsigned frames = sample.getNumberOfFrames();
+			unsigned start;
+			unsigned end;
+			if (!sustain.loops.empty()) {
+				start = frames;
+				end = 0;
+				for (std::pair<unsigned, unsigned> &loop : sustain.loops) {
+					start = std::min(start, loop.first);
+					end = std::max(end, loop.second + 1);
+				}
+			} else {
+				unsigned attackStart = std::min((unsigned) std::max(0, sustain.attackStart), frames);
+				start = attackStart + std::min(sample.getSampleRate() / 2, (frames - attackStart) / 4);
+				end = sustain.cuePoint > (int) start ? (unsigned) sustain.cuePoint : frames;
+			}
+			result.isMeasured = measureFile(sustain.path, start, std::min(end, frames), result.rms, result.loudness, result.errorMessage);
+			if (result.loudness <= SILENCE_DB)
+				result.isSilent = true;
+			if (result.isMeasured && !result.isSilent)
+				result.effectiveLoudness = result.loudness + result.gain + 20.0f * std::log10(result.amplitudeLevel / 100.0f);
+		},
+		[&](size_t done) { return !progress || progress(done, total); }
+	);
+}
+
+void LoudnessAnalyzer::proposeGains(std::vector<PIPE_LOUDNESS> &results, unsigned smoothingWidth, float minimumChange) {
+	size_t rankStart = 0;
+	while (rankStart < results.size()) {
+		size_t rankEnd = rankStart;
+		while (rankEnd < results.size() && results[rankEnd].rank == results[rankStart].rank)
+			rankEnd++;
+
+		std::vector<size_t> measured;
+		for (size_t i = rankStart; i < rankEnd; i++) {
+			results[i].hasProposal = false;
+			results[i].proposedGain = results[i].gain;
+			if (results[i].isMeasured && !results[i].isSilent)
+				measured.push_back(i);
+		}
+
+		// a running median ignores single odd pipes, the running mean then smooths the steps
+		int width = smoothingWidth;
+		int count = measured.size();
+		std::vector<float> medians(count);
+		for (int k = 0; k < count; k++) {
+			std::vector<float> window;
+			for (int j = std::max(0, k - width); j <= std::min(count - 1, k + width); j++)
+				window.push_back(results[measured[j]].effectiveLoudness);
+			std::nth_element(window.begin(), window.begin() + window.size() / 2, window.end());
+			medians[k] = window[window.size() / 2];
+		}
+		for (int k = 0; k < count; k++) {
+			float sum = 0;
+			int first = std::max(0, k - width);
+			int last = std::min(count - 1, k + width);
+			for (int j = first; j <= last; j++)
+				sum += medians[j];
+			float target = sum / (last - first + 1);
+			PIPE_LOUDNESS &result = results[measured[k]];
+			float proposed = std::round((result.gain + target - result.effectiveLoudness) * 10.0f) / 10.0f;
+			proposed = std::min(std::max(proposed, MIN_GAIN), MAX_GAIN);
+			if (std::fabs(proposed - result.gain) >= minimumChange) {
+				result.hasProposal = true;
+				result.proposedGain = proposed;
+			}
+		}
+		rankStart = rankEnd;
+	}
+}
+
+unsigned LoudnessAnalyzer::applyGains(const std::vector<PIPE_LOUDNESS*> &results) {
+	unsigned changed = 0;
+	for (PIPE_LOUDNESS *result : results) {
+		if (!result->hasProposal || result->pipeIndex >= result->rank->m_pipes.size())
+			continue;
+		result->rank->getPipeAt(result->pipeIndex)->gain = result->proposedGain;
+		changed++;
+	}
+	return changed;
+}
+
+bool LoudnessAnalyzer::measureFile(const wxString &path, unsigned sustainStart, unsigned sustainEnd, float &rms, float &loudness, wxString &errorMessage) {
+	SampleReader reader(path);
+	if (!reader.isOk()) {
+		errorMessage = reader.getErrorMessage();
+		return false;
+	}
+	unsigned sampleRate = reader.getSampleRate();
+	unsigned channels = reader.getNumberOfChannels();
+	unsigned stepFrames = sampleRate / 10;
+	sustainEnd = std::min(sustainEnd, reader.getNumberOfFrames());
+	sustainEnd = std::min(sustainEnd, sustainStart + MAX_MEASURED_SECONDS * sampleRate);
+	if (sustainEnd <= sustainStart || sustainEnd - sustainStart < stepFrames * STEPS_PER_BLOCK) {
+		errorMessage = wxT("The sustain is too short to measure.\n");
+		return false;
+	}
+	unsigned settlingFrames = std::min(sustainStart, sampleRate * FILTER_SETTLING_MS / 1000);
+	unsigned first = sustainStart - settlingFrames;
+
+	std::vector<Biquad> shelves(channels);
+	std::vector<Biquad> highPasses(channels);
+	for (unsigned c = 0; c < channels; c++)
+		createKWeighting(sampleRate, shelves[c], highPasses[c]);
+
+	std::vector<float> buffer((size_t) stepFrames * channels);
+	std::vector<double> stepPowers;
+	double plainSum = 0;
+	size_t plainCount = 0;
+	if (!reader.seek(first))
+		return false;
+	unsigned position = first;
+	while (position < sustainEnd) {
+		unsigned toRead = position < sustainStart ? std::min(stepFrames, sustainStart - position) : std::min(stepFrames, sustainEnd - position);
+		unsigned framesRead = reader.read(buffer.data(), toRead);
+		if (framesRead == 0)
+			break;
+		double weightedSum = 0;
+		for (unsigned f = 0; f < framesRead; f++) {
+			for (unsigned c = 0; c < channels; c++) {
+				float value = buffer[(size_t) f * channels + c];
+				float weighted = highPasses[c].process(shelves[c].process(value));
+				if (position >= sustainStart) {
+					weightedSum += (double) weighted * weighted;
+					plainSum += (double) value * value;
+				}
+			}
+		}
+		if (position >= sustainStart) {
+			plainCount += (size_t) framesRead * channels;
+			// channels are summed, not averaged, for the loudness
+			if (framesRead == stepFrames)
+				stepPowers.push_back(weightedSum / framesRead);
+		}
+		position += framesRead;
+	}
+	if (stepPowers.size() < STEPS_PER_BLOCK || plainCount == 0) {
+		errorMessage = wxT("The sustain couldn't be read.\n");
+		return false;
+	}
+	rms = powerToDb(plainSum / plainCount, 0);
+
+	// gated integrated loudness over overlapping 400 ms blocks
+	std::vector<double> blockPowers;
+	for (size_t i = 0; i + STEPS_PER_BLOCK <= stepPowers.size(); i++) {
+		double power = 0;
+		for (unsigned s = 0; s < STEPS_PER_BLOCK; s++)
+			power += stepPowers[i + s];
+		blockPowers.push_back(power / STEPS_PER_BLOCK);
+	}
+	double gatedSum = 0;
+	unsigned gatedCount = 0;
+	for (double power : blockPowers) {
+		if (powerToDb(power, -0.691f) > ABSOLUTE_GATE) {
+			gatedSum += power;
+			gatedCount++;
+		}
+	}
+	if (gatedCount == 0) {
+		loudness = SILENCE_DB;
+		errorMessage = wxT("The sustain is silent.\n");
+		return false;
+	}
+	float relativeGate = powerToDb(gatedSum / gatedCount, -0.691f) + RELATIVE_GATE;
+	double sum = 0;
+	unsigned count = 0;
+	for (double power : blockPowers) {
+		float blockLoudness = powerToDb(power, -0.691f);
+		if (blockLoudness > ABSOLUTE_GATE && blockLoudness > relativeGate) {
+			sum += power;
+			count++;
+		}
+	}
+	loudness = powerToDb(count ? sum / count : gatedSum / gatedCount, -0.691f);
+	return true;
+}
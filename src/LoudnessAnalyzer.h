@@ -0,0 +1,71 @@
+/*
+ * LoudnessAnalyzer.h is part of GoOdf.
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * GoOdf is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GoOdf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GoOdf.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#ifndef LOUDNESSANALYZER_H
+#define LOUDNESSANALYZER_H
+
+#include <wx/wx.h>
+#include <vector>
+#include <functional>
+
+class Rank;
+
+// Measures the loudness of the sustain of the first attack of every pipe,
+// both as plain RMS and as gated K-weighted loudness (LUFS) following
+// ITU-R BS.1770, and proposes Gain values for the pipes that make the
+// loudness of each rank follow a smooth curve.
+class LoudnessAnalyzer {
+public:
+	struct PIPE_LOUDNESS {
+		Rank *rank;
+		wxString rankName;
+		unsigned pipeIndex;
+		wxString fileName;
+		bool isMeasured;
+		// muted by the amplitude level or without any audible sustain,
+		// such pipes are left out of the proposals
+		bool isSilent;
+		// dBFS and LUFS of the sample itself
+		float rms;
+		float loudness;
+		float amplitudeLevel;
+		float gain;
+		// the loudness with the amplitude level and gain of the pipe applied
+		float effectiveLoudness;
+		bool hasProposal;
+		float proposedGain;
+		wxString errorMessage;
+	};
+
+	static bool measureRanks(
+		const std::vector<std::pair<Rank*, wxString>> &ranks,
+		std::vector<PIPE_LOUDNESS> &results,
+		const std::function<bool(size_t, size_t)> &progress = nullptr
+	);
+	// The target of each pipe is the median and then the mean of the
+	// pipes within smoothingWidth of it in the same rank
+	static void proposeGains(std::vector<PIPE_LOUDNESS> &results, unsigned smoothingWidth, float minimumChange);
+	// Sets the proposed gains of the given results, returns the number of pipes changed
+	static unsigned applyGains(const std::vector<PIPE_LOUDNESS*> &results);
+	static bool measureFile(const wxString &path, unsigned sustainStart, unsigned sustainEnd, float &rms, float &loudness, wxString &errorMessage);
+
+};
+
+#endif
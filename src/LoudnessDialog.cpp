@@ -0,0 +1,224 @@
+/*
+ * LoudnessDialog.cpp is part of GoOdf.
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * GoOdf is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GoOdf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GoOdf. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#include "LoudnessDialog.h"
+#include "GOODFDef.h"
+#include "GOODFFunctions.h"
+#include <wx/statline.h>
+#include <cmath>
+
+IMPLEMENT_CLASS(LoudnessDialog, wxDialog)
+
+BEGIN_EVENT_TABLE(LoudnessDialog, wxDialog)
+	EVT_BUTTON(ID_LOUDNESS_UPDATE_BTN, LoudnessDialog::OnUpdateBtn)
+	EVT_BUTTON(ID_LOUDNESS_APPLY_BTN, LoudnessDialog::OnApplyBtn)
+END_EVENT_TABLE()
+
+LoudnessDialog::LoudnessDialog(std::vector<LoudnessAnalyzer::PIPE_LOUDNESS> *results) {
+	Init(results);
+}
+
+LoudnessDialog::LoudnessDialog(
+	std::vector<LoudnessAnalyzer::PIPE_LOUDNESS> *results,
+	wxWindow* parent,
+	wxWindowID id,
+	const wxString& caption,
+	const wxPoint& pos,
+	const wxSize& size,
+	long style
+) {
+	Init(results);
+	Create(parent, id, caption, pos, size, style);
+}
+
+LoudnessDialog::~LoudnessDialog() {
+
+}
+
+void LoudnessDialog::Init(std::vector<LoudnessAnalyzer::PIPE_LOUDNESS> *results) {
+	m_results = results;
+	m_numberOfChanges = 0;
+}
+
+bool LoudnessDialog::Create(
+	wxWindow* parent,
+	wxWindowID id,
+	const wxString& caption,
+	const wxPoint& pos,
+	const wxSize& size,
+	long style
+) {
+	if (!wxDialog::Create(parent, id, caption, pos, size, style))
+		return false;
+
+	CreateControls();
+	LoudnessAnalyzer::proposeGains(*m_results, m_smoothingSpin->GetValue(), (float) m_minimumChangeSpin->GetValue());
+	FillList();
+
+	GetSizer()->Fit(this);
+	GetSizer()->SetSizeHints(this);
+	Centre();
+
+	return true;
+}
+
+void LoudnessDialog::CreateControls() {
+	wxBoxSizer *mainSizer = new wxBoxSizer(wxVERTICAL);
+
+	wxBoxSizer *settingsRow = new wxBoxSizer(wxHORIZONTAL);
+	wxStaticText *smoothingText = new wxStaticText (
+		this,
+		wxID_STATIC,
+		wxT("Smooth over pipes on each side: ")
+	);
+	settingsRow->Add(smoothingText, 0, wxALIGN_CENTER_VERTICAL|wxALL, 5);
+	m_smoothingSpin = new wxSpinCtrl(
+		this,
+		wxID_ANY,
+		wxEmptyString,
+		wxDefaultPosition,
+		wxDefaultSize,
+		wxSP_ARROW_KEYS,
+		1,
+		12,
+		3
+	);
+	settingsRow->Add(m_smoothingSpin, 0, wxALIGN_CENTER_VERTICAL|wxALL, 5);
+	wxStaticText *minimumChangeText = new wxStaticText (
+		this,
+		wxID_STATIC,
+		wxT("Smallest change (dB): ")
+	);
+	settingsRow->Add(minimumChangeText, 0, wxALIGN_CENTER_VERTICAL|wxALL, 5);
+	m_minimumChangeSpin = new wxSpinCtrlDouble(
+		this,
+		wxID_ANY,
+		wxEmptyString,
+		wxDefaultPosition,
+		wxDefaultSize,
+		wxSP_ARROW_KEYS,
+		0.1,
+		6,
+		0.5,
+		0.1
+	);
+	m_minimumChangeSpin->SetDigits(1);
+	settingsRow->Add(m_minimumChangeSpin, 0, wxALIGN_CENTER_VERTICAL|wxALL, 5);
+	wxButton *updateBtn = new wxButton(
+		this,
+		ID_LOUDNESS_UPDATE_BTN,
+		wxT("Update suggestions")
+	);
+	settingsRow->Add(updateBtn, 0, wxALIGN_CENTER_VERTICAL|wxALL, 5);
+	mainSizer->Add(settingsRow, 0, wxGROW);
+
+	m_loudnessList = new wxListCtrl(
+		this,
+		ID_LOUDNESS_LIST,
+		wxDefaultPosition,
+		wxSize(900, 400),
+		wxLC_REPORT
+	);
+	m_loudnessList->AppendColumn(wxT("Rank"), wxLIST_FORMAT_LEFT, 180);
+	m_loudnessList->AppendColumn(wxT("Pipe"), wxLIST_FORMAT_RIGHT, 50);
+	m_loudnessList->AppendColumn(wxT("Sample"), wxLIST_FORMAT_LEFT, 200);
+	m_loudnessList->AppendColumn(wxT("RMS (dBFS)"), wxLIST_FORMAT_RIGHT, 90);
+	m_loudnessList->AppendColumn(wxT("Loudness (LUFS)"), wxLIST_FORMAT_RIGHT, 110);
+	m_loudnessList->AppendColumn(wxT("With gain (LUFS)"), wxLIST_FORMAT_RIGHT, 110);
+	m_loudnessList->AppendColumn(wxT("Gain"), wxLIST_FORMAT_RIGHT, 60);
+	m_loudnessList->AppendColumn(wxT("Suggested gain"), wxLIST_FORMAT_RIGHT, 100);
+	mainSizer->Add(m_loudnessList, 1, wxEXPAND|wxALL, 5);
+	m_applyBtn = new wxButton(
+		this,
+		ID_LOUDNESS_APPLY_BTN,
+		wxT("Apply suggested gains (to the selected pipes only, if any)")
+	);
+	mainSizer->Add(m_applyBtn, 0, wxALIGN_RIGHT|wxLEFT|wxRIGHT|wxBOTTOM, 5);
+
+	wxStaticLine *bottomDivider = new wxStaticLine(this);
+	mainSizer->Add(bottomDivider, 0, wxEXPAND);
+
+	wxBoxSizer *bottomRow = new wxBoxSizer(wxHORIZONTAL);
+	bottomRow->AddStretchSpacer();
+	wxButton *theCloseButton = new wxButton(
+		this,
+		wxID_CANCEL,
+		wxT("Close")
+	);
+	bottomRow->Add(theCloseButton, 0, wxALIGN_CENTER|wxALL, 10);
+	bottomRow->AddStretchSpacer();
+	mainSizer->Add(bottomRow, 0, wxGROW);
+
+	SetSizer(mainSizer);
+}
+
+unsigned LoudnessDialog::GetNumberOfChanges() {
+	return m_numberOfChanges;
+}
+
+void LoudnessDialog::OnUpdateBtn(wxCommandEvent& WXUNUSED(event)) {
+	LoudnessAnalyzer::proposeGains(*m_results, m_smoothingSpin->GetValue(), (float) m_minimumChangeSpin->GetValue());
+	FillList();
+}
+
+void LoudnessDialog::OnApplyBtn(wxCommandEvent& WXUNUSED(event)) {
+	std::vector<LoudnessAnalyzer::PIPE_LOUDNESS*> toApply;
+	long item = -1;
+	while ((item = m_loudnessList->GetNextItem(item, wxLIST_NEXT_ALL, wxLIST_STATE_SELECTED)) != -1)
+		toApply.push_back(&(*m_results)[m_loudnessList->GetItemData(item)]);
+	if (toApply.empty()) {
+		for (LoudnessAnalyzer::PIPE_LOUDNESS &result : *m_results)
+			toApply.push_back(&result);
+	}
+	m_numberOfChanges += LoudnessAnalyzer::applyGains(toApply);
+	EndModal(wxID_OK);
+}
+
+void LoudnessDialog::FillList() {
+	m_loudnessList->DeleteAllItems();
+	unsigned proposals = 0;
+	long row = 0;
+	for (unsigned i = 0; i < m_results->size(); i++) {
+		const LoudnessAnalyzer::PIPE_LOUDNESS &result = (*m_results)[i];
+		if (!result.isMeasured && result.errorMessage.IsEmpty())
+			continue;
+		m_loudnessList->InsertItem(row, result.rankName);
+		m_loudnessList->SetItemData(row, i);
+		m_loudnessList->SetItem(row, 1, GOODF_functions::number_format(result.pipeIndex + 1));
+		m_loudnessList->SetItem(row, 2, result.fileName);
+		if (result.isMeasured) {
+			m_loudnessList->SetItem(row, 3, wxString::Format(wxT("%.1f"), result.rms));
+			m_loudnessList->SetItem(row, 4, wxString::Format(wxT("%.1f"), result.loudness));
+			if (result.isSilent)
+				m_loudnessList->SetItem(row, 5, wxT("muted"));
+			else
+				m_loudnessList->SetItem(row, 5, wxString::Format(wxT("%.1f"), result.effectiveLoudness));
+			m_loudnessList->SetItem(row, 6, wxString::Format(wxT("%.1f"), result.gain));
+			if (result.hasProposal) {
+				m_loudnessList->SetItem(row, 7, wxString::Format(wxT("%.1f"), result.proposedGain));
+				proposals++;
+			}
+		} else {
+			m_loudnessList->SetItem(row, 3, result.errorMessage.Strip(wxString::both));
+		}
+		row++;
+	}
+	m_applyBtn->Enable(proposals > 0);
+}
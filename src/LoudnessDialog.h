@@ -0,0 +1,83 @@
+/*
+ * LoudnessDialog.h is part of GoOdf.
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * GoOdf is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GoOdf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GoOdf. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#ifndef LOUDNESSDIALOG_H
+#define LOUDNESSDIALOG_H
+
+#include <wx/wx.h>
+#include <wx/listctrl.h>
+#include <wx/spinctrl.h>
+#include "LoudnessAnalyzer.h"
+
+class LoudnessDialog : public wxDialog {
+	DECLARE_CLASS(LoudnessDialog)
+	DECLARE_EVENT_TABLE()
+
+public:
+	// Constructors
+	LoudnessDialog(std::vector<LoudnessAnalyzer::PIPE_LOUDNESS> *results);
+	LoudnessDialog(
+		std::vector<LoudnessAnalyzer::PIPE_LOUDNESS> *results,
+		wxWindow* parent,
+		wxWindowID id = wxID_ANY,
+		const wxString& caption = wxT("Pipe loudness"),
+		const wxPoint& pos = wxDefaultPosition,
+		const wxSize& size = wxDefaultSize,
+		long style = wxCAPTION|wxRESIZE_BORDER|wxSYSTEM_MENU|wxCLOSE_BOX
+	);
+
+	~LoudnessDialog();
+
+	// Initialize our variables
+	void Init(std::vector<LoudnessAnalyzer::PIPE_LOUDNESS> *results);
+
+	// Creation
+	bool Create(
+		wxWindow* parent,
+		wxWindowID id = wxID_ANY,
+		const wxString& caption = wxT("Pipe loudness"),
+		const wxPoint& pos = wxDefaultPosition,
+		const wxSize& size = wxDefaultSize,
+		long style = wxCAPTION|wxRESIZE_BORDER|wxSYSTEM_MENU|wxCLOSE_BOX
+	);
+
+	// Creates the controls and sizers
+	void CreateControls();
+
+	// Accessors
+	unsigned GetNumberOfChanges();
+
+private:
+	std::vector<LoudnessAnalyzer::PIPE_LOUDNESS> *m_results;
+	unsigned m_numberOfChanges;
+
+	wxSpinCtrl *m_smoothingSpin;
+	wxSpinCtrlDouble *m_minimumChangeSpin;
+	wxListCtrl *m_loudnessList;
+	wxButton *m_applyBtn;
+
+	// Event methods
+	void OnUpdateBtn(wxCommandEvent& event);
+	void OnApplyBtn(wxCommandEvent& event);
+
+	void FillList();
+};
+
+#endif
@@ -19,7 +19,7 @@
  */
 
 #include "Manual.h"
-#include "GOODF.h"
+#include "Organ.h"
 #include "GOODFFunctions.h"
 #include <utility>
 #include <vector>
@@ -57,7 +57,7 @@ void Manual::write(wxTextFile *outFile) {
 	outFile->AddLine(wxT("NumberOfStops=") + wxString::Format(wxT("%u"), nbStops));
 	unsigned counter = 1;
 	for (Stop *s : m_stops) {
-		wxString stopId = GOODF_functions::number_format(::wxGetApp().m_frame->m_organ->getIndexOfOrganStop(s));
+		wxString stopId = GOODF_functions::number_format(OrganContext::current()->getOrgan()->getIndexOfOrganStop(s));
 		outFile->AddLine(wxT("Stop") + GOODF_functions::number_format(counter) + wxT("=") + stopId);
 		counter++;
 	}
@@ -66,7 +66,7 @@ void Manual::write(wxTextFile *outFile) {
 		outFile->AddLine(wxT("NumberOfCouplers=") + wxString::Format(wxT("%u"), nbCouplers));
 		counter = 1;
 		for (Coupler *c : m_couplers) {
-			wxString couplerId = GOODF_functions::number_format(::wxGetApp().m_frame->m_organ->getIndexOfOrganCoupler(c));
+			wxString couplerId = GOODF_functions::number_format(OrganContext::current()->getOrgan()->getIndexOfOrganCoupler(c));
 			outFile->AddLine(wxT("Coupler") + GOODF_functions::number_format(counter) + wxT("=") + couplerId);
 			counter++;
 		}
@@ -76,7 +76,7 @@ void Manual::write(wxTextFile *outFile) {
 		outFile->AddLine(wxT("NumberOfDivisionals=") + wxString::Format(wxT("%u"), nbDivisionals));
 		counter = 1;
 		for (Divisional *d : m_divisionals) {
-			wxString divId = GOODF_functions::number_format(::wxGetApp().m_frame->m_organ->getIndexOfOrganDivisional(d));
+			wxString divId = GOODF_functions::number_format(OrganContext::current()->getOrgan()->getIndexOfOrganDivisional(d));
 			outFile->AddLine(wxT("Divisional") + GOODF_functions::number_format(counter) + wxT("=") + divId);
 			counter++;
 		}
@@ -86,7 +86,7 @@ void Manual::write(wxTextFile *outFile) {
 		outFile->AddLine(wxT("NumberOfTremulants=") + wxString::Format(wxT("%u"), nbTrems));
 		counter = 1;
 		for (Tremulant *t : m_tremulants) {
-			wxString tremId = GOODF_functions::number_format(::wxGetApp().m_frame->m_organ->getIndexOfOrganTremulant(t));
+			wxString tremId = GOODF_functions::number_format(OrganContext::current()->getOrgan()->getIndexOfOrganTremulant(t));
 			outFile->AddLine(wxT("Tremulant") + GOODF_functions::number_format(counter) + wxT("=") + tremId);
 			counter++;
 		}
@@ -96,7 +96,7 @@ void Manual::write(wxTextFile *outFile) {
 		outFile->AddLine(wxT("NumberOfSwitches=") + wxString::Format(wxT("%u"), nbSwitches));
 		counter = 1;
 		for (GoSwitch *sw : m_switches) {
-			wxString switchId = GOODF_functions::number_format(::wxGetApp().m_frame->m_organ->getIndexOfOrganSwitch(sw));
+			wxString switchId = GOODF_functions::number_format(OrganContext::current()->getOrgan()->getIndexOfOrganSwitch(sw));
 			outFile->AddLine(wxT("Switch") + GOODF_functions::number_format(counter) + wxT("=") + switchId);
 			counter++;
 		}
@@ -183,31 +183,33 @@ void Manual::read(wxFileConfig *cfg, bool useOldPanelFormat, wxString manId, Org
 					for (Pipe& p : s.getInternalRank()->m_pipes) {
 						if (!p.m_attacks.front().loadRelease && p.m_attacks.front().releaseCrossfadeLength) {
 							// This is certainly a legacy x-fade!
-							wxLogWarning("[Stop%0.3d] %s uses Pipe999ReleaseCrossfadeLength with LoadRelease=N! You might want to use Tools->Import Legacy X-fades.", readOrgan->getNumberOfStops(), s.getName());
+							readOrgan->getContext()->logWarning(wxString::Format("[Stop%0.3d] %s uses Pipe999ReleaseCrossfadeLength with LoadRelease=N! You might want to use Tools->Import Legacy X-fades.", readOrgan->getNumberOfStops(), s.getName()));
 							rankUsesLegacyXfades = true;
 						}
 						if (rankUsesLegacyXfades) {
-							::wxGetApp().m_frame->GetLogWindow()->Show(true);
 							break;
 						}
 					}
 				}
 				if (s.isDisplayed()) {
 					// we must also create a GUI element for that stop from this group information
-					int lastStopIdx = m_stops.size() - 1;
-					GUIElement *guiStop = new GUIStop(getStopAt(lastStopIdx));
-					guiStop->setOwningPanel(readOrgan->getOrganPanelAt(0));
-					guiStop->setDisplayName(s.getName());
-					readOrgan->getOrganPanelAt(0)->addGuiElement(guiStop);
-
-					GUIStop *stopElement = dynamic_cast<GUIStop*>(guiStop);
-					if (stopElement) {
-						stopElement->read(cfg, false, readOrgan);
-					}
+					Stop *lastStop = getStopAt(m_stops.size() - 1);
+					std::shared_ptr<wxFileConfig> section = GOODF_functions::copyConfigGroups(cfg, stopGroup);
+					readOrgan->getContext()->addGuiTask([section, readOrgan, lastStop, stopGroup]() {
+						section->SetPath(wxT("/") + stopGroup);
+						GUIElement *guiStop = new GUIStop(lastStop);
+						guiStop->setOwningPanel(readOrgan->getOrganPanelAt(0));
+						guiStop->setDisplayName(lastStop->getName());
+						readOrgan->getOrganPanelAt(0)->addGuiElement(guiStop);
+
+						GUIStop *stopElement = dynamic_cast<GUIStop*>(guiStop);
+						if (stopElement) {
+							stopElement->read(section.get(), false, readOrgan);
+						}
+					});
 				}
 			} else {
-				wxLogWarning("[%s] section couldn't be found!", stopGroup);
-				::wxGetApp().m_frame->GetLogWindow()->Show(true);
+				readOrgan->getContext()->logWarning(wxString::Format("[%s] section couldn't be found!", stopGroup));
 			}
 		}
 	}
@@ -232,20 +234,23 @@ void Manual::readCouplers(wxFileConfig *cfg, bool useOldPanelFormat, wxString ma
 				addCoupler(readOrgan->getOrganCouplerAt(readOrgan->getNumberOfCouplers() - 1));
 				if (c.isDisplayed()) {
 					// we must also create a GUI element for that coupler from this group information
-					int lastCplrIdx = m_couplers.size() - 1;
-					GUIElement *guiCplr = new GUICoupler(getCouplerAt(lastCplrIdx));
-					guiCplr->setOwningPanel(readOrgan->getOrganPanelAt(0));
-					guiCplr->setDisplayName(c.getName());
-					readOrgan->getOrganPanelAt(0)->addGuiElement(guiCplr);
-
-					GUICoupler *cplrElement = dynamic_cast<GUICoupler*>(guiCplr);
-					if (cplrElement) {
-						cplrElement->read(cfg, false, readOrgan);
-					}
+					Coupler *lastCplr = getCouplerAt(m_couplers.size() - 1);
+					std::shared_ptr<wxFileConfig> section = GOODF_functions::copyConfigGroups(cfg, couplerGroup);
+					readOrgan->getContext()->addGuiTask([section, readOrgan, lastCplr, couplerGroup]() {
+						section->SetPath(wxT("/") + couplerGroup);
+						GUIElement *guiCplr = new GUICoupler(lastCplr);
+						guiCplr->setOwningPanel(readOrgan->getOrganPanelAt(0));
+						guiCplr->setDisplayName(lastCplr->getName());
+						readOrgan->getOrganPanelAt(0)->addGuiElement(guiCplr);
+
+						GUICoupler *cplrElement = dynamic_cast<GUICoupler*>(guiCplr);
+						if (cplrElement) {
+							cplrElement->read(section.get(), false, readOrgan);
+						}
+					});
 				}
 			} else {
-				wxLogWarning("[%s] section couldn't be found!", couplerGroup);
-				::wxGetApp().m_frame->GetLogWindow()->Show(true);
+				readOrgan->getContext()->logWarning(wxString::Format("[%s] section couldn't be found!", couplerGroup));
 			}
 		}
 	}
@@ -268,20 +273,23 @@ void Manual::readDivisionals(wxFileConfig *cfg, bool useOldPanelFormat, wxString
 				addDivisional(readOrgan->getOrganDivisionalAt(readOrgan->getNumberOfDivisionals() - 1));
 				if (d.isDisplayed()) {
 					// we must also create a GUI element for that divisional from this group information
-					int lastDivIdx = m_divisionals.size() - 1;
-					GUIElement *guiDiv = new GUIDivisional(getDivisionalAt(lastDivIdx));
-					guiDiv->setOwningPanel(readOrgan->getOrganPanelAt(0));
-					guiDiv->setDisplayName(d.getName());
-					readOrgan->getOrganPanelAt(0)->addGuiElement(guiDiv);
-
-					GUIDivisional *divElement = dynamic_cast<GUIDivisional*>(guiDiv);
-					if (divElement) {
-						divElement->read(cfg, true, readOrgan);
-					}
+					Divisional *lastDiv = getDivisionalAt(m_divisionals.size() - 1);
+					std::shared_ptr<wxFileConfig> section = GOODF_functions::copyConfigGroups(cfg, divGroup);
+					readOrgan->getContext()->addGuiTask([section, readOrgan, lastDiv, divGroup]() {
+						section->SetPath(wxT("/") + divGroup);
+						GUIElement *guiDiv = new GUIDivisional(lastDiv);
+						guiDiv->setOwningPanel(readOrgan->getOrganPanelAt(0));
+						guiDiv->setDisplayName(lastDiv->getName());
+						readOrgan->getOrganPanelAt(0)->addGuiElement(guiDiv);
+
+						GUIDivisional *divElement = dynamic_cast<GUIDivisional*>(guiDiv);
+						if (divElement) {
+							divElement->read(section.get(), true, readOrgan);
+						}
+					});
 				}
 			} else {
-				wxLogWarning("[%s] section couldn't be found!", divGroup);
-				::wxGetApp().m_frame->GetLogWindow()->Show(true);
+				readOrgan->getContext()->logWarning(wxString::Format("[%s] section couldn't be found!", divGroup));
 			}
 		}
 	}
@@ -344,9 +352,9 @@ bool Manual::isThePedal() {
 	return m_thePedal;
 }
 
-void Manual::setIsPedal(bool isPedal, bool isParsing) {
+void Manual::setIsPedal(bool isPedal, OrganContext &context, bool isParsing) {
 	m_thePedal = isPedal;
-	::wxGetApp().m_frame->m_organ->setHasPedals(isPedal, isParsing);
+	context.getOrgan()->setHasPedals(isPedal, isParsing);
 }
 
 bool Manual::isDisplayed() {
@@ -33,6 +33,7 @@
 
 class Coupler;
 class Organ;
+class OrganContext;
 
 class Manual {
 public:
@@ -57,7 +58,7 @@ public:
 	int getMidiInputNumber();
 	void setMidiInputNumber(int midiInputNbr);
 	bool isThePedal();
-	void setIsPedal(bool isPedal, bool isParsing = false);
+	void setIsPedal(bool isPedal, OrganContext &context, bool isParsing = false);
 	bool isDisplayed();
 	unsigned getNumberOfStops();
 	Stop* getStopAt(unsigned index);
@@ -530,9 +530,9 @@ void ManualPanel::OnNameChange(wxCommandEvent& WXUNUSED(event)) {
 
 void ManualPanel::OnPedalCheckbox(wxCommandEvent& WXUNUSED(event)) {
 	if (m_thisIsThePedalCheckbox->GetValue())
-		m_manual->setIsPedal(true);
+		m_manual->setIsPedal(true, *::wxGetApp().m_frame->m_organ->getContext());
 	else
-		m_manual->setIsPedal(false);
+		m_manual->setIsPedal(false, *::wxGetApp().m_frame->m_organ->getContext());
 	::wxGetApp().m_frame->m_organ->organElementHasChanged();
 }
 
@@ -587,6 +587,8 @@ void ManualPanel::OnNewStopBtn(wxCommandEvent& WXUNUSED(event)) {
 			Stop stop;
 			stop.setOwningManual(m_manual);
 			stop.getInternalRank()->setFirstMidiNoteNumber(m_manual->getFirstAccessibleKeyMIDINoteNumber());
+			stop.getInternalRank()->setPercussive(::wxGetApp().m_frame->m_organ->getIsPercussive());
+			stop.getInternalRank()->setIndependentRelease(::wxGetApp().m_frame->m_organ->getHasIndependentRelease());
 			::wxGetApp().m_frame->m_organ->addStop(stop);
 			unsigned nbStops = ::wxGetApp().m_frame->m_organ->getNumberOfStops();
 			if (nbStops > 0)
@@ -0,0 +1,193 @@
+/*
+ * MemoryFootprintDialog.cpp is part of GoOdf.
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * GoOdf is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GoOdf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GoOdf. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#include "MemoryFootprintDialog.h"
+#include "GOODFDef.h"
+#include <wx/statline.h>
+
+// the columns before the one for each loading setting
+static const int FIXED_COLUMNS = 3;
+
+IMPLEMENT_CLASS(MemoryFootprintDialog, wxDialog)
+
+BEGIN_EVENT_TABLE(MemoryFootprintDialog, wxDialog)
+	EVT_LIST_COL_CLICK(ID_MEMORY_FOOTPRINT_LIST, MemoryFootprintDialog::OnColumnClick)
+END_EVENT_TABLE()
+
+MemoryFootprintDialog::MemoryFootprintDialog(const MemoryFootprintEstimator *estimator) {
+	Init(estimator);
+}
+
+MemoryFootprintDialog::MemoryFootprintDialog(
+	const MemoryFootprintEstimator *estimator,
+	wxWindow* parent,
+	wxWindowID id,
+	const wxString& caption,
+	const wxPoint& pos,
+	const wxSize& size,
+	long style
+) {
+	Init(estimator);
+	Create(parent, id, caption, pos, size, style);
+}
+
+MemoryFootprintDialog::~MemoryFootprintDialog() {
+
+}
+
+void MemoryFootprintDialog::Init(const MemoryFootprintEstimator *estimator) {
+	m_estimator = estimator;
+	// largest first with the most demanding setting
+	m_sortColumn = FIXED_COLUMNS;
+	m_sortAscending = false;
+}
+
+bool MemoryFootprintDialog::Create(
+	wxWindow* parent,
+	wxWindowID id,
+	const wxString& caption,
+	const wxPoint& pos,
+	const wxSize& size,
+	long style
+) {
+	if (!wxDialog::Create(parent, id, caption, pos, size, style))
+		return false;
+
+	CreateControls();
+	FillList();
+
+	GetSizer()->Fit(this);
+	GetSizer()->SetSizeHints(this);
+	Centre();
+
+	return true;
+}
+
+void MemoryFootprintDialog::CreateControls() {
+	wxBoxSizer *mainSizer = new wxBoxSizer(wxVERTICAL);
+	const std::vector<MemoryFootprintEstimator::LOADING_SETTINGS> &settings = MemoryFootprintEstimator::getLoadingSettings();
+	const MemoryFootprintEstimator::FOOTPRINT_ROW &total = m_estimator->getTotal();
+
+	wxString totalText = wxString::Format(wxT("Estimated total for %u samples:"), total.numberOfSamples);
+	for (unsigned i = 0; i < settings.size(); i++)
+		totalText += wxT("\n") + settings[i].label + wxT(": ") + FormatSize(total.bytes[i]);
+	if (m_estimator->getNumberOfUnreadableFiles())
+		totalText += wxString::Format(wxT("\n%u sample files couldn't be read and aren't counted."), m_estimator->getNumberOfUnreadableFiles());
+	wxStaticText *summaryText = new wxStaticText (
+		this,
+		wxID_STATIC,
+		totalText
+	);
+	mainSizer->Add(summaryText, 0, wxALL, 5);
+
+	m_footprintList = new wxListCtrl(
+		this,
+		ID_MEMORY_FOOTPRINT_LIST,
+		wxDefaultPosition,
+		wxSize(900, 400),
+		wxLC_REPORT|wxLC_SINGLE_SEL
+	);
+	m_footprintList->AppendColumn(wxT("Type"), wxLIST_FORMAT_LEFT, 60);
+	m_footprintList->AppendColumn(wxT("Name"), wxLIST_FORMAT_LEFT, 220);
+	m_footprintList->AppendColumn(wxT("Samples"), wxLIST_FORMAT_RIGHT, 70);
+	for (const MemoryFootprintEstimator::LOADING_SETTINGS &setting : settings)
+		m_footprintList->AppendColumn(setting.label, wxLIST_FORMAT_RIGHT, 100);
+	mainSizer->Add(m_footprintList, 1, wxEXPAND|wxALL, 5);
+
+	wxStaticText *infoText = new wxStaticText (
+		this,
+		wxID_STATIC,
+		wxT("Stops show the part of their ranks they use, so the same pipes can be listed for several stops. Click on a column to sort by it.")
+	);
+	infoText->Wrap(880);
+	mainSizer->Add(infoText, 0, wxALL, 5);
+
+	wxStaticLine *bottomDivider = new wxStaticLine(this);
+	mainSizer->Add(bottomDivider, 0, wxEXPAND);
+
+	wxBoxSizer *bottomRow = new wxBoxSizer(wxHORIZONTAL);
+	bottomRow->AddStretchSpacer();
+	wxButton *theCloseButton = new wxButton(
+		this,
+		wxID_CANCEL,
+		wxT("Close")
+	);
+	bottomRow->Add(theCloseButton, 0, wxALIGN_CENTER|wxALL, 10);
+	bottomRow->AddStretchSpacer();
+	mainSizer->Add(bottomRow, 0, wxGROW);
+
+	SetSizer(mainSizer);
+}
+
+void MemoryFootprintDialog::OnColumnClick(wxListEvent& event) {
+	int column = event.GetColumn();
+	if (column < 0)
+		return;
+	if (column == m_sortColumn) {
+		m_sortAscending = !m_sortAscending;
+	} else {
+		m_sortColumn = column;
+		// sizes are most interesting largest first
+		m_sortAscending = column < FIXED_COLUMNS - 1;
+	}
+	m_footprintList->SortItems(CompareRows, (wxIntPtr) this);
+}
+
+void MemoryFootprintDialog::FillList() {
+	const std::vector<MemoryFootprintEstimator::FOOTPRINT_ROW> &rows = m_estimator->getRows();
+	for (unsigned i = 0; i < rows.size(); i++) {
+		const MemoryFootprintEstimator::FOOTPRINT_ROW &row = rows[i];
+		m_footprintList->InsertItem(i, row.type == MemoryFootprintEstimator::STOP_ROW ? wxT("Stop") : wxT("Rank"));
+		m_footprintList->SetItem(i, 1, row.name);
+		m_footprintList->SetItem(i, 2, wxString::Format(wxT("%u"), row.numberOfSamples));
+		for (unsigned j = 0; j < row.bytes.size(); j++)
+			m_footprintList->SetItem(i, FIXED_COLUMNS + j, FormatSize(row.bytes[j]));
+		m_footprintList->SetItemData(i, i);
+	}
+	m_footprintList->SortItems(CompareRows, (wxIntPtr) this);
+}
+
+int wxCALLBACK MemoryFootprintDialog::CompareRows(wxIntPtr item1, wxIntPtr item2, wxIntPtr sortData) {
+	MemoryFootprintDialog *dlg = (MemoryFootprintDialog*) sortData;
+	const std::vector<MemoryFootprintEstimator::FOOTPRINT_ROW> &rows = dlg->m_estimator->getRows();
+	const MemoryFootprintEstimator::FOOTPRINT_ROW &first = rows[item1];
+	const MemoryFootprintEstimator::FOOTPRINT_ROW &second = rows[item2];
+
+	int result = 0;
+	if (dlg->m_sortColumn == 0) {
+		result = (int) first.type - (int) second.type;
+	} else if (dlg->m_sortColumn == 1) {
+		result = first.name.CmpNoCase(second.name);
+	} else if (dlg->m_sortColumn == 2) {
+		result = first.numberOfSamples < second.numberOfSamples ? -1 : (first.numberOfSamples > second.numberOfSamples ? 1 : 0);
+	} else {
+		unsigned setting = dlg->m_sortColumn - FIXED_COLUMNS;
+		result = first.bytes[setting] < second.bytes[setting] ? -1 : (first.bytes[setting] > second.bytes[setting] ? 1 : 0);
+	}
+	if (result == 0)
+		result = item1 < item2 ? -1 : (item1 > item2 ? 1 : 0);
+	return dlg->m_sortAscending ? result : -result;
+}
+
+wxString MemoryFootprintDialog::FormatSize(unsigned long long bytes) {
+	if (bytes >= 1073741824ULL)
+		return wxString::Format(wxT("%.2f GB"), bytes / 1073741824.0);
+	return wxString::Format(wxT("%.1f MB"), bytes / 1048576.0);
+}
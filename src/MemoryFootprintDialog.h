@@ -0,0 +1,78 @@
+/*
+ * MemoryFootprintDialog.h is part of GoOdf.
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * GoOdf is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GoOdf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GoOdf. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#ifndef MEMORYFOOTPRINTDIALOG_H
+#define MEMORYFOOTPRINTDIALOG_H
+
+#include <wx/wx.h>
+#include <wx/listctrl.h>
+#include "MemoryFootprintEstimator.h"
+
+class MemoryFootprintDialog : public wxDialog {
+	DECLARE_CLASS(MemoryFootprintDialog)
+	DECLARE_EVENT_TABLE()
+
+public:
+	// Constructors
+	MemoryFootprintDialog(const MemoryFootprintEstimator *estimator);
+	MemoryFootprintDialog(
+		const MemoryFootprintEstimator *estimator,
+		wxWindow* parent,
+		wxWindowID id = wxID_ANY,
+		const wxString& caption = wxT("Estimated memory footprint"),
+		const wxPoint& pos = wxDefaultPosition,
+		const wxSize& size = wxDefaultSize,
+		long style = wxCAPTION|wxRESIZE_BORDER|wxSYSTEM_MENU|wxCLOSE_BOX
+	);
+
+	~MemoryFootprintDialog();
+
+	// Initialize our variables
+	void Init(const MemoryFootprintEstimator *estimator);
+
+	// Creation
+	bool Create(
+		wxWindow* parent,
+		wxWindowID id = wxID_ANY,
+		const wxString& caption = wxT("Estimated memory footprint"),
+		const wxPoint& pos = wxDefaultPosition,
+		const wxSize& size = wxDefaultSize,
+		long style = wxCAPTION|wxRESIZE_BORDER|wxSYSTEM_MENU|wxCLOSE_BOX
+	);
+
+	// Creates the controls and sizers
+	void CreateControls();
+
+private:
+	const MemoryFootprintEstimator *m_estimator;
+	int m_sortColumn;
+	bool m_sortAscending;
+
+	wxListCtrl *m_footprintList;
+
+	// Event methods
+	void OnColumnClick(wxListEvent& event);
+
+	void FillList();
+	static int wxCALLBACK CompareRows(wxIntPtr item1, wxIntPtr item2, wxIntPtr sortData);
+	static wxString FormatSize(unsigned long long bytes);
+};
+
+#endif
@@ -0,0 +1,297 @@
+/*
+ * MemoryFootprintEstimator.cpp is part of GoOdf.
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * GoOdf is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GoOdf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GoOdf.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#include "MemoryFootprintEstimator.h"
+#include "Organ.h"
+#include "WAVfileParser.h"
+#include "WorkerPool.h"
+#include "Instrumentation.h"
+#include "GOODFFunctions.h"
+#include <algorithm>
+
+// Rough assumptions of how GrandOrgue holds the samples in memory: each
+// loop gets a copy of the frames around its end, and the lossless
+// compression keeps about this share of the data.
+static const unsigned LOOP_END_FRAMES = 1024;
+static const double COMPRESSED_SHARE = 0.6;
+
+MemoryFootprintEstimator::MemoryFootprintEstimator(Organ *organ) {
+	m_organ = organ;
+}
+
+MemoryFootprintEstimator::~MemoryFootprintEstimator() {
+
+}
+
+bool MemoryFootprintEstimator::estimate(const std::function<bool(size_t, size_t)> &progress) {
+	ScopedTimer timer("analysis.estimateMemoryFootprint");
+	m_paths.clear();
+	m_pathIndexes.clear();
+	m_samples.clear();
+	m_pipeBytes.clear();
+	m_pipeSamples.clear();
+	m_rows.clear();
+
+	std::vector<Rank*> ranks = getAllRanks();
+	collectSampleFiles(ranks);
+
+	// reading the headers is what takes time, the rest is just adding up
+	m_samples.resize(m_paths.size());
+	size_t total = m_paths.size();
+	bool completed = WorkerPool::run(
+		m_paths.size(),
+		[this](size_t index) { readSampleInfo(m_paths[index], m_samples[index]); },
+		[&](size_t done) { return !progress || progress(done, total); }
+	);
+	if (!completed)
+		return false;
+
+	m_total.type = RANK_ROW;
+	m_total.name = wxT("Total");
+	m_total.numberOfSamples = 0;
+	m_total.bytes.assign(getLoadingSettings().size(), 0);
+
+	for (unsigned i = 0; i < m_organ->getNumberOfRanks(); i++) {
+		Rank *rank = m_organ->getOrganRankAt(i);
+		FOOTPRINT_ROW row = estimateRank(rank, rank->getName());
+		m_rows.push_back(row);
+		m_total.numberOfSamples += row.numberOfSamples;
+		for (unsigned s = 0; s < row.bytes.size(); s++)
+			m_total.bytes[s] += row.bytes[s];
+	}
+
+	for (unsigned i = 0; i < m_organ->getNumberOfStops(); i++) {
+		Stop *stop = m_organ->getOrganStopAt(i);
+		FOOTPRINT_ROW row;
+		row.type = STOP_ROW;
+		row.name = stop->getName();
+		if (stop->getOwningManual())
+			row.name += wxT(" (") + stop->getOwningManual()->getName() + wxT(")");
+		row.numberOfSamples = 0;
+		row.bytes.assign(getLoadingSettings().size(), 0);
+		if (stop->isUsingInternalRank()) {
+			// the internal rank isn't listed on its own
+			FOOTPRINT_ROW rankRow = estimateRank(stop->getInternalRank(), stop->getName());
+			row.numberOfSamples = rankRow.numberOfSamples;
+			row.bytes = rankRow.bytes;
+			m_total.numberOfSamples += rankRow.numberOfSamples;
+			for (unsigned s = 0; s < rankRow.bytes.size(); s++)
+				m_total.bytes[s] += rankRow.bytes[s];
+		} else {
+			for (unsigned j = 0; j < stop->getNumberOfRanks(); j++) {
+				RankReference *ref = stop->getRankReferenceAt(j);
+				int pipeCount = ref->m_pipeCount > 0 ? ref->m_pipeCount : stop->getNumberOfAccessiblePipes();
+				if (ref->m_firstPipeNumber > 0 && pipeCount > 0)
+					addPipesToRow(row, ref->m_rankReference, ref->m_firstPipeNumber - 1, pipeCount);
+			}
+		}
+		m_rows.push_back(row);
+	}
+	return true;
+}
+
+const std::vector<MemoryFootprintEstimator::LOADING_SETTINGS>& MemoryFootprintEstimator::getLoadingSettings() {
+	static const std::vector<LOADING_SETTINGS> settings = {
+		{ wxT("24 bit stereo"), 24, false, false },
+		{ wxT("24 bit stereo compressed"), 24, true, false },
+		{ wxT("16 bit stereo"), 16, false, false },
+		{ wxT("16 bit stereo compressed"), 16, true, false },
+		{ wxT("16 bit mono"), 16, false, true },
+		{ wxT("16 bit mono compressed"), 16, true, true }
+	};
+	return settings;
+}
+
+const std::vector<MemoryFootprintEstimator::FOOTPRINT_ROW>& MemoryFootprintEstimator::getRows() const {
+	return m_rows;
+}
+
+const MemoryFootprintEstimator::FOOTPRINT_ROW& MemoryFootprintEstimator::getTotal() const {
+	return m_total;
+}
+
+unsigned MemoryFootprintEstimator::getNumberOfUnreadableFiles() const {
+	unsigned unreadable = 0;
+	for (const SAMPLE_INFO &info : m_samples) {
+		if (!info.isReadable)
+			unreadable++;
+	}
+	return unreadable;
+}
+
+std::vector<Rank*> MemoryFootprintEstimator::getAllRanks() {
+	std::vector<Rank*> ranks;
+	for (unsigned i = 0; i < m_organ->getNumberOfRanks(); i++)
+		ranks.push_back(m_organ->getOrganRankAt(i));
+	for (unsigned i = 0; i < m_organ->getNumberOfStops(); i++) {
+		Stop *stop = m_organ->getOrganStopAt(i);
+		if (stop->isUsingInternalRank())
+			ranks.push_back(stop->getInternalRank());
+	}
+	return ranks;
+}
+
+void MemoryFootprintEstimator::collectSampleFiles(const std::vector<Rank*> &ranks) {
+	auto addPath = [this](const wxString &path) {
+		if (!GOODF_functions::isSampleFilePath(path))
+			return;
+		if (m_pathIndexes.find(path) == m_pathIndexes.end()) {
+			m_pathIndexes[path] = m_paths.size();
+			m_paths.push_back(path);
+		}
+	};
+
+	for (Rank *rank : ranks) {
+		rank->loadPipes();
+		for (Pipe &pipe : rank->m_pipes) {
+			for (Attack &atk : pipe.m_attacks)
+				addPath(atk.fullPath);
+			for (Release &rel : pipe.m_releases)
+				addPath(rel.fullPath);
+		}
+	}
+}
+
+void MemoryFootprintEstimator::readSampleInfo(const wxString &path, SAMPLE_INFO &info) {
+	WAVfileParser sample(path);
+	info.isReadable = sample.isWavOk();
+	info.numberOfFrames = sample.getNumberOfFrames();
+	info.numberOfChannels = sample.getNumberOfChannels();
+	info.bitsPerSample = sample.getBitsPerSample();
+	info.cuePoint = sample.getNumberOfCues() > 0 ? (int) sample.getCuepointAtIndex(0).dwSampleOffset : -1;
+	for (unsigned i = 0; i < sample.getNumberOfLoops(); i++) {
+		LOOP loop = sample.getLoopAtIndex(i);
+		info.loops.push_back(std::make_pair(loop.dwStart, loop.dwEnd));
+	}
+	Instrumentation::count(Instrumentation::FILES_PARSED);
+}
+
+const MemoryFootprintEstimator::SAMPLE_INFO* MemoryFootprintEstimator::getSampleInfo(const wxString &path) {
+	auto it = m_pathIndexes.find(path);
+	if (it == m_pathIndexes.end() || !m_samples[it->second].isReadable)
+		return NULL;
+	return &m_samples[it->second];
+}
+
+unsigned MemoryFootprintEstimator::getAttackFrames(const Attack &atk, const SAMPLE_INFO &info) {
+	unsigned start = atk.attackStart > 0 ? std::min((unsigned) atk.attackStart, info.numberOfFrames) : 0;
+	unsigned releaseEnd = atk.releaseEnd > 0 ? std::min((unsigned) atk.releaseEnd, info.numberOfFrames) : info.numberOfFrames;
+
+	// the loops of the attack replace those of the file
+	std::vector<std::pair<unsigned, unsigned>> loops;
+	if (!atk.m_loops.empty()) {
+		for (const Loop &loop : atk.m_loops)
+			loops.push_back(std::make_pair((unsigned) loop.start, (unsigned) loop.end));
+	} else {
+		loops = info.loops;
+	}
+
+	if (loops.empty())
+		return releaseEnd > start ? releaseEnd - start : 0;
+
+	unsigned loopEnd = 0;
+	for (auto &loop : loops)
+		loopEnd = std::max(loopEnd, std::min(loop.second + 1, info.numberOfFrames));
+	unsigned frames = loopEnd > start ? loopEnd - start : 0;
+	frames += loops.size() * LOOP_END_FRAMES;
+
+	if (atk.loadRelease) {
+		int cue = atk.cuePoint >= 0 ? atk.cuePoint : info.cuePoint;
+		if (cue >= 0 && (unsigned) cue < releaseEnd)
+			frames += releaseEnd - cue;
+	}
+	return frames;
+}
+
+unsigned MemoryFootprintEstimator::getReleaseFrames(const Release &rel, const SAMPLE_INFO &info) {
+	int cue = rel.cuePoint >= 0 ? rel.cuePoint : info.cuePoint;
+	unsigned start = cue > 0 ? std::min((unsigned) cue, info.numberOfFrames) : 0;
+	unsigned end = rel.releaseEnd > 0 ? std::min((unsigned) rel.releaseEnd, info.numberOfFrames) : info.numberOfFrames;
+	return end > start ? end - start : 0;
+}
+
+unsigned long long MemoryFootprintEstimator::getBytes(unsigned frames, const SAMPLE_INFO &info, const LOADING_SETTINGS &settings) {
+	// GrandOrgue never stores more bits than the file has, and a value
+	// takes one, two or three bytes
+	unsigned bits = std::min(info.bitsPerSample ? info.bitsPerSample : 16, settings.bitsPerSample);
+	unsigned bytesPerValue = bits <= 8 ? 1 : (bits <= 16 ? 2 : 3);
+	unsigned channels = settings.mono ? 1 : std::max(info.numberOfChannels, 1u);
+	unsigned long long bytes = (unsigned long long) frames * channels * bytesPerValue;
+	if (settings.compressed)
+		bytes = (unsigned long long) (bytes * COMPRESSED_SHARE);
+	return bytes;
+}
+
+MemoryFootprintEstimator::FOOTPRINT_ROW MemoryFootprintEstimator::estimateRank(Rank *rank, const wxString &name) {
+	const std::vector<LOADING_SETTINGS> &settings = getLoadingSettings();
+	std::vector<std::vector<unsigned long long>> &pipeBytes = m_pipeBytes[rank];
+	std::vector<unsigned> &pipeSamples = m_pipeSamples[rank];
+	pipeBytes.clear();
+	pipeSamples.clear();
+
+	FOOTPRINT_ROW row;
+	row.type = RANK_ROW;
+	row.name = name;
+	row.numberOfSamples = 0;
+	row.bytes.assign(settings.size(), 0);
+	for (Pipe &pipe : rank->m_pipes) {
+		std::vector<unsigned long long> bytes(settings.size(), 0);
+		unsigned samples = 0;
+		for (Attack &atk : pipe.m_attacks) {
+			const SAMPLE_INFO *info = getSampleInfo(atk.fullPath);
+			if (!info)
+				continue;
+			unsigned frames = getAttackFrames(atk, *info);
+			for (unsigned s = 0; s < settings.size(); s++)
+				bytes[s] += getBytes(frames, *info, settings[s]);
+			samples++;
+		}
+		for (Release &rel : pipe.m_releases) {
+			const SAMPLE_INFO *info = getSampleInfo(rel.fullPath);
+			if (!info)
+				continue;
+			unsigned frames = getReleaseFrames(rel, *info);
+			for (unsigned s = 0; s < settings.size(); s++)
+				bytes[s] += getBytes(frames, *info, settings[s]);
+			samples++;
+		}
+		for (unsigned s = 0; s < settings.size(); s++)
+			row.bytes[s] += bytes[s];
+		row.numberOfSamples += samples;
+		pipeBytes.push_back(bytes);
+		pipeSamples.push_back(samples);
+	}
+	return row;
+}
+
+void MemoryFootprintEstimator::addPipesToRow(FOOTPRINT_ROW &row, Rank *rank, unsigned firstPipe, unsigned numberOfPipes) {
+	auto it = m_pipeBytes.find(rank);
+	if (it == m_pipeBytes.end())
+		return;
+	std::vector<std::vector<unsigned long long>> &pipeBytes = it->second;
+	unsigned lastPipe = std::min((size_t) firstPipe + numberOfPipes, pipeBytes.size());
+	for (unsigned p = firstPipe; p < lastPipe; p++) {
+		for (unsigned s = 0; s < row.bytes.size(); s++)
+			row.bytes[s] += pipeBytes[p][s];
+	}
+	std::vector<unsigned> &pipeSamples = m_pipeSamples[rank];
+	for (unsigned p = firstPipe; p < lastPipe; p++)
+		row.numberOfSamples += pipeSamples[p];
+}
@@ -0,0 +1,104 @@
+/*
+ * MemoryFootprintEstimator.h is part of GoOdf.
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * GoOdf is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GoOdf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GoOdf.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#ifndef MEMORYFOOTPRINTESTIMATOR_H
+#define MEMORYFOOTPRINTESTIMATOR_H
+
+#include <wx/wx.h>
+#include <vector>
+#include <map>
+#include <functional>
+
+class Organ;
+class Rank;
+class Attack;
+class Release;
+
+// Estimates how much memory GrandOrgue needs for the samples of an organ
+// from the metadata of the sample files only. The attack is counted from
+// its start to the end of the last loop (or to the release end if there
+// are no loops) and any release from its cue to its end, at a number of
+// common GrandOrgue sample loading settings.
+class MemoryFootprintEstimator {
+public:
+	struct LOADING_SETTINGS {
+		wxString label;
+		unsigned bitsPerSample;
+		bool compressed;
+		bool mono;
+	};
+
+	enum ROW_TYPE {
+		RANK_ROW = 0,
+		STOP_ROW
+	};
+
+	struct FOOTPRINT_ROW {
+		ROW_TYPE type;
+		wxString name;
+		unsigned numberOfSamples;
+		std::vector<unsigned long long> bytes; // for each of the loading settings
+	};
+
+	MemoryFootprintEstimator(Organ *organ);
+	~MemoryFootprintEstimator();
+
+	// The progress gets the number of read sample files and the total
+	// number of them and can return false to cancel the estimation
+	bool estimate(const std::function<bool(size_t, size_t)> &progress = nullptr);
+
+	static const std::vector<LOADING_SETTINGS>& getLoadingSettings();
+	const std::vector<FOOTPRINT_ROW>& getRows() const;
+	// Ranks only, as the stops use the pipes of the ranks
+	const FOOTPRINT_ROW& getTotal() const;
+	unsigned getNumberOfUnreadableFiles() const;
+
+private:
+	struct SAMPLE_INFO {
+		bool isReadable;
+		unsigned numberOfFrames;
+		unsigned numberOfChannels;
+		unsigned bitsPerSample;
+		int cuePoint;
+		std::vector<std::pair<unsigned, unsigned>> loops;
+	};
+
+	Organ *m_organ;
+	std::vector<wxString> m_paths;
+	std::map<wxString, unsigned> m_pathIndexes;
+	std::vector<SAMPLE_INFO> m_samples;
+	// the estimate of each pipe of each rank for each setting
+	std::map<Rank*, std::vector<std::vector<unsigned long long>>> m_pipeBytes;
+	std::map<Rank*, std::vector<unsigned>> m_pipeSamples;
+	std::vector<FOOTPRINT_ROW> m_rows;
+	FOOTPRINT_ROW m_total;
+
+	std::vector<Rank*> getAllRanks();
+	void collectSampleFiles(const std::vector<Rank*> &ranks);
+	void readSampleInfo(const wxString &path, SAMPLE_INFO &info);
+	const SAMPLE_INFO* getSampleInfo(const wxString &path);
+	unsigned getAttackFrames(const Attack &atk, const SAMPLE_INFO &info);
+	unsigned getReleaseFrames(const Release &rel, const SAMPLE_INFO &info);
+	unsigned long long getBytes(unsigned frames, const SAMPLE_INFO &info, const LOADING_SETTINGS &settings);
+	FOOTPRINT_ROW estimateRank(Rank *rank, const wxString &name);
+	void addPipesToRow(FOOTPRINT_ROW &row, Rank *rank, unsigned firstPipe, unsigned numberOfPipes);
+};
+
+#endif
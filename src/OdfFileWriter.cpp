@@ -0,0 +1,196 @@
+/*
+ * OdfFileWriter.cpp is part of GoOdf.
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * GoOdf is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GoOdf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GoOdf.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#include "OdfFileWriter.h"
+#include <wx/file.h>
+#include <wx/filename.h>
+#include <string>
+#include "Instrumentation.h"
+#ifdef __WXMSW__
+#include <wx/msw/wrapwin.h>
+#else
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cstdio>
+#endif
+
+// Encodes and writes the lines on a worker thread
+class OdfWritingThread : public wxThread {
+public:
+	OdfWritingThread(OdfFileWriter *writer) : wxThread(wxTHREAD_JOINABLE) {
+		m_writer = writer;
+	}
+
+protected:
+	virtual ExitCode Entry() {
+		m_writer->writeFile();
+		return (ExitCode) 0;
+	}
+
+private:
+	OdfFileWriter *m_writer;
+};
+
+OdfFileWriter::OdfFileWriter(wxString filePath, wxEvtHandler *handler, int eventId) {
+	m_filePath = filePath.Clone();
+	m_modificationCount = 0;
+	m_thread = NULL;
+	m_handler = handler;
+	m_eventId = eventId;
+	m_result = NOT_WRITTEN;
+}
+
+OdfFileWriter::~OdfFileWriter() {
+	wait();
+}
+
+wxTextFile* OdfFileWriter::getLines() {
+	return &m_lines;
+}
+
+std::map<wxString, unsigned long long>* OdfFileWriter::getCachedSections() {
+	return &m_cachedSections;
+}
+
+void OdfFileWriter::setModificationCount(unsigned count) {
+	m_modificationCount = count;
+}
+
+unsigned OdfFileWriter::getModificationCount() {
+	return m_modificationCount;
+}
+
+void OdfFileWriter::start() {
+	// from here on the lines belong to the worker until it's done
+	m_thread = new OdfWritingThread(this);
+	if (m_thread->Run() != wxTHREAD_NO_ERROR) {
+		// write here instead, the result is announced in the same way
+		delete m_thread;
+		m_thread = NULL;
+		writeFile();
+	}
+}
+
+void OdfFileWriter::wait() {
+	if (m_thread) {
+		m_thread->Wait();
+		delete m_thread;
+		m_thread = NULL;
+	}
+}
+
+wxString OdfFileWriter::getFilePath() {
+	return m_filePath;
+}
+
+OdfFileWriter::Result OdfFileWriter::getResult() {
+	return m_result;
+}
+
+void OdfFileWriter::writeFile() {
+	ScopedTimer writeTimer("save.encodeAndWrite");
+	wxString tempPath = m_filePath + wxT(".saving");
+	wxCSConv latin1("ISO-8859-1");
+	wxCSConv utf8("UTF-8");
+	if (isEncodingOk(latin1)) {
+		m_result = writeTempFile(tempPath, latin1, false) && replaceFile(tempPath, m_filePath) ? WRITTEN : WRITING_FAILED;
+	} else if (isEncodingOk(utf8)) {
+		m_result = writeTempFile(tempPath, utf8, true) && replaceFile(tempPath, m_filePath) ? WRITTEN_AS_UTF8 : WRITING_FAILED;
+	} else {
+		m_result = ENCODING_FAILED;
+	}
+	if (m_result == WRITING_FAILED && wxFileExists(tempPath))
+		wxRemoveFile(tempPath);
+
+	wxThreadEvent *event = new wxThreadEvent(wxEVT_THREAD, m_eventId);
+	event->SetPayload(this);
+	wxQueueEvent(m_handler, event);
+}
+
+// iterate through the lines checking that the conversion would work
+bool OdfFileWriter::isEncodingOk(wxMBConv &conv) {
+	if (!conv.IsOk())
+		return false;
+	for (size_t i = 0; i < m_lines.GetLineCount(); i++) {
+		if (conv.FromWChar(NULL, 0, m_lines.GetLine(i).wc_str()) == wxCONV_FAILED)
+			return false;
+	}
+	return true;
+}
+
+bool OdfFileWriter::writeTempFile(const wxString &tempPath, wxMBConv &conv, bool addBom) {
+	// a replaced file keeps the permissions it had
+	int permissions = wxS_DEFAULT;
+#ifndef __WXMSW__
+	struct stat targetStat;
+	if (stat(m_filePath.fn_str(), &targetStat) == 0)
+		permissions = targetStat.st_mode & 0777;
+#endif
+	wxFile outFile;
+	if (!outFile.Create(tempPath, true, permissions))
+		return false;
+
+	// the encoded lines are collected and written in larger blocks
+	const size_t blockSize = 64 * 1024;
+	std::string block;
+	block.reserve(blockSize + 1024);
+	if (addBom)
+		block.append("\xef\xbb\xbf");
+	bool isOk = true;
+	for (size_t i = 0; i < m_lines.GetLineCount() && isOk; i++) {
+		wxCharBuffer encoded = m_lines.GetLine(i).mb_str(conv);
+		block.append(encoded.data(), encoded.length());
+		block.append("\r\n");
+		if (block.size() >= blockSize) {
+			isOk = outFile.Write(block.data(), block.size()) == block.size();
+			block.clear();
+		}
+	}
+	if (isOk && !block.empty())
+		isOk = outFile.Write(block.data(), block.size()) == block.size();
+
+	// make sure the content is on disk before the file replaces the old one
+	if (isOk)
+		isOk = outFile.Flush();
+	return outFile.Close() && isOk;
+}
+
+bool OdfFileWriter::replaceFile(const wxString &tempPath, const wxString &targetPath) {
+#ifdef __WXMSW__
+	return ::MoveFileExW(tempPath.wc_str(), targetPath.wc_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+	// the content must be on disk before the file replaces the old one
+	int fileFd = ::open(tempPath.fn_str(), O_RDONLY);
+	if (fileFd < 0)
+		return false;
+	bool isSynced = ::fsync(fileFd) == 0;
+	::close(fileFd);
+	if (!isSynced || ::rename(tempPath.fn_str(), targetPath.fn_str()) != 0)
+		return false;
+	// the rename itself is only durable once the directory is synced
+	int dirFd = ::open(wxFileName(targetPath).GetPath().fn_str(), O_RDONLY);
+	if (dirFd >= 0) {
+		::fsync(dirFd);
+		::close(dirFd);
+	}
+	return true;
+#endif
+}
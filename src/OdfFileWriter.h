@@ -0,0 +1,81 @@
+/*
+ * OdfFileWriter.h is part of GoOdf.
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * GoOdf is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GoOdf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GoOdf.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#ifndef ODFFILEWRITER_H
+#define ODFFILEWRITER_H
+
+#include <wx/wx.h>
+#include <wx/thread.h>
+#include <wx/textfile.h>
+#include <map>
+
+// Writes an .organ file on a worker thread from the lines the organ has been
+// serialized into, so that editing can go on while the file is written. The
+// lines go to a temporary file next to the target that is flushed to disk and
+// then renamed over it, a failed write thus never leaves a partial file. When
+// done a wxThreadEvent with the writer as payload is queued to the handler.
+class OdfFileWriter {
+public:
+	enum Result {
+		NOT_WRITTEN,
+		WRITTEN,
+		WRITTEN_AS_UTF8,
+		ENCODING_FAILED,
+		WRITING_FAILED
+	};
+
+	OdfFileWriter(wxString filePath, wxEvtHandler *handler, int eventId);
+	~OdfFileWriter();
+
+	wxTextFile* getLines();
+	std::map<wxString, unsigned long long>* getCachedSections();
+	void setModificationCount(unsigned count);
+	unsigned getModificationCount();
+	void start();
+	void wait();
+
+	wxString getFilePath();
+	Result getResult();
+
+	// Durably replaces the target with the finished temporary file next to
+	// it, also for other files that are replaced the same way
+	static bool replaceFile(const wxString &tempPath, const wxString &targetPath);
+
+private:
+	wxString m_filePath;
+	wxTextFile m_lines;
+	std::map<wxString, unsigned long long> m_cachedSections;
+	unsigned m_modificationCount;
+	wxThread *m_thread;
+	wxEvtHandler *m_handler;
+	int m_eventId;
+	Result m_result;
+
+	void writeFile();
+	bool isEncodingOk(wxMBConv &conv);
+	bool writeTempFile(const wxString &tempPath, wxMBConv &conv, bool addBom);
+
+	friend class OdfWritingThread;
+
+	OdfFileWriter(const OdfFileWriter&) = delete;
+	OdfFileWriter& operator=(const OdfFileWriter&) = delete;
+};
+
+#endif
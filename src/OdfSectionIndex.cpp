@@ -0,0 +1,181 @@
+/*
+ * OdfSectionIndex.cpp is part of GoOdf.
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * GoOdf is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GoOdf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GoOdf.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#include "OdfSectionIndex.h"
+#include <wx/file.h>
+#include <cstring>
+#include "Instrumentation.h"
+
+OdfSectionIndex::OdfSectionIndex() {
+	m_isUtf8 = false;
+}
+
+OdfSectionIndex::~OdfSectionIndex() {
+
+}
+
+bool OdfSectionIndex::build(const wxString &filePath) {
+	ScopedTimer indexTimer("import.indexSections");
+	m_filePath = filePath;
+	m_sections.clear();
+	wxFile odfFile;
+	if (!odfFile.Open(filePath))
+		return false;
+	wxFileOffset length = odfFile.Length();
+	if (length < 0)
+		return false;
+	m_content.assign(length, '\0');
+	if (length > 0 && odfFile.Read(&m_content[0], length) != length)
+		return false;
+	Instrumentation::count(Instrumentation::BYTES_READ, (long long) length);
+
+	// same as the full parser: UTF-8 if marked or valid as such, otherwise ISO-8859-1
+	size_t pos = 0;
+	if (m_content.compare(0, 3, "\xef\xbb\xbf") == 0) {
+		m_isUtf8 = true;
+		pos = 3;
+	} else {
+		m_isUtf8 = wxConvUTF8.ToWChar(NULL, 0, m_content.data(), m_content.size()) != wxCONV_FAILED;
+	}
+
+	Section *current = NULL;
+	size_t size = m_content.size();
+	while (pos < size) {
+		size_t lineEnd = m_content.find('\n', pos);
+		if (lineEnd == std::string::npos)
+			lineEnd = size;
+		size_t first = pos;
+		while (first < lineEnd && (m_content[first] == ' ' || m_content[first] == '\t'))
+			first++;
+		if (first < lineEnd && m_content[first] == '[') {
+			size_t close = m_content.find(']', first);
+			if (close != std::string::npos && close < lineEnd) {
+				if (current)
+					current->end = pos;
+				Section &section = m_sections[decode(first + 1, close - first - 1)];
+				section.begin = lineEnd < size ? lineEnd + 1 : size;
+				section.end = size;
+				section.nameBegin = 0;
+				section.nameLength = 0;
+				current = &section;
+			}
+		} else if (current && current->nameLength == 0 && m_content.compare(first, 5, "Name=") == 0) {
+			current->nameBegin = first + 5;
+			current->nameLength = lineEnd - current->nameBegin;
+		}
+		pos = lineEnd + 1;
+	}
+	return true;
+}
+
+wxString OdfSectionIndex::getFilePath() const {
+	return m_filePath;
+}
+
+bool OdfSectionIndex::hasSection(const wxString &section) const {
+	return m_sections.find(section) != m_sections.end();
+}
+
+wxString OdfSectionIndex::getName(const wxString &section) const {
+	std::map<wxString, Section>::const_iterator it = m_sections.find(section);
+	if (it == m_sections.end() || it->second.nameLength == 0)
+		return wxEmptyString;
+	return cleanValue(it->second.nameBegin, it->second.nameLength);
+}
+
+wxString OdfSectionIndex::readValue(const wxString &section, const wxString &key, const wxString &defaultValue) const {
+	std::map<wxString, Section>::const_iterator it = m_sections.find(section);
+	if (it == m_sections.end())
+		return defaultValue;
+	const wxScopedCharBuffer keyBytes = key.utf8_str();
+	size_t pos = it->second.begin;
+	size_t keyBegin, keyLength, valueBegin, valueLength;
+	while (nextEntry(pos, it->second.end, keyBegin, keyLength, valueBegin, valueLength)) {
+		if (keyLength == keyBytes.length() && memcmp(m_content.data() + keyBegin, keyBytes.data(), keyLength) == 0)
+			return cleanValue(valueBegin, valueLength);
+	}
+	return defaultValue;
+}
+
+long OdfSectionIndex::readLong(const wxString &section, const wxString &key, long defaultValue) const {
+	long value;
+	if (readValue(section, key).ToLong(&value))
+		return value;
+	return defaultValue;
+}
+
+wxFileConfig* OdfSectionIndex::createSectionConfig(const wxString &section) const {
+	// filled the same way as a rank reads its deferred pipes
+	wxFileConfig *cfg = new wxFileConfig(wxEmptyString, wxEmptyString, wxEmptyString, wxEmptyString, wxCONFIG_USE_NO_ESCAPE_CHARACTERS);
+	cfg->SetExpandEnvVars(false);
+	cfg->SetPath(wxT("/") + section);
+	std::map<wxString, Section>::const_iterator it = m_sections.find(section);
+	if (it != m_sections.end()) {
+		size_t pos = it->second.begin;
+		size_t keyBegin, keyLength, valueBegin, valueLength;
+		while (nextEntry(pos, it->second.end, keyBegin, keyLength, valueBegin, valueLength))
+			cfg->Write(decode(keyBegin, keyLength), cleanValue(valueBegin, valueLength));
+	}
+	return cfg;
+}
+
+wxString OdfSectionIndex::decode(size_t begin, size_t length) const {
+	if (m_isUtf8)
+		return wxString::FromUTF8(m_content.data() + begin, length);
+	return wxString(m_content.data() + begin, wxConvISO8859_1, length);
+}
+
+// Finds the next key=value line, skipping empty lines and comments
+bool OdfSectionIndex::nextEntry(size_t &pos, size_t end, size_t &keyBegin, size_t &keyLength, size_t &valueBegin, size_t &valueLength) const {
+	while (pos < end) {
+		size_t lineEnd = m_content.find('\n', pos);
+		if (lineEnd == std::string::npos || lineEnd > end)
+			lineEnd = end;
+		size_t first = pos;
+		pos = lineEnd + 1;
+		while (first < lineEnd && (m_content[first] == ' ' || m_content[first] == '\t'))
+			first++;
+		if (first == lineEnd || m_content[first] == ';' || m_content[first] == '#')
+			continue;
+		size_t equals = m_content.find('=', first);
+		if (equals == std::string::npos || equals >= lineEnd)
+			continue;
+		size_t keyEnd = equals;
+		while (keyEnd > first && (m_content[keyEnd - 1] == ' ' || m_content[keyEnd - 1] == '\t'))
+			keyEnd--;
+		keyBegin = first;
+		keyLength = keyEnd - first;
+		valueBegin = equals + 1;
+		valueLength = lineEnd - valueBegin;
+		return true;
+	}
+	return false;
+}
+
+// Removes comments and surrounding whitespace like the full parser does
+wxString OdfSectionIndex::cleanValue(size_t valueBegin, size_t valueLength) const {
+	wxString value = decode(valueBegin, valueLength);
+	int semicolonPos = value.Find(wxT(";"));
+	if (semicolonPos != wxNOT_FOUND)
+		value = value.substr(0, semicolonPos);
+	value.Trim(false);
+	value.Trim();
+	return value;
+}
@@ -0,0 +1,68 @@
+/*
+ * OdfSectionIndex.h is part of GoOdf.
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * GoOdf is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GoOdf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GoOdf.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#ifndef ODFSECTIONINDEX_H
+#define ODFSECTIONINDEX_H
+
+#include <wx/wx.h>
+#include <wx/fileconf.h>
+#include <map>
+#include <string>
+
+// Locates every [section] of an .organ file in one scan of its content so
+// that single sections can be read without parsing the whole file. The Name
+// of each section is picked up during the scan, anything else is read from
+// the section itself when asked for.
+class OdfSectionIndex {
+public:
+	OdfSectionIndex();
+	~OdfSectionIndex();
+
+	bool build(const wxString &filePath);
+	wxString getFilePath() const;
+
+	bool hasSection(const wxString &section) const;
+	wxString getName(const wxString &section) const;
+	wxString readValue(const wxString &section, const wxString &key, const wxString &defaultValue = wxEmptyString) const;
+	long readLong(const wxString &section, const wxString &key, long defaultValue) const;
+
+	// An in-memory config holding just the section, with the path set to it.
+	// The values are cleaned up like the full parser does. Caller deletes it.
+	wxFileConfig* createSectionConfig(const wxString &section) const;
+
+private:
+	struct Section {
+		size_t begin;
+		size_t end;
+		size_t nameBegin;
+		size_t nameLength;
+	};
+
+	wxString m_filePath;
+	std::string m_content;
+	bool m_isUtf8;
+	std::map<wxString, Section> m_sections;
+
+	wxString decode(size_t begin, size_t length) const;
+	bool nextEntry(size_t &pos, size_t end, size_t &keyBegin, size_t &keyLength, size_t &valueBegin, size_t &valueLength) const;
+	wxString cleanValue(size_t valueBegin, size_t valueLength) const;
+};
+
+#endif
@@ -27,6 +27,10 @@ Organ::Organ() {
 	// Initialize a new blank organ
 	m_odfRoot = wxEmptyString;
 	m_isModified = false;
+	m_modificationCount = 0;
+	m_rankInSectionEdit = NULL;
+	m_fileExistenceCache = NULL;
+	m_context.setOrgan(this);
 	m_churchName = wxEmptyString;
 	m_churchAddress = wxEmptyString;
 	m_organBuilder = wxEmptyString;
@@ -60,7 +64,8 @@ Organ::~Organ() {
 
 }
 
-void Organ::writeOrgan(wxTextFile *outFile) {
+void Organ::writeOrgan(wxTextFile *outFile, std::map<wxString, unsigned long long> *cachedSections) {
+	OrganContextScope contextScope(&m_context);
 	// Header of odf file
 	outFile->AddLine(wxT("[Organ]"));
 	outFile->AddLine(wxT("ChurchName=") + m_churchName);
@@ -70,39 +75,39 @@ void Organ::writeOrgan(wxTextFile *outFile) {
 	outFile->AddLine(wxT("OrganComments=") + m_organComments);
 	outFile->AddLine(wxT("RecordingDetails=") + m_recordingDetails);
 	if (m_infoFilename != wxEmptyString) {
-		wxString infoFile = GOODF_functions::fixSeparator(GOODF_functions::removeBaseOdfPath(m_infoFilename));
+		wxString infoFile = GOODF_functions::fixSeparator(GOODF_functions::removeBaseOdfPath(m_infoFilename, m_context));
 		outFile->AddLine(wxT("InfoFilename=") + infoFile);
 	}
 	unsigned nbMan = m_Manuals.size();
 	if (m_hasPedals) {
 		nbMan--;
-		outFile->AddLine(wxT("NumberOfManuals=") + wxString::Format(wxT("%u"), nbMan));
+		GOODF_functions::addKeyLine(outFile, wxT("NumberOfManuals="), nbMan);
 		outFile->AddLine(wxT("HasPedals=Y"));
 	} else {
-		outFile->AddLine(wxT("NumberOfManuals=") + wxString::Format(wxT("%u"), nbMan));
+		GOODF_functions::addKeyLine(outFile, wxT("NumberOfManuals="), nbMan);
 		outFile->AddLine(wxT("HasPedals=N"));
 	}
 	unsigned nbEnc = m_Enclosures.size();
-	outFile->AddLine(wxT("NumberOfEnclosures=") + wxString::Format(wxT("%u"), nbEnc));
+	GOODF_functions::addKeyLine(outFile, wxT("NumberOfEnclosures="), nbEnc);
 	unsigned nbTrem = m_Tremulants.size();
-	outFile->AddLine(wxT("NumberOfTremulants=") + wxString::Format(wxT("%u"), nbTrem));
+	GOODF_functions::addKeyLine(outFile, wxT("NumberOfTremulants="), nbTrem);
 	unsigned nbWind = m_Windchestgroups.size();
-	outFile->AddLine(wxT("NumberOfWindchestGroups=") + wxString::Format(wxT("%u"), nbWind));
+	GOODF_functions::addKeyLine(outFile, wxT("NumberOfWindchestGroups="), nbWind);
 	unsigned nbRevPistons = m_ReversiblePistons.size();
-	outFile->AddLine(wxT("NumberOfReversiblePistons=") + wxString::Format(wxT("%u"), nbRevPistons));
+	GOODF_functions::addKeyLine(outFile, wxT("NumberOfReversiblePistons="), nbRevPistons);
 	unsigned nbGenerals = m_Generals.size();
-	outFile->AddLine(wxT("NumberOfGenerals=") + wxString::Format(wxT("%u"), nbGenerals));
+	GOODF_functions::addKeyLine(outFile, wxT("NumberOfGenerals="), nbGenerals);
 	unsigned nbDivCplrs = m_DivisionalCouplers.size();
-	outFile->AddLine(wxT("NumberOfDivisionalCouplers=") + wxString::Format(wxT("%u"), nbDivCplrs));
+	GOODF_functions::addKeyLine(outFile, wxT("NumberOfDivisionalCouplers="), nbDivCplrs);
 	// The number of panels is the additional panels, not the main [Panel000]
 	unsigned nbPanels = m_Panels.size() - 1;
-	outFile->AddLine(wxT("NumberOfPanels=") + wxString::Format(wxT("%u"), nbPanels));
+	GOODF_functions::addKeyLine(outFile, wxT("NumberOfPanels="), nbPanels);
 	unsigned nbSwitches = m_Switches.size();
 	if (nbSwitches)
-		outFile->AddLine(wxT("NumberOfSwitches=") + wxString::Format(wxT("%u"), nbSwitches));
+		GOODF_functions::addKeyLine(outFile, wxT("NumberOfSwitches="), nbSwitches);
 	unsigned nbRanks = m_Ranks.size();
 	if (nbRanks)
-		outFile->AddLine(wxT("NumberOfRanks=") + wxString::Format(wxT("%u"), nbRanks));
+		GOODF_functions::addKeyLine(outFile, wxT("NumberOfRanks="), nbRanks);
 	if (m_divisionalsStoreIntermanualCouplers)
 		outFile->AddLine(wxT("DivisionalsStoreIntermanualCouplers=Y"));
 	else
@@ -122,15 +127,15 @@ void Organ::writeOrgan(wxTextFile *outFile) {
 	if (!m_combinationsStoreNonDisplayedDrawstops)
 		outFile->AddLine(wxT("CombinationsStoreNonDisplayedDrawstops=N"));
 	if (m_amplitudeLevel != 100)
-		outFile->AddLine(wxT("AmplitudeLevel=") + wxString::Format(wxT("%f"), m_amplitudeLevel));
+		GOODF_functions::addKeyLine(outFile, wxT("AmplitudeLevel="), m_amplitudeLevel);
 	if (m_gain != 0)
-		outFile->AddLine(wxT("Gain=") + wxString::Format(wxT("%f"), m_gain));
+		GOODF_functions::addKeyLine(outFile, wxT("Gain="), m_gain);
 	if (m_pitchTuning != 0)
-		outFile->AddLine(wxT("PitchTuning=") + wxString::Format(wxT("%f"), m_pitchTuning));
+		GOODF_functions::addKeyLine(outFile, wxT("PitchTuning="), m_pitchTuning);
 	if (m_pitchCorrection != 0)
-		outFile->AddLine(wxT("PitchCorrection=") + wxString::Format(wxT("%f"), m_pitchCorrection));
+		GOODF_functions::addKeyLine(outFile, wxT("PitchCorrection="), m_pitchCorrection);
 	if (m_trackerDelay != 0)
-		outFile->AddLine(wxT("TrackerDelay=") + wxString::Format(wxT("%u"), m_trackerDelay));
+		GOODF_functions::addKeyLine(outFile, wxT("TrackerDelay="), m_trackerDelay);
 	if (m_isPercussive) {
 		outFile->AddLine(wxT("Percussive=Y"));
 		if (m_hasIndependentRelease) {
@@ -171,8 +176,7 @@ void Organ::writeOrgan(wxTextFile *outFile) {
 		i++;
 	}
 	if (m_Windchestgroups.empty()) {
-		wxLogWarning("There are no windchestgroups in the organ! The .organ file won't be functional!");
-		::wxGetApp().m_frame->GetLogWindow()->Show(true);
+		m_context.logWarning(wxT("There are no windchestgroups in the organ! The .organ file won't be functional!"));
 	}
 
 	// Couplers
@@ -222,8 +226,7 @@ void Organ::writeOrgan(wxTextFile *outFile) {
 	i = 1;
 	for (auto& sw : m_Switches) {
 		if (sw.getFunction().IsSameAs(wxT("Input")) && !isElementReferenced(&sw)) {
-			wxLogWarning("Switch %s has function Input but is not referenced anywhere.", sw.getName());
-			::wxGetApp().m_frame->GetLogWindow()->Show(true);
+			m_context.logWarning(wxString::Format("Switch %s has function Input but is not referenced anywhere.", sw.getName()));
 		}
 		wxString switchId = wxT("[Switch") + GOODF_functions::number_format(i) + wxT("]");
 		outFile->AddLine(switchId);
@@ -237,7 +240,14 @@ void Organ::writeOrgan(wxTextFile *outFile) {
 	for (auto& rank : m_Ranks) {
 		wxString rankId = wxT("[Rank") + GOODF_functions::number_format(i) + wxT("]");
 		outFile->AddLine(rankId);
-		rank.write(outFile);
+		if (!rank.m_sectionCache.isValid()) {
+			wxTextFile section;
+			rank.write(&section);
+			rank.m_sectionCache.store(&section);
+		}
+		rank.m_sectionCache.writeTo(outFile);
+		if (cachedSections)
+			(*cachedSections)[rankId] = rank.m_sectionCache.getStamp();
 		outFile->AddLine(wxT(""));
 		i++;
 	}
@@ -277,7 +287,14 @@ void Organ::writeOrgan(wxTextFile *outFile) {
 	for (auto& pan : m_Panels) {
 		wxString panelId = wxT("[Panel") + GOODF_functions::number_format(i) + wxT("]");
 		outFile->AddLine(panelId);
-		pan.write(outFile, i);
+		if (!pan.m_sectionCache.isValid()) {
+			wxTextFile section;
+			pan.write(&section, i);
+			pan.m_sectionCache.store(&section);
+		}
+		pan.m_sectionCache.writeTo(outFile);
+		if (cachedSections)
+			(*cachedSections)[panelId] = pan.m_sectionCache.getStamp();
 		outFile->AddLine(wxT(""));
 		i++;
 	}
@@ -488,6 +505,7 @@ void Organ::addEnclosure(Enclosure enclosure, bool isParsing) {
 }
 
 void Organ::removeEnclosureAt(unsigned index) {
+	m_context.structureWillChange();
 	std::list<Enclosure>::iterator it = m_Enclosures.begin();
 	std::advance(it, index);
 	m_Enclosures.erase(it);
@@ -526,6 +544,7 @@ void Organ::addTremulant(Tremulant tremulant, bool isParsing) {
 }
 
 void Organ::removeTremulantAt(unsigned index) {
+	m_context.structureWillChange();
 	std::list<Tremulant>::iterator it = m_Tremulants.begin();
 	std::advance(it, index);
 	// the tremulant can be referenced in a reversible piston so we just reset it
@@ -569,6 +588,7 @@ void Organ::addWindchestgroup(Windchestgroup windchest) {
 }
 
 void Organ::removeWindchestgroupAt(unsigned index) {
+	m_context.structureWillChange();
 	std::list<Windchestgroup>::iterator it = m_Windchestgroups.begin();
 	std::advance(it, index);
 	// now we're at the windchest to remove but first we should remove it from any stop/rank/pipe that have it set
@@ -587,6 +607,7 @@ void Organ::removeWindchestgroupAt(unsigned index) {
 		if (r.getWindchest() == &(*it)) {
 			r.setOnlyRankWindchest(NULL);
 		}
+		r.loadPipes();
 		for (Pipe &p : r.m_pipes) {
 			if (p.windchest == &(*it))
 				p.windchest = NULL;
@@ -596,6 +617,9 @@ void Organ::removeWindchestgroupAt(unsigned index) {
 }
 
 void Organ::moveWindchestgroup(int sourceIndex, int toBeforeIndex) {
+	m_context.structureWillChange();
+	// pipes not yet loaded refer to windchests by their current order
+	loadAllDeferredPipes();
 	auto theOneToMove = std::next(m_Windchestgroups.begin(), sourceIndex);
 	std::list<Windchestgroup>::iterator it = m_Windchestgroups.begin();
 
@@ -640,6 +664,7 @@ unsigned Organ::getIndexOfOrganSwitch(GoSwitch *switchToFind) {
 }
 
 void Organ::removeSwitchAt(unsigned index) {
+	m_context.structureWillChange();
 	if (index >= m_Switches.size())
 		return;
 
@@ -676,7 +701,7 @@ void Organ::removeSwitchAt(unsigned index) {
 	for (unsigned i = 0; i < m_Panels.size(); i++) {
 		if (getOrganPanelAt(i)->hasItemAsGuiElement(switchToRemove)) {
 			getOrganPanelAt(i)->removeItemFromPanel(switchToRemove);
-			::wxGetApp().m_frame->RebuildPanelGuiElementsInTree(i);
+			m_context.panelGuiElementsChanged(i);
 		}
 	}
 
@@ -712,6 +737,7 @@ void Organ::removeSwitchAt(unsigned index) {
 }
 
 void Organ::moveSwitch(int sourceIndex, int toBeforeIndex) {
+	m_context.structureWillChange();
 	auto theOneToMove = std::next(m_Switches.begin(), sourceIndex);
 	std::list<GoSwitch>::iterator it = m_Switches.begin();
 
@@ -775,12 +801,14 @@ void Organ::addRank(Rank rank) {
 }
 
 void Organ::removeRankAt(unsigned index) {
+	m_context.structureWillChange();
 	std::list<Rank>::iterator it = m_Ranks.begin();
 	std::advance(it, index);
 	m_Ranks.erase(it);
 }
 
 void Organ::moveRank(int sourceIndex, int toBeforeIndex) {
+	m_context.structureWillChange();
 	auto theOneToMove = std::next(m_Ranks.begin(), sourceIndex);
 	std::list<Rank>::iterator it = m_Ranks.begin();
 
@@ -825,6 +853,7 @@ void Organ::addStop(Stop stop, bool isParsing) {
 }
 
 void Organ::removeStopAt(unsigned index) {
+	m_context.structureWillChange();
 	std::list<Stop>::iterator it = m_Stops.begin();
 	std::advance(it, index);
 	// any other stop or rank can reference this stops' internal rank pipes, and if they do we should reset them to DUMMIES
@@ -843,6 +872,7 @@ void Organ::removeStopAt(unsigned index) {
 		}
 	}
 	for (Rank& r : m_Ranks) {
+		r.loadPipes();
 		for (Pipe& p : r.m_pipes) {
 			if (p.m_attacks.front().fileName.StartsWith(refStr, &rest)) {
 				p.m_attacks.front().fileName = wxT("DUMMY");
@@ -862,6 +892,7 @@ void Organ::removeStopAt(unsigned index) {
 }
 
 void Organ::removeStop(Stop *stop) {
+	m_context.structureWillChange();
 	unsigned index = 0;
 	for (Stop& s : m_Stops) {
 		if (&s == stop) {
@@ -869,7 +900,7 @@ void Organ::removeStop(Stop *stop) {
 			for (unsigned i = 0; i < m_Panels.size(); i++) {
 				if (getOrganPanelAt(i)->hasItemAsGuiElement(stop)) {
 					getOrganPanelAt(i)->removeItemFromPanel(stop);
-					::wxGetApp().m_frame->RebuildPanelGuiElementsInTree(i);
+					m_context.panelGuiElementsChanged(i);
 				}
 			}
 			// this stop should also be removed from any general
@@ -887,6 +918,7 @@ void Organ::removeStop(Stop *stop) {
 }
 
 bool Organ::moveStop(int srcManualIdx, int srcStopIdxOnManual, int dstManualIdx, int dstStopIdxOnManual) {
+	m_context.structureWillChange();
 	if (srcManualIdx < 0 || srcStopIdxOnManual < 0 || dstManualIdx < 0 || dstStopIdxOnManual < 0) {
 		return false;
 	}
@@ -971,6 +1003,7 @@ bool Organ::moveStop(int srcManualIdx, int srcStopIdxOnManual, int dstManualIdx,
 	}
 
 	for (Rank& r : m_Ranks) {
+		r.loadPipes();
 		for (Pipe& p : r.m_pipes) {
 			if (p.m_attacks.front().fileName.StartsWith(movedStopOriginalRef)) {
 				p.m_attacks.front().fileName.Replace(movedStopOriginalRef, movedStopNewRef, false);
@@ -999,6 +1032,7 @@ bool Organ::moveStop(int srcManualIdx, int srcStopIdxOnManual, int dstManualIdx,
 	}
 
 	for (Rank& r : m_Ranks) {
+		r.loadPipes();
 		for (Pipe& p : r.m_pipes) {
 			bool adjusted = std::find(std::begin(adjustedPipes), std::end(adjustedPipes), &p) != std::end(adjustedPipes);
 			if (adjusted) {
@@ -1023,6 +1057,12 @@ wxString Organ::getOdfRoot() {
 }
 
 void Organ::setOdfRoot(wxString root) {
+	// all sample and image paths are written relative to the root
+	if (root != m_odfRoot) {
+		// pipes not yet loaded must be resolved against the old root
+		loadAllDeferredPipes();
+		invalidateSectionCaches();
+	}
 	m_odfRoot = root;
 }
 
@@ -1053,6 +1093,7 @@ void Organ::updateManualPipeReferences(int sourceIdx, int newIdx) {
 	}
 
 	for (Rank& r : m_Ranks) {
+		r.loadPipes();
 		for (Pipe& p : r.m_pipes) {
 			if (p.m_attacks.front().fileName.StartsWith(searchFor)) {
 				p.m_attacks.front().fileName.Replace(searchFor, replaceWith, false);
@@ -1088,6 +1129,7 @@ void Organ::updatePipeReferencesFromPedalChoice() {
 		}
 
 		for (Rank& r : m_Ranks) {
+			r.loadPipes();
 			for (Pipe& p : r.m_pipes) {
 				if (p.m_attacks.front().fileName.StartsWith(wxT("REF:"))) {
 					wxString manStr = p.m_attacks.front().fileName.Mid(4, 3);
@@ -1124,6 +1166,7 @@ void Organ::updatePipeReferencesFromPedalChoice() {
 		}
 
 		for (Rank& r : m_Ranks) {
+			r.loadPipes();
 			for (Pipe& p : r.m_pipes) {
 				if (p.m_attacks.front().fileName.StartsWith(wxT("REF:"))) {
 					wxString manStr = p.m_attacks.front().fileName.Mid(4, 3);
@@ -1210,6 +1253,7 @@ void Organ::addManual(Manual manual, bool isParsing) {
 }
 
 void Organ::removeManualAt(unsigned index) {
+	m_context.structureWillChange();
 	std::list<Manual>::iterator it = m_Manuals.begin();
 	std::advance(it, index);
 	// remove the manual from any divisional coupler too
@@ -1223,6 +1267,7 @@ void Organ::removeManualAt(unsigned index) {
 }
 
 void Organ::moveManual(int sourceIndex, int toBeforeIndex) {
+	m_context.structureWillChange();
 	Manual *theManual = getOrganManualAt(sourceIndex);
 	auto theOneToMove = std::next(m_Manuals.begin(), sourceIndex);
 	std::list<Manual>::iterator it = m_Manuals.begin();
@@ -1240,7 +1285,7 @@ void Organ::moveManual(int sourceIndex, int toBeforeIndex) {
 	if (m_hasPedals && (toBeforeIndex == 0 || sourceIndex == 0)) {
 		for (Manual& man : m_Manuals) {
 			if (man.isThePedal()) {
-				man.setIsPedal(false);
+				man.setIsPedal(false, m_context);
 			}
 		}
 	}
@@ -1286,6 +1331,7 @@ void Organ::addCoupler(Coupler coupler, bool isParsing) {
 }
 
 void Organ::removeCouplerAt(unsigned index) {
+	m_context.structureWillChange();
 	std::list<Coupler>::iterator it = m_Couplers.begin();
 	std::advance(it, index);
 	// the coupler can be referenced in a reversible piston so we just reset it
@@ -1300,6 +1346,7 @@ void Organ::removeCouplerAt(unsigned index) {
 }
 
 void Organ::removeCoupler(Coupler *coupler) {
+	m_context.structureWillChange();
 	unsigned index = 0;
 	for (Coupler& c : m_Couplers) {
 		if (&c == coupler) {
@@ -1307,7 +1354,7 @@ void Organ::removeCoupler(Coupler *coupler) {
 			for (unsigned i = 0; i < m_Panels.size(); i++) {
 				if (getOrganPanelAt(i)->hasItemAsGuiElement(coupler)) {
 					getOrganPanelAt(i)->removeItemFromPanel(coupler);
-					::wxGetApp().m_frame->RebuildPanelGuiElementsInTree(i);
+					m_context.panelGuiElementsChanged(i);
 				}
 			}
 			// this coupler should also be removed from any general
@@ -1356,6 +1403,7 @@ void Organ::addDivisional(Divisional divisional, bool isParsing) {
 }
 
 void Organ::removeDivisionalAt(unsigned index) {
+	m_context.structureWillChange();
 	std::list<Divisional>::iterator it = m_Divisionals.begin();
 	std::advance(it, index);
 	m_Divisionals.erase(it);
@@ -1363,6 +1411,7 @@ void Organ::removeDivisionalAt(unsigned index) {
 }
 
 void Organ::removeDivisional(Divisional *divisional) {
+	m_context.structureWillChange();
 	unsigned index = 0;
 	for (Divisional& d : m_Divisionals) {
 		if (&d == divisional) {
@@ -1370,7 +1419,7 @@ void Organ::removeDivisional(Divisional *divisional) {
 			for (unsigned i = 0; i < m_Panels.size(); i++) {
 				if (getOrganPanelAt(i)->hasItemAsGuiElement(divisional)) {
 					getOrganPanelAt(i)->removeItemFromPanel(divisional);
-					::wxGetApp().m_frame->RebuildPanelGuiElementsInTree(i);
+					m_context.panelGuiElementsChanged(i);
 				}
 			}
 			removeDivisionalAt(index);
@@ -1413,13 +1462,14 @@ void Organ::addDivisionalCoupler(DivisionalCoupler divCplr, bool isParsing) {
 }
 
 void Organ::removeDivisionalCouplerAt(unsigned index) {
+	m_context.structureWillChange();
 	std::list<DivisionalCoupler>::iterator it = m_DivisionalCouplers.begin();
 	std::advance(it, index);
 	// if any gui element exist for this divisional coupler in any panel it should be removed
 	for (unsigned i = 0; i < m_Panels.size(); i++) {
 		if (getOrganPanelAt(i)->hasItemAsGuiElement(&(*it))) {
 			getOrganPanelAt(i)->removeItemFromPanel(&(*it));
-			::wxGetApp().m_frame->RebuildPanelGuiElementsInTree(i);
+			m_context.panelGuiElementsChanged(i);
 		}
 	}
 	// this divisonal coupler should also be removed from any general
@@ -1433,13 +1483,14 @@ void Organ::removeDivisionalCouplerAt(unsigned index) {
 }
 
 void Organ::removeDivisionalCoupler(DivisionalCoupler *divCplr) {
+	m_context.structureWillChange();
 	for (auto it = m_DivisionalCouplers.begin(); it != m_DivisionalCouplers.end();) {
 		if (&(*it) == divCplr) {
 			// remove any gui representations first
 			for (unsigned i = 0; i < m_Panels.size(); i++) {
 				if (getOrganPanelAt(i)->hasItemAsGuiElement(&(*it))) {
 					getOrganPanelAt(i)->removeItemFromPanel(&(*it));
-					::wxGetApp().m_frame->RebuildPanelGuiElementsInTree(i);
+					m_context.panelGuiElementsChanged(i);
 				}
 			}
 			it = m_DivisionalCouplers.erase(it);
@@ -1482,13 +1533,14 @@ void Organ::addGeneral(General general, bool isParsing) {
 }
 
 void Organ::removeGeneralAt(unsigned index) {
+	m_context.structureWillChange();
 	std::list<General>::iterator it = m_Generals.begin();
 	std::advance(it, index);
 	// remove any gui representations first
 	for (unsigned i = 0; i < m_Panels.size(); i++) {
 		if (getOrganPanelAt(i)->hasItemAsGuiElement(&(*it))) {
 			getOrganPanelAt(i)->removeItemFromPanel(&(*it));
-			::wxGetApp().m_frame->RebuildPanelGuiElementsInTree(i);
+			m_context.panelGuiElementsChanged(i);
 		}
 	}
 	m_Generals.erase(it);
@@ -1496,13 +1548,14 @@ void Organ::removeGeneralAt(unsigned index) {
 }
 
 void Organ::removeGeneral(General *general) {
+	m_context.structureWillChange();
 	for (auto it = m_Generals.begin(); it != m_Generals.end();) {
 		if (&(*it) == general) {
 			// remove any gui representations first
 			for (unsigned i = 0; i < m_Panels.size(); i++) {
 				if (getOrganPanelAt(i)->hasItemAsGuiElement(&(*it))) {
 					getOrganPanelAt(i)->removeItemFromPanel(&(*it));
-					::wxGetApp().m_frame->RebuildPanelGuiElementsInTree(i);
+					m_context.panelGuiElementsChanged(i);
 				}
 			}
 			it = m_Generals.erase(it);
@@ -1545,13 +1598,14 @@ void Organ::addReversiblePiston(ReversiblePiston piston, bool isParsing) {
 }
 
 void Organ::removeReversiblePistonAt(unsigned index) {
+	m_context.structureWillChange();
 	std::list<ReversiblePiston>::iterator it = m_ReversiblePistons.begin();
 	std::advance(it, index);
 	// if any gui element exist for this piston in any panel it should be removed
 	for (unsigned i = 0; i < m_Panels.size(); i++) {
 		if (getOrganPanelAt(i)->hasItemAsGuiElement(&(*it))) {
 			getOrganPanelAt(i)->removeItemFromPanel(&(*it));
-			::wxGetApp().m_frame->RebuildPanelGuiElementsInTree(i);
+			m_context.panelGuiElementsChanged(i);
 		}
 	}
 	m_ReversiblePistons.erase(it);
@@ -1559,13 +1613,14 @@ void Organ::removeReversiblePistonAt(unsigned index) {
 }
 
 void Organ::removeReversiblePiston(ReversiblePiston *piston) {
+	m_context.structureWillChange();
 	for (auto it = m_ReversiblePistons.begin(); it != m_ReversiblePistons.end();) {
 		if (&(*it) == piston) {
 			// if any gui element exist for this piston in any panel it should be removed
 			for (unsigned i = 0; i < m_Panels.size(); i++) {
 				if (getOrganPanelAt(i)->hasItemAsGuiElement(&(*it))) {
 					getOrganPanelAt(i)->removeItemFromPanel(&(*it));
-					::wxGetApp().m_frame->RebuildPanelGuiElementsInTree(i);
+					m_context.panelGuiElementsChanged(i);
 				}
 			}
 			it = m_ReversiblePistons.erase(it);
@@ -1606,6 +1661,7 @@ void Organ::addPanel(GoPanel panel) {
 }
 
 void Organ::removePanelAt(unsigned index) {
+	m_context.structureWillChange();
 	// TODO: Check index usage (the getindex function always returns +1 from list index)
 	if (index > 0) {
 		std::list<GoPanel>::iterator it = m_Panels.begin();
@@ -1615,6 +1671,7 @@ void Organ::removePanelAt(unsigned index) {
 }
 
 void Organ::removePanel(GoPanel *panel) {
+	m_context.structureWillChange();
 	// The main panel may not be removed and it will be returned as 1 from getindex
 	if (getIndexOfOrganPanel(panel) > 1) {
 		for (auto it = m_Panels.begin(); it != m_Panels.end();) {
@@ -1627,6 +1684,7 @@ void Organ::removePanel(GoPanel *panel) {
 }
 
 void Organ::movePanel(int sourceIndex, int toBeforeIndex) {
+	m_context.structureWillChange();
 	auto theOneToMove = std::next(m_Panels.begin(), sourceIndex);
 	std::list<GoPanel>::iterator it = m_Panels.begin();
 
@@ -1826,8 +1884,8 @@ void Organ::updateOrganElements() {
 	// Since this method is called whenever the name of an element changes it makes sense to update
 	// the GUI elements display names from here too.
 	for (unsigned i = 0; i < m_Panels.size(); i++) {
-		getOrganPanelAt(i)->updateGuiElementsDisplayNames();
-		::wxGetApp().m_frame->RebuildPanelGuiElementsInTree(i);
+		getOrganPanelAt(i)->updateGuiElementsDisplayNames(m_context);
+		m_context.panelGuiElementsChanged(i);
 	}
 }
 
@@ -1912,12 +1970,18 @@ void Organ::organElementHasChanged(bool isParsing) {
 	}
 }
 
+void Organ::loadAllDeferredPipes() {
+	for (Rank& r : m_Ranks) {
+		r.loadPipes();
+	}
+}
+
 void Organ::updateRelativePipePaths() {
 	for (Stop& s : m_Stops) {
-		s.getInternalRank()->updatePipeRelativePaths();
+		s.getInternalRank()->updatePipeRelativePaths(m_context);
 	}
 	for (Rank& r : m_Ranks) {
-		r.updatePipeRelativePaths();
+		r.updatePipeRelativePaths(m_context);
 	}
 }
 
@@ -1926,12 +1990,70 @@ bool Organ::isModified() {
 }
 
 void Organ::setModified(bool modified) {
+	if (modified) {
+		// Without knowing what changed every cached section must be
+		// considered stale, unless a single rank is being edited.
+		if (m_rankInSectionEdit)
+			m_rankInSectionEdit->m_sectionCache.invalidate();
+		else
+			invalidateSectionCaches();
+		m_modificationCount++;
+	}
 	m_isModified = modified;
-	::wxGetApp().m_frame->UpdateFrameTitle();
+	m_context.modifiedStateChanged();
+}
+
+// Tells whether anything has changed since a saved snapshot was taken
+unsigned Organ::getModificationCount() {
+	return m_modificationCount;
+}
+
+void Organ::setSectionModified(Rank *rank) {
+	rank->m_sectionCache.invalidate();
+	m_isModified = true;
+	m_modificationCount++;
+	m_context.modifiedStateChanged();
+}
+
+void Organ::setSectionModified(GoPanel *panel) {
+	panel->m_sectionCache.invalidate();
+	m_isModified = true;
+	m_modificationCount++;
+	m_context.modifiedStateChanged();
+}
+
+void Organ::beginSectionEdit(Rank *rank) {
+	m_rankInSectionEdit = rank;
+}
+
+void Organ::endSectionEdit() {
+	m_rankInSectionEdit = NULL;
+}
+
+void Organ::invalidateSectionCaches() {
+	for (Rank& r : m_Ranks) {
+		r.m_sectionCache.invalidate();
+	}
+	for (GoPanel& p : m_Panels) {
+		p.m_sectionCache.invalidate();
+	}
+}
+
+FileExistenceCache* Organ::getFileExistenceCache() {
+	return m_fileExistenceCache;
+}
+
+void Organ::setFileExistenceCache(FileExistenceCache *cache) {
+	m_fileExistenceCache = cache;
+}
+
+OrganContext* Organ::getContext() {
+	return &m_context;
 }
 
 void Organ::doInheritLegacyXfades() {
 	for (Rank& r : m_Ranks) {
+		r.loadPipes();
 		for (Pipe& p : r.m_pipes) {
 			if (!p.m_attacks.front().fileName.StartsWith(wxT("REF:"))) {
 				int loopXfadeValue = p.m_attacks.front().loopCrossfadeLength;
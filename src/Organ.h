@@ -24,6 +24,7 @@
 #include <wx/wx.h>
 #include <wx/textfile.h>
 #include <list>
+#include <map>
 #include "Enclosure.h"
 #include "Tremulant.h"
 #include "Windchestgroup.h"
@@ -37,13 +38,17 @@
 #include "General.h"
 #include "ReversiblePiston.h"
 #include "GoPanel.h"
+#include "FileExistenceCache.h"
+#include "OrganContext.h"
 
 class Organ {
 public:
 	Organ();
 	~Organ();
 
-	void writeOrgan(wxTextFile *outFile);
+	// Sections written from a cache are listed in cachedSections, when
+	// given, with the stamp of the cache they came from
+	void writeOrgan(wxTextFile *outFile, std::map<wxString, unsigned long long> *cachedSections = NULL);
 
 	float getAmplitudeLevel();
 	void setAmplitudeLevel(float amplitudeLevel);
@@ -181,9 +186,19 @@ public:
 	const wxArrayString& getOrganElements() const;
 	std::pair<wxString, int> getTypeAndIndexOfElement(int index);
 	void organElementHasChanged(bool isParsing = false);
+	void loadAllDeferredPipes();
 	void updateRelativePipePaths();
 	bool isModified();
 	void setModified(bool modified);
+	unsigned getModificationCount();
+	void setSectionModified(Rank *rank);
+	void setSectionModified(GoPanel *panel);
+	void beginSectionEdit(Rank *rank);
+	void endSectionEdit();
+	void invalidateSectionCaches();
+	FileExistenceCache* getFileExistenceCache();
+	OrganContext* getContext();
+	void setFileExistenceCache(FileExistenceCache *cache);
 	void doInheritLegacyXfades();
 	bool isElementReferenced(GoSwitch *sw);
 	void fixTrailingSpacesInStrings();
@@ -191,6 +206,10 @@ public:
 private:
 	wxString m_odfRoot;
 	bool m_isModified;
+	unsigned m_modificationCount;
+	Rank *m_rankInSectionEdit;
+	FileExistenceCache *m_fileExistenceCache;
+	OrganContext m_context;
 	// Organ properties
 	wxString m_churchName;
 	wxString m_churchAddress;
@@ -0,0 +1,222 @@
+/*
+ * OrganContext.cpp is part of GoOdf.
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * GoOdf is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GoOdf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GoOdf.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#include "OrganContext.h"
+
+thread_local OrganContext *OrganContext::m_current = NULL;
+
+OrganContext::OrganContext(Organ *organ) {
+	m_organ = organ;
+	m_keepMissingFiles = false;
+	m_loadPipesOnDemand = false;
+	m_sampleNamingScheme = 0;
+	m_noteNameConvention = 0;
+	m_isCollectingDiagnostics = false;
+	m_isDiscardingDiagnostics = false;
+	m_isAttachedToUi = false;
+	m_isDeferringGuiTasks = false;
+	m_nextGuiTask = 0;
+}
+
+OrganContext::~OrganContext() {
+
+}
+
+Organ* OrganContext::getOrgan() const {
+	return m_organ;
+}
+
+void OrganContext::setOrgan(Organ *organ) {
+	m_organ = organ;
+}
+
+bool OrganContext::isKeepingMissingFiles() const {
+	return m_keepMissingFiles;
+}
+
+void OrganContext::setKeepMissingFiles(bool keep) {
+	m_keepMissingFiles = keep;
+}
+
+bool OrganContext::isLoadingPipesOnDemand() const {
+	return m_loadPipesOnDemand;
+}
+
+void OrganContext::setLoadPipesOnDemand(bool onDemand) {
+	m_loadPipesOnDemand = onDemand;
+}
+
+int OrganContext::getSampleNamingScheme() const {
+	return m_sampleNamingScheme;
+}
+
+void OrganContext::setSampleNamingScheme(int scheme) {
+	m_sampleNamingScheme = scheme;
+}
+
+wxString OrganContext::getSampleNamePattern() const {
+	return m_sampleNamePattern;
+}
+
+void OrganContext::setSampleNamePattern(const wxString &pattern) {
+	m_sampleNamePattern = pattern;
+}
+
+int OrganContext::getNoteNameConvention() const {
+	return m_noteNameConvention;
+}
+
+void OrganContext::setNoteNameConvention(int convention) {
+	m_noteNameConvention = convention;
+}
+
+void OrganContext::logWarning(const wxString &message) {
+	addDiagnostic(false, message);
+}
+
+void OrganContext::logError(const wxString &message) {
+	addDiagnostic(true, message);
+}
+
+void OrganContext::setCollectingDiagnostics(bool collect) {
+	m_isCollectingDiagnostics = collect;
+}
+
+void OrganContext::flushDiagnostics() {
+	std::vector<std::pair<bool, wxString>> diagnostics;
+	{
+		wxCriticalSectionLocker locker(m_diagnosticsLock);
+		diagnostics.swap(m_diagnostics);
+	}
+	if (diagnostics.empty())
+		return;
+	for (const std::pair<bool, wxString> &diagnostic : diagnostics) {
+		if (diagnostic.first)
+			wxLogError("%s", diagnostic.second);
+		else
+			wxLogWarning("%s", diagnostic.second);
+	}
+	showLogWindow();
+}
+
+void OrganContext::setDiscardingDiagnostics(bool discard) {
+	m_isDiscardingDiagnostics = discard;
+}
+
+bool OrganContext::isAttachedToUi() const {
+	return m_isAttachedToUi;
+}
+
+void OrganContext::setAttachedToUi(bool attached, const UI_CALLBACKS &callbacks) {
+	m_isAttachedToUi = attached;
+	m_uiCallbacks = callbacks;
+}
+
+void OrganContext::panelGuiElementsChanged(unsigned panelIndex) {
+	if (m_isAttachedToUi && wxThread::IsMain() && m_uiCallbacks.panelGuiElementsChanged)
+		m_uiCallbacks.panelGuiElementsChanged(panelIndex);
+}
+
+void OrganContext::modifiedStateChanged() {
+	if (m_isAttachedToUi && wxThread::IsMain() && m_uiCallbacks.modifiedStateChanged)
+		m_uiCallbacks.modifiedStateChanged();
+}
+
+void OrganContext::structureWillChange() {
+	// anything still being loaded refers to the elements by their current index
+	if (m_isAttachedToUi && wxThread::IsMain() && m_uiCallbacks.structureWillChange)
+		m_uiCallbacks.structureWillChange();
+}
+
+void OrganContext::setDeferringGuiTasks(bool defer) {
+	m_isDeferringGuiTasks = defer;
+}
+
+void OrganContext::addGuiTask(std::function<void()> task) {
+	if (m_isDeferringGuiTasks) {
+		m_guiTasks.push_back(task);
+		return;
+	}
+	OrganContextScope contextScope(this);
+	task();
+}
+
+bool OrganContext::hasPendingGuiTasks() const {
+	return m_nextGuiTask < m_guiTasks.size();
+}
+
+void OrganContext::runNextGuiTask() {
+	if (!hasPendingGuiTasks())
+		return;
+	OrganContextScope contextScope(this);
+	std::function<void()> task;
+	task.swap(m_guiTasks[m_nextGuiTask]);
+	m_nextGuiTask++;
+	task();
+}
+
+unsigned OrganContext::getNumberOfGuiTasks() const {
+	return m_guiTasks.size();
+}
+
+unsigned OrganContext::getNumberOfFinishedGuiTasks() const {
+	return m_nextGuiTask;
+}
+
+void OrganContext::clearGuiTasks() {
+	m_guiTasks.clear();
+	m_nextGuiTask = 0;
+}
+
+OrganContext* OrganContext::current() {
+	// only reading and writing an organ install a context, anything else
+	// has to be handed the context of the organ it works on
+	wxASSERT_MSG(m_current, wxT("No OrganContextScope is active on this thread"));
+	return m_current;
+}
+
+void OrganContext::addDiagnostic(bool isError, const wxString &message) {
+	if (m_isDiscardingDiagnostics && wxThread::IsMain())
+		return;
+	if (m_isCollectingDiagnostics || !wxThread::IsMain()) {
+		wxCriticalSectionLocker locker(m_diagnosticsLock);
+		m_diagnostics.push_back(std::make_pair(isError, message.Clone()));
+		return;
+	}
+	if (isError)
+		wxLogError("%s", message);
+	else
+		wxLogWarning("%s", message);
+	showLogWindow();
+}
+
+void OrganContext::showLogWindow() {
+	if (wxThread::IsMain() && m_uiCallbacks.showLogWindow)
+		m_uiCallbacks.showLogWindow();
+}
+
+OrganContextScope::OrganContextScope(OrganContext *context) {
+	m_previous = OrganContext::m_current;
+	OrganContext::m_current = context;
+}
+
+OrganContextScope::~OrganContextScope() {
+	OrganContext::m_current = m_previous;
+}
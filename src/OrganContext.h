@@ -0,0 +1,136 @@
+/*
+ * OrganContext.h is part of GoOdf.
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * GoOdf is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GoOdf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GoOdf.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#ifndef ORGANCONTEXT_H
+#define ORGANCONTEXT_H
+
+#include <wx/wx.h>
+#include <wx/thread.h>
+#include <vector>
+#include <utility>
+#include <functional>
+
+class Organ;
+
+// Everything the model needs from its surroundings: the organ that element
+// references are resolved against, the user options that affect reading and
+// where diagnostics go. Each organ owns one. Reading and writing an organ
+// makes its context current with an OrganContextScope, everything else gets
+// the context passed, so that an organ can be handled on a worker thread or
+// without any user interface.
+class OrganContext {
+public:
+	OrganContext(Organ *organ = NULL);
+	~OrganContext();
+
+	Organ* getOrgan() const;
+	void setOrgan(Organ *organ);
+	bool isKeepingMissingFiles() const;
+	void setKeepMissingFiles(bool keep);
+	bool isLoadingPipesOnDemand() const;
+	void setLoadPipesOnDemand(bool onDemand);
+	int getSampleNamingScheme() const;
+	void setSampleNamingScheme(int scheme);
+	wxString getSampleNamePattern() const;
+	void setSampleNamePattern(const wxString &pattern);
+	int getNoteNameConvention() const;
+	void setNoteNameConvention(int convention);
+
+	// Messages are logged at once on the main thread unless collecting is
+	// enabled. From other threads they are always collected until flushed.
+	void logWarning(const wxString &message);
+	void logError(const wxString &message);
+	void setCollectingDiagnostics(bool collect);
+	void flushDiagnostics();
+	// Writes the user didn't ask for drop the messages of the main thread
+	void setDiscardingDiagnostics(bool discard);
+
+	// What the user interface does on behalf of the organ, installed by it
+	// so that the organ doesn't know about it
+	struct UI_CALLBACKS {
+		std::function<void(unsigned)> panelGuiElementsChanged;
+		std::function<void()> modifiedStateChanged;
+		std::function<void()> structureWillChange;
+		std::function<void()> showLogWindow;
+	};
+
+	// Notifications for the user interface are only passed on when attached,
+	// the log window is shown for any context that has the callbacks
+	bool isAttachedToUi() const;
+	void setAttachedToUi(bool attached, const UI_CALLBACKS &callbacks);
+	void panelGuiElementsChanged(unsigned panelIndex);
+	void modifiedStateChanged();
+	void structureWillChange();
+
+	// GUI elements can only be created on the main thread. While deferring,
+	// tasks that create them are queued and run later one at a time in the
+	// order they were added, otherwise they run at once.
+	void setDeferringGuiTasks(bool defer);
+	void addGuiTask(std::function<void()> task);
+	bool hasPendingGuiTasks() const;
+	void runNextGuiTask();
+	unsigned getNumberOfGuiTasks() const;
+	unsigned getNumberOfFinishedGuiTasks() const;
+	void clearGuiTasks();
+
+	// The context of the organ being read or written on this thread
+	static OrganContext* current();
+
+private:
+	Organ *m_organ;
+	bool m_keepMissingFiles;
+	bool m_loadPipesOnDemand;
+	int m_sampleNamingScheme;
+	wxString m_sampleNamePattern;
+	int m_noteNameConvention;
+	bool m_isCollectingDiagnostics;
+	bool m_isDiscardingDiagnostics;
+	bool m_isAttachedToUi;
+	UI_CALLBACKS m_uiCallbacks;
+	bool m_isDeferringGuiTasks;
+	std::vector<std::pair<bool, wxString>> m_diagnostics;
+	std::vector<std::function<void()>> m_guiTasks;
+	unsigned m_nextGuiTask;
+	wxCriticalSection m_diagnosticsLock;
+
+	void addDiagnostic(bool isError, const wxString &message);
+	void showLogWindow();
+
+	static thread_local OrganContext *m_current;
+	friend class OrganContextScope;
+
+	OrganContext(const OrganContext&) = delete;
+	OrganContext& operator=(const OrganContext&) = delete;
+};
+
+// Makes a context current for the calling thread while in scope
+class OrganContextScope {
+public:
+	OrganContextScope(OrganContext *context);
+	~OrganContextScope();
+
+private:
+	OrganContext *m_previous;
+
+	OrganContextScope(const OrganContextScope&) = delete;
+	OrganContextScope& operator=(const OrganContextScope&) = delete;
+};
+
+#endif
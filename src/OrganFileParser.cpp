@@ -21,8 +21,11 @@
 #include "OrganFileParser.h"
 #include <wx/filename.h>
 #include <wx/image.h>
+#include <wx/file.h>
+#include <unordered_set>
 #include "GOODF.h"
 #include "GOODFFunctions.h"
+#include "Instrumentation.h"
 #include "GUITremulant.h"
 #include "GUISwitch.h"
 #include "GUIReversiblePiston.h"
@@ -32,37 +35,84 @@
 #include "GUICoupler.h"
 #include "GUIStop.h"
 
-OrganFileParser::OrganFileParser(wxString filePath, Organ *organ) {
+OrganFileParser::OrganFileParser(wxString filePath, Organ *organ, bool parseNow) {
 	m_filePath = filePath;
 	m_organ = organ;
+	m_organFile = NULL;
 	m_fileIsOk = false;
 	m_organIsReady = false;
 	m_isUsingOldPanelFormat = false;
+	m_isParsingInSteps = !parseNow;
+	m_isCancelled = false;
 	m_errorMessage = wxEmptyString;
 	m_progressDlg = NULL;
+	m_progressValue = 0;
+	m_progressMessage = wxEmptyString;
 
-	readIniFile();
-	if (m_fileIsOk) {
-		m_progressDlg = new wxProgressDialog(
-			wxT("Parsing ") + m_filePath,
-			wxEmptyString
-		);
-		parseOrgan();
+	if (parseNow) {
+		parseStructure();
+		finishParsing();
 	}
 }
 
 OrganFileParser::~OrganFileParser() {
+	if (m_organ->getFileExistenceCache() == &m_fileExistenceCache)
+		m_organ->setFileExistenceCache(NULL);
+	if (m_isParsingInSteps) {
+		// GUI elements not created yet are abandoned with the loading
+		m_organ->getContext()->clearGuiTasks();
+		m_organ->getContext()->setDeferringGuiTasks(false);
+	}
 	if (m_organFile)
 		delete m_organFile;
 	if (m_progressDlg)
 		delete m_progressDlg;
 }
 
-void OrganFileParser::parseOrgan() {
+bool OrganFileParser::parseStructure() {
+	// everything read resolves against, and reports to, the organ being parsed
+	OrganContextScope contextScope(m_organ->getContext());
+	{
+		ScopedTimer readTimer("load.readIniFile");
+		readIniFile();
+	}
+	if (!m_fileIsOk)
+		return false;
+	if (m_isParsingInSteps) {
+		m_organ->getContext()->setDeferringGuiTasks(true);
+	} else {
+		m_progressDlg = new wxProgressDialog(
+			wxT("Parsing ") + m_filePath,
+			wxEmptyString
+		);
+	}
+
 	wxFileName odf = wxFileName(m_filePath);
 	m_organ->setOdfRoot(odf.GetPath());
-	parseOrganSection();
-	if (m_errorMessage == wxEmptyString)
+	// list the directories of all referenced files up front instead of checking each file
+	updateProgress(0, wxT("Checking referenced files"));
+	{
+		ScopedTimer prefetchTimer("load.listReferencedDirectories");
+		m_fileExistenceCache.prefetch();
+	}
+	m_organ->setFileExistenceCache(&m_fileExistenceCache);
+	if (m_isParsingInSteps || m_organ->getContext()->isLoadingPipesOnDemand())
+		readPipeEntryOrder();
+	{
+		ScopedTimer parseTimer("load.parseSections");
+		parseOrganSection();
+	}
+	return m_errorMessage == wxEmptyString && !isCancelled();
+}
+
+void OrganFileParser::finishParsing() {
+	if (!m_fileIsOk)
+		return;
+	OrganContextScope contextScope(m_organ->getContext());
+	m_organ->getContext()->setDeferringGuiTasks(false);
+	m_organ->setFileExistenceCache(NULL);
+	m_fileExistenceCache.reportMissingFiles(m_organ->getContext());
+	if (m_errorMessage == wxEmptyString && !isCancelled())
 		m_organIsReady = true;
 }
 
@@ -70,8 +120,42 @@ bool OrganFileParser::isOrganReady() {
 	return m_organIsReady;
 }
 
+wxString OrganFileParser::getErrorMessage() {
+	return m_errorMessage;
+}
+
+void OrganFileParser::cancel() {
+	m_isCancelled = true;
+}
+
+bool OrganFileParser::isCancelled() {
+	return m_isCancelled;
+}
+
+int OrganFileParser::getProgress(wxString &message) {
+	wxCriticalSectionLocker locker(m_progressLock);
+	message = m_progressMessage.Clone();
+	return m_progressValue;
+}
+
+bool OrganFileParser::updateProgress(int value, const wxString &message) {
+	if (m_progressDlg) {
+		m_progressDlg->Update(value, message);
+	} else {
+		wxCriticalSectionLocker locker(m_progressLock);
+		m_progressValue = value;
+		m_progressMessage = message.Clone();
+	}
+	return !isCancelled();
+}
+
 void OrganFileParser::readIniFile() {
 	m_organFile = new wxFileConfig(wxEmptyString, wxEmptyString, m_filePath, wxEmptyString, wxCONFIG_USE_NO_ESCAPE_CHARACTERS);
+	if (Instrumentation::isEnabled()) {
+		wxULongLong odfSize = wxFileName::GetSize(m_filePath);
+		if (odfSize != wxInvalidSize)
+			Instrumentation::count(Instrumentation::BYTES_READ, (long long) odfSize.GetValue());
+	}
 	if (m_organFile->HasGroup(wxT("Organ"))) {
 		m_fileIsOk = true;
 		if (m_organFile->HasGroup(wxT("Panel000"))) {
@@ -86,9 +170,60 @@ void OrganFileParser::readIniFile() {
 	}
 }
 
+void OrganFileParser::readPipeEntryOrder() {
+	// wxFileConfig keeps the entries of a group sorted by name, the pipe keys
+	// of the ranks are listed here as they appear in the file instead. Only
+	// ASCII keys are looked for so the raw bytes don't need to be converted.
+	m_pipeEntryOrder.clear();
+	wxFile file;
+	if (!file.Open(m_filePath))
+		return;
+	wxFileOffset length = file.Length();
+	if (length <= 0)
+		return;
+	std::string content(static_cast<size_t>(length), '\0');
+	if (file.Read(&content[0], content.size()) != (ssize_t) content.size())
+		return;
+
+	wxArrayString *currentOrder = NULL;
+	std::unordered_set<std::string> seenKeys;
+	size_t lineStart = 0;
+	while (lineStart < content.size()) {
+		size_t lineEnd = content.find('\n', lineStart);
+		if (lineEnd == std::string::npos)
+			lineEnd = content.size();
+		size_t first = content.find_first_not_of(" \t\r", lineStart);
+		if (first != std::string::npos && first < lineEnd) {
+			if (content[first] == '[') {
+				size_t close = content.find(']', first);
+				currentOrder = NULL;
+				if (close != std::string::npos && close < lineEnd) {
+					std::string group = content.substr(first + 1, close - first - 1);
+					if (group.size() == 7 && group.compare(0, 4, "Rank") == 0) {
+						currentOrder = &m_pipeEntryOrder[wxString::FromAscii(group.c_str())];
+						seenKeys.clear();
+					}
+				}
+			} else if (currentOrder && content.compare(first, 4, "Pipe") == 0) {
+				size_t equals = content.find('=', first);
+				if (equals != std::string::npos && equals < lineEnd) {
+					size_t keyEnd = content.find_last_not_of(" \t", equals - 1);
+					std::string key = content.substr(first, keyEnd - first + 1);
+					if (seenKeys.insert(key).second)
+						currentOrder->Add(wxString::FromAscii(key.c_str()));
+				}
+			}
+		}
+		lineStart = lineEnd + 1;
+	}
+}
+
 void OrganFileParser::trimKeyValues() {
 	wxString group;
 	long group_index;
+	wxString odfRoot = wxFileName(m_filePath).GetPath();
+	// pipes streamed in after a background open are still checked with the cached listings
+	bool pipesAreDeferred = m_organ->getContext()->isLoadingPipesOnDemand();
 
 	m_organFile->SetPath("/");
 	bool has_group = m_organFile->GetFirstGroup(group, group_index);
@@ -123,6 +258,10 @@ void OrganFileParser::trimKeyValues() {
 				m_organFile->Write(entry, value);
 			}
 
+			// pipes that are loaded on demand aren't checked while parsing
+			if (!(pipesAreDeferred && group.StartsWith(wxT("Rank")) && entry.StartsWith(wxT("Pipe"))))
+				addReferencedDirectory(value, odfRoot);
+
 			has_entry = m_organFile->GetNextEntry(entry, entry_index);
 		}
 
@@ -131,10 +270,34 @@ void OrganFileParser::trimKeyValues() {
 	}
 }
 
+void OrganFileParser::addReferencedDirectory(const wxString &value, const wxString &odfRoot) {
+	if (value.IsEmpty() || value.IsSameAs(wxT("DUMMY")) || value.StartsWith(wxT("REF:")))
+		return;
+	double number;
+	if (value.ToCDouble(&number))
+		return;
+	// only values that look like file names with a short extension are considered
+	wxString ext = wxFileName(value, wxPATH_DOS).GetExt();
+	if (ext.IsEmpty() || ext.length() > 4 || !ext.IsAscii())
+		return;
+	for (wxString::const_iterator it = ext.begin(); it != ext.end(); ++it) {
+		if (!wxIsalnum(*it))
+			return;
+	}
+	wxString relativePath = value;
+	if (relativePath.StartsWith(wxT("./")) || relativePath.StartsWith(wxT(".\\")))
+		relativePath.erase(0, 2);
+	m_fileExistenceCache.addDirectoryOf(odfRoot + wxFILE_SEP_PATH + relativePath);
+}
+
 void OrganFileParser::parseOrganSection() {
+	// GUI tasks can run after parsing has moved on, so they only get the organ
+	// and a private copy of the sections they read, never the parser or its file
+	Organ *organ = m_organ;
 	m_organFile->SetPath("/Organ");
 
-	m_progressDlg->Update(0, wxT("Parsing [Organ] section"));
+	if (!updateProgress(0, wxT("Parsing [Organ] section")))
+		return;
 	m_organ->setChurchName(m_organFile->Read("ChurchName", wxEmptyString));
 	m_organ->setChurchAddress(m_organFile->Read("ChurchAddress", wxEmptyString));
 	m_organ->setOrganBuilder(m_organFile->Read("OrganBuilder", wxEmptyString));
@@ -183,7 +346,11 @@ void OrganFileParser::parseOrganSection() {
 
 	if (m_isUsingOldPanelFormat) {
 		// the display metrics must be read from the organ section into Panel000
-		m_organ->getOrganPanelAt(0)->getDisplayMetrics()->read(m_organFile);
+		std::shared_ptr<wxFileConfig> organSection = GOODF_functions::copyConfigGroups(m_organFile, wxT("Organ"));
+		m_organ->getContext()->addGuiTask([organ, organSection]() {
+			organSection->SetPath(wxT("/Organ"));
+			organ->getOrganPanelAt(0)->getDisplayMetrics()->read(organSection.get());
+		});
 
 		// images can also exist that must be transferred to the main panel
 		int nbrImages = static_cast<int>(m_organFile->ReadLong("NumberOfImages", 0));
@@ -192,18 +359,21 @@ void OrganFileParser::parseOrganSection() {
 				m_organFile->SetPath("/");
 				wxString imgGroupName = wxT("Image") + GOODF_functions::number_format(i + 1);
 				if (m_organFile->HasGroup(imgGroupName)) {
-					m_progressDlg->Update(5, wxT("Parsing old style [") + imgGroupName + wxT("] section"));
-					m_organFile->SetPath(wxT("/") + imgGroupName);
-					GoImage img;
-					img.setOwningPanelWidth(m_organ->getOrganPanelAt(0)->getDisplayMetrics()->m_dispScreenSizeHoriz.getNumericalValue());
-					img.setOwningPanelHeight(m_organ->getOrganPanelAt(0)->getDisplayMetrics()->m_dispScreenSizeVert.getNumericalValue());
-					bool imgIsOk = img.read(m_organFile, m_organ);
-					if (imgIsOk)
-						m_organ->getOrganPanelAt(0)->addImage(img);
-					else {
-						wxLogWarning("%s is not possible to parse and use!", imgGroupName);
-						::wxGetApp().m_frame->GetLogWindow()->Show(true);
-					}
+					if (!updateProgress(5, wxT("Parsing old style [") + imgGroupName + wxT("] section")))
+						return;
+					std::shared_ptr<wxFileConfig> section = GOODF_functions::copyConfigGroups(m_organFile, imgGroupName);
+					m_organ->getContext()->addGuiTask([organ, section, imgGroupName]() {
+						section->SetPath(wxT("/") + imgGroupName);
+						GoImage img;
+						img.setOwningPanelWidth(organ->getOrganPanelAt(0)->getDisplayMetrics()->m_dispScreenSizeHoriz.getNumericalValue());
+						img.setOwningPanelHeight(organ->getOrganPanelAt(0)->getDisplayMetrics()->m_dispScreenSizeVert.getNumericalValue());
+						bool imgIsOk = img.read(section.get(), organ);
+						if (imgIsOk)
+							organ->getOrganPanelAt(0)->addImage(img);
+						else {
+							organ->getContext()->logWarning(wxString::Format("%s is not possible to parse and use!", imgGroupName));
+						}
+					});
 				}
 			}
 			m_organFile->SetPath("/Organ");
@@ -215,13 +385,16 @@ void OrganFileParser::parseOrganSection() {
 			for (int i = 0; i < nbrLabels; i++) {
 				m_organFile->SetPath("/");
 				wxString labelGroupName = wxT("Label") + GOODF_functions::number_format(i + 1);
-				m_progressDlg->Update(10, wxT("Parsing old style [") + labelGroupName + wxT("] section"));
+				if (!updateProgress(10, wxT("Parsing old style [") + labelGroupName + wxT("] section")))
+					return;
 				if (m_organFile->HasGroup(labelGroupName)) {
-					m_organFile->SetPath(wxT("/") + labelGroupName);
-					createGUILabel(m_organ->getOrganPanelAt(0));
+					std::shared_ptr<wxFileConfig> section = GOODF_functions::copyConfigGroups(m_organFile, labelGroupName);
+					m_organ->getContext()->addGuiTask([organ, section, labelGroupName]() {
+						section->SetPath(wxT("/") + labelGroupName);
+						createGUILabel(section.get(), organ, organ->getOrganPanelAt(0));
+					});
 				} else {
-					wxLogWarning("%s couldn't be found!", labelGroupName);
-					::wxGetApp().m_frame->GetLogWindow()->Show(true);
+					m_organ->getContext()->logWarning(wxString::Format("%s couldn't be found!", labelGroupName));
 				}
 			}
 			m_organFile->SetPath("/Organ");
@@ -230,9 +403,13 @@ void OrganFileParser::parseOrganSection() {
 		// We need to read the display metrics of panel 000 before any other elements that might be displayed!
 		// But the new style GUI elements must be read after all the structural elements have been processed,
 		// so that will be done at a later point in the parsing.
-		m_organFile->SetPath(wxT("/Panel000"));
-		m_organ->getOrganPanelAt(0)->read(m_organFile, wxT("Panel000"), m_organ);
-		m_progressDlg->Update(12, wxT("Parsing [Panel000] base section"));
+		if (!updateProgress(12, wxT("Parsing [Panel000] base section")))
+			return;
+		std::shared_ptr<wxFileConfig> mainPanelSections = GOODF_functions::copyConfigGroups(m_organFile, wxT("Panel000"), true);
+		m_organ->getContext()->addGuiTask([organ, mainPanelSections]() {
+			mainPanelSections->SetPath(wxT("/Panel000"));
+			organ->getOrganPanelAt(0)->read(mainPanelSections.get(), wxT("Panel000"), organ);
+		});
 		m_organFile->SetPath("/Organ");
 	}
 
@@ -242,19 +419,23 @@ void OrganFileParser::parseOrganSection() {
 		for (int i = 0; i < nbrEnclosures; i++) {
 			m_organFile->SetPath("/");
 			wxString enclosureGroupName = wxT("Enclosure") + GOODF_functions::number_format(i + 1);
-			m_progressDlg->Update(15, wxT("Parsing [") + enclosureGroupName + wxT("] section"));
+			if (!updateProgress(15, wxT("Parsing [") + enclosureGroupName + wxT("] section")))
+				return;
 			if (m_organFile->HasGroup(enclosureGroupName)) {
 				m_organFile->SetPath(wxT("/") + enclosureGroupName);
 				Enclosure enc;
 				enc.read(m_organFile, m_isUsingOldPanelFormat);
 				m_organ->addEnclosure(enc, true);
 				if (enc.isDisplayed()) {
-					int lastEnclosureIdx = m_organ->getNumberOfEnclosures() - 1;
-					createGUIEnclosure(m_organ->getOrganPanelAt(0), m_organ->getOrganEnclosureAt(lastEnclosureIdx));
+					Enclosure *lastEnclosure = m_organ->getOrganEnclosureAt(m_organ->getNumberOfEnclosures() - 1);
+					std::shared_ptr<wxFileConfig> section = GOODF_functions::copyConfigGroups(m_organFile, enclosureGroupName);
+					m_organ->getContext()->addGuiTask([organ, section, enclosureGroupName, lastEnclosure]() {
+						section->SetPath(wxT("/") + enclosureGroupName);
+						createGUIEnclosure(section.get(), organ, organ->getOrganPanelAt(0), lastEnclosure);
+					});
 				}
 			} else {
-				wxLogWarning("%s couldn't be found!", enclosureGroupName);
-				::wxGetApp().m_frame->GetLogWindow()->Show(true);
+				m_organ->getContext()->logWarning(wxString::Format("%s couldn't be found!", enclosureGroupName));
 			}
 		}
 		m_organFile->SetPath("/Organ");
@@ -266,19 +447,23 @@ void OrganFileParser::parseOrganSection() {
 		for (int i = 0; i < nbrSwitches; i++) {
 			m_organFile->SetPath("/");
 			wxString switchGroupName = wxT("Switch") + GOODF_functions::number_format(i + 1);
-			m_progressDlg->Update(20, wxT("Parsing [") + switchGroupName + wxT("] section"));
+			if (!updateProgress(20, wxT("Parsing [") + switchGroupName + wxT("] section")))
+				return;
 			if (m_organFile->HasGroup(switchGroupName)) {
 				m_organFile->SetPath(wxT("/") + switchGroupName);
 				GoSwitch sw;
 				sw.read(m_organFile, m_isUsingOldPanelFormat, m_organ);
 				m_organ->addSwitch(sw, true);
 				if (sw.isDisplayed()) {
-					int lastSwitchIdx = m_organ->getNumberOfSwitches() - 1;
-					createGUISwitch(m_organ->getOrganPanelAt(0), m_organ->getOrganSwitchAt(lastSwitchIdx));
+					GoSwitch *lastSwitch = m_organ->getOrganSwitchAt(m_organ->getNumberOfSwitches() - 1);
+					std::shared_ptr<wxFileConfig> section = GOODF_functions::copyConfigGroups(m_organFile, switchGroupName);
+					m_organ->getContext()->addGuiTask([organ, section, switchGroupName, lastSwitch]() {
+						section->SetPath(wxT("/") + switchGroupName);
+						createGUISwitch(section.get(), organ, organ->getOrganPanelAt(0), lastSwitch);
+					});
 				}
 			} else {
-				wxLogWarning("%s couldn't be found!", switchGroupName);
-				::wxGetApp().m_frame->GetLogWindow()->Show(true);
+				m_organ->getContext()->logWarning(wxString::Format("%s couldn't be found!", switchGroupName));
 			}
 		}
 		m_organFile->SetPath("/Organ");
@@ -290,19 +475,23 @@ void OrganFileParser::parseOrganSection() {
 		for (int i = 0; i < nbrTrems; i++) {
 			m_organFile->SetPath("/");
 			wxString tremGroupName = wxT("Tremulant") + GOODF_functions::number_format(i + 1);
-			m_progressDlg->Update(25, wxT("Parsing [") + tremGroupName + wxT("] section"));
+			if (!updateProgress(25, wxT("Parsing [") + tremGroupName + wxT("] section")))
+				return;
 			if (m_organFile->HasGroup(tremGroupName)) {
 				m_organFile->SetPath(wxT("/") + tremGroupName);
 				Tremulant trem;
 				trem.read(m_organFile, m_isUsingOldPanelFormat, m_organ);
 				m_organ->addTremulant(trem, true);
 				if (trem.isDisplayed()) {
-					int lastTremIdx = m_organ->getNumberOfTremulants() - 1;
-					createGUITremulant(m_organ->getOrganPanelAt(0), m_organ->getOrganTremulantAt(lastTremIdx));
+					Tremulant *lastTrem = m_organ->getOrganTremulantAt(m_organ->getNumberOfTremulants() - 1);
+					std::shared_ptr<wxFileConfig> section = GOODF_functions::copyConfigGroups(m_organFile, tremGroupName);
+					m_organ->getContext()->addGuiTask([organ, section, tremGroupName, lastTrem]() {
+						section->SetPath(wxT("/") + tremGroupName);
+						createGUITremulant(section.get(), organ, organ->getOrganPanelAt(0), lastTrem);
+					});
 				}
 			} else {
-				wxLogWarning("%s couldn't be found!", tremGroupName);
-				::wxGetApp().m_frame->GetLogWindow()->Show(true);
+				m_organ->getContext()->logWarning(wxString::Format("%s couldn't be found!", tremGroupName));
 			}
 		}
 		m_organFile->SetPath("/Organ");
@@ -314,22 +503,21 @@ void OrganFileParser::parseOrganSection() {
 		for (int i = 0; i < nbrWindchests; i++) {
 			m_organFile->SetPath("/");
 			wxString windchestGroupName = wxT("WindchestGroup") + GOODF_functions::number_format(i + 1);
-			m_progressDlg->Update(30, wxT("Parsing [") + windchestGroupName + wxT("] section"));
+			if (!updateProgress(30, wxT("Parsing [") + windchestGroupName + wxT("] section")))
+				return;
 			if (m_organFile->HasGroup(windchestGroupName)) {
 				m_organFile->SetPath(wxT("/") + windchestGroupName);
 				Windchestgroup windchest;
 				windchest.read(m_organFile, m_organ);
 				m_organ->addWindchestgroup(windchest);
 			} else {
-				wxLogWarning("%s couldn't be found!", windchestGroupName);
-				::wxGetApp().m_frame->GetLogWindow()->Show(true);
+				m_organ->getContext()->logWarning(wxString::Format("%s couldn't be found!", windchestGroupName));
 			}
 		}
 		m_organFile->SetPath("/Organ");
 	}
 	if (nbrWindchests == 0) {
-		wxLogWarning("There are no windchestgroups in the organ! The .organ file won't be functional until at least one windchestgroup exists!");
-		::wxGetApp().m_frame->GetLogWindow()->Show(true);
+		m_organ->getContext()->logWarning(wxT("There are no windchestgroups in the organ! The .organ file won't be functional until at least one windchestgroup exists!"));
 	}
 
 	// parse ranks
@@ -338,27 +526,35 @@ void OrganFileParser::parseOrganSection() {
 		for (int i = 0; i < nbrRanks; i++) {
 			m_organFile->SetPath("/");
 			wxString rankGroupName = wxT("Rank") + GOODF_functions::number_format(i + 1);
-			m_progressDlg->Update(35, wxT("Parsing [") + rankGroupName + wxT("] section"));
+			if (!updateProgress(35, wxT("Parsing [") + rankGroupName + wxT("] section")))
+				return;
 			if (m_organFile->HasGroup(rankGroupName)) {
 				m_organFile->SetPath(wxT("/") + rankGroupName);
 				Rank r;
-				r.read(m_organFile, m_organ);
+				std::map<wxString, wxArrayString>::const_iterator pipeEntryOrder = m_pipeEntryOrder.find(rankGroupName);
+				r.read(
+					m_organFile,
+					m_organ,
+					m_isParsingInSteps || m_organ->getContext()->isLoadingPipesOnDemand(),
+					pipeEntryOrder != m_pipeEntryOrder.end() ? &pipeEntryOrder->second : NULL
+				);
 				m_organ->addRank(r);
+				if (r.hasDeferredPipes() && r.hasDeferredLegacyXfades()) {
+					m_organ->getContext()->logWarning(wxString::Format("[Rank%0.3d] %s uses Pipe999ReleaseCrossfadeLength with LoadRelease=N! You might want to use Tools->Import Legacy X-fades.", m_organ->getNumberOfRanks(), r.getName()));
+				}
 				bool rankUsesLegacyXfades = false;
 				for (Pipe& p : r.m_pipes) {
 					if (!p.m_attacks.front().loadRelease && p.m_attacks.front().releaseCrossfadeLength) {
 						// This is certainly a legacy x-fade!
-						wxLogWarning("[Rank%0.3d] %s uses Pipe999ReleaseCrossfadeLength with LoadRelease=N! You might want to use Tools->Import Legacy X-fades.", m_organ->getNumberOfRanks(), r.getName());
+						m_organ->getContext()->logWarning(wxString::Format("[Rank%0.3d] %s uses Pipe999ReleaseCrossfadeLength with LoadRelease=N! You might want to use Tools->Import Legacy X-fades.", m_organ->getNumberOfRanks(), r.getName()));
 						rankUsesLegacyXfades = true;
 					}
 					if (rankUsesLegacyXfades) {
-						::wxGetApp().m_frame->GetLogWindow()->Show(true);
 						break;
 					}
 				}
 			} else {
-				wxLogWarning("%s couldn't be found!", rankGroupName);
-				::wxGetApp().m_frame->GetLogWindow()->Show(true);
+				m_organ->getContext()->logWarning(wxString::Format("%s couldn't be found!", rankGroupName));
 			}
 		}
 		m_organFile->SetPath("/Organ");
@@ -379,23 +575,27 @@ void OrganFileParser::parseOrganSection() {
 				manIdxNbr += 1;
 			wxString manGroupName = wxT("Manual") + GOODF_functions::number_format(manIdxNbr);
 			int dlgValue = 40 + (24 / nbrManuals) * i;
-			m_progressDlg->Update(dlgValue, wxT("Parsing [") + manGroupName + wxT("] section"));
+			if (!updateProgress(dlgValue, wxT("Parsing [") + manGroupName + wxT("] section")))
+				return;
 			if (m_organFile->HasGroup(manGroupName)) {
 				m_organFile->SetPath(wxT("/") + manGroupName);
 				Manual m;
 				if (manIdxNbr == 0)
-					m.setIsPedal(true, true);
+					m.setIsPedal(true, *m_organ->getContext(), true);
 				m_organ->addManual(m, true);
 				Manual *man = m_organ->getOrganManualAt(m_organ->getNumberOfManuals() - 1);
 				man->read(m_organFile, m_isUsingOldPanelFormat, manGroupName, m_organ);
 				if (man->isDisplayed()) {
-					createGUIManual(m_organ->getOrganPanelAt(0), man);
-					if (manGroupName.IsSameAs(wxT("Manual000")))
-						m_organ->getOrganPanelAt(0)->setHasPedals(true);
+					std::shared_ptr<wxFileConfig> section = GOODF_functions::copyConfigGroups(m_organFile, manGroupName);
+					m_organ->getContext()->addGuiTask([organ, section, manGroupName, man]() {
+						section->SetPath(wxT("/") + manGroupName);
+						createGUIManual(section.get(), organ, organ->getOrganPanelAt(0), man);
+						if (manGroupName.IsSameAs(wxT("Manual000")))
+							organ->getOrganPanelAt(0)->setHasPedals(true);
+					});
 				}
 			} else {
-				wxLogWarning("%s couldn't be found!", manGroupName);
-				::wxGetApp().m_frame->GetLogWindow()->Show(true);
+				m_organ->getContext()->logWarning(wxString::Format("%s couldn't be found!", manGroupName));
 			}
 		}
 
@@ -405,7 +605,8 @@ void OrganFileParser::parseOrganSection() {
 			if (!m_organ->doesHavePedals())
 				manIdxNbr += 1;
 			wxString manGroupName = wxT("Manual") + GOODF_functions::number_format(manIdxNbr);
-			m_progressDlg->Update(65, wxT("Parsing couplers for [") + manGroupName + wxT("]"));
+			if (!updateProgress(65, wxT("Parsing couplers for [") + manGroupName + wxT("]")))
+				return;
 			if (m_organFile->HasGroup(manGroupName) && i < (int) m_organ->getNumberOfManuals()) {
 				m_organFile->SetPath(wxT("/") + manGroupName);
 				Manual *man = m_organ->getOrganManualAt(i);
@@ -419,7 +620,8 @@ void OrganFileParser::parseOrganSection() {
 			if (!m_organ->doesHavePedals())
 				manIdxNbr += 1;
 			wxString manGroupName = wxT("Manual") + GOODF_functions::number_format(manIdxNbr);
-			m_progressDlg->Update(66, wxT("Parsing divisionals for [") + manGroupName + wxT("]"));
+			if (!updateProgress(66, wxT("Parsing divisionals for [") + manGroupName + wxT("]")))
+				return;
 			if (m_organFile->HasGroup(manGroupName) && i < (int) m_organ->getNumberOfManuals()) {
 				m_organFile->SetPath(wxT("/") + manGroupName);
 				Manual *man = m_organ->getOrganManualAt(i);
@@ -435,19 +637,23 @@ void OrganFileParser::parseOrganSection() {
 		for (int i = 0; i < nbrPistons; i++) {
 			m_organFile->SetPath("/");
 			wxString pistonGroupName = wxT("ReversiblePiston") + GOODF_functions::number_format(i + 1);
-			m_progressDlg->Update(68, wxT("Parsing [") + pistonGroupName + wxT("] section"));
+			if (!updateProgress(68, wxT("Parsing [") + pistonGroupName + wxT("] section")))
+				return;
 			if (m_organFile->HasGroup(pistonGroupName)) {
 				m_organFile->SetPath(wxT("/") + pistonGroupName);
 				ReversiblePiston p;
 				p.read(m_organFile, m_isUsingOldPanelFormat, m_organ);
 				m_organ->addReversiblePiston(p, true);
 				if (p.isDisplayed()) {
-					unsigned lastPistonIdx = m_organ->getNumberOfReversiblePistons() - 1;
-					createGUIPiston(m_organ->getOrganPanelAt(0), m_organ->getReversiblePistonAt(lastPistonIdx));
+					ReversiblePiston *lastPiston = m_organ->getReversiblePistonAt(m_organ->getNumberOfReversiblePistons() - 1);
+					std::shared_ptr<wxFileConfig> section = GOODF_functions::copyConfigGroups(m_organFile, pistonGroupName);
+					m_organ->getContext()->addGuiTask([organ, section, pistonGroupName, lastPiston]() {
+						section->SetPath(wxT("/") + pistonGroupName);
+						createGUIPiston(section.get(), organ, organ->getOrganPanelAt(0), lastPiston);
+					});
 				}
 			} else {
-				wxLogWarning("%s couldn't be found!", pistonGroupName);
-				::wxGetApp().m_frame->GetLogWindow()->Show(true);
+				m_organ->getContext()->logWarning(wxString::Format("%s couldn't be found!", pistonGroupName));
 			}
 		}
 		m_organFile->SetPath("/Organ");
@@ -459,19 +665,23 @@ void OrganFileParser::parseOrganSection() {
 		for (int i = 0; i < nbrDivCplrs; i++) {
 			m_organFile->SetPath("/");
 			wxString divCplrGroupName = wxT("DivisionalCoupler") + GOODF_functions::number_format(i + 1);
-			m_progressDlg->Update(70, wxT("Parsing [") + divCplrGroupName + wxT("] section"));
+			if (!updateProgress(70, wxT("Parsing [") + divCplrGroupName + wxT("] section")))
+				return;
 			if (m_organFile->HasGroup(divCplrGroupName)) {
 				m_organFile->SetPath(wxT("/") + divCplrGroupName);
 				DivisionalCoupler divCplr;
 				divCplr.read(m_organFile, m_isUsingOldPanelFormat, m_organ);
 				m_organ->addDivisionalCoupler(divCplr, true);
 				if (divCplr.isDisplayed()) {
-					unsigned lastIdx = m_organ->getNumberOfOrganDivisionalCouplers() - 1;
-					createGUIDivCplr(m_organ->getOrganPanelAt(0), m_organ->getOrganDivisionalCouplerAt(lastIdx));
+					DivisionalCoupler *lastDivCplr = m_organ->getOrganDivisionalCouplerAt(m_organ->getNumberOfOrganDivisionalCouplers() - 1);
+					std::shared_ptr<wxFileConfig> section = GOODF_functions::copyConfigGroups(m_organFile, divCplrGroupName);
+					m_organ->getContext()->addGuiTask([organ, section, divCplrGroupName, lastDivCplr]() {
+						section->SetPath(wxT("/") + divCplrGroupName);
+						createGUIDivCplr(section.get(), organ, organ->getOrganPanelAt(0), lastDivCplr);
+					});
 				}
 			} else {
-				wxLogWarning("%s couldn't be found!", divCplrGroupName);
-				::wxGetApp().m_frame->GetLogWindow()->Show(true);
+				m_organ->getContext()->logWarning(wxString::Format("%s couldn't be found!", divCplrGroupName));
 			}
 		}
 		m_organFile->SetPath("/Organ");
@@ -483,19 +693,23 @@ void OrganFileParser::parseOrganSection() {
 		for (int i = 0; i < nbrGenerals; i++) {
 			m_organFile->SetPath("/");
 			wxString generalGroupName = wxT("General") + GOODF_functions::number_format(i + 1);
-			m_progressDlg->Update(75, wxT("Parsing [") + generalGroupName + wxT("] section"));
+			if (!updateProgress(75, wxT("Parsing [") + generalGroupName + wxT("] section")))
+				return;
 			if (m_organFile->HasGroup(generalGroupName)) {
 				m_organFile->SetPath(wxT("/") + generalGroupName);
 				General g;
 				g.read(m_organFile, m_isUsingOldPanelFormat, m_organ);
 				m_organ->addGeneral(g, true);
 				if (g.isDisplayed()) {
-					unsigned lastIdx = m_organ->getNumberOfGenerals() - 1;
-					createGUIGeneral(m_organ->getOrganPanelAt(0), m_organ->getOrganGeneralAt(lastIdx));
+					General *lastGeneral = m_organ->getOrganGeneralAt(m_organ->getNumberOfGenerals() - 1);
+					std::shared_ptr<wxFileConfig> section = GOODF_functions::copyConfigGroups(m_organFile, generalGroupName);
+					m_organ->getContext()->addGuiTask([organ, section, generalGroupName, lastGeneral]() {
+						section->SetPath(wxT("/") + generalGroupName);
+						createGUIGeneral(section.get(), organ, organ->getOrganPanelAt(0), lastGeneral);
+					});
 				}
 			} else {
-				wxLogWarning("%s couldn't be found!", generalGroupName);
-				::wxGetApp().m_frame->GetLogWindow()->Show(true);
+				m_organ->getContext()->logWarning(wxString::Format("%s couldn't be found!", generalGroupName));
 			}
 		}
 		m_organFile->SetPath("/Organ");
@@ -509,16 +723,20 @@ void OrganFileParser::parseOrganSection() {
 			for (int i = 0; i < nbrSetters; i++) {
 				m_organFile->SetPath("/");
 				wxString setterGroupName = wxT("SetterElement") + GOODF_functions::number_format(i + 1);
-				m_progressDlg->Update(80, wxT("Parsing old style [") + setterGroupName + wxT("] section"));
+				if (!updateProgress(80, wxT("Parsing old style [") + setterGroupName + wxT("] section")))
+					return;
 				if (m_organFile->HasGroup(setterGroupName)) {
 					m_organFile->SetPath(wxT("/") + setterGroupName);
 					wxString elementType = m_organFile->Read("Type", wxEmptyString);
 					if (elementType != wxEmptyString) {
-						createFromSetterElement(m_organ->getOrganPanelAt(0), elementType);
+						std::shared_ptr<wxFileConfig> section = GOODF_functions::copyConfigGroups(m_organFile, setterGroupName);
+						m_organ->getContext()->addGuiTask([organ, section, setterGroupName, elementType]() {
+							section->SetPath(wxT("/") + setterGroupName);
+							createFromSetterElement(section.get(), organ, organ->getOrganPanelAt(0), elementType);
+						});
 					}
 				} else {
-					wxLogWarning("%s couldn't be found!", setterGroupName);
-					::wxGetApp().m_frame->GetLogWindow()->Show(true);
+					m_organ->getContext()->logWarning(wxString::Format("%s couldn't be found!", setterGroupName));
 				}
 			}
 		}
@@ -531,33 +749,38 @@ void OrganFileParser::parseOrganSection() {
 		// For the new format there exist a [Panel000] as main panel that can have GUI elements that must be read.
 		// That panel is already created with the organ and it won't be included in the count of number of panels either.
 		// The check if that section exist in the .organ file has already been done.
-		m_organFile->SetPath(wxT("/Panel000"));
-		m_progressDlg->Update(85, wxT("Parsing [Panel000] GUI elements"));
-		parsePanelElements(m_organ->getOrganPanelAt(0), wxT("Panel000"));
+		updateProgress(85, wxT("Parsing [Panel000] GUI elements"));
+		std::shared_ptr<wxFileConfig> panelSections = GOODF_functions::copyConfigGroups(m_organFile, wxT("Panel000"), true);
+		m_organ->getContext()->addGuiTask([organ, panelSections]() {
+			panelSections->SetPath(wxT("/Panel000"));
+			parsePanelElements(panelSections.get(), organ, organ->getOrganPanelAt(0), wxT("Panel000"));
+		});
 		m_organFile->SetPath("/Organ");
 	}
 	if (nbrPanels > 0 && nbrPanels < 100) {
 		for (int i = 0; i < nbrPanels; i++) {
 			m_organFile->SetPath("/");
 			wxString panelGroupName = wxT("Panel") + GOODF_functions::number_format(i + 1);
-			m_progressDlg->Update(90, wxT("Parsing [") + panelGroupName + wxT("] section"));
 			if (m_organFile->HasGroup(panelGroupName)) {
-				m_organFile->SetPath(wxT("/") + panelGroupName);
-				GoPanel p;
-				p.read(m_organFile, panelGroupName, m_organ);
-				m_organ->addPanel(p);
-				parsePanelElements(m_organ->getOrganPanelAt(m_organ->getNumberOfPanels() - 1), panelGroupName);
+				updateProgress(90, wxT("Parsing [") + panelGroupName + wxT("] section"));
+				std::shared_ptr<wxFileConfig> panelSections = GOODF_functions::copyConfigGroups(m_organFile, panelGroupName, true);
+				m_organ->getContext()->addGuiTask([organ, panelSections, panelGroupName]() {
+					panelSections->SetPath(wxT("/") + panelGroupName);
+					GoPanel p;
+					p.read(panelSections.get(), panelGroupName, organ);
+					organ->addPanel(p);
+					parsePanelElements(panelSections.get(), organ, organ->getOrganPanelAt(organ->getNumberOfPanels() - 1), panelGroupName);
+				});
 			} else {
-				wxLogWarning("%s couldn't be found!", panelGroupName);
-				::wxGetApp().m_frame->GetLogWindow()->Show(true);
+				m_organ->getContext()->logWarning(wxString::Format("%s couldn't be found!", panelGroupName));
 			}
 		}
 		m_organFile->SetPath("/Organ");
 	}
-	m_progressDlg->Update(100, wxT("Whole .organ file has been parsed!"));
+	updateProgress(100, wxT("Whole .organ file has been parsed!"));
 }
 
-void OrganFileParser::createGUIEnclosure(GoPanel *targetPanel, Enclosure *enclosure) {
+void OrganFileParser::createGUIEnclosure(wxFileConfig *cfg, Organ *organ, GoPanel *targetPanel, Enclosure *enclosure) {
 	GUIElement *guiEnc = new GUIEnclosure(enclosure);
 	guiEnc->setOwningPanel(targetPanel);
 	if (enclosure)
@@ -567,11 +790,11 @@ void OrganFileParser::createGUIEnclosure(GoPanel *targetPanel, Enclosure *enclos
 	// convert gui element back to enclosure type for parsing
 	GUIEnclosure *encElement = dynamic_cast<GUIEnclosure*>(guiEnc);
 	if (encElement) {
-		encElement->read(m_organFile, m_organ);
+		encElement->read(cfg, organ);
 	}
 }
 
-void OrganFileParser::createGUITremulant(GoPanel *targetPanel, Tremulant *tremulant) {
+void OrganFileParser::createGUITremulant(wxFileConfig *cfg, Organ *organ, GoPanel *targetPanel, Tremulant *tremulant) {
 	GUIElement *guiTrem = new GUITremulant(tremulant);
 	guiTrem->setOwningPanel(targetPanel);
 	guiTrem->setDisplayName(tremulant->getName());
@@ -580,11 +803,11 @@ void OrganFileParser::createGUITremulant(GoPanel *targetPanel, Tremulant *tremul
 
 	GUITremulant *tremElement = dynamic_cast<GUITremulant*>(guiTrem);
 	if (tremElement) {
-		tremElement->read(m_organFile, m_organ);
+		tremElement->read(cfg, organ);
 	}
 }
 
-void OrganFileParser::createGUISwitch(GoPanel *targetPanel, GoSwitch *theSwitch) {
+void OrganFileParser::createGUISwitch(wxFileConfig *cfg, Organ *organ, GoPanel *targetPanel, GoSwitch *theSwitch) {
 	GUIElement *guiSwitch = new GUISwitch(theSwitch);
 	guiSwitch->setOwningPanel(targetPanel);
 	if (theSwitch)
@@ -594,24 +817,24 @@ void OrganFileParser::createGUISwitch(GoPanel *targetPanel, GoSwitch *theSwitch)
 
 	GUISwitch *switchElement = dynamic_cast<GUISwitch*>(guiSwitch);
 	if (switchElement) {
-		switchElement->read(m_organFile, m_organ);
+		switchElement->read(cfg, organ);
 	}
 }
 
-void OrganFileParser::createGUILabel(GoPanel *targetPanel) {
+void OrganFileParser::createGUILabel(wxFileConfig *cfg, Organ *organ, GoPanel *targetPanel) {
 	GUIElement *label = new GUILabel();
 	label->setOwningPanel(targetPanel);
-	label->updateDisplayName();
+	label->updateDisplayName(*organ->getContext());
 	label->setDefaultFont(targetPanel->getDisplayMetrics()->m_dispGroupLabelFont);
 	targetPanel->addGuiElement(label);
 
 	GUILabel *theLabel = dynamic_cast<GUILabel*>(label);
 	if (theLabel) {
-		theLabel->read(m_organFile, m_organ);
+		theLabel->read(cfg, organ);
 	}
 }
 
-void OrganFileParser::createGUIManual(GoPanel *targetPanel, Manual *manual) {
+void OrganFileParser::createGUIManual(wxFileConfig *cfg, Organ *organ, GoPanel *targetPanel, Manual *manual) {
 	GUIElement *man = new GUIManual(manual);
 	man->setOwningPanel(targetPanel);
 	man->setDisplayName(manual->getName());
@@ -619,11 +842,11 @@ void OrganFileParser::createGUIManual(GoPanel *targetPanel, Manual *manual) {
 
 	GUIManual *theManual = dynamic_cast<GUIManual*>(man);
 	if (theManual) {
-		theManual->read(m_organFile, m_organ);
+		theManual->read(cfg, organ);
 	}
 }
 
-void OrganFileParser::createGUIPiston(GoPanel *targetPanel, ReversiblePiston *piston) {
+void OrganFileParser::createGUIPiston(wxFileConfig *cfg, Organ *organ, GoPanel *targetPanel, ReversiblePiston *piston) {
 	GUIElement *revPiston = new GUIReversiblePiston(piston);
 	revPiston->setOwningPanel(targetPanel);
 	revPiston->setDisplayName(piston->getName());
@@ -632,11 +855,11 @@ void OrganFileParser::createGUIPiston(GoPanel *targetPanel, ReversiblePiston *pi
 
 	GUIReversiblePiston *thePiston = dynamic_cast<GUIReversiblePiston*>(revPiston);
 	if (thePiston) {
-		thePiston->read(m_organFile, thePiston->isDisplayAsPiston(), m_organ);
+		thePiston->read(cfg, thePiston->isDisplayAsPiston(), organ);
 	}
 }
 
-void OrganFileParser::createGUIDivCplr(GoPanel *targetPanel, DivisionalCoupler *div_cplr) {
+void OrganFileParser::createGUIDivCplr(wxFileConfig *cfg, Organ *organ, GoPanel *targetPanel, DivisionalCoupler *div_cplr) {
 	GUIElement *divCoupler = new GUIDivisionalCoupler(div_cplr);
 	divCoupler->setOwningPanel(targetPanel);
 	divCoupler->setDisplayName(div_cplr->getName());
@@ -645,11 +868,11 @@ void OrganFileParser::createGUIDivCplr(GoPanel *targetPanel, DivisionalCoupler *
 
 	GUIDivisionalCoupler *theDivCplr = dynamic_cast<GUIDivisionalCoupler*>(divCoupler);
 	if (theDivCplr) {
-		theDivCplr->read(m_organFile, theDivCplr->isDisplayAsPiston(), m_organ);
+		theDivCplr->read(cfg, theDivCplr->isDisplayAsPiston(), organ);
 	}
 }
 
-void OrganFileParser::createGUIGeneral(GoPanel *targetPanel, General *general) {
+void OrganFileParser::createGUIGeneral(wxFileConfig *cfg, Organ *organ, GoPanel *targetPanel, General *general) {
 	GUIElement *gen = new GUIGeneral(general);
 	gen->setOwningPanel(targetPanel);
 	if (general)
@@ -659,11 +882,11 @@ void OrganFileParser::createGUIGeneral(GoPanel *targetPanel, General *general) {
 
 	GUIGeneral *theGeneral = dynamic_cast<GUIGeneral*>(gen);
 	if (theGeneral) {
-		theGeneral->read(m_organFile, theGeneral->isDisplayAsPiston(), m_organ);
+		theGeneral->read(cfg, theGeneral->isDisplayAsPiston(), organ);
 	}
 }
 
-void OrganFileParser::createGUIDivisional(GoPanel *targetPanel, Divisional *divisional) {
+void OrganFileParser::createGUIDivisional(wxFileConfig *cfg, Organ *organ, GoPanel *targetPanel, Divisional *divisional) {
 	GUIElement *guiDiv = new GUIDivisional(divisional);
 	guiDiv->setOwningPanel(targetPanel);
 	guiDiv->setDefaultFont(targetPanel->getDisplayMetrics()->m_dispControlLabelFont);
@@ -671,11 +894,11 @@ void OrganFileParser::createGUIDivisional(GoPanel *targetPanel, Divisional *divi
 
 	GUIDivisional *divElement = dynamic_cast<GUIDivisional*>(guiDiv);
 	if (divElement) {
-		divElement->read(m_organFile, true, m_organ);
+		divElement->read(cfg, true, organ);
 	}
 }
 
-void OrganFileParser::createFromSetterElement(GoPanel *targetPanel, wxString elementType) {
+void OrganFileParser::createFromSetterElement(wxFileConfig *cfg, Organ *organ, GoPanel *targetPanel, wxString elementType) {
 	if (elementType == wxT("CrescendoLabel") ||
 		elementType == wxT("CurrFileName") ||
 		elementType == wxT("GeneralLabel") ||
@@ -684,7 +907,7 @@ void OrganFileParser::createFromSetterElement(GoPanel *targetPanel, wxString ele
 		elementType == wxT("TemperamentLabel") ||
 		elementType == wxT("TransposeLabel") ) {
 		// this setter element is a type of label
-		createGUILabel(targetPanel);
+		createGUILabel(cfg, organ, targetPanel);
 		// the label element type must be overridden
 		GUIElement *e = targetPanel->getGuiElementAt(targetPanel->getNumberOfGuiElements() - 1);
 		e->setType(elementType);
@@ -697,22 +920,22 @@ void OrganFileParser::createFromSetterElement(GoPanel *targetPanel, wxString ele
 			return;
 		}
 		int targetManual = (int) value;
-		if (targetManual > (int)::wxGetApp().m_frame->m_organ->getNumberOfManuals()) {
+		if (targetManual > (int)organ->getNumberOfManuals()) {
 			return;
 		}
-		createGUILabel(targetPanel);
+		createGUILabel(cfg, organ, targetPanel);
 		// the element type must be overridden
 		GUIElement *e = targetPanel->getGuiElementAt(targetPanel->getNumberOfGuiElements() - 1);
 		e->setType(elementType);
 		e->setDisplayName(elementType);
 	} else if (elementType == wxT("Swell")) {
-		createGUIEnclosure(targetPanel, NULL);
+		createGUIEnclosure(cfg, organ, targetPanel, NULL);
 		// the element type must be overridden
 		GUIElement *e = targetPanel->getGuiElementAt(targetPanel->getNumberOfGuiElements() - 1);
 		e->setType(elementType);
 		e->setDisplayName(elementType);
 	} else if (elementType.StartsWith("General") && elementType.Len() == 9) {
-		createGUIGeneral(targetPanel, NULL);
+		createGUIGeneral(cfg, organ, targetPanel, NULL);
 		// the element type must be overridden
 		GUIElement *e = targetPanel->getGuiElementAt(targetPanel->getNumberOfGuiElements() - 1);
 		e->setType(elementType);
@@ -725,14 +948,14 @@ void OrganFileParser::createFromSetterElement(GoPanel *targetPanel, wxString ele
 			return;
 		}
 		int targetManual = (int) value;
-		if (targetManual > (int)::wxGetApp().m_frame->m_organ->getNumberOfManuals()) {
+		if (targetManual > (int)organ->getNumberOfManuals()) {
 			return;
 		}
 		wxString divNbrStr = elementType.Mid(19 ,3);
 		if (!divNbrStr.ToLong(&value)) {
 			return;
 		}
-		createGUIDivisional(targetPanel, NULL);
+		createGUIDivisional(cfg, organ, targetPanel, NULL);
 		// the element type must be overridden
 		GUIElement *e = targetPanel->getGuiElementAt(targetPanel->getNumberOfGuiElements() - 1);
 		e->setType(elementType);
@@ -745,17 +968,17 @@ void OrganFileParser::createFromSetterElement(GoPanel *targetPanel, wxString ele
 			return;
 		}
 		int targetManual = (int) value;
-		if (targetManual > (int)::wxGetApp().m_frame->m_organ->getNumberOfManuals()) {
+		if (targetManual > (int)organ->getNumberOfManuals()) {
 			return;
 		}
-		createGUIDivisional(targetPanel, NULL);
+		createGUIDivisional(cfg, organ, targetPanel, NULL);
 		// the element type must be overridden
 		GUIElement *e = targetPanel->getGuiElementAt(targetPanel->getNumberOfGuiElements() - 1);
 		e->setType(elementType);
 		e->setDisplayName(elementType);
-	} else if (m_organ->getSetterElements().Index(elementType) != wxNOT_FOUND) {
+	} else if (organ->getSetterElements().Index(elementType) != wxNOT_FOUND) {
 		// any other valid type we simply create as a gui switch
-		createGUISwitch(targetPanel, NULL);
+		createGUISwitch(cfg, organ, targetPanel, NULL);
 		// the element type must be overridden
 		GUIElement *e = targetPanel->getGuiElementAt(targetPanel->getNumberOfGuiElements() - 1);
 		e->setType(elementType);
@@ -763,7 +986,7 @@ void OrganFileParser::createFromSetterElement(GoPanel *targetPanel, wxString ele
 	}
 }
 
-void OrganFileParser::createGUICoupler(GoPanel *targetPanel, Coupler *coupler) {
+void OrganFileParser::createGUICoupler(wxFileConfig *cfg, Organ *organ, GoPanel *targetPanel, Coupler *coupler) {
 	GUIElement *guiCplr = new GUICoupler(coupler);
 	guiCplr->setOwningPanel(targetPanel);
 	guiCplr->setDisplayName(coupler->getName());
@@ -772,11 +995,11 @@ void OrganFileParser::createGUICoupler(GoPanel *targetPanel, Coupler *coupler) {
 
 	GUICoupler *cplrElement = dynamic_cast<GUICoupler*>(guiCplr);
 	if (cplrElement) {
-		cplrElement->read(m_organFile, false, m_organ);
+		cplrElement->read(cfg, false, organ);
 	}
 }
 
-void OrganFileParser::createGUIStop(GoPanel *targetPanel, Stop *stop) {
+void OrganFileParser::createGUIStop(wxFileConfig *cfg, Organ *organ, GoPanel *targetPanel, Stop *stop) {
 	GUIElement *guiStop = new GUIStop(stop);
 	guiStop->setOwningPanel(targetPanel);
 	guiStop->setDisplayName(stop->getName());
@@ -785,297 +1008,295 @@ void OrganFileParser::createGUIStop(GoPanel *targetPanel, Stop *stop) {
 
 	GUIStop *stopElement = dynamic_cast<GUIStop*>(guiStop);
 	if (stopElement) {
-		stopElement->read(m_organFile, false, m_organ);
+		stopElement->read(cfg, false, organ);
 	}
 }
 
-void OrganFileParser::parsePanelElements(GoPanel *targetPanel, wxString panelId) {
-	int nbrGuiElements = static_cast<int>(m_organFile->ReadLong("NumberOfGUIElements", 0));
+void OrganFileParser::parsePanelElements(wxFileConfig *cfg, Organ *organ, GoPanel *targetPanel, wxString panelId) {
+	int nbrGuiElements = static_cast<int>(cfg->ReadLong("NumberOfGUIElements", 0));
 	if (panelId.IsSameAs(wxT("Panel000"), false) || nbrGuiElements > 0) {
 		if (nbrGuiElements > 0 && nbrGuiElements < 1000) {
 			for (int i = 0; i < nbrGuiElements; i++) {
 				wxString elementGroupName = wxT("Element") + GOODF_functions::number_format(i + 1);
-				m_organFile->SetPath(wxT("/"));
-				if (m_organFile->HasGroup(panelId + elementGroupName)) {
-					m_organFile->SetPath(wxT("/") + panelId + elementGroupName);
-					wxString elementType = m_organFile->Read("Type", wxEmptyString);
+				cfg->SetPath(wxT("/"));
+				if (cfg->HasGroup(panelId + elementGroupName)) {
+					cfg->SetPath(wxT("/") + panelId + elementGroupName);
+					wxString elementType = cfg->Read("Type", wxEmptyString);
 					if (elementType.IsSameAs(wxT("Divisional"))) {
-						int manualIdx = static_cast<int>(m_organFile->ReadLong("Manual", -1));
-						if (manualIdx >= 0 && manualIdx <= (int)m_organ->getNumberOfManuals()) {
-							if (!m_organ->doesHavePedals() && manualIdx > 0)
+						int manualIdx = static_cast<int>(cfg->ReadLong("Manual", -1));
+						if (manualIdx >= 0 && manualIdx <= (int)organ->getNumberOfManuals()) {
+							if (!organ->doesHavePedals() && manualIdx > 0)
 								manualIdx -= 1;
-							Manual *man = m_organ->getOrganManualAt(manualIdx);
-							int divIdx = static_cast<int>(m_organFile->ReadLong("Divisional", 0));
+							Manual *man = organ->getOrganManualAt(manualIdx);
+							int divIdx = static_cast<int>(cfg->ReadLong("Divisional", 0));
 							if (divIdx > 0 && divIdx <= (int)man->getNumberOfDivisionals()) {
-								createGUIDivisional(targetPanel, man->getDivisionalAt(divIdx - 1));
+								createGUIDivisional(cfg, organ, targetPanel, man->getDivisionalAt(divIdx - 1));
 							}
 						}
 					} else if (elementType.IsSameAs(wxT("Coupler"))) {
-						int manualIdx = static_cast<int>(m_organFile->ReadLong("Manual", -1));
-						if (manualIdx >= 0 && manualIdx <= (int)m_organ->getNumberOfManuals()) {
-							if (!m_organ->doesHavePedals() && manualIdx > 0)
+						int manualIdx = static_cast<int>(cfg->ReadLong("Manual", -1));
+						if (manualIdx >= 0 && manualIdx <= (int)organ->getNumberOfManuals()) {
+							if (!organ->doesHavePedals() && manualIdx > 0)
 								manualIdx -= 1;
-							Manual *man = m_organ->getOrganManualAt(manualIdx);
-							int cplrIdx = static_cast<int>(m_organFile->ReadLong("Coupler", 0));
+							Manual *man = organ->getOrganManualAt(manualIdx);
+							int cplrIdx = static_cast<int>(cfg->ReadLong("Coupler", 0));
 							if (cplrIdx > 0 && cplrIdx <= (int)man->getNumberOfCouplers()) {
-								createGUICoupler(targetPanel, man->getCouplerAt(cplrIdx - 1));
+								createGUICoupler(cfg, organ, targetPanel, man->getCouplerAt(cplrIdx - 1));
 							}
 						}
 					} else if (elementType.IsSameAs(wxT("Stop"))) {
-						int manualIdx = static_cast<int>(m_organFile->ReadLong("Manual", -1));
-						if (manualIdx >= 0 && manualIdx <= (int)m_organ->getNumberOfManuals()) {
-							if (!m_organ->doesHavePedals() && manualIdx > 0)
+						int manualIdx = static_cast<int>(cfg->ReadLong("Manual", -1));
+						if (manualIdx >= 0 && manualIdx <= (int)organ->getNumberOfManuals()) {
+							if (!organ->doesHavePedals() && manualIdx > 0)
 								manualIdx -= 1;
-							Manual *man = m_organ->getOrganManualAt(manualIdx);
-							int stopIdx = static_cast<int>(m_organFile->ReadLong("Stop", 0));
+							Manual *man = organ->getOrganManualAt(manualIdx);
+							int stopIdx = static_cast<int>(cfg->ReadLong("Stop", 0));
 							if (stopIdx > 0 && stopIdx <= (int)man->getNumberOfStops()) {
-								createGUIStop(targetPanel, man->getStopAt(stopIdx - 1));
+								createGUIStop(cfg, organ, targetPanel, man->getStopAt(stopIdx - 1));
 							}
 						}
 					} else if (elementType.IsSameAs(wxT("Enclosure"))) {
-						int enclosureIdx = static_cast<int>(m_organFile->ReadLong("Enclosure", 0));
-						if (enclosureIdx > 0 && enclosureIdx <= (int)m_organ->getNumberOfEnclosures()) {
-							createGUIEnclosure(targetPanel, m_organ->getOrganEnclosureAt(enclosureIdx - 1));
+						int enclosureIdx = static_cast<int>(cfg->ReadLong("Enclosure", 0));
+						if (enclosureIdx > 0 && enclosureIdx <= (int)organ->getNumberOfEnclosures()) {
+							createGUIEnclosure(cfg, organ, targetPanel, organ->getOrganEnclosureAt(enclosureIdx - 1));
 						}
 					} else if (elementType.IsSameAs(wxT("Tremulant"))) {
-						int tremIdx = static_cast<int>(m_organFile->ReadLong("Tremulant", 0));
-						if (tremIdx > 0 && tremIdx <= (int)m_organ->getNumberOfTremulants()) {
-							createGUITremulant(targetPanel, m_organ->getOrganTremulantAt(tremIdx - 1));
+						int tremIdx = static_cast<int>(cfg->ReadLong("Tremulant", 0));
+						if (tremIdx > 0 && tremIdx <= (int)organ->getNumberOfTremulants()) {
+							createGUITremulant(cfg, organ, targetPanel, organ->getOrganTremulantAt(tremIdx - 1));
 						}
 					} else if (elementType.IsSameAs(wxT("DivisionalCoupler"))) {
-						int divCplrIdx = static_cast<int>(m_organFile->ReadLong("DivisionalCoupler", 0));
-						if (divCplrIdx > 0 && divCplrIdx <= (int)m_organ->getNumberOfOrganDivisionalCouplers()) {
-							createGUIDivCplr(targetPanel, m_organ->getOrganDivisionalCouplerAt(divCplrIdx - 1));
+						int divCplrIdx = static_cast<int>(cfg->ReadLong("DivisionalCoupler", 0));
+						if (divCplrIdx > 0 && divCplrIdx <= (int)organ->getNumberOfOrganDivisionalCouplers()) {
+							createGUIDivCplr(cfg, organ, targetPanel, organ->getOrganDivisionalCouplerAt(divCplrIdx - 1));
 						}
 					} else if (elementType.IsSameAs(wxT("General"))) {
-						int genIdx = static_cast<int>(m_organFile->ReadLong("General", 0));
-						if (genIdx > 0 && genIdx <= (int)m_organ->getNumberOfGenerals()) {
-							createGUIGeneral(targetPanel, m_organ->getOrganGeneralAt(genIdx - 1));
+						int genIdx = static_cast<int>(cfg->ReadLong("General", 0));
+						if (genIdx > 0 && genIdx <= (int)organ->getNumberOfGenerals()) {
+							createGUIGeneral(cfg, organ, targetPanel, organ->getOrganGeneralAt(genIdx - 1));
 						}
 					} else if (elementType.IsSameAs(wxT("ReversiblePiston"))) {
-						int revPistonIdx = static_cast<int>(m_organFile->ReadLong("ReversiblePiston", 0));
-						if (revPistonIdx > 0 && revPistonIdx <= (int)m_organ->getNumberOfReversiblePistons()) {
-							createGUIPiston(targetPanel, m_organ->getReversiblePistonAt(revPistonIdx - 1));
+						int revPistonIdx = static_cast<int>(cfg->ReadLong("ReversiblePiston", 0));
+						if (revPistonIdx > 0 && revPistonIdx <= (int)organ->getNumberOfReversiblePistons()) {
+							createGUIPiston(cfg, organ, targetPanel, organ->getReversiblePistonAt(revPistonIdx - 1));
 						}
 					} else if (elementType.IsSameAs(wxT("Switch"))) {
-						int switchIdx = static_cast<int>(m_organFile->ReadLong("Switch", 0));
-						if (switchIdx > 0 && switchIdx <= (int)m_organ->getNumberOfSwitches()) {
-							createGUISwitch(targetPanel, m_organ->getOrganSwitchAt(switchIdx - 1));
+						int switchIdx = static_cast<int>(cfg->ReadLong("Switch", 0));
+						if (switchIdx > 0 && switchIdx <= (int)organ->getNumberOfSwitches()) {
+							createGUISwitch(cfg, organ, targetPanel, organ->getOrganSwitchAt(switchIdx - 1));
 						}
 					} else if (elementType.IsSameAs(wxT("Label"))) {
-						createGUILabel(targetPanel);
+						createGUILabel(cfg, organ, targetPanel);
 					} else if (elementType.IsSameAs(wxT("Manual"))) {
-						int manIdx = static_cast<int>(m_organFile->ReadLong("Manual", -1));
-						if (manIdx >= 0 && manIdx <= (int)m_organ->getNumberOfManuals()) {
-							if (!m_organ->doesHavePedals() && manIdx > 0)
+						int manIdx = static_cast<int>(cfg->ReadLong("Manual", -1));
+						if (manIdx >= 0 && manIdx <= (int)organ->getNumberOfManuals()) {
+							if (!organ->doesHavePedals() && manIdx > 0)
 								manIdx -= 1;
-							createGUIManual(targetPanel, m_organ->getOrganManualAt(manIdx));
+							createGUIManual(cfg, organ, targetPanel, organ->getOrganManualAt(manIdx));
 						}
 					} else {
 						// the type can also be a valid setter element
-						createFromSetterElement(targetPanel, elementType);
+						createFromSetterElement(cfg, organ, targetPanel, elementType);
 					}
 				} else {
-					wxLogWarning("%s%s couldn't be found!", panelId, elementGroupName);
-					::wxGetApp().m_frame->GetLogWindow()->Show(true);
+					organ->getContext()->logWarning(wxString::Format("%s%s couldn't be found!", panelId, elementGroupName));
 				}
 			}
-			m_organFile->SetPath(wxT("/") + panelId);
+			cfg->SetPath(wxT("/") + panelId);
 		} else {
-			wxLogWarning("NumberOfGUIElements=%d is invalid in %s!", nbrGuiElements, panelId);
-			::wxGetApp().m_frame->GetLogWindow()->Show(true);
+			organ->getContext()->logWarning(wxString::Format("NumberOfGUIElements=%d is invalid in %s!", nbrGuiElements, panelId));
 		}
 	} else {
 		// old style panel elements are read in another way, but they will be converted to the new style
-		int nbrManuals = static_cast<int>(m_organFile->ReadLong("NumberOfManuals", 0));
+		int nbrManuals = static_cast<int>(cfg->ReadLong("NumberOfManuals", 0));
 		for (int i = 0; i < nbrManuals; i++) {
 			wxString manStr = wxT("Manual") + GOODF_functions::number_format(i + 1);
-			int manRefId = static_cast<int>(m_organFile->ReadLong(manStr, -1));
-			if (manRefId >= 0 && manRefId <= (int)m_organ->getNumberOfManuals()) {
+			int manRefId = static_cast<int>(cfg->ReadLong(manStr, -1));
+			if (manRefId >= 0 && manRefId <= (int)organ->getNumberOfManuals()) {
 				int manIdx = manRefId;
-				if (!m_organ->doesHavePedals() && manIdx > 0)
+				if (!organ->doesHavePedals() && manIdx > 0)
 					manIdx -= 1;
 				wxString thePath = panelId + wxT("Manual") + GOODF_functions::number_format(manRefId);
-				m_organFile->SetPath(wxT("/"));
-				if (m_organFile->HasGroup(thePath)) {
-					m_organFile->SetPath(wxT("/") + thePath);
-					createGUIManual(targetPanel, m_organ->getOrganManualAt(manIdx));
+				cfg->SetPath(wxT("/"));
+				if (cfg->HasGroup(thePath)) {
+					cfg->SetPath(wxT("/") + thePath);
+					createGUIManual(cfg, organ, targetPanel, organ->getOrganManualAt(manIdx));
 				}
 			}
-			m_organFile->SetPath(wxT("/") + panelId);
+			cfg->SetPath(wxT("/") + panelId);
 		}
-		int nbrSetters = static_cast<int>(m_organFile->ReadLong("NumberOfSetterElements", 0));
+		int nbrSetters = static_cast<int>(cfg->ReadLong("NumberOfSetterElements", 0));
 		for (int i = 0; i < nbrSetters; i++) {
 			wxString setterGroupName = panelId + wxT("SetterElement") + GOODF_functions::number_format(i + 1);
-			m_organFile->SetPath(wxT("/"));
-			if (m_organFile->HasGroup(setterGroupName)) {
-				m_organFile->SetPath(wxT("/") + setterGroupName);
-				wxString elementType = m_organFile->Read("Type", wxEmptyString);
+			cfg->SetPath(wxT("/"));
+			if (cfg->HasGroup(setterGroupName)) {
+				cfg->SetPath(wxT("/") + setterGroupName);
+				wxString elementType = cfg->Read("Type", wxEmptyString);
 				if (elementType != wxEmptyString) {
-					createFromSetterElement(m_organ->getOrganPanelAt(0), elementType);
+					createFromSetterElement(cfg, organ, organ->getOrganPanelAt(0), elementType);
 				}
 			}
-			m_organFile->SetPath(wxT("/") + panelId);
+			cfg->SetPath(wxT("/") + panelId);
 		}
-		int nbrEnclosures = static_cast<int>(m_organFile->ReadLong("NumberOfEnclosures", 0));
+		int nbrEnclosures = static_cast<int>(cfg->ReadLong("NumberOfEnclosures", 0));
 		for (int i = 0; i < nbrEnclosures; i++) {
 			wxString encStr = wxT("Enclosure") + GOODF_functions::number_format(i + 1);
-			int encRefId = static_cast<int>(m_organFile->ReadLong(encStr, 0));
-			if (encRefId > 0 && encRefId <= (int)m_organ->getNumberOfEnclosures()) {
+			int encRefId = static_cast<int>(cfg->ReadLong(encStr, 0));
+			if (encRefId > 0 && encRefId <= (int)organ->getNumberOfEnclosures()) {
 				wxString thePath = panelId + wxT("Enclosure") + GOODF_functions::number_format(encRefId);
-				m_organFile->SetPath(wxT("/"));
-				if (m_organFile->HasGroup(thePath)) {
-					m_organFile->SetPath(wxT("/") + thePath);
-					createGUIEnclosure(targetPanel, m_organ->getOrganEnclosureAt(encRefId - 1));
+				cfg->SetPath(wxT("/"));
+				if (cfg->HasGroup(thePath)) {
+					cfg->SetPath(wxT("/") + thePath);
+					createGUIEnclosure(cfg, organ, targetPanel, organ->getOrganEnclosureAt(encRefId - 1));
 				}
 			}
-			m_organFile->SetPath(wxT("/") + panelId);
+			cfg->SetPath(wxT("/") + panelId);
 		}
-		int nbrTremulants = static_cast<int>(m_organFile->ReadLong("NumberOfTremulants", 0));
+		int nbrTremulants = static_cast<int>(cfg->ReadLong("NumberOfTremulants", 0));
 		for (int i = 0; i < nbrTremulants; i++) {
 			wxString tremStr = wxT("Tremulant") + GOODF_functions::number_format(i + 1);
-			int tremRefId = static_cast<int>(m_organFile->ReadLong(tremStr, 0));
-			if (tremRefId > 0 && tremRefId <= (int)m_organ->getNumberOfTremulants()) {
+			int tremRefId = static_cast<int>(cfg->ReadLong(tremStr, 0));
+			if (tremRefId > 0 && tremRefId <= (int)organ->getNumberOfTremulants()) {
 				wxString thePath = panelId + wxT("Tremulant") + GOODF_functions::number_format(tremRefId);
-				m_organFile->SetPath(wxT("/"));
-				if (m_organFile->HasGroup(thePath)) {
-					m_organFile->SetPath(wxT("/") + thePath);
-					createGUITremulant(targetPanel, m_organ->getOrganTremulantAt(tremRefId - 1));
+				cfg->SetPath(wxT("/"));
+				if (cfg->HasGroup(thePath)) {
+					cfg->SetPath(wxT("/") + thePath);
+					createGUITremulant(cfg, organ, targetPanel, organ->getOrganTremulantAt(tremRefId - 1));
 				}
 			}
-			m_organFile->SetPath(wxT("/") + panelId);
+			cfg->SetPath(wxT("/") + panelId);
 		}
-		int nbrPistons = static_cast<int>(m_organFile->ReadLong("NumberOfReversiblePistons", 0));
+		int nbrPistons = static_cast<int>(cfg->ReadLong("NumberOfReversiblePistons", 0));
 		for (int i = 0; i < nbrPistons; i++) {
 			wxString pistonStr = wxT("ReversiblePiston") + GOODF_functions::number_format(i + 1);
-			int pistonRefId = static_cast<int>(m_organFile->ReadLong(pistonStr, 0));
-			if (pistonRefId > 0 && pistonRefId <= (int)m_organ->getNumberOfReversiblePistons()) {
+			int pistonRefId = static_cast<int>(cfg->ReadLong(pistonStr, 0));
+			if (pistonRefId > 0 && pistonRefId <= (int)organ->getNumberOfReversiblePistons()) {
 				wxString thePath = panelId + wxT("ReversiblePiston") + GOODF_functions::number_format(pistonRefId);
-				m_organFile->SetPath(wxT("/"));
-				if (m_organFile->HasGroup(thePath)) {
-					m_organFile->SetPath(wxT("/") + thePath);
-					createGUIPiston(targetPanel, m_organ->getReversiblePistonAt(pistonRefId - 1));
+				cfg->SetPath(wxT("/"));
+				if (cfg->HasGroup(thePath)) {
+					cfg->SetPath(wxT("/") + thePath);
+					createGUIPiston(cfg, organ, targetPanel, organ->getReversiblePistonAt(pistonRefId - 1));
 				}
 			}
-			m_organFile->SetPath(wxT("/") + panelId);
+			cfg->SetPath(wxT("/") + panelId);
 		}
-		int nbrSwitches = static_cast<int>(m_organFile->ReadLong("NumberOfSwitches", 0));
+		int nbrSwitches = static_cast<int>(cfg->ReadLong("NumberOfSwitches", 0));
 		for (int i = 0; i < nbrSwitches; i++) {
 			wxString swStr = wxT("Switch") + GOODF_functions::number_format(i + 1);
-			int swRefId = static_cast<int>(m_organFile->ReadLong(swStr, 0));
-			if (swRefId > 0 && swRefId <= (int)m_organ->getNumberOfSwitches()) {
+			int swRefId = static_cast<int>(cfg->ReadLong(swStr, 0));
+			if (swRefId > 0 && swRefId <= (int)organ->getNumberOfSwitches()) {
 				wxString thePath = panelId + wxT("Switch") + GOODF_functions::number_format(swRefId);
-				m_organFile->SetPath(wxT("/"));
-				if (m_organFile->HasGroup(thePath)) {
-					m_organFile->SetPath(wxT("/") + thePath);
-					createGUISwitch(targetPanel, m_organ->getOrganSwitchAt(swRefId - 1));
+				cfg->SetPath(wxT("/"));
+				if (cfg->HasGroup(thePath)) {
+					cfg->SetPath(wxT("/") + thePath);
+					createGUISwitch(cfg, organ, targetPanel, organ->getOrganSwitchAt(swRefId - 1));
 				}
 			}
-			m_organFile->SetPath(wxT("/") + panelId);
+			cfg->SetPath(wxT("/") + panelId);
 		}
-		int nbrGenerals = static_cast<int>(m_organFile->ReadLong("NumberOfGenerals", 0));
+		int nbrGenerals = static_cast<int>(cfg->ReadLong("NumberOfGenerals", 0));
 		for (int i = 0; i < nbrGenerals; i++) {
 			wxString genStr = wxT("General") + GOODF_functions::number_format(i + 1);
-			int genRefId = static_cast<int>(m_organFile->ReadLong(genStr, 0));
-			if (genRefId > 0 && genRefId <= (int)m_organ->getNumberOfGenerals()) {
+			int genRefId = static_cast<int>(cfg->ReadLong(genStr, 0));
+			if (genRefId > 0 && genRefId <= (int)organ->getNumberOfGenerals()) {
 				wxString thePath = panelId + wxT("General") + GOODF_functions::number_format(genRefId);
-				m_organFile->SetPath(wxT("/"));
-				if (m_organFile->HasGroup(thePath)) {
-					m_organFile->SetPath(wxT("/") + thePath);
-					createGUIGeneral(targetPanel, m_organ->getOrganGeneralAt(genRefId - 1));
+				cfg->SetPath(wxT("/"));
+				if (cfg->HasGroup(thePath)) {
+					cfg->SetPath(wxT("/") + thePath);
+					createGUIGeneral(cfg, organ, targetPanel, organ->getOrganGeneralAt(genRefId - 1));
 				}
 			}
-			m_organFile->SetPath(wxT("/") + panelId);
+			cfg->SetPath(wxT("/") + panelId);
 		}
-		int nbrDivCplrs = static_cast<int>(m_organFile->ReadLong("NumberOfDivisionalCouplers", 0));
+		int nbrDivCplrs = static_cast<int>(cfg->ReadLong("NumberOfDivisionalCouplers", 0));
 		for (int i = 0; i < nbrDivCplrs; i++) {
 			wxString divCplrStr = wxT("DivisionalCoupler") + GOODF_functions::number_format(i + 1);
-			int divCplrRefId = static_cast<int>(m_organFile->ReadLong(divCplrStr, 0));
-			if (divCplrRefId > 0 && divCplrRefId <= (int)m_organ->getNumberOfOrganDivisionalCouplers()) {
+			int divCplrRefId = static_cast<int>(cfg->ReadLong(divCplrStr, 0));
+			if (divCplrRefId > 0 && divCplrRefId <= (int)organ->getNumberOfOrganDivisionalCouplers()) {
 				wxString thePath = panelId + wxT("DivisionalCoupler") + GOODF_functions::number_format(divCplrRefId);
-				m_organFile->SetPath(wxT("/"));
-				if (m_organFile->HasGroup(thePath)) {
-					m_organFile->SetPath(wxT("/") + thePath);
-					createGUIDivCplr(targetPanel, m_organ->getOrganDivisionalCouplerAt(divCplrRefId - 1));
+				cfg->SetPath(wxT("/"));
+				if (cfg->HasGroup(thePath)) {
+					cfg->SetPath(wxT("/") + thePath);
+					createGUIDivCplr(cfg, organ, targetPanel, organ->getOrganDivisionalCouplerAt(divCplrRefId - 1));
 				}
 			}
-			m_organFile->SetPath(wxT("/") + panelId);
+			cfg->SetPath(wxT("/") + panelId);
 		}
-		int nbrStops = static_cast<int>(m_organFile->ReadLong("NumberOfStops", 0));
+		int nbrStops = static_cast<int>(cfg->ReadLong("NumberOfStops", 0));
 		for (int i = 0; i < nbrStops; i++) {
 			wxString stopManStr = wxT("Stop") + GOODF_functions::number_format(i + 1) + wxT("Manual");
 			wxString stopStr = wxT("Stop") + GOODF_functions::number_format(i + 1);
-			int manRefId = static_cast<int>(m_organFile->ReadLong(stopManStr, -1));
-			if (manRefId >= 0 && manRefId <= (int)m_organ->getNumberOfManuals()) {
+			int manRefId = static_cast<int>(cfg->ReadLong(stopManStr, -1));
+			if (manRefId >= 0 && manRefId <= (int)organ->getNumberOfManuals()) {
 				int manIdx = manRefId;
-				if (!m_organ->doesHavePedals() && manIdx > 0)
+				if (!organ->doesHavePedals() && manIdx > 0)
 					manIdx -= 1;
-				Manual *man = m_organ->getOrganManualAt(manIdx);
-				int stopRefId = static_cast<int>(m_organFile->ReadLong(stopStr, 0));
+				Manual *man = organ->getOrganManualAt(manIdx);
+				int stopRefId = static_cast<int>(cfg->ReadLong(stopStr, 0));
 				if (stopRefId > 0 && stopRefId <= (int)man->getNumberOfStops()) {
 					wxString thePath = panelId + wxT("Stop") + GOODF_functions::number_format(i + 1);
-					m_organFile->SetPath(wxT("/"));
-					if (m_organFile->HasGroup(thePath)) {
-						m_organFile->SetPath(wxT("/") + thePath);
-						createGUIStop(targetPanel, man->getStopAt(stopRefId - 1));
+					cfg->SetPath(wxT("/"));
+					if (cfg->HasGroup(thePath)) {
+						cfg->SetPath(wxT("/") + thePath);
+						createGUIStop(cfg, organ, targetPanel, man->getStopAt(stopRefId - 1));
 					}
 				}
 			}
-			m_organFile->SetPath(wxT("/") + panelId);
+			cfg->SetPath(wxT("/") + panelId);
 		}
-		int nbrCplrs = static_cast<int>(m_organFile->ReadLong("NumberOfCouplers", 0));
+		int nbrCplrs = static_cast<int>(cfg->ReadLong("NumberOfCouplers", 0));
 		for (int i = 0; i < nbrCplrs; i++) {
 			wxString couplerManStr = wxT("Coupler") + GOODF_functions::number_format(i + 1) + wxT("Manual");
 			wxString couplerStr = wxT("Coupler") + GOODF_functions::number_format(i + 1);
-			int manRefId = static_cast<int>(m_organFile->ReadLong(couplerManStr, -1));
-			if (manRefId >= 0 && manRefId <= (int)m_organ->getNumberOfManuals()) {
+			int manRefId = static_cast<int>(cfg->ReadLong(couplerManStr, -1));
+			if (manRefId >= 0 && manRefId <= (int)organ->getNumberOfManuals()) {
 				int manIdx = manRefId;
-				if (!m_organ->doesHavePedals() && manIdx > 0)
+				if (!organ->doesHavePedals() && manIdx > 0)
 					manIdx -= 1;
-				Manual *man = m_organ->getOrganManualAt(manIdx);
-				int couplerRefId = static_cast<int>(m_organFile->ReadLong(couplerStr, 0));
+				Manual *man = organ->getOrganManualAt(manIdx);
+				int couplerRefId = static_cast<int>(cfg->ReadLong(couplerStr, 0));
 				if (couplerRefId > 0 && couplerRefId <= (int)man->getNumberOfCouplers()) {
 					wxString thePath = panelId + wxT("Coupler") + GOODF_functions::number_format(i + 1);
-					m_organFile->SetPath(wxT("/"));
-					if (m_organFile->HasGroup(thePath)) {
-						m_organFile->SetPath(wxT("/") + thePath);
-						createGUICoupler(targetPanel, man->getCouplerAt(couplerRefId - 1));
+					cfg->SetPath(wxT("/"));
+					if (cfg->HasGroup(thePath)) {
+						cfg->SetPath(wxT("/") + thePath);
+						createGUICoupler(cfg, organ, targetPanel, man->getCouplerAt(couplerRefId - 1));
 					}
 				}
 			}
-			m_organFile->SetPath(wxT("/") + panelId);
+			cfg->SetPath(wxT("/") + panelId);
 		}
-		int nbrDivisionals = static_cast<int>(m_organFile->ReadLong("NumberOfDivisionals", 0));
+		int nbrDivisionals = static_cast<int>(cfg->ReadLong("NumberOfDivisionals", 0));
 		for (int i = 0; i < nbrDivisionals; i++) {
 			wxString divManStr = wxT("Divisional") + GOODF_functions::number_format(i + 1) + wxT("Manual");
 			wxString divStr = wxT("Divisional") + GOODF_functions::number_format(i + 1);
-			int manRefId = static_cast<int>(m_organFile->ReadLong(divManStr, -1));
-			if (manRefId >= 0 && manRefId <= (int)m_organ->getNumberOfManuals()) {
+			int manRefId = static_cast<int>(cfg->ReadLong(divManStr, -1));
+			if (manRefId >= 0 && manRefId <= (int)organ->getNumberOfManuals()) {
 				int manIdx = manRefId;
-				if (!m_organ->doesHavePedals() && manIdx > 0)
+				if (!organ->doesHavePedals() && manIdx > 0)
 					manIdx -= 1;
-				Manual *man = m_organ->getOrganManualAt(manIdx);
-				int divRefId = static_cast<int>(m_organFile->ReadLong(divStr, 0));
+				Manual *man = organ->getOrganManualAt(manIdx);
+				int divRefId = static_cast<int>(cfg->ReadLong(divStr, 0));
 				if (divRefId > 0 && divRefId <= (int)man->getNumberOfDivisionals()) {
 					wxString thePath = panelId + wxT("Divisional") + GOODF_functions::number_format(i + 1);
-					m_organFile->SetPath(wxT("/"));
-					if (m_organFile->HasGroup(thePath)) {
-						m_organFile->SetPath(wxT("/") + thePath);
-						createGUIDivisional(targetPanel, man->getDivisionalAt(divRefId - 1));
+					cfg->SetPath(wxT("/"));
+					if (cfg->HasGroup(thePath)) {
+						cfg->SetPath(wxT("/") + thePath);
+						createGUIDivisional(cfg, organ, targetPanel, man->getDivisionalAt(divRefId - 1));
 					}
 				}
 			}
-			m_organFile->SetPath(wxT("/") + panelId);
+			cfg->SetPath(wxT("/") + panelId);
 		}
-		int nbrLabels = static_cast<int>(m_organFile->ReadLong("NumberOfLabels", 0));
+		int nbrLabels = static_cast<int>(cfg->ReadLong("NumberOfLabels", 0));
 		for (int i = 0; i < nbrLabels; i++) {
 			wxString thePath = panelId + wxT("Label") + GOODF_functions::number_format(i + 1);
-			m_organFile->SetPath(wxT("/"));
-			if (m_organFile->HasGroup(thePath)) {
-				m_organFile->SetPath(wxT("/") + thePath);
-				createGUILabel(targetPanel);
+			cfg->SetPath(wxT("/"));
+			if (cfg->HasGroup(thePath)) {
+				cfg->SetPath(wxT("/") + thePath);
+				createGUILabel(cfg, organ, targetPanel);
 			}
-			m_organFile->SetPath(wxT("/") + panelId);
+			cfg->SetPath(wxT("/") + panelId);
 		}
 	}
 }
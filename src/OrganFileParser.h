@@ -25,13 +25,28 @@
 #include <wx/fileconf.h>
 #include <wx/progdlg.h>
 #include "Organ.h"
+#include "FileExistenceCache.h"
+#include <atomic>
+#include <map>
 
 class OrganFileParser {
 public:
-	OrganFileParser(wxString filePath, Organ *organ);
+	// Unless parseNow is false the whole file is parsed at once behind a
+	// progress dialog. Otherwise parseStructure() can be called from a worker
+	// thread, with the GUI elements queued in the organ context to be created
+	// on the main thread and the rank pipes left to be loaded on demand,
+	// before finishParsing() is called.
+	OrganFileParser(wxString filePath, Organ *organ, bool parseNow = true);
 	~OrganFileParser();
 
 	bool isOrganReady();
+	wxString getErrorMessage();
+
+	bool parseStructure();
+	void finishParsing();
+	void cancel();
+	bool isCancelled();
+	int getProgress(wxString &message);
 
 private:
 
@@ -41,8 +56,15 @@ private:
 	bool m_fileIsOk;
 	bool m_organIsReady;
 	bool m_isUsingOldPanelFormat;
+	bool m_isParsingInSteps;
+	std::atomic<bool> m_isCancelled;
 	wxString m_errorMessage;
 	wxProgressDialog *m_progressDlg;
+	wxCriticalSection m_progressLock;
+	int m_progressValue;
+	wxString m_progressMessage;
+	FileExistenceCache m_fileExistenceCache;
+	std::map<wxString, wxArrayString> m_pipeEntryOrder;
 
 	int m_enclosuresToParse;
 	int m_tremulantsToParse;
@@ -62,24 +84,26 @@ private:
 
 	void readIniFile();
 	void trimKeyValues();
-	void parseOrgan();
+	void readPipeEntryOrder();
+	void addReferencedDirectory(const wxString &value, const wxString &odfRoot);
+	bool updateProgress(int value, const wxString &message);
 
 	void parseOrganSection();
 
-	void createGUIEnclosure(GoPanel *targetPanel, Enclosure *enclosure);
-	void createGUITremulant(GoPanel *targetPanel, Tremulant *tremulant);
-	void createGUISwitch(GoPanel *targetPanel, GoSwitch *theSwitch);
-	void createGUILabel(GoPanel *targetPanel);
-	void createGUIManual(GoPanel *targetPanel, Manual *manual);
-	void createGUIPiston(GoPanel *targetPanel, ReversiblePiston *piston);
-	void createGUIDivCplr(GoPanel *targetPanel, DivisionalCoupler *div_cplr);
-	void createGUIGeneral(GoPanel *targetPanel, General *general);
-	void createGUIDivisional(GoPanel *targetPanel, Divisional *divisional);
-	void createFromSetterElement(GoPanel *targetPanel, wxString elementType);
-	void createGUICoupler(GoPanel *targetPanel, Coupler *coupler);
-	void createGUIStop(GoPanel *targetPanel, Stop *stop);
+	static void createGUIEnclosure(wxFileConfig *cfg, Organ *organ, GoPanel *targetPanel, Enclosure *enclosure);
+	static void createGUITremulant(wxFileConfig *cfg, Organ *organ, GoPanel *targetPanel, Tremulant *tremulant);
+	static void createGUISwitch(wxFileConfig *cfg, Organ *organ, GoPanel *targetPanel, GoSwitch *theSwitch);
+	static void createGUILabel(wxFileConfig *cfg, Organ *organ, GoPanel *targetPanel);
+	static void createGUIManual(wxFileConfig *cfg, Organ *organ, GoPanel *targetPanel, Manual *manual);
+	static void createGUIPiston(wxFileConfig *cfg, Organ *organ, GoPanel *targetPanel, ReversiblePiston *piston);
+	static void createGUIDivCplr(wxFileConfig *cfg, Organ *organ, GoPanel *targetPanel, DivisionalCoupler *div_cplr);
+	static void createGUIGeneral(wxFileConfig *cfg, Organ *organ, GoPanel *targetPanel, General *general);
+	static void createGUIDivisional(wxFileConfig *cfg, Organ *organ, GoPanel *targetPanel, Divisional *divisional);
+	static void createFromSetterElement(wxFileConfig *cfg, Organ *organ, GoPanel *targetPanel, wxString elementType);
+	static void createGUICoupler(wxFileConfig *cfg, Organ *organ, GoPanel *targetPanel, Coupler *coupler);
+	static void createGUIStop(wxFileConfig *cfg, Organ *organ, GoPanel *targetPanel, Stop *stop);
 
-	void parsePanelElements(GoPanel *targetPanel, wxString panelId);
+	static void parsePanelElements(wxFileConfig *cfg, Organ *organ, GoPanel *targetPanel, wxString panelId);
 
 };
 
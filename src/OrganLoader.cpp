@@ -0,0 +1,148 @@
+/*
+ * OrganLoader.cpp is part of GoOdf.
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * GoOdf is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GoOdf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GoOdf.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#include "OrganLoader.h"
+
+// Parses the structure of the organ on a worker thread
+class StructureParsingThread : public wxThread {
+public:
+	StructureParsingThread(OrganLoader *loader) : wxThread(wxTHREAD_JOINABLE) {
+		m_loader = loader;
+	}
+
+protected:
+	virtual ExitCode Entry() {
+		m_loader->parseStructure();
+		return (ExitCode) 0;
+	}
+
+private:
+	OrganLoader *m_loader;
+};
+
+OrganLoader::OrganLoader(wxString filePath, Organ *organ, wxEvtHandler *handler, int eventId) {
+	m_filePath = filePath.Clone();
+	m_organ = organ;
+	m_ownsOrgan = true;
+	m_parser = new OrganFileParser(m_filePath, m_organ, false);
+	m_thread = NULL;
+	m_handler = handler;
+	m_eventId = eventId;
+	m_isStructureParsed = false;
+	// with pipes loaded on demand they're left for when a rank is first used
+	m_isLoadingPipes = !m_organ->getContext()->isLoadingPipesOnDemand();
+	m_nextRank = 0;
+}
+
+OrganLoader::~OrganLoader() {
+	if (m_thread) {
+		m_parser->cancel();
+		m_thread->Wait();
+		delete m_thread;
+	}
+	// the parser must go first as it still refers to the organ
+	delete m_parser;
+	if (m_ownsOrgan)
+		delete m_organ;
+}
+
+void OrganLoader::start() {
+	m_thread = new StructureParsingThread(this);
+	if (m_thread->Run() != wxTHREAD_NO_ERROR) {
+		// parse here instead, the result is announced in the same way
+		delete m_thread;
+		m_thread = NULL;
+		parseStructure();
+	}
+}
+
+bool OrganLoader::hasParsedStructure() {
+	if (m_thread) {
+		m_thread->Wait();
+		delete m_thread;
+		m_thread = NULL;
+	}
+	return m_isStructureParsed;
+}
+
+bool OrganLoader::loadNextPart() {
+	OrganContext *context = m_organ->getContext();
+	if (context->hasPendingGuiTasks()) {
+		context->runNextGuiTask();
+		return true;
+	}
+	if (m_isLoadingPipes) {
+		while (m_nextRank < m_organ->getNumberOfRanks()) {
+			Rank *rank = m_organ->getOrganRankAt(m_nextRank);
+			m_nextRank++;
+			// ranks already used have loaded their pipes themselves
+			if (rank->hasDeferredPipes()) {
+				rank->loadPipes();
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
+void OrganLoader::finish() {
+	m_parser->finishParsing();
+}
+
+void OrganLoader::cancel() {
+	m_parser->cancel();
+}
+
+wxString OrganLoader::getFilePath() {
+	return m_filePath;
+}
+
+Organ* OrganLoader::getOrgan() {
+	return m_organ;
+}
+
+void OrganLoader::releaseOrgan() {
+	m_ownsOrgan = false;
+}
+
+int OrganLoader::getParsingProgress(wxString &message) {
+	return m_parser->getProgress(message);
+}
+
+int OrganLoader::getLoadingProgress(wxString &message) {
+	OrganContext *context = m_organ->getContext();
+	unsigned nbrRanks = m_isLoadingPipes ? m_organ->getNumberOfRanks() : 0;
+	unsigned total = context->getNumberOfGuiTasks() + nbrRanks;
+	unsigned done = context->getNumberOfFinishedGuiTasks() + (m_nextRank < nbrRanks ? m_nextRank : nbrRanks);
+	if (context->hasPendingGuiTasks())
+		message = wxT("Creating panels and GUI elements");
+	else
+		message = wxT("Loading pipes of the ranks");
+	if (total == 0)
+		return 100;
+	return static_cast<int>(done * 100 / total);
+}
+
+void OrganLoader::parseStructure() {
+	m_isStructureParsed = m_parser->parseStructure();
+	wxThreadEvent *event = new wxThreadEvent(wxEVT_THREAD, m_eventId);
+	event->SetPayload(this);
+	wxQueueEvent(m_handler, event);
+}
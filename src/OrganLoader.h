@@ -0,0 +1,72 @@
+/*
+ * OrganLoader.h is part of GoOdf.
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * GoOdf is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GoOdf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GoOdf.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#ifndef ORGANLOADER_H
+#define ORGANLOADER_H
+
+#include <wx/wx.h>
+#include <wx/thread.h>
+#include <atomic>
+#include "Organ.h"
+#include "OrganFileParser.h"
+
+// Opens an .organ file without blocking the user interface. The structure
+// is parsed on a worker thread, after which a wxThreadEvent with the loader
+// as payload is queued to the event handler. The organ can then be shown
+// while the GUI elements and the rank pipes are loaded a part at a time on
+// the main thread with loadNextPart().
+class OrganLoader {
+public:
+	OrganLoader(wxString filePath, Organ *organ, wxEvtHandler *handler, int eventId);
+	~OrganLoader();
+
+	void start();
+	bool hasParsedStructure();
+	bool loadNextPart();
+	void finish();
+	void cancel();
+
+	wxString getFilePath();
+	Organ* getOrgan();
+	void releaseOrgan();
+	int getParsingProgress(wxString &message);
+	int getLoadingProgress(wxString &message);
+
+private:
+	wxString m_filePath;
+	Organ *m_organ;
+	bool m_ownsOrgan;
+	OrganFileParser *m_parser;
+	wxThread *m_thread;
+	wxEvtHandler *m_handler;
+	int m_eventId;
+	std::atomic<bool> m_isStructureParsed;
+	bool m_isLoadingPipes;
+	unsigned m_nextRank;
+
+	void parseStructure();
+
+	friend class StructureParsingThread;
+
+	OrganLoader(const OrganLoader&) = delete;
+	OrganLoader& operator=(const OrganLoader&) = delete;
+};
+
+#endif
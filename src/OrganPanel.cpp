@@ -664,7 +664,7 @@ void OrganPanel::getDataFromOrgan() {
 	m_organBuildDateField->ChangeValue(m_currentOrgan->getOrganBuildDate());
 	m_organCommentsField->ChangeValue(m_currentOrgan->getOrganComments());
 	m_recordingDetailsField->ChangeValue(m_currentOrgan->getRecordingDetails());
-	m_infoPathField->ChangeValue(GOODF_functions::removeBaseOdfPath(m_currentOrgan->getInfoFilename()));
+	m_infoPathField->ChangeValue(GOODF_functions::removeBaseOdfPath(m_currentOrgan->getInfoFilename(), *m_currentOrgan->getContext()));
 	if (m_currentOrgan->doesDivisionalsStoreIntermanualCouplers())
 		m_interManualYes->SetValue(true);
 	else
@@ -712,7 +712,7 @@ void OrganPanel::OnBrowseForOrganPath(wxCommandEvent& WXUNUSED(event)) {
 	m_currentOrgan->setOdfRoot(m_odfPath);
 	m_currentOrgan->updateRelativePipePaths();
 	if (!m_infoPathField->IsEmpty()) {
-		m_infoPathField->SetValue(GOODF_functions::removeBaseOdfPath(m_currentOrgan->getInfoFilename()));
+		m_infoPathField->SetValue(GOODF_functions::removeBaseOdfPath(m_currentOrgan->getInfoFilename(), *m_currentOrgan->getContext()));
 	}
 	if (!m_odfPath.IsSameAs(oldOdfPath))
 		::wxGetApp().m_frame->m_organ->setModified(true);
@@ -826,7 +826,7 @@ void OrganPanel::OnBrowseForInfoPath(wxCommandEvent& WXUNUSED(event)) {
 
 	infoFilePath = fileDialog.GetPath();
 	m_currentOrgan->setInfoFilename(infoFilePath);
-	m_infoPathField->SetValue(GOODF_functions::removeBaseOdfPath(infoFilePath));
+	m_infoPathField->SetValue(GOODF_functions::removeBaseOdfPath(infoFilePath, *m_currentOrgan->getContext()));
 	::wxGetApp().m_frame->m_organ->setModified(true);
 
 }
@@ -930,8 +930,8 @@ void OrganPanel::OnPercussiveSelection(wxCommandEvent& event) {
 				for (unsigned i = 0; i < m_currentOrgan->getNumberOfWindchestgroups(); i++) {
 					Windchestgroup *w = m_currentOrgan->getOrganWindchestgroupAt(i);
 					w->setIsPercussive(true);
-					if (w->isPipesOnThisWindchest())
-						w->applyPercussiveRecursively();
+					if (w->isPipesOnThisWindchest(*m_currentOrgan->getContext()))
+						w->applyPercussiveRecursively(*m_currentOrgan->getContext());
 				}
 			}
 		}
@@ -951,8 +951,8 @@ void OrganPanel::OnPercussiveSelection(wxCommandEvent& event) {
 				for (unsigned i = 0; i < m_currentOrgan->getNumberOfWindchestgroups(); i++) {
 					Windchestgroup *w = m_currentOrgan->getOrganWindchestgroupAt(i);
 					w->setIsPercussive(true);
-					if (w->isPipesOnThisWindchest())
-						w->applyPercussiveRecursively();
+					if (w->isPipesOnThisWindchest(*m_currentOrgan->getContext()))
+						w->applyPercussiveRecursively(*m_currentOrgan->getContext());
 				}
 			}
 		}
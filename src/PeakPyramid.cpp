@@ -0,0 +1,141 @@
+/*
+ * PeakPyramid.cpp is part of GoOdf.
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * GoOdf is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GoOdf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GoOdf.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#include "PeakPyramid.h"
+#include "SampleReader.h"
+#include <algorithm>
+#include <cmath>
+
+// frames read from the file at a time
+static const unsigned READ_BLOCKS = 1024;
+
+PeakPyramid::PeakPyramid() {
+	m_numberOfChannels = 0;
+	m_numberOfFrames = 0;
+	m_sampleRate = 0;
+}
+
+PeakPyramid::~PeakPyramid() {
+
+}
+
+bool PeakPyramid::build(SampleReader &reader) {
+	m_levels.clear();
+	m_numberOfChannels = reader.getNumberOfChannels();
+	m_numberOfFrames = reader.getNumberOfFrames();
+	m_sampleRate = reader.getSampleRate();
+	if (!m_numberOfChannels || !reader.seek(0))
+		return false;
+
+	std::vector<PEAK> base;
+	base.reserve((size_t) (m_numberOfFrames / BASE_BLOCK_FRAMES + 1) * m_numberOfChannels);
+	std::vector<float> buffer((size_t) READ_BLOCKS * BASE_BLOCK_FRAMES * m_numberOfChannels);
+	unsigned framesRead;
+	while ((framesRead = reader.read(buffer.data(), READ_BLOCKS * BASE_BLOCK_FRAMES)) > 0) {
+		for (unsigned first = 0; first < framesRead; first += BASE_BLOCK_FRAMES) {
+			unsigned last = std::min(framesRead, first + BASE_BLOCK_FRAMES);
+			for (unsigned c = 0; c < m_numberOfChannels; c++) {
+				PEAK peak = { buffer[(size_t) first * m_numberOfChannels + c], buffer[(size_t) first * m_numberOfChannels + c] };
+				for (unsigned f = first + 1; f < last; f++) {
+					float value = buffer[(size_t) f * m_numberOfChannels + c];
+					peak.min = std::min(peak.min, value);
+					peak.max = std::max(peak.max, value);
+				}
+				base.push_back(peak);
+			}
+		}
+	}
+	if (base.empty())
+		return false;
+	m_levels.push_back(base);
+
+	// every coarser level combines LEVEL_FACTOR blocks of the one before
+	while (m_levels.back().size() > m_numberOfChannels) {
+		const std::vector<PEAK> &finer = m_levels.back();
+		size_t finerBlocks = finer.size() / m_numberOfChannels;
+		std::vector<PEAK> coarser;
+		coarser.reserve(((finerBlocks + LEVEL_FACTOR - 1) / LEVEL_FACTOR) * m_numberOfChannels);
+		for (size_t block = 0; block < finerBlocks; block += LEVEL_FACTOR) {
+			size_t lastBlock = std::min(finerBlocks, block + LEVEL_FACTOR);
+			for (unsigned c = 0; c < m_numberOfChannels; c++) {
+				PEAK peak = finer[block * m_numberOfChannels + c];
+				for (size_t b = block + 1; b < lastBlock; b++) {
+					peak.min = std::min(peak.min, finer[b * m_numberOfChannels + c].min);
+					peak.max = std::max(peak.max, finer[b * m_numberOfChannels + c].max);
+				}
+				coarser.push_back(peak);
+			}
+		}
+		m_levels.push_back(coarser);
+	}
+	return true;
+}
+
+unsigned PeakPyramid::getNumberOfChannels() const {
+	return m_numberOfChannels;
+}
+
+unsigned PeakPyramid::getNumberOfFrames() const {
+	return m_numberOfFrames;
+}
+
+unsigned PeakPyramid::getSampleRate() const {
+	return m_sampleRate;
+}
+
+size_t PeakPyramid::getMemoryUse() const {
+	size_t bytes = sizeof(PeakPyramid);
+	for (const std::vector<PEAK> &level : m_levels)
+		bytes += level.capacity() * sizeof(PEAK);
+	return bytes;
+}
+
+void PeakPyramid::getPeaks(unsigned channel, double firstFrame, double framesPerColumn, unsigned columns, std::vector<PEAK> &peaks) const {
+	peaks.assign(columns, PEAK { 0, 0 });
+	if (m_levels.empty() || channel >= m_numberOfChannels || framesPerColumn <= 0)
+		return;
+
+	// the coarsest level whose blocks still fit in a column
+	unsigned level = 0;
+	double blockFrames = BASE_BLOCK_FRAMES;
+	while (level + 1 < m_levels.size() && blockFrames * LEVEL_FACTOR <= framesPerColumn) {
+		level++;
+		blockFrames *= LEVEL_FACTOR;
+	}
+	const std::vector<PEAK> &peaksOfLevel = m_levels[level];
+	size_t numberOfBlocks = peaksOfLevel.size() / m_numberOfChannels;
+
+	for (unsigned column = 0; column < columns; column++) {
+		double start = firstFrame + column * framesPerColumn;
+		double end = start + framesPerColumn;
+		if (end <= 0 || start >= m_numberOfFrames)
+			continue;
+		size_t firstBlock = (size_t) std::max(0.0, std::floor(start / blockFrames));
+		size_t lastBlock = std::min(numberOfBlocks, (size_t) std::ceil(end / blockFrames));
+		if (firstBlock >= lastBlock)
+			continue;
+		PEAK peak = peaksOfLevel[firstBlock * m_numberOfChannels + channel];
+		for (size_t b = firstBlock + 1; b < lastBlock; b++) {
+			peak.min = std::min(peak.min, peaksOfLevel[b * m_numberOfChannels + channel].min);
+			peak.max = std::max(peak.max, peaksOfLevel[b * m_numberOfChannels + channel].max);
+		}
+		peaks[column] = peak;
+	}
+}
@@ -0,0 +1,67 @@
+/*
+ * PeakPyramid.h is part of GoOdf.
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * GoOdf is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GoOdf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GoOdf.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#ifndef PEAKPYRAMID_H
+#define PEAKPYRAMID_H
+
+#include <cstddef>
+#include <vector>
+
+class SampleReader;
+
+// The minimum and maximum of every channel of a sample, for blocks of
+// BASE_BLOCK_FRAMES frames and then for LEVEL_FACTOR times larger blocks
+// in each coarser level, built in one pass over the audio. A waveform can
+// then be drawn at any zoom down to a block from a few values per pixel.
+class PeakPyramid {
+public:
+	struct PEAK {
+		float min;
+		float max;
+	};
+
+	static const unsigned BASE_BLOCK_FRAMES = 64;
+	static const unsigned LEVEL_FACTOR = 4;
+
+	PeakPyramid();
+	~PeakPyramid();
+
+	bool build(SampleReader &reader);
+
+	unsigned getNumberOfChannels() const;
+	unsigned getNumberOfFrames() const;
+	unsigned getSampleRate() const;
+	size_t getMemoryUse() const;
+
+	// One peak per column of framesPerColumn frames from firstFrame, which
+	// should not be less than BASE_BLOCK_FRAMES. Columns outside of the
+	// sample get an empty (0, 0) peak.
+	void getPeaks(unsigned channel, double firstFrame, double framesPerColumn, unsigned columns, std::vector<PEAK> &peaks) const;
+
+private:
+	unsigned m_numberOfChannels;
+	unsigned m_numberOfFrames;
+	unsigned m_sampleRate;
+	// the peaks of the channels are interleaved like the frames
+	std::vector<std::vector<PEAK>> m_levels;
+
+};
+
+#endif
@@ -67,10 +67,10 @@ Pipe::~Pipe() {
 
 }
 
-void Pipe::write(wxTextFile *outFile, wxString pipeNr, Rank *parent) {
+void Pipe::write(wxTextFile *outFile, const wxString &pipeNr, Rank *parent) {
 	if (!isFirstAttackRefPath()) {
 		// remove organ base path from output line path
-		wxString relativeFileName = GOODF_functions::removeBaseOdfPath(m_attacks.front().fullPath);
+		wxString relativeFileName = GOODF_functions::removeBaseOdfPath(m_attacks.front().fullPath, *OrganContext::current());
 		wxString fullLine = GOODF_functions::fixSeparator(pipeNr + wxT("=") + relativeFileName);
 		outFile->AddLine(fullLine);
 
@@ -87,13 +87,13 @@ void Pipe::write(wxTextFile *outFile, wxString pipeNr, Rank *parent) {
 				outFile->AddLine(pipeNr + wxT("Percussive=N"));
 		}
 		if (amplitudeLevel != 100)
-			outFile->AddLine(pipeNr + wxT("AmplitudeLevel=") + wxString::Format(wxT("%f"), amplitudeLevel));
+			GOODF_functions::addKeyLine(outFile, pipeNr, wxT("AmplitudeLevel="), amplitudeLevel);
 		if (gain != 0)
-			outFile->AddLine(pipeNr + wxT("Gain=") + wxString::Format(wxT("%f"), gain));
+			GOODF_functions::addKeyLine(outFile, pipeNr, wxT("Gain="), gain);
 		if (pitchTuning != 0)
-			outFile->AddLine(pipeNr + wxT("PitchTuning=") + wxString::Format(wxT("%f"), pitchTuning));
+			GOODF_functions::addKeyLine(outFile, pipeNr, wxT("PitchTuning="), pitchTuning);
 		if (trackerDelay != 0)
-			outFile->AddLine(pipeNr + wxT("TrackerDelay=") + wxString::Format(wxT("%i"), trackerDelay));
+			GOODF_functions::addKeyLine(outFile, pipeNr, wxT("TrackerDelay="), trackerDelay);
 
 		writeLoadRelease(outFile, pipeNr, m_attacks.front());
 		writeAttackVelocity(outFile, pipeNr, m_attacks.front());
@@ -111,13 +111,13 @@ void Pipe::write(wxTextFile *outFile, wxString pipeNr, Rank *parent) {
 		writeReleaseXfade(outFile, pipeNr, m_attacks.front());
 
 		if ((harmonicNumber != 8 && harmonicNumber != parent->getHarmonicNumber()) || (harmonicNumber == 8 && harmonicNumber != parent->getHarmonicNumber()))
-			outFile->AddLine(pipeNr + wxT("HarmonicNumber=") + wxString::Format(wxT("%i"), harmonicNumber));
+			GOODF_functions::addKeyLine(outFile, pipeNr, wxT("HarmonicNumber="), harmonicNumber);
 		if (midiKeyNumber > -1)
-			outFile->AddLine(pipeNr + wxT("MIDIKeyNumber=") + wxString::Format(wxT("%i"), midiKeyNumber));
+			GOODF_functions::addKeyLine(outFile, pipeNr, wxT("MIDIKeyNumber="), midiKeyNumber);
 		if (midiPitchFraction > -0.1f)
-			outFile->AddLine(pipeNr + wxT("MIDIPitchFraction=") + wxString::Format(wxT("%f"), midiPitchFraction));
+			GOODF_functions::addKeyLine(outFile, pipeNr, wxT("MIDIPitchFraction="), midiPitchFraction);
 		if (pitchCorrection != 0 && pitchCorrection != parent->getPitchCorrection())
-			outFile->AddLine(pipeNr + wxT("PitchCorrection=") + wxString::Format(wxT("%f"), pitchCorrection));
+			GOODF_functions::addKeyLine(outFile, pipeNr, wxT("PitchCorrection="), pitchCorrection);
 		if (acceptsRetuning != parent->doesAcceptsRetuning()) {
 			if (acceptsRetuning)
 				outFile->AddLine(pipeNr + wxT("AcceptsRetuning=Y"));
@@ -125,7 +125,7 @@ void Pipe::write(wxTextFile *outFile, wxString pipeNr, Rank *parent) {
 				outFile->AddLine(pipeNr + wxT("AcceptsRetuning=N"));
 		}
 		if (windchest != parent->getWindchest()) {
-			wxString wcRef = wxString::Format(wxT("%u"), ::wxGetApp().m_frame->m_organ->getIndexOfOrganWindchest(windchest));
+			wxString wcRef = wxString::Format(wxT("%u"), OrganContext::current()->getOrgan()->getIndexOfOrganWindchest(windchest));
 			outFile->AddLine(pipeNr + wxT("WindchestGroup=") + wcRef);
 		}
 
@@ -218,7 +218,7 @@ void Pipe::read(wxFileConfig *cfg, wxString pipeNr, Rank *parent, Organ *readOrg
 				int relEnd = static_cast<int>(cfg->ReadLong(relStr + wxT("ReleaseEnd"), -1));
 				int relXfade = static_cast<int>(cfg->ReadLong(relStr + wxT("ReleaseCrossfadeLength"), 0));
 				Release r;
-				r.fileName = GOODF_functions::removeBaseOdfPath(fullRelPath);
+				r.fileName = GOODF_functions::removeBaseOdfPath(fullRelPath, *readOrgan->getContext());
 				r.fullPath = fullRelPath;
 				if (isTrem > -2 && isTrem < 2)
 					r.isTremulant = isTrem;
@@ -236,10 +236,9 @@ void Pipe::read(wxFileConfig *cfg, wxString pipeNr, Rank *parent, Organ *readOrg
 		}
 	} else if (nbrExtraRel > 0 && isPercussive) {
 		if (nbrExtraRel > 1)
-			wxLogWarning("Separate releases found in %s %s that is percussive! Ignoring them.", parent->getName(), pipeNr);
+			readOrgan->getContext()->logWarning(wxString::Format("Separate releases found in %s %s that is percussive! Ignoring them.", parent->getName(), pipeNr));
 		else
-			wxLogWarning("Separate release found in %s %s that is percussive! Ignoring it.", parent->getName(), pipeNr);
-		::wxGetApp().m_frame->GetLogWindow()->Show(true);
+			readOrgan->getContext()->logWarning(wxString::Format("Separate release found in %s %s that is percussive! Ignoring it.", parent->getName(), pipeNr));
 	}
 
 	// finally a sanity check to see that there is at least one valid attack in the pipe
@@ -248,8 +247,7 @@ void Pipe::read(wxFileConfig *cfg, wxString pipeNr, Rank *parent, Organ *readOrg
 		a.fileName = wxT("DUMMY");
 		a.fullPath = wxT("DUMMY");
 		m_attacks.push_back(a);
-		wxLogWarning("No valid pipe could be added for %s %s! Setting it to DUMMY.", parent->getName(), pipeNr);
-		::wxGetApp().m_frame->GetLogWindow()->Show(true);
+		readOrgan->getContext()->logWarning(wxString::Format("No valid pipe could be added for %s %s! Setting it to DUMMY.", parent->getName(), pipeNr));
 	} else {
 		// update the pipes root path of parent rank from the main attack
 		wxFileName fileName = m_attacks.front().fullPath;
@@ -278,7 +276,7 @@ void Pipe::readAttack(wxFileConfig *cfg, wxString pipeStr, Organ *readOrgan) {
 			if (loops > 100)
 				loops = 100;
 			Attack a;
-			a.fileName = GOODF_functions::removeBaseOdfPath(fullAtkPath);
+			a.fileName = GOODF_functions::removeBaseOdfPath(fullAtkPath, *readOrgan->getContext());
 			a.fullPath = fullAtkPath;
 			a.loadRelease = GOODF_functions::parseBoolean(loadReleaseStr, !isPercussive);
 			if (atkVel > -1 && atkVel < 128)
@@ -336,11 +334,11 @@ bool Pipe::isFirstAttackRefPath() {
 	return m_attacks.front().fileName.StartsWith(wxT("REF"));
 }
 
-void Pipe::writeAdditionalAttacks(wxTextFile *outFile, wxString pipeNr) {
+void Pipe::writeAdditionalAttacks(wxTextFile *outFile, const wxString &pipeNr) {
 	// Deal with possible additional attacks
 	if (m_attacks.size() > 1) {
 		unsigned extraAttacks = m_attacks.size() - 1;
-		outFile->AddLine(pipeNr + wxT("AttackCount=") + wxString::Format(wxT("%u"), extraAttacks));
+		GOODF_functions::addKeyLine(outFile, pipeNr, wxT("AttackCount="), extraAttacks);
 		unsigned k = 0;
 		bool firstAtk = true;
 		for (Attack &atk : m_attacks) {
@@ -350,7 +348,7 @@ void Pipe::writeAdditionalAttacks(wxTextFile *outFile, wxString pipeNr) {
 			}
 			k++;
 			wxString attackName = pipeNr + wxT("Attack") + GOODF_functions::number_format(k);
-			wxString fullLine = GOODF_functions::fixSeparator(attackName + wxT("=") + GOODF_functions::removeBaseOdfPath(atk.fileName));
+			wxString fullLine = GOODF_functions::fixSeparator(attackName + wxT("=") + GOODF_functions::removeBaseOdfPath(atk.fileName, *OrganContext::current()));
 			outFile->AddLine(fullLine);
 
 			writeLoadRelease(outFile, attackName, atk);
@@ -368,43 +366,43 @@ void Pipe::writeAdditionalAttacks(wxTextFile *outFile, wxString pipeNr) {
 	}
 }
 
-void Pipe::writeAdditionalReleases(wxTextFile *outFile, wxString pipeNr) {
+void Pipe::writeAdditionalReleases(wxTextFile *outFile, const wxString &pipeNr) {
 	// Deal with possible additional releases if not a percussive pipe
 	if ((!m_releases.empty() && !isPercussive) ||
 		(!m_releases.empty() && isPercussive && hasIndependentRelease)
 		) {
 		unsigned extraReleases = m_releases.size();
-		outFile->AddLine(pipeNr + wxT("ReleaseCount=") + wxString::Format(wxT("%u"), extraReleases));
+		GOODF_functions::addKeyLine(outFile, pipeNr, wxT("ReleaseCount="), extraReleases);
 		unsigned k = 0;
-		for (Release rel : m_releases) {
+		for (const Release &rel : m_releases) {
 			k++;
 			wxString releaseName = pipeNr + "Release" + GOODF_functions::number_format(k);
-			wxString fullLine = GOODF_functions::fixSeparator(releaseName + "=" + GOODF_functions::removeBaseOdfPath(rel.fileName));
+			wxString fullLine = GOODF_functions::fixSeparator(releaseName + "=" + GOODF_functions::removeBaseOdfPath(rel.fileName, *OrganContext::current()));
 			outFile->AddLine(fullLine);
 
 			if (rel.isTremulant != -1)
-				outFile->AddLine(releaseName + wxT("IsTremulant=") + wxString::Format(wxT("%i"), rel.isTremulant));
+				GOODF_functions::addKeyLine(outFile, releaseName, wxT("IsTremulant="), rel.isTremulant);
 
 			if (rel.maxKeyPressTime != -1)
-				outFile->AddLine(releaseName + wxT("MaxKeyPressTime=") + wxString::Format(wxT("%i"), rel.maxKeyPressTime));
+				GOODF_functions::addKeyLine(outFile, releaseName, wxT("MaxKeyPressTime="), rel.maxKeyPressTime);
 
 			if (rel.cuePoint != -1)
-				outFile->AddLine(releaseName + wxT("CuePoint=") + wxString::Format(wxT("%i"), rel.cuePoint));
+				GOODF_functions::addKeyLine(outFile, releaseName, wxT("CuePoint="), rel.cuePoint);
 
 			if (rel.releaseEnd != -1)
-				outFile->AddLine(releaseName + wxT("ReleaseEnd=") + wxString::Format(wxT("%i"), rel.releaseEnd));
+				GOODF_functions::addKeyLine(outFile, releaseName, wxT("ReleaseEnd="), rel.releaseEnd);
 
 			if (rel.releaseCrossfadeLength)
-				outFile->AddLine(releaseName + wxT("ReleaseCrossfadeLength=") + wxString::Format(wxT("%i"), rel.releaseCrossfadeLength));
+				GOODF_functions::addKeyLine(outFile, releaseName, wxT("ReleaseCrossfadeLength="), rel.releaseCrossfadeLength);
 		}
 	}
 }
 
-void Pipe::writeRef(wxTextFile *outFile, wxString pipeNr) {
+void Pipe::writeRef(wxTextFile *outFile, const wxString &pipeNr) {
 	outFile->AddLine(pipeNr + wxT("=") + m_attacks.front().fileName);
 }
 
-void Pipe::writeLoadRelease(wxTextFile *outFile, wxString pipeNr, Attack atk) {
+void Pipe::writeLoadRelease(wxTextFile *outFile, const wxString &pipeNr, const Attack &atk) {
 	if (!isPercussive) {
 		if (atk.fullPath != wxT("DUMMY")) {
 			// Load release is default Y for non percussive so we only need to care if it's false
@@ -414,71 +412,71 @@ void Pipe::writeLoadRelease(wxTextFile *outFile, wxString pipeNr, Attack atk) {
 	}
 }
 
-void Pipe::writeAttackVelocity(wxTextFile *outFile, wxString pipeNr, Attack atk) {
+void Pipe::writeAttackVelocity(wxTextFile *outFile, const wxString &pipeNr, const Attack &atk) {
 	if (atk.attackVelocity != 0)
-		outFile->AddLine(pipeNr + wxT("AttackVelocity=") + wxString::Format(wxT("%i"), atk.attackVelocity));
+		GOODF_functions::addKeyLine(outFile, pipeNr, wxT("AttackVelocity="), atk.attackVelocity);
 }
 
-void Pipe::writeMaxTimeSinceLastRelease(wxTextFile *outFile, wxString pipeNr, Attack atk) {
+void Pipe::writeMaxTimeSinceLastRelease(wxTextFile *outFile, const wxString &pipeNr, const Attack &atk) {
 	if (atk.maxTimeSinceLastRelease != -1)
-		outFile->AddLine(pipeNr + wxT("MaxTimeSinceLastRelease=") + wxString::Format(wxT("%i"), atk.maxTimeSinceLastRelease));
+		GOODF_functions::addKeyLine(outFile, pipeNr, wxT("MaxTimeSinceLastRelease="), atk.maxTimeSinceLastRelease);
 }
 
-void Pipe::writeIsTremulant(wxTextFile *outFile, wxString pipeNr, Attack atk) {
+void Pipe::writeIsTremulant(wxTextFile *outFile, const wxString &pipeNr, const Attack &atk) {
 	if (atk.isTremulant != -1)
-		outFile->AddLine(pipeNr + wxT("IsTremulant=") + wxString::Format(wxT("%i"), atk.isTremulant));
+		GOODF_functions::addKeyLine(outFile, pipeNr, wxT("IsTremulant="), atk.isTremulant);
 }
 
-void Pipe::writeMaxKeyPressTime(wxTextFile *outFile, wxString pipeNr, Attack atk) {
+void Pipe::writeMaxKeyPressTime(wxTextFile *outFile, const wxString &pipeNr, const Attack &atk) {
 	if (atk.maxKeyPressTime != -1)
-		outFile->AddLine(pipeNr + wxT("MaxKeyPressTime=") + wxString::Format(wxT("%i"), atk.maxKeyPressTime));
+		GOODF_functions::addKeyLine(outFile, pipeNr, wxT("MaxKeyPressTime="), atk.maxKeyPressTime);
 }
 
-void Pipe::writeAttackStart(wxTextFile *outFile, wxString pipeNr, Attack atk) {
+void Pipe::writeAttackStart(wxTextFile *outFile, const wxString &pipeNr, const Attack &atk) {
 	if (atk.attackStart != 0)
-		outFile->AddLine(pipeNr + wxT("AttackStart=") + wxString::Format(wxT("%i"), atk.attackStart));
+		GOODF_functions::addKeyLine(outFile, pipeNr, wxT("AttackStart="), atk.attackStart);
 }
 
-void Pipe::writeCuePoint(wxTextFile *outFile, wxString pipeNr, Attack atk) {
+void Pipe::writeCuePoint(wxTextFile *outFile, const wxString &pipeNr, const Attack &atk) {
 	if (atk.cuePoint != -1 && !isPercussive)
-		outFile->AddLine(pipeNr + wxT("CuePoint=") + wxString::Format(wxT("%i"), atk.cuePoint));
+		GOODF_functions::addKeyLine(outFile, pipeNr, wxT("CuePoint="), atk.cuePoint);
 }
 
-void Pipe::writeReleaseEnd(wxTextFile *outFile, wxString pipeNr, Attack atk) {
+void Pipe::writeReleaseEnd(wxTextFile *outFile, const wxString &pipeNr, const Attack &atk) {
 	if (atk.releaseEnd != -1 && !isPercussive)
-		outFile->AddLine(pipeNr + wxT("ReleaseEnd=") + wxString::Format(wxT("%i"), atk.releaseEnd));
+		GOODF_functions::addKeyLine(outFile, pipeNr, wxT("ReleaseEnd="), atk.releaseEnd);
 }
 
-void Pipe::writeLoops(wxTextFile *outFile, wxString pipeNr, Attack &atk) {
+void Pipe::writeLoops(wxTextFile *outFile, const wxString &pipeNr, const Attack &atk) {
 	if (!atk.m_loops.empty() && !isPercussive) {
 		unsigned nbLoops = atk.m_loops.size();
-		outFile->AddLine(pipeNr + wxT("LoopCount=") + wxString::Format(wxT("%u"), nbLoops));
+		GOODF_functions::addKeyLine(outFile, pipeNr, wxT("LoopCount="), nbLoops);
 		unsigned counter = 0;
-		for (Loop l : atk.m_loops) {
+		for (const Loop &l : atk.m_loops) {
 			counter++;
 			wxString formattedLoopNr = GOODF_functions::number_format(counter);
-			outFile->AddLine(pipeNr + wxT("Loop") + formattedLoopNr + wxT("Start=") + wxString::Format(wxT("%i"), l.start));
-			outFile->AddLine(pipeNr + wxT("Loop") + formattedLoopNr + wxT("End=") + wxString::Format(wxT("%i"), l.end));
+			GOODF_functions::addKeyLine(outFile, pipeNr + wxT("Loop") + formattedLoopNr, wxT("Start="), l.start);
+			GOODF_functions::addKeyLine(outFile, pipeNr + wxT("Loop") + formattedLoopNr, wxT("End="), l.end);
 		}
 	}
 }
 
-void Pipe::writeLoopXfade(wxTextFile *outFile, wxString pipeNr, Attack &atk) {
+void Pipe::writeLoopXfade(wxTextFile *outFile, const wxString &pipeNr, const Attack &atk) {
 	if (atk.loopCrossfadeLength && !isPercussive)
-		outFile->AddLine(pipeNr + wxT("LoopCrossfadeLength=") + wxString::Format(wxT("%i"), atk.loopCrossfadeLength));
+		GOODF_functions::addKeyLine(outFile, pipeNr, wxT("LoopCrossfadeLength="), atk.loopCrossfadeLength);
 }
 
-void Pipe::writeReleaseXfade(wxTextFile *outFile, wxString pipeNr, Attack &atk) {
+void Pipe::writeReleaseXfade(wxTextFile *outFile, const wxString &pipeNr, const Attack &atk) {
 	if (atk.loadRelease && atk.releaseCrossfadeLength && !isPercussive)
-		outFile->AddLine(pipeNr + wxT("ReleaseCrossfadeLength=") + wxString::Format(wxT("%i"), atk.releaseCrossfadeLength));
+		GOODF_functions::addKeyLine(outFile, pipeNr, wxT("ReleaseCrossfadeLength="), atk.releaseCrossfadeLength);
 }
 
-void Pipe::updateRelativePaths() {
+void Pipe::updateRelativePaths(OrganContext &context) {
 	for (Attack& a : m_attacks) {
-		a.fileName = GOODF_functions::removeBaseOdfPath(a.fullPath);
+		a.fileName = GOODF_functions::removeBaseOdfPath(a.fullPath, context);
 	}
 	for (Release& r : m_releases) {
-		r.fileName = GOODF_functions::removeBaseOdfPath(r.fullPath);
+		r.fileName = GOODF_functions::removeBaseOdfPath(r.fullPath, context);
 	}
 }
 
@@ -30,6 +30,7 @@
 
 class Rank;
 class Organ;
+class OrganContext;
 
 class Pipe {
 public:
@@ -37,26 +38,26 @@ public:
 	Pipe(const Pipe& p);
 	~Pipe();
 
-	void write(wxTextFile *outFile, wxString pipeNr, Rank *parent);
+	void write(wxTextFile *outFile, const wxString &pipeNr, Rank *parent);
 	void read(wxFileConfig *cfg, wxString pipeNr, Rank *parent, Organ *readOrgan);
 	void readAttack(wxFileConfig *cfg, wxString pipeStr, Organ *readOrgan);
 
 	bool isFirstAttackRefPath();
-	void writeAdditionalAttacks(wxTextFile *outFile, wxString pipeNr);
-	void writeAdditionalReleases(wxTextFile *outFile, wxString pipeNr);
-	void writeRef(wxTextFile *outFile, wxString pipeNr);
-	void writeLoadRelease(wxTextFile *outFile, wxString pipeNr, Attack atk);
-	void writeAttackVelocity(wxTextFile *outFile, wxString pipeNr, Attack atk);
-	void writeMaxTimeSinceLastRelease(wxTextFile *outFile, wxString pipeNr, Attack atk);
-	void writeIsTremulant(wxTextFile *outFile, wxString pipeNr, Attack atk);
-	void writeMaxKeyPressTime(wxTextFile *outFile, wxString pipeNr, Attack atk);
-	void writeAttackStart(wxTextFile *outFile, wxString pipeNr, Attack atk);
-	void writeCuePoint(wxTextFile *outFile, wxString pipeNr, Attack atk);
-	void writeReleaseEnd(wxTextFile *outFile, wxString pipeNr, Attack atk);
-	void writeLoops(wxTextFile *outFile, wxString pipeNr, Attack &atk);
-	void writeLoopXfade(wxTextFile *outFile, wxString pipeNr, Attack &atk);
-	void writeReleaseXfade(wxTextFile *outFile, wxString pipeNr, Attack &atk);
-	void updateRelativePaths();
+	void writeAdditionalAttacks(wxTextFile *outFile, const wxString &pipeNr);
+	void writeAdditionalReleases(wxTextFile *outFile, const wxString &pipeNr);
+	void writeRef(wxTextFile *outFile, const wxString &pipeNr);
+	void writeLoadRelease(wxTextFile *outFile, const wxString &pipeNr, const Attack &atk);
+	void writeAttackVelocity(wxTextFile *outFile, const wxString &pipeNr, const Attack &atk);
+	void writeMaxTimeSinceLastRelease(wxTextFile *outFile, const wxString &pipeNr, const Attack &atk);
+	void writeIsTremulant(wxTextFile *outFile, const wxString &pipeNr, const Attack &atk);
+	void writeMaxKeyPressTime(wxTextFile *outFile, const wxString &pipeNr, const Attack &atk);
+	void writeAttackStart(wxTextFile *outFile, const wxString &pipeNr, const Attack &atk);
+	void writeCuePoint(wxTextFile *outFile, const wxString &pipeNr, const Attack &atk);
+	void writeReleaseEnd(wxTextFile *outFile, const wxString &pipeNr, const Attack &atk);
+	void writeLoops(wxTextFile *outFile, const wxString &pipeNr, const Attack &atk);
+	void writeLoopXfade(wxTextFile *outFile, const wxString &pipeNr, const Attack &atk);
+	void writeReleaseXfade(wxTextFile *outFile, const wxString &pipeNr, const Attack &atk);
+	void updateRelativePaths(OrganContext &context);
 	void updateRefString();
 	bool isIndependentRelease();
 	void setIndependentRelease(bool independent);
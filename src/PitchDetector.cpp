@@ -0,0 +1,218 @@
+/*
+ * PitchDetector.cpp is part of GoOdf.
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * GoOdf is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GoOdf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GoOdf.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#include "PitchDetector.h"
+#include "Rank.h"
+#include "SampleReader.h"
+#include "SignalKernels.h"
+#include "WAVfileParser.h"
+#include "WorkerPool.h"
+#include "Instrumentation.h"
+#include <algorithm>
+#include <cmath>
+
+// the lowest pipes of a 32' stop and the top of a high mixture
+static const double LOWEST_PITCH = 15.0;
+static const double HIGHEST_PITCH = 12000.0;
+static const float YIN_THRESHOLD = 0.12f;
+static const float YIN_GIVE_UP = 0.4f;
+static const unsigned NUMBER_OF_WINDOWS = 3;
+
+bool PitchDetector::detectPitch(const wxString &path, const std::vector<std::pair<unsigned, unsigned>> &loops, double &pitchInHz, wxString &errorMessage) {
+	SampleReader reader(path);
+	if (!reader.isOk()) {
+		errorMessage = reader.getErrorMessage();
+		return false;
+	}
+	unsigned sampleRate = reader.getSampleRate();
+	unsigned frames = reader.getNumberOfFrames();
+
+	// the sustain is between the loops, or the middle half of the sample
+	unsigned first = frames / 4;
+	unsigned last = frames - frames / 4;
+	if (!loops.empty()) {
+		first = frames;
+		last = 0;
+		for (const std::pair<unsigned, unsigned> &loop : loops) {
+			if (loop.second <= loop.first || loop.second >= frames)
+				continue;
+			first = std::min(first, loop.first);
+			last = std::max(last, loop.second);
+		}
+		if (last <= first) {
+			first = frames / 4;
+			last = frames - frames / 4;
+		}
+	}
+
+	unsigned longestPeriod = (unsigned) std::ceil(sampleRate / LOWEST_PITCH);
+	unsigned windowLength = 2 * std::max(longestPeriod, 1024u);
+	if (last <= first || last - first < windowLength) {
+		// a short sustain is analyzed as a whole, if it's long enough for the highest pipes
+		windowLength = std::min(windowLength, frames);
+		first = frames > windowLength ? (frames - windowLength) / 2 : 0;
+		last = first + windowLength;
+	}
+	if (windowLength < 64) {
+		errorMessage = wxT("The sample is too short to find its pitch.\n");
+		return false;
+	}
+
+	std::vector<float> interleaved;
+	std::vector<float> mono(windowLength);
+	std::vector<double> found;
+	unsigned step = NUMBER_OF_WINDOWS > 1 ? (last - first - windowLength) / (NUMBER_OF_WINDOWS - 1) : 0;
+	for (unsigned i = 0; i < NUMBER_OF_WINDOWS; i++) {
+		unsigned start = first + i * step;
+		if (!reader.readRange(start, start + windowLength, interleaved))
+			break;
+		SignalKernels::mixToMono(interleaved.data(), reader.getNumberOfChannels(), mono.data(), windowLength);
+		double pitch = detectWindowPitch(mono.data(), windowLength, sampleRate);
+		if (pitch > 0)
+			found.push_back(pitch);
+	}
+	if (found.empty()) {
+		errorMessage = wxT("No clear pitch was found in the sample.\n");
+		return false;
+	}
+	std::sort(found.begin(), found.end());
+	pitchInHz = found[found.size() / 2];
+	return true;
+}
+
+double PitchDetector::detectWindowPitch(const float *audio, unsigned length, unsigned sampleRate) {
+	unsigned shortestPeriod = std::max(2u, (unsigned) (sampleRate / std::min(HIGHEST_PITCH, sampleRate / 4.0)));
+	unsigned longestPeriod = std::min(length / 2, (unsigned) std::ceil(sampleRate / LOWEST_PITCH));
+	if (longestPeriod <= shortestPeriod + 2)
+		return 0;
+	unsigned compared = length - longestPeriod;
+
+	// cumulative mean normalized difference for every lag
+	std::vector<float> difference(longestPeriod + 1);
+	difference[0] = 1;
+	double runningSum = 0;
+	for (unsigned lag = 1; lag <= longestPeriod; lag++) {
+		float d = SignalKernels::squaredDistance(audio, audio + lag, compared);
+		runningSum += d;
+		difference[lag] = runningSum > 0 ? (float) (d * lag / runningSum) : 1.0f;
+	}
+
+	// the first dip below the threshold avoids choosing a lower octave
+	unsigned period = 0;
+	for (unsigned lag = shortestPeriod; lag < longestPeriod; lag++) {
+		if (difference[lag] < YIN_THRESHOLD) {
+			while (lag + 1 < longestPeriod && difference[lag + 1] < difference[lag])
+				lag++;
+			period = lag;
+			break;
+		}
+	}
+	if (!period) {
+		unsigned best = shortestPeriod;
+		for (unsigned lag = shortestPeriod; lag < longestPeriod; lag++) {
+			if (difference[lag] < difference[best])
+				best = lag;
+		}
+		if (difference[best] > YIN_GIVE_UP)
+			return 0;
+		period = best;
+	}
+
+	// the true minimum is between the lags
+	double refined = period;
+	if (period > 1 && period < longestPeriod) {
+		double before = difference[period - 1];
+		double at = difference[period];
+		double after = difference[period + 1];
+		double divisor = before - 2 * at + after;
+		if (divisor > 0)
+			refined += 0.5 * (before - after) / divisor;
+	}
+	return sampleRate / refined;
+}
+
+bool PitchDetector::detectRankPitches(
+	Rank *rank,
+	bool useSampleInfo,
+	std::vector<PIPE_PITCH> &pitches,
+	const std::function<bool(size_t, size_t)> &progress
+) {
+	ScopedTimer timer("analysis.detectPitch");
+	rank->loadPipes();
+	pitches.assign(rank->m_pipes.size(), PIPE_PITCH());
+
+	// the first attack with a sample of each pipe is copied for the workers
+	std::vector<wxString> paths;
+	std::vector<std::vector<std::pair<unsigned, unsigned>>> attackLoops;
+	for (Pipe &pipe : rank->m_pipes) {
+		wxString path;
+		std::vector<std::pair<unsigned, unsigned>> loops;
+		if (!pipe.isFirstAttackRefPath()) {
+			for (Attack &atk : pipe.m_attacks) {
+				if (atk.fullPath.IsEmpty() || atk.fullPath.IsSameAs(wxT("DUMMY"), false))
+					continue;
+				path = atk.fullPath;
+				for (Loop &loop : atk.m_loops)
+					loops.push_back(std::make_pair((unsigned) loop.start, (unsigned) loop.end));
+				break;
+			}
+		}
+		paths.push_back(path);
+		attackLoops.push_back(loops);
+	}
+
+	size_t total = paths.size();
+	return WorkerPool::run(
+		paths.size(),
+		[&](size_t index) {
+			PIPE_PITCH &result = pitches[index];
+			result.isFound = false;
+			result.isFromSampleInfo = false;
+			result.pitchInHz = 0;
+			if (paths[index].IsEmpty())
+				return;
+			WAVfileParser sample(paths[index]);
+			if (useSampleInfo && sample.isWavOk() && sample.hasPitchInfo()) {
+				result.pitchInHz = sample.getPitchInHz();
+				result.isFromSampleInfo = true;
+				result.isFound = true;
+				return;
+			}
+			std::vector<std::pair<unsigned, unsigned>> loops = attackLoops[index];
+			if (loops.empty()) {
+				for (unsigned i = 0; i < sample.getNumberOfLoops(); i++)
+					loops.push_back(std::make_pair(sample.getLoopAtIndex(i).dwStart, sample.getLoopAtIndex(i).dwEnd));
+			}
+			result.isFound = detectPitch(paths[index], loops, result.pitchInHz, result.errorMessage);
+		},
+		[&](size_t done) { return !progress || progress(done, total); }
+	);
+}
+
+void PitchDetector::pitchToMidi(double pitchInHz, int &midiKey, float &pitchFraction) {
+	double midiNote = 69.0 + 12.0 * std::log2(pitchInHz / 440.0);
+	midiKey = (int) std::floor(midiNote);
+	pitchFraction = (float) ((midiNote - midiKey) * 100.0);
+	if (pitchFraction >= 99.95f) {
+		midiKey++;
+		pitchFraction = 0;
+	}
+	midiKey = std::max(0, std::min(midiKey, 127));
+}
@@ -0,0 +1,60 @@
+/*
+ * PitchDetector.h is part of GoOdf.
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * GoOdf is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GoOdf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GoOdf.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#ifndef PITCHDETECTOR_H
+#define PITCHDETECTOR_H
+
+#include <wx/wx.h>
+#include <vector>
+#include <functional>
+
+class Rank;
+
+// Finds the pitch of a sample from its audio with the YIN method, for
+// samples without a smpl chunk telling it. A few windows spread over the
+// sustain (the loops, or the middle of the sample if it has none) are
+// analyzed and the median of their pitches is used.
+class PitchDetector {
+public:
+	struct PIPE_PITCH {
+		bool isFound;
+		// from the smpl chunk rather than detected
+		bool isFromSampleInfo;
+		double pitchInHz;
+		wxString errorMessage;
+	};
+
+	static bool detectPitch(const wxString &path, const std::vector<std::pair<unsigned, unsigned>> &loops, double &pitchInHz, wxString &errorMessage);
+	// Detects the pitch of a window of mono audio, 0 if there's no clear pitch
+	static double detectWindowPitch(const float *audio, unsigned length, unsigned sampleRate);
+	// Gets the pitch of the first attack of every pipe of the rank on the
+	// worker pool. With useSampleInfo the pitch in the smpl chunk is used
+	// when there is one. The progress gets the number of finished pipes.
+	static bool detectRankPitches(
+		Rank *rank,
+		bool useSampleInfo,
+		std::vector<PIPE_PITCH> &pitches,
+		const std::function<bool(size_t, size_t)> &progress = nullptr
+	);
+	// MIDI key and the cents (0 - 100) above it for a pitch
+	static void pitchToMidi(double pitchInHz, int &midiKey, float &pitchFraction);
+};
+
+#endif
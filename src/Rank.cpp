@@ -19,10 +19,11 @@
  */
 
 #include "Rank.h"
-#include "GOODF.h"
+#include "Organ.h"
 #include "GOODFFunctions.h"
+#include "Instrumentation.h"
+#include "SampleNameMatcher.h"
 #include <wx/unichar.h>
-#include <wx/regex.h>
 
 Rank::Rank() {
 	name = wxT("New Rank");
@@ -35,13 +36,16 @@ Rank::Rank() {
 	harmonicNumber = 8;
 	pitchCorrection = 0;
 	windchest = NULL;
-	percussive = ::wxGetApp().m_frame->m_organ->getIsPercussive();
-	hasIndependentRelease = ::wxGetApp().m_frame->m_organ->getHasIndependentRelease();
+	// whoever adds the rank to an organ applies the organ defaults
+	percussive = false;
+	hasIndependentRelease = false;
 	minVelocityVolume = 100;
 	maxVelocityVolume = 100;
 	acceptsRetuning = true;
 
 	m_latestPipesRootPath = wxEmptyString;
+	m_deferredPipesOrgan = NULL;
+	m_hasDeferredPipes = false;
 	createDummyPipes();
 }
 
@@ -62,6 +66,10 @@ Rank::Rank(const Rank& r) {
 	maxVelocityVolume = r.maxVelocityVolume;
 	acceptsRetuning = r.acceptsRetuning;
 	m_latestPipesRootPath = r.m_latestPipesRootPath;
+	m_deferredPipeKeys = r.m_deferredPipeKeys;
+	m_deferredPipeValues = r.m_deferredPipeValues;
+	m_deferredPipesOrgan = r.m_deferredPipesOrgan;
+	m_hasDeferredPipes = r.m_hasDeferredPipes;
 
 	for (Pipe p : r.m_pipes) {
 		m_pipes.push_back(p);
@@ -75,22 +83,22 @@ Rank::~Rank() {
 void Rank::write(wxTextFile *outFile) {
 	outFile->AddLine(wxT("Name=") + name);
 	if (firstMidiNoteNumber > -1)
-		outFile->AddLine(wxT("FirstMidiNoteNumber=") + wxString::Format(wxT("%i"), firstMidiNoteNumber));
-	outFile->AddLine(wxT("NumberOfLogicalPipes=") + wxString::Format(wxT("%i"), numberOfLogicalPipes));
+		GOODF_functions::addKeyLine(outFile, wxT("FirstMidiNoteNumber="), firstMidiNoteNumber);
+	GOODF_functions::addKeyLine(outFile, wxT("NumberOfLogicalPipes="), numberOfLogicalPipes);
 	if (amplitudeLevel != 100)
-		outFile->AddLine(wxT("AmplitudeLevel=") + wxString::Format(wxT("%f"), amplitudeLevel));
+		GOODF_functions::addKeyLine(outFile, wxT("AmplitudeLevel="), amplitudeLevel);
 	if (gain != 0)
-		outFile->AddLine(wxT("Gain=") + wxString::Format(wxT("%f"), gain));
+		GOODF_functions::addKeyLine(outFile, wxT("Gain="), gain);
 	if (pitchTuning != 0)
-		outFile->AddLine(wxT("PitchTuning=") + wxString::Format(wxT("%f"), pitchTuning));
+		GOODF_functions::addKeyLine(outFile, wxT("PitchTuning="), pitchTuning);
 	if (trackerDelay != 0)
-		outFile->AddLine(wxT("TrackerDelay=") + wxString::Format(wxT("%i"), trackerDelay));
+		GOODF_functions::addKeyLine(outFile, wxT("TrackerDelay="), trackerDelay);
 	if (harmonicNumber != 8)
-		outFile->AddLine(wxT("HarmonicNumber=") + wxString::Format(wxT("%i"), harmonicNumber));
+		GOODF_functions::addKeyLine(outFile, wxT("HarmonicNumber="), harmonicNumber);
 	if (pitchCorrection != 0)
-		outFile->AddLine(wxT("PitchCorrection=") + wxString::Format(wxT("%f"), pitchCorrection));
+		GOODF_functions::addKeyLine(outFile, wxT("PitchCorrection="), pitchCorrection);
 	if (windchest) {
-		wxString wcRef = GOODF_functions::number_format(::wxGetApp().m_frame->m_organ->getIndexOfOrganWindchest(windchest));
+		wxString wcRef = GOODF_functions::number_format(OrganContext::current()->getOrgan()->getIndexOfOrganWindchest(windchest));
 		outFile->AddLine(wxT("WindchestGroup=") + wcRef);
 		if (percussive != windchest->getIsPercussive()) {
 			if (percussive) {
@@ -107,16 +115,22 @@ void Rank::write(wxTextFile *outFile) {
 			}
 		}
 	} else {
-		wxLogWarning("No windchestgroup is set for rank %s! The .organ file won't be functional!", getName());
-		::wxGetApp().m_frame->GetLogWindow()->Show(true);
+		OrganContext::current()->logWarning(wxString::Format("No windchestgroup is set for rank %s! The .organ file won't be functional!", getName()));
 	}
 	if (minVelocityVolume != 100)
-		outFile->AddLine(wxT("MinVelocityVolume=") + wxString::Format(wxT("%f"), minVelocityVolume));
+		GOODF_functions::addKeyLine(outFile, wxT("MinVelocityVolume="), minVelocityVolume);
 	if (maxVelocityVolume != 100)
-		outFile->AddLine(wxT("MaxVelocityVolume=") + wxString::Format(wxT("%f"), maxVelocityVolume));
+		GOODF_functions::addKeyLine(outFile, wxT("MaxVelocityVolume="), maxVelocityVolume);
 	if (!acceptsRetuning)
 		outFile->AddLine(wxT("AcceptsRetuning=N"));
 
+	if (m_hasDeferredPipes) {
+		// pipes that have never been loaded are written back as they were read
+		for (unsigned i = 0; i < m_deferredPipeKeys.GetCount(); i++)
+			outFile->AddLine(m_deferredPipeKeys[i] + wxT("=") + m_deferredPipeValues[i]);
+		return;
+	}
+
 	// pipes of the rank
 	unsigned pipeCounter = 0;
 	bool hadUnusualTremulants = false;
@@ -135,21 +149,21 @@ void Rank::write(wxTextFile *outFile) {
 }
 
 void Rank::writeFromStop(wxTextFile *outFile) {
-	outFile->AddLine(wxT("NumberOfLogicalPipes=") + wxString::Format(wxT("%i"), numberOfLogicalPipes));
+	GOODF_functions::addKeyLine(outFile, wxT("NumberOfLogicalPipes="), numberOfLogicalPipes);
 	if (amplitudeLevel != 100)
-		outFile->AddLine(wxT("AmplitudeLevel=") + wxString::Format(wxT("%f"), amplitudeLevel));
+		GOODF_functions::addKeyLine(outFile, wxT("AmplitudeLevel="), amplitudeLevel);
 	if (gain != 0)
-		outFile->AddLine(wxT("Gain=") + wxString::Format(wxT("%f"), gain));
+		GOODF_functions::addKeyLine(outFile, wxT("Gain="), gain);
 	if (pitchTuning != 0)
-		outFile->AddLine(wxT("PitchTuning=") + wxString::Format(wxT("%f"), pitchTuning));
+		GOODF_functions::addKeyLine(outFile, wxT("PitchTuning="), pitchTuning);
 	if (trackerDelay != 0)
-		outFile->AddLine(wxT("TrackerDelay=") + wxString::Format(wxT("%i"), trackerDelay));
+		GOODF_functions::addKeyLine(outFile, wxT("TrackerDelay="), trackerDelay);
 	if (harmonicNumber != 8)
-		outFile->AddLine(wxT("HarmonicNumber=") + wxString::Format(wxT("%i"), harmonicNumber));
+		GOODF_functions::addKeyLine(outFile, wxT("HarmonicNumber="), harmonicNumber);
 	if (pitchCorrection != 0)
-		outFile->AddLine(wxT("PitchCorrection=") + wxString::Format(wxT("%f"), pitchCorrection));
+		GOODF_functions::addKeyLine(outFile, wxT("PitchCorrection="), pitchCorrection);
 	if (windchest) {
-		wxString wcRef = GOODF_functions::number_format(::wxGetApp().m_frame->m_organ->getIndexOfOrganWindchest(windchest));
+		wxString wcRef = GOODF_functions::number_format(OrganContext::current()->getOrgan()->getIndexOfOrganWindchest(windchest));
 		outFile->AddLine(wxT("WindchestGroup=") + wcRef);
 		if (percussive != windchest->getIsPercussive()) {
 			if (percussive) {
@@ -162,13 +176,12 @@ void Rank::writeFromStop(wxTextFile *outFile) {
 			}
 		}
 	} else {
-		wxLogWarning("No windchestgroup is set for internal rank of stop %s! The .organ file won't be functional!", getName());
-		::wxGetApp().m_frame->GetLogWindow()->Show(true);
+		OrganContext::current()->logWarning(wxString::Format("No windchestgroup is set for internal rank of stop %s! The .organ file won't be functional!", getName()));
 	}
 	if (minVelocityVolume != 100)
-		outFile->AddLine(wxT("MinVelocityVolume=") + wxString::Format(wxT("%f"), minVelocityVolume));
+		GOODF_functions::addKeyLine(outFile, wxT("MinVelocityVolume="), minVelocityVolume);
 	if (maxVelocityVolume != 100)
-		outFile->AddLine(wxT("MaxVelocityVolume=") + wxString::Format(wxT("%f"), maxVelocityVolume));
+		GOODF_functions::addKeyLine(outFile, wxT("MaxVelocityVolume="), maxVelocityVolume);
 	if (!acceptsRetuning)
 		outFile->AddLine(wxT("AcceptsRetuning=N"));
 
@@ -189,7 +202,7 @@ void Rank::writeFromStop(wxTextFile *outFile) {
 	}
 }
 
-void Rank::read(wxFileConfig *cfg, Organ *readOrgan) {
+void Rank::read(wxFileConfig *cfg, Organ *readOrgan, bool deferPipes, const wxArrayString *pipeEntryOrder) {
 	name = cfg->Read("Name", wxEmptyString);
 	int firstMIDInote = static_cast<int>(cfg->ReadLong("FirstMidiNoteNumber", 36));
 	if (firstMIDInote > -1 && firstMIDInote < 257) {
@@ -227,8 +240,7 @@ void Rank::read(wxFileConfig *cfg, Organ *readOrgan) {
 	if (windchestRef > 0 && windchestRef <= (int) readOrgan->getNumberOfWindchestgroups()) {
 		setWindchest(readOrgan->getOrganWindchestgroupAt(windchestRef - 1));
 	} else {
-		wxLogWarning("No windchestgroup could be read for %s!", getName());
-		::wxGetApp().m_frame->GetLogWindow()->Show(true);
+		readOrgan->getContext()->logWarning(wxString::Format("No windchestgroup could be read for %s!", getName()));
 	}
 	wxString percussiveStr = cfg->Read("Percussive", wxEmptyString);
 	setPercussive(GOODF_functions::parseBoolean(percussiveStr, false));
@@ -249,19 +261,72 @@ void Rank::read(wxFileConfig *cfg, Organ *readOrgan) {
 	if (!m_pipes.empty())
 		m_pipes.clear();
 
-	bool hadUnusualTremulants = false;
-	for (int i = 0; i < numberOfLogicalPipes; i++) {
-		Pipe p;
-		wxString pipeNbr = wxT("Pipe") + GOODF_functions::number_format(i + 1);
-		p.read(cfg, pipeNbr, this, readOrgan);
-		m_pipes.push_back(p);
-		if (p.hasUnusualTremulants()) {
-			hadUnusualTremulants = true;
+	if (deferPipes) {
+		// just keep the entries of the pipes that belong to the rank
+		m_deferredPipeKeys.Empty();
+		m_deferredPipeValues.Empty();
+		long pipeNbr;
+		if (pipeEntryOrder) {
+			for (const wxString &entryName : *pipeEntryOrder) {
+				if (entryName.StartsWith(wxT("Pipe")) && entryName.Mid(4, 3).ToLong(&pipeNbr) && pipeNbr > 0 && pipeNbr <= numberOfLogicalPipes && cfg->HasEntry(entryName)) {
+					m_deferredPipeKeys.Add(entryName);
+					m_deferredPipeValues.Add(cfg->Read(entryName, wxEmptyString));
+				}
+			}
+		} else {
+			wxString entryName;
+			long entryIndex;
+			bool hasEntry = cfg->GetFirstEntry(entryName, entryIndex);
+			while (hasEntry) {
+				if (entryName.StartsWith(wxT("Pipe")) && entryName.Mid(4, 3).ToLong(&pipeNbr) && pipeNbr > 0 && pipeNbr <= numberOfLogicalPipes) {
+					m_deferredPipeKeys.Add(entryName);
+					m_deferredPipeValues.Add(cfg->Read(entryName, wxEmptyString));
+				}
+				hasEntry = cfg->GetNextEntry(entryName, entryIndex);
+			}
 		}
+		m_deferredPipesOrgan = readOrgan;
+		m_hasDeferredPipes = true;
+	} else {
+		readPipeEntries(cfg, readOrgan);
 	}
-	if (hadUnusualTremulants) {
-		logTremulantMessage();
+}
+
+bool Rank::hasDeferredPipes() const {
+	return m_hasDeferredPipes;
+}
+
+void Rank::loadPipes() {
+	if (!m_hasDeferredPipes)
+		return;
+	m_hasDeferredPipes = false;
+
+	// an in-memory config without any backing file is filled with the kept
+	// entries so that the pipes are read exactly as during normal parsing
+	wxFileConfig pipeCfg(wxEmptyString, wxEmptyString, wxEmptyString, wxEmptyString, wxCONFIG_USE_NO_ESCAPE_CHARACTERS);
+	pipeCfg.SetExpandEnvVars(false);
+	for (unsigned i = 0; i < m_deferredPipeKeys.GetCount(); i++)
+		pipeCfg.Write(m_deferredPipeKeys[i], m_deferredPipeValues[i]);
+	m_deferredPipeKeys.Empty();
+	m_deferredPipeValues.Empty();
+
+	OrganContextScope contextScope(m_deferredPipesOrgan->getContext());
+	readPipeEntries(&pipeCfg, m_deferredPipesOrgan);
+	m_deferredPipesOrgan = NULL;
+}
+
+bool Rank::hasDeferredLegacyXfades() {
+	// same test as for loaded pipes: an attack with LoadRelease=N and a ReleaseCrossfadeLength
+	for (unsigned i = 0; i < m_deferredPipeKeys.GetCount(); i++) {
+		const wxString &key = m_deferredPipeKeys[i];
+		if (key.length() == 18 && key.EndsWith(wxT("LoadRelease")) && !GOODF_functions::parseBoolean(m_deferredPipeValues[i], true)) {
+			int xfadeIdx = m_deferredPipeKeys.Index(key.Left(7) + wxT("ReleaseCrossfadeLength"));
+			long xfadeValue = 0;
+			if (xfadeIdx != wxNOT_FOUND && m_deferredPipeValues[xfadeIdx].ToLong(&xfadeValue) && xfadeValue)
+				return true;
+		}
 	}
+	return false;
 }
 
 bool Rank::doesAcceptsRetuning() const {
@@ -269,6 +334,7 @@ bool Rank::doesAcceptsRetuning() const {
 }
 
 void Rank::setAcceptsRetuning(bool acceptsRetuning) {
+	loadPipes();
 	this->acceptsRetuning = acceptsRetuning;
 
 	for (std::list<Pipe>::iterator pipe = m_pipes.begin(); pipe != m_pipes.end(); ++pipe) {
@@ -305,6 +371,7 @@ int Rank::getHarmonicNumber() const {
 }
 
 void Rank::setHarmonicNumber(int harmonicNumber) {
+	loadPipes();
 	this->harmonicNumber = harmonicNumber;
 
 	for (std::list<Pipe>::iterator pipe = m_pipes.begin(); pipe != m_pipes.end(); ++pipe) {
@@ -317,6 +384,7 @@ float Rank::getMaxVelocityVolume() const {
 }
 
 void Rank::setMaxVelocityVolume(float maxVelocityVolume) {
+	loadPipes();
 	this->maxVelocityVolume = maxVelocityVolume;
 
 	for (std::list<Pipe>::iterator pipe = m_pipes.begin(); pipe != m_pipes.end(); ++pipe) {
@@ -329,6 +397,7 @@ float Rank::getMinVelocityVolume() const {
 }
 
 void Rank::setMinVelocityVolume(float minVelocityVolume) {
+	loadPipes();
 	this->minVelocityVolume = minVelocityVolume;
 
 	for (std::list<Pipe>::iterator pipe = m_pipes.begin(); pipe != m_pipes.end(); ++pipe) {
@@ -397,6 +466,7 @@ Windchestgroup* Rank::getWindchest() {
 }
 
 void Rank::setWindchest(Windchestgroup *windchest) {
+	loadPipes();
 	this->windchest = windchest;
 	for (std::list<Pipe>::iterator pipe = m_pipes.begin(); pipe != m_pipes.end(); ++pipe) {
 		pipe->windchest = this->windchest;
@@ -425,11 +495,14 @@ void Rank::readPipes(
 	bool loadPipesAsTremOff,
 	int startPipeIdx,
 	int firstMatchingNumber,
-	int totalNbrOfPipes
+	int totalNbrOfPipes,
+	OrganContext &context
 ) {
+	ScopedTimer timer("scan.readPipes");
+	loadPipes();
 	bool organRootPathIsSet = false;
 
-	if (::wxGetApp().m_frame->m_organ->getOdfRoot() != wxEmptyString)
+	if (context.getOrgan()->getOdfRoot() != wxEmptyString)
 		organRootPathIsSet = true;
 
 	wxDir pipeRoot(m_latestPipesRootPath);
@@ -437,15 +510,16 @@ void Rank::readPipes(
 	if (!pipeRoot.IsOpened())
 		return;
 
+	// every folder is listed once and its files sorted by MIDI note
+	SampleNameMatcher matcher(context.getSampleNamingScheme(), context.getSampleNamePattern(), context.getNoteNameConvention());
+
 	int count = 0;
 	for (int i = startPipeIdx; i < startPipeIdx + totalNbrOfPipes; i++) {
 		emptyPipeAt(i);
 		Pipe *p = getPipeAt(i);
 		setupPipeProperties(*p);
 
-		wxArrayString pipeAttacks;
 		wxArrayString pipeAttacksToAdd;
-		wxArrayString pipeReleases;
 		wxArrayString pipeReleasesToAdd;
 		wxArrayString releaseFolders;
 		wxArrayString tremulantFolders;
@@ -475,37 +549,31 @@ void Rank::readPipes(
 		}
 
 		// get attacks from root folder
-		pipeRoot.GetAllFiles(
+		fillArrayStringWithFiles(
+			matcher,
 			m_latestPipesRootPath,
-			&pipeAttacks,
-			wxString::Format(wxT("*%i*.*"), (count + firstMatchingNumber)),
-			wxDIR_FILES
+			pipeAttacksToAdd,
+			count + firstMatchingNumber
 		);
 
 		// then from possible extra attack folder
 		if (extraAttackFolder != wxEmptyString) {
-			pipeRoot.GetAllFiles(
+			fillArrayStringWithFiles(
+				matcher,
 				m_latestPipesRootPath + wxFILE_SEP_PATH + extraAttackFolder,
-				&pipeAttacks,
-				wxString::Format(wxT("*%i*.*"), (count + firstMatchingNumber)),
-				wxDIR_FILES
+				pipeAttacksToAdd,
+				count + firstMatchingNumber
 			);
 		}
 
-		pipeAttacks.Sort();
-
-		// remove any file that's not ending with .wav or .wv
-		onlyAddWaveFiles(pipeAttacks, pipeAttacksToAdd);
-
-		// make sure to exactly match the MIDI number
-		exactlyMatchMidiNumber(pipeAttacksToAdd, count + firstMatchingNumber);
+		pipeAttacksToAdd.Sort();
 
 		// if there are any matching attacks we add them
 		if (!pipeAttacksToAdd.IsEmpty()) {
 			for (unsigned j = 0; j < pipeAttacksToAdd.GetCount(); j++) {
 				wxString relativeFileName;
 				if (organRootPathIsSet)
-					relativeFileName = getOnlyFileName(pipeAttacksToAdd.Item(j));
+					relativeFileName = getOnlyFileName(pipeAttacksToAdd.Item(j), context);
 				else
 					relativeFileName = pipeAttacksToAdd.Item(j);
 
@@ -524,7 +592,6 @@ void Rank::readPipes(
 			}
 		}
 
-		pipeAttacks.Empty();
 		pipeAttacksToAdd.Empty();
 
 		// add extra releases if they can be found
@@ -533,20 +600,14 @@ void Rank::readPipes(
 			releaseFolders.Sort();
 
 			for (unsigned j = 0; j < releaseFolders.GetCount(); j++) {
-				pipeRoot.GetAllFiles(
+				fillArrayStringWithFiles(
+					matcher,
 					m_latestPipesRootPath + wxFILE_SEP_PATH + releaseFolders.Item(j),
-					&pipeReleases,
-					wxString::Format(wxT("*%i*.*"), (count + firstMatchingNumber)),
-					wxDIR_FILES
+					pipeReleasesToAdd,
+					count + firstMatchingNumber
 				);
 
-				pipeReleases.Sort();
-
-				// remove any file that's not ending with .wav or .wv
-				onlyAddWaveFiles(pipeReleases, pipeReleasesToAdd);
-
-				// make sure to exactly match the MIDI number
-				exactlyMatchMidiNumber(pipeReleasesToAdd, count + firstMatchingNumber);
+				pipeReleasesToAdd.Sort();
 
 				// if there are any matching releases we add them
 				if (!pipeReleasesToAdd.IsEmpty()) {
@@ -554,7 +615,7 @@ void Rank::readPipes(
 					for (unsigned k = 0; k < pipeReleasesToAdd.GetCount(); k++) {
 						wxString relativeFileName;
 						if (organRootPathIsSet)
-							relativeFileName = getOnlyFileName(pipeReleasesToAdd.Item(k));
+							relativeFileName = getOnlyFileName(pipeReleasesToAdd.Item(k), context);
 						else
 							relativeFileName = pipeReleasesToAdd.Item(k);
 
@@ -595,7 +656,6 @@ void Rank::readPipes(
 					}
 				}
 
-				pipeReleases.Empty();
 				pipeReleasesToAdd.Empty();
 			}
 		}
@@ -604,24 +664,18 @@ void Rank::readPipes(
 		if (!tremulantFolders.IsEmpty() && !loadOnlyOneAttack) {
 			for (unsigned j = 0; j < tremulantFolders.GetCount(); j++) {
 				fillArrayStringWithFiles(
-					pipeRoot,
+					matcher,
 					m_latestPipesRootPath + wxFILE_SEP_PATH + tremulantFolders.Item(j),
-					pipeAttacks,
-					count,
-					firstMatchingNumber
+					pipeAttacksToAdd,
+					count + firstMatchingNumber
 				);
 
-				onlyAddWaveFiles(pipeAttacks, pipeAttacksToAdd);
-
-				// make sure to exactly match the MIDI number
-				exactlyMatchMidiNumber(pipeAttacksToAdd, count + firstMatchingNumber);
-
 				// if there are any matching attacks we add them
 				if (!pipeAttacksToAdd.IsEmpty()) {
 					for (unsigned k = 0; k < pipeAttacksToAdd.GetCount(); k++) {
 						wxString relativeFileName;
 						if (organRootPathIsSet)
-							relativeFileName = getOnlyFileName(pipeAttacksToAdd.Item(k));
+							relativeFileName = getOnlyFileName(pipeAttacksToAdd.Item(k), context);
 						else
 							relativeFileName = pipeAttacksToAdd.Item(k);
 
@@ -637,6 +691,8 @@ void Rank::readPipes(
 					}
 				}
 
+				pipeAttacksToAdd.Empty();
+
 				// also take care of possible tremulant releases
 				wxArrayString foldersInTremulantFolder;
 				wxArrayString tremReleaseFolders;
@@ -663,27 +719,22 @@ void Rank::readPipes(
 					if (!tremReleaseFolders.IsEmpty()) {
 						for (unsigned k = 0; k < tremReleaseFolders.GetCount(); k++) {
 							fillArrayStringWithFiles(
-								tremRoot,
+								matcher,
 								currentTremRootPath + wxFILE_SEP_PATH + tremReleaseFolders.Item(k),
-								pipeReleases,
-								count,
-								firstMatchingNumber
+								pipeReleasesToAdd,
+								count + firstMatchingNumber
 							);
 						}
 					}
 
-					pipeReleases.Sort();
-					onlyAddWaveFiles(pipeReleases, pipeReleasesToAdd);
-
-					// make sure to exactly match the MIDI number
-					exactlyMatchMidiNumber(pipeReleasesToAdd, count + firstMatchingNumber);
+					pipeReleasesToAdd.Sort();
 
 					// if there are any matching releases we add them
 					if (!pipeReleasesToAdd.IsEmpty()) {
 						for (unsigned k = 0; k < pipeReleasesToAdd.GetCount(); k++) {
 							wxString relativeFileName;
 							if (organRootPathIsSet)
-								relativeFileName = getOnlyFileName(pipeReleasesToAdd.Item(k));
+								relativeFileName = getOnlyFileName(pipeReleasesToAdd.Item(k), context);
 							else
 								relativeFileName = pipeReleasesToAdd.Item(k);
 
@@ -720,6 +771,7 @@ void Rank::readPipes(
 						}
 					}
 
+					pipeReleasesToAdd.Empty();
 				}
 			}
 		}
@@ -745,11 +797,14 @@ void Rank::addToPipes(
 	bool loadPipesAsTremOff,
 	int startPipeIdx,
 	int firstMatchingNumber,
-	int totalNbrOfPipes
+	int totalNbrOfPipes,
+	OrganContext &context
 ) {
+	ScopedTimer timer("scan.addToPipes");
+	loadPipes();
 	bool organRootPathIsSet = false;
 
-	if (::wxGetApp().m_frame->m_organ->getOdfRoot() != wxEmptyString)
+	if (context.getOrgan()->getOdfRoot() != wxEmptyString)
 		organRootPathIsSet = true;
 
 	wxDir pipeRoot(m_latestPipesRootPath);
@@ -757,13 +812,14 @@ void Rank::addToPipes(
 	if (!pipeRoot.IsOpened())
 		return;
 
+	// every folder is listed once and its files sorted by MIDI note
+	SampleNameMatcher matcher(context.getSampleNamingScheme(), context.getSampleNamePattern(), context.getNoteNameConvention());
+
 	int count = 0;
 	for (int i = startPipeIdx; i < startPipeIdx + totalNbrOfPipes; i++) {
 		Pipe *p = getPipeAt(i);
 
-		wxArrayString pipeAttacks;
 		wxArrayString pipeAttacksToAdd;
-		wxArrayString pipeReleases;
 		wxArrayString pipeReleasesToAdd;
 		wxArrayString releaseFolders;
 		wxArrayString tremulantFolders;
@@ -793,37 +849,31 @@ void Rank::addToPipes(
 		}
 
 		// get attacks from root folder
-		pipeRoot.GetAllFiles(
+		fillArrayStringWithFiles(
+			matcher,
 			m_latestPipesRootPath,
-			&pipeAttacks,
-			wxString::Format(wxT("*%i*.*"), (count + firstMatchingNumber)),
-			wxDIR_FILES
+			pipeAttacksToAdd,
+			count + firstMatchingNumber
 		);
 
 		// then from possible extra attack folder
 		if (extraAttackFolder != wxEmptyString) {
-			pipeRoot.GetAllFiles(
+			fillArrayStringWithFiles(
+				matcher,
 				m_latestPipesRootPath + wxFILE_SEP_PATH + extraAttackFolder,
-				&pipeAttacks,
-				wxString::Format(wxT("*%i*.*"), (count + firstMatchingNumber)),
-				wxDIR_FILES
+				pipeAttacksToAdd,
+				count + firstMatchingNumber
 			);
 		}
 
-		pipeAttacks.Sort();
-
-		// remove any file that's not ending with .wav or .wv
-		onlyAddWaveFiles(pipeAttacks, pipeAttacksToAdd);
-
-		// make sure to exactly match the MIDI number
-		exactlyMatchMidiNumber(pipeAttacksToAdd, count + firstMatchingNumber);
+		pipeAttacksToAdd.Sort();
 
 		// if there are any matching attacks we add them
 		if (!pipeAttacksToAdd.IsEmpty()) {
 			for (unsigned j = 0; j < pipeAttacksToAdd.GetCount(); j++) {
 				wxString relativeFileName;
 				if (organRootPathIsSet)
-					relativeFileName = getOnlyFileName(pipeAttacksToAdd.Item(j));
+					relativeFileName = getOnlyFileName(pipeAttacksToAdd.Item(j), context);
 				else
 					relativeFileName = pipeAttacksToAdd.Item(j);
 
@@ -842,7 +892,6 @@ void Rank::addToPipes(
 			}
 		}
 
-		pipeAttacks.Empty();
 		pipeAttacksToAdd.Empty();
 
 		// add extra releases if they can be found
@@ -851,20 +900,14 @@ void Rank::addToPipes(
 			releaseFolders.Sort();
 
 			for (unsigned j = 0; j < releaseFolders.GetCount(); j++) {
-				pipeRoot.GetAllFiles(
+				fillArrayStringWithFiles(
+					matcher,
 					m_latestPipesRootPath + wxFILE_SEP_PATH + releaseFolders.Item(j),
-					&pipeReleases,
-					wxString::Format(wxT("*%i*.*"), (count + firstMatchingNumber)),
-					wxDIR_FILES
+					pipeReleasesToAdd,
+					count + firstMatchingNumber
 				);
 
-				pipeReleases.Sort();
-
-				// remove any file that's not ending with .wav or .wv
-				onlyAddWaveFiles(pipeReleases, pipeReleasesToAdd);
-
-				// make sure to exactly match the MIDI number
-				exactlyMatchMidiNumber(pipeReleasesToAdd, count + firstMatchingNumber);
+				pipeReleasesToAdd.Sort();
 
 				// if there are any matching releases we add them
 				if (!pipeReleasesToAdd.IsEmpty()) {
@@ -872,7 +915,7 @@ void Rank::addToPipes(
 					for (unsigned k = 0; k < pipeReleasesToAdd.GetCount(); k++) {
 						wxString relativeFileName;
 						if (organRootPathIsSet)
-							relativeFileName = getOnlyFileName(pipeReleasesToAdd.Item(k));
+							relativeFileName = getOnlyFileName(pipeReleasesToAdd.Item(k), context);
 						else
 							relativeFileName = pipeReleasesToAdd.Item(k);
 
@@ -913,7 +956,6 @@ void Rank::addToPipes(
 					}
 				}
 
-				pipeReleases.Empty();
 				pipeReleasesToAdd.Empty();
 			}
 		}
@@ -922,24 +964,18 @@ void Rank::addToPipes(
 		if (!tremulantFolders.IsEmpty() && !loadOnlyOneAttack) {
 			for (unsigned j = 0; j < tremulantFolders.GetCount(); j++) {
 				fillArrayStringWithFiles(
-					pipeRoot,
+					matcher,
 					m_latestPipesRootPath + wxFILE_SEP_PATH + tremulantFolders.Item(j),
-					pipeAttacks,
-					count,
-					firstMatchingNumber
+					pipeAttacksToAdd,
+					count + firstMatchingNumber
 				);
 
-				onlyAddWaveFiles(pipeAttacks, pipeAttacksToAdd);
-
-				// make sure to exactly match the MIDI number
-				exactlyMatchMidiNumber(pipeAttacksToAdd, count + firstMatchingNumber);
-
 				// if there are any matching attacks we add them
 				if (!pipeAttacksToAdd.IsEmpty()) {
 					for (unsigned k = 0; k < pipeAttacksToAdd.GetCount(); k++) {
 						wxString relativeFileName;
 						if (organRootPathIsSet)
-							relativeFileName = getOnlyFileName(pipeAttacksToAdd.Item(k));
+							relativeFileName = getOnlyFileName(pipeAttacksToAdd.Item(k), context);
 						else
 							relativeFileName = pipeAttacksToAdd.Item(k);
 
@@ -955,6 +991,8 @@ void Rank::addToPipes(
 					}
 				}
 
+				pipeAttacksToAdd.Empty();
+
 				// also take care of possible tremulant releases
 				wxArrayString foldersInTremulantFolder;
 				wxArrayString tremReleaseFolders;
@@ -981,27 +1019,22 @@ void Rank::addToPipes(
 					if (!tremReleaseFolders.IsEmpty()) {
 						for (unsigned k = 0; k < tremReleaseFolders.GetCount(); k++) {
 							fillArrayStringWithFiles(
-								tremRoot,
+								matcher,
 								currentTremRootPath + wxFILE_SEP_PATH + tremReleaseFolders.Item(k),
-								pipeReleases,
-								count,
-								firstMatchingNumber
+								pipeReleasesToAdd,
+								count + firstMatchingNumber
 							);
 						}
 					}
 
-					pipeReleases.Sort();
-					onlyAddWaveFiles(pipeReleases, pipeReleasesToAdd);
-
-					// make sure to exactly match the MIDI number
-					exactlyMatchMidiNumber(pipeReleasesToAdd, count + firstMatchingNumber);
+					pipeReleasesToAdd.Sort();
 
 					// if there are any matching releases we add them
 					if (!pipeReleasesToAdd.IsEmpty()) {
 						for (unsigned k = 0; k < pipeReleasesToAdd.GetCount(); k++) {
 							wxString relativeFileName;
 							if (organRootPathIsSet)
-								relativeFileName = getOnlyFileName(pipeReleasesToAdd.Item(k));
+								relativeFileName = getOnlyFileName(pipeReleasesToAdd.Item(k), context);
 							else
 								relativeFileName = pipeReleasesToAdd.Item(k);
 
@@ -1038,6 +1071,7 @@ void Rank::addToPipes(
 						}
 					}
 
+					pipeReleasesToAdd.Empty();
 				}
 			}
 		}
@@ -1053,12 +1087,14 @@ void Rank::addTremulantToPipes(
 	bool extractKeyPressTime,
 	int startPipeIdx,
 	int firstMatchingNumber,
-	int totalNbrOfPipes
+	int totalNbrOfPipes,
+	OrganContext &context
 ) {
+	loadPipes();
 	// This method is for adding additional attacks/releases as (wave) tremulants only
 	bool organRootPathIsSet = false;
 
-	if (::wxGetApp().m_frame->m_organ->getOdfRoot() != wxEmptyString)
+	if (context.getOrgan()->getOdfRoot() != wxEmptyString)
 		organRootPathIsSet = true;
 
 	wxDir pipeRoot(m_latestPipesRootPath);
@@ -1066,13 +1102,14 @@ void Rank::addTremulantToPipes(
 	if (!pipeRoot.IsOpened())
 		return;
 
+	// every folder is listed once and its files sorted by MIDI note
+	SampleNameMatcher matcher(context.getSampleNamingScheme(), context.getSampleNamePattern(), context.getNoteNameConvention());
+
 	int count = 0;
 	for (int i = startPipeIdx; i < startPipeIdx + totalNbrOfPipes; i++) {
 		Pipe *p = getPipeAt(i);
 
-		wxArrayString pipeAttacks;
 		wxArrayString pipeAttacksToAdd;
-		wxArrayString pipeReleases;
 		wxArrayString pipeReleasesToAdd;
 		wxArrayString releaseFolders;
 		wxArrayString allFolders;
@@ -1096,37 +1133,31 @@ void Rank::addTremulantToPipes(
 		}
 
 		// get attacks from root folder
-		pipeRoot.GetAllFiles(
+		fillArrayStringWithFiles(
+			matcher,
 			m_latestPipesRootPath,
-			&pipeAttacks,
-			wxString::Format(wxT("*%i*.*"), (count + firstMatchingNumber)),
-			wxDIR_FILES
+			pipeAttacksToAdd,
+			count + firstMatchingNumber
 		);
 
 		// then from possible extra attack folder
 		if (extraAttackFolder != wxEmptyString) {
-			pipeRoot.GetAllFiles(
+			fillArrayStringWithFiles(
+				matcher,
 				m_latestPipesRootPath + wxFILE_SEP_PATH + extraAttackFolder,
-				&pipeAttacks,
-				wxString::Format(wxT("*%i*.*"), (count + firstMatchingNumber)),
-				wxDIR_FILES
+				pipeAttacksToAdd,
+				count + firstMatchingNumber
 			);
 		}
 
-		pipeAttacks.Sort();
-
-		// remove any file that's not ending with .wav or .wv
-		onlyAddWaveFiles(pipeAttacks, pipeAttacksToAdd);
-
-		// make sure to exactly match the MIDI number
-		exactlyMatchMidiNumber(pipeAttacksToAdd, count + firstMatchingNumber);
+		pipeAttacksToAdd.Sort();
 
 		// if there are any matching attacks we add them
 		if (!pipeAttacksToAdd.IsEmpty()) {
 			for (unsigned j = 0; j < pipeAttacksToAdd.GetCount(); j++) {
 				wxString relativeFileName;
 				if (organRootPathIsSet)
-					relativeFileName = getOnlyFileName(pipeAttacksToAdd.Item(j));
+					relativeFileName = getOnlyFileName(pipeAttacksToAdd.Item(j), context);
 				else
 					relativeFileName = pipeAttacksToAdd.Item(j);
 
@@ -1144,7 +1175,6 @@ void Rank::addTremulantToPipes(
 			}
 		}
 
-		pipeAttacks.Empty();
 		pipeAttacksToAdd.Empty();
 
 		// add extra releases if they can be found
@@ -1153,20 +1183,14 @@ void Rank::addTremulantToPipes(
 			releaseFolders.Sort();
 
 			for (unsigned j = 0; j < releaseFolders.GetCount(); j++) {
-				pipeRoot.GetAllFiles(
+				fillArrayStringWithFiles(
+					matcher,
 					m_latestPipesRootPath + wxFILE_SEP_PATH + releaseFolders.Item(j),
-					&pipeReleases,
-					wxString::Format(wxT("*%i*.*"), (count + firstMatchingNumber)),
-					wxDIR_FILES
+					pipeReleasesToAdd,
+					count + firstMatchingNumber
 				);
 
-				pipeReleases.Sort();
-
-				// remove any file that's not ending with .wav or .wv
-				onlyAddWaveFiles(pipeReleases, pipeReleasesToAdd);
-
-				// make sure to exactly match the MIDI number
-				exactlyMatchMidiNumber(pipeReleasesToAdd, count + firstMatchingNumber);
+				pipeReleasesToAdd.Sort();
 
 				// if there are any matching releases we add them
 				if (!pipeReleasesToAdd.IsEmpty()) {
@@ -1174,7 +1198,7 @@ void Rank::addTremulantToPipes(
 					for (unsigned k = 0; k < pipeReleasesToAdd.GetCount(); k++) {
 						wxString relativeFileName;
 						if (organRootPathIsSet)
-							relativeFileName = getOnlyFileName(pipeReleasesToAdd.Item(k));
+							relativeFileName = getOnlyFileName(pipeReleasesToAdd.Item(k), context);
 						else
 							relativeFileName = pipeReleasesToAdd.Item(k);
 
@@ -1214,7 +1238,6 @@ void Rank::addTremulantToPipes(
 					}
 				}
 
-				pipeReleases.Empty();
 				pipeReleasesToAdd.Empty();
 			}
 		}
@@ -1226,12 +1249,14 @@ void Rank::addReleasesToPipes(
 	bool loadPipesAsTremOff,
 	int startPipeIdx,
 	int firstMatchingNumber,
-	int totalNbrOfPipes
+	int totalNbrOfPipes,
+	OrganContext &context
 ) {
+	loadPipes();
 	// This method is for adding releases only from a single folder
 	bool organRootPathIsSet = false;
 
-	if (::wxGetApp().m_frame->m_organ->getOdfRoot() != wxEmptyString)
+	if (context.getOrgan()->getOdfRoot() != wxEmptyString)
 		organRootPathIsSet = true;
 
 	wxDir pipeRoot(m_latestPipesRootPath);
@@ -1239,35 +1264,31 @@ void Rank::addReleasesToPipes(
 	if (!pipeRoot.IsOpened())
 		return;
 
+	// every folder is listed once and its files sorted by MIDI note
+	SampleNameMatcher matcher(context.getSampleNamingScheme(), context.getSampleNamePattern(), context.getNoteNameConvention());
+
 	int count = 0;
 	for (int i = startPipeIdx; i < startPipeIdx + totalNbrOfPipes; i++) {
 		Pipe *p = getPipeAt(i);
 
-		wxArrayString pipeReleases;
 		wxArrayString pipeReleasesToAdd;
 
 		// get files from root folder
-		pipeRoot.GetAllFiles(
+		fillArrayStringWithFiles(
+			matcher,
 			m_latestPipesRootPath,
-			&pipeReleases,
-			wxString::Format(wxT("*%i*.*"), (count + firstMatchingNumber)),
-			wxDIR_FILES
+			pipeReleasesToAdd,
+			count + firstMatchingNumber
 		);
 
-		pipeReleases.Sort();
-
-		// remove any file that's not ending with .wav or .wv
-		onlyAddWaveFiles(pipeReleases, pipeReleasesToAdd);
-
-		// make sure to exactly match the MIDI number
-		exactlyMatchMidiNumber(pipeReleasesToAdd, count + firstMatchingNumber);
+		pipeReleasesToAdd.Sort();
 
 		// if there are any matching attacks we add them
 		if (!pipeReleasesToAdd.IsEmpty()) {
 			for (unsigned j = 0; j < pipeReleasesToAdd.GetCount(); j++) {
 				wxString relativeFileName;
 				if (organRootPathIsSet)
-					relativeFileName = getOnlyFileName(pipeReleasesToAdd.Item(j));
+					relativeFileName = getOnlyFileName(pipeReleasesToAdd.Item(j), context);
 				else
 					relativeFileName = pipeReleasesToAdd.Item(j);
 
@@ -1283,13 +1304,13 @@ void Rank::addReleasesToPipes(
 			}
 		}
 
-		pipeReleases.Empty();
 		pipeReleasesToAdd.Empty();
 		count++;
 	}
 }
 
 void Rank::clearAllPipes() {
+	loadPipes();
 	for (Pipe p : m_pipes) {
 		p.m_attacks.clear();
 		p.m_releases.clear();
@@ -1299,6 +1320,10 @@ void Rank::clearAllPipes() {
 }
 
 void Rank::createDummyPipes() {
+	// any pipes not yet loaded are replaced too
+	m_hasDeferredPipes = false;
+	m_deferredPipeKeys.Empty();
+	m_deferredPipeValues.Empty();
 	if (!m_pipes.empty())
 		clearAllPipes();
 
@@ -1314,6 +1339,7 @@ void Rank::createDummyPipes() {
 }
 
 void Rank::addDummyPipeFront() {
+	loadPipes();
 	Pipe p;
 	setupPipeProperties(p);
 
@@ -1324,6 +1350,7 @@ void Rank::addDummyPipeFront() {
 }
 
 void Rank::addDummyPipeBack() {
+	loadPipes();
 	Pipe p;
 	setupPipeProperties(p);
 
@@ -1334,6 +1361,7 @@ void Rank::addDummyPipeBack() {
 }
 
 bool Rank::hasOnlyDummyPipes() {
+	loadPipes();
 	for (Pipe p : m_pipes) {
 		for (Attack atk : p.m_attacks) {
 			if (atk.fileName != wxT("DUMMY"))
@@ -1344,14 +1372,17 @@ bool Rank::hasOnlyDummyPipes() {
 }
 
 void Rank::removePipeFront() {
+	loadPipes();
 	m_pipes.pop_front();
 }
 
 void Rank::removePipeBack() {
+	loadPipes();
 	m_pipes.pop_back();
 }
 
 void Rank::clearPipeAt(unsigned index) {
+	loadPipes();
 	auto iterator = std::next(m_pipes.begin(), index);
 	(*iterator).m_attacks.clear();
 	(*iterator).m_releases.clear();
@@ -1362,22 +1393,24 @@ void Rank::clearPipeAt(unsigned index) {
 }
 
 void Rank::emptyPipeAt(unsigned index) {
+	loadPipes();
 	auto iterator = std::next(m_pipes.begin(), index);
 	(*iterator).m_attacks.clear();
 	(*iterator).m_releases.clear();
 }
 
-void Rank::createNewAttackInPipe(unsigned index, wxString filePath, bool loadRelease) {
+void Rank::createNewAttackInPipe(unsigned index, wxString filePath, bool loadRelease, OrganContext &context) {
+	loadPipes();
 	auto iterator = std::next(m_pipes.begin(), index);
 
 	bool organRootPathIsSet = false;
 
-	if (::wxGetApp().m_frame->m_organ->getOdfRoot() != wxEmptyString)
+	if (context.getOrgan()->getOdfRoot() != wxEmptyString)
 		organRootPathIsSet = true;
 
 	wxString relativeFileName;
 	if (organRootPathIsSet)
-		relativeFileName = getOnlyFileName(filePath);
+		relativeFileName = getOnlyFileName(filePath, context);
 	else
 		relativeFileName = filePath;
 
@@ -1395,17 +1428,18 @@ void Rank::createNewAttackInPipe(unsigned index, wxString filePath, bool loadRel
 	(*iterator).m_attacks.push_back(a);
 }
 
-void Rank::createNewReleaseInPipe(unsigned index, wxString filePath, bool extractKeyPressTime) {
+void Rank::createNewReleaseInPipe(unsigned index, wxString filePath, bool extractKeyPressTime, OrganContext &context) {
+	loadPipes();
 	auto iterator = std::next(m_pipes.begin(), index);
 
 	bool organRootPathIsSet = false;
 
-	if (::wxGetApp().m_frame->m_organ->getOdfRoot() != wxEmptyString)
+	if (context.getOrgan()->getOdfRoot() != wxEmptyString)
 		organRootPathIsSet = true;
 
 	wxString relativeFileName;
 	if (organRootPathIsSet)
-		relativeFileName = getOnlyFileName(filePath);
+		relativeFileName = getOnlyFileName(filePath, context);
 	else
 		relativeFileName = filePath;
 
@@ -1443,6 +1477,7 @@ void Rank::createNewReleaseInPipe(unsigned index, wxString filePath, bool extrac
 }
 
 bool Rank::deleteAttackInPipe(unsigned pipeIndex, unsigned attackIndex) {
+	loadPipes();
 	auto pipeIt = std::next(m_pipes.begin(), pipeIndex);
 	auto atkIt = std::next((*pipeIt).m_attacks.begin(), attackIndex);
 
@@ -1455,6 +1490,7 @@ bool Rank::deleteAttackInPipe(unsigned pipeIndex, unsigned attackIndex) {
 }
 
 void Rank::deleteReleaseInPipe(unsigned pipeIndex, unsigned releaseIndex) {
+	loadPipes();
 	auto pipeIt = std::next(m_pipes.begin(), pipeIndex);
 	auto relIt = std::next((*pipeIt).m_releases.begin(), releaseIndex);
 
@@ -1462,31 +1498,17 @@ void Rank::deleteReleaseInPipe(unsigned pipeIndex, unsigned releaseIndex) {
 }
 
 Pipe* Rank::getPipeAt(unsigned index) {
+	loadPipes();
 	auto iterator = std::next(m_pipes.begin(), index);
 	return &(*iterator);
 }
 
-void Rank::fillArrayStringWithFiles(wxDir &root, wxString path, wxArrayString &list, int theCount, int firstMatchingNbr) {
-	root.GetAllFiles(
-		path,
-		&list,
-		wxString::Format(wxT("*%i*.*"), (theCount + firstMatchingNbr)),
-		wxDIR_FILES
-	);
+void Rank::fillArrayStringWithFiles(SampleNameMatcher &matcher, wxString path, wxArrayString &list, int midiNumber) {
+	WX_APPEND_ARRAY(list, matcher.getSampleFiles(path, midiNumber));
 }
 
-void Rank::onlyAddWaveFiles(wxArrayString &source, wxArrayString &selection) {
-	if (!source.IsEmpty()) {
-		for (unsigned n = 0; n < source.GetCount(); n++) {
-			wxString suffix = source.Item(n).AfterLast('.');
-			if (suffix.CmpNoCase(wxT("wav")) == 0 || suffix.CmpNoCase(wxT("wv")) == 0)
-				selection.Add(source.Item(n));
-		}
-	}
-}
-
-wxString Rank::getOnlyFileName(wxString path) {
-	return GOODF_functions::removeBaseOdfPath(path);
+wxString Rank::getOnlyFileName(wxString path, OrganContext &context) {
+	return GOODF_functions::removeBaseOdfPath(path, context);
 }
 
 void Rank::setupPipeProperties(Pipe &pipe) {
@@ -1506,30 +1528,29 @@ void Rank::setupPipeProperties(Pipe &pipe) {
 	pipe.maxVelocityVolume = this->maxVelocityVolume;
 }
 
-void Rank::exactlyMatchMidiNumber(wxArrayString &fileList, int midiNbr) {
-	// incoming fileList contains full paths to candidate files
-	// but in this function we're interested only in the file name
-	// we get it by converting path to wxFileName and then extracting the name part
-	// and matching against this regular expression
-	wxRegEx midiRegEx = wxRegEx(wxString::Format(wxT("^([0[:alpha:]]*)(%i)([^[:digit:]]*[-._])"), midiNbr));
-
-	if (!fileList.IsEmpty()) {
-		for (int i = fileList.size() - 1; i >= 0; i--) {
-			wxFileName whole_path(fileList[i]);
-			if (!midiRegEx.Matches(whole_path.GetFullName())) {
-				fileList.RemoveAt(i);
-			}
-		}
+void Rank::updatePipeRelativePaths(OrganContext &context) {
+	loadPipes();
+	for (Pipe& p : m_pipes) {
+		p.updateRelativePaths(context);
 	}
 }
 
-void Rank::updatePipeRelativePaths() {
-	for (Pipe& p : m_pipes) {
-		p.updateRelativePaths();
+void Rank::readPipeEntries(wxFileConfig *cfg, Organ *readOrgan) {
+	bool hadUnusualTremulants = false;
+	for (int i = 0; i < numberOfLogicalPipes; i++) {
+		Pipe p;
+		wxString pipeNbr = wxT("Pipe") + GOODF_functions::number_format(i + 1);
+		p.read(cfg, pipeNbr, this, readOrgan);
+		m_pipes.push_back(p);
+		if (p.hasUnusualTremulants()) {
+			hadUnusualTremulants = true;
+		}
+	}
+	if (hadUnusualTremulants) {
+		logTremulantMessage();
 	}
 }
 
 void Rank::logTremulantMessage() {
-	wxLogError("An unusual use of pipe tremulant settings in %s.  See help for common Tremulant examples", getName());
-	::wxGetApp().m_frame->GetLogWindow()->Show(true);
+	OrganContext::current()->logError(wxString::Format("An unusual use of pipe tremulant settings in %s.  See help for common Tremulant examples", getName()));
 }
@@ -23,12 +23,15 @@
 
 #include "Pipe.h"
 #include "Windchestgroup.h"
+#include "SectionCache.h"
 #include <list>
 #include <wx/textfile.h>
 #include <wx/dir.h>
 #include <wx/fileconf.h>
 
 class Organ;
+class OrganContext;
+class SampleNameMatcher;
 
 class Rank {
 public:
@@ -38,7 +41,13 @@ public:
 
 	void write(wxTextFile *outFile);
 	void writeFromStop(wxTextFile *outFile);
-	void read(wxFileConfig *cfg, Organ *readOrgan);
+	// With deferPipes the pipe entries are only kept. The config lists entries
+	// sorted, so pipeEntryOrder can give their order in the file to write
+	// them back unchanged if the pipes are never loaded.
+	void read(wxFileConfig *cfg, Organ *readOrgan, bool deferPipes = false, const wxArrayString *pipeEntryOrder = NULL);
+	bool hasDeferredPipes() const;
+	void loadPipes();
+	bool hasDeferredLegacyXfades();
 
 	bool doesAcceptsRetuning() const;
 	void setAcceptsRetuning(bool acceptsRetuning);
@@ -83,7 +92,8 @@ public:
 		bool loadPipesAsTremOff,
 		int startPipeIdx,
 		int firstMatchingNumber,
-		int totalNbrOfPipes
+		int totalNbrOfPipes,
+		OrganContext &context
 	);
 	void addToPipes(
 		wxString extraAttackFolder,
@@ -95,7 +105,8 @@ public:
 		bool loadPipesAsTremOff,
 		int startPipeIdx,
 		int firstMatchingNumber,
-		int totalNbrOfPipes
+		int totalNbrOfPipes,
+		OrganContext &context
 	);
 	void addTremulantToPipes(
 		wxString extraAttackFolder,
@@ -105,13 +116,15 @@ public:
 		bool extractKeyPressTime,
 		int startPipeIdx,
 		int firstMatchingNumber,
-		int totalNbrOfPipes
+		int totalNbrOfPipes,
+		OrganContext &context
 	);
 	void addReleasesToPipes(
 		bool loadPipesAsTremOff,
 		int startPipeIdx,
 		int firstMatchingNumber,
-		int totalNbrOfPipes
+		int totalNbrOfPipes,
+		OrganContext &context
 	);
 	void clearAllPipes();
 	void createDummyPipes();
@@ -122,14 +135,15 @@ public:
 	void removePipeBack();
 	void clearPipeAt(unsigned index);
 	void emptyPipeAt(unsigned index);
-	void createNewAttackInPipe(unsigned index, wxString filePath, bool loadRelease);
-	void createNewReleaseInPipe(unsigned index, wxString filePath, bool extractKeyPressTime);
+	void createNewAttackInPipe(unsigned index, wxString filePath, bool loadRelease, OrganContext &context);
+	void createNewReleaseInPipe(unsigned index, wxString filePath, bool extractKeyPressTime, OrganContext &context);
 	bool deleteAttackInPipe(unsigned pipeIndex, unsigned attackIndex);
 	void deleteReleaseInPipe(unsigned pipeIndex, unsigned releaseIndex);
 	Pipe* getPipeAt(unsigned index);
-	void updatePipeRelativePaths();
+	void updatePipeRelativePaths(OrganContext &context);
 
 	std::list<Pipe> m_pipes;
+	SectionCache m_sectionCache;
 
 protected:
 	wxString name;
@@ -148,13 +162,17 @@ protected:
 	float maxVelocityVolume;
 	bool acceptsRetuning;
 	wxString m_latestPipesRootPath;
+	// Pipe entries kept as read until the pipes are first needed
+	wxArrayString m_deferredPipeKeys;
+	wxArrayString m_deferredPipeValues;
+	Organ *m_deferredPipesOrgan;
+	bool m_hasDeferredPipes;
 
-	void fillArrayStringWithFiles(wxDir &root, wxString path, wxArrayString &list, int theCount, int firstMatchingNbr);
-	void onlyAddWaveFiles(wxArrayString &source, wxArrayString &selection);
-	wxString getOnlyFileName(wxString path);
+	void fillArrayStringWithFiles(SampleNameMatcher &matcher, wxString path, wxArrayString &list, int midiNumber);
+	wxString getOnlyFileName(wxString path, OrganContext &context);
 	void setupPipeProperties(Pipe &pipe);
-	void exactlyMatchMidiNumber(wxArrayString &fileList, int midiNbr);
 	void logTremulantMessage();
+	void readPipeEntries(wxFileConfig *cfg, Organ *readOrgan);
 };
 
 #endif
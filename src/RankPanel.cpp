@@ -37,6 +37,13 @@
 #include "WAVfileParser.h"
 #include "SampleFileInfoDialog.h"
 #include "DoubleEntryDialog.h"
+#include "LoopAnalyzer.h"
+#include "LoopQualityDialog.h"
+#include "PitchDetector.h"
+#include "LoopFinder.h"
+#include "EnvelopeDialog.h"
+#include "LoudnessDialog.h"
+#include "AuditionDialog.h"
 #include <cmath>
 
 // Event table
@@ -47,6 +54,7 @@ BEGIN_EVENT_TABLE(RankPanel, wxPanel)
 	EVT_SPINCTRL(ID_RANK_LOGICAL_PIPES_SPIN, RankPanel::OnLogicalPipeSpin)
 	EVT_SPINCTRL(ID_RANK_HARMONIC_NBR_SPIN, RankPanel::OnHarmonicNbrSpin)
 	EVT_BUTTON(ID_RANK_SET_HN_FROM_PITCH_BTN, RankPanel::OnSetHarmonicNbrBtn)
+	EVT_BUTTON(ID_RANK_DETECT_PITCH_BTN, RankPanel::OnDetectPitchBtn)
 	EVT_SPINCTRLDOUBLE(ID_RANK_PITCH_CORR_SPIN, RankPanel::OnPitchCorrectionSpin)
 	EVT_RADIOBUTTON(ID_RANK_PERCUSSIVE_YES, RankPanel::OnPercussiveSelection)
 	EVT_RADIOBUTTON(ID_RANK_PERCUSSIVE_NO, RankPanel::OnPercussiveSelection)
@@ -67,6 +75,12 @@ BEGIN_EVENT_TABLE(RankPanel, wxPanel)
 	EVT_BUTTON(ID_RANK_ADD_PIPES_BTN, RankPanel::OnAddPipesBtn)
 	EVT_BUTTON(ID_RANK_ADD_TREMULANT_PIPES_BTN, RankPanel::OnAddTremulantPipesBtn)
 	EVT_BUTTON(ID_RANK_EXPAND_TREE_BTN, RankPanel::OnExpandTreeBtn)
+	EVT_BUTTON(ID_RANK_CHECK_LOOPS_BTN, RankPanel::OnCheckLoopsBtn)
+	EVT_BUTTON(ID_RANK_FIND_LOOPS_BTN, RankPanel::OnFindLoopsBtn)
+	EVT_BUTTON(ID_RANK_DETECT_ENVELOPE_BTN, RankPanel::OnDetectEnvelopeBtn)
+	EVT_BUTTON(ID_RANK_LOUDNESS_BTN, RankPanel::OnLoudnessBtn)
+	EVT_BUTTON(ID_RANK_RENDER_AUDITIONS_BTN, RankPanel::OnRenderAuditionsBtn)
+	EVT_BUTTON(ID_RANK_EXPORT_TRIMMED_BTN, RankPanel::OnExportTrimmedBtn)
 	EVT_BUTTON(ID_RANK_ADD_RELEASES_BTN, RankPanel::OnAddReleaseSamplesBtn)
 	EVT_TREE_KEY_DOWN(ID_RANK_PIPE_TREE, RankPanel::OnTreeKeyboardInput)
 	EVT_BUTTON(ID_RANK_FLEXIBLE_PIPE_LOADING_BTN, RankPanel::OnFlexiblePipeLoadingBtn)
@@ -172,6 +186,12 @@ RankPanel::RankPanel(wxWindow *parent) : wxPanel(parent) {
 		wxT("Calculate HN")
 	);
 	thirdRow->Add(setHarmonicNbrFromEmbeddedPitchBtn, 0, wxALIGN_CENTER_VERTICAL|wxALL, 5);
+	m_detectPitchBtn = new wxButton(
+		this,
+		ID_RANK_DETECT_PITCH_BTN,
+		wxT("Detect pitch")
+	);
+	thirdRow->Add(m_detectPitchBtn, 0, wxALIGN_CENTER_VERTICAL|wxALL, 5);
 	wxStaticText *harmonicNumberText = new wxStaticText (
 		this,
 		wxID_STATIC,
@@ -358,6 +378,42 @@ RankPanel::RankPanel(wxWindow *parent) : wxPanel(parent) {
 		wxT("Expand the pipe tree")
 	);
 	sixthRow->Add(m_expandTreeBtn, 0, wxALIGN_CENTER_VERTICAL|wxALL, 5);
+	m_checkLoopsBtn = new wxButton(
+		this,
+		ID_RANK_CHECK_LOOPS_BTN,
+		wxT("Check loops")
+	);
+	sixthRow->Add(m_checkLoopsBtn, 0, wxALIGN_CENTER_VERTICAL|wxALL, 5);
+	m_findLoopsBtn = new wxButton(
+		this,
+		ID_RANK_FIND_LOOPS_BTN,
+		wxT("Find loops")
+	);
+	sixthRow->Add(m_findLoopsBtn, 0, wxALIGN_CENTER_VERTICAL|wxALL, 5);
+	m_detectEnvelopeBtn = new wxButton(
+		this,
+		ID_RANK_DETECT_ENVELOPE_BTN,
+		wxT("Detect cue points...")
+	);
+	sixthRow->Add(m_detectEnvelopeBtn, 0, wxALIGN_CENTER_VERTICAL|wxALL, 5);
+	m_loudnessBtn = new wxButton(
+		this,
+		ID_RANK_LOUDNESS_BTN,
+		wxT("Balance loudness...")
+	);
+	sixthRow->Add(m_loudnessBtn, 0, wxALIGN_CENTER_VERTICAL|wxALL, 5);
+	m_renderAuditionsBtn = new wxButton(
+		this,
+		ID_RANK_RENDER_AUDITIONS_BTN,
+		wxT("Render auditions...")
+	);
+	sixthRow->Add(m_renderAuditionsBtn, 0, wxALIGN_CENTER_VERTICAL|wxALL, 5);
+	m_exportTrimmedBtn = new wxButton(
+		this,
+		ID_RANK_EXPORT_TRIMMED_BTN,
+		wxT("Export trimmed...")
+	);
+	sixthRow->Add(m_exportTrimmedBtn, 0, wxALIGN_CENTER_VERTICAL|wxALL, 5);
 	sixthRow->AddStretchSpacer();
 	wxStaticText *isPercussiveText = new wxStaticText (
 		this,
@@ -603,6 +659,7 @@ RankPanel::~RankPanel() {
 
 void RankPanel::setRank(Rank *rank) {
 	m_rank = rank;
+	m_rank->loadPipes();
 	m_lastReferencedManual = -1;
 	m_lastReferencedStop = -1;
 
@@ -708,6 +765,13 @@ void RankPanel::setTooltipsEnabled(bool isEnabled) {
 		m_addReleaseSamplesBtn->SetToolTip(wxT("Use this button to add separate releases to the rank, it doesn't remove existing samples. This can be useful if the release samples are placed somewhere else than the other samples."));
 		m_flexiblePipeLoadingBtn->SetToolTip(wxT("Use this button to auto load samples for the rank with more fexibility than the other buttons allow."));
 		m_pipeTreeCtrl->SetToolTip(wxT("The pipe tree pipe(s), attacks and releases can be right clicked to bring up a pop-up menu."));
+		m_detectPitchBtn->SetToolTip(wxT("Find the pitch of the first attack of every pipe whose sample has no pitch information (smpl chunk) from the audio, and set MIDIKeyNumber and MIDIPitchFraction of the pipe from it."));
+		m_checkLoopsBtn->SetToolTip(wxT("Analyze the loops of all attacks in the rank for clicks. The result is shown after each attack in the pipe tree."));
+		m_detectEnvelopeBtn->SetToolTip(wxT("Propose AttackStart, CuePoint and ReleaseEnd values for the samples of the rank from their envelopes, and apply them all at once."));
+		m_loudnessBtn->SetToolTip(wxT("Measure the loudness of the sustain of every pipe and suggest Gain values that make the loudness of the rank change smoothly from pipe to pipe."));
+		m_findLoopsBtn->SetToolTip(wxT("Search the sustain of every attack that has no loops, neither in the .organ file nor in the sample, and add the best loop found to it."));
+		m_renderAuditionsBtn->SetToolTip(wxT("Write a .wav file per pipe of what holding the key sounds like: the first attack through its loops with their crossfades and then into a release."));
+		m_exportTrimmedBtn->SetToolTip(wxT("Write copies of the samples of the rank without the audio before AttackStart and after ReleaseEnd, with their loops and cue points moved along, and use them instead of the original samples."));
 	} else {
 		m_nameField->SetToolTip(wxEmptyString);
 		m_firstMidiNoteNumberSpin->SetToolTip(wxEmptyString);
@@ -740,6 +804,13 @@ void RankPanel::setTooltipsEnabled(bool isEnabled) {
 		m_addReleaseSamplesBtn->SetToolTip(wxEmptyString);
 		m_flexiblePipeLoadingBtn->SetToolTip(wxEmptyString);
 		m_pipeTreeCtrl->SetToolTip(wxEmptyString);
+		m_detectPitchBtn->SetToolTip(wxEmptyString);
+		m_checkLoopsBtn->SetToolTip(wxEmptyString);
+		m_findLoopsBtn->SetToolTip(wxEmptyString);
+		m_detectEnvelopeBtn->SetToolTip(wxEmptyString);
+		m_loudnessBtn->SetToolTip(wxEmptyString);
+		m_renderAuditionsBtn->SetToolTip(wxEmptyString);
+		m_exportTrimmedBtn->SetToolTip(wxEmptyString);
 	}
 }
 
@@ -803,7 +874,7 @@ void RankPanel::OnNameChange(wxCommandEvent& WXUNUSED(event)) {
 	m_rank->setName(m_nameField->GetValue());
 	wxString updatedLabel = m_nameField->GetValue();
 	::wxGetApp().m_frame->OrganTreeChildItemLabelChanged(updatedLabel);
-	::wxGetApp().m_frame->m_organ->setModified(true);
+	::wxGetApp().m_frame->m_organ->setSectionModified(m_rank);
 }
 
 void RankPanel::OnWindchestChoice(wxCommandEvent& WXUNUSED(event)) {
@@ -852,7 +923,7 @@ void RankPanel::OnWindchestChoice(wxCommandEvent& WXUNUSED(event)) {
 			}
 		}
 
-		::wxGetApp().m_frame->m_organ->setModified(true);
+		::wxGetApp().m_frame->m_organ->setSectionModified(m_rank);
 	}
 }
 
@@ -892,7 +963,7 @@ void RankPanel::OnMidiNoteSpin(wxSpinEvent& WXUNUSED(event)) {
 			UpdatePipeTree();
 		}
 	}
-	::wxGetApp().m_frame->m_organ->setModified(true);
+	::wxGetApp().m_frame->m_organ->setSectionModified(m_rank);
 }
 
 void RankPanel::OnLogicalPipeSpin(wxSpinEvent& WXUNUSED(event)) {
@@ -930,20 +1001,20 @@ void RankPanel::OnLogicalPipeSpin(wxSpinEvent& WXUNUSED(event)) {
 	if (theParent) {
 		theParent->internalRankLogicalPipesChanged(m_rank->getNumberOfLogicalPipes());
 	}
-	::wxGetApp().m_frame->m_organ->setModified(true);
+	::wxGetApp().m_frame->m_organ->setSectionModified(m_rank);
 }
 
 void RankPanel::OnHarmonicNbrSpin(wxSpinEvent& WXUNUSED(event)) {
 	int harmonicNbr = m_harmonicNumberSpin->GetValue();
 	m_rank->setHarmonicNumber(harmonicNbr);
 	m_calculatedLength->SetLabelText(GOODF_functions::getFootLengthSize(harmonicNbr));
-	::wxGetApp().m_frame->m_organ->setModified(true);
+	::wxGetApp().m_frame->m_organ->setSectionModified(m_rank);
 }
 
 void RankPanel::OnSetHarmonicNbrBtn(wxCommandEvent& WXUNUSED(event)) {
 	DoubleEntryDialog referencePitchDlg(
 		this,
-		wxT("Embedded pitch info in the first attack plus any PitchTuning for every pipe in this rank\nwill be compared against reference pitch and expected MIDI number\nto set the HarmonicNumber for each pipe in this rank (and the rank itself).\n\nThus you should make sure to have adjusted PitchTuning properly for the pipes\nespecially if samples are re-used for extension of compass."),
+		wxT("Embedded pitch info in the first attack (or its detected pitch if it has none) plus any PitchTuning for every pipe in this rank\nwill be compared against reference pitch and expected MIDI number\nto set the HarmonicNumber for each pipe in this rank (and the rank itself).\n\nThus you should make sure to have adjusted PitchTuning properly for the pipes\nespecially if samples are re-used for extension of compass."),
 		wxT("8' reference pitch for a1 (A4) in Hz"),
 		440,
 		220,
@@ -953,47 +1024,77 @@ void RankPanel::OnSetHarmonicNbrBtn(wxCommandEvent& WXUNUSED(event)) {
 	);
 	if (referencePitchDlg.ShowModal() == wxID_OK && referencePitchDlg.TransferDataFromWindow()) {
 		double referencePitch = referencePitchDlg.GetValue();
+
+		// samples without embedded pitch info get their pitch detected
+		std::vector<PitchDetector::PIPE_PITCH> pitches;
+		bool completed = GOODF_functions::runWithProgress(this, wxT("Finding pitches"), wxT("Finding the pitch of the pipes in ") + m_rank->getName(), false, [&](const std::function<bool(size_t, size_t)> &progress) {
+			return PitchDetector::detectRankPitches(m_rank, true, pitches, progress);
+		});
+		if (!completed)
+			return;
+
 		int pipeMIDInote = m_rank->getFirstMidiNoteNumber();
 		bool foundFirstHarmonicNbr = false;
+		unsigned pipeIndex = 0;
 		for (auto& p : m_rank->m_pipes) {
-			if (p.isFirstAttackRefPath()) {
-				pipeMIDInote++;
-				continue;
-			}
-			for (auto& atk : p.m_attacks) {
-				if (atk.fullPath.IsSameAs(wxT("DUMMY"))) {
-					pipeMIDInote++;
-					continue;
-				} else {
-					WAVfileParser atkFile(atk.fullPath);
-					if (atkFile.isWavOk()) {
-						double embeddedPitch = atkFile.getPitchInHz();
-						double effectivePitch = embeddedPitch * pow(2, (p.pitchTuning / 1200.0));
-						double expectedEightFootPitch = referencePitch * pow(2, ((double)(pipeMIDInote - 69) / 12.0));
-						double pitchRatio = effectivePitch / expectedEightFootPitch;
-						int harmonicNbr = round(8.0f * pitchRatio);
-						p.harmonicNumber = harmonicNbr;
-						if (!foundFirstHarmonicNbr) {
-							m_rank->setHarmonicNumber(harmonicNbr);
-							foundFirstHarmonicNbr = true;
-						}
-						break;
-					}
+			if (pitches[pipeIndex].isFound) {
+				double effectivePitch = pitches[pipeIndex].pitchInHz * pow(2, (p.pitchTuning / 1200.0));
+				double expectedEightFootPitch = referencePitch * pow(2, ((double)(pipeMIDInote - 69) / 12.0));
+				double pitchRatio = effectivePitch / expectedEightFootPitch;
+				int harmonicNbr = round(8.0f * pitchRatio);
+				p.harmonicNumber = harmonicNbr;
+				if (!foundFirstHarmonicNbr) {
+					m_rank->setHarmonicNumber(harmonicNbr);
+					foundFirstHarmonicNbr = true;
 				}
 			}
 			pipeMIDInote++;
+			pipeIndex++;
 		}
 		if (foundFirstHarmonicNbr) {
 			m_harmonicNumberSpin->SetValue(m_rank->getHarmonicNumber());
 			m_calculatedLength->SetLabelText(GOODF_functions::getFootLengthSize(m_rank->getHarmonicNumber()));
-			::wxGetApp().m_frame->m_organ->setModified(true);
+			::wxGetApp().m_frame->m_organ->setSectionModified(m_rank);
 		}
 	}
 }
 
+void RankPanel::OnDetectPitchBtn(wxCommandEvent& WXUNUSED(event)) {
+	std::vector<PitchDetector::PIPE_PITCH> pitches;
+	bool completed = GOODF_functions::runWithProgress(this, wxT("Detecting pitches"), wxT("Detecting the pitch of the pipes in ") + m_rank->getName(), false, [&](const std::function<bool(size_t, size_t)> &progress) {
+		return PitchDetector::detectRankPitches(m_rank, true, pitches, progress);
+	});
+	if (!completed)
+		return;
+
+	unsigned detected = 0;
+	unsigned failed = 0;
+	unsigned pipeIndex = 0;
+	for (auto& p : m_rank->m_pipes) {
+		PitchDetector::PIPE_PITCH &pitch = pitches[pipeIndex++];
+		if (pitch.isFromSampleInfo)
+			continue;
+		if (!pitch.isFound) {
+			if (!pitch.errorMessage.IsEmpty())
+				failed++;
+			continue;
+		}
+		PitchDetector::pitchToMidi(pitch.pitchInHz, p.midiKeyNumber, p.midiPitchFraction);
+		detected++;
+	}
+	if (detected)
+		::wxGetApp().m_frame->m_organ->setSectionModified(m_rank);
+
+	wxString message = wxString::Format(wxT("MIDIKeyNumber and MIDIPitchFraction were set from the detected pitch for %u pipe(s)."), detected);
+	if (failed)
+		message += wxString::Format(wxT("\nNo clear pitch could be found for %u pipe(s)."), failed);
+	wxMessageDialog msg(this, message, wxT("Pitch detection"), wxOK|wxCENTRE|wxICON_INFORMATION);
+	msg.ShowModal();
+}
+
 void RankPanel::OnPitchCorrectionSpin(wxSpinDoubleEvent& WXUNUSED(event)) {
 	m_rank->setPitchCorrection((float) m_pitchCorrectionSpin->GetValue());
-	::wxGetApp().m_frame->m_organ->setModified(true);
+	::wxGetApp().m_frame->m_organ->setSectionModified(m_rank);
 }
 
 void RankPanel::OnPercussiveSelection(wxCommandEvent& event) {
@@ -1044,7 +1145,7 @@ void RankPanel::OnPercussiveSelection(wxCommandEvent& event) {
 	}
 	RebuildPipeTree();
 	UpdatePipeTree();
-	::wxGetApp().m_frame->m_organ->setModified(true);
+	::wxGetApp().m_frame->m_organ->setSectionModified(m_rank);
 }
 
 void RankPanel::OnIndependentReleaseSelection(wxCommandEvent& event) {
@@ -1076,17 +1177,17 @@ void RankPanel::OnIndependentReleaseSelection(wxCommandEvent& event) {
 	}
 	RebuildPipeTree();
 	UpdatePipeTree();
-	::wxGetApp().m_frame->m_organ->setModified(true);
+	::wxGetApp().m_frame->m_organ->setSectionModified(m_rank);
 }
 
 void RankPanel::OnMinVelocitySpin(wxSpinDoubleEvent& WXUNUSED(event)) {
 	m_rank->setMinVelocityVolume((float) m_minVelocityVolumeSpin->GetValue());
-	::wxGetApp().m_frame->m_organ->setModified(true);
+	::wxGetApp().m_frame->m_organ->setSectionModified(m_rank);
 }
 
 void RankPanel::OnMaxVelocitySpin(wxSpinDoubleEvent& WXUNUSED(event)) {
 	m_rank->setMaxVelocityVolume((float) m_maxVelocityVolumeSpin->GetValue());
-	::wxGetApp().m_frame->m_organ->setModified(true);
+	::wxGetApp().m_frame->m_organ->setSectionModified(m_rank);
 }
 
 void RankPanel::OnRetuningSelection(wxCommandEvent& event) {
@@ -1097,7 +1198,7 @@ void RankPanel::OnRetuningSelection(wxCommandEvent& event) {
 		m_acceptsRetuningNo->SetValue(true);
 		m_rank->setAcceptsRetuning(false);
 	}
-	::wxGetApp().m_frame->m_organ->setModified(true);
+	::wxGetApp().m_frame->m_organ->setSectionModified(m_rank);
 }
 
 void RankPanel::OnReadPipesBtn(wxCommandEvent& WXUNUSED(event)) {
@@ -1141,13 +1242,14 @@ void RankPanel::OnReadPipesBtn(wxCommandEvent& WXUNUSED(event)) {
 			loadPipesTremOff,
 			0,
 			m_rank->getFirstMidiNoteNumber(),
-			m_rank->getNumberOfLogicalPipes()
+			m_rank->getNumberOfLogicalPipes(),
+			*::wxGetApp().m_frame->m_organ->getContext()
 		);
 
 		RebuildPipeTree();
 		UpdatePipeTree();
 	}
-	::wxGetApp().m_frame->m_organ->setModified(true);
+	::wxGetApp().m_frame->m_organ->setSectionModified(m_rank);
 }
 
 void RankPanel::OnRemoveRankBtn(wxCommandEvent& WXUNUSED(event)) {
@@ -1179,7 +1281,7 @@ void RankPanel::OnClearPipesBtn(wxCommandEvent& WXUNUSED(event)) {
 		m_rank->createDummyPipes();
 		RebuildPipeTree();
 		UpdatePipeTree();
-		::wxGetApp().m_frame->m_organ->setModified(true);
+		::wxGetApp().m_frame->m_organ->setSectionModified(m_rank);
 	}
 }
 
@@ -1213,6 +1315,7 @@ void RankPanel::OnPipeTreeItemRightClick(wxTreeEvent &evt) {
 		// for an attack
 		mnu.Append(ID_PIPE_MENU_EDIT_ATTACK, "Edit attack properties\tCtrl+E");
 		mnu.Append(ID_PIPE_MENU_VIEW_ATTACK_SAMPLE_DETAILS, "View sample file details\tCtrl+D");
+		mnu.Append(ID_PIPE_MENU_RENDER_AUDITION, "Render audition...");
 		mnu.Append(ID_PIPE_MENU_REMOVE_SELECTED_ATTACK, "Delete attack\tDel");
 		showMenu = true;
 	} else if (m_pipeTreeCtrl->GetItemText(m_pipeTreeCtrl->GetItemParent(selectedItem)) == wxT("Release(s)")) {
@@ -1264,6 +1367,9 @@ void RankPanel::OnPopupMenuClick(wxCommandEvent &evt) {
 		case ID_PIPE_MENU_VIEW_ATTACK_SAMPLE_DETAILS:
 			OnViewAttackSample();
 			break;
+		case ID_PIPE_MENU_RENDER_AUDITION:
+			OnRenderAttackAudition();
+			break;
 		case ID_PIPE_MENU_VIEW_RELEASE_SAMPLE_DETAILS:
 			OnViewReleaseSample();
 			break;
@@ -1402,7 +1508,7 @@ void RankPanel::OnAddNewAttack() {
 		return;
 
 	bool loadRelease = m_optionsLoadReleaseInAttack->GetValue();
-	m_rank->createNewAttackInPipe(pipeIndex, attackPath, loadRelease);
+	m_rank->createNewAttackInPipe(pipeIndex, attackPath, loadRelease, *::wxGetApp().m_frame->m_organ->getContext());
 
 	RebuildPipeTree();
 	UpdatePipeTree();
@@ -1414,7 +1520,7 @@ void RankPanel::OnAddNewAttack() {
 	}
 
 	m_rank->setPipesRootPath(fileDialog.GetDirectory());
-	::wxGetApp().m_frame->m_organ->setModified(true);
+	::wxGetApp().m_frame->m_organ->setSectionModified(m_rank);
 }
 
 void RankPanel::OnAddNewRelease() {
@@ -1451,7 +1557,7 @@ void RankPanel::OnAddNewRelease() {
 		return;
 
 	bool extractKeyPressTime = m_optionsKeyPressTime->GetValue();
-	m_rank->createNewReleaseInPipe(pipeIndex, releasePath, extractKeyPressTime);
+	m_rank->createNewReleaseInPipe(pipeIndex, releasePath, extractKeyPressTime, *::wxGetApp().m_frame->m_organ->getContext());
 
 	RebuildPipeTree();
 	UpdatePipeTree();
@@ -1463,7 +1569,7 @@ void RankPanel::OnAddNewRelease() {
 	}
 
 	m_rank->setPipesRootPath(fileDialog.GetDirectory());
-	::wxGetApp().m_frame->m_organ->setModified(true);
+	::wxGetApp().m_frame->m_organ->setSectionModified(m_rank);
 }
 
 void RankPanel::OnClearPipe() {
@@ -1481,7 +1587,7 @@ void RankPanel::OnClearPipe() {
 		m_pipeTreeCtrl->SelectItem(toSelect);
 		m_pipeTreeCtrl->ExpandAllChildren(toSelect);
 	}
-	::wxGetApp().m_frame->m_organ->setModified(true);
+	::wxGetApp().m_frame->m_organ->setSectionModified(m_rank);
 }
 
 void RankPanel::OnEditPipe() {
@@ -1491,7 +1597,9 @@ void RankPanel::OnEditPipe() {
 		isItemExpanded = true;
 
 	PipeDialog dlg(m_rank->m_pipes, (unsigned) GetSelectedItemIndexRelativeParent(), this);
+	::wxGetApp().m_frame->m_organ->beginSectionEdit(m_rank);
 	dlg.ShowModal();
+	::wxGetApp().m_frame->m_organ->endSectionEdit();
 
 	RebuildPipeTree();
 	UpdatePipeTree();
@@ -1552,7 +1660,7 @@ void RankPanel::OnCreateReference() {
 
 			RebuildPipeTree();
 			UpdatePipeTree();
-			::wxGetApp().m_frame->m_organ->setModified(true);
+			::wxGetApp().m_frame->m_organ->setSectionModified(m_rank);
 		}
 	}
 }
@@ -1563,7 +1671,10 @@ void RankPanel::OnEditAttack() {
 	Pipe *currentPipe = m_rank->getPipeAt(selectedPipeIndex);
 	AttackDialog atk_dlg(currentPipe->m_attacks, (unsigned) GetSelectedItemIndexRelativeParent(), this);
 
-	if (atk_dlg.ShowModal() == wxID_OK) {
+	::wxGetApp().m_frame->m_organ->beginSectionEdit(m_rank);
+	int dialogResult = atk_dlg.ShowModal();
+	::wxGetApp().m_frame->m_organ->endSectionEdit();
+	if (dialogResult == wxID_OK) {
 		// the user wants to copy properties of the selected attack to other
 		// attacks in the same directory
 		auto sourceAttack = std::next(atk_dlg.m_attacklist.begin(), atk_dlg.m_selectedAttackIndex);
@@ -1601,7 +1712,7 @@ void RankPanel::OnEditAttack() {
 				}
 			}
 		}
-		::wxGetApp().m_frame->m_organ->setModified(true);
+		::wxGetApp().m_frame->m_organ->setSectionModified(m_rank);
 	}
 }
 
@@ -1621,13 +1732,62 @@ void RankPanel::OnViewAttackSample() {
 	ViewSampleDetails(attackIterator->fullPath);
 }
 
+void RankPanel::OnRenderAttackAudition() {
+	wxTreeItemId selectedPipe = GetPipeOfSelection();
+	int selectedPipeIndex = GetItemIndexRelativeParent(selectedPipe);
+	Pipe *currentPipe = m_rank->getPipeAt(selectedPipeIndex);
+	int selectedAttack = GetSelectedItemIndexRelativeParent();
+
+	if (selectedAttack < 0)
+		return;
+
+	if ((unsigned) selectedAttack >= currentPipe->m_attacks.size())
+		return;
+
+	auto attackIterator = std::next(currentPipe->m_attacks.begin(), selectedAttack);
+	wxArrayString releaseNames;
+	for (Release &rel : currentPipe->m_releases)
+		releaseNames.Add(rel.fileName);
+	AuditionDialog settingsDlg(releaseNames, this);
+	if (settingsDlg.ShowModal() != wxID_OK)
+		return;
+	AuditionRenderer::RENDER_SETTINGS settings = settingsDlg.GetSettings();
+
+	wxFileDialog fileDialog(
+		this,
+		wxT("Save the audition as"),
+		wxEmptyString,
+		wxFileName(attackIterator->fullPath).GetName() + wxT("_audition.wav"),
+		"WAVE files (*.wav)|*.wav",
+		wxFD_SAVE|wxFD_OVERWRITE_PROMPT
+	);
+	if (fileDialog.ShowModal() != wxID_OK)
+		return;
+
+	Release release;
+	bool hasRelease = AuditionRenderer::chooseRelease(currentPipe, *attackIterator, settings, release);
+	wxString errorMessage;
+	bool rendered;
+	{
+		wxBusyCursor busy;
+		rendered = AuditionRenderer::renderAttack(*attackIterator, hasRelease ? &release : NULL, settings, fileDialog.GetPath(), errorMessage);
+	}
+	if (!rendered) {
+		wxMessageDialog msg(this, errorMessage, wxT("Rendering failed"), wxOK|wxCENTRE|wxICON_ERROR);
+		msg.ShowModal();
+	}
+}
+
 void RankPanel::OnEditRelease() {
 	wxTreeItemId selectedPipe = GetPipeOfSelection();
 	int selectedPipeIndex = GetItemIndexRelativeParent(selectedPipe);
 	Pipe *currentPipe = m_rank->getPipeAt(selectedPipeIndex);
 	ReleaseDialog dlg(currentPipe->m_releases, (unsigned) GetSelectedItemIndexRelativeParent(), this);
 
-	if (dlg.ShowModal() == wxID_OK) {
+	::wxGetApp().m_frame->m_organ->beginSectionEdit(m_rank);
+	int dialogResult = dlg.ShowModal();
+	::wxGetApp().m_frame->m_organ->endSectionEdit();
+	if (dialogResult == wxID_OK) {
 		// the user wants to copy properties of the selected release to other
 		// releases from the same directory
 		Release *sourceRelease = dlg.GetCurrentRelease();
@@ -1643,7 +1803,7 @@ void RankPanel::OnEditRelease() {
 				}
 			}
 		}
-		::wxGetApp().m_frame->m_organ->setModified(true);
+		::wxGetApp().m_frame->m_organ->setSectionModified(m_rank);
 	}
 }
 
@@ -1685,7 +1845,7 @@ void RankPanel::OnRemoveSelectedAttack() {
 				m_pipeTreeCtrl->SelectItem(toSelect);
 				m_pipeTreeCtrl->ExpandAllChildren(toSelect);
 			}
-			::wxGetApp().m_frame->m_organ->setModified(true);
+			::wxGetApp().m_frame->m_organ->setSectionModified(m_rank);
 		}
 	}
 }
@@ -1708,7 +1868,7 @@ void RankPanel::OnRemoveSelectedRelease() {
 		m_pipeTreeCtrl->SelectItem(toSelect);
 		m_pipeTreeCtrl->ExpandAllChildren(toSelect);
 	}
-	::wxGetApp().m_frame->m_organ->setModified(true);
+	::wxGetApp().m_frame->m_organ->setSectionModified(m_rank);
 }
 
 void RankPanel::OnCopyPipeOffset() {
@@ -1766,7 +1926,7 @@ void RankPanel::OnCopyPipeOffset() {
 				m_pipeTreeCtrl->SelectItem(toSelect);
 				m_pipeTreeCtrl->ExpandAllChildren(toSelect);
 			}
-			::wxGetApp().m_frame->m_organ->setModified(true);
+			::wxGetApp().m_frame->m_organ->setSectionModified(m_rank);
 		}
 	}
 }
@@ -1811,22 +1971,22 @@ wxTreeItemId RankPanel::GetPipeOfSelection() {
 
 void RankPanel::OnAmplitudeLevelSpin(wxSpinDoubleEvent& WXUNUSED(event)) {
 	m_rank->setAmplitudeLevel(m_amplitudeLevelSpin->GetValue());
-	::wxGetApp().m_frame->m_organ->setModified(true);
+	::wxGetApp().m_frame->m_organ->setSectionModified(m_rank);
 }
 
 void RankPanel::OnGainSpin(wxSpinDoubleEvent& WXUNUSED(event)) {
 	m_rank->setGain(m_gainSpin->GetValue());
-	::wxGetApp().m_frame->m_organ->setModified(true);
+	::wxGetApp().m_frame->m_organ->setSectionModified(m_rank);
 }
 
 void RankPanel::OnPitchTuningSpin(wxSpinDoubleEvent& WXUNUSED(event)) {
 	m_rank->setPitchTuning(m_pitchTuningSpin->GetValue());
-	::wxGetApp().m_frame->m_organ->setModified(true);
+	::wxGetApp().m_frame->m_organ->setSectionModified(m_rank);
 }
 
 void RankPanel::OnTrackerDelaySpin(wxSpinEvent& WXUNUSED(event)) {
 	m_rank->setTrackerDelay(m_trackerDelaySpin->GetValue());
-	::wxGetApp().m_frame->m_organ->setModified(true);
+	::wxGetApp().m_frame->m_organ->setSectionModified(m_rank);
 }
 
 void RankPanel::OnAddPipesBtn(wxCommandEvent& WXUNUSED(event)) {
@@ -1870,12 +2030,13 @@ void RankPanel::OnAddPipesBtn(wxCommandEvent& WXUNUSED(event)) {
 			loadPipesTremOff,
 			0,
 			m_rank->getFirstMidiNoteNumber(),
-			m_rank->getNumberOfLogicalPipes()
+			m_rank->getNumberOfLogicalPipes(),
+			*::wxGetApp().m_frame->m_organ->getContext()
 		);
 
 		RebuildPipeTree();
 		UpdatePipeTree();
-		::wxGetApp().m_frame->m_organ->setModified(true);
+		::wxGetApp().m_frame->m_organ->setSectionModified(m_rank);
 	}
 }
 
@@ -1916,12 +2077,13 @@ void RankPanel::OnAddTremulantPipesBtn(wxCommandEvent& WXUNUSED(event)) {
 			extractKeyPressTime,
 			0,
 			m_rank->getFirstMidiNoteNumber(),
-			m_rank->getNumberOfLogicalPipes()
+			m_rank->getNumberOfLogicalPipes(),
+			*::wxGetApp().m_frame->m_organ->getContext()
 		);
 
 		RebuildPipeTree();
 		UpdatePipeTree();
-		::wxGetApp().m_frame->m_organ->setModified(true);
+		::wxGetApp().m_frame->m_organ->setSectionModified(m_rank);
 	}
 }
 
@@ -1932,6 +2094,123 @@ void RankPanel::OnExpandTreeBtn(wxCommandEvent& WXUNUSED(event)) {
 	}
 }
 
+void RankPanel::OnCheckLoopsBtn(wxCommandEvent& WXUNUSED(event)) {
+	std::vector<LoopAnalyzer::ATTACK_RESULT> results;
+	std::vector<std::pair<Rank*, wxString>> ranks;
+	ranks.push_back(std::make_pair(m_rank, m_rank->getName()));
+	bool completed = GOODF_functions::runWithProgress(this, wxT("Checking loops"), wxT("Analyzing the loops of ") + m_rank->getName(), false, [&](const std::function<bool(size_t, size_t)> &progress) {
+		return LoopAnalyzer::analyzeRanks(ranks, results, progress);
+	});
+	if (!completed)
+		return;
+
+	LoopQualityDialog reportDlg(results, this);
+	reportDlg.ShowModal();
+}
+
+void RankPanel::OnFindLoopsBtn(wxCommandEvent& WXUNUSED(event)) {
+	wxMessageDialog confirm(this, wxT("The best loop found will be added to every attack of the rank that has no loops yet. Do you want to continue?"), wxT("Find loops"), wxYES_NO|wxCENTRE|wxICON_QUESTION);
+	if (confirm.ShowModal() != wxID_YES)
+		return;
+
+	std::vector<LoopFinder::ATTACK_CANDIDATES> results;
+	bool completed = GOODF_functions::runWithProgress(this, wxT("Finding loops"), wxT("Searching for loops in ") + m_rank->getName(), false, [&](const std::function<bool(size_t, size_t)> &progress) {
+		return LoopFinder::findRankLoops(m_rank, 1, true, results, progress);
+	});
+	if (!completed)
+		return;
+
+	unsigned added = 0;
+	unsigned failed = 0;
+	for (LoopFinder::ATTACK_CANDIDATES &result : results) {
+		if (result.candidates.empty()) {
+			if (!result.errorMessage.IsEmpty())
+				failed++;
+			continue;
+		}
+		Pipe *p = m_rank->getPipeAt(result.pipeIndex);
+		std::list<Attack>::iterator atk = std::next(p->m_attacks.begin(), result.attackIndex);
+		Loop l;
+		l.start = result.candidates.front().start;
+		l.end = result.candidates.front().end;
+		atk->addNewLoop(l);
+		added++;
+	}
+	if (added)
+		::wxGetApp().m_frame->m_organ->setSectionModified(m_rank);
+
+	wxString message = wxString::Format(wxT("A loop was added to %u attack(s)."), added);
+	if (failed)
+		message += wxString::Format(wxT("\nNo good loop could be found for %u attack(s)."), failed);
+	wxMessageDialog msg(this, message, wxT("Find loops"), wxOK|wxCENTRE|wxICON_INFORMATION);
+	msg.ShowModal();
+}
+
+void RankPanel::OnDetectEnvelopeBtn(wxCommandEvent& WXUNUSED(event)) {
+	EnvelopeDialog dlg(m_rank, this);
+	if (dlg.ShowModal() == wxID_OK && dlg.GetNumberOfChanges())
+		::wxGetApp().m_frame->m_organ->setSectionModified(m_rank);
+}
+
+void RankPanel::OnLoudnessBtn(wxCommandEvent& WXUNUSED(event)) {
+	std::vector<std::pair<Rank*, wxString>> ranks;
+	ranks.push_back(std::make_pair(m_rank, m_rank->getName()));
+	std::vector<LoudnessAnalyzer::PIPE_LOUDNESS> results;
+	bool completed = GOODF_functions::runWithProgress(this, wxT("Measuring loudness"), wxT("Measuring the loudness of the pipes in ") + m_rank->getName(), false, [&](const std::function<bool(size_t, size_t)> &progress) {
+		return LoudnessAnalyzer::measureRanks(ranks, results, progress);
+	});
+	if (!completed)
+		return;
+
+	LoudnessDialog dlg(&results, this);
+	if (dlg.ShowModal() == wxID_OK && dlg.GetNumberOfChanges())
+		::wxGetApp().m_frame->m_organ->setSectionModified(m_rank);
+}
+
+void RankPanel::OnRenderAuditionsBtn(wxCommandEvent& WXUNUSED(event)) {
+	AuditionDialog settingsDlg(wxArrayString(), this);
+	if (settingsDlg.ShowModal() != wxID_OK)
+		return;
+	AuditionRenderer::RENDER_SETTINGS settings = settingsDlg.GetSettings();
+
+	wxDirDialog dirDialog(
+		this,
+		wxT("Pick a directory to write the rendered pipes to"),
+		::wxGetApp().m_frame->m_organ->getOdfRoot(),
+		wxDD_DIR_MUST_EXIST
+	);
+	if (dirDialog.ShowModal() != wxID_OK)
+		return;
+
+	unsigned rankNumber = ::wxGetApp().m_frame->m_organ->getIndexOfOrganRank(m_rank);
+	std::vector<AuditionRenderer::PIPE_RENDER> results;
+	bool completed = GOODF_functions::runWithProgress(this, wxT("Rendering auditions"), wxT("Rendering the pipes of ") + m_rank->getName(), false, [&](const std::function<bool(size_t, size_t)> &progress) {
+		return AuditionRenderer::renderRank(m_rank, rankNumber, settings, dirDialog.GetPath(), results, progress);
+	});
+
+	unsigned rendered = 0;
+	wxString failures;
+	for (AuditionRenderer::PIPE_RENDER &result : results) {
+		if (result.isRendered)
+			rendered++;
+		else if (!result.errorMessage.IsEmpty())
+			failures += wxString::Format(wxT("\nPipe %u: "), result.pipeIndex + 1) + result.errorMessage.Trim();
+	}
+	wxString message = wxString::Format(wxT("%u pipe(s) were rendered to %s."), rendered, dirDialog.GetPath() + wxFILE_SEP_PATH + AuditionRenderer::getRankDirectoryName(m_rank, rankNumber));
+	if (!completed)
+		message += wxT("\nThe rendering was cancelled.");
+	if (!failures.IsEmpty())
+		message += wxT("\n") + failures;
+	wxMessageDialog msg(this, message, wxT("Render auditions"), wxOK|wxCENTRE|wxICON_INFORMATION);
+	msg.ShowModal();
+}
+
+void RankPanel::OnExportTrimmedBtn(wxCommandEvent& WXUNUSED(event)) {
+	std::vector<std::pair<Rank*, wxString>> ranks;
+	ranks.push_back(std::make_pair(m_rank, m_rank->getName()));
+	::wxGetApp().m_frame->ExportTrimmedSamples(ranks);
+}
+
 void RankPanel::OnAddReleaseSamplesBtn(wxCommandEvent& WXUNUSED(event)) {
 	wxString defaultPath;
 	if (m_rank->getPipesRootPath() != wxEmptyString)
@@ -1961,12 +2240,13 @@ void RankPanel::OnAddReleaseSamplesBtn(wxCommandEvent& WXUNUSED(event)) {
 			loadPipesTremOff,
 			0,
 			m_rank->getFirstMidiNoteNumber(),
-			m_rank->getNumberOfLogicalPipes()
+			m_rank->getNumberOfLogicalPipes(),
+			*::wxGetApp().m_frame->m_organ->getContext()
 		);
 
 		RebuildPipeTree();
 		UpdatePipeTree();
-		::wxGetApp().m_frame->m_organ->setModified(true);
+		::wxGetApp().m_frame->m_organ->setSectionModified(m_rank);
 	}
 }
 
@@ -2007,7 +2287,8 @@ void RankPanel::OnFlexiblePipeLoadingBtn(wxCommandEvent& WXUNUSED(event)) {
 					loadingDialog.GetLoadPipesTremOff(),
 					loadingDialog.GetStartingPipeNumber() - 1,
 					loadingDialog.GetFirstMidiMatchingNbr(),
-					loadingDialog.GetNbrPipesToLoad()
+					loadingDialog.GetNbrPipesToLoad(),
+					*::wxGetApp().m_frame->m_organ->getContext()
 				);
 				break;
 			case 1:
@@ -2022,7 +2303,8 @@ void RankPanel::OnFlexiblePipeLoadingBtn(wxCommandEvent& WXUNUSED(event)) {
 					loadingDialog.GetLoadPipesTremOff(),
 					loadingDialog.GetStartingPipeNumber() - 1,
 					loadingDialog.GetFirstMidiMatchingNbr(),
-					loadingDialog.GetNbrPipesToLoad()
+					loadingDialog.GetNbrPipesToLoad(),
+					*::wxGetApp().m_frame->m_organ->getContext()
 				);
 				break;
 			case 2:
@@ -2035,7 +2317,8 @@ void RankPanel::OnFlexiblePipeLoadingBtn(wxCommandEvent& WXUNUSED(event)) {
 					loadingDialog.GetExtractKeyPressTime(),
 					loadingDialog.GetStartingPipeNumber() - 1,
 					loadingDialog.GetFirstMidiMatchingNbr(),
-					loadingDialog.GetNbrPipesToLoad()
+					loadingDialog.GetNbrPipesToLoad(),
+					*::wxGetApp().m_frame->m_organ->getContext()
 				);
 				break;
 			case 3:
@@ -2044,7 +2327,8 @@ void RankPanel::OnFlexiblePipeLoadingBtn(wxCommandEvent& WXUNUSED(event)) {
 					loadingDialog.GetLoadPipesTremOff(),
 					loadingDialog.GetStartingPipeNumber() - 1,
 					loadingDialog.GetFirstMidiMatchingNbr(),
-					loadingDialog.GetNbrPipesToLoad()
+					loadingDialog.GetNbrPipesToLoad(),
+					*::wxGetApp().m_frame->m_organ->getContext()
 				);
 				break;
 			default:
@@ -2063,7 +2347,7 @@ void RankPanel::OnFlexiblePipeLoadingBtn(wxCommandEvent& WXUNUSED(event)) {
 			}
 		}
 
-		::wxGetApp().m_frame->m_organ->setModified(true);
+		::wxGetApp().m_frame->m_organ->setSectionModified(m_rank);
 	}
 }
 
@@ -57,6 +57,7 @@ private:
 	wxSpinCtrl *m_harmonicNumberSpin; // 1 - 1024, default 8, calculates 64 / rank_size
 	wxStaticText *m_calculatedLength;
 	wxButton *setHarmonicNbrFromEmbeddedPitchBtn;
+	wxButton *m_detectPitchBtn;
 	wxSpinCtrlDouble *m_pitchCorrectionSpin; // -1800 - 1800
 	wxChoice *m_windchestChoice;
 	wxRadioButton *m_isPercussiveYes;
@@ -84,6 +85,12 @@ private:
 	wxButton *m_addTremulantPipesBtn;
 	wxCheckBox *m_loadPipesAsTremOffCheck;
 	wxButton *m_expandTreeBtn;
+	wxButton *m_checkLoopsBtn;
+	wxButton *m_findLoopsBtn;
+	wxButton *m_detectEnvelopeBtn;
+	wxButton *m_loudnessBtn;
+	wxButton *m_renderAuditionsBtn;
+	wxButton *m_exportTrimmedBtn;
 	wxButton *m_addReleaseSamplesBtn;
 	wxButton *m_flexiblePipeLoadingBtn;
 
@@ -109,6 +116,7 @@ private:
 	void OnLogicalPipeSpin(wxSpinEvent& event);
 	void OnHarmonicNbrSpin(wxSpinEvent& event);
 	void OnSetHarmonicNbrBtn(wxCommandEvent& event);
+	void OnDetectPitchBtn(wxCommandEvent& event);
 	void OnPitchCorrectionSpin(wxSpinDoubleEvent& event);
 	void OnPercussiveSelection(wxCommandEvent& event);
 	void OnIndependentReleaseSelection(wxCommandEvent& event);
@@ -128,6 +136,12 @@ private:
 	void OnAddPipesBtn(wxCommandEvent& event);
 	void OnAddTremulantPipesBtn(wxCommandEvent& event);
 	void OnExpandTreeBtn(wxCommandEvent& event);
+	void OnCheckLoopsBtn(wxCommandEvent& event);
+	void OnFindLoopsBtn(wxCommandEvent& event);
+	void OnDetectEnvelopeBtn(wxCommandEvent& event);
+	void OnLoudnessBtn(wxCommandEvent& event);
+	void OnRenderAuditionsBtn(wxCommandEvent& event);
+	void OnExportTrimmedBtn(wxCommandEvent& event);
 	void OnAddReleaseSamplesBtn(wxCommandEvent& event);
 	void OnFlexiblePipeLoadingBtn(wxCommandEvent& event);
 	void OnTreeKeyboardInput(wxTreeEvent& event);
@@ -151,6 +165,7 @@ private:
 	void OnCreateReference();
 	void OnEditAttack();
 	void OnViewAttackSample();
+	void OnRenderAttackAudition();
 	void OnEditRelease();
 	void OnViewReleaseSample();
 	void OnRemoveSelectedAttack();
@@ -145,6 +145,9 @@ void ReleaseDialog::CreateControls() {
 	wxStaticLine *upperDivider = new wxStaticLine(this);
 	mainSizer->Add(upperDivider, 0, wxEXPAND);
 
+	m_waveform = new WaveformPanel(this);
+	mainSizer->Add(m_waveform, 1, wxEXPAND|wxALL, 5);
+
 	wxBoxSizer *secondRow = new wxBoxSizer(wxHORIZONTAL);
 	wxStaticText *isTremulantText = new wxStaticText (
 		this,
@@ -322,12 +325,14 @@ void ReleaseDialog::OnMaxKeyPressTimeSpin(wxSpinEvent& WXUNUSED(event)) {
 
 void ReleaseDialog::OnCuePointSpin(wxSpinEvent& WXUNUSED(event)) {
 	m_currentRelease->cuePoint = m_cuePointSpin->GetValue();
+	UpdateWaveform();
 	m_copyPropertiesBtn->Enable();
 	::wxGetApp().m_frame->m_organ->setModified(true);
 }
 
 void ReleaseDialog::OnReleaseEndSpin(wxSpinEvent& WXUNUSED(event)) {
 	m_currentRelease->releaseEnd = m_releaseEndSpin->GetValue();
+	UpdateWaveform();
 	m_copyPropertiesBtn->Enable();
 	::wxGetApp().m_frame->m_organ->setModified(true);
 }
@@ -373,4 +378,14 @@ void ReleaseDialog::TransferReleaseValuesToWindow() {
 	m_cuePointSpin->SetValue(m_currentRelease->cuePoint);
 	m_releaseEndSpin->SetValue(m_currentRelease->releaseEnd);
 	m_releaseCrossfadeSpin->SetValue(m_currentRelease->releaseCrossfadeLength);
+	UpdateWaveform();
+}
+
+void ReleaseDialog::UpdateWaveform() {
+	if (m_currentRelease->fullPath.IsSameAs(wxT("DUMMY"))) {
+		m_waveform->SetSample(wxEmptyString);
+		return;
+	}
+	m_waveform->SetSample(m_currentRelease->fullPath);
+	m_waveform->SetMarkers(0, m_currentRelease->cuePoint, m_currentRelease->releaseEnd, std::vector<std::pair<unsigned, unsigned>>());
 }
@@ -25,6 +25,7 @@
 #include <wx/spinctrl.h>
 #include "GOODFDef.h"
 #include "Release.h"
+#include "WaveformPanel.h"
 #include <list>
 
 class ReleaseDialog : public wxDialog {
@@ -83,6 +84,7 @@ private:
 	wxSpinCtrl *m_maxKeyPressTime; // -1 - 100000
 	wxSpinCtrl *m_cuePointSpin; // -1 - 158760000
 	wxSpinCtrl *m_releaseEndSpin; // -1 - 158760000
+	WaveformPanel *m_waveform;
 	wxSpinCtrl *m_releaseCrossfadeSpin; // 0-3000
 	wxButton *m_copyPropertiesBtn;
 
@@ -98,6 +100,7 @@ private:
 	Release* GetReleasePointer(unsigned index);
 	void SetButtonState();
 	void TransferReleaseValuesToWindow();
+	void UpdateWaveform();
 };
 
 #endif
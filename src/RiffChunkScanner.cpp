@@ -0,0 +1,103 @@
+/*
+ * RiffChunkScanner.cpp is part of GoOdf.
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * GoOdf is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GoOdf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GoOdf.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#include "RiffChunkScanner.h"
+#include <cstring>
+#include <algorithm>
+
+bool RiffChunkScanner::CHUNK::is(const char *chunkId) const {
+	return memcmp(id, chunkId, 4) == 0;
+}
+
+RiffChunkScanner::SCAN_RESULT RiffChunkScanner::scan(wxFFile &file, std::vector<CHUNK> &chunks) {
+	chunks.clear();
+	wxFileOffset fileLength = file.Length();
+	unsigned char header[12];
+	if (!file.Seek(0) || file.Read(header, 12) != 12)
+		return NOT_WAVE;
+	if (memcmp(header, "wvpk", 4) == 0)
+		return WAVPACK;
+	if (memcmp(header, "RIFF", 4) != 0 || memcmp(header + 8, "WAVE", 4) != 0)
+		return NOT_WAVE;
+
+	wxFileOffset offset = 12;
+	while (offset + 8 <= fileLength) {
+		unsigned char chunkHeader[8];
+		if (!file.Seek(offset) || file.Read(chunkHeader, 8) != 8)
+			break;
+		CHUNK chunk;
+		memcpy(chunk.id, chunkHeader, 4);
+		chunk.offset = offset + 8;
+		chunk.size = readUnsigned(chunkHeader + 4, 4);
+		if (chunk.offset + chunk.size > fileLength)
+			return TRUNCATED;
+		chunks.push_back(chunk);
+		offset = chunk.offset + chunk.size + (chunk.size % 2);
+	}
+	return SCAN_OK;
+}
+
+bool RiffChunkScanner::readPayload(wxFFile &file, const CHUNK &chunk, std::vector<unsigned char> &payload) {
+	payload.resize(chunk.size);
+	return file.Seek(chunk.offset) && file.Read(payload.data(), chunk.size) == chunk.size;
+}
+
+bool RiffChunkScanner::writeChunkHeader(wxFFile &file, const char *id, unsigned size) {
+	unsigned char header[8];
+	memcpy(header, id, 4);
+	writeUnsigned(header + 4, size);
+	return file.Write(header, 8) == 8;
+}
+
+bool RiffChunkScanner::writeChunk(wxFFile &file, const char *id, const std::vector<unsigned char> &payload) {
+	if (!writeChunkHeader(file, id, payload.size()) || file.Write(payload.data(), payload.size()) != payload.size())
+		return false;
+	return payload.size() % 2 == 0 || file.Write("", 1) == 1;
+}
+
+bool RiffChunkScanner::copyChunk(wxFFile &in, wxFFile &out, const CHUNK &chunk, std::vector<unsigned char> &buffer) {
+	if (!writeChunkHeader(out, chunk.id, chunk.size) || !copyRange(in, out, chunk.offset, chunk.size, buffer))
+		return false;
+	return chunk.size % 2 == 0 || out.Write("", 1) == 1;
+}
+
+bool RiffChunkScanner::copyRange(wxFFile &in, wxFFile &out, wxFileOffset offset, size_t length, std::vector<unsigned char> &buffer) {
+	if (!in.Seek(offset))
+		return false;
+	while (length > 0) {
+		size_t blockLength = std::min(length, buffer.size());
+		if (in.Read(buffer.data(), blockLength) != blockLength || out.Write(buffer.data(), blockLength) != blockLength)
+			return false;
+		length -= blockLength;
+	}
+	return true;
+}
+
+unsigned RiffChunkScanner::readUnsigned(const unsigned char *bytes, unsigned length) {
+	unsigned value = 0;
+	for (unsigned i = 0; i < length; i++)
+		value |= (unsigned) bytes[i] << (8 * i);
+	return value;
+}
+
+void RiffChunkScanner::writeUnsigned(unsigned char *bytes, unsigned value) {
+	for (unsigned i = 0; i < 4; i++)
+		bytes[i] = (value >> (8 * i)) & 0xff;
+}
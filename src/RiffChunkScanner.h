@@ -0,0 +1,63 @@
+/*
+ * RiffChunkScanner.h is part of GoOdf.
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * GoOdf is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GoOdf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GoOdf.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#ifndef RIFFCHUNKSCANNER_H
+#define RIFFCHUNKSCANNER_H
+
+#include <wx/wx.h>
+#include <wx/ffile.h>
+#include <vector>
+
+// Finds the chunks of a RIFF WAVE file from their headers only, so that
+// a writer can read the few payloads it changes and copy the others as
+// they are. Also holds the little endian helpers the readers and writers
+// of sample files share.
+class RiffChunkScanner {
+public:
+	enum SCAN_RESULT {
+		SCAN_OK = 0,
+		NOT_WAVE,
+		WAVPACK,
+		TRUNCATED
+	};
+
+	struct CHUNK {
+		char id[4];
+		// of the payload, after the chunk header
+		wxFileOffset offset;
+		unsigned size;
+
+		bool is(const char *chunkId) const;
+	};
+
+	static SCAN_RESULT scan(wxFFile &file, std::vector<CHUNK> &chunks);
+	static bool readPayload(wxFFile &file, const CHUNK &chunk, std::vector<unsigned char> &payload);
+	// The chunks are written with the pad byte of an odd size, which some
+	// writers leave out of the last chunk
+	static bool writeChunkHeader(wxFFile &file, const char *id, unsigned size);
+	static bool writeChunk(wxFFile &file, const char *id, const std::vector<unsigned char> &payload);
+	static bool copyChunk(wxFFile &in, wxFFile &out, const CHUNK &chunk, std::vector<unsigned char> &buffer);
+	static bool copyRange(wxFFile &in, wxFFile &out, wxFileOffset offset, size_t length, std::vector<unsigned char> &buffer);
+
+	static unsigned readUnsigned(const unsigned char *bytes, unsigned length);
+	static void writeUnsigned(unsigned char *bytes, unsigned value);
+};
+
+#endif
@@ -0,0 +1,329 @@
+/*
+ * SampleChunkWriter.cpp is part of GoOdf.
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * GoOdf is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GoOdf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GoOdf.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#include "SampleChunkWriter.h"
+#include "Rank.h"
+#include "WorkerPool.h"
+#include "Instrumentation.h"
+#include "GOODFFunctions.h"
+#include "OdfFileWriter.h"
+#include "RiffChunkScanner.h"
+#include <wx/ffile.h>
+#include <wx/filename.h>
+#include <map>
+#include <cmath>
+#include <algorithm>
+#ifndef __WXMSW__
+#include <sys/stat.h>
+#endif
+
+namespace {
+
+	// bytes copied at a time
+	const size_t COPY_BLOCK_SIZE = 1024 * 1024;
+	// up to and including dwSampleLoops and cbSamplerData
+	const unsigned SMPL_HEADER_SIZE = 36;
+	const unsigned SMPL_LOOP_SIZE = 24;
+
+	typedef RiffChunkScanner::CHUNK CHUNK;
+
+	void appendUnsigned(std::vector<unsigned char> &bytes, unsigned value) {
+		for (unsigned i = 0; i < 4; i++)
+			bytes.push_back((value >> (8 * i)) & 0xff);
+	}
+
+	void appendId(std::vector<unsigned char> &bytes, const char *id) {
+		bytes.insert(bytes.end(), id, id + 4);
+	}
+
+	// The smpl chunk with the loops replaced, the other fields and the
+	// sampler specific data are kept from the old chunk if there is one
+	std::vector<unsigned char> buildSmplChunk(const std::vector<unsigned char> &oldChunk, const SampleChunkWriter::SAMPLE_PATCH &patch, unsigned sampleRate) {
+		std::vector<unsigned char> chunk;
+		std::vector<unsigned char> samplerData;
+		if (oldChunk.size() >= SMPL_HEADER_SIZE) {
+			chunk.assign(oldChunk.begin(), oldChunk.begin() + 28);
+			size_t oldLoopsEnd = SMPL_HEADER_SIZE + (size_t) RiffChunkScanner::readUnsigned(&oldChunk[28], 4) * SMPL_LOOP_SIZE;
+			size_t samplerDataSize = RiffChunkScanner::readUnsigned(&oldChunk[32], 4);
+			if (oldLoopsEnd < oldChunk.size())
+				samplerData.assign(oldChunk.begin() + oldLoopsEnd, oldChunk.begin() + std::min(oldChunk.size(), oldLoopsEnd + samplerDataSize));
+		} else {
+			// manufacturer and product
+			appendUnsigned(chunk, 0);
+			appendUnsigned(chunk, 0);
+			appendUnsigned(chunk, sampleRate ? (unsigned) (1000000000.0 / sampleRate + 0.5) : 0);
+			appendUnsigned(chunk, patch.midiUnityNote);
+			appendUnsigned(chunk, patch.midiPitchFraction > 0 ? (unsigned) std::min(patch.midiPitchFraction / 100.0 * 4294967296.0, 4294967295.0) : 0);
+			// no SMPTE format and offset
+			appendUnsigned(chunk, 0);
+			appendUnsigned(chunk, 0);
+		}
+		appendUnsigned(chunk, patch.loops.size());
+		appendUnsigned(chunk, samplerData.size());
+		for (unsigned i = 0; i < patch.loops.size(); i++) {
+			// cue point id, forward loop, start, end, fraction and endless play count
+			appendUnsigned(chunk, i);
+			appendUnsigned(chunk, 0);
+			appendUnsigned(chunk, patch.loops[i].start);
+			appendUnsigned(chunk, patch.loops[i].end);
+			appendUnsigned(chunk, 0);
+			appendUnsigned(chunk, 0);
+		}
+		chunk.insert(chunk.end(), samplerData.begin(), samplerData.end());
+		return chunk;
+	}
+
+	std::vector<unsigned char> buildCueChunk(unsigned cuePoint) {
+		std::vector<unsigned char> chunk;
+		appendUnsigned(chunk, 1);
+		// id, play order position, data chunk, chunk start, block start
+		// and the offset in frames
+		appendUnsigned(chunk, 1);
+		appendUnsigned(chunk, 0);
+		appendId(chunk, "data");
+		appendUnsigned(chunk, 0);
+		appendUnsigned(chunk, 0);
+		appendUnsigned(chunk, cuePoint);
+		return chunk;
+	}
+
+	bool writePatchedFile(wxFFile &in, const std::vector<CHUNK> &chunks, const std::vector<unsigned char> *smpl, const std::vector<unsigned char> *cue, const wxString &path) {
+		wxFFile out;
+		{
+			wxLogNull noLog;
+			if (!out.Open(path, wxT("wb")))
+				return false;
+		}
+		std::vector<unsigned char> buffer(COPY_BLOCK_SIZE);
+		// the RIFF size is written when it's known
+		if (out.Write("RIFF\0\0\0\0WAVE", 12) != 12)
+			return false;
+		bool smplWritten = false;
+		bool cueWritten = false;
+		for (const CHUNK &chunk : chunks) {
+			bool ok;
+			if (smpl && chunk.is("smpl")) {
+				// the first one is replaced and any others dropped
+				ok = smplWritten || RiffChunkScanner::writeChunk(out, "smpl", *smpl);
+				smplWritten = true;
+			} else if (cue && chunk.is("cue ")) {
+				ok = cueWritten || RiffChunkScanner::writeChunk(out, "cue ", *cue);
+				cueWritten = true;
+			} else {
+				ok = RiffChunkScanner::copyChunk(in, out, chunk, buffer);
+			}
+			if (!ok)
+				return false;
+		}
+		if (smpl && !smplWritten && !RiffChunkScanner::writeChunk(out, "smpl", *smpl))
+			return false;
+		if (cue && !cueWritten && !RiffChunkScanner::writeChunk(out, "cue ", *cue))
+			return false;
+
+		wxFileOffset length = out.Tell();
+		if (length < 8 || length - 8 > 0xffffffffLL)
+			return false;
+		unsigned char riffSize[4];
+		RiffChunkScanner::writeUnsigned(riffSize, (unsigned) (length - 8));
+		return out.Seek(4) && out.Write(riffSize, 4) == 4 && out.Close();
+	}
+
+	bool hasSamePatch(const SampleChunkWriter::SAMPLE_PATCH &a, const SampleChunkWriter::SAMPLE_PATCH &b) {
+		if (a.cuePoint != b.cuePoint || a.loops.size() != b.loops.size())
+			return false;
+		for (unsigned i = 0; i < a.loops.size(); i++) {
+			if (a.loops[i].start != b.loops[i].start || a.loops[i].end != b.loops[i].end)
+				return false;
+		}
+		return true;
+	}
+
+}
+
+bool SampleChunkWriter::patchFile(SAMPLE_PATCH &patch) {
+	patch.isWritten = false;
+	wxFFile in;
+	{
+		wxLogNull noLog;
+		if (!in.Open(patch.path, wxT("rb"))) {
+			patch.errorMessage = wxT("Failed to open ") + patch.path + wxT(".\n");
+			return false;
+		}
+	}
+	// only the chunk headers are read, the payloads are copied as they are
+	std::vector<CHUNK> chunks;
+	switch (RiffChunkScanner::scan(in, chunks)) {
+		case RiffChunkScanner::SCAN_OK:
+			break;
+		case RiffChunkScanner::WAVPACK:
+			patch.errorMessage = patch.path + wxT(" is a WavPack file, only WAVE files can be written to.\n");
+			return false;
+		case RiffChunkScanner::TRUNCATED:
+			patch.errorMessage = patch.path + wxT(" is truncated.\n");
+			return false;
+		default:
+			patch.errorMessage = patch.path + wxT(" is not a WAVE file.\n");
+			return false;
+	}
+
+	unsigned sampleRate = 0;
+	unsigned blockAlign = 0;
+	unsigned dataSize = 0;
+	bool hasData = false;
+	std::vector<unsigned char> oldSmpl;
+	for (const CHUNK &chunk : chunks) {
+		std::vector<unsigned char> payload;
+		if (chunk.is("fmt ") && chunk.size >= 16 && RiffChunkScanner::readPayload(in, chunk, payload)) {
+			sampleRate = RiffChunkScanner::readUnsigned(&payload[4], 4);
+			blockAlign = RiffChunkScanner::readUnsigned(&payload[12], 2);
+		} else if (chunk.is("data") && !hasData) {
+			dataSize = chunk.size;
+			hasData = true;
+		} else if (chunk.is("smpl") && oldSmpl.empty() && !RiffChunkScanner::readPayload(in, chunk, oldSmpl)) {
+			patch.errorMessage = wxT("Failed to read ") + patch.path + wxT(".\n");
+			return false;
+		}
+	}
+	if (!hasData || blockAlign == 0) {
+		patch.errorMessage = patch.path + wxT(" has no audio.\n");
+		return false;
+	}
+
+	unsigned numberOfFrames = dataSize / blockAlign;
+	for (const SAMPLE_LOOP &loop : patch.loops) {
+		if (loop.start >= loop.end || loop.end >= numberOfFrames) {
+			patch.errorMessage = wxString::Format(wxT("The loop %u-%u is outside of the %u frames of "), loop.start, loop.end, numberOfFrames) + patch.path + wxT(".\n");
+			return false;
+		}
+	}
+	if (patch.cuePoint >= 0 && (unsigned) patch.cuePoint >= numberOfFrames) {
+		patch.errorMessage = wxString::Format(wxT("The cue point %i is outside of the %u frames of "), patch.cuePoint, numberOfFrames) + patch.path + wxT(".\n");
+		return false;
+	}
+
+	std::vector<unsigned char> smpl;
+	std::vector<unsigned char> cue;
+	if (!patch.loops.empty())
+		smpl = buildSmplChunk(oldSmpl, patch, sampleRate);
+	if (patch.cuePoint >= 0)
+		cue = buildCueChunk(patch.cuePoint);
+
+	// the temporary file is in the same directory so that it can simply
+	// be renamed over the original
+	wxString tempPath;
+	{
+		wxLogNull noLog;
+		tempPath = wxFileName::CreateTempFileName(wxFileName(patch.path).GetPathWithSep() + wxT("goodf"));
+	}
+	if (tempPath.IsEmpty()) {
+		patch.errorMessage = wxT("Failed to create a temporary file next to ") + patch.path + wxT(".\n");
+		return false;
+	}
+	bool ok = writePatchedFile(in, chunks, smpl.empty() ? NULL : &smpl, cue.empty() ? NULL : &cue, tempPath);
+	in.Close();
+#ifndef __WXMSW__
+	// the temporary file is only readable by the user, the patched sample
+	// keeps the permissions it had
+	struct stat sampleStat;
+	if (ok && ::stat(patch.path.fn_str(), &sampleStat) == 0)
+		ok = ::chmod(tempPath.fn_str(), sampleStat.st_mode & 0777) == 0;
+#endif
+	if (ok) {
+		wxLogNull noLog;
+		ok = OdfFileWriter::replaceFile(tempPath, patch.path);
+	}
+	if (!ok) {
+		wxLogNull noLog;
+		wxRemoveFile(tempPath);
+		patch.errorMessage = wxT("Failed to write ") + patch.path + wxT(".\n");
+		return false;
+	}
+	patch.isWritten = true;
+	return true;
+}
+
+unsigned SampleChunkWriter::collectPatches(const std::vector<std::pair<Rank*, wxString>> &ranks, std::vector<SAMPLE_PATCH> &patches) {
+	patches.clear();
+	std::map<wxString, size_t> patchOfPath;
+	unsigned numberOfConflicts = 0;
+	auto addPatch = [&](SAMPLE_PATCH &patch) {
+		if (patch.loops.empty() && patch.cuePoint < 0)
+			return;
+		std::map<wxString, size_t>::iterator it = patchOfPath.find(patch.path);
+		if (it == patchOfPath.end()) {
+			patchOfPath[patch.path] = patches.size();
+			patches.push_back(patch);
+		} else if (!hasSamePatch(patches[it->second], patch)) {
+			numberOfConflicts++;
+		}
+	};
+
+	for (const std::pair<Rank*, wxString> &entry : ranks) {
+		Rank *rank = entry.first;
+		rank->loadPipes();
+		unsigned pipeIndex = 0;
+		for (Pipe &pipe : rank->m_pipes) {
+			// the pitch of the pipe, only used for files without a smpl chunk
+			SAMPLE_PATCH base;
+			base.cuePoint = -1;
+			base.isWritten = false;
+			if (pipe.midiKeyNumber > -1) {
+				base.midiUnityNote = pipe.midiKeyNumber;
+				base.midiPitchFraction = pipe.midiPitchFraction;
+			} else {
+				int note = rank->getFirstMidiNoteNumber() + pipeIndex;
+				if (pipe.harmonicNumber > 0)
+					note += (int) std::lround(12 * std::log2(pipe.harmonicNumber / 8.0));
+				base.midiUnityNote = std::max(0, std::min(note, 127));
+				base.midiPitchFraction = 0;
+			}
+			for (Attack &atk : pipe.m_attacks) {
+				if (!GOODF_functions::isSampleFilePath(atk.fullPath))
+					continue;
+				SAMPLE_PATCH patch = base;
+				patch.path = atk.fullPath;
+				patch.cuePoint = atk.cuePoint;
+				for (const Loop &loop : atk.m_loops)
+					patch.loops.push_back(SAMPLE_LOOP{ (unsigned) loop.start, (unsigned) loop.end });
+				addPatch(patch);
+			}
+			for (Release &rel : pipe.m_releases) {
+				if (!GOODF_functions::isSampleFilePath(rel.fullPath))
+					continue;
+				SAMPLE_PATCH patch = base;
+				patch.path = rel.fullPath;
+				patch.cuePoint = rel.cuePoint;
+				addPatch(patch);
+			}
+			pipeIndex++;
+		}
+	}
+	return numberOfConflicts;
+}
+
+bool SampleChunkWriter::patchFiles(std::vector<SAMPLE_PATCH> &patches, const std::function<bool(size_t, size_t)> &progress) {
+	ScopedTimer timer("samples.patchChunks");
+	size_t total = patches.size();
+	return WorkerPool::run(
+		total,
+		[&](size_t index) { patchFile(patches[index]); },
+		[&](size_t done) { return !progress || progress(done, total); }
+	);
+}
@@ -0,0 +1,67 @@
+/*
+ * SampleChunkWriter.h is part of GoOdf.
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * GoOdf is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GoOdf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GoOdf.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#ifndef SAMPLECHUNKWRITER_H
+#define SAMPLECHUNKWRITER_H
+
+#include <wx/wx.h>
+#include <vector>
+#include <functional>
+
+class Rank;
+
+// Writes the loops and cue points of the ODF into the smpl and cue chunks
+// of the WAVE files themselves, so that they are kept with the samples.
+// All other chunks, the audio included, are copied byte for byte to a
+// temporary file next to the original which then replaces it, so a failed
+// write never leaves a half written sample behind.
+class SampleChunkWriter {
+public:
+	struct SAMPLE_LOOP {
+		unsigned start;
+		// inclusive, like the LoopEnd of the ODF
+		unsigned end;
+	};
+
+	struct SAMPLE_PATCH {
+		wxString path;
+		// an empty list keeps the loops of the file
+		std::vector<SAMPLE_LOOP> loops;
+		// -1 keeps the cue points of the file
+		int cuePoint;
+		// the pitch written if the file has no smpl chunk yet, the
+		// pitch fraction is in cents
+		unsigned midiUnityNote;
+		float midiPitchFraction;
+		bool isWritten;
+		wxString errorMessage;
+	};
+
+	static bool patchFile(SAMPLE_PATCH &patch);
+	// One patch per sample file of the ranks that has loops or a cue point
+	// set in the ODF, returns the number of files used with different
+	// values by more than one attack or release, of which only the first
+	// is written
+	static unsigned collectPatches(const std::vector<std::pair<Rank*, wxString>> &ranks, std::vector<SAMPLE_PATCH> &patches);
+	// Patches the files on the worker pool
+	static bool patchFiles(std::vector<SAMPLE_PATCH> &patches, const std::function<bool(size_t, size_t)> &progress = nullptr);
+};
+
+#endif
@@ -21,6 +21,8 @@
 #include "SampleFileInfoDialog.h"
 #include <wx/statline.h>
 #include "GOODFFunctions.h"
+#include "GOODF.h"
+#include "WaveformPanel.h"
 
 IMPLEMENT_CLASS(SampleFileInfoDialog, wxDialog)
 
@@ -49,7 +51,8 @@ SampleFileInfoDialog::~SampleFileInfoDialog() {
 }
 
 void SampleFileInfoDialog::Init(wxString sampleFile) {
-	m_relativeFilePath = GOODF_functions::removeBaseOdfPath(sampleFile);
+	m_fullFilePath = sampleFile;
+	m_relativeFilePath = GOODF_functions::removeBaseOdfPath(sampleFile, *::wxGetApp().m_frame->m_organ->getContext());
 	m_sampleFile = new WAVfileParser(sampleFile);
 }
 
@@ -156,6 +159,15 @@ void SampleFileInfoDialog::CreateControls() {
 		seventhRow->Add(pitchText, 0, wxALIGN_CENTER_VERTICAL|wxLEFT|wxRIGHT, 5);
 		mainSizer->Add(seventhRow, 0, wxGROW|wxTOP|wxBOTTOM, 2);
 
+		WaveformPanel *waveform = new WaveformPanel(this);
+		waveform->SetSample(m_fullFilePath);
+		std::vector<std::pair<unsigned, unsigned>> embeddedLoops;
+		for (unsigned i = 0; i < m_sampleFile->getNumberOfLoops(); i++)
+			embeddedLoops.push_back(std::make_pair(m_sampleFile->getLoopAtIndex(i).dwStart, m_sampleFile->getLoopAtIndex(i).dwEnd));
+		int embeddedCue = m_sampleFile->getNumberOfCues() > 0 ? (int) m_sampleFile->getCuepointAtIndex(0).dwSampleOffset : -1;
+		waveform->SetMarkers(0, embeddedCue, -1, embeddedLoops);
+		mainSizer->Add(waveform, 1, wxEXPAND|wxALL, 5);
+
 		unsigned nbrLoops = m_sampleFile->getNumberOfLoops();
 		if (nbrLoops > 0) {
 			wxString loopHeader = wxEmptyString;
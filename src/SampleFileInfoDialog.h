@@ -58,6 +58,7 @@ public:
 	void CreateControls();
 
 private:
+	wxString m_fullFilePath;
 	wxString m_relativeFilePath;
 	WAVfileParser *m_sampleFile;
 };
@@ -0,0 +1,112 @@
+/*
+ * SampleMetadataCache.cpp is part of GoOdf.
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * GoOdf is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GoOdf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GoOdf.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#include "SampleMetadataCache.h"
+#include "SampleReader.h"
+#include "Instrumentation.h"
+#include <wx/filename.h>
+
+// the peaks of about an hour of stereo audio at 48 kHz
+static const size_t MAX_MEMORY_USE = 64 * 1024 * 1024;
+
+SampleMetadataCache& SampleMetadataCache::get() {
+	static SampleMetadataCache cache;
+	return cache;
+}
+
+SampleMetadataCache::SampleMetadataCache() {
+	m_memoryUse = 0;
+	m_useCounter = 0;
+}
+
+SampleMetadataCache::~SampleMetadataCache() {
+
+}
+
+std::shared_ptr<const PeakPyramid> SampleMetadataCache::getPeakPyramid(const wxString &path, wxString &errorMessage) {
+	wxFileName file(path);
+	Instrumentation::count(Instrumentation::FILES_STATTED);
+	wxULongLong fileSize = file.GetSize();
+	if (fileSize == wxInvalidSize) {
+		errorMessage = wxT("The file doesn't exist.\n");
+		return nullptr;
+	}
+	time_t modificationTime = file.GetModificationTime().GetTicks();
+
+	{
+		wxMutexLocker lock(m_mutex);
+		std::map<wxString, CACHE_ENTRY>::iterator it = m_entries.find(path);
+		if (it != m_entries.end()) {
+			if (it->second.fileSize == fileSize && it->second.modificationTime == modificationTime) {
+				it->second.lastUse = ++m_useCounter;
+				return it->second.peaks;
+			}
+			m_memoryUse -= it->second.peaks->getMemoryUse();
+			m_entries.erase(it);
+		}
+	}
+
+	// the audio is read without holding the lock
+	SampleReader reader(path);
+	if (!reader.isOk()) {
+		errorMessage = reader.getErrorMessage();
+		return nullptr;
+	}
+	std::shared_ptr<PeakPyramid> peaks = std::make_shared<PeakPyramid>();
+	{
+		ScopedTimer timer("analysis.peakPyramid");
+		if (!peaks->build(reader)) {
+			errorMessage = wxT("The audio of the file couldn't be read.\n");
+			return nullptr;
+		}
+	}
+
+	wxMutexLocker lock(m_mutex);
+	std::map<wxString, CACHE_ENTRY>::iterator it = m_entries.find(path);
+	if (it != m_entries.end())
+		m_memoryUse -= it->second.peaks->getMemoryUse();
+	CACHE_ENTRY &entry = m_entries[path];
+	entry.fileSize = fileSize;
+	entry.modificationTime = modificationTime;
+	entry.peaks = peaks;
+	entry.lastUse = ++m_useCounter;
+	m_memoryUse += peaks->getMemoryUse();
+	dropLeastRecentlyUsed();
+	return peaks;
+}
+
+void SampleMetadataCache::clear() {
+	wxMutexLocker lock(m_mutex);
+	m_entries.clear();
+	m_memoryUse = 0;
+}
+
+void SampleMetadataCache::dropLeastRecentlyUsed() {
+	// the entry just added is never dropped
+	while (m_memoryUse > MAX_MEMORY_USE && m_entries.size() > 1) {
+		std::map<wxString, CACHE_ENTRY>::iterator oldest = m_entries.begin();
+		for (std::map<wxString, CACHE_ENTRY>::iterator it = m_entries.begin(); it != m_entries.end(); ++it) {
+			if (it->second.lastUse < oldest->second.lastUse)
+				oldest = it;
+		}
+		m_memoryUse -= oldest->second.peaks->getMemoryUse();
+		m_entries.erase(oldest);
+	}
+}
@@ -0,0 +1,63 @@
+/*
+ * SampleMetadataCache.h is part of GoOdf.
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * GoOdf is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GoOdf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GoOdf.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#ifndef SAMPLEMETADATACACHE_H
+#define SAMPLEMETADATACACHE_H
+
+#include <wx/wx.h>
+#include <wx/thread.h>
+#include <map>
+#include <memory>
+#include "PeakPyramid.h"
+
+// Keeps what has been computed from the audio of sample files, like the
+// waveform peaks, for the rest of the session so that opening a sample
+// again doesn't decode it again. An entry is only used while the size and
+// modification time of the file are unchanged, and the least recently used
+// entries are dropped when the cache grows too large. Thread safe.
+class SampleMetadataCache {
+public:
+	static SampleMetadataCache& get();
+
+	// Builds the pyramid on first use, returns null if the audio can't be read
+	std::shared_ptr<const PeakPyramid> getPeakPyramid(const wxString &path, wxString &errorMessage);
+	void clear();
+
+private:
+	struct CACHE_ENTRY {
+		wxULongLong fileSize;
+		time_t modificationTime;
+		std::shared_ptr<const PeakPyramid> peaks;
+		unsigned long lastUse;
+	};
+
+	wxMutex m_mutex;
+	std::map<wxString, CACHE_ENTRY> m_entries;
+	size_t m_memoryUse;
+	unsigned long m_useCounter;
+
+	SampleMetadataCache();
+	~SampleMetadataCache();
+
+	void dropLeastRecentlyUsed();
+
+};
+
+#endif
@@ -0,0 +1,314 @@
+/*
+ * SampleNameMatcher.cpp is part of GoOdf.
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * GoOdf is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GoOdf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GoOdf.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#include "SampleNameMatcher.h"
+#include "Instrumentation.h"
+#include <wx/dir.h>
+#include <wx/filename.h>
+
+namespace {
+
+	int lowerAscii(wxUniChar c) {
+		int value = (int) c.GetValue();
+		if (value >= 'A' && value <= 'Z')
+			return value + ('a' - 'A');
+		return value;
+	}
+
+	bool isDigit(wxUniChar c) {
+		return c.GetValue() >= '0' && c.GetValue() <= '9';
+	}
+
+	wxString nameWithoutSuffix(const wxString &fileName) {
+		size_t dot = fileName.rfind('.');
+		if (dot == wxString::npos)
+			return fileName;
+		return fileName.substr(0, dot);
+	}
+
+}
+
+SampleNameMatcher::SampleNameMatcher(int scheme, const wxString &pattern, int noteNames) {
+	m_scheme = scheme;
+	m_noteNames = noteNames == GERMAN_NOTE_NAMES ? GERMAN_NOTE_NAMES : ENGLISH_NOTE_NAMES;
+	m_isValid = true;
+	m_patternUsesNoteName = false;
+	if (m_scheme == CUSTOM_PATTERN_SCHEME) {
+		m_isValid = isValidPattern(pattern);
+		if (m_isValid) {
+			m_patternUsesNoteName = pattern.Find(wxT("%n")) != wxNOT_FOUND;
+			m_isValid = m_patternRegEx.Compile(patternToRegEx(pattern), wxRE_EXTENDED|wxRE_ICASE);
+		}
+	} else if (m_scheme != NOTE_NAME_SCHEME) {
+		m_scheme = MIDI_NUMBER_SCHEME;
+	}
+}
+
+SampleNameMatcher::~SampleNameMatcher() {
+
+}
+
+bool SampleNameMatcher::isValid() const {
+	return m_isValid;
+}
+
+int SampleNameMatcher::getScheme() const {
+	return m_scheme;
+}
+
+int SampleNameMatcher::getMidiNumber(const wxString &fileName) const {
+	if (!m_isValid)
+		return -1;
+
+	switch (m_scheme) {
+		case NOTE_NAME_SCHEME:
+			return matchNoteName(fileName);
+		case CUSTOM_PATTERN_SCHEME:
+			return matchCustomPattern(fileName);
+		default:
+			return matchMidiNumberPrefix(fileName);
+	}
+}
+
+const wxArrayString& SampleNameMatcher::getSampleFiles(const wxString &directory, int midiNumber) {
+	auto dirIt = m_directories.find(directory);
+	if (dirIt == m_directories.end()) {
+		dirIt = m_directories.emplace(directory, std::map<int, wxArrayString>()).first;
+		indexDirectory(directory, dirIt->second);
+	}
+
+	auto bucketIt = dirIt->second.find(midiNumber);
+	if (bucketIt == dirIt->second.end())
+		return m_noFiles;
+	return bucketIt->second;
+}
+
+int SampleNameMatcher::parseNoteName(const wxString &name, size_t start, size_t *end, int noteNames) {
+	// pitch classes of the letters a to g
+	static const int pitchClasses[] = { 9, 11, 0, 2, 4, 5, 7 };
+
+	size_t length = name.length();
+	if (start >= length)
+		return -1;
+
+	int letter = lowerAscii(name[start]);
+	int pitchClass;
+	if (noteNames == GERMAN_NOTE_NAMES && letter == 'h')
+		pitchClass = 11;
+	else if (noteNames == GERMAN_NOTE_NAMES && letter == 'b')
+		// the german b is the english b flat
+		pitchClass = 10;
+	else if (letter >= 'a' && letter <= 'g')
+		pitchClass = pitchClasses[letter - 'a'];
+	else
+		return -1;
+
+	size_t pos = start + 1;
+	int accidental = 0;
+	if (pos < length) {
+		int next = lowerAscii(name[pos]);
+		int afterNext = pos + 1 < length ? lowerAscii(name[pos + 1]) : 0;
+		if (next == '#') {
+			accidental = 1;
+			pos++;
+		} else if (next == 'i' && afterNext == 's') {
+			// german cis, dis...
+			accidental = 1;
+			pos += 2;
+		} else if (next == 'e' && afterNext == 's') {
+			// german des, ges...
+			accidental = -1;
+			pos += 2;
+		} else if (next == 's' && (letter == 'a' || letter == 'e')) {
+			// german as and es
+			accidental = -1;
+			pos++;
+		} else if (next == 'b') {
+			accidental = -1;
+			pos++;
+		}
+	}
+
+	int octave;
+	if (pos + 1 < length && name[pos] == '-' && name[pos + 1] == '1') {
+		octave = -1;
+		pos += 2;
+	} else if (pos < length && isDigit(name[pos])) {
+		octave = (int) name[pos].GetValue() - '0';
+		pos++;
+	} else {
+		return -1;
+	}
+
+	// a longer number isn't an octave
+	if (pos < length && isDigit(name[pos]))
+		return -1;
+
+	int midiNumber = (octave + 1) * 12 + pitchClass + accidental;
+	if (midiNumber < 0 || midiNumber > 127)
+		return -1;
+
+	if (end)
+		*end = pos;
+	return midiNumber;
+}
+
+bool SampleNameMatcher::isValidPattern(const wxString &pattern) {
+	int placeholders = 0;
+	for (size_t i = 0; i + 1 < pattern.length(); i++) {
+		if (pattern[i] == '%' && (pattern[i + 1] == 'm' || pattern[i + 1] == 'n')) {
+			placeholders++;
+			i++;
+		}
+	}
+	if (placeholders != 1)
+		return false;
+
+	wxRegEx regEx;
+	return regEx.Compile(patternToRegEx(pattern), wxRE_EXTENDED|wxRE_ICASE);
+}
+
+int SampleNameMatcher::matchMidiNumberPrefix(const wxString &fileName) const {
+	// Same result as matching ^([0[:alpha:]]*)(nbr)([^[:digit:]]*[-._]) for
+	// every candidate number, but the number is read from the name instead.
+	size_t length = fileName.length();
+	size_t pos = 0;
+	int lastZero = -1;
+	while (pos < length && (fileName[pos] == '0' || wxIsalpha(fileName[pos]))) {
+		if (fileName[pos] == '0')
+			lastZero = pos;
+		pos++;
+	}
+
+	long number = 0;
+	size_t numberEnd;
+	if (pos < length && isDigit(fileName[pos])) {
+		while (pos < length && isDigit(fileName[pos])) {
+			number = number * 10 + ((int) fileName[pos].GetValue() - '0');
+			if (number > 99999)
+				return -1;
+			pos++;
+		}
+		numberEnd = pos;
+	} else if (lastZero > -1) {
+		// only a zero among the leading characters can be the number then
+		numberEnd = lastZero + 1;
+	} else {
+		return -1;
+	}
+
+	for (size_t i = numberEnd; i < length; i++) {
+		wxUniChar c = fileName[i];
+		if (c == '-' || c == '.' || c == '_')
+			return (int) number;
+		if (isDigit(c))
+			return -1;
+	}
+	return -1;
+}
+
+int SampleNameMatcher::matchNoteName(const wxString &fileName) const {
+	wxString name = nameWithoutSuffix(fileName);
+	for (size_t i = 0; i < name.length(); i++) {
+		// a note name can't start in the middle of a word
+		if (i > 0 && wxIsalpha(name[i - 1]))
+			continue;
+		int midiNumber = parseNoteName(name, i, NULL, m_noteNames);
+		if (midiNumber > -1)
+			return midiNumber;
+	}
+	return -1;
+}
+
+int SampleNameMatcher::matchCustomPattern(const wxString &fileName) const {
+	wxString name = nameWithoutSuffix(fileName);
+	if (!m_patternRegEx.Matches(name))
+		return -1;
+
+	wxString noteMatch = m_patternRegEx.GetMatch(name, 1);
+	if (m_patternUsesNoteName) {
+		size_t end = 0;
+		int midiNumber = parseNoteName(noteMatch, 0, &end, m_noteNames);
+		if (end != noteMatch.length())
+			return -1;
+		return midiNumber;
+	}
+
+	long midiNumber;
+	if (!noteMatch.ToLong(&midiNumber) || midiNumber < 0 || midiNumber > 127)
+		return -1;
+	return (int) midiNumber;
+}
+
+void SampleNameMatcher::indexDirectory(const wxString &directory, std::map<int, wxArrayString> &buckets) {
+	if (!wxDir::Exists(directory))
+		return;
+
+	wxDir dir(directory);
+	if (!dir.IsOpened())
+		return;
+	Instrumentation::count(Instrumentation::DIRECTORIES_LISTED);
+
+	wxString prefix = directory;
+	if (!prefix.EndsWith(wxFILE_SEP_PATH))
+		prefix += wxFILE_SEP_PATH;
+
+	wxString fileName;
+	bool cont = dir.GetFirst(&fileName, wxEmptyString, wxDIR_FILES);
+	while (cont) {
+		size_t dot = fileName.rfind('.');
+		if (dot != wxString::npos) {
+			wxString suffix = fileName.substr(dot + 1);
+			if (suffix.CmpNoCase(wxT("wav")) == 0 || suffix.CmpNoCase(wxT("wv")) == 0) {
+				int midiNumber = getMidiNumber(fileName);
+				if (midiNumber > -1)
+					buckets[midiNumber].Add(prefix + fileName);
+			}
+		}
+		cont = dir.GetNext(&fileName);
+	}
+
+	for (auto &bucket : buckets)
+		bucket.second.Sort();
+}
+
+wxString SampleNameMatcher::patternToRegEx(const wxString &pattern) {
+	wxString regEx = wxT("^");
+	for (size_t i = 0; i < pattern.length(); i++) {
+		wxUniChar c = pattern[i];
+		if (c == '%' && i + 1 < pattern.length() && pattern[i + 1] == 'm') {
+			regEx += wxT("([0-9]+)");
+			i++;
+		} else if (c == '%' && i + 1 < pattern.length() && pattern[i + 1] == 'n') {
+			regEx += wxT("([a-h][#a-z]?[a-z]?-?[0-9])");
+			i++;
+		} else if (c == '*') {
+			regEx += wxT(".*");
+		} else if (c == '?') {
+			regEx += wxT(".");
+		} else {
+			if (wxString(wxT("\\.^$|()[]{}+")).Find(c) != wxNOT_FOUND)
+				regEx += wxT("\\");
+			regEx += c;
+		}
+	}
+	regEx += wxT("$");
+	return regEx;
+}
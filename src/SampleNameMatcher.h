@@ -0,0 +1,82 @@
+/*
+ * SampleNameMatcher.h is part of GoOdf.
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * GoOdf is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GoOdf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GoOdf.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#ifndef SAMPLENAMEMATCHER_H
+#define SAMPLENAMEMATCHER_H
+
+#include <wx/wx.h>
+#include <wx/regex.h>
+#include <map>
+
+// Works out which MIDI note a sample file belongs to from its name. The
+// naming scheme is set up once, after which each name is examined in a
+// single pass. Directories are listed only once and their sample files
+// sorted into MIDI note buckets so that any number of pipes can then pick
+// up their files without touching the disk again.
+class SampleNameMatcher {
+public:
+	enum NAMING_SCHEME {
+		MIDI_NUMBER_SCHEME = 0, // optional letters/zeros, the MIDI number, then - . or _
+		NOTE_NAME_SCHEME,       // note names like c2, C#3, Eb4 or fis1 with C4 = 60
+		CUSTOM_PATTERN_SCHEME   // wildcard pattern for the name without suffix, %m or %n marks the note
+	};
+
+	enum NOTE_NAME_CONVENTION {
+		ENGLISH_NOTE_NAMES = 0, // b is B and bb is B flat
+		GERMAN_NOTE_NAMES       // h is B and b is B flat
+	};
+
+	SampleNameMatcher(int scheme = MIDI_NUMBER_SCHEME, const wxString &pattern = wxEmptyString, int noteNames = ENGLISH_NOTE_NAMES);
+	~SampleNameMatcher();
+
+	bool isValid() const;
+	int getScheme() const;
+
+	// The MIDI note of a file name (without path) or -1 if it doesn't match
+	int getMidiNumber(const wxString &fileName) const;
+
+	// Full paths of the .wav/.wv files in the directory matching the MIDI
+	// note, sorted. The directory itself is read on first request only.
+	const wxArrayString& getSampleFiles(const wxString &directory, int midiNumber);
+
+	static int parseNoteName(const wxString &name, size_t start, size_t *end = NULL, int noteNames = ENGLISH_NOTE_NAMES);
+	static bool isValidPattern(const wxString &pattern);
+
+private:
+	int m_scheme;
+	int m_noteNames;
+	bool m_isValid;
+	bool m_patternUsesNoteName;
+	wxRegEx m_patternRegEx;
+	std::map<wxString, std::map<int, wxArrayString>> m_directories;
+	wxArrayString m_noFiles;
+
+	int matchMidiNumberPrefix(const wxString &fileName) const;
+	int matchNoteName(const wxString &fileName) const;
+	int matchCustomPattern(const wxString &fileName) const;
+	void indexDirectory(const wxString &directory, std::map<int, wxArrayString> &buckets);
+
+	static wxString patternToRegEx(const wxString &pattern);
+
+	SampleNameMatcher(const SampleNameMatcher&) = delete;
+	SampleNameMatcher& operator=(const SampleNameMatcher&) = delete;
+};
+
+#endif
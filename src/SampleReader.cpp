@@ -0,0 +1,220 @@
+/*
+ * SampleReader.cpp is part of GoOdf.
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * GoOdf is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GoOdf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GoOdf.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#include "SampleReader.h"
+#include "Instrumentation.h"
+#include "WavPackDecoder.h"
+#include "RiffChunkScanner.h"
+#include <cstring>
+#include <cstdint>
+#include <algorithm>
+
+SampleReader::SampleReader(const wxString &file) {
+	m_isOk = false;
+	m_audioFormat = 0;
+	m_numberOfChannels = 0;
+	m_sampleRate = 0;
+	m_bitsPerSample = 0;
+	m_blockAlign = 0;
+	m_dataOffset = 0;
+	m_numberOfFrames = 0;
+	m_position = 0;
+
+	wxLogNull noLog;
+	if (!m_file.Open(file, wxT("rb"))) {
+		m_errorMessage = wxT("Failed to open the file.\n");
+		return;
+	}
+	unsigned char magic[4];
+	if (m_file.Read(magic, 4) == 4 && memcmp(magic, "wvpk", 4) == 0)
+		m_isOk = openWavPack();
+	else
+		m_isOk = m_file.Seek(0) && openWav();
+}
+
+SampleReader::~SampleReader() {
+
+}
+
+bool SampleReader::isOk() const {
+	return m_isOk;
+}
+
+wxString SampleReader::getErrorMessage() const {
+	return m_errorMessage;
+}
+
+unsigned SampleReader::getNumberOfChannels() const {
+	return m_numberOfChannels;
+}
+
+unsigned SampleReader::getSampleRate() const {
+	return m_sampleRate;
+}
+
+unsigned SampleReader::getNumberOfFrames() const {
+	return m_numberOfFrames;
+}
+
+bool SampleReader::seek(unsigned frame) {
+	if (!m_isOk || frame > m_numberOfFrames)
+		return false;
+	if (m_wavPack)
+		return m_wavPack->seek(frame);
+	if (!m_file.Seek(m_dataOffset + (wxFileOffset) frame * m_blockAlign))
+		return false;
+	m_position = frame;
+	return true;
+}
+
+unsigned SampleReader::read(float *buffer, unsigned frames) {
+	if (!m_isOk)
+		return 0;
+	if (m_wavPack) {
+		unsigned framesRead = m_wavPack->read(buffer, frames);
+		if (framesRead < frames && m_wavPack->getErrorMessage() != wxEmptyString)
+			m_errorMessage = m_wavPack->getErrorMessage();
+		return framesRead;
+	}
+	frames = std::min(frames, m_numberOfFrames - m_position);
+	if (frames == 0)
+		return 0;
+	m_rawBuffer.resize((size_t) frames * m_blockAlign);
+	size_t bytesRead = m_file.Read(m_rawBuffer.data(), m_rawBuffer.size());
+	unsigned framesRead = bytesRead / m_blockAlign;
+	convertToFloat(m_rawBuffer.data(), buffer, framesRead * m_numberOfChannels);
+	m_position += framesRead;
+	Instrumentation::count(Instrumentation::BYTES_READ, bytesRead);
+	return framesRead;
+}
+
+bool SampleReader::readRange(unsigned first, unsigned last, std::vector<float> &buffer) {
+	if (last < first || last > m_numberOfFrames || !seek(first))
+		return false;
+	buffer.resize((size_t) (last - first) * m_numberOfChannels);
+	return read(buffer.data(), last - first) == last - first;
+}
+
+bool SampleReader::openWav() {
+	unsigned char header[12];
+	if (m_file.Read(header, 12) != 12 || memcmp(header, "RIFF", 4) != 0 || memcmp(header + 8, "WAVE", 4) != 0) {
+		m_errorMessage = wxT("Not a RIFF WAVE file.\n");
+		return false;
+	}
+
+	bool fmtFound = false;
+	wxFileOffset length = m_file.Length();
+	wxFileOffset pos = 12;
+	while (pos + 8 <= length) {
+		unsigned char chunk[8];
+		if (!m_file.Seek(pos) || m_file.Read(chunk, 8) != 8)
+			break;
+		unsigned chunkSize = RiffChunkScanner::readUnsigned(chunk + 4, 4);
+
+		if (memcmp(chunk, "fmt ", 4) == 0 && chunkSize >= 16) {
+			unsigned char fmt[40] = {};
+			if (m_file.Read(fmt, std::min(chunkSize, 40u)) < 16)
+				break;
+			m_audioFormat = RiffChunkScanner::readUnsigned(fmt, 2);
+			m_numberOfChannels = RiffChunkScanner::readUnsigned(fmt + 2, 2);
+			m_sampleRate = RiffChunkScanner::readUnsigned(fmt + 4, 4);
+			m_blockAlign = RiffChunkScanner::readUnsigned(fmt + 12, 2);
+			m_bitsPerSample = RiffChunkScanner::readUnsigned(fmt + 14, 2);
+			// the sub format of WAVE_FORMAT_EXTENSIBLE starts with the format tag
+			if (m_audioFormat == 65534 && chunkSize >= 40)
+				m_audioFormat = RiffChunkScanner::readUnsigned(fmt + 24, 2);
+			fmtFound = true;
+		} else if (memcmp(chunk, "data", 4) == 0 && fmtFound) {
+			if (m_audioFormat != 1 && m_audioFormat != 3) {
+				m_errorMessage = wxT("Unsupported wave format detected.\n");
+				return false;
+			}
+			if (m_numberOfChannels == 0 || m_blockAlign != m_numberOfChannels * ((m_bitsPerSample + 7) / 8)) {
+				m_errorMessage = wxT("Block align doesn't match (nChannels*bitsPerSample/8).\n");
+				return false;
+			}
+			if (m_audioFormat == 3 ? (m_bitsPerSample != 32 && m_bitsPerSample != 64) : (m_bitsPerSample < 8 || m_bitsPerSample > 32)) {
+				m_errorMessage = wxT("Unsupported bits per sample.\n");
+				return false;
+			}
+			m_dataOffset = pos + 8;
+			wxFileOffset dataSize = std::min((wxFileOffset) chunkSize, length - m_dataOffset);
+			m_numberOfFrames = dataSize / m_blockAlign;
+			m_position = 0;
+			return m_file.Seek(m_dataOffset);
+		}
+		pos += 8 + (wxFileOffset) chunkSize + (chunkSize & 1);
+	}
+	m_errorMessage = wxT("Chunks for fmt and/or data couldn't be found.\n");
+	return false;
+}
+
+bool SampleReader::openWavPack() {
+	m_wavPack.reset(new WavPackDecoder(m_file));
+	if (!m_wavPack->open(m_errorMessage))
+		return false;
+	m_numberOfChannels = m_wavPack->getNumberOfChannels();
+	m_sampleRate = m_wavPack->getSampleRate();
+	m_bitsPerSample = m_wavPack->getBitsPerSample();
+	m_numberOfFrames = m_wavPack->getNumberOfFrames();
+	return true;
+}
+
+void SampleReader::convertToFloat(const unsigned char *raw, float *buffer, unsigned numberOfValues) {
+	unsigned bytesPerValue = m_blockAlign / m_numberOfChannels;
+	if (m_audioFormat == 3) {
+		if (bytesPerValue == 4) {
+			memcpy(buffer, raw, (size_t) numberOfValues * 4);
+		} else {
+			for (unsigned i = 0; i < numberOfValues; i++) {
+				double value;
+				memcpy(&value, raw + (size_t) i * 8, 8);
+				buffer[i] = (float) value;
+			}
+		}
+		return;
+	}
+
+	switch (bytesPerValue) {
+		case 1:
+			for (unsigned i = 0; i < numberOfValues; i++)
+				buffer[i] = ((int) raw[i] - 128) * (1.0f / 128.0f);
+			break;
+		case 2:
+			for (unsigned i = 0; i < numberOfValues; i++) {
+				int16_t value = (int16_t) (raw[2 * i] | (raw[2 * i + 1] << 8));
+				buffer[i] = value * (1.0f / 32768.0f);
+			}
+			break;
+		case 3:
+			for (unsigned i = 0; i < numberOfValues; i++) {
+				const unsigned char *bytes = raw + (size_t) i * 3;
+				int32_t value = (int32_t) ((unsigned) bytes[0] << 8 | (unsigned) bytes[1] << 16 | (unsigned) bytes[2] << 24) >> 8;
+				buffer[i] = value * (1.0f / 8388608.0f);
+			}
+			break;
+		default:
+			for (unsigned i = 0; i < numberOfValues; i++) {
+				int32_t value = (int32_t) RiffChunkScanner::readUnsigned(raw + (size_t) i * 4, 4);
+				buffer[i] = value * (1.0f / 2147483648.0f);
+			}
+			break;
+	}
+}
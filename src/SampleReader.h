@@ -0,0 +1,73 @@
+/*
+ * SampleReader.h is part of GoOdf.
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * GoOdf is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GoOdf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GoOdf.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#ifndef SAMPLEREADER_H
+#define SAMPLEREADER_H
+
+#include <wx/wx.h>
+#include <wx/ffile.h>
+#include <vector>
+#include <memory>
+
+class WavPackDecoder;
+
+// Reads the audio of a sample file a chunk at a time as interleaved
+// floats between -1 and 1, so that any part of a file can be analyzed
+// without holding all of it in memory. Both RIFF WAVE and WavPack files
+// are read. Each reader has its own file handle and can be used on any
+// thread.
+class SampleReader {
+public:
+	SampleReader(const wxString &file);
+	~SampleReader();
+
+	bool isOk() const;
+	wxString getErrorMessage() const;
+	unsigned getNumberOfChannels() const;
+	unsigned getSampleRate() const;
+	unsigned getNumberOfFrames() const;
+
+	bool seek(unsigned frame);
+	// Returns the number of frames read, less than asked for only at the end
+	unsigned read(float *buffer, unsigned frames);
+	// Reads the frames from first (inclusive) to last (exclusive)
+	bool readRange(unsigned first, unsigned last, std::vector<float> &buffer);
+
+private:
+	wxFFile m_file;
+	bool m_isOk;
+	wxString m_errorMessage;
+	unsigned m_audioFormat;
+	unsigned m_numberOfChannels;
+	unsigned m_sampleRate;
+	unsigned m_bitsPerSample;
+	unsigned m_blockAlign;
+	wxFileOffset m_dataOffset;
+	unsigned m_numberOfFrames;
+	unsigned m_position;
+	std::vector<unsigned char> m_rawBuffer;
+	std::unique_ptr<WavPackDecoder> m_wavPack;
+
+	bool openWav();
+	bool openWavPack();
+	void convertToFloat(const unsigned char *raw, float *buffer, unsigned numberOfValues);
+};
+
+#endif
@@ -0,0 +1,354 @@
+/*
+ * SampleTrimExporter.cpp is part of GoOdf.
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * GoOdf is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GoOdf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GoOdf.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#include "SampleTrimExporter.h"
+#include "Organ.h"
+#include "Rank.h"
+#include "GOODFFunctions.h"
+#include "WorkerPool.h"
+#include "Instrumentation.h"
+#include "RiffChunkScanner.h"
+#include <wx/ffile.h>
+#include <wx/filename.h>
+#include <algorithm>
+
+namespace {
+
+	// bytes copied at a time, which is all the memory a worker needs
+	const size_t COPY_BLOCK_SIZE = 1024 * 1024;
+	const unsigned SMPL_HEADER_SIZE = 36;
+	const unsigned SMPL_LOOP_SIZE = 24;
+	const unsigned CUE_POINT_SIZE = 24;
+
+	typedef RiffChunkScanner::CHUNK CHUNK;
+
+	// Moves the loops to the trimmed audio, dropping those outside of it
+	void rebaseSmplChunk(std::vector<unsigned char> &payload, unsigned startFrame, unsigned endFrame) {
+		if (payload.size() < SMPL_HEADER_SIZE)
+			return;
+		unsigned numberOfLoops = RiffChunkScanner::readUnsigned(&payload[28], 4);
+		std::vector<unsigned char> rebased(payload.begin(), payload.begin() + SMPL_HEADER_SIZE);
+		unsigned kept = 0;
+		size_t position = SMPL_HEADER_SIZE;
+		for (unsigned i = 0; i < numberOfLoops && position + SMPL_LOOP_SIZE <= payload.size(); i++, position += SMPL_LOOP_SIZE) {
+			unsigned start = RiffChunkScanner::readUnsigned(&payload[position + 8], 4);
+			unsigned end = RiffChunkScanner::readUnsigned(&payload[position + 12], 4);
+			if (start < startFrame || end >= endFrame)
+				continue;
+			rebased.insert(rebased.end(), payload.begin() + position, payload.begin() + position + SMPL_LOOP_SIZE);
+			RiffChunkScanner::writeUnsigned(&rebased[rebased.size() - 16], start - startFrame);
+			RiffChunkScanner::writeUnsigned(&rebased[rebased.size() - 12], end - startFrame);
+			kept++;
+		}
+		// the sampler specific data follows the loops
+		if (position < payload.size())
+			rebased.insert(rebased.end(), payload.begin() + position, payload.end());
+		RiffChunkScanner::writeUnsigned(&rebased[28], kept);
+		payload.swap(rebased);
+	}
+
+	void rebaseCueChunk(std::vector<unsigned char> &payload, unsigned startFrame, unsigned endFrame) {
+		if (payload.size() < 4)
+			return;
+		unsigned numberOfCues = RiffChunkScanner::readUnsigned(&payload[0], 4);
+		std::vector<unsigned char> rebased(payload.begin(), payload.begin() + 4);
+		unsigned kept = 0;
+		size_t position = 4;
+		for (unsigned i = 0; i < numberOfCues && position + CUE_POINT_SIZE <= payload.size(); i++, position += CUE_POINT_SIZE) {
+			unsigned offset = RiffChunkScanner::readUnsigned(&payload[position + 20], 4);
+			if (offset < startFrame || offset >= endFrame)
+				continue;
+			rebased.insert(rebased.end(), payload.begin() + position, payload.begin() + position + CUE_POINT_SIZE);
+			RiffChunkScanner::writeUnsigned(&rebased[rebased.size() - 4], offset - startFrame);
+			kept++;
+		}
+		RiffChunkScanner::writeUnsigned(&rebased[0], kept);
+		payload.swap(rebased);
+	}
+
+	unsigned getLastLoopEnd(const std::vector<unsigned char> &smpl) {
+		unsigned lastEnd = 0;
+		if (smpl.size() < SMPL_HEADER_SIZE)
+			return lastEnd;
+		unsigned numberOfLoops = RiffChunkScanner::readUnsigned(&smpl[28], 4);
+		for (unsigned i = 0; i < numberOfLoops && SMPL_HEADER_SIZE + (i + 1) * SMPL_LOOP_SIZE <= smpl.size(); i++)
+			lastEnd = std::max(lastEnd, RiffChunkScanner::readUnsigned(&smpl[SMPL_HEADER_SIZE + i * SMPL_LOOP_SIZE + 12], 4) + 1);
+		return lastEnd;
+	}
+
+	// The offsets of the ODF rebased to a copy starting at startFrame with
+	// numberOfFrames frames, -1 if they fall after it
+	int rebaseOffset(int offset, unsigned startFrame, unsigned numberOfFrames) {
+		if (offset < 0)
+			return offset;
+		int rebased = offset - (int) startFrame;
+		return rebased + 1 >= (int) numberOfFrames ? -1 : rebased;
+	}
+
+}
+
+SampleTrimExporter::SampleTrimExporter(Organ *organ) : m_organ(organ) {
+
+}
+
+SampleTrimExporter::~SampleTrimExporter() {
+
+}
+
+void SampleTrimExporter::collectSamples(const std::vector<std::pair<Rank*, wxString>> &ranks, const wxString &directory) {
+	m_files.clear();
+	m_uses.clear();
+	m_fileOfTrim.clear();
+	m_outputPaths.clear();
+	for (const std::pair<Rank*, wxString> &entry : ranks) {
+		Rank *rank = entry.first;
+		rank->loadPipes();
+		for (Pipe &pipe : rank->m_pipes) {
+			for (Attack &atk : pipe.m_attacks) {
+				if (!GOODF_functions::isSampleFilePath(atk.fullPath))
+					continue;
+				unsigned startFrame = atk.attackStart > 0 ? atk.attackStart : 0;
+				int endFrame = END_OF_FILE;
+				int lastLoopEnd = -1;
+				for (const Loop &loop : atk.m_loops) {
+					// the ODF offsets must stay valid once rebased
+					if (loop.start < (int) startFrame)
+						startFrame = 0;
+					lastLoopEnd = std::max(lastLoopEnd, loop.end + 1);
+				}
+				if (atk.cuePoint >= 0 && atk.cuePoint < (int) startFrame)
+					startFrame = 0;
+				if (atk.loadRelease) {
+					if (atk.releaseEnd >= 0)
+						endFrame = std::max(atk.releaseEnd + 1, lastLoopEnd);
+				} else if (lastLoopEnd > 0) {
+					endFrame = lastLoopEnd;
+				} else {
+					endFrame = END_OF_LOOPS;
+				}
+				m_uses.push_back(SAMPLE_USE{ rank, &atk, NULL, addFile(atk.fullPath, startFrame, endFrame, directory) });
+			}
+			for (Release &rel : pipe.m_releases) {
+				if (!GOODF_functions::isSampleFilePath(rel.fullPath))
+					continue;
+				int endFrame = rel.releaseEnd >= 0 ? rel.releaseEnd + 1 : END_OF_FILE;
+				m_uses.push_back(SAMPLE_USE{ rank, NULL, &rel, addFile(rel.fullPath, 0, endFrame, directory) });
+			}
+		}
+	}
+}
+
+size_t SampleTrimExporter::addFile(const wxString &sourcePath, unsigned startFrame, int endFrame, const wxString &directory) {
+	std::tuple<wxString, unsigned, int> trim(sourcePath, startFrame, endFrame);
+	std::map<std::tuple<wxString, unsigned, int>, size_t>::iterator it = m_fileOfTrim.find(trim);
+	if (it != m_fileOfTrim.end())
+		return it->second;
+
+	wxFileName relative(sourcePath);
+	relative.MakeRelativeTo(m_organ->getOdfRoot());
+	if (relative.GetFullPath().StartsWith(wxT("..")) || relative.IsAbsolute())
+		relative = wxFileName(wxFileName(sourcePath).GetFullName());
+	wxFileName output(directory + wxFILE_SEP_PATH + relative.GetFullPath());
+	// a sample trimmed differently for several uses gets a copy per use
+	wxString name = output.GetName();
+	for (unsigned copy = 2; m_outputPaths.count(output.GetFullPath()); copy++)
+		output.SetName(name + wxString::Format(wxT("-%u"), copy));
+	m_outputPaths.insert(output.GetFullPath());
+
+	EXPORT_FILE file;
+	file.sourcePath = sourcePath;
+	file.outputPath = output.GetFullPath();
+	file.startFrame = startFrame;
+	file.endFrame = endFrame;
+	file.numberOfFrames = 0;
+	file.sourceSize = 0;
+	file.outputSize = 0;
+	file.isWritten = false;
+	m_files.push_back(file);
+	m_fileOfTrim[trim] = m_files.size() - 1;
+	return m_files.size() - 1;
+}
+
+bool SampleTrimExporter::exportFiles(const std::function<bool(size_t, size_t)> &progress) {
+	ScopedTimer timer("samples.exportTrimmed");
+	// the directories are made here so that the workers don't race for them
+	std::set<wxString> directories;
+	for (const EXPORT_FILE &file : m_files)
+		directories.insert(wxFileName(file.outputPath).GetPath());
+	for (const wxString &directory : directories) {
+		wxLogNull noLog;
+		if (!wxFileName::DirExists(directory))
+			wxFileName::Mkdir(directory, wxS_DIR_DEFAULT, wxPATH_MKDIR_FULL);
+	}
+
+	size_t total = m_files.size();
+	return WorkerPool::run(
+		total,
+		[&](size_t index) { trimFile(m_files[index]); },
+		[&](size_t done) { return !progress || progress(done, total); }
+	);
+}
+
+unsigned SampleTrimExporter::applyToOdf() {
+	unsigned changedSamples = 0;
+	std::set<Rank*> changedRanks;
+	for (SAMPLE_USE &use : m_uses) {
+		const EXPORT_FILE &file = m_files[use.fileIndex];
+		if (!file.isWritten)
+			continue;
+		if (use.attack) {
+			Attack *atk = use.attack;
+			atk->fullPath = file.outputPath;
+			atk->fileName = GOODF_functions::removeBaseOdfPath(file.outputPath, *m_organ->getContext());
+			atk->attackStart = std::max(atk->attackStart - (int) file.startFrame, 0);
+			for (Loop &loop : atk->m_loops) {
+				loop.start -= file.startFrame;
+				loop.end -= file.startFrame;
+			}
+			atk->cuePoint = rebaseOffset(atk->cuePoint, file.startFrame, file.numberOfFrames);
+			atk->releaseEnd = rebaseOffset(atk->releaseEnd, file.startFrame, file.numberOfFrames);
+		} else {
+			Release *rel = use.release;
+			rel->fullPath = file.outputPath;
+			rel->fileName = GOODF_functions::removeBaseOdfPath(file.outputPath, *m_organ->getContext());
+			rel->releaseEnd = rebaseOffset(rel->releaseEnd, file.startFrame, file.numberOfFrames);
+		}
+		changedRanks.insert(use.rank);
+		changedSamples++;
+	}
+	for (Rank *rank : changedRanks)
+		m_organ->setSectionModified(rank);
+	return changedSamples;
+}
+
+const std::vector<SampleTrimExporter::EXPORT_FILE>& SampleTrimExporter::getFiles() const {
+	return m_files;
+}
+
+bool SampleTrimExporter::trimFile(EXPORT_FILE &file) {
+	file.isWritten = false;
+	if (wxFileName(file.sourcePath).SameAs(wxFileName(file.outputPath))) {
+		file.errorMessage = file.sourcePath + wxT(" would be overwritten by its own copy.\n");
+		return false;
+	}
+	wxFFile in;
+	{
+		wxLogNull noLog;
+		if (!in.Open(file.sourcePath, wxT("rb"))) {
+			file.errorMessage = wxT("Failed to open ") + file.sourcePath + wxT(".\n");
+			return false;
+		}
+	}
+	wxFileOffset fileLength = in.Length();
+	file.sourceSize = fileLength > 0 ? fileLength : 0;
+	std::vector<CHUNK> chunks;
+	switch (RiffChunkScanner::scan(in, chunks)) {
+		case RiffChunkScanner::SCAN_OK:
+			break;
+		case RiffChunkScanner::WAVPACK:
+			file.errorMessage = file.sourcePath + wxT(" is a WavPack file, only WAVE files can be trimmed.\n");
+			return false;
+		case RiffChunkScanner::TRUNCATED:
+			file.errorMessage = file.sourcePath + wxT(" is truncated.\n");
+			return false;
+		default:
+			file.errorMessage = file.sourcePath + wxT(" is not a WAVE file.\n");
+			return false;
+	}
+
+	unsigned blockAlign = 0;
+	const CHUNK *data = NULL;
+	std::vector<unsigned char> smpl;
+	for (const CHUNK &chunk : chunks) {
+		std::vector<unsigned char> payload;
+		if (chunk.is("fmt ") && chunk.size >= 16 && RiffChunkScanner::readPayload(in, chunk, payload))
+			blockAlign = RiffChunkScanner::readUnsigned(&payload[12], 2);
+		else if (chunk.is("data") && !data)
+			data = &chunk;
+		else if (chunk.is("smpl") && smpl.empty())
+			RiffChunkScanner::readPayload(in, chunk, smpl);
+	}
+	if (!data || blockAlign == 0) {
+		file.errorMessage = file.sourcePath + wxT(" has no audio.\n");
+		return false;
+	}
+
+	unsigned sourceFrames = data->size / blockAlign;
+	unsigned endFrame = sourceFrames;
+	if (file.endFrame == END_OF_LOOPS) {
+		unsigned lastLoopEnd = getLastLoopEnd(smpl);
+		if (lastLoopEnd > 0)
+			endFrame = std::min(lastLoopEnd, sourceFrames);
+	} else if (file.endFrame >= 0) {
+		endFrame = std::min((unsigned) file.endFrame, sourceFrames);
+	}
+	if (file.startFrame >= endFrame) {
+		file.errorMessage = wxString::Format(wxT("Nothing is left of the %u frames of "), sourceFrames) + file.sourcePath + wxString::Format(wxT(" when starting at %u.\n"), file.startFrame);
+		return false;
+	}
+	file.numberOfFrames = endFrame - file.startFrame;
+
+	wxFFile out;
+	{
+		wxLogNull noLog;
+		if (!out.Open(file.outputPath, wxT("wb"))) {
+			file.errorMessage = wxT("Failed to create ") + file.outputPath + wxT(".\n");
+			return false;
+		}
+	}
+	std::vector<unsigned char> buffer(COPY_BLOCK_SIZE);
+	// the RIFF size is written when it's known
+	bool ok = out.Write("RIFF\0\0\0\0WAVE", 12) == 12;
+	for (const CHUNK &chunk : chunks) {
+		if (!ok)
+			break;
+		if (&chunk == data) {
+			unsigned dataSize = file.numberOfFrames * blockAlign;
+			ok = RiffChunkScanner::writeChunkHeader(out, "data", dataSize) && RiffChunkScanner::copyRange(in, out, chunk.offset + (wxFileOffset) file.startFrame * blockAlign, dataSize, buffer);
+			ok = ok && (dataSize % 2 == 0 || out.Write("", 1) == 1);
+		} else if (chunk.is("smpl") || chunk.is("cue ") || chunk.is("fact")) {
+			std::vector<unsigned char> payload;
+			ok = RiffChunkScanner::readPayload(in, chunk, payload);
+			if (chunk.is("smpl"))
+				rebaseSmplChunk(payload, file.startFrame, endFrame);
+			else if (chunk.is("cue "))
+				rebaseCueChunk(payload, file.startFrame, endFrame);
+			else if (payload.size() >= 4)
+				RiffChunkScanner::writeUnsigned(&payload[0], file.numberOfFrames);
+			ok = ok && RiffChunkScanner::writeChunk(out, chunk.id, payload);
+		} else {
+			ok = RiffChunkScanner::copyChunk(in, out, chunk, buffer);
+		}
+	}
+	wxFileOffset outputLength = out.Tell();
+	unsigned char riffSize[4];
+	RiffChunkScanner::writeUnsigned(riffSize, (unsigned) (outputLength - 8));
+	ok = ok && out.Seek(4) && out.Write(riffSize, 4) == 4;
+	ok = out.Close() && ok;
+	if (!ok) {
+		wxLogNull noLog;
+		wxRemoveFile(file.outputPath);
+		file.errorMessage = wxT("Failed to write ") + file.outputPath + wxT(".\n");
+		return false;
+	}
+	file.outputSize = outputLength;
+	file.isWritten = true;
+	return true;
+}
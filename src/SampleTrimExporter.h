@@ -0,0 +1,94 @@
+/*
+ * SampleTrimExporter.h is part of GoOdf.
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * GoOdf is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GoOdf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GoOdf.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#ifndef SAMPLETRIMEXPORTER_H
+#define SAMPLETRIMEXPORTER_H
+
+#include <wx/wx.h>
+#include <vector>
+#include <functional>
+#include <map>
+#include <set>
+#include <tuple>
+#include "Attack.h"
+#include "Release.h"
+
+class Organ;
+class Rank;
+
+// Writes copies of the samples of ranks with the audio GrandOrgue never
+// plays removed: the frames before the AttackStart and those after the
+// ReleaseEnd, or after the last loop of attacks that don't load a release.
+// The loops and cue points of the smpl and cue chunks are moved along and
+// the ODF is then pointed at the copies with its offsets rebased, so that
+// the shipped samples are smaller and load faster. The audio is copied in
+// blocks without decoding it, the files are written on the worker pool.
+class SampleTrimExporter {
+public:
+	struct EXPORT_FILE {
+		wxString sourcePath;
+		wxString outputPath;
+		// the first frame kept
+		unsigned startFrame;
+		// the frame after the last one kept, END_OF_FILE keeps the rest of
+		// the file and END_OF_LOOPS ends after the last loop of the file
+		int endFrame;
+		// set by exportFiles
+		unsigned numberOfFrames;
+		unsigned long long sourceSize;
+		unsigned long long outputSize;
+		bool isWritten;
+		wxString errorMessage;
+	};
+
+	static const int END_OF_FILE = -1;
+	static const int END_OF_LOOPS = -2;
+
+	SampleTrimExporter(Organ *organ);
+	~SampleTrimExporter();
+
+	// The copies keep their path relative to the ODF root in the directory
+	void collectSamples(const std::vector<std::pair<Rank*, wxString>> &ranks, const wxString &directory);
+	bool exportFiles(const std::function<bool(size_t, size_t)> &progress = nullptr);
+	// Points the attacks and releases at the written copies, returns the
+	// number of them that were changed
+	unsigned applyToOdf();
+	const std::vector<EXPORT_FILE>& getFiles() const;
+
+	static bool trimFile(EXPORT_FILE &file);
+
+private:
+	struct SAMPLE_USE {
+		Rank *rank;
+		Attack *attack;
+		Release *release;
+		size_t fileIndex;
+	};
+
+	Organ *m_organ;
+	std::vector<EXPORT_FILE> m_files;
+	std::vector<SAMPLE_USE> m_uses;
+	std::map<std::tuple<wxString, unsigned, int>, size_t> m_fileOfTrim;
+	std::set<wxString> m_outputPaths;
+
+	size_t addFile(const wxString &sourcePath, unsigned startFrame, int endFrame, const wxString &directory);
+};
+
+#endif
@@ -0,0 +1,241 @@
+/*
+ * SampleValidationDialog.cpp is part of GoOdf.
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * GoOdf is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GoOdf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GoOdf.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#include "SampleValidationDialog.h"
+#include "GOODFDef.h"
+#include "GOODFFunctions.h"
+#include <wx/statline.h>
+#include <algorithm>
+
+IMPLEMENT_CLASS(SampleValidationDialog, wxDialog)
+
+BEGIN_EVENT_TABLE(SampleValidationDialog, wxDialog)
+	EVT_CHOICE(ID_VALIDATION_SEVERITY_CHOICE, SampleValidationDialog::OnFilterChange)
+	EVT_CHOICE(ID_VALIDATION_TYPE_CHOICE, SampleValidationDialog::OnFilterChange)
+	EVT_TEXT(ID_VALIDATION_FILTER_TEXT, SampleValidationDialog::OnFilterChange)
+	EVT_BUTTON(ID_VALIDATION_RECHECK_BTN, SampleValidationDialog::OnRecheckBtn)
+END_EVENT_TABLE()
+
+SampleValidationDialog::SampleValidationDialog(SampleValidator *validator, const std::vector<std::pair<Rank*, wxString>> &ranks) {
+	Init(validator, ranks);
+}
+
+SampleValidationDialog::SampleValidationDialog(
+	SampleValidator *validator,
+	const std::vector<std::pair<Rank*, wxString>> &ranks,
+	wxWindow* parent,
+	wxWindowID id,
+	const wxString& caption,
+	const wxPoint& pos,
+	const wxSize& size,
+	long style
+) {
+	Init(validator, ranks);
+	Create(parent, id, caption, pos, size, style);
+}
+
+SampleValidationDialog::~SampleValidationDialog() {
+
+}
+
+void SampleValidationDialog::Init(SampleValidator *validator, const std::vector<std::pair<Rank*, wxString>> &ranks) {
+	m_validator = validator;
+	m_ranks = ranks;
+}
+
+bool SampleValidationDialog::Create(
+	wxWindow* parent,
+	wxWindowID id,
+	const wxString& caption,
+	const wxPoint& pos,
+	const wxSize& size,
+	long style
+) {
+	if (!wxDialog::Create(parent, id, caption, pos, size, style))
+		return false;
+
+	CreateControls();
+	UpdateSummary();
+	FillList();
+
+	GetSizer()->Fit(this);
+	GetSizer()->SetSizeHints(this);
+	Centre();
+
+	return true;
+}
+
+void SampleValidationDialog::CreateControls() {
+	wxBoxSizer *mainSizer = new wxBoxSizer(wxVERTICAL);
+
+	m_summaryText = new wxStaticText (
+		this,
+		wxID_STATIC,
+		wxEmptyString
+	);
+	mainSizer->Add(m_summaryText, 0, wxALL, 5);
+
+	wxBoxSizer *filterRow = new wxBoxSizer(wxHORIZONTAL);
+	wxStaticText *severityText = new wxStaticText (
+		this,
+		wxID_STATIC,
+		wxT("Show: ")
+	);
+	filterRow->Add(severityText, 0, wxALIGN_CENTER_VERTICAL|wxALL, 5);
+	wxArrayString severities;
+	severities.Add(wxT("Errors and warnings"));
+	severities.Add(wxT("Errors"));
+	severities.Add(wxT("Warnings"));
+	m_severityChoice = new wxChoice(
+		this,
+		ID_VALIDATION_SEVERITY_CHOICE,
+		wxDefaultPosition,
+		wxDefaultSize,
+		severities
+	);
+	m_severityChoice->SetSelection(0);
+	filterRow->Add(m_severityChoice, 0, wxALIGN_CENTER_VERTICAL|wxALL, 5);
+	wxStaticText *typeText = new wxStaticText (
+		this,
+		wxID_STATIC,
+		wxT("Type: ")
+	);
+	filterRow->Add(typeText, 0, wxALIGN_CENTER_VERTICAL|wxALL, 5);
+	wxArrayString types;
+	types.Add(wxT("All"));
+	for (int i = 0; i < SampleValidator::NUMBER_OF_PROBLEM_TYPES; i++)
+		types.Add(SampleValidator::getTypeName((SampleValidator::PROBLEM_TYPE) i));
+	m_typeChoice = new wxChoice(
+		this,
+		ID_VALIDATION_TYPE_CHOICE,
+		wxDefaultPosition,
+		wxDefaultSize,
+		types
+	);
+	m_typeChoice->SetSelection(0);
+	filterRow->Add(m_typeChoice, 0, wxALIGN_CENTER_VERTICAL|wxALL, 5);
+	wxStaticText *filterText = new wxStaticText (
+		this,
+		wxID_STATIC,
+		wxT("Containing: ")
+	);
+	filterRow->Add(filterText, 0, wxALIGN_CENTER_VERTICAL|wxALL, 5);
+	m_filterField = new wxTextCtrl(
+		this,
+		ID_VALIDATION_FILTER_TEXT,
+		wxEmptyString
+	);
+	m_filterField->SetToolTip(wxT("Only show the problems whose rank, sample or description contains this text"));
+	filterRow->Add(m_filterField, 1, wxEXPAND|wxALL, 5);
+	wxButton *recheckBtn = new wxButton(
+		this,
+		ID_VALIDATION_RECHECK_BTN,
+		wxT("Check again")
+	);
+	filterRow->Add(recheckBtn, 0, wxALIGN_CENTER_VERTICAL|wxALL, 5);
+	mainSizer->Add(filterRow, 0, wxGROW);
+
+	m_problemList = new wxListCtrl(
+		this,
+		ID_VALIDATION_LIST,
+		wxDefaultPosition,
+		wxSize(960, 400),
+		wxLC_REPORT|wxLC_SINGLE_SEL
+	);
+	m_problemList->AppendColumn(wxT("Severity"), wxLIST_FORMAT_LEFT, 70);
+	m_problemList->AppendColumn(wxT("Type"), wxLIST_FORMAT_LEFT, 110);
+	m_problemList->AppendColumn(wxT("Rank"), wxLIST_FORMAT_LEFT, 160);
+	m_problemList->AppendColumn(wxT("Pipe"), wxLIST_FORMAT_RIGHT, 50);
+	m_problemList->AppendColumn(wxT("Sample"), wxLIST_FORMAT_LEFT, 220);
+	m_problemList->AppendColumn(wxT("Problem"), wxLIST_FORMAT_LEFT, 350);
+	mainSizer->Add(m_problemList, 1, wxEXPAND|wxALL, 5);
+
+	wxStaticLine *bottomDivider = new wxStaticLine(this);
+	mainSizer->Add(bottomDivider, 0, wxEXPAND);
+
+	wxBoxSizer *bottomRow = new wxBoxSizer(wxHORIZONTAL);
+	bottomRow->AddStretchSpacer();
+	wxButton *theCloseButton = new wxButton(
+		this,
+		wxID_CANCEL,
+		wxT("Close")
+	);
+	bottomRow->Add(theCloseButton, 0, wxALIGN_CENTER|wxALL, 10);
+	bottomRow->AddStretchSpacer();
+	mainSizer->Add(bottomRow, 0, wxGROW);
+
+	SetSizer(mainSizer);
+}
+
+void SampleValidationDialog::OnFilterChange(wxCommandEvent& WXUNUSED(event)) {
+	FillList();
+}
+
+void SampleValidationDialog::OnRecheckBtn(wxCommandEvent& WXUNUSED(event)) {
+	bool completed = GOODF_functions::runWithProgress(this, wxT("Validating samples"), wxT("Checking the samples again"), false, [&](const std::function<bool(size_t, size_t)> &progress) {
+		return m_validator->validate(m_ranks, progress);
+	});
+	if (!completed)
+		return;
+	UpdateSummary();
+	FillList();
+}
+
+void SampleValidationDialog::UpdateSummary() {
+	unsigned errors = 0;
+	for (const SampleValidator::PROBLEM &problem : m_validator->getProblems()) {
+		if (problem.isError)
+			errors++;
+	}
+	m_summaryText->SetLabel(wxString::Format(
+		wxT("%u error(s) and %u warning(s) in %u pipes. %u pipe(s) were checked and %u sample file(s) read, the rest were unchanged since the last check."),
+		errors,
+		(unsigned) m_validator->getProblems().size() - errors,
+		m_validator->getNumberOfPipes(),
+		m_validator->getNumberOfCheckedPipes(),
+		m_validator->getNumberOfReadFiles()
+	));
+}
+
+void SampleValidationDialog::FillList() {
+	int severity = m_severityChoice->GetSelection();
+	int type = m_typeChoice->GetSelection() - 1;
+	wxString filter = m_filterField->GetValue().Lower();
+
+	m_problemList->Freeze();
+	m_problemList->DeleteAllItems();
+	long row = 0;
+	for (const SampleValidator::PROBLEM &problem : m_validator->getProblems()) {
+		if ((severity == 1 && !problem.isError) || (severity == 2 && problem.isError))
+			continue;
+		if (type >= 0 && problem.type != type)
+			continue;
+		if (!filter.IsEmpty() && problem.rankName.Lower().Find(filter) == wxNOT_FOUND && problem.sampleName.Lower().Find(filter) == wxNOT_FOUND && problem.message.Lower().Find(filter) == wxNOT_FOUND)
+			continue;
+		m_problemList->InsertItem(row, problem.isError ? wxT("Error") : wxT("Warning"));
+		m_problemList->SetItem(row, 1, SampleValidator::getTypeName(problem.type));
+		m_problemList->SetItem(row, 2, problem.rankName);
+		m_problemList->SetItem(row, 3, GOODF_functions::number_format(problem.pipeIndex + 1));
+		m_problemList->SetItem(row, 4, problem.sampleName);
+		m_problemList->SetItem(row, 5, problem.message);
+		row++;
+	}
+	m_problemList->Thaw();
+}
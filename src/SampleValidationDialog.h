@@ -0,0 +1,82 @@
+/*
+ * SampleValidationDialog.h is part of GoOdf.
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * GoOdf is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GoOdf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GoOdf.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#ifndef SAMPLEVALIDATIONDIALOG_H
+#define SAMPLEVALIDATIONDIALOG_H
+
+#include <wx/wx.h>
+#include <wx/listctrl.h>
+#include "SampleValidator.h"
+
+class SampleValidationDialog : public wxDialog {
+	DECLARE_CLASS(SampleValidationDialog)
+	DECLARE_EVENT_TABLE()
+
+public:
+	// Constructors
+	SampleValidationDialog(SampleValidator *validator, const std::vector<std::pair<Rank*, wxString>> &ranks);
+	SampleValidationDialog(
+		SampleValidator *validator,
+		const std::vector<std::pair<Rank*, wxString>> &ranks,
+		wxWindow* parent,
+		wxWindowID id = wxID_ANY,
+		const wxString& caption = wxT("Sample validation"),
+		const wxPoint& pos = wxDefaultPosition,
+		const wxSize& size = wxDefaultSize,
+		long style = wxCAPTION|wxRESIZE_BORDER|wxSYSTEM_MENU|wxCLOSE_BOX
+	);
+
+	~SampleValidationDialog();
+
+	// Initialize our variables
+	void Init(SampleValidator *validator, const std::vector<std::pair<Rank*, wxString>> &ranks);
+
+	// Creation
+	bool Create(
+		wxWindow* parent,
+		wxWindowID id = wxID_ANY,
+		const wxString& caption = wxT("Sample validation"),
+		const wxPoint& pos = wxDefaultPosition,
+		const wxSize& size = wxDefaultSize,
+		long style = wxCAPTION|wxRESIZE_BORDER|wxSYSTEM_MENU|wxCLOSE_BOX
+	);
+
+	// Creates the controls and sizers
+	void CreateControls();
+
+private:
+	SampleValidator *m_validator;
+	std::vector<std::pair<Rank*, wxString>> m_ranks;
+
+	wxStaticText *m_summaryText;
+	wxChoice *m_severityChoice;
+	wxChoice *m_typeChoice;
+	wxTextCtrl *m_filterField;
+	wxListCtrl *m_problemList;
+
+	// Event methods
+	void OnFilterChange(wxCommandEvent& event);
+	void OnRecheckBtn(wxCommandEvent& event);
+
+	void UpdateSummary();
+	void FillList();
+};
+
+#endif
@@ -0,0 +1,469 @@
+/*
+ * SampleValidator.cpp is part of GoOdf.
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * GoOdf is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GoOdf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GoOdf.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#include "SampleValidator.h"
+#include "Rank.h"
+#include "WAVfileParser.h"
+#include "WorkerPool.h"
+#include "Instrumentation.h"
+#include "GOODFFunctions.h"
+#include <wx/filename.h>
+#include <algorithm>
+
+namespace {
+
+	// The value most samples of a rank have
+	unsigned getMostCommon(const std::map<unsigned, unsigned> &counts) {
+		unsigned value = 0;
+		unsigned count = 0;
+		for (const std::pair<const unsigned, unsigned> &entry : counts) {
+			if (entry.second > count) {
+				value = entry.first;
+				count = entry.second;
+			}
+		}
+		return value;
+	}
+
+}
+
+SampleValidator::SampleValidator() {
+	m_numberOfPipes = 0;
+	m_numberOfCheckedPipes = 0;
+	m_numberOfReadFiles = 0;
+}
+
+SampleValidator::~SampleValidator() {
+
+}
+
+bool SampleValidator::validate(const std::vector<std::pair<Rank*, wxString>> &ranks, const std::function<bool(size_t, size_t)> &progress) {
+	ScopedTimer timer("analysis.validateSamples");
+	m_problems.clear();
+	m_numberOfPipes = 0;
+	m_numberOfCheckedPipes = 0;
+	m_numberOfReadFiles = 0;
+
+	std::vector<wxString> paths;
+	std::map<wxString, size_t> pathIndexes;
+	// the indexes of the files each rank uses
+	std::vector<std::vector<size_t>> rankPaths(ranks.size());
+	auto collectPath = [&](const wxString &fullPath, std::vector<size_t> &used) {
+		if (!GOODF_functions::isSampleFilePath(fullPath))
+			return;
+		std::map<wxString, size_t>::iterator it = pathIndexes.find(fullPath);
+		if (it == pathIndexes.end()) {
+			it = pathIndexes.insert(std::make_pair(fullPath, paths.size())).first;
+			paths.push_back(fullPath);
+		}
+		used.push_back(it->second);
+	};
+	for (size_t i = 0; i < ranks.size(); i++) {
+		ranks[i].first->loadPipes();
+		for (Pipe &pipe : ranks[i].first->m_pipes) {
+			for (Attack &atk : pipe.m_attacks)
+				collectPath(atk.fullPath, rankPaths[i]);
+			for (Release &rel : pipe.m_releases)
+				collectPath(rel.fullPath, rankPaths[i]);
+		}
+	}
+
+	// every file is stat'ed but only the changed ones are read again, the
+	// workers only read the previous results which are replaced afterwards
+	std::vector<FILE_INFO> infos(paths.size());
+	std::vector<char> isRead(paths.size(), 0);
+	std::vector<char> isChanged(paths.size(), 0);
+	size_t total = paths.size();
+	bool completed = WorkerPool::run(
+		total,
+		[&](size_t index) {
+			FILE_INFO &info = infos[index];
+			wxFileName file(paths[index]);
+			Instrumentation::count(Instrumentation::FILES_STATTED);
+			info.fileSize = file.GetSize();
+			info.exists = info.fileSize != wxInvalidSize;
+			info.modificationTime = info.exists ? file.GetModificationTime().GetTicks() : 0;
+			const FILE_INFO *previous = getFileInfo(paths[index]);
+			if (previous && previous->exists == info.exists && previous->fileSize == info.fileSize && previous->modificationTime == info.modificationTime) {
+				info = *previous;
+				return;
+			}
+			isChanged[index] = 1;
+			if (info.exists) {
+				readFileInfo(paths[index], info);
+				isRead[index] = 1;
+			} else {
+				info.isReadable = false;
+				info.numberOfFrames = 0;
+				info.numberOfChannels = 0;
+				info.sampleRate = 0;
+				info.cuePoint = -1;
+			}
+		},
+		[&](size_t done) { return !progress || progress(done, total); }
+	);
+	if (!completed)
+		return false;
+
+	m_files.clear();
+	for (size_t i = 0; i < paths.size(); i++) {
+		m_files[paths[i]] = infos[i];
+		m_numberOfReadFiles += isRead[i];
+	}
+
+	// A rank whose section cache is still the one stored when it was last
+	// validated hasn't been edited since, so unless one of its files
+	// changed its pipes keep their results without being looked at.
+	// Otherwise each pipe is fingerprinted and checked if that is new.
+	struct PIPE_JOB {
+		size_t rankIndex;
+		unsigned pipeIndex;
+		const Pipe *pipe;
+		wxString fingerprint;
+		bool isChecked;
+		std::vector<PROBLEM> problems;
+	};
+	std::vector<PIPE_JOB> jobs;
+	std::vector<char> isRankUnchanged(ranks.size(), 0);
+	for (size_t i = 0; i < ranks.size(); i++) {
+		Rank *rank = ranks[i].first;
+		std::map<Rank*, RANK_RECORD>::const_iterator record = m_rankRecords.find(rank);
+		bool isUnchanged = record != m_rankRecords.end() &&
+			rank->m_sectionCache.isValid() &&
+			record->second.stamp == rank->m_sectionCache.getStamp() &&
+			record->second.rankName == ranks[i].second &&
+			record->second.fingerprints.size() == rank->m_pipes.size();
+		for (size_t j = 0; isUnchanged && j < rankPaths[i].size(); j++) {
+			if (isChanged[rankPaths[i][j]])
+				isUnchanged = false;
+		}
+		isRankUnchanged[i] = isUnchanged;
+		if (isUnchanged)
+			continue;
+		unsigned pipeIndex = 0;
+		for (Pipe &pipe : rank->m_pipes) {
+			PIPE_JOB job;
+			job.rankIndex = i;
+			job.pipeIndex = pipeIndex++;
+			job.pipe = &pipe;
+			job.isChecked = false;
+			jobs.push_back(job);
+		}
+	}
+
+	// the pipes are only read by the workers and nothing can edit them
+	// while the pool runs
+	total = jobs.size();
+	completed = WorkerPool::run(
+		total,
+		[&](size_t index) {
+			PIPE_JOB &job = jobs[index];
+			const wxString &rankName = ranks[job.rankIndex].second;
+			job.fingerprint = getFingerprint(rankName, job.pipeIndex, *job.pipe);
+			std::map<wxString, std::vector<PROBLEM>>::const_iterator previous = m_pipeProblems.find(job.fingerprint);
+			if (previous != m_pipeProblems.end()) {
+				job.problems = previous->second;
+			} else {
+				checkPipe(rankName, job.pipeIndex, *job.pipe, job.problems);
+				job.isChecked = true;
+			}
+		},
+		[&](size_t done) { return !progress || progress(done, total); }
+	);
+	if (!completed)
+		return false;
+
+	// pipes and ranks that aren't part of the organ anymore are forgotten
+	std::map<wxString, std::vector<PROBLEM>> pipeProblems;
+	std::map<Rank*, RANK_RECORD> rankRecords;
+	std::vector<PIPE_JOB>::iterator job = jobs.begin();
+	for (size_t i = 0; i < ranks.size(); i++) {
+		Rank *rank = ranks[i].first;
+		RANK_RECORD &record = rankRecords[rank];
+		if (isRankUnchanged[i]) {
+			record = m_rankRecords[rank];
+			for (const wxString &fingerprint : record.fingerprints) {
+				std::vector<PROBLEM> &problems = pipeProblems[fingerprint];
+				problems = m_pipeProblems[fingerprint];
+				m_problems.insert(m_problems.end(), problems.begin(), problems.end());
+			}
+		} else {
+			record.rankName = ranks[i].second;
+			record.stamp = rank->m_sectionCache.isValid() ? rank->m_sectionCache.getStamp() : 0;
+			for (; job != jobs.end() && job->rankIndex == i; ++job) {
+				record.fingerprints.push_back(job->fingerprint);
+				if (job->isChecked)
+					m_numberOfCheckedPipes++;
+				m_problems.insert(m_problems.end(), job->problems.begin(), job->problems.end());
+				pipeProblems[job->fingerprint].swap(job->problems);
+			}
+		}
+		m_numberOfPipes += rank->m_pipes.size();
+		checkRankFormats(ranks[i].second, rank);
+	}
+	m_pipeProblems.swap(pipeProblems);
+	m_rankRecords.swap(rankRecords);
+	return true;
+}
+
+const std::vector<SampleValidator::PROBLEM>& SampleValidator::getProblems() const {
+	return m_problems;
+}
+
+unsigned SampleValidator::getNumberOfPipes() const {
+	return m_numberOfPipes;
+}
+
+unsigned SampleValidator::getNumberOfCheckedPipes() const {
+	return m_numberOfCheckedPipes;
+}
+
+unsigned SampleValidator::getNumberOfReadFiles() const {
+	return m_numberOfReadFiles;
+}
+
+wxString SampleValidator::getTypeName(PROBLEM_TYPE type) {
+	switch (type) {
+		case MISSING_FILE:
+			return wxT("Missing file");
+		case UNREADABLE_FILE:
+			return wxT("Unreadable file");
+		case LOOP_PROBLEM:
+			return wxT("Loop");
+		case CUE_POINT_PROBLEM:
+			return wxT("Cue point");
+		case OFFSET_PROBLEM:
+			return wxT("Start/end");
+		case FORMAT_MISMATCH:
+			return wxT("Format mismatch");
+		default:
+			return wxEmptyString;
+	}
+}
+
+void SampleValidator::readFileInfo(const wxString &path, FILE_INFO &info) {
+	WAVfileParser sample(path);
+	info.isReadable = sample.isWavOk();
+	info.errorMessage = sample.getErrorMessage();
+	info.numberOfFrames = sample.getNumberOfFrames();
+	info.numberOfChannels = sample.getNumberOfChannels();
+	info.sampleRate = sample.getSampleRate();
+	info.cuePoint = sample.getNumberOfCues() > 0 ? (int) sample.getCuepointAtIndex(0).dwSampleOffset : -1;
+	info.loops.clear();
+	for (unsigned i = 0; i < sample.getNumberOfLoops(); i++) {
+		LOOP loop = sample.getLoopAtIndex(i);
+		info.loops.push_back(std::make_pair(loop.dwStart, loop.dwEnd));
+	}
+}
+
+const SampleValidator::FILE_INFO* SampleValidator::getFileInfo(const wxString &path) const {
+	std::map<wxString, FILE_INFO>::const_iterator it = m_files.find(path);
+	if (it == m_files.end())
+		return NULL;
+	return &it->second;
+}
+
+wxString SampleValidator::getFingerprint(const wxString &rankName, unsigned pipeIndex, const Pipe &pipe) const {
+	// everything checkPipe looks at, the stamps of the files included
+	wxString fingerprint = rankName;
+	fingerprint.append(wxT('|'));
+	GOODF_functions::appendNumber(fingerprint, pipeIndex);
+	auto appendFile = [this, &fingerprint](const wxString &path) {
+		fingerprint.append(wxT('|'));
+		fingerprint.append(path);
+		const FILE_INFO *info = getFileInfo(path);
+		if (info && info->exists) {
+			fingerprint.append(wxT('@'));
+			fingerprint.append(info->fileSize.ToString());
+			fingerprint.append(wxT('@'));
+			fingerprint.append(wxString::Format(wxT("%lld"), (long long) info->modificationTime));
+		}
+	};
+	for (const Attack &atk : pipe.m_attacks) {
+		appendFile(atk.fullPath);
+		fingerprint.append(wxT('|'));
+		GOODF_functions::appendNumber(fingerprint, atk.attackStart);
+		fingerprint.append(wxT(','));
+		GOODF_functions::appendNumber(fingerprint, atk.cuePoint);
+		fingerprint.append(wxT(','));
+		GOODF_functions::appendNumber(fingerprint, atk.releaseEnd);
+		fingerprint.append(atk.loadRelease ? wxT(",Y") : wxT(",N"));
+		for (const Loop &loop : atk.m_loops) {
+			fingerprint.append(wxT(','));
+			GOODF_functions::appendNumber(fingerprint, loop.start);
+			fingerprint.append(wxT('-'));
+			GOODF_functions::appendNumber(fingerprint, loop.end);
+		}
+	}
+	fingerprint.append(wxT("|R"));
+	for (const Release &rel : pipe.m_releases) {
+		appendFile(rel.fullPath);
+		fingerprint.append(wxT('|'));
+		GOODF_functions::appendNumber(fingerprint, rel.cuePoint);
+		fingerprint.append(wxT(','));
+		GOODF_functions::appendNumber(fingerprint, rel.releaseEnd);
+	}
+	return fingerprint;
+}
+
+void SampleValidator::checkPipe(const wxString &rankName, unsigned pipeIndex, const Pipe &pipe, std::vector<PROBLEM> &problems) const {
+	wxString sampleName;
+	auto addProblem = [&](PROBLEM_TYPE type, bool isError, const wxString &message) {
+		PROBLEM problem;
+		problem.type = type;
+		problem.isError = isError;
+		problem.rankName = rankName;
+		problem.pipeIndex = pipeIndex;
+		problem.sampleName = sampleName;
+		problem.message = message;
+		problems.push_back(problem);
+	};
+	// the common checks of attacks and releases, returns the info of a
+	// readable file
+	auto checkFile = [&](const wxString &fullPath) -> const FILE_INFO* {
+		const FILE_INFO *info = getFileInfo(fullPath);
+		if (!info || !info->exists) {
+			addProblem(MISSING_FILE, true, wxT("The sample file doesn't exist."));
+			return NULL;
+		}
+		if (!info->isReadable) {
+			wxString message = info->errorMessage;
+			addProblem(UNREADABLE_FILE, true, message.IsEmpty() ? wxString(wxT("The sample file can't be read.")) : message.Trim());
+			return NULL;
+		}
+		return info;
+	};
+	auto checkCueAndEnd = [&](const FILE_INFO *info, int cuePoint, int releaseEnd) {
+		if (cuePoint >= 0 && (unsigned) cuePoint >= info->numberOfFrames)
+			addProblem(CUE_POINT_PROBLEM, true, wxString::Format(wxT("CuePoint %i is beyond the %u frames of the sample."), cuePoint, info->numberOfFrames));
+		if (releaseEnd >= 0 && (unsigned) releaseEnd >= info->numberOfFrames)
+			addProblem(OFFSET_PROBLEM, true, wxString::Format(wxT("ReleaseEnd %i is beyond the %u frames of the sample."), releaseEnd, info->numberOfFrames));
+		int usedCuePoint = cuePoint >= 0 ? cuePoint : info->cuePoint;
+		if (releaseEnd >= 0 && usedCuePoint >= 0 && releaseEnd <= usedCuePoint)
+			addProblem(OFFSET_PROBLEM, true, wxString::Format(wxT("ReleaseEnd %i is not after the cue point %i."), releaseEnd, usedCuePoint));
+	};
+
+	unsigned index = 0;
+	for (const Attack &atk : pipe.m_attacks) {
+		index++;
+		if (!GOODF_functions::isSampleFilePath(atk.fullPath))
+			continue;
+		sampleName = wxString::Format(wxT("Attack %u: "), index) + atk.fileName;
+		const FILE_INFO *info = checkFile(atk.fullPath);
+		if (!info)
+			continue;
+		if (atk.attackStart > 0 && (unsigned) atk.attackStart >= info->numberOfFrames)
+			addProblem(OFFSET_PROBLEM, true, wxString::Format(wxT("AttackStart %i is beyond the %u frames of the sample."), atk.attackStart, info->numberOfFrames));
+
+		// the loops of the attack replace those of the file
+		std::vector<std::pair<int, int>> loops;
+		for (const Loop &loop : atk.m_loops)
+			loops.push_back(std::make_pair(loop.start, loop.end));
+		bool isFromFile = loops.empty();
+		if (isFromFile) {
+			for (const std::pair<unsigned, unsigned> &loop : info->loops)
+				loops.push_back(std::make_pair((int) loop.first, (int) loop.second));
+		}
+		for (unsigned i = 0; i < loops.size(); i++) {
+			wxString loopName = wxString::Format(isFromFile ? wxT("Loop %u of the sample") : wxT("Loop %u"), i + 1);
+			int start = loops[i].first;
+			int end = loops[i].second;
+			if (start < 0 || start >= end)
+				addProblem(LOOP_PROBLEM, true, loopName + wxString::Format(wxT(" (%i-%i) doesn't end after it starts."), start, end));
+			else if ((unsigned) end >= info->numberOfFrames)
+				addProblem(LOOP_PROBLEM, true, loopName + wxString::Format(wxT(" (%i-%i) ends beyond the %u frames of the sample."), start, end, info->numberOfFrames));
+			else if (start < atk.attackStart)
+				addProblem(LOOP_PROBLEM, false, loopName + wxString::Format(wxT(" (%i-%i) starts before AttackStart %i."), start, end, atk.attackStart));
+		}
+		checkCueAndEnd(info, atk.cuePoint, atk.releaseEnd);
+	}
+
+	index = 0;
+	for (const Release &rel : pipe.m_releases) {
+		index++;
+		if (!GOODF_functions::isSampleFilePath(rel.fullPath))
+			continue;
+		sampleName = wxString::Format(wxT("Release %u: "), index) + rel.fileName;
+		const FILE_INFO *info = checkFile(rel.fullPath);
+		if (info)
+			checkCueAndEnd(info, rel.cuePoint, rel.releaseEnd);
+	}
+}
+
+void SampleValidator::checkRankFormats(const wxString &rankName, Rank *rank) {
+	// GrandOrgue plays samples of any format, but differing ones in a rank
+	// are usually a mistake when the samples were prepared
+	std::map<unsigned, unsigned> sampleRates;
+	std::map<unsigned, unsigned> channels;
+	for (Pipe &pipe : rank->m_pipes) {
+		for (Attack &atk : pipe.m_attacks) {
+			const FILE_INFO *info = getFileInfo(atk.fullPath);
+			if (info && info->isReadable) {
+				sampleRates[info->sampleRate]++;
+				channels[info->numberOfChannels]++;
+			}
+		}
+		for (Release &rel : pipe.m_releases) {
+			const FILE_INFO *info = getFileInfo(rel.fullPath);
+			if (info && info->isReadable) {
+				sampleRates[info->sampleRate]++;
+				channels[info->numberOfChannels]++;
+			}
+		}
+	}
+	if (sampleRates.size() < 2 && channels.size() < 2)
+		return;
+	unsigned commonRate = getMostCommon(sampleRates);
+	unsigned commonChannels = getMostCommon(channels);
+
+	auto checkSample = [&](unsigned pipeIndex, const wxString &sampleName, const wxString &fullPath) {
+		const FILE_INFO *info = getFileInfo(fullPath);
+		if (!info || !info->isReadable)
+			return;
+		wxString message;
+		if (info->sampleRate != commonRate)
+			message = wxString::Format(wxT("The sample rate is %u Hz while most samples of the rank have %u Hz."), info->sampleRate, commonRate);
+		if (info->numberOfChannels != commonChannels) {
+			if (!message.IsEmpty())
+				message += wxT(" ");
+			message += wxString::Format(wxT("The sample has %u channel(s) while most samples of the rank have %u."), info->numberOfChannels, commonChannels);
+		}
+		if (message.IsEmpty())
+			return;
+		PROBLEM problem;
+		problem.type = FORMAT_MISMATCH;
+		problem.isError = false;
+		problem.rankName = rankName;
+		problem.pipeIndex = pipeIndex;
+		problem.sampleName = sampleName;
+		problem.message = message;
+		m_problems.push_back(problem);
+	};
+	unsigned pipeIndex = 0;
+	for (Pipe &pipe : rank->m_pipes) {
+		unsigned index = 0;
+		for (Attack &atk : pipe.m_attacks)
+			checkSample(pipeIndex, wxString::Format(wxT("Attack %u: "), ++index) + atk.fileName, atk.fullPath);
+		index = 0;
+		for (Release &rel : pipe.m_releases)
+			checkSample(pipeIndex, wxString::Format(wxT("Release %u: "), ++index) + rel.fileName, rel.fullPath);
+		pipeIndex++;
+	}
+}
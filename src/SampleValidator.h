@@ -0,0 +1,116 @@
+/*
+ * SampleValidator.h is part of GoOdf.
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * GoOdf is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GoOdf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GoOdf.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#ifndef SAMPLEVALIDATOR_H
+#define SAMPLEVALIDATOR_H
+
+#include <wx/wx.h>
+#include <vector>
+#include <map>
+#include <functional>
+
+class Rank;
+class Pipe;
+
+// Checks the attacks, releases and loops of ranks against the metadata of
+// their sample files: missing or unreadable files, offsets and loops
+// beyond the end of the audio or in the wrong order, and samples whose
+// sample rate or channel count differ from the rest of their rank. Only
+// the headers are read, on the worker pool. The validator is meant to be
+// kept and run again after editing: a file is only read again when its
+// size or modification time changed and a pipe is only checked again
+// when its samples or their files changed. A rank whose section cache
+// is still the one it had when it was validated hasn't been edited since,
+// so its pipes aren't even fingerprinted.
+class SampleValidator {
+public:
+	enum PROBLEM_TYPE {
+		MISSING_FILE = 0,
+		UNREADABLE_FILE,
+		LOOP_PROBLEM,
+		CUE_POINT_PROBLEM,
+		OFFSET_PROBLEM,
+		FORMAT_MISMATCH,
+		NUMBER_OF_PROBLEM_TYPES
+	};
+
+	struct PROBLEM {
+		PROBLEM_TYPE type;
+		// otherwise a warning about something GrandOrgue accepts
+		bool isError;
+		wxString rankName;
+		unsigned pipeIndex;
+		wxString sampleName;
+		wxString message;
+	};
+
+	SampleValidator();
+	~SampleValidator();
+
+	// The progress gets the number of checked sample files and the total
+	// number of them, then the same for the pipes, and can return false to
+	// cancel the validation
+	bool validate(const std::vector<std::pair<Rank*, wxString>> &ranks, const std::function<bool(size_t, size_t)> &progress = nullptr);
+	const std::vector<PROBLEM>& getProblems() const;
+	unsigned getNumberOfPipes() const;
+	// of the last validation, the others had the same result as before
+	unsigned getNumberOfCheckedPipes() const;
+	unsigned getNumberOfReadFiles() const;
+
+	static wxString getTypeName(PROBLEM_TYPE type);
+
+private:
+	struct FILE_INFO {
+		bool exists;
+		wxULongLong fileSize;
+		time_t modificationTime;
+		bool isReadable;
+		wxString errorMessage;
+		unsigned numberOfFrames;
+		unsigned numberOfChannels;
+		unsigned sampleRate;
+		int cuePoint;
+		std::vector<std::pair<unsigned, unsigned>> loops;
+	};
+
+	struct RANK_RECORD {
+		wxString rankName;
+		// of the rank's section cache when it was validated
+		unsigned long long stamp;
+		std::vector<wxString> fingerprints;
+	};
+
+	std::map<wxString, FILE_INFO> m_files;
+	// the problems of each pipe by everything they were found from
+	std::map<wxString, std::vector<PROBLEM>> m_pipeProblems;
+	std::map<Rank*, RANK_RECORD> m_rankRecords;
+	std::vector<PROBLEM> m_problems;
+	unsigned m_numberOfPipes;
+	unsigned m_numberOfCheckedPipes;
+	unsigned m_numberOfReadFiles;
+
+	static void readFileInfo(const wxString &path, FILE_INFO &info);
+	const FILE_INFO* getFileInfo(const wxString &path) const;
+	wxString getFingerprint(const wxString &rankName, unsigned pipeIndex, const Pipe &pipe) const;
+	void checkPipe(const wxString &rankName, unsigned pipeIndex, const Pipe &pipe, std::vector<PROBLEM> &problems) const;
+	void checkRankFormats(const wxString &rankName, Rank *rank);
+};
+
+#endif
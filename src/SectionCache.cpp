@@ -0,0 +1,66 @@
+/*
+ * SectionCache.cpp is part of GoOdf.
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * GoOdf is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GoOdf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GoOdf.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#include "SectionCache.h"
+
+unsigned long long SectionCache::m_lastStamp = 0;
+
+SectionCache::SectionCache() {
+	m_isValid = false;
+	m_stamp = 0;
+}
+
+SectionCache::SectionCache(const SectionCache& WXUNUSED(c)) {
+	m_isValid = false;
+	m_stamp = 0;
+}
+
+SectionCache::~SectionCache() {
+
+}
+
+bool SectionCache::isValid() const {
+	return m_isValid;
+}
+
+void SectionCache::invalidate() {
+	if (!m_isValid)
+		return;
+	m_lines.Clear();
+	m_isValid = false;
+}
+
+void SectionCache::store(wxTextFile *section) {
+	m_lines.Clear();
+	m_lines.Alloc(section->GetLineCount());
+	for (size_t i = 0; i < section->GetLineCount(); i++)
+		m_lines.Add(section->GetLine(i));
+	m_isValid = true;
+	m_stamp = ++m_lastStamp;
+}
+
+void SectionCache::writeTo(wxTextFile *outFile) const {
+	for (size_t i = 0; i < m_lines.GetCount(); i++)
+		outFile->AddLine(m_lines[i]);
+}
+
+unsigned long long SectionCache::getStamp() const {
+	return m_stamp;
+}
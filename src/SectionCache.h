@@ -0,0 +1,52 @@
+/*
+ * SectionCache.h is part of GoOdf.
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * GoOdf is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GoOdf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GoOdf.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#ifndef SECTIONCACHE_H
+#define SECTIONCACHE_H
+
+#include <wx/wx.h>
+#include <wx/textfile.h>
+
+// Holds the lines an element produced the last time it was written so that
+// an unchanged element can be spliced into the next save without being
+// serialized again. A copied element always starts with an invalid cache.
+class SectionCache {
+public:
+	SectionCache();
+	SectionCache(const SectionCache& c);
+	~SectionCache();
+
+	bool isValid() const;
+	void invalidate();
+	void store(wxTextFile *section);
+	void writeTo(wxTextFile *outFile) const;
+	// Identifies what was stored, every store gets a new stamp
+	unsigned long long getStamp() const;
+
+private:
+	wxArrayString m_lines;
+	bool m_isValid;
+	unsigned long long m_stamp;
+
+	static unsigned long long m_lastStamp;
+
+};
+
+#endif
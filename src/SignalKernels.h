@@ -0,0 +1,138 @@
+/*
+ * SignalKernels.h is part of GoOdf.
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * GoOdf is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GoOdf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GoOdf.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#ifndef SIGNALKERNELS_H
+#define SIGNALKERNELS_H
+
+#include <cstddef>
+#include <cmath>
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#define GOODF_SIGNAL_KERNELS_SSE
+#include <xmmintrin.h>
+#endif
+
+// Inner loops of the sample analysis. They work on four values at a time,
+// with SSE where the compiler targets it and otherwise with four separate
+// sums that the compiler is free to vectorize.
+namespace SignalKernels {
+
+	inline float dotProduct(const float *a, const float *b, size_t length) {
+		size_t i = 0;
+#ifdef GOODF_SIGNAL_KERNELS_SSE
+		__m128 sum = _mm_setzero_ps();
+		for (; i + 4 <= length; i += 4)
+			sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+		float lanes[4];
+		_mm_storeu_ps(lanes, sum);
+#else
+		float lanes[4] = { 0, 0, 0, 0 };
+		for (; i + 4 <= length; i += 4) {
+			lanes[0] += a[i] * b[i];
+			lanes[1] += a[i + 1] * b[i + 1];
+			lanes[2] += a[i + 2] * b[i + 2];
+			lanes[3] += a[i + 3] * b[i + 3];
+		}
+#endif
+		float result = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+		for (; i < length; i++)
+			result += a[i] * b[i];
+		return result;
+	}
+
+	inline float sumOfSquares(const float *a, size_t length) {
+		return dotProduct(a, a, length);
+	}
+
+	// Sum of the squared differences between a and b
+	inline float squaredDistance(const float *a, const float *b, size_t length) {
+		size_t i = 0;
+#ifdef GOODF_SIGNAL_KERNELS_SSE
+		__m128 sum = _mm_setzero_ps();
+		for (; i + 4 <= length; i += 4) {
+			__m128 diff = _mm_sub_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i));
+			sum = _mm_add_ps(sum, _mm_mul_ps(diff, diff));
+		}
+		float lanes[4];
+		_mm_storeu_ps(lanes, sum);
+#else
+		float lanes[4] = { 0, 0, 0, 0 };
+		for (; i + 4 <= length; i += 4) {
+			for (int j = 0; j < 4; j++) {
+				float diff = a[i + j] - b[i + j];
+				lanes[j] += diff * diff;
+			}
+		}
+#endif
+		float result = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+		for (; i < length; i++) {
+			float diff = a[i] - b[i];
+			result += diff * diff;
+		}
+		return result;
+	}
+
+	inline float peakAbsolute(const float *a, size_t length) {
+		size_t i = 0;
+#ifdef GOODF_SIGNAL_KERNELS_SSE
+		const __m128 signMask = _mm_set1_ps(-0.0f);
+		__m128 peak = _mm_setzero_ps();
+		for (; i + 4 <= length; i += 4)
+			peak = _mm_max_ps(peak, _mm_andnot_ps(signMask, _mm_loadu_ps(a + i)));
+		float lanes[4];
+		_mm_storeu_ps(lanes, peak);
+#else
+		float lanes[4] = { 0, 0, 0, 0 };
+		for (; i + 4 <= length; i += 4) {
+			for (int j = 0; j < 4; j++)
+				lanes[j] = std::fmax(lanes[j], std::fabs(a[i + j]));
+		}
+#endif
+		float result = std::fmax(std::fmax(lanes[0], lanes[1]), std::fmax(lanes[2], lanes[3]));
+		for (; i < length; i++)
+			result = std::fmax(result, std::fabs(a[i]));
+		return result;
+	}
+
+	// Copies one channel out of interleaved frames
+	inline void extractChannel(const float *interleaved, unsigned numberOfChannels, unsigned channel, float *out, size_t frames) {
+		for (size_t i = 0; i < frames; i++)
+			out[i] = interleaved[i * numberOfChannels + channel];
+	}
+
+	// Averages all channels of interleaved frames
+	inline void mixToMono(const float *interleaved, unsigned numberOfChannels, float *out, size_t frames) {
+		if (numberOfChannels == 1) {
+			for (size_t i = 0; i < frames; i++)
+				out[i] = interleaved[i];
+			return;
+		}
+		float scale = 1.0f / numberOfChannels;
+		for (size_t i = 0; i < frames; i++) {
+			float sum = 0;
+			for (unsigned c = 0; c < numberOfChannels; c++)
+				sum += interleaved[i * numberOfChannels + c];
+			out[i] = sum * scale;
+		}
+	}
+
+}
+
+#endif
@@ -19,7 +19,7 @@
  */
 
 #include "Stop.h"
-#include "GOODF.h"
+#include "Organ.h"
 #include "GOODFFunctions.h"
 
 Stop::Stop() : Drawstop() {
@@ -49,7 +49,7 @@ void Stop::write(wxTextFile *outFile) {
 			outFile->AddLine(wxT("NumberOfRanks=") + wxString::Format(wxT("%u"), nbRanks));
 			unsigned counter = 1;
 			for (auto& rankRef : m_referencedRanks) {
-				unsigned refRankId = ::wxGetApp().m_frame->m_organ->getIndexOfOrganRank(rankRef.m_rankReference);
+				unsigned refRankId = OrganContext::current()->getOrgan()->getIndexOfOrganRank(rankRef.m_rankReference);
 				wxString rankId = wxT("Rank") + GOODF_functions::number_format(counter);
 				wxString refId = GOODF_functions::number_format(refRankId);
 				outFile->AddLine(rankId + wxT("=") + refId);
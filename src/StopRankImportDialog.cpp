@@ -34,12 +34,13 @@ BEGIN_EVENT_TABLE(StopRankImportDialog, wxDialog)
 	EVT_BUTTON(ID_STOP_RANK_IMPORT_BTN, StopRankImportDialog::OnDoImportBtn)
 END_EVENT_TABLE()
 
-StopRankImportDialog::StopRankImportDialog(Organ *source, Organ *target) {
-	Init(source, target);
+StopRankImportDialog::StopRankImportDialog(Organ *source, OdfSectionIndex *sourceIndex, Organ *target) {
+	Init(source, sourceIndex, target);
 }
 
 StopRankImportDialog::StopRankImportDialog(
 	Organ *source,
+	OdfSectionIndex *sourceIndex,
 	Organ *target,
 	wxWindow* parent,
 	wxWindowID id,
@@ -48,7 +49,7 @@ StopRankImportDialog::StopRankImportDialog(
 	const wxSize& size,
 	long style
 ) {
-	Init(source, target);
+	Init(source, sourceIndex, target);
 	Create(parent, id, caption, pos, size, style);
 }
 
@@ -56,9 +57,11 @@ StopRankImportDialog::~StopRankImportDialog() {
 
 }
 
-void StopRankImportDialog::Init(Organ *source, Organ *target) {
+void StopRankImportDialog::Init(Organ *source, OdfSectionIndex *sourceIndex, Organ *target) {
 	m_targetOrgan = target;
 	m_sourceOrgan = source;
+	m_sourceIndex = sourceIndex;
+	ReadSourceStructure();
 
 	for (unsigned i = 0; i < m_targetOrgan->getNumberOfManuals(); i++) {
 		m_targetManualList.Add(m_targetOrgan->getOrganManualAt(i)->getName());
@@ -248,7 +251,7 @@ void StopRankImportDialog::OnAvailableStopRankSelection(wxCommandEvent& WXUNUSED
 	int stopCount = m_availableStopList->GetSelections(selectedStops);
 	if (!selectedStops.IsEmpty()) {
 		for (int i = 0; i < stopCount; i++) {
-			Stop *s = m_sourceOrgan->getOrganStopAt(selectedStops[i]);
+			Stop *s = GetSourceStop(selectedStops[i]);
 			if (s->isUsingInternalRank()) {
 				std::vector<Stop*> dependsOn;
 				for (Pipe p : s->getInternalRank()->m_pipes) {
@@ -294,7 +297,8 @@ void StopRankImportDialog::OnAvailableStopRankSelection(wxCommandEvent& WXUNUSED
 	int rankCount = m_availableRankList->GetSelections(selectedRanks);
 	if (!selectedRanks.IsEmpty()) {
 		for (int i = 0; i < rankCount; i++) {
-			Rank *r = m_sourceOrgan->getOrganRankAt(selectedRanks[i]);
+			Rank *r = GetSourceRank(selectedRanks[i]);
+			r->loadPipes();
 			std::vector<Stop*> dependsOn;
 			for (Pipe p : r->m_pipes) {
 				if (p.m_attacks.front().fileName.StartsWith(wxT("REF"))) {
@@ -343,7 +347,7 @@ void StopRankImportDialog::OnDoImportBtn(wxCommandEvent& WXUNUSED(event)) {
 	if (nbrStopsBeforeImport + stopCount < 1000 && nbrRanksBeforeImport + rankCount < 1000) {
 		if (!selectedStops.IsEmpty()) {
 			for (int i = 0; i < stopCount; i++) {
-				Stop *s = m_sourceOrgan->getOrganStopAt(selectedStops[i]);
+				Stop *s = GetSourceStop(selectedStops[i]);
 				Stop importedStop(*s);
 				unsigned manIdx = m_manualChoice->GetSelection();
 				Manual *targetManual = m_targetOrgan->getOrganManualAt(manIdx);
@@ -366,7 +370,8 @@ void StopRankImportDialog::OnDoImportBtn(wxCommandEvent& WXUNUSED(event)) {
 
 		if (!selectedRanks.IsEmpty()) {
 			for (int i = 0; i < rankCount; i++) {
-				Rank *r = m_sourceOrgan->getOrganRankAt(selectedRanks[i]);
+				Rank *r = GetSourceRank(selectedRanks[i]);
+				r->loadPipes();
 				Rank importedRank(*r);
 				if (m_windchestChoice->GetSelection() != wxNOT_FOUND)
 					importedRank.setWindchest(m_targetOrgan->getOrganWindchestgroupAt(m_windchestChoice->GetSelection()));
@@ -433,7 +438,7 @@ void StopRankImportDialog::OnDoImportBtn(wxCommandEvent& WXUNUSED(event)) {
 		// Any rank references must be adjusted correctly
 		if (!selectedStops.IsEmpty()) {
 			for (int i = 0; i < stopCount; i++) {
-				Stop *s = m_sourceOrgan->getOrganStopAt(selectedStops[i]);
+				Stop *s = GetSourceStop(selectedStops[i]);
 				if (!s->isUsingInternalRank()) {
 					Stop *targetStop = m_targetOrgan->getOrganStopAt(nbrStopsBeforeImport + i);
 					for (unsigned j = 0; j < s->getNumberOfRanks(); j++) {
@@ -486,3 +491,107 @@ bool StopRankImportDialog::CanImportButtonBeEnabled() {
 		return false;
 	}
 }
+
+void StopRankImportDialog::ReadSourceStructure() {
+	OrganContextScope contextScope(m_sourceOrgan->getContext());
+	m_sourceOrgan->setOdfRoot(wxFileName(m_sourceIndex->getFilePath()).GetPath());
+	m_sourceOrgan->setChurchName(m_sourceIndex->readValue(wxT("Organ"), wxT("ChurchName")));
+	m_sourceOrgan->setHasPedals(GOODF_functions::parseBoolean(m_sourceIndex->readValue(wxT("Organ"), wxT("HasPedals")), false), true);
+	m_isSourceUsingOldPanelFormat = !m_sourceIndex->hasSection(wxT("Panel000"));
+
+	// the windchests are only there for the ranks to refer to
+	long nbrWindchests = m_sourceIndex->readLong(wxT("Organ"), wxT("NumberOfWindchestGroups"), 0);
+	if (nbrWindchests > 0 && nbrWindchests < 1000) {
+		for (long i = 0; i < nbrWindchests; i++) {
+			wxString windchestGroupName = wxT("WindchestGroup") + GOODF_functions::number_format(i + 1);
+			if (!m_sourceIndex->hasSection(windchestGroupName))
+				continue;
+			Windchestgroup windchest;
+			windchest.setName(m_sourceIndex->getName(windchestGroupName));
+			m_sourceOrgan->addWindchestgroup(windchest);
+		}
+	}
+
+	// ranks are numbered as the parser would have added them
+	long nbrRanks = m_sourceIndex->readLong(wxT("Organ"), wxT("NumberOfRanks"), 0);
+	if (nbrRanks > 0 && nbrRanks < 1000) {
+		for (long i = 0; i < nbrRanks; i++) {
+			wxString rankGroupName = wxT("Rank") + GOODF_functions::number_format(i + 1);
+			if (!m_sourceIndex->hasSection(rankGroupName))
+				continue;
+			Rank r;
+			r.setName(m_sourceIndex->getName(rankGroupName));
+			m_sourceOrgan->addRank(r);
+			m_unreadRankSections.push_back(rankGroupName);
+		}
+	}
+
+	// the stops are added manual by manual, which is also how REF: strings find them
+	long nbrManuals = m_sourceIndex->readLong(wxT("Organ"), wxT("NumberOfManuals"), 0);
+	if ((nbrManuals > 0 && nbrManuals < 17) || (nbrManuals == 0 && m_sourceOrgan->doesHavePedals())) {
+		if (m_sourceOrgan->doesHavePedals())
+			nbrManuals += 1;
+		for (long i = 0; i < nbrManuals; i++) {
+			int manIdxNbr = m_sourceOrgan->doesHavePedals() ? i : i + 1;
+			wxString manGroupName = wxT("Manual") + GOODF_functions::number_format(manIdxNbr);
+			if (!m_sourceIndex->hasSection(manGroupName))
+				continue;
+			Manual m;
+			if (manIdxNbr == 0)
+				m.setIsPedal(true, *m_sourceOrgan->getContext(), true);
+			m.setName(m_sourceIndex->getName(manGroupName));
+			m.setFirstAccessibleKeyMIDINoteNumber(static_cast<int>(m_sourceIndex->readLong(manGroupName, wxT("FirstAccessibleKeyMIDINoteNumber"), 36)));
+			m_sourceOrgan->addManual(m, true);
+			Manual *man = m_sourceOrgan->getOrganManualAt(m_sourceOrgan->getNumberOfManuals() - 1);
+			long nbrStops = m_sourceIndex->readLong(manGroupName, wxT("NumberOfStops"), 0);
+			if (nbrStops > 0 && nbrStops < 1000) {
+				for (long j = 0; j < nbrStops; j++) {
+					long stopIdx = m_sourceIndex->readLong(manGroupName, wxT("Stop") + GOODF_functions::number_format(j + 1), 0);
+					wxString stopGroupName = wxT("Stop") + GOODF_functions::number_format(stopIdx);
+					if (!m_sourceIndex->hasSection(stopGroupName))
+						continue;
+					Stop s;
+					s.setName(m_sourceIndex->getName(stopGroupName));
+					s.setOwningManual(man);
+					m_sourceOrgan->addStop(s, true);
+					man->addStop(m_sourceOrgan->getOrganStopAt(m_sourceOrgan->getNumberOfStops() - 1));
+					m_unreadStopSections.push_back(stopGroupName);
+				}
+			}
+		}
+	}
+}
+
+Stop* StopRankImportDialog::GetSourceStop(unsigned index) {
+	Stop *stop = m_sourceOrgan->getOrganStopAt(index);
+	if (m_unreadStopSections[index].IsEmpty())
+		return stop;
+	wxString stopGroupName = m_unreadStopSections[index];
+	m_unreadStopSections[index] = wxEmptyString;
+
+	// the ranks the stop refers to must be complete before it is read
+	long nbrRanks = m_sourceIndex->readLong(stopGroupName, wxT("NumberOfRanks"), 0);
+	for (long i = 0; i < nbrRanks && i < 1000; i++) {
+		long refRank = m_sourceIndex->readLong(stopGroupName, wxT("Rank") + GOODF_functions::number_format(i + 1), 0);
+		if (refRank > 0 && refRank <= (long) m_sourceOrgan->getNumberOfRanks())
+			GetSourceRank(refRank - 1);
+	}
+	OrganContextScope contextScope(m_sourceOrgan->getContext());
+	wxFileConfig *cfg = m_sourceIndex->createSectionConfig(stopGroupName);
+	stop->read(cfg, m_isSourceUsingOldPanelFormat, stop->getOwningManual(), m_sourceOrgan);
+	delete cfg;
+	return stop;
+}
+
+Rank* StopRankImportDialog::GetSourceRank(unsigned index) {
+	Rank *rank = m_sourceOrgan->getOrganRankAt(index);
+	if (m_unreadRankSections[index].IsEmpty())
+		return rank;
+	OrganContextScope contextScope(m_sourceOrgan->getContext());
+	wxFileConfig *cfg = m_sourceIndex->createSectionConfig(m_unreadRankSections[index]);
+	// the pipes are only read if the rank is imported or inspected for borrowing
+	rank->read(cfg, m_sourceOrgan, true);
+	delete cfg;
+	m_unreadRankSections[index] = wxEmptyString;
+	return rank;
+}
@@ -23,6 +23,8 @@
 
 #include <wx/wx.h>
 #include "Organ.h"
+#include "OdfSectionIndex.h"
+#include <vector>
 
 class StopRankImportDialog : public wxDialog {
 	DECLARE_CLASS(StopRankImportDialog)
@@ -30,9 +32,10 @@ class StopRankImportDialog : public wxDialog {
 
 public:
 	// Constructors
-	StopRankImportDialog(Organ *source, Organ *target);
+	StopRankImportDialog(Organ *source, OdfSectionIndex *sourceIndex, Organ *target);
 	StopRankImportDialog(
 		Organ *source,
+		OdfSectionIndex *sourceIndex,
 		Organ *target,
 		wxWindow* parent,
 		wxWindowID id = wxID_ANY,
@@ -45,7 +48,7 @@ public:
 	~StopRankImportDialog();
 
 	// Initialize our variables
-	void Init(Organ *source, Organ *target);
+	void Init(Organ *source, OdfSectionIndex *sourceIndex, Organ *target);
 
 	// Creation
 	bool Create(
@@ -62,7 +65,13 @@ public:
 
 private:
 	Organ *m_targetOrgan;
+	// The source organ only gets the names and structure at first, the stops
+	// and ranks are read from their sections when they are first needed.
 	Organ *m_sourceOrgan;
+	OdfSectionIndex *m_sourceIndex;
+	bool m_isSourceUsingOldPanelFormat;
+	std::vector<wxString> m_unreadStopSections;
+	std::vector<wxString> m_unreadRankSections;
 	wxArrayString m_targetManualList;
 	wxArrayString m_importStopList;
 	wxArrayString m_importRankList;
@@ -82,6 +91,9 @@ private:
 	void OnManualChoice(wxCommandEvent& event);
 
 	bool CanImportButtonBeEnabled();
+	void ReadSourceStructure();
+	Stop* GetSourceStop(unsigned index);
+	Rank* GetSourceRank(unsigned index);
 };
 
 #endif
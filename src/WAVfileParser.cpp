@@ -19,6 +19,7 @@
  */
 
 #include "WAVfileParser.h"
+#include "Instrumentation.h"
 #include <climits>
 #include <cstdint>
 
@@ -33,6 +34,8 @@ wxString const WAVE_INFO = wxT("INFO");
 wxString const WVPK_ID = wxT("wvpk");
 
 WAVfileParser::WAVfileParser(wxString file) {
+	ScopedTimer timer("scan.parseSampleFile");
+	Instrumentation::count(Instrumentation::FILES_PARSED);
 	m_wavpackUsed = false;
 	m_fileName = file;
 	m_errorMessage = wxEmptyString;
@@ -46,6 +49,7 @@ WAVfileParser::WAVfileParser(wxString file) {
 	m_numberOfFrames = 0;
 	m_dwMIDIUnityNote = 0;
 	m_dwMIDIPitchFraction = 0;
+	m_hasPitchInfo = false;
 	m_lastChunkSizeParsed = 0;
 
 	if (tryParsingFile(m_fileName))
@@ -132,6 +136,10 @@ double WAVfileParser::getPitchFractionCents() {
 	return (double) m_dwMIDIPitchFraction / (double)UINT_MAX * 100.0;
 }
 
+bool WAVfileParser::hasPitchInfo() {
+	return m_hasPitchInfo;
+}
+
 double WAVfileParser::getPitchInHz() {
 	double cents = getPitchFractionCents();
 	int midiNote = m_dwMIDIUnityNote;
@@ -669,6 +677,7 @@ bool WAVfileParser::parseSmplChunk(wxFFileInputStream &wavFile) {
 	wavFile.Read(&uBuffer, 4);
 	if (wavFile.LastRead() == 4) {
 		m_dwMIDIPitchFraction = uBuffer;
+		m_hasPitchInfo = true;
 		bytesRead += 4;
 	} else {
 		m_errorMessage += wxT("Couldn't read dwMIDIPitchFraction.\n");
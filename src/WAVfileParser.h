@@ -69,6 +69,8 @@ public:
 	unsigned getMidiNote();
 	unsigned getPitchFraction();
 	double getPitchFractionCents();
+	// if the smpl chunk gave the unity note and pitch fraction
+	bool hasPitchInfo();
 	double getPitchInHz();
 
 private:
@@ -86,6 +88,7 @@ private:
 	unsigned m_numberOfFrames;
 	unsigned m_dwMIDIUnityNote;
 	unsigned m_dwMIDIPitchFraction;
+	bool m_hasPitchInfo;
 	std::vector<CUEPOINT> m_cues;
 	std::vector<LOOP> m_loops;
 	std::vector<std::pair<wxString, wxString>> m_infoList;
@@ -0,0 +1,843 @@
+/*
+ * WavPackDecoder.cpp is part of GoOdf.
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * GoOdf is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GoOdf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GoOdf.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#include "WavPackDecoder.h"
+#include "Instrumentation.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+// The bitstream layout and the decorrelation follow the WavPack 4 format
+// as documented by its reference implementation (libwavpack, BSD license).
+
+namespace {
+
+	const uint32_t BYTES_STORED = 3;
+	const uint32_t MONO_FLAG = 4;
+	const uint32_t HYBRID_FLAG = 8;
+	const uint32_t JOINT_STEREO = 0x10;
+	const uint32_t FLOAT_DATA = 0x80;
+	const uint32_t INT32_DATA = 0x100;
+	const uint32_t INITIAL_BLOCK = 0x800;
+	const uint32_t FINAL_BLOCK = 0x1000;
+	const unsigned SHIFT_LSB = 13;
+	const uint32_t SHIFT_MASK = 0x1f << SHIFT_LSB;
+	const unsigned SRATE_LSB = 23;
+	const uint32_t SRATE_MASK = 0xf << SRATE_LSB;
+	const uint32_t FALSE_STEREO = 0x40000000;
+	const uint32_t DSD_FLAG = 0x80000000;
+	const uint32_t MONO_DATA = MONO_FLAG | FALSE_STEREO;
+
+	const unsigned ID_UNIQUE = 0x3f;
+	const unsigned ID_ODD_SIZE = 0x40;
+	const unsigned ID_LARGE = 0x80;
+	const unsigned ID_DECORR_TERMS = 0x2;
+	const unsigned ID_DECORR_WEIGHTS = 0x3;
+	const unsigned ID_DECORR_SAMPLES = 0x4;
+	const unsigned ID_ENTROPY_VARS = 0x5;
+	const unsigned ID_INT32_INFO = 0x9;
+	const unsigned ID_WV_BITSTREAM = 0xa;
+	const unsigned ID_SAMPLE_RATE = 0x27;
+
+	const size_t HEADER_SIZE = 32;
+	const unsigned MAX_TERMS = 16;
+	const unsigned LIMIT_ONES = 16;
+	const size_t NO_FRAME = (size_t) -1;
+
+	const unsigned sampleRates[15] = {
+		6000, 8000, 9600, 11025, 12000, 16000, 22050, 24000,
+		32000, 44100, 48000, 64000, 88200, 96000, 192000
+	};
+
+	// round(256 * (2 ^ (i / 256) - 1)), the mantissas of the stored logarithms
+	const unsigned char exp2Table[256] = {
+		0x00, 0x01, 0x01, 0x02, 0x03, 0x03, 0x04, 0x05, 0x06, 0x06, 0x07, 0x08, 0x08, 0x09, 0x0a, 0x0b,
+		0x0b, 0x0c, 0x0d, 0x0e, 0x0e, 0x0f, 0x10, 0x10, 0x11, 0x12, 0x13, 0x13, 0x14, 0x15, 0x16, 0x16,
+		0x17, 0x18, 0x19, 0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1d, 0x1e, 0x1f, 0x20, 0x20, 0x21, 0x22, 0x23,
+		0x24, 0x24, 0x25, 0x26, 0x27, 0x28, 0x28, 0x29, 0x2a, 0x2b, 0x2c, 0x2c, 0x2d, 0x2e, 0x2f, 0x30,
+		0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3a, 0x3a, 0x3b, 0x3c, 0x3d,
+		0x3e, 0x3f, 0x40, 0x41, 0x41, 0x42, 0x43, 0x44, 0x45, 0x46, 0x47, 0x48, 0x48, 0x49, 0x4a, 0x4b,
+		0x4c, 0x4d, 0x4e, 0x4f, 0x50, 0x51, 0x51, 0x52, 0x53, 0x54, 0x55, 0x56, 0x57, 0x58, 0x59, 0x5a,
+		0x5b, 0x5c, 0x5d, 0x5e, 0x5e, 0x5f, 0x60, 0x61, 0x62, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68, 0x69,
+		0x6a, 0x6b, 0x6c, 0x6d, 0x6e, 0x6f, 0x70, 0x71, 0x72, 0x73, 0x74, 0x75, 0x76, 0x77, 0x78, 0x79,
+		0x7a, 0x7b, 0x7c, 0x7d, 0x7e, 0x7f, 0x80, 0x81, 0x82, 0x83, 0x84, 0x85, 0x87, 0x88, 0x89, 0x8a,
+		0x8b, 0x8c, 0x8d, 0x8e, 0x8f, 0x90, 0x91, 0x92, 0x93, 0x95, 0x96, 0x97, 0x98, 0x99, 0x9a, 0x9b,
+		0x9c, 0x9d, 0x9f, 0xa0, 0xa1, 0xa2, 0xa3, 0xa4, 0xa5, 0xa6, 0xa8, 0xa9, 0xaa, 0xab, 0xac, 0xad,
+		0xaf, 0xb0, 0xb1, 0xb2, 0xb3, 0xb4, 0xb6, 0xb7, 0xb8, 0xb9, 0xba, 0xbc, 0xbd, 0xbe, 0xbf, 0xc0,
+		0xc2, 0xc3, 0xc4, 0xc5, 0xc6, 0xc8, 0xc9, 0xca, 0xcb, 0xcd, 0xce, 0xcf, 0xd0, 0xd2, 0xd3, 0xd4,
+		0xd6, 0xd7, 0xd8, 0xd9, 0xdb, 0xdc, 0xdd, 0xde, 0xe0, 0xe1, 0xe2, 0xe4, 0xe5, 0xe6, 0xe8, 0xe9,
+		0xea, 0xec, 0xed, 0xee, 0xf0, 0xf1, 0xf2, 0xf4, 0xf5, 0xf6, 0xf8, 0xf9, 0xfa, 0xfc, 0xfd, 0xff
+	};
+
+	uint32_t readU16(const unsigned char *bytes) {
+		return (uint32_t) bytes[0] | (uint32_t) bytes[1] << 8;
+	}
+
+	uint32_t readU32(const unsigned char *bytes) {
+		return readU16(bytes) | readU16(bytes + 2) << 16;
+	}
+
+	int32_t exp2s(int log) {
+		if (log < 0)
+			return -exp2s(-log);
+		uint32_t value = exp2Table[log & 0xff] | 0x100;
+		log >>= 8;
+		if (log <= 9)
+			return value >> (9 - log);
+		return value << ((log - 9) & 0x1f);
+	}
+
+	int restoreWeight(signed char weight) {
+		int result = weight * 8;
+		if (result > 0)
+			result += (result + 64) >> 7;
+		return result;
+	}
+
+	int32_t applyWeight(int weight, int32_t sample) {
+		return (int32_t) (((int64_t) weight * sample + 512) >> 10);
+	}
+
+	void updateWeight(int &weight, int delta, int32_t source, int32_t result) {
+		if (source && result)
+			weight -= ((((source ^ result) >> 30) & 2) - 1) * delta;
+	}
+
+	void updateWeightClip(int &weight, int delta, int32_t source, int32_t result) {
+		if (source && result) {
+			if ((source ^ result) < 0)
+				weight = std::max(weight - delta, -1024);
+			else
+				weight = std::min(weight + delta, 1024);
+		}
+	}
+
+	int32_t addWrapped(int32_t a, int32_t b) {
+		return (int32_t) ((uint32_t) a + (uint32_t) b);
+	}
+
+	// terms 17 and 18 extrapolate from the two previous samples
+	int32_t extrapolate(int term, const int32_t *previous) {
+		if (term & 1)
+			return (int32_t) (2u * (uint32_t) previous[0] - (uint32_t) previous[1]);
+		return (int32_t) (3u * (uint32_t) previous[0] - (uint32_t) previous[1]) >> 1;
+	}
+
+	// Walks the metadata sub-blocks following a block header
+	class SubBlockReader {
+	public:
+		SubBlockReader(const unsigned char *block, size_t size) : m_pos(block + HEADER_SIZE), m_end(block + size) {}
+
+		bool next(unsigned &id, const unsigned char *&data, size_t &size) {
+			if (m_end - m_pos < 2)
+				return false;
+			unsigned rawId = m_pos[0];
+			size_t words = m_pos[1];
+			m_pos += 2;
+			if (rawId & ID_LARGE) {
+				if (m_end - m_pos < 2)
+					return false;
+				words |= (size_t) m_pos[0] << 8 | (size_t) m_pos[1] << 16;
+				m_pos += 2;
+			}
+			size_t stored = words * 2;
+			if ((size_t) (m_end - m_pos) < stored)
+				return false;
+			id = rawId & ID_UNIQUE;
+			data = m_pos;
+			size = (rawId & ID_ODD_SIZE) && stored ? stored - 1 : stored;
+			m_pos += stored;
+			return true;
+		}
+
+	private:
+		const unsigned char *m_pos;
+		const unsigned char *m_end;
+	};
+
+	// Least significant bit first reader of the entropy coded bitstream.
+	// Reading past the end yields zeros and marks the stream as overrun.
+	class BitReader {
+	public:
+		BitReader(const unsigned char *data, size_t size) : m_data(data), m_end(data + size), m_bits(0), m_count(0), m_padding(0), m_overrun(false) {}
+
+		unsigned getBit() {
+			if (m_count == 0)
+				refill();
+			unsigned bit = m_bits & 1;
+			m_bits >>= 1;
+			m_count--;
+			return bit;
+		}
+
+		uint32_t getBits(unsigned count) {
+			if (count == 0)
+				return 0;
+			if (m_count < count)
+				refill();
+			uint32_t value = (uint32_t) (m_bits & ((1ULL << count) - 1));
+			m_bits >>= count;
+			m_count -= count;
+			return value;
+		}
+
+		// Counts and consumes one bits up to limit, also consuming the
+		// terminating zero if it comes before the limit is reached
+		unsigned countOnes(unsigned limit) {
+			unsigned ones = 0;
+			while (ones < limit) {
+				if (m_count == 0)
+					refill();
+				if (!(m_bits & 1)) {
+					m_bits >>= 1;
+					m_count--;
+					return ones;
+				}
+				m_bits >>= 1;
+				m_count--;
+				ones++;
+			}
+			return ones;
+		}
+
+		bool isOverrun() const {
+			return m_overrun || m_count < m_padding;
+		}
+
+	private:
+		const unsigned char *m_data;
+		const unsigned char *m_end;
+		uint64_t m_bits;
+		unsigned m_count;
+		// zero bits appended after the end of the data
+		unsigned m_padding;
+		bool m_overrun;
+
+		void refill() {
+			if (m_count < m_padding)
+				m_overrun = true;
+			while (m_count <= 56) {
+				if (m_data < m_end)
+					m_bits |= (uint64_t) *m_data++ << m_count;
+				else
+					m_padding = std::min(m_padding + 8, m_count + 8);
+				m_count += 8;
+			}
+		}
+	};
+
+	struct ENTROPY_STATE {
+		uint32_t median[2][3];
+		uint32_t zerosAcc;
+		bool holdingOne;
+		bool holdingZero;
+	};
+
+	uint32_t readCode(BitReader &bits, uint32_t maxCode) {
+		if (maxCode < 2)
+			return maxCode ? bits.getBit() : 0;
+		unsigned bitCount = 0;
+		while (bitCount < 32 && (maxCode >> bitCount) > 1)
+			bitCount++;
+		uint32_t extras = (uint32_t) ((2ULL << bitCount) - maxCode - 1);
+		uint32_t code = bits.getBits(bitCount);
+		if (code >= extras)
+			code = (code << 1) - extras + bits.getBit();
+		return code;
+	}
+
+	// Decodes one residual with the adaptive Golomb-like code that keeps
+	// three running medians per channel, including the runs of zeros
+	bool getWord(BitReader &bits, ENTROPY_STATE &state, unsigned channel, int32_t &word) {
+		uint32_t *median = state.median[channel];
+		if (state.median[0][0] < 2 && state.median[1][0] < 2 && !state.holdingZero && !state.holdingOne) {
+			if (state.zerosAcc) {
+				if (--state.zerosAcc) {
+					word = 0;
+					return true;
+				}
+			} else {
+				unsigned cbits = bits.countOnes(33);
+				if (cbits == 33)
+					return false;
+				if (cbits < 2)
+					state.zerosAcc = cbits;
+				else
+					state.zerosAcc = bits.getBits(cbits - 1) | (1u << (cbits - 1));
+				if (state.zerosAcc) {
+					memset(state.median, 0, sizeof(state.median));
+					word = 0;
+					return true;
+				}
+			}
+		}
+
+		uint32_t onesCount;
+		if (state.holdingZero) {
+			onesCount = 0;
+			state.holdingZero = false;
+		} else {
+			onesCount = bits.countOnes(LIMIT_ONES + 1);
+			if (onesCount >= LIMIT_ONES) {
+				if (onesCount == LIMIT_ONES + 1)
+					return false;
+				unsigned cbits = bits.countOnes(33);
+				if (cbits == 33)
+					return false;
+				if (cbits < 2)
+					onesCount = cbits;
+				else
+					onesCount = bits.getBits(cbits - 1) | (1u << (cbits - 1));
+				onesCount += LIMIT_ONES;
+			}
+			if (state.holdingOne) {
+				state.holdingOne = onesCount & 1;
+				onesCount = (onesCount >> 1) + 1;
+			} else {
+				state.holdingOne = onesCount & 1;
+				onesCount >>= 1;
+			}
+			state.holdingZero = !state.holdingOne;
+		}
+
+		uint32_t low;
+		uint32_t high;
+		uint32_t med0 = (median[0] >> 4) + 1;
+		if (onesCount == 0) {
+			low = 0;
+			high = med0 - 1;
+			median[0] -= ((median[0] + 126) / 128) * 2;
+		} else {
+			low = med0;
+			median[0] += ((median[0] + 128) / 128) * 5;
+			uint32_t med1 = (median[1] >> 4) + 1;
+			if (onesCount == 1) {
+				high = low + med1 - 1;
+				median[1] -= ((median[1] + 62) / 64) * 2;
+			} else {
+				low += med1;
+				median[1] += ((median[1] + 64) / 64) * 5;
+				uint32_t med2 = (median[2] >> 4) + 1;
+				if (onesCount == 2) {
+					high = low + med2 - 1;
+					median[2] -= ((median[2] + 30) / 32) * 2;
+				} else {
+					low += (onesCount - 2) * med2;
+					high = low + med2 - 1;
+					median[2] += ((median[2] + 32) / 32) * 5;
+				}
+			}
+		}
+		low &= 0x7fffffff;
+		high &= 0x7fffffff;
+		if (low > high)
+			return false;
+
+		uint32_t code = readCode(bits, high - low) + low;
+		word = bits.getBit() ? (int32_t) ~code : (int32_t) code;
+		return !bits.isOverrun();
+	}
+
+}
+
+WavPackDecoder::WavPackDecoder(wxFFile &file) : m_file(file) {
+	m_numberOfChannels = 0;
+	m_sampleRate = 0;
+	m_bitsPerSample = 0;
+	m_numberOfFrames = 0;
+	m_position = 0;
+	m_decodedIndex = NO_FRAME;
+}
+
+WavPackDecoder::~WavPackDecoder() {
+
+}
+
+bool WavPackDecoder::open(wxString &errorMessage) {
+	bool ok = scanBlocks();
+	if (!ok)
+		errorMessage = m_errorMessage;
+	return ok;
+}
+
+unsigned WavPackDecoder::getNumberOfChannels() const {
+	return m_numberOfChannels;
+}
+
+unsigned WavPackDecoder::getSampleRate() const {
+	return m_sampleRate;
+}
+
+unsigned WavPackDecoder::getBitsPerSample() const {
+	return m_bitsPerSample;
+}
+
+unsigned WavPackDecoder::getNumberOfFrames() const {
+	return m_numberOfFrames;
+}
+
+wxString WavPackDecoder::getErrorMessage() const {
+	return m_errorMessage;
+}
+
+bool WavPackDecoder::seek(unsigned frame) {
+	if (frame > m_numberOfFrames)
+		return false;
+	// the containing block is decoded lazily by the next read
+	m_position = frame;
+	return true;
+}
+
+unsigned WavPackDecoder::read(float *buffer, unsigned frames) {
+	unsigned done = 0;
+	while (done < frames && m_position < m_numberOfFrames) {
+		size_t index = m_decodedIndex;
+		if (index == NO_FRAME || m_position < m_frames[index].firstFrame || m_position - m_frames[index].firstFrame >= m_frames[index].numberOfFrames) {
+			auto it = std::upper_bound(m_frames.begin(), m_frames.end(), m_position, [](unsigned frame, const AUDIO_FRAME &audioFrame) {
+				return frame < audioFrame.firstFrame;
+			});
+			index = (it - m_frames.begin()) - 1;
+			if (!decodeAudioFrame(index))
+				break;
+		}
+		const AUDIO_FRAME &audioFrame = m_frames[index];
+		unsigned offset = m_position - audioFrame.firstFrame;
+		unsigned count = std::min(frames - done, audioFrame.numberOfFrames - offset);
+		std::copy_n(m_decoded.begin() + (size_t) offset * m_numberOfChannels, (size_t) count * m_numberOfChannels, buffer + (size_t) done * m_numberOfChannels);
+		done += count;
+		m_position += count;
+	}
+	return done;
+}
+
+bool WavPackDecoder::scanBlocks() {
+	wxFileOffset length = m_file.Length();
+	wxFileOffset pos = 0;
+	bool countingChannels = false;
+	unsigned char header[HEADER_SIZE];
+
+	while (pos + (wxFileOffset) HEADER_SIZE <= length) {
+		if (!m_file.Seek(pos) || m_file.Read(header, HEADER_SIZE) != HEADER_SIZE || memcmp(header, "wvpk", 4) != 0) {
+			// trailing tags may follow the last block
+			if (!m_frames.empty())
+				break;
+			m_errorMessage = wxT("No WavPack block header found.\n");
+			return false;
+		}
+		uint32_t blockSize = readU32(header + 4);
+		unsigned version = readU16(header + 8);
+		uint32_t blockIndex = readU32(header + 16);
+		uint32_t blockSamples = readU32(header + 20);
+		uint32_t flags = readU32(header + 24);
+		if (blockSize < HEADER_SIZE - 8 || pos + 8 + (wxFileOffset) blockSize > length) {
+			m_errorMessage = wxT("A WavPack block is truncated.\n");
+			return false;
+		}
+		if (version < 0x402 || version > 0x410) {
+			m_errorMessage = wxString::Format(wxT("Unsupported WavPack version 0x%x.\n"), version);
+			return false;
+		}
+
+		if (blockSamples) {
+			if (flags & HYBRID_FLAG) {
+				m_errorMessage = wxT("Hybrid (lossy) WavPack files can't be decoded.\n");
+				return false;
+			}
+			if (flags & (FLOAT_DATA | DSD_FLAG)) {
+				m_errorMessage = wxT("Floating point and DSD WavPack files can't be decoded.\n");
+				return false;
+			}
+			if (flags & INITIAL_BLOCK) {
+				if (m_frames.empty()) {
+					countingChannels = true;
+					unsigned bytesStored = (flags & BYTES_STORED) + 1;
+					m_bitsPerSample = bytesStored * 8 - ((flags & SHIFT_MASK) >> SHIFT_LSB);
+					unsigned rateIndex = (flags & SRATE_MASK) >> SRATE_LSB;
+					if (rateIndex < 15) {
+						m_sampleRate = sampleRates[rateIndex];
+					} else {
+						m_blockBuffer.resize(blockSize + 8);
+						if (!m_file.Seek(pos) || m_file.Read(m_blockBuffer.data(), m_blockBuffer.size()) != m_blockBuffer.size() || !readSampleRate(m_blockBuffer.data(), m_blockBuffer.size())) {
+							m_errorMessage = wxT("The WavPack sample rate couldn't be found.\n");
+							return false;
+						}
+					}
+				}
+				if (m_frames.empty() || blockIndex != m_frames.back().firstFrame) {
+					unsigned expected = m_frames.empty() ? 0 : m_frames.back().firstFrame + m_frames.back().numberOfFrames;
+					if (blockIndex != expected) {
+						m_errorMessage = wxT("The WavPack blocks are not contiguous.\n");
+						return false;
+					}
+					m_frames.push_back(AUDIO_FRAME{pos, blockIndex, blockSamples});
+				}
+			}
+			if (countingChannels) {
+				m_numberOfChannels += (flags & MONO_FLAG) ? 1 : 2;
+				if (flags & FINAL_BLOCK)
+					countingChannels = false;
+			}
+		}
+		pos += 8 + (wxFileOffset) blockSize;
+	}
+
+	if (m_frames.empty() || m_numberOfChannels == 0) {
+		m_errorMessage = wxT("The WavPack file contains no audio.\n");
+		return false;
+	}
+	m_numberOfFrames = m_frames.back().firstFrame + m_frames.back().numberOfFrames;
+	m_position = 0;
+	return true;
+}
+
+bool WavPackDecoder::readSampleRate(const unsigned char *block, size_t size) {
+	SubBlockReader subBlocks(block, size);
+	unsigned id;
+	const unsigned char *data;
+	size_t dataSize;
+	while (subBlocks.next(id, data, dataSize)) {
+		if (id == ID_SAMPLE_RATE && dataSize >= 3) {
+			m_sampleRate = data[0] | data[1] << 8 | data[2] << 16;
+			if (dataSize >= 4)
+				m_sampleRate |= (unsigned) (data[3] & 0x7f) << 24;
+			return m_sampleRate > 0;
+		}
+	}
+	return false;
+}
+
+bool WavPackDecoder::decodeAudioFrame(size_t index) {
+	const AUDIO_FRAME &audioFrame = m_frames[index];
+	m_decodedIndex = NO_FRAME;
+	m_decoded.assign((size_t) audioFrame.numberOfFrames * m_numberOfChannels, 0.0f);
+
+	wxFileOffset pos = audioFrame.offset;
+	unsigned channel = 0;
+	unsigned char header[HEADER_SIZE];
+	while (channel < m_numberOfChannels) {
+		if (!m_file.Seek(pos) || m_file.Read(header, HEADER_SIZE) != HEADER_SIZE || memcmp(header, "wvpk", 4) != 0) {
+			m_errorMessage = wxT("A WavPack block couldn't be read.\n");
+			return false;
+		}
+		size_t blockSize = (size_t) readU32(header + 4) + 8;
+		uint32_t blockIndex = readU32(header + 16);
+		uint32_t blockSamples = readU32(header + 20);
+		uint32_t flags = readU32(header + 24);
+		pos += blockSize;
+		if (blockSamples == 0)
+			continue;
+		if (blockIndex != audioFrame.firstFrame || blockSamples != audioFrame.numberOfFrames) {
+			m_errorMessage = wxT("A WavPack block doesn't match its neighbours.\n");
+			return false;
+		}
+
+		m_blockBuffer.resize(blockSize);
+		memcpy(m_blockBuffer.data(), header, HEADER_SIZE);
+		size_t rest = blockSize - HEADER_SIZE;
+		if (m_file.Read(m_blockBuffer.data() + HEADER_SIZE, rest) != rest) {
+			m_errorMessage = wxT("A WavPack block is truncated.\n");
+			return false;
+		}
+		Instrumentation::count(Instrumentation::BYTES_READ, blockSize);
+
+		if (!decodeBlock(m_blockBuffer.data(), blockSize, channel, blockSamples))
+			return false;
+		channel += (flags & MONO_FLAG) ? 1 : 2;
+		if (flags & FINAL_BLOCK)
+			break;
+	}
+	m_decodedIndex = index;
+	return true;
+}
+
+bool WavPackDecoder::decodeBlock(const unsigned char *block, size_t size, unsigned firstChannel, unsigned frames) {
+	uint32_t flags = readU32(block + 24);
+	uint32_t expectedCrc = readU32(block + 28);
+	bool monoData = (flags & MONO_DATA) != 0;
+	unsigned outputChannels = (flags & MONO_FLAG) ? 1 : 2;
+	if (flags & (HYBRID_FLAG | FLOAT_DATA | DSD_FLAG)) {
+		m_errorMessage = wxT("Only lossless integer WavPack blocks can be decoded.\n");
+		return false;
+	}
+	if (firstChannel + outputChannels > m_numberOfChannels) {
+		m_errorMessage = wxT("A WavPack block has more channels than the file.\n");
+		return false;
+	}
+
+	DECORR_PASS passes[MAX_TERMS];
+	unsigned numberOfTerms = 0;
+	ENTROPY_STATE entropy;
+	memset(&entropy, 0, sizeof(entropy));
+	bool hasEntropy = false;
+	const unsigned char *bitstream = NULL;
+	size_t bitstreamSize = 0;
+	unsigned int32Zeros = 0;
+	unsigned int32Ones = 0;
+	unsigned int32Dups = 0;
+
+	SubBlockReader subBlocks(block, size);
+	unsigned id;
+	const unsigned char *data;
+	size_t dataSize;
+	while (subBlocks.next(id, data, dataSize)) {
+		switch (id) {
+			case ID_DECORR_TERMS:
+				if (dataSize > MAX_TERMS) {
+					m_errorMessage = wxT("A WavPack block has too many decorrelation terms.\n");
+					return false;
+				}
+				numberOfTerms = dataSize;
+				// the terms are stored in the reverse order of their use
+				for (unsigned i = 0; i < numberOfTerms; i++) {
+					DECORR_PASS &pass = passes[numberOfTerms - i - 1];
+					memset(&pass, 0, sizeof(pass));
+					pass.term = (int) (data[i] & 0x1f) - 5;
+					pass.delta = (data[i] >> 5) & 0x7;
+					bool valid = (pass.term >= 1 && pass.term <= 8) || pass.term == 17 || pass.term == 18 || (!monoData && pass.term >= -3 && pass.term <= -1);
+					if (!valid) {
+						m_errorMessage = wxT("A WavPack block has an invalid decorrelation term.\n");
+						return false;
+					}
+				}
+				break;
+			case ID_DECORR_WEIGHTS: {
+				size_t count = monoData ? dataSize : dataSize / 2;
+				if (count > numberOfTerms) {
+					m_errorMessage = wxT("A WavPack block has too many decorrelation weights.\n");
+					return false;
+				}
+				const signed char *weights = (const signed char *) data;
+				for (int i = (int) numberOfTerms - 1; i >= 0 && count > 0; i--, count--) {
+					passes[i].weightA = restoreWeight(*weights++);
+					if (!monoData)
+						passes[i].weightB = restoreWeight(*weights++);
+				}
+				break;
+			}
+			case ID_DECORR_SAMPLES: {
+				const unsigned char *pos = data;
+				const unsigned char *end = data + dataSize;
+				auto next = [&pos]() {
+					int32_t value = exp2s((int16_t) readU16(pos));
+					pos += 2;
+					return value;
+				};
+				for (int i = (int) numberOfTerms - 1; i >= 0 && pos < end; i--) {
+					DECORR_PASS &pass = passes[i];
+					size_t needed = pass.term > 8 ? (monoData ? 4 : 8) : pass.term < 0 ? 4 : (size_t) pass.term * (monoData ? 2 : 4);
+					if ((size_t) (end - pos) < needed) {
+						m_errorMessage = wxT("A WavPack block has truncated decorrelation samples.\n");
+						return false;
+					}
+					if (pass.term > 8) {
+						pass.samplesA[0] = next();
+						pass.samplesA[1] = next();
+						if (!monoData) {
+							pass.samplesB[0] = next();
+							pass.samplesB[1] = next();
+						}
+					} else if (pass.term < 0) {
+						pass.samplesA[0] = next();
+						pass.samplesB[0] = next();
+					} else {
+						for (int j = 0; j < pass.term; j++) {
+							pass.samplesA[j] = next();
+							if (!monoData)
+								pass.samplesB[j] = next();
+						}
+					}
+				}
+				break;
+			}
+			case ID_ENTROPY_VARS:
+				if (dataSize != (monoData ? 6u : 12u)) {
+					m_errorMessage = wxT("A WavPack block has invalid entropy variables.\n");
+					return false;
+				}
+				for (unsigned c = 0; c < (monoData ? 1u : 2u); c++) {
+					for (unsigned i = 0; i < 3; i++)
+						entropy.median[c][i] = exp2s(readU16(data + 6 * c + 2 * i));
+				}
+				hasEntropy = true;
+				break;
+			case ID_INT32_INFO:
+				if (dataSize < 4) {
+					m_errorMessage = wxT("A WavPack block has invalid 32-bit integer information.\n");
+					return false;
+				}
+				if (data[0]) {
+					// the low bits are stored in a separate stream
+					m_errorMessage = wxT("WavPack files with extended 32-bit integer precision can't be decoded.\n");
+					return false;
+				}
+				int32Zeros = data[1];
+				int32Ones = data[2];
+				int32Dups = data[3];
+				break;
+			case ID_WV_BITSTREAM:
+				bitstream = data;
+				bitstreamSize = dataSize;
+				break;
+			default:
+				break;
+		}
+	}
+	if (!bitstream || !hasEntropy) {
+		m_errorMessage = wxT("A WavPack block lacks its audio bitstream.\n");
+		return false;
+	}
+
+	// entropy decoding of the residuals, interleaved when stereo
+	size_t numberOfValues = (size_t) frames * (monoData ? 1 : 2);
+	m_samples.resize(numberOfValues);
+	int32_t *samples = m_samples.data();
+	BitReader bits(bitstream, bitstreamSize);
+	for (size_t i = 0; i < numberOfValues; i++) {
+		if (!getWord(bits, entropy, monoData ? 0 : i & 1, samples[i])) {
+			m_errorMessage = wxT("A WavPack block has a corrupt bitstream.\n");
+			return false;
+		}
+	}
+
+	// the decorrelation passes are undone one at a time over the whole block
+	for (unsigned t = 0; t < numberOfTerms; t++) {
+		DECORR_PASS &pass = passes[t];
+		if (monoData) {
+			unsigned m = 0;
+			for (size_t i = 0; i < frames; i++) {
+				int32_t sample;
+				int32_t residual = samples[i];
+				if (pass.term > 8) {
+					sample = extrapolate(pass.term, pass.samplesA);
+					pass.samplesA[1] = pass.samplesA[0];
+					pass.samplesA[0] = addWrapped(residual, applyWeight(pass.weightA, sample));
+					samples[i] = pass.samplesA[0];
+				} else {
+					sample = pass.samplesA[m];
+					unsigned k = (m + pass.term) & 7;
+					pass.samplesA[k] = addWrapped(residual, applyWeight(pass.weightA, sample));
+					samples[i] = pass.samplesA[k];
+					m = (m + 1) & 7;
+				}
+				updateWeight(pass.weightA, pass.delta, sample, residual);
+			}
+		} else if (pass.term > 0) {
+			unsigned m = 0;
+			for (size_t i = 0; i < frames; i++) {
+				int32_t left = samples[2 * i];
+				int32_t right = samples[2 * i + 1];
+				int32_t sampleA;
+				int32_t sampleB;
+				unsigned k;
+				if (pass.term > 8) {
+					sampleA = extrapolate(pass.term, pass.samplesA);
+					sampleB = extrapolate(pass.term, pass.samplesB);
+					pass.samplesA[1] = pass.samplesA[0];
+					pass.samplesB[1] = pass.samplesB[0];
+					k = 0;
+				} else {
+					sampleA = pass.samplesA[m];
+					sampleB = pass.samplesB[m];
+					k = (m + pass.term) & 7;
+					m = (m + 1) & 7;
+				}
+				pass.samplesA[k] = samples[2 * i] = addWrapped(left, applyWeight(pass.weightA, sampleA));
+				pass.samplesB[k] = samples[2 * i + 1] = addWrapped(right, applyWeight(pass.weightB, sampleB));
+				updateWeight(pass.weightA, pass.delta, sampleA, left);
+				updateWeight(pass.weightB, pass.delta, sampleB, right);
+			}
+		} else {
+			// negative terms predict each channel from the other one
+			for (size_t i = 0; i < frames; i++) {
+				int32_t left = samples[2 * i];
+				int32_t right = samples[2 * i + 1];
+				if (pass.term == -1) {
+					int32_t newLeft = addWrapped(left, applyWeight(pass.weightA, pass.samplesA[0]));
+					updateWeightClip(pass.weightA, pass.delta, pass.samplesA[0], left);
+					int32_t newRight = addWrapped(right, applyWeight(pass.weightB, newLeft));
+					updateWeightClip(pass.weightB, pass.delta, newLeft, right);
+					pass.samplesA[0] = newRight;
+					left = newLeft;
+					right = newRight;
+				} else {
+					int32_t newRight = addWrapped(right, applyWeight(pass.weightB, pass.samplesB[0]));
+					updateWeightClip(pass.weightB, pass.delta, pass.samplesB[0], right);
+					int32_t source = newRight;
+					if (pass.term == -3) {
+						source = pass.samplesA[0];
+						pass.samplesA[0] = newRight;
+					}
+					int32_t newLeft = addWrapped(left, applyWeight(pass.weightA, source));
+					updateWeightClip(pass.weightA, pass.delta, source, left);
+					pass.samplesB[0] = newLeft;
+					left = newLeft;
+					right = newRight;
+				}
+				samples[2 * i] = left;
+				samples[2 * i + 1] = right;
+			}
+		}
+	}
+
+	if (!monoData && (flags & JOINT_STEREO)) {
+		for (size_t i = 0; i < frames; i++) {
+			samples[2 * i + 1] -= samples[2 * i] >> 1;
+			samples[2 * i] += samples[2 * i + 1];
+		}
+	}
+
+	uint32_t crc = 0xffffffff;
+	for (size_t i = 0; i < numberOfValues; i++)
+		crc = crc * 3 + (uint32_t) samples[i];
+	if (crc != expectedCrc) {
+		m_errorMessage = wxT("A WavPack block failed its checksum.\n");
+		return false;
+	}
+
+	if ((flags & INT32_DATA) && (int32Zeros || int32Ones || int32Dups)) {
+		for (size_t i = 0; i < numberOfValues; i++) {
+			uint32_t value = (uint32_t) samples[i];
+			if (int32Zeros)
+				value <<= int32Zeros;
+			else if (int32Ones)
+				value = ((value + 1) << int32Ones) - 1;
+			else
+				value = ((value + (value & 1)) << int32Dups) - (value & 1);
+			samples[i] = (int32_t) value;
+		}
+	}
+
+	unsigned bytesStored = (flags & BYTES_STORED) + 1;
+	int shift = (int) ((flags & SHIFT_MASK) >> SHIFT_LSB) - (int) (bytesStored * 8 - 1);
+	float scale = (float) std::ldexp(1.0, shift);
+	float *output = m_decoded.data() + firstChannel;
+	for (size_t i = 0; i < frames; i++) {
+		float *frame = output + i * m_numberOfChannels;
+		if (monoData) {
+			frame[0] = samples[i] * scale;
+			if (outputChannels == 2)
+				frame[1] = frame[0];
+		} else {
+			frame[0] = samples[2 * i] * scale;
+			frame[1] = samples[2 * i + 1] * scale;
+		}
+	}
+	return true;
+}
@@ -0,0 +1,87 @@
+/*
+ * WavPackDecoder.h is part of GoOdf.
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * GoOdf is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GoOdf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GoOdf.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#ifndef WAVPACKDECODER_H
+#define WAVPACKDECODER_H
+
+#include <wx/wx.h>
+#include <wx/ffile.h>
+#include <vector>
+#include <cstdint>
+
+// Decodes the audio of a lossless WavPack 4 file one block at a time so
+// that only the block being read is held in memory. Blocks are found by
+// scanning the block headers when the file is opened, which also makes
+// seeking cheap: only the block containing the wanted frame is decoded.
+// Hybrid (lossy) and floating point files are reported as unsupported.
+class WavPackDecoder {
+public:
+	WavPackDecoder(wxFFile &file);
+	~WavPackDecoder();
+
+	bool open(wxString &errorMessage);
+	unsigned getNumberOfChannels() const;
+	unsigned getSampleRate() const;
+	unsigned getBitsPerSample() const;
+	unsigned getNumberOfFrames() const;
+
+	bool seek(unsigned frame);
+	unsigned read(float *buffer, unsigned frames);
+	wxString getErrorMessage() const;
+
+private:
+	// a set of blocks (one per mono or stereo pair) sharing the same frames
+	struct AUDIO_FRAME {
+		wxFileOffset offset;
+		unsigned firstFrame;
+		unsigned numberOfFrames;
+	};
+
+	struct DECORR_PASS {
+		int term;
+		int delta;
+		int weightA;
+		int weightB;
+		int32_t samplesA[8];
+		int32_t samplesB[8];
+	};
+
+	wxFFile &m_file;
+	wxString m_errorMessage;
+	std::vector<AUDIO_FRAME> m_frames;
+	unsigned m_numberOfChannels;
+	unsigned m_sampleRate;
+	unsigned m_bitsPerSample;
+	unsigned m_numberOfFrames;
+	unsigned m_position;
+
+	// the currently decoded audio frame, interleaved
+	size_t m_decodedIndex;
+	std::vector<float> m_decoded;
+	std::vector<unsigned char> m_blockBuffer;
+	std::vector<int32_t> m_samples;
+
+	bool scanBlocks();
+	bool decodeAudioFrame(size_t index);
+	bool decodeBlock(const unsigned char *block, size_t size, unsigned firstChannel, unsigned frames);
+	bool readSampleRate(const unsigned char *block, size_t size);
+};
+
+#endif
@@ -0,0 +1,108 @@
+/*
+ * WavWriter.cpp is part of GoOdf.
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * GoOdf is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GoOdf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GoOdf.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#include "WavWriter.h"
+#include <cstring>
+#include <cstdint>
+
+namespace {
+
+	const unsigned HEADER_SIZE = 44;
+
+	void writeUnsigned(unsigned char *bytes, unsigned value, unsigned length) {
+		for (unsigned i = 0; i < length; i++)
+			bytes[i] = (value >> (8 * i)) & 0xff;
+	}
+
+}
+
+WavWriter::WavWriter() {
+	m_numberOfChannels = 0;
+	m_sampleRate = 0;
+	m_framesWritten = 0;
+}
+
+WavWriter::~WavWriter() {
+	if (m_file.IsOpened())
+		close();
+}
+
+bool WavWriter::open(const wxString &path, unsigned numberOfChannels, unsigned sampleRate) {
+	m_numberOfChannels = numberOfChannels;
+	m_sampleRate = sampleRate;
+	m_framesWritten = 0;
+	{
+		wxLogNull noLog;
+		if (!m_file.Open(path, wxT("wb"))) {
+			m_errorMessage = wxT("Failed to create ") + path + wxT(".\n");
+			return false;
+		}
+	}
+	// the sizes are written by close()
+	unsigned char header[HEADER_SIZE] = {};
+	return m_file.Write(header, HEADER_SIZE) == HEADER_SIZE;
+}
+
+bool WavWriter::write(const float *buffer, unsigned frames) {
+	size_t numberOfValues = (size_t) frames * m_numberOfChannels;
+	m_buffer.resize(numberOfValues * 4);
+	for (size_t i = 0; i < numberOfValues; i++) {
+		uint32_t bits;
+		memcpy(&bits, buffer + i, 4);
+		writeUnsigned(m_buffer.data() + i * 4, bits, 4);
+	}
+	if (m_file.Write(m_buffer.data(), m_buffer.size()) != m_buffer.size()) {
+		m_errorMessage = wxT("Failed to write the audio.\n");
+		return false;
+	}
+	m_framesWritten += frames;
+	return true;
+}
+
+bool WavWriter::close() {
+	if (!m_file.IsOpened())
+		return false;
+	unsigned long long dataSize = m_framesWritten * m_numberOfChannels * 4;
+	bool ok = dataSize <= 0xffffffffULL - HEADER_SIZE;
+	if (!ok)
+		m_errorMessage = wxT("The audio is too long for a WAVE file.\n");
+
+	unsigned char header[HEADER_SIZE];
+	memcpy(header, "RIFF", 4);
+	writeUnsigned(header + 4, (unsigned) (dataSize + HEADER_SIZE - 8), 4);
+	memcpy(header + 8, "WAVEfmt ", 8);
+	writeUnsigned(header + 16, 16, 4);
+	// WAVE_FORMAT_IEEE_FLOAT
+	writeUnsigned(header + 20, 3, 2);
+	writeUnsigned(header + 22, m_numberOfChannels, 2);
+	writeUnsigned(header + 24, m_sampleRate, 4);
+	writeUnsigned(header + 28, m_sampleRate * m_numberOfChannels * 4, 4);
+	writeUnsigned(header + 32, m_numberOfChannels * 4, 2);
+	writeUnsigned(header + 34, 32, 2);
+	memcpy(header + 36, "data", 4);
+	writeUnsigned(header + 40, (unsigned) dataSize, 4);
+	ok = ok && m_file.Seek(0) && m_file.Write(header, HEADER_SIZE) == HEADER_SIZE;
+	ok = m_file.Close() && ok;
+	return ok;
+}
+
+wxString WavWriter::getErrorMessage() const {
+	return m_errorMessage;
+}
@@ -0,0 +1,49 @@
+/*
+ * WavWriter.h is part of GoOdf.
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * GoOdf is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GoOdf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GoOdf.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#ifndef WAVWRITER_H
+#define WAVWRITER_H
+
+#include <wx/wx.h>
+#include <wx/ffile.h>
+#include <vector>
+
+// Streams interleaved float audio to a 32-bit floating point RIFF WAVE
+// file. The chunk sizes are filled in when the file is closed.
+class WavWriter {
+public:
+	WavWriter();
+	~WavWriter();
+
+	bool open(const wxString &path, unsigned numberOfChannels, unsigned sampleRate);
+	bool write(const float *buffer, unsigned frames);
+	bool close();
+	wxString getErrorMessage() const;
+
+private:
+	wxFFile m_file;
+	unsigned m_numberOfChannels;
+	unsigned m_sampleRate;
+	unsigned long long m_framesWritten;
+	wxString m_errorMessage;
+	std::vector<unsigned char> m_buffer;
+};
+
+#endif
@@ -0,0 +1,289 @@
+/*
+ * WaveformPanel.cpp is part of GoOdf.
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * GoOdf is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GoOdf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GoOdf.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#include "WaveformPanel.h"
+#include "SampleMetadataCache.h"
+#include "SampleReader.h"
+#include <wx/dcbuffer.h>
+#include <algorithm>
+#include <cmath>
+
+// the closest zoom shows a frame every 16 pixels
+static const double MIN_FRAMES_PER_PIXEL = 1.0 / 16;
+static const double WHEEL_ZOOM_FACTOR = 1.25;
+
+BEGIN_EVENT_TABLE(WaveformPanel, wxPanel)
+	EVT_PAINT(WaveformPanel::OnPaintEvent)
+	EVT_MOUSEWHEEL(WaveformPanel::OnMouseWheel)
+	EVT_LEFT_DOWN(WaveformPanel::OnLeftDown)
+	EVT_LEFT_UP(WaveformPanel::OnLeftUp)
+	EVT_MOTION(WaveformPanel::OnMouseMotion)
+	EVT_LEFT_DCLICK(WaveformPanel::OnLeftDoubleClick)
+	EVT_MOUSE_CAPTURE_LOST(WaveformPanel::OnCaptureLost)
+	EVT_SIZE(WaveformPanel::OnPanelSize)
+END_EVENT_TABLE()
+
+WaveformPanel::WaveformPanel(wxWindow *parent, wxWindowID id, const wxSize &size) : wxPanel(parent, id, wxDefaultPosition, size, wxBORDER_SUNKEN|wxFULL_REPAINT_ON_RESIZE) {
+	m_firstFrame = 0;
+	m_framesPerPixel = 1;
+	m_isShowingAll = true;
+	m_rawFirstFrame = 0;
+	m_attackStart = 0;
+	m_cuePoint = -1;
+	m_releaseEnd = -1;
+	m_isDragging = false;
+	m_dragStartX = 0;
+	m_dragStartFrame = 0;
+	SetBackgroundStyle(wxBG_STYLE_PAINT);
+	SetMinSize(size);
+	SetToolTip(wxT("Use the mouse wheel to zoom, drag to scroll and double click to show the whole sample."));
+}
+
+WaveformPanel::~WaveformPanel() {
+
+}
+
+void WaveformPanel::SetSample(const wxString &path) {
+	if (path == m_path && m_peaks)
+		return;
+	m_path = path;
+	m_reader.reset();
+	m_rawFrames.clear();
+	m_errorMessage = wxEmptyString;
+	m_peaks.reset();
+	if (path.IsEmpty()) {
+		Refresh();
+		return;
+	}
+	{
+		wxBusyCursor busy;
+		m_peaks = SampleMetadataCache::get().getPeakPyramid(path, m_errorMessage);
+	}
+	ZoomToAll();
+}
+
+void WaveformPanel::SetMarkers(int attackStart, int cuePoint, int releaseEnd, const std::vector<std::pair<unsigned, unsigned>> &loops) {
+	m_attackStart = attackStart;
+	m_cuePoint = cuePoint;
+	m_releaseEnd = releaseEnd;
+	m_loops = loops;
+	Refresh();
+}
+
+void WaveformPanel::ZoomToAll() {
+	m_isShowingAll = true;
+	m_firstFrame = 0;
+	int width = std::max(1, GetClientSize().GetWidth());
+	m_framesPerPixel = m_peaks ? (double) m_peaks->getNumberOfFrames() / width : 1;
+	ClampView();
+	Refresh();
+}
+
+void WaveformPanel::OnPaintEvent(wxPaintEvent& WXUNUSED(event)) {
+	wxAutoBufferedPaintDC dc(this);
+	Render(dc);
+}
+
+void WaveformPanel::OnMouseWheel(wxMouseEvent& event) {
+	if (!m_peaks || event.GetWheelRotation() == 0)
+		return;
+	double frameAtPointer = XToFrame(event.GetX());
+	if (event.GetWheelRotation() > 0)
+		m_framesPerPixel /= WHEEL_ZOOM_FACTOR;
+	else
+		m_framesPerPixel *= WHEEL_ZOOM_FACTOR;
+	m_firstFrame = frameAtPointer - event.GetX() * m_framesPerPixel;
+	m_isShowingAll = false;
+	ClampView();
+	Refresh();
+}
+
+void WaveformPanel::OnLeftDown(wxMouseEvent& event) {
+	m_isDragging = true;
+	m_dragStartX = event.GetX();
+	m_dragStartFrame = m_firstFrame;
+	CaptureMouse();
+}
+
+void WaveformPanel::OnLeftUp(wxMouseEvent& WXUNUSED(event)) {
+	m_isDragging = false;
+	if (HasCapture())
+		ReleaseMouse();
+}
+
+void WaveformPanel::OnMouseMotion(wxMouseEvent& event) {
+	if (!m_isDragging || !event.LeftIsDown())
+		return;
+	m_firstFrame = m_dragStartFrame - (event.GetX() - m_dragStartX) * m_framesPerPixel;
+	m_isShowingAll = false;
+	ClampView();
+	Refresh();
+}
+
+void WaveformPanel::OnLeftDoubleClick(wxMouseEvent& WXUNUSED(event)) {
+	ZoomToAll();
+}
+
+void WaveformPanel::OnCaptureLost(wxMouseCaptureLostEvent& WXUNUSED(event)) {
+	m_isDragging = false;
+}
+
+void WaveformPanel::OnPanelSize(wxSizeEvent& event) {
+	if (m_isShowingAll)
+		ZoomToAll();
+	else
+		ClampView();
+	Refresh();
+	event.Skip();
+}
+
+void WaveformPanel::Render(wxDC& dc) {
+	dc.SetBackground(*wxWHITE_BRUSH);
+	dc.Clear();
+	wxSize size = GetClientSize();
+	if (!m_peaks) {
+		dc.SetTextForeground(*wxBLACK);
+		dc.DrawText(m_errorMessage.IsEmpty() ? wxT("No waveform to show") : m_errorMessage.Strip(wxString::both), 5, 5);
+		return;
+	}
+
+	if (m_framesPerPixel < PeakPyramid::BASE_BLOCK_FRAMES)
+		ReadRawFrames();
+	unsigned channels = m_peaks->getNumberOfChannels();
+	int laneHeight = size.GetHeight() / channels;
+	for (unsigned c = 0; c < channels; c++)
+		DrawChannel(dc, c, wxRect(0, c * laneHeight, size.GetWidth(), laneHeight));
+
+	for (unsigned i = 0; i < m_loops.size(); i++) {
+		wxString label = wxString::Format(wxT("L%u"), i + 1);
+		DrawMarker(dc, m_loops[i].first, wxColour(0, 150, 0), label, i % 2);
+		DrawMarker(dc, m_loops[i].second + 1, wxColour(200, 0, 0), label, i % 2);
+	}
+	if (m_attackStart > 0)
+		DrawMarker(dc, m_attackStart, wxColour(230, 130, 0), wxT("Start"), 2);
+	if (m_cuePoint >= 0)
+		DrawMarker(dc, m_cuePoint, wxColour(0, 0, 220), wxT("Cue"), 2);
+	if (m_releaseEnd >= 0)
+		DrawMarker(dc, m_releaseEnd, wxColour(150, 0, 150), wxT("End"), 2);
+
+	double sampleRate = m_peaks->getSampleRate() ? m_peaks->getSampleRate() : 1;
+	wxString range = wxString::Format(
+		wxT("%.3f - %.3f s"),
+		m_firstFrame / sampleRate,
+		(m_firstFrame + size.GetWidth() * m_framesPerPixel) / sampleRate
+	);
+	wxSize rangeSize = dc.GetTextExtent(range);
+	dc.SetTextForeground(*wxBLACK);
+	dc.DrawText(range, size.GetWidth() - rangeSize.GetWidth() - 3, size.GetHeight() - rangeSize.GetHeight() - 1);
+}
+
+void WaveformPanel::ReadRawFrames() {
+	unsigned frames = m_peaks->getNumberOfFrames();
+	unsigned first = (unsigned) std::max(0.0, std::floor(m_firstFrame));
+	unsigned last = std::min(frames, (unsigned) std::ceil(m_firstFrame + GetClientSize().GetWidth() * m_framesPerPixel) + 2);
+	if (!m_rawFrames.empty() && m_rawFirstFrame == first && m_rawFrames.size() == (size_t) (last - first) * m_peaks->getNumberOfChannels())
+		return;
+	if (!m_reader)
+		m_reader.reset(new SampleReader(m_path));
+	m_rawFirstFrame = first;
+	if (!m_reader->isOk() || first >= last || !m_reader->readRange(first, last, m_rawFrames))
+		m_rawFrames.clear();
+}
+
+void WaveformPanel::DrawChannel(wxDC& dc, unsigned channel, const wxRect &lane) {
+	int center = lane.GetY() + lane.GetHeight() / 2;
+	double scale = lane.GetHeight() / 2 - 1;
+	dc.SetPen(*wxLIGHT_GREY_PEN);
+	dc.DrawLine(lane.GetLeft(), center, lane.GetRight(), center);
+	if (channel > 0)
+		dc.DrawLine(lane.GetLeft(), lane.GetTop(), lane.GetRight(), lane.GetTop());
+	dc.SetPen(wxPen(wxColour(40, 70, 140)));
+
+	if (m_framesPerPixel >= PeakPyramid::BASE_BLOCK_FRAMES) {
+		std::vector<PeakPyramid::PEAK> peaks;
+		m_peaks->getPeaks(channel, m_firstFrame, m_framesPerPixel, lane.GetWidth(), peaks);
+		for (int x = 0; x < lane.GetWidth(); x++) {
+			if (peaks[x].min == 0 && peaks[x].max == 0)
+				continue;
+			dc.DrawLine(x, center - (int) (peaks[x].max * scale), x, center - (int) (peaks[x].min * scale) + 1);
+		}
+		return;
+	}
+
+	unsigned channels = m_peaks->getNumberOfChannels();
+	size_t numberOfFrames = m_rawFrames.size() / channels;
+	if (m_framesPerPixel >= 1) {
+		// a vertical line for the frames of each column
+		for (int x = 0; x < lane.GetWidth(); x++) {
+			double start = m_firstFrame + x * m_framesPerPixel - m_rawFirstFrame;
+			size_t first = (size_t) std::max(0.0, std::floor(start));
+			size_t last = std::min(numberOfFrames, (size_t) std::ceil(start + m_framesPerPixel));
+			if (first >= last)
+				continue;
+			float min = m_rawFrames[first * channels + channel];
+			float max = min;
+			for (size_t f = first + 1; f < last; f++) {
+				min = std::min(min, m_rawFrames[f * channels + channel]);
+				max = std::max(max, m_rawFrames[f * channels + channel]);
+			}
+			dc.DrawLine(x, center - (int) (max * scale), x, center - (int) (min * scale) + 1);
+		}
+	} else {
+		// the frames themselves, joined by lines
+		wxPoint previous;
+		for (size_t f = 0; f < numberOfFrames; f++) {
+			wxPoint point(FrameToX(m_rawFirstFrame + f), center - (int) (m_rawFrames[f * channels + channel] * scale));
+			if (f > 0)
+				dc.DrawLine(previous, point);
+			if (m_framesPerPixel < 0.25)
+				dc.DrawCircle(point, 2);
+			previous = point;
+		}
+	}
+}
+
+void WaveformPanel::DrawMarker(wxDC& dc, double frame, const wxColour &colour, const wxString &label, int labelRow) {
+	int x = FrameToX(frame);
+	wxSize size = GetClientSize();
+	if (x < 0 || x >= size.GetWidth())
+		return;
+	dc.SetPen(wxPen(colour));
+	dc.DrawLine(x, 0, x, size.GetHeight());
+	dc.SetTextForeground(colour);
+	dc.DrawText(label, x + 2, labelRow * dc.GetCharHeight());
+}
+
+void WaveformPanel::ClampView() {
+	if (!m_peaks)
+		return;
+	int width = std::max(1, GetClientSize().GetWidth());
+	double frames = m_peaks->getNumberOfFrames();
+	double maxFramesPerPixel = std::max(MIN_FRAMES_PER_PIXEL, frames / width);
+	m_framesPerPixel = std::min(std::max(m_framesPerPixel, MIN_FRAMES_PER_PIXEL), maxFramesPerPixel);
+	m_firstFrame = std::min(std::max(m_firstFrame, 0.0), std::max(0.0, frames - width * m_framesPerPixel));
+}
+
+int WaveformPanel::FrameToX(double frame) const {
+	return (int) std::floor((frame - m_firstFrame) / m_framesPerPixel);
+}
+
+double WaveformPanel::XToFrame(int x) const {
+	return m_firstFrame + x * m_framesPerPixel;
+}
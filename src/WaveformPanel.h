@@ -0,0 +1,85 @@
+/*
+ * WaveformPanel.h is part of GoOdf.
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * GoOdf is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GoOdf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GoOdf.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#ifndef WAVEFORMPANEL_H
+#define WAVEFORMPANEL_H
+
+#include <wx/wx.h>
+#include <memory>
+#include <vector>
+#include "PeakPyramid.h"
+
+class SampleReader;
+
+// Draws the waveform of a sample from its cached peak pyramid with the
+// loops, cue point, attack start and release end on top. The mouse wheel
+// zooms around the pointer down to single frames, dragging scrolls and a
+// double click shows the whole sample again.
+class WaveformPanel : public wxPanel {
+public:
+	WaveformPanel(wxWindow *parent, wxWindowID id = wxID_ANY, const wxSize &size = wxSize(600, 160));
+	~WaveformPanel();
+
+	void SetSample(const wxString &path);
+	// -1 (or 0 for the attack start) means that the marker isn't drawn
+	void SetMarkers(int attackStart, int cuePoint, int releaseEnd, const std::vector<std::pair<unsigned, unsigned>> &loops);
+	void ZoomToAll();
+
+private:
+	DECLARE_EVENT_TABLE()
+
+	wxString m_path;
+	std::shared_ptr<const PeakPyramid> m_peaks;
+	std::unique_ptr<SampleReader> m_reader;
+	wxString m_errorMessage;
+	double m_firstFrame;
+	double m_framesPerPixel;
+	bool m_isShowingAll;
+	// the frames themselves when zoomed in closer than the peaks go
+	std::vector<float> m_rawFrames;
+	unsigned m_rawFirstFrame;
+	int m_attackStart;
+	int m_cuePoint;
+	int m_releaseEnd;
+	std::vector<std::pair<unsigned, unsigned>> m_loops;
+	bool m_isDragging;
+	int m_dragStartX;
+	double m_dragStartFrame;
+
+	void OnPaintEvent(wxPaintEvent& event);
+	void OnMouseWheel(wxMouseEvent& event);
+	void OnLeftDown(wxMouseEvent& event);
+	void OnLeftUp(wxMouseEvent& event);
+	void OnMouseMotion(wxMouseEvent& event);
+	void OnLeftDoubleClick(wxMouseEvent& event);
+	void OnCaptureLost(wxMouseCaptureLostEvent& event);
+	void OnPanelSize(wxSizeEvent& event);
+
+	void Render(wxDC& dc);
+	void ReadRawFrames();
+	void DrawChannel(wxDC& dc, unsigned channel, const wxRect &lane);
+	void DrawMarker(wxDC& dc, double frame, const wxColour &colour, const wxString &label, int labelRow);
+	void ClampView();
+	int FrameToX(double frame) const;
+	double XToFrame(int x) const;
+
+};
+
+#endif
@@ -20,7 +20,7 @@
 
 #include "Windchestgroup.h"
 #include "GOODFFunctions.h"
-#include "GOODF.h"
+#include "Organ.h"
 
 Windchestgroup::Windchestgroup() {
 	name = wxT("New windchest");
@@ -40,38 +40,38 @@ Windchestgroup::~Windchestgroup() {
 void Windchestgroup::write(wxTextFile *outFile) {
 	outFile->AddLine(wxT("Name=") + name);
 	unsigned nbEnc = m_Enclosures.size();
-	outFile->AddLine(wxT("NumberOfEnclosures=") + wxString::Format(wxT("%u"), nbEnc));
+	GOODF_functions::addKeyLine(outFile, wxT("NumberOfEnclosures="), nbEnc);
 	unsigned i = 0;
 	if (!m_Enclosures.empty()) {
 		for (auto& enc : m_Enclosures) {
 			i++;
 			wxString encNumber = GOODF_functions::number_format(i);
-			wxString encRef = GOODF_functions::number_format(::wxGetApp().m_frame->m_organ->getIndexOfOrganEnclosure(enc));
+			wxString encRef = GOODF_functions::number_format(OrganContext::current()->getOrgan()->getIndexOfOrganEnclosure(enc));
 			outFile->AddLine(wxT("Enclosure") + encNumber + wxT("=") + encRef);
 		}
 	}
 	unsigned nbTrem = m_Tremulants.size();
-	outFile->AddLine(wxT("NumberOfTremulants=") + wxString::Format(wxT("%u"), nbTrem));
+	GOODF_functions::addKeyLine(outFile, wxT("NumberOfTremulants="), nbTrem);
 	i = 0;
 	if (!m_Tremulants.empty()) {
 		for (auto& trem : m_Tremulants) {
 			i++;
 			wxString tremNumber = GOODF_functions::number_format(i);
-			wxString tremRef = GOODF_functions::number_format(::wxGetApp().m_frame->m_organ->getIndexOfOrganTremulant(trem));
+			wxString tremRef = GOODF_functions::number_format(OrganContext::current()->getOrgan()->getIndexOfOrganTremulant(trem));
 			outFile->AddLine(wxT("Tremulant") + tremNumber + wxT("=") + tremRef);
 		}
 	}
 	if (m_amplitudeLevel != 100)
-		outFile->AddLine(wxT("AmplitudeLevel=") + wxString::Format(wxT("%f"), m_amplitudeLevel));
+		GOODF_functions::addKeyLine(outFile, wxT("AmplitudeLevel="), m_amplitudeLevel);
 	if (m_gain != 0)
-		outFile->AddLine(wxT("Gain=") + wxString::Format(wxT("%f"), m_gain));
+		GOODF_functions::addKeyLine(outFile, wxT("Gain="), m_gain);
 	if (m_pitchTuning != 0)
-		outFile->AddLine(wxT("PitchTuning=") + wxString::Format(wxT("%f"), m_pitchTuning));
+		GOODF_functions::addKeyLine(outFile, wxT("PitchTuning="), m_pitchTuning);
 	if (m_pitchCorrection != 0)
-		outFile->AddLine(wxT("PitchCorrection=") + wxString::Format(wxT("%f"), m_pitchCorrection));
+		GOODF_functions::addKeyLine(outFile, wxT("PitchCorrection="), m_pitchCorrection);
 	if (m_trackerDelay != 0)
-		outFile->AddLine(wxT("TrackerDelay=") + wxString::Format(wxT("%u"), m_trackerDelay));
-	if (m_isPercussive != ::wxGetApp().m_frame->m_organ->getIsPercussive()) {
+		GOODF_functions::addKeyLine(outFile, wxT("TrackerDelay="), m_trackerDelay);
+	if (m_isPercussive != OrganContext::current()->getOrgan()->getIsPercussive()) {
 		if (m_isPercussive) {
 			outFile->AddLine(wxT("Percussive=Y"));
 			if (m_hasIndependentRelease) {
@@ -263,14 +263,15 @@ void Windchestgroup::setHasIndependentRelease(bool independentRel) {
 	m_hasIndependentRelease = independentRel;
 }
 
-bool Windchestgroup::isPipesOnThisWindchest() {
+bool Windchestgroup::isPipesOnThisWindchest(OrganContext &context) {
 	bool pipesFound = false;
 
-	for (unsigned i = 0; i < ::wxGetApp().m_frame->m_organ->getNumberOfRanks(); i ++) {
+	for (unsigned i = 0; i < context.getOrgan()->getNumberOfRanks(); i ++) {
 		if (pipesFound)
 			break;
 
-		Rank *r = ::wxGetApp().m_frame->m_organ->getOrganRankAt(i);
+		Rank *r = context.getOrgan()->getOrganRankAt(i);
+		r->loadPipes();
 		for (Pipe &p : r->m_pipes) {
 			if (p.windchest == this) {
 				pipesFound = true;
@@ -280,11 +281,11 @@ bool Windchestgroup::isPipesOnThisWindchest() {
 	}
 
 	if (!pipesFound) {
-		for (unsigned i = 0; i < ::wxGetApp().m_frame->m_organ->getNumberOfStops(); i ++) {
+		for (unsigned i = 0; i < context.getOrgan()->getNumberOfStops(); i ++) {
 			if (pipesFound)
 				break;
 
-			Stop *s = ::wxGetApp().m_frame->m_organ->getOrganStopAt(i);
+			Stop *s = context.getOrgan()->getOrganStopAt(i);
 			if (s->isUsingInternalRank()) {
 				Rank *r = s->getInternalRank();
 				for (Pipe &p : r->m_pipes) {
@@ -300,10 +301,11 @@ bool Windchestgroup::isPipesOnThisWindchest() {
 	return pipesFound;
 }
 
-void Windchestgroup::applyPercussiveRecursively() {
+void Windchestgroup::applyPercussiveRecursively(OrganContext &context) {
 	// apply Percussive value to all separate ranks
-	for (unsigned i = 0; i < ::wxGetApp().m_frame->m_organ->getNumberOfRanks(); i ++) {
-		Rank *r = ::wxGetApp().m_frame->m_organ->getOrganRankAt(i);
+	for (unsigned i = 0; i < context.getOrgan()->getNumberOfRanks(); i ++) {
+		Rank *r = context.getOrgan()->getOrganRankAt(i);
+		r->loadPipes();
 		for (Pipe &p : r->m_pipes) {
 			if (p.windchest == this) {
 				p.isPercussive = this->getIsPercussive();
@@ -324,8 +326,8 @@ void Windchestgroup::applyPercussiveRecursively() {
 		}
 	}
 	// and to any stop with internal rank
-	for (unsigned i = 0; i < ::wxGetApp().m_frame->m_organ->getNumberOfStops(); i ++) {
-		Stop *s = ::wxGetApp().m_frame->m_organ->getOrganStopAt(i);
+	for (unsigned i = 0; i < context.getOrgan()->getNumberOfStops(); i ++) {
+		Stop *s = context.getOrgan()->getOrganStopAt(i);
 		if (s->isUsingInternalRank()) {
 			Rank *r = s->getInternalRank();
 			for (Pipe &p : r->m_pipes) {
@@ -350,10 +352,11 @@ void Windchestgroup::applyPercussiveRecursively() {
 	}
 }
 
-void Windchestgroup::applyHasIndependentReleaseRecursively() {
+void Windchestgroup::applyHasIndependentReleaseRecursively(OrganContext &context) {
 	// apply HasIndependentRelease value to all separate ranks
-	for (unsigned i = 0; i < ::wxGetApp().m_frame->m_organ->getNumberOfRanks(); i ++) {
-		Rank *r = ::wxGetApp().m_frame->m_organ->getOrganRankAt(i);
+	for (unsigned i = 0; i < context.getOrgan()->getNumberOfRanks(); i ++) {
+		Rank *r = context.getOrgan()->getOrganRankAt(i);
+		r->loadPipes();
 		for (Pipe &p : r->m_pipes) {
 			if (p.windchest == this) {
 				if ((this->getHasIndependentRelease() && p.isPercussive) || !this->getHasIndependentRelease())
@@ -366,8 +369,8 @@ void Windchestgroup::applyHasIndependentReleaseRecursively() {
 		}
 	}
 	// and to any stop with internal rank
-	for (unsigned i = 0; i < ::wxGetApp().m_frame->m_organ->getNumberOfStops(); i ++) {
-		Stop *s = ::wxGetApp().m_frame->m_organ->getOrganStopAt(i);
+	for (unsigned i = 0; i < context.getOrgan()->getNumberOfStops(); i ++) {
+		Stop *s = context.getOrgan()->getOrganStopAt(i);
 		if (s->isUsingInternalRank()) {
 			Rank *r = s->getInternalRank();
 			for (Pipe &p : r->m_pipes) {
@@ -29,6 +29,7 @@
 #include "Tremulant.h"
 
 class Organ;
+class OrganContext;
 
 class Windchestgroup {
 public:
@@ -67,9 +68,9 @@ public:
 	void setIsPercussive(bool percussive);
 	bool getHasIndependentRelease();
 	void setHasIndependentRelease(bool independentRel);
-	bool isPipesOnThisWindchest();
-	void applyPercussiveRecursively();
-	void applyHasIndependentReleaseRecursively();
+	bool isPipesOnThisWindchest(OrganContext &context);
+	void applyPercussiveRecursively(OrganContext &context);
+	void applyHasIndependentReleaseRecursively(OrganContext &context);
 
 private:
 	wxString name;
@@ -646,11 +646,11 @@ void WindchestgroupPanel::OnPercussiveSelection(wxCommandEvent& event) {
 		m_hasIndependentReleaseYes->Enable();
 		m_hasIndependentReleaseNo->Enable();
 
-		if (m_windchest->isPipesOnThisWindchest()) {
+		if (m_windchest->isPipesOnThisWindchest(*::wxGetApp().m_frame->m_organ->getContext())) {
 			// ask if this should be applied to rank/pipes on this windchest
 			wxMessageDialog msg(this, wxT("Do you want the Percussive=Y value to be applied recursively to ranks/pipes on this windchest?\n\nWARNING! Purely percussive pipes cannot have any releases, so any existing releases will be removed!"), wxT("Apply recursively?"), wxYES_NO|wxCENTRE|wxICON_EXCLAMATION);
 			if (msg.ShowModal() == wxID_YES) {
-				m_windchest->applyPercussiveRecursively();
+				m_windchest->applyPercussiveRecursively(*::wxGetApp().m_frame->m_organ->getContext());
 			}
 		}
 	} else {
@@ -661,11 +661,11 @@ void WindchestgroupPanel::OnPercussiveSelection(wxCommandEvent& event) {
 		m_hasIndependentReleaseYes->Enable(false);
 		m_hasIndependentReleaseNo->Enable(false);
 
-		if (m_windchest->isPipesOnThisWindchest()) {
+		if (m_windchest->isPipesOnThisWindchest(*::wxGetApp().m_frame->m_organ->getContext())) {
 			// ask if this should be applied to rank/pipes on this windchest
 			wxMessageDialog msg(this, wxT("Do you want the Percussive=N value (and also HasIndependentRelease=N) to be applied recursively to ranks/pipes on this windchest?"), wxT("Apply recursively?"), wxYES_NO|wxCENTRE|wxICON_EXCLAMATION);
 			if (msg.ShowModal() == wxID_YES) {
-				m_windchest->applyPercussiveRecursively();
+				m_windchest->applyPercussiveRecursively(*::wxGetApp().m_frame->m_organ->getContext());
 			}
 		}
 	}
@@ -676,22 +676,22 @@ void WindchestgroupPanel::OnIndependentReleaseSelection(wxCommandEvent& event) {
 	if (event.GetId() == ID_WINDCHEST_INDEPENDENT_RELEASE_YES) {
 		m_windchest->setHasIndependentRelease(true);
 
-		if (m_windchest->isPipesOnThisWindchest()) {
+		if (m_windchest->isPipesOnThisWindchest(*::wxGetApp().m_frame->m_organ->getContext())) {
 			// ask if this should be applied to rank/pipes on this windchest
 			wxMessageDialog msg(this, wxT("Do you want the HasIndependentRelease=Y value to be applied recursively to ranks/pipes on this windchest if possible (requires that Percussive=Y already is set also)?"), wxT("Apply recursively?"), wxYES_NO|wxCENTRE|wxICON_EXCLAMATION);
 			if (msg.ShowModal() == wxID_YES) {
-				m_windchest->applyHasIndependentReleaseRecursively();
+				m_windchest->applyHasIndependentReleaseRecursively(*::wxGetApp().m_frame->m_organ->getContext());
 			}
 		}
 
 	} else {
 		m_windchest->setHasIndependentRelease(false);
 
-		if (m_windchest->isPipesOnThisWindchest()) {
+		if (m_windchest->isPipesOnThisWindchest(*::wxGetApp().m_frame->m_organ->getContext())) {
 			// ask if this should be applied to rank/pipes on this windchest
 			wxMessageDialog msg(this, wxT("Do you want the HasIndependentRelease=N value to be applied recursively to ranks/pipes on this windchest?"), wxT("Apply recursively?"), wxYES_NO|wxCENTRE|wxICON_EXCLAMATION);
 			if (msg.ShowModal() == wxID_YES) {
-				m_windchest->applyHasIndependentReleaseRecursively();
+				m_windchest->applyHasIndependentReleaseRecursively(*::wxGetApp().m_frame->m_organ->getContext());
 			}
 		}
 	}
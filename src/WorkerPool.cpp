@@ -0,0 +1,119 @@
+/*
+ * WorkerPool.cpp is part of GoOdf.
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * GoOdf is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GoOdf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GoOdf.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#include "WorkerPool.h"
+#include <wx/thread.h>
+#include <atomic>
+#include <vector>
+
+namespace {
+
+	struct SharedState {
+		size_t count;
+		const std::function<void(size_t)> *task;
+		std::atomic<size_t> nextIndex;
+		std::atomic<size_t> finishedTasks;
+		std::atomic<bool> isCancelled;
+	};
+
+	class PoolThread : public wxThread {
+	public:
+		PoolThread(SharedState *state) : wxThread(wxTHREAD_JOINABLE) {
+			m_state = state;
+		}
+
+	protected:
+		virtual ExitCode Entry() {
+			while (!m_state->isCancelled) {
+				size_t index = m_state->nextIndex.fetch_add(1);
+				if (index >= m_state->count)
+					break;
+				(*m_state->task)(index);
+				m_state->finishedTasks.fetch_add(1);
+			}
+			return (ExitCode) 0;
+		}
+
+	private:
+		SharedState *m_state;
+	};
+
+}
+
+bool WorkerPool::run(size_t count, const std::function<void(size_t)> &task, const std::function<bool(size_t)> &progress) {
+	SharedState state;
+	state.count = count;
+	state.task = &task;
+	state.nextIndex = 0;
+	state.finishedTasks = 0;
+	state.isCancelled = false;
+
+	std::vector<PoolThread*> threads;
+	unsigned workers = getNumberOfWorkers();
+	for (unsigned i = 0; i < workers && i < count; i++) {
+		PoolThread *thread = new PoolThread(&state);
+		if (thread->Run() != wxTHREAD_NO_ERROR) {
+			delete thread;
+			break;
+		}
+		threads.push_back(thread);
+	}
+
+	if (threads.empty()) {
+		// no threads could be started so the tasks are run right here
+		for (size_t i = 0; i < count && !state.isCancelled; i++) {
+			task(i);
+			state.finishedTasks.fetch_add(1);
+			if (progress && !progress(state.finishedTasks))
+				state.isCancelled = true;
+		}
+		return !state.isCancelled;
+	}
+
+	while (state.finishedTasks < count) {
+		bool allStopped = true;
+		for (PoolThread *thread : threads) {
+			if (thread->IsRunning()) {
+				allStopped = false;
+				break;
+			}
+		}
+		if (allStopped)
+			break;
+		if (progress && !state.isCancelled && !progress(state.finishedTasks))
+			state.isCancelled = true;
+		wxMilliSleep(50);
+	}
+
+	for (PoolThread *thread : threads) {
+		thread->Wait();
+		delete thread;
+	}
+	if (progress && !state.isCancelled)
+		progress(state.finishedTasks);
+	return !state.isCancelled;
+}
+
+unsigned WorkerPool::getNumberOfWorkers() {
+	int cpus = wxThread::GetCPUCount();
+	if (cpus < 1)
+		return 1;
+	return (unsigned) cpus;
+}
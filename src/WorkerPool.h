@@ -0,0 +1,39 @@
+/*
+ * WorkerPool.h is part of GoOdf.
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * GoOdf is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GoOdf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GoOdf.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#ifndef WORKERPOOL_H
+#define WORKERPOOL_H
+
+#include <wx/wx.h>
+#include <functional>
+
+// Runs a batch of independent tasks on one worker thread per processor
+// while the calling thread reports the progress. The task is called once
+// for every index from 0 to count - 1 and must not touch the user
+// interface. The progress callback is called on the calling thread every
+// now and then with the number of finished tasks; returning false from it
+// cancels the tasks that haven't started yet.
+class WorkerPool {
+public:
+	static bool run(size_t count, const std::function<void(size_t)> &task, const std::function<bool(size_t)> &progress = nullptr);
+	static unsigned getNumberOfWorkers();
+};
+
+#endif